@@ -116,6 +116,7 @@ typedef union tagLALH5Generic {
 void XLALH5FileClose(LALH5File *file);
 LALH5File * XLALH5FileOpen(const char *path, const char *mode);
 LALH5File * XLALH5GroupOpen(LALH5File *file, const char *name);
+int XLALH5FileFlush(LALH5File *file);
 
 int XLALH5FileCheckGroupExists(const LALH5File *file, const char *name);
 int XLALH5FileCheckDatasetExists(const LALH5File *file, const char *name);
@@ -184,6 +185,7 @@ int XLALH5AttributeQueryEnumValue(const LALH5Generic object, const char *key, in
 
 LALH5Dataset * XLALH5TableAlloc(LALH5File *file, const char *name, size_t ncols, const char **cols, const LALTYPECODE *types, const size_t *offsets, size_t rowsz);
 int XLALH5TableAppend(LALH5Dataset *dset, const size_t *offsets, const size_t *colsz, size_t nrows, size_t rowsz, const void *data);
+int XLALH5TableTruncate(LALH5Dataset *dset, size_t nrows);
 
 int XLALH5TableRead(void *data, const LALH5Dataset *dset, const size_t *offsets, const size_t *colsz, size_t rowsz);
 int XLALH5TableReadRows(void *data, const LALH5Dataset *dset, const size_t *offsets, const size_t *colsz, size_t row0, size_t nrows, size_t rowsz);
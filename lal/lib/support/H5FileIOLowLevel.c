@@ -31,6 +31,7 @@
 
 #define LAL_H5_FILE_MODE_READ  H5F_ACC_RDONLY
 #define LAL_H5_FILE_MODE_WRITE H5F_ACC_TRUNC
+#define LAL_H5_FILE_MODE_APPEND H5F_ACC_RDWR
 
 struct tagLALH5Object {
 	hid_t object_id; /* this object's id must be first */
@@ -335,6 +336,23 @@ static LALH5File * XLALH5FileOpenRead(const char *path)
 	return file;
 }
 
+/* opens an existing HDF5 file for reading and writing in place */
+static LALH5File * XLALH5FileOpenAppend(const char *path)
+{
+	LALH5File *file;
+	file = LALCalloc(1, sizeof(*file));
+	if (!file)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	XLALStringCopy(file->fname, path, sizeof(file->fname));
+	file->file_id = threadsafe_H5Fopen(path, H5F_ACC_RDWR, H5P_DEFAULT);
+	if (file->file_id < 0) {
+		LALFree(file);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not open HDF5 file `%s'", path);
+	}
+	file->mode = LAL_H5_FILE_MODE_APPEND;
+	return file;
+}
+
 #if 0
 static hid_t XLALGetObjectIdentifier(const void *ptr)
 {
@@ -424,14 +442,17 @@ void XLALH5FileClose(LALH5File UNUSED *file)
  * <dl>
  * <dt>r</dt><dd>Open file for reading.</dd>
  * <dt>w</dt><dd>Truncate to zero length or create file for writing.</dd>
+ * <dt>a</dt><dd>Open an existing file for reading and writing.</dd>
  * </dl>
  *
  * If a file is opened for writing then data is initially written to a
  * temporary file, and this file is renamed once the #LALH5File structure
- * is closed with XLALH5FileClose().
+ * is closed with XLALH5FileClose().  A file opened for appending is
+ * modified in place, so that data can be added to it incrementally; use
+ * XLALH5FileFlush() to bring the file on disk up to date while it is open.
  *
  * @param path Pointer to a string containing the path of the file to open.
- * @param mode Mode to open the file, either "r" or "w".
+ * @param mode Mode to open the file, either "r", "w", or "a".
  * @returns A pointer to a #LALH5File structure associated with the
  * specified HDF5 file.
  * @retval NULL An error occurred opening the file.
@@ -447,7 +468,9 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
 		return XLALH5FileOpenRead(path);
 	else if (strcmp(mode, "w") == 0)
 		return XLALH5FileCreate(path);
-	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\" or \"w\"", mode);
+	else if (strcmp(mode, "a") == 0)
+		return XLALH5FileOpenAppend(path);
+	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\", \"w\", or \"a\"", mode);
 #endif
 }
 
@@ -458,7 +481,8 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
  * associated with the #LALH5File @p file.  If the HDF5 file is
  * being read, the specified group must exist in that file.  If
  * the HDF5 file is being written, the specified group is created
- * within the file.
+ * within the file.  If the HDF5 file is being appended to, the
+ * group is opened if it exists and created otherwise.
  *
  * @param file Pointer to a #LALH5File structure in which to open the group.
  * @param name Pointer to a string with the name of the group to open.
@@ -481,9 +505,10 @@ LALH5File * XLALH5GroupOpen(LALH5File UNUSED *file, const char UNUSED *name)
 	group->mode = file->mode;
 	if (!name) /* this is the same as the file */
 		group->file_id = file->file_id;
-	else if (group->mode == LAL_H5_FILE_MODE_READ)
+	else if (group->mode == LAL_H5_FILE_MODE_READ
+			|| (group->mode == LAL_H5_FILE_MODE_APPEND && XLALH5FileCheckGroupExists(file, name)))
 		group->file_id = threadsafe_H5Gopen2(file->file_id, name, H5P_DEFAULT);
-	else if (group->mode == LAL_H5_FILE_MODE_WRITE) {
+	else if (group->mode == LAL_H5_FILE_MODE_WRITE || group->mode == LAL_H5_FILE_MODE_APPEND) {
 		hid_t gcpl; /* property list to allow intermediate groups to be created */
 		gcpl = threadsafe_H5Pcreate(H5P_LINK_CREATE);
 		if (gcpl < 0 || threadsafe_H5Pset_create_intermediate_group(gcpl, 1) < 0) {
@@ -502,6 +527,32 @@ LALH5File * XLALH5GroupOpen(LALH5File UNUSED *file, const char UNUSED *name)
 #endif
 }
 
+/**
+ * @brief Flushes a #LALH5File to disk
+ * @details
+ * Writes all buffered data and metadata of the HDF5 file associated with
+ * the #LALH5File @p file (which may be a group within the file) to disk,
+ * so that the file is complete and readable by other processes.  This is
+ * only useful for files opened for appending; files opened for writing
+ * are not moved into place until they are closed.
+ *
+ * @param file Pointer to a #LALH5File structure to flush.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5FileFlush(LALH5File UNUSED *file)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	if (file == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (threadsafe_H5Fflush(file->file_id, H5F_SCOPE_GLOBAL) < 0)
+		XLAL_ERROR(XLAL_EIO, "Failed to flush HDF5 file");
+	return 0;
+#endif
+}
+
 /**
  * @brief Checks for existence of a group in a #LALH5File
  * @details
@@ -959,7 +1010,7 @@ LALH5Dataset * XLALH5DatasetAlloc(LALH5File UNUSED *file, const char UNUSED *nam
 
 	if (name == NULL || file == NULL || dimLength == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1042,7 +1093,7 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
 
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1132,7 +1183,7 @@ LALH5Dataset * XLALH5DatasetRead(LALH5File UNUSED *file, const char UNUSED *name
 	size_t namelen;
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_READ)
+	if (file->mode == LAL_H5_FILE_MODE_WRITE)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to read a write-only HDF5 file");
 
 	namelen = strlen(name);
@@ -3103,7 +3154,7 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 	if (file == NULL || cols == NULL || types == NULL || offsets == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
 
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	/* map the LAL types to HDF5 types */
@@ -3227,6 +3278,43 @@ int XLALH5TableAppend(LALH5Dataset UNUSED *dset, const size_t UNUSED *offsets, c
 #endif
 }
 
+/**
+ * @brief Truncates the table data in a #LALH5Dataset
+ * @details
+ * This routine discards all rows of the table associated with the
+ * #LALH5Dataset @p dset from row number @p nrows onwards, so that the
+ * table holds its first @p nrows rows.  The table must be in a file
+ * opened for appending, and must not have fewer than @p nrows rows.
+ * Rows appended with XLALH5TableAppend() afterwards follow on from the
+ * truncated table.
+ *
+ * @param dset Pointer to a #LALH5Dataset containing the table to truncate.
+ * @param nrows Number of rows of the table to keep.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5TableTruncate(LALH5Dataset UNUSED *dset, size_t UNUSED nrows)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hsize_t nrecords;
+
+	if (dset == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	if (threadsafe_H5TBget_table_info(dset->parent_id, dset->name, NULL, &nrecords) < 0)
+		XLAL_ERROR(XLAL_EIO);
+	if (nrows > nrecords)
+		XLAL_ERROR(XLAL_EINVAL, "Cannot truncate table `%s' of %zu rows to %zu rows", dset->name, (size_t) nrecords, nrows);
+
+	if (nrows < nrecords && threadsafe_H5TBdelete_record(dset->parent_id, dset->name, nrows, nrecords - nrows) < 0)
+		XLAL_ERROR(XLAL_EIO);
+
+	return 0;
+#endif
+}
+
 /**
  * @brief Reads table data from a #LALH5Dataset
  * @details
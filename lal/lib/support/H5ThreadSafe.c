@@ -387,6 +387,14 @@ static inline herr_t threadsafe_H5TBappend_records(hid_t loc_id, const char *dse
 	return retval;
 }
 
+static inline herr_t threadsafe_H5TBdelete_record(hid_t loc_id, const char *dset_name, hsize_t start, hsize_t nrecords)
+{
+	LAL_HDF5_MUTEX_LOCK
+	herr_t retval = H5TBdelete_record(loc_id, dset_name, start, nrecords);
+	LAL_HDF5_MUTEX_UNLOCK
+	return retval;
+}
+
 static inline herr_t threadsafe_H5TBget_field_info(hid_t loc_id, const char *dset_name, char *field_names[], size_t *field_sizes, size_t *field_offsets, size_t *type_size)
 {
 	LAL_HDF5_MUTEX_LOCK
@@ -673,6 +681,7 @@ static inline herr_t threadsafe_H5open(void)
 #define threadsafe_H5Sget_simple_extent_ndims H5Sget_simple_extent_ndims
 #define threadsafe_H5Sget_simple_extent_npoints H5Sget_simple_extent_npoints
 #define threadsafe_H5TBappend_records H5TBappend_records
+#define threadsafe_H5TBdelete_record H5TBdelete_record
 #define threadsafe_H5TBget_field_info H5TBget_field_info
 #define threadsafe_H5TBget_table_info H5TBget_table_info
 #define threadsafe_H5TBmake_table H5TBmake_table
@@ -0,0 +1,178 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_CreateEphemeris
+ * \brief
+ * Convert Earth/Sun ephemeris files and time correction files into the binary format
+ * read by XLALInitBarycenter() and XLALInitTimeCorrections(), which loads much faster
+ * than the (gzipped) ASCII format.
+ *
+ * Ephemerides may be stored either as tables, which are read back exactly, or as
+ * Chebyshev polynomials fitted over segments of the tables, which are smaller; the
+ * accuracy of the converted ephemerides is reported by reading them back.
+ */
+
+/* ---------- includes ---------- */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <lal/UserInput.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/LALString.h>
+
+#include <lalapps.h>
+
+/* ---------- local types ---------- */
+
+typedef struct
+{
+  CHAR *ephemEarth;	/**< Earth ephemeris file to convert */
+  CHAR *ephemSun;	/**< Sun ephemeris file to convert */
+  CHAR *timeCorr;	/**< time correction file to convert */
+
+  CHAR *outEarth;	/**< binary Earth ephemeris file to write */
+  CHAR *outSun;		/**< binary Sun ephemeris file to write */
+  CHAR *outTimeCorr;	/**< binary time correction file to write */
+
+  INT4 chebCoeffs;	/**< number of Chebyshev coefficients per segment, or zero to store tables */
+  INT4 chebSpan;	/**< number of table intervals per Chebyshev segment */
+
+} UserVariables_t;
+
+/* ---------- local prototypes ---------- */
+static int CompareEphemerisTables ( const CHAR *name, const PosVelAcc *table1, INT4 length1, const PosVelAcc *table2, INT4 length2 );
+
+/*============================================================
+ * FUNCTION definitions
+ *============================================================*/
+
+int
+main(int argc, char *argv[])
+{
+
+  UserVariables_t XLAL_INIT_DECL(uvar_struct);
+  UserVariables_t *const uvar = &uvar_struct;
+
+  /* set a few defaults */
+  uvar->ephemEarth = XLALStringDuplicate("earth00-40-DE405.dat.gz");
+  uvar->ephemSun = XLALStringDuplicate("sun00-40-DE405.dat.gz");
+  uvar->chebCoeffs = 0;
+  uvar->chebSpan = 32;
+
+  /* register all user-variables */
+  XLALRegisterUvarMember(	ephemEarth,	STRING, 0,  OPTIONAL,	"Earth ephemeris file to convert");
+  XLALRegisterUvarMember(	ephemSun,	STRING, 0,  OPTIONAL,	"Sun ephemeris file to convert");
+  XLALRegisterUvarMember(	timeCorr,	STRING, 0,  OPTIONAL,	"Time correction file to convert");
+  XLALRegisterUvarMember(	outEarth,	STRING, 0,  OPTIONAL,	"Binary Earth ephemeris file to write");
+  XLALRegisterUvarMember(	outSun,		STRING, 0,  OPTIONAL,	"Binary Sun ephemeris file to write");
+  XLALRegisterUvarMember(	outTimeCorr,	STRING, 0,  OPTIONAL,	"Binary time correction file to write");
+  XLALRegisterUvarMember(	chebCoeffs,	INT4, 0,  OPTIONAL,	"Store ephemerides as Chebyshev polynomials with this many coefficients per segment (0 = store tables)");
+  XLALRegisterUvarMember(	chebSpan,	INT4, 0,  OPTIONAL,	"Number of ephemeris table intervals spanned by each Chebyshev segment");
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit(1);
+  }
+
+  /* check user input */
+  XLALUserVarCheck( &should_exit, uvar->outEarth != NULL || uvar->outSun != NULL || uvar->outTimeCorr != NULL, "At least one of --outEarth, --outSun, or --outTimeCorr must be given" );
+  XLALUserVarCheck( &should_exit, uvar->timeCorr != NULL || uvar->outTimeCorr == NULL, "--outTimeCorr requires --timeCorr" );
+  XLALUserVarCheck( &should_exit, uvar->chebCoeffs >= 0, UVAR_STR( chebCoeffs ) " must be non-negative" );
+  XLALUserVarCheck( &should_exit, uvar->chebSpan > 0, UVAR_STR( chebSpan ) " must be strictly positive" );
+  if ( should_exit ) {
+    return EXIT_FAILURE;
+  }
+
+  /* ----- convert ephemerides ----- */
+  if ( uvar->outEarth != NULL || uvar->outSun != NULL ) {
+    EphemerisData *edat = XLALInitBarycenter( uvar->ephemEarth, uvar->ephemSun );
+    XLAL_CHECK_MAIN( edat != NULL, XLAL_EFUNC );
+
+    if ( uvar->outEarth != NULL ) {
+      XLAL_CHECK_MAIN( XLALWriteEphemerisBinaryFile( uvar->outEarth, edat, 0, uvar->chebCoeffs, uvar->chebSpan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    if ( uvar->outSun != NULL ) {
+      XLAL_CHECK_MAIN( XLALWriteEphemerisBinaryFile( uvar->outSun, edat, 1, uvar->chebCoeffs, uvar->chebSpan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    /* read converted ephemerides back, and report their accuracy */
+    EphemerisData *edat_bin = XLALInitBarycenter( uvar->outEarth != NULL ? uvar->outEarth : uvar->ephemEarth,
+                                                  uvar->outSun != NULL ? uvar->outSun : uvar->ephemSun );
+    XLAL_CHECK_MAIN( edat_bin != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( edat_bin->etype == edat->etype, XLAL_EFAILED, "Converted ephemeris type %d != %d\n", edat_bin->etype, edat->etype );
+    if ( uvar->outEarth != NULL ) {
+      XLAL_CHECK_MAIN( CompareEphemerisTables( uvar->outEarth, edat->ephemE, edat->nentriesE, edat_bin->ephemE, edat_bin->nentriesE ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    if ( uvar->outSun != NULL ) {
+      XLAL_CHECK_MAIN( CompareEphemerisTables( uvar->outSun, edat->ephemS, edat->nentriesS, edat_bin->ephemS, edat_bin->nentriesS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    XLALDestroyEphemerisData( edat );
+    XLALDestroyEphemerisData( edat_bin );
+  }
+
+  /* ----- convert time corrections ----- */
+  if ( uvar->outTimeCorr != NULL ) {
+    TimeCorrectionData *tdat = XLALInitTimeCorrections( uvar->timeCorr );
+    XLAL_CHECK_MAIN( tdat != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWriteTimeCorrectionBinaryFile( uvar->outTimeCorr, tdat ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* time corrections are stored as tables, and so must be read back exactly */
+    TimeCorrectionData *tdat_bin = XLALInitTimeCorrections( uvar->outTimeCorr );
+    XLAL_CHECK_MAIN( tdat_bin != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( tdat_bin->nentriesT == tdat->nentriesT && tdat_bin->dtTtable == tdat->dtTtable && tdat_bin->timeCorrStart == tdat->timeCorrStart, XLAL_EFAILED, "Converted time corrections '%s' have inconsistent table header\n", uvar->outTimeCorr );
+    XLAL_CHECK_MAIN( memcmp( tdat_bin->timeCorrs, tdat->timeCorrs, tdat->nentriesT * sizeof(REAL8) ) == 0, XLAL_EFAILED, "Converted time corrections '%s' differ from '%s'\n", uvar->outTimeCorr, uvar->timeCorr );
+    printf( "%s: %u time corrections\n", uvar->outTimeCorr, tdat_bin->nentriesT );
+
+    XLALDestroyTimeCorrectionData( tdat );
+    XLALDestroyTimeCorrectionData( tdat_bin );
+  }
+
+  /* ----- done: free all memory */
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main */
+
+/** Report the maximum differences between an original and a converted ephemeris table */
+static int
+CompareEphemerisTables ( const CHAR *name, const PosVelAcc *table1, INT4 length1, const PosVelAcc *table2, INT4 length2 )
+{
+  XLAL_CHECK( length1 == length2, XLAL_EFAILED, "Converted ephemeris '%s' has %d entries, expected %d\n", name, length2, length1 );
+
+  REAL8 max_dpos = 0, max_dvel = 0, max_dacc = 0;
+  for ( INT4 j = 0; j < length1; ++j ) {
+    XLAL_CHECK( table1[j].gps == table2[j].gps, XLAL_EFAILED, "Converted ephemeris '%s' has time %0.9f in entry %d, expected %0.9f\n", name, table2[j].gps, j, table1[j].gps );
+    for ( int a = 0; a < 3; ++a ) {
+      max_dpos = fmax( max_dpos, fabs( table1[j].pos[a] - table2[j].pos[a] ) );
+      max_dvel = fmax( max_dvel, fabs( table1[j].vel[a] - table2[j].vel[a] ) );
+      max_dacc = fmax( max_dacc, fabs( table1[j].acc[a] - table2[j].acc[a] ) );
+    }
+  }
+  printf( "%s: %d entries, maximum error in position = %g s, velocity = %g, acceleration = %g /s\n", name, length1, max_dpos, max_dvel, max_dacc );
+
+  return XLAL_SUCCESS;
+
+} /* CompareEphemerisTables() */
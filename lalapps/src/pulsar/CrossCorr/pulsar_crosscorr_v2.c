@@ -34,6 +34,12 @@
 #include <lal/PulsarCrossCorr_v2.h>
 #include "CrossCorrToplist.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 /**
  * \author B.Krishnan, S.Larson, J.T.Whelan, Y.Zhang, G.D. Meadors
  * \date 2013, 2014, 2015, 2016, 2017
@@ -100,6 +106,7 @@ typedef struct tagUserInput_t {
   BOOLEAN inclSameDetector;      /**< include cross-correlations of detector with itself */
   BOOLEAN treatWarningsAsErrors; /**< treat any warnings as errors and abort */
   LALStringVector *injectionSources; /**< CSV file list containing sources to inject or '{Alpha=0;Delta=0;...}' */
+  INT4    numThreads;            /**< number of threads used to compute the cross-correlation statistic (without resampling) */
 } UserInput_t;
 
 /* struct to store useful variables */
@@ -117,6 +124,7 @@ typedef struct tagConfigVariables{
 
 #define MYMAX(x,y) ( (x) > (y) ? (x) : (y) )
 #define MYMIN(x,y) ( (x) < (y) ? (x) : (y) )
+#define DEMOD_RUN_LENGTH 256 /* maximum number of frequencies computed for each computation of binary times */
 #define USE_ALIGNED_MEMORY_ROUTINES
 
 /* local function prototypes */
@@ -128,6 +136,7 @@ int GetNextCrossCorrTemplateResamp(BOOLEAN *binaryParamsFlag, BOOLEAN *firstPoin
 int GetNextCrossCorrTemplateForResamp(BOOLEAN *binaryParamsFlag, PulsarDopplerParams *dopplerpos, PulsarDopplerParams *binaryTemplateSpacings, PulsarDopplerParams *minBinaryTemplate, PulsarDopplerParams *maxBinaryTemplate, UINT8 *fCount, UINT8 *aCount, UINT8 *tCount, UINT8 *pCount);
 int demodLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBTimes, PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftFlag, PulsarDopplerParams binaryTemplateSpacings, PulsarDopplerParams minBinaryTemplate, PulsarDopplerParams maxBinaryTemplate, UINT8 fCount, UINT8 aCount, UINT8 tCount, UINT8 pCount, UINT8 fSpacingNum, UINT8 aSpacingNum, UINT8 tSpacingNum, UINT8 pSpacingNum, REAL8Vector *shiftedFreqs, UINT4Vector *lowestBins, COMPLEX8Vector *expSignalPhases, REAL8VectorSequence *sincList, UserInput_t uvar, SFTIndexList *sftIndices, MultiSFTVector *inputSFTs, MultiUINT4Vector *badBins, REAL8 Tsft, MultiNoiseWeights *multiWeights, REAL8 ccStat, REAL8 evSquared, REAL8 estSens, REAL8Vector *GammaAve, SFTPairIndexList *sftPairs, CrossCorrBinaryOutputEntry thisCandidate, toplist_t *ccToplist );
 int resampLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBTimes, PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftFlag, PulsarDopplerParams binaryTemplateSpacings, PulsarDopplerParams minBinaryTemplate, PulsarDopplerParams maxBinaryTemplate, UINT8 fCount, UINT8 aCount, UINT8 tCount, UINT8 pCount, UINT8 fSpacingNum, UINT8 aSpacingNum, UINT8 tSpacingNum, UINT8 pSpacingNum, REAL8Vector *shiftedFreqs, UINT4Vector *lowestBins, COMPLEX8Vector *expSignalPhases, REAL8VectorSequence *sincList, UserInput_t uvar, SFTIndexList *sftIndices, MultiSFTVector *inputSFTs, MultiUINT4Vector *badBins, REAL8 Tsft, MultiNoiseWeights *multiWeights, REAL8 ccStat, REAL8 evSquared, REAL8 estSens, REAL8Vector *GammaAve, SFTPairIndexList *sftPairs, CrossCorrBinaryOutputEntry thisCandidate, toplist_t *ccToplist );
+int demodTemplatesCrossCorr(REAL8 *rho, REAL8 *evSquared, MultiSSBtimes **multiBinaryTimes, MultiSSBtimes *multiSSBTimes, PulsarDopplerParams dopplerpos, const REAL8 *freqs, UINT4 numFreqs, REAL8Vector *shiftedFreqs, UINT4Vector *lowestBins, COMPLEX8Vector *expSignalPhases, REAL8VectorSequence *sincList, const UserInput_t *uvar, SFTIndexList *sftIndices, MultiSFTVector *inputSFTs, MultiUINT4Vector *badBins, REAL8 Tsft, MultiNoiseWeights *multiWeights, REAL8Vector *GammaAve, SFTPairIndexList *sftPairs);
 int resampForLoopCrossCorr(PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftGlag, PulsarDopplerParams binaryTemplateSpacings, PulsarDopplerParams minBinaryTemplate, PulsarDopplerParams maxBinaryTemplate, UINT8 fCount, UINT8 aCount, UINT8 tCount, UINT8 pCount, UINT8 fSpacingNum, UINT8 aSpacingNum, UINT8 tSpacingNum, UINT8 pSpacingNum, UserInput_t uvar, MultiNoiseWeights *multiWeights, REAL8Vector *ccStatVector, REAL8Vector *evSquaredVector, REAL8Vector *numeEquivAve, REAL8Vector *numeEquivCirc, REAL8 estSens, REAL8Vector *resampGammaAve, MultiResampSFTPairMultiIndexList *resampMultiPairs, CrossCorrBinaryOutputEntry thisCandidate, toplist_t *ccToplist, REAL8 tShort, ConfigVariables *config);
 int testShortFunctionsBlock ( UserInput_t uvar, MultiSFTVector *inputSFTs, REAL8 Tsft, REAL8 resampTshort, SFTIndexList **sftIndices, SFTPairIndexList **sftPairs, REAL8Vector** GammaAve, REAL8Vector** GammaCirc, MultiResampSFTPairMultiIndexList **resampMultiPairs, MultiLALDetector* multiDetectors, MultiDetectorStateSeries **multiStates, MultiDetectorStateSeries **resampMultiStates, MultiNoiseWeights **multiWeights,  MultiLIGOTimeGPSVector **multiTimes, MultiLIGOTimeGPSVector **resampMultiTimes, MultiSSBtimes **multiSSBTimes, REAL8VectorSequence **phaseDerivs, gsl_matrix **g_ij, gsl_vector **eps_i, REAL8 estSens, SkyPosition *skypos, PulsarDopplerParams *dopplerpos, PulsarDopplerParams *thisBinaryTemplate, ConfigVariables config, const DopplerCoordinateSystem coordSys );
 UINT4 pcc_count_csv( CHAR *csvline );
@@ -192,6 +201,13 @@ int main(int argc, char *argv[]){
   if (should_exit)
     return EXIT_FAILURE;
 
+  XLALUserVarCheck( &should_exit, uvar.numThreads > 0, UVAR_STR( numThreads ) " must be strictly positive" );
+#ifndef _OPENMP
+  XLALUserVarCheck( &should_exit, uvar.numThreads == 1, UVAR_STR( numThreads ) " must be 1 since lalapps was built without OpenMP support" );
+#endif
+  if (should_exit)
+    return EXIT_FAILURE;
+
   CHAR *VCSInfoString = XLALVCSInfoString(lalAppsVCSInfoList, 0, "%% ");     /**<LAL + LALapps Vsersion string*/
 
   /* configure useful variables based on user input */
@@ -946,7 +962,10 @@ int main(int argc, char *argv[]){
         LogPrintf ( LOG_CRITICAL, "%s: XLALCreateREAL8Vector() failed with errno=%d\n", __func__, xlalErrno );
         XLAL_ERROR( XLAL_EFUNC );
       }
-      demodLoopCrossCorr(multiBinaryTimes, multiSSBTimes, dopplerpos, dopplerShiftFlag, binaryTemplateSpacings, minBinaryTemplate, maxBinaryTemplate, fCount, aCount, tCount, pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum, shiftedFreqs, lowestBins, expSignalPhases, sincList, uvar, sftIndices, inputSFTs, badBins, Tsft, multiWeights, ccStat, evSquared, estSens, GammaAve, sftPairs, thisCandidate, ccToplist );
+      if ( demodLoopCrossCorr(multiBinaryTimes, multiSSBTimes, dopplerpos, dopplerShiftFlag, binaryTemplateSpacings, minBinaryTemplate, maxBinaryTemplate, fCount, aCount, tCount, pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum, shiftedFreqs, lowestBins, expSignalPhases, sincList, uvar, sftIndices, inputSFTs, badBins, Tsft, multiWeights, ccStat, evSquared, estSens, GammaAve, sftPairs, thisCandidate, ccToplist ) != XLAL_SUCCESS ) {
+        LogPrintf ( LOG_CRITICAL, "%s: demodLoopCrossCorr() failed with errno=%d\n", __func__, xlalErrno );
+        XLAL_ERROR( XLAL_EFUNC );
+      }
       XLALDestroyMultiSFTVector ( inputSFTs );
       XLALDestroyCOMPLEX8Vector ( expSignalPhases );
   } 
@@ -1133,6 +1152,7 @@ int XLALInitUserVars (UserInput_t *uvar)
   uvar->treatWarningsAsErrors = TRUE;
   uvar->testShortFunctions = FALSE;
   uvar->testResampNoTShort = FALSE;
+  uvar->numThreads = 1;
 
   /* register  user-variables */
   XLALRegisterUvarMember( startTime,       INT4, 0,  REQUIRED, "Desired start time of analysis in GPS seconds (SFT timestamps must be >= this)");
@@ -1183,6 +1203,7 @@ int XLALInitUserVars (UserInput_t *uvar)
   XLALRegisterUvarMember( inclSameDetector, BOOLEAN, 0, OPTIONAL, "Cross-correlate a detector with itself at a different time (if inclAutoCorr, then also same time)");
   XLALRegisterUvarMember( treatWarningsAsErrors, BOOLEAN, 0, OPTIONAL, "Abort program if any warnings arise (for e.g., zero-maxLag radiometer mode)");
   XLALRegisterUvarMember( injectionSources, STRINGVector, 0 , OPTIONAL, "CSV file list containing sources to inject or '{Alpha=0;Delta=0;...}'");
+  XLALRegisterUvarMember( numThreads, INT4, 0, OPTIONAL, "Number of threads used to compute the cross-correlation statistic over blocks of templates (without resampling)");
   if ( xlalErrno ) {
     XLALPrintError ("%s: user variable initialization failed with errno = %d.\n", __func__, xlalErrno );
     XLAL_ERROR ( XLAL_EFUNC );
@@ -1564,60 +1585,155 @@ INT4 XLALFindBadBins
 
 }
 
-/** Function to isolate the loop for demod */
+/**
+ * Function to isolate the loop for demod. Templates are collected in blocks of runs of
+ * consecutive frequencies at the same orbital parameters; the runs of each block are
+ * computed in parallel, each by a single thread which reuses its binary times for every
+ * frequency, and the results are added to the toplist in template order.
+ */
 int demodLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBTimes, PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftFlag, PulsarDopplerParams binaryTemplateSpacings, PulsarDopplerParams minBinaryTemplate, PulsarDopplerParams maxBinaryTemplate, UINT8 fCount, UINT8 aCount, UINT8 tCount, UINT8 pCount, UINT8 fSpacingNum, UINT8 aSpacingNum, UINT8 tSpacingNum, UINT8 pSpacingNum, REAL8Vector *shiftedFreqs, UINT4Vector *lowestBins, COMPLEX8Vector *expSignalPhases, REAL8VectorSequence *sincList, UserInput_t uvar, SFTIndexList *sftIndices, MultiSFTVector *inputSFTs, MultiUINT4Vector *badBins, REAL8 Tsft, MultiNoiseWeights *multiWeights, REAL8 ccStat, REAL8 evSquared, REAL8 estSens, REAL8Vector *GammaAve, SFTPairIndexList *sftPairs, CrossCorrBinaryOutputEntry thisCandidate, toplist_t *ccToplist ){
   /* args should be : spacings, min and max doppler params */
   BOOLEAN firstPoint = TRUE; /* a boolean to help to search at the beginning point in parameter space, after the search it is set to be FALSE to end the loop*/
-  if ( (XLALAddMultiBinaryTimes( &multiBinaryTimes, multiSSBTimes, &dopplerpos )  != XLAL_SUCCESS ) ) {
-    LogPrintf ( LOG_CRITICAL, "%s: XLALAddMultiBinaryTimes() failed with errno=%d\n", __func__, xlalErrno );
-    XLAL_ERROR( XLAL_EFUNC );
-  } /*Need to apply additional doppler shifting before the loop, or the first point in parameter space will be lost and return a wrong SNR when fBand!=0*/
+
+  /* runs are handed out to threads dynamically, so give each thread several runs to balance their work */
+  const UINT4 numThreads = uvar.numThreads;
+  const UINT4 maxRuns = ( numThreads > 1 ) ? 16 * numThreads : 1;
+  const UINT4 numSFTs = sftIndices->length;
+
+  /* per-block template storage: orbital parameters and first template of each run, and frequency and results of each template */
+  PulsarDopplerParams *runDopplerpos = XLALCalloc ( maxRuns, sizeof ( *runDopplerpos ) );
+  UINT4 *runFirst = XLALCalloc ( maxRuns + 1, sizeof ( *runFirst ) );
+  REAL8 *templFreqs = XLALCalloc ( maxRuns * DEMOD_RUN_LENGTH, sizeof ( *templFreqs ) );
+  REAL8 *templRho = XLALCalloc ( maxRuns * DEMOD_RUN_LENGTH, sizeof ( *templRho ) );
+  REAL8 *templEvSquared = XLALCalloc ( maxRuns * DEMOD_RUN_LENGTH, sizeof ( *templEvSquared ) );
+  XLAL_CHECK ( runDopplerpos != NULL && runFirst != NULL && templFreqs != NULL && templRho != NULL && templEvSquared != NULL, XLAL_ENOMEM );
+
+  /* per-thread buffers: thread 0 uses those passed in */
+  MultiSSBtimes *XLAL_INIT_DECL( threadBinaryTimes, [numThreads] );
+  REAL8Vector *XLAL_INIT_DECL( threadShiftedFreqs, [numThreads] );
+  UINT4Vector *XLAL_INIT_DECL( threadLowestBins, [numThreads] );
+  COMPLEX8Vector *XLAL_INIT_DECL( threadExpSignalPhases, [numThreads] );
+  REAL8VectorSequence *XLAL_INIT_DECL( threadSincList, [numThreads] );
+  threadBinaryTimes[0] = multiBinaryTimes;
+  threadShiftedFreqs[0] = shiftedFreqs;
+  threadLowestBins[0] = lowestBins;
+  threadExpSignalPhases[0] = expSignalPhases;
+  threadSincList[0] = sincList;
+  for ( UINT4 t = 1; t < numThreads; ++t ) {
+    XLAL_CHECK ( ( threadShiftedFreqs[t] = XLALCreateREAL8Vector ( numSFTs ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( ( threadLowestBins[t] = XLALCreateUINT4Vector ( numSFTs ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( ( threadExpSignalPhases[t] = XLALCreateCOMPLEX8Vector ( numSFTs ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( ( threadSincList[t] = XLALCreateREAL8VectorSequence ( numSFTs, uvar.numBins ) ) != NULL, XLAL_EFUNC );
+  }
 
   //fprintf(stdout, "Resampling? %s \n", uvar.resamp ? "true" : "false");
 
-  while ( GetNextCrossCorrTemplate(&dopplerShiftFlag, &firstPoint, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum) == 0)
+  /* the first template is at the starting orbital parameters; a new run starts whenever the orbital parameters change */
+  BOOLEAN haveTemplate = ( GetNextCrossCorrTemplate(&dopplerShiftFlag, &firstPoint, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum) == 0 );
+  BOOLEAN newRun = TRUE;
+  while ( haveTemplate )
     {
-      /* do useful stuff here*/
 
-      /* Apply additional Doppler shifting using current binary orbital parameters */
-      /* Might want to be clever about checking whether we've changed the orbital parameters or only the frequency */
-      if (dopplerShiftFlag == TRUE)
+      /* collect a block of runs of templates */
+      UINT4 numRuns = 0;
+      runFirst[0] = 0;
+      while ( haveTemplate )
 	{
-	  if ( (XLALAddMultiBinaryTimes( &multiBinaryTimes, multiSSBTimes, &dopplerpos )  != XLAL_SUCCESS ) ) {
-	    LogPrintf ( LOG_CRITICAL, "%s: XLALAddMultiBinaryTimes() failed with errno=%d\n", __func__, xlalErrno );
-	    XLAL_ERROR( XLAL_EFUNC );
-	  }
+	  if ( numRuns == 0 || newRun || runFirst[numRuns] - runFirst[numRuns - 1] == DEMOD_RUN_LENGTH )
+	    {
+	      if ( numRuns == maxRuns )
+		break;
+	      runDopplerpos[numRuns] = dopplerpos;
+	      ++numRuns;
+	      runFirst[numRuns] = runFirst[numRuns - 1];
+	      newRun = FALSE;
+	    }
+	  templFreqs[runFirst[numRuns]++] = dopplerpos.fkdot[0];
+	  haveTemplate = ( GetNextCrossCorrTemplate(&dopplerShiftFlag, &firstPoint, &dopplerpos, &binaryTemplateSpacings, &minBinaryTemplate, &maxBinaryTemplate, &fCount, &aCount, &tCount, &pCount, fSpacingNum, aSpacingNum, tSpacingNum, pSpacingNum) == 0 );
+	  newRun = ( dopplerShiftFlag == TRUE );
 	}
 
-      if ( (XLALGetDopplerShiftedFrequencyInfo( shiftedFreqs, lowestBins, expSignalPhases, sincList, uvar.numBins, &dopplerpos, sftIndices, inputSFTs, multiBinaryTimes, badBins, Tsft )  != XLAL_SUCCESS ) ) {
-	LogPrintf ( LOG_CRITICAL, "%s: XLALGetDopplerShiftedFrequencyInfo() failed with errno=%d\n", __func__, xlalErrno );
-	XLAL_ERROR( XLAL_EFUNC );
-      }
-
-      if ( (XLALCalculatePulsarCrossCorrStatistic( &ccStat, &evSquared, GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, inputSFTs, multiWeights, uvar.numBins)  != XLAL_SUCCESS ) ) {
-	LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatistic() failed with errno=%d\n", __func__, xlalErrno );
-	XLAL_ERROR( XLAL_EFUNC );
+      /* compute the cross-correlation statistic for each run */
+      int nerrors = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads) reduction(+:nerrors)
+      for ( UINT4 r = 0; r < numRuns; ++r ) {
+#ifdef _OPENMP
+	const int t = omp_get_thread_num();
+#else
+	const int t = 0;
+#endif
+	if ( nerrors == 0 && demodTemplatesCrossCorr( &templRho[runFirst[r]], &templEvSquared[runFirst[r]], &threadBinaryTimes[t], multiSSBTimes, runDopplerpos[r], &templFreqs[runFirst[r]], runFirst[r + 1] - runFirst[r], threadShiftedFreqs[t], threadLowestBins[t], threadExpSignalPhases[t], threadSincList[t], &uvar, sftIndices, inputSFTs, badBins, Tsft, multiWeights, GammaAve, sftPairs ) != XLAL_SUCCESS ) {
+	  ++nerrors;
+	}
       }
+      XLAL_CHECK ( nerrors == 0, XLAL_EFUNC, "Failed to compute cross-correlation statistic" );
 
       /* fill candidate struct and insert into toplist if necessary */
-      thisCandidate.freq = dopplerpos.fkdot[0];
-      thisCandidate.tp = XLALGPSGetREAL8( &dopplerpos.tp );
-      thisCandidate.argp = dopplerpos.argp;
-      thisCandidate.asini = dopplerpos.asini;
-      thisCandidate.ecc = dopplerpos.ecc;
-      thisCandidate.period = dopplerpos.period;
-      thisCandidate.rho = ccStat;
-      thisCandidate.evSquared = evSquared;
-      thisCandidate.estSens = estSens;
-
-      insert_into_crossCorrBinary_toplist(ccToplist, thisCandidate);
+      for ( UINT4 r = 0; r < numRuns; ++r )
+	{
+	  for ( UINT4 i = runFirst[r]; i < runFirst[r + 1]; ++i )
+	    {
+	      thisCandidate.freq = templFreqs[i];
+	      thisCandidate.tp = XLALGPSGetREAL8( &runDopplerpos[r].tp );
+	      thisCandidate.argp = runDopplerpos[r].argp;
+	      thisCandidate.asini = runDopplerpos[r].asini;
+	      thisCandidate.ecc = runDopplerpos[r].ecc;
+	      thisCandidate.period = runDopplerpos[r].period;
+	      thisCandidate.rho = templRho[i];
+	      thisCandidate.evSquared = templEvSquared[i];
+	      thisCandidate.estSens = estSens;
+
+	      insert_into_crossCorrBinary_toplist(ccToplist, thisCandidate);
+	    }
+	}
 
       //fprintf(stdout,"Inner loop: freq %f , tp %f , asini %f \n", thisCandidate.freq, thisCandidate.tp, thisCandidate.asini);
 
     } /* end while loop over templates */
-    return 0;
+
+  for ( UINT4 t = 1; t < numThreads; ++t ) {
+    XLALDestroyMultiSSBtimes ( threadBinaryTimes[t] );
+    XLALDestroyREAL8Vector ( threadShiftedFreqs[t] );
+    XLALDestroyUINT4Vector ( threadLowestBins[t] );
+    XLALDestroyCOMPLEX8Vector ( threadExpSignalPhases[t] );
+    XLALDestroyREAL8VectorSequence ( threadSincList[t] );
+  }
+  XLALFree ( runDopplerpos );
+  XLALFree ( runFirst );
+  XLALFree ( templFreqs );
+  XLALFree ( templRho );
+  XLALFree ( templEvSquared );
+
+  return XLAL_SUCCESS;
 } /* end demodLoopCrossCorr */
 
+/** Compute the cross-correlation statistic for a run of frequencies at the same orbital parameters */
+int demodTemplatesCrossCorr(REAL8 *rho, REAL8 *evSquared, MultiSSBtimes **multiBinaryTimes, MultiSSBtimes *multiSSBTimes, PulsarDopplerParams dopplerpos, const REAL8 *freqs, UINT4 numFreqs, REAL8Vector *shiftedFreqs, UINT4Vector *lowestBins, COMPLEX8Vector *expSignalPhases, REAL8VectorSequence *sincList, const UserInput_t *uvar, SFTIndexList *sftIndices, MultiSFTVector *inputSFTs, MultiUINT4Vector *badBins, REAL8 Tsft, MultiNoiseWeights *multiWeights, REAL8Vector *GammaAve, SFTPairIndexList *sftPairs){
+
+  /* Apply additional Doppler shifting using the orbital parameters of this run */
+  if ( (XLALAddMultiBinaryTimes( multiBinaryTimes, multiSSBTimes, &dopplerpos )  != XLAL_SUCCESS ) ) {
+    LogPrintf ( LOG_CRITICAL, "%s: XLALAddMultiBinaryTimes() failed with errno=%d\n", __func__, xlalErrno );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  for ( UINT4 i = 0; i < numFreqs; ++i )
+    {
+      dopplerpos.fkdot[0] = freqs[i];
+
+      if ( (XLALGetDopplerShiftedFrequencyInfo( shiftedFreqs, lowestBins, expSignalPhases, sincList, uvar->numBins, &dopplerpos, sftIndices, inputSFTs, *multiBinaryTimes, badBins, Tsft )  != XLAL_SUCCESS ) ) {
+	LogPrintf ( LOG_CRITICAL, "%s: XLALGetDopplerShiftedFrequencyInfo() failed with errno=%d\n", __func__, xlalErrno );
+	XLAL_ERROR( XLAL_EFUNC );
+      }
+
+      if ( (XLALCalculatePulsarCrossCorrStatistic( &rho[i], &evSquared[i], GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, inputSFTs, multiWeights, uvar->numBins)  != XLAL_SUCCESS ) ) {
+	LogPrintf ( LOG_CRITICAL, "%s: XLALCalculatePulsarCrossCorrStatistic() failed with errno=%d\n", __func__, xlalErrno );
+	XLAL_ERROR( XLAL_EFUNC );
+      }
+    }
+
+  return XLAL_SUCCESS;
+} /* end demodTemplatesCrossCorr */
+
 /** Function to isolate the loop for resampling */
 int resampLoopCrossCorr(MultiSSBtimes *multiBinaryTimes, MultiSSBtimes *multiSSBTimes, PulsarDopplerParams dopplerpos, BOOLEAN dopplerShiftFlag, PulsarDopplerParams binaryTemplateSpacings, PulsarDopplerParams minBinaryTemplate, PulsarDopplerParams maxBinaryTemplate, UINT8 fCount, UINT8 aCount, UINT8 tCount, UINT8 pCount, UINT8 fSpacingNum, UINT8 aSpacingNum, UINT8 tSpacingNum, UINT8 pSpacingNum, REAL8Vector *shiftedFreqs, UINT4Vector *lowestBins, COMPLEX8Vector *expSignalPhases, REAL8VectorSequence *sincList, UserInput_t uvar, SFTIndexList *sftIndices, MultiSFTVector *inputSFTs, MultiUINT4Vector *badBins, REAL8 Tsft, MultiNoiseWeights *multiWeights, REAL8 ccStat, REAL8 evSquared, REAL8 estSens, REAL8Vector *GammaAve, SFTPairIndexList *sftPairs, CrossCorrBinaryOutputEntry thisCandidate, toplist_t *ccToplist ){
   /* args should be : spacings, min and max doppler params */
@@ -43,6 +43,10 @@ and reheterodyne with this phase difference. */
 
 #include "heterodyne_pulsar.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /* define a macro to round a number without having to use the C round function */
 #define ROUND(a) (floor(a+0.5))
 
@@ -77,7 +81,6 @@ int main(int argc, char *argv[]){
   Filters iirFilters;
 
   LALFILE *fpin=NULL;
-  FILE *fpout=NULL;
   static FrameCache cache;
   INT4 count=0, frcount=0;
 
@@ -102,23 +105,23 @@ int main(int argc, char *argv[]){
 
   if( inputParams.verbose ) verbose=1;
 
+  /* heterodyne a list of pulsars from a single pass through the frame data */
+  if( inputParams.paramfilelist != NULL )
+    return heterodyne_pulsar_list(&inputParams, argc, argv);
+
   hetParams.heterodyneflag = inputParams.heterodyneflag; /* set type of heterodyne */
 
   /* read in pulsar data */
   hetParams.het = XLALReadTEMPOParFile( inputParams.paramfile );
   hetParams.hetUpdate = NULL;
   hetParams.outputPhase = inputParams.outputPhase;
+  hetParams.offset = 0;
+  hetParams.edat = NULL;
+  hetParams.tdat = NULL;
+  hetParams.earth = NULL;
 
   /* set pulsar name - take from par file if available, or if not get from command line args */
-  if( PulsarCheckParam( hetParams.het, "PSRJ" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "PSRJ" );
-  else if( PulsarCheckParam( hetParams.het, "PSRB" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "PSRB" );
-  else if( PulsarCheckParam( hetParams.het, "NAME" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "NAME" );
-  else if( PulsarCheckParam( hetParams.het, "PSR" ) )
-    psrname = PulsarGetStringParam( hetParams.het, "PSR" );
-  else{
+  if( (psrname = get_pulsar_name( hetParams.het )) == NULL ){
     fprintf(stderr, "No pulsar name specified!\n");
     exit(0);
   }
@@ -200,26 +203,17 @@ int main(int argc, char *argv[]){
   }
 
   if( inputParams.heterodyneflag > 0 ){
-    snprintf(hetParams.earthfile, sizeof(hetParams.earthfile), "%s",
-      inputParams.earthfile);
-    snprintf(hetParams.sunfile, sizeof(hetParams.sunfile), "%s",
-      inputParams.sunfile);
+    /* set up ephemeris files - these are read in once for all the data */
+    XLAL_CHECK_MAIN( (hetParams.edat = XLALInitBarycenter( inputParams.earthfile,
+      inputParams.sunfile )) != NULL, XLAL_EFUNC );
 
-    if( inputParams.timeCorrFile != NULL ){
-      hetParams.timeCorrFile = XLALStringDuplicate( inputParams.timeCorrFile );
+    hetParams.ttype = get_time_correction_type( hetParams.hetUpdate,
+      inputParams.timeCorrFile );
 
-      if ( PulsarCheckParam( hetParams.hetUpdate, "UNITS" ) ){
-        if ( !strcmp( PulsarGetStringParam( hetParams.hetUpdate, "UNITS" ), "TDB" ) )
-          hetParams.ttype = TIMECORRECTION_TDB; /* use TDB units i.e. TEMPO standard */
-        else
-          hetParams.ttype = TIMECORRECTION_TCB; /* default to TCB i.e. TEMPO2 standard */
-      }
-      else /* don't recognise units type, so default to the original code */
-        hetParams.ttype = TIMECORRECTION_ORIGINAL;
-    }
-    else{
-      hetParams.timeCorrFile = NULL;
-      hetParams.ttype = TIMECORRECTION_ORIGINAL;
+    /* get files containing Einstein delay correction look-up table */
+    if ( hetParams.ttype != TIMECORRECTION_ORIGINAL ){
+      XLAL_CHECK_MAIN( (hetParams.tdat = XLALInitTimeCorrections(
+        inputParams.timeCorrFile ) ) != NULL, XLAL_EFUNC );
     }
   }
 
@@ -247,58 +241,7 @@ int main(int argc, char *argv[]){
 
   if(inputParams.heterodyneflag == 0 || inputParams.heterodyneflag == 3){
     /* input comes from frame files so read in frame filenames */
-    CHAR det[10]; /* detector from cache file */
-    CHAR type[256]; /* frame type e.g. RDS_R_L3 - from cache file */
-    INT4 cachecount=0, ch=0;
-
-    /* count the number of frame files in the cache file */
-    while( (ch = XLALFileGetc(fpin) ) != EOF ){
-      if( ch == '\n' ) cachecount++;
-    }
-
-    /* rewind file pointer */
-    XLALFileRewind(fpin);
-
-    /* allocate memory for frame cache information */
-    {
-      INT4 ii=0;
-
-      if( (cache.starttime = XLALCalloc(cachecount, sizeof(INT4))) == NULL ||
-          (cache.duration = XLALCalloc(cachecount, sizeof(INT4))) == NULL ||
-          (cache.framelist = XLALCalloc(cachecount, sizeof(CHAR *))) == NULL )
-        {  XLALPrintError("Error allocating frame cache memory.\n");  }
-
-      for( ii=0; ii<cachecount; ii++ ){
-        if( (cache.framelist[ii] = XLALCalloc(MAXSTRLENGTH, sizeof(CHAR))) == NULL )
-          {  XLALPrintError("Error allocating frame list memory.\n");  }
-      }
-    }
-
-    frcount=0;
-    do{
-      CHAR linebuf[1024]; // buffer for each line
-      if ( XLALFileGets(&linebuf[0], 1024, fpin) == NULL ){
-        // skip this line
-        continue;
-      }
-
-      if ( sscanf(linebuf, "%s%s%d%d file://localhost%s", det, type, &cache.starttime[frcount], &cache.duration[frcount],
-             cache.framelist[frcount]) != 5 ){
-        // skip this line
-        continue;
-      }
-
-      frcount++;
-    }while( !XLALFileEOF(fpin) );
-    XLALFileClose(fpin);
-
-    if( frcount != cachecount ){
-      fprintf(stderr, "Error... There's been a problem reading in the frame \
-data!\n");
-      return 1;
-    }
-
-    cache.length = cachecount;
+    if( (frcount = read_frame_cache(&cache, fpin)) < 0 ) return 1;
 
     if(verbose){  fprintf(stderr, "I've read in the frame list.\n");  }
   }
@@ -345,44 +288,8 @@ data!\n");
     strloc[0] = '\0';
   }
 
-  /* add header to the files: header information will be a string consisting of several lines starting with %%s.
-   *  - the first line will contain the time and date of the file creation
-   *  - the next set of lines will contain the version and git hash of the lalsuite versions
-   *  - the penulimate line will contain the command line inputs used to create the file
-   *  - the final will contain headers for the three columns in the file: GPS time, Real, Imag */
-  if( (fpout = fopen(outputfile, "w")) == NULL ){
-    fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
-    return 0;
-  }
-
-  CHAR *headerinfo = XLALStringDuplicate("%% File created on ");
-  headerinfo = XLALStringAppend(headerinfo, LogTimeToString( XLALGetTimeOfDay() ));
-  headerinfo = XLALStringAppend(headerinfo, "\n");
-  headerinfo = XLALStringAppend(headerinfo, XLALGetVersionString( 0 ) );
-  headerinfo = XLALStringAppend(headerinfo, "%% ");
-  for ( INT4 j=0; j<argc; j++ ) {
-    headerinfo = XLALStringAppend(headerinfo, argv[j]);
-    headerinfo = XLALStringAppend(headerinfo, " ");
-  }
-  CHAR dataline[] = "\n%% GPS time\tReal\tImag\n";
-  if ( strlen(headerinfo)+strlen(dataline) > HEADERSIZE ) {
-    fprintf(stderr, "Error... HEADERSIZE needs to be increased to accommodate information\n");
-    return 0;
-  }
-  else{
-    /* fill in rest of string with whitespace */
-    for ( INT4 j=strlen(headerinfo); j<HEADERSIZE; j++ ){ headerinfo = XLALStringAppend(headerinfo, " "); }
-    memcpy(&headerinfo[HEADERSIZE-strlen(dataline)], &dataline[0], sizeof(CHAR)*strlen(dataline));
-
-    /* output the header to the file */
-    size_t rc = fwrite(&headerinfo[0], sizeof(CHAR), HEADERSIZE, fpout);
-    if ( ferror(fpout) || !rc ){
-      fprintf(stderr, "Error... problem writing out header data!\n");
-      exit(1);
-    }
-  }
-  XLALFree( headerinfo );
-  fclose(fpout);
+  /* add header to the file */
+  if( write_output_header(outputfile, argc, argv) ) return 0;
 
   snprintf(channel, sizeof(channel), "%s", inputParams.channel);
 
@@ -644,97 +551,14 @@ data!\n");
 
     XLALDestroyCOMPLEX16TimeSeries( data );
 
-    /*perform outlier removal twice incase very large outliers skew the stddev*/
-    if( inputParams.stddevthresh != 0. ){
-      INT4 numOutliers=0;
-      numOutliers = remove_outliers(resampData, times,
-        inputParams.stddevthresh);
-      if( verbose ){
-        fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 1st time.\n",
-          100.*(double)numOutliers/(double)resampData->data->length,
-          inputParams.stddevthresh);
-      }
-    }
-
-    /* calibrate */
-    if( inputParams.calibrate ){
-      calibrate(resampData, times, inputParams.calibfiles,
-        inputParams.freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ), inputParams.channel);
-      if( verbose ){ fprintf(stderr, "I've calibrated the data at %.1lf Hz\n", inputParams.freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ));  }
-    }
-
-    /* remove outliers above our threshold */
-    if( inputParams.stddevthresh != 0. ){
-      INT4 numOutliers = 0;
-      numOutliers = remove_outliers(resampData, times,
-        inputParams.stddevthresh);
-      if( verbose ){
-        fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 2nd time.\n",
-          100.*(double)numOutliers/(double)resampData->data->length,
-          inputParams.stddevthresh);
-      }
-    }
+    /* remove outliers and calibrate */
+    clean_data(resampData, times, &inputParams,
+      inputParams.freqfactor*PulsarGetREAL8VectorParamIndividual( hetParams.het, "F0" ));
 
     /* output data */
-    if( inputParams.binaryoutput ){
-      if((fpout = fopen(outputfile, "ab"))==NULL){
-        fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
-        return 0;
-      }
-    }
-    else{
-      if( (fpout = fopen(outputfile, "a")) == NULL ){
-        fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
-        return 0;
-      }
-    }
-
-    /* buffer the output, so that file system is not thrashed when outputing */
-    /* buffer will be 1Mb */
-    if( setvbuf(fpout, NULL, _IOFBF, 0x100000) ){ fprintf(stderr, "Warning: Unable to set output file buffer!"); }
-
-    for( i=0;i<(INT4)resampData->data->length;i++ ){
-      /* if data has been scaled then undo scaling for output */
-
-      if( inputParams.binaryoutput ){
-        size_t rc = 0;
-        REAL8 tempreal, tempimag;
-
-        tempreal = creal(resampData->data->data[i]);
-        tempimag = cimag(resampData->data->data[i]);
-
-        /* binary output will be same as ASCII text - time real imag */
-        if( inputParams.scaleFac > 1.0 ){
-          tempreal /= inputParams.scaleFac;
-          tempimag /= inputParams.scaleFac;
-        }
-
-        rc = fwrite(&times->data[i], sizeof(REAL8), 1, fpout);
-        rc = fwrite(&tempreal, sizeof(REAL8), 1, fpout);
-        rc = fwrite(&tempimag, sizeof(REAL8), 1, fpout);
-
-        if( ferror(fpout) || !rc ){
-          fprintf(stderr, "Error... problem writing out data to binary file!\n");
-          exit(1);
-        }
-      }
-      else{
-        if( inputParams.scaleFac > 1.0 ){
-          fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
-                  creal(resampData->data->data[i])/inputParams.scaleFac,
-                  cimag(resampData->data->data[i])/inputParams.scaleFac);
-        }
-        else{
-          fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
-            creal(resampData->data->data[i]), cimag(resampData->data->data[i]));
-        }
-      }
-
-    }
+    if( output_data(outputfile, resampData, times, &inputParams) ) return 0;
     if( verbose ){ fprintf(stderr, "I've output the data.\n"); }
 
-    fclose(fpout);
-
     XLALDestroyCOMPLEX16TimeSeries( resampData );
 
     XLALDestroyREAL8Vector( times );
@@ -769,18 +593,16 @@ data!\n");
   }
 
   if( inputParams.filterknee > 0. ){
-    XLALDestroyREAL8IIRFilter( iirFilters.filter1Re );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter1Im );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter2Re );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter2Im );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter3Re );
-    XLALDestroyREAL8IIRFilter( iirFilters.filter3Im );
+    destroy_filters( &iirFilters );
 
     if( verbose ){ fprintf(stderr, "I've destroyed all filters.\n"); }
   }
 
   if ( filtresp != NULL ){ destroy_filter_response( filtresp ); }
 
+  if( hetParams.edat != NULL ){ XLALDestroyEphemerisData( hetParams.edat ); }
+  if( hetParams.tdat != NULL ){ XLALDestroyTimeCorrectionData( hetParams.tdat ); }
+
   PulsarFreeParams( hetParams.het );
   if ( inputParams.heterodyneflag == 2 || inputParams.heterodyneflag == 4 ){ PulsarFreeParams( hetParams.hetUpdate ); }
 
@@ -801,6 +623,7 @@ void get_input_args(InputParams *inputParams, int argc, char *argv[]){
     { "heterodyne-flag",          required_argument,  0, 'z' },
     { "param-file",               required_argument,  0, 'f' },
     { "param-file-update",        required_argument,  0, 'g' },
+    { "param-file-list",          required_argument,  0, 'X' },
     { "filter-knee",              required_argument,  0, 'k' },
     { "sample-rate",              required_argument,  0, 's' },
     { "resample-rate",            required_argument,  0, 'r' },
@@ -831,11 +654,12 @@ void get_input_args(InputParams *inputParams, int argc, char *argv[]){
     { 0, 0, 0, 0 }
   };
 
-  char args[] = "hi:p:z:f:g:k:s:r:d:D:c:o:e:S:t:l:R:C:F:O:T:m:G:H:M:ABbZLvP";
+  char args[] = "hi:p:z:f:g:X:k:s:r:d:D:c:o:e:S:t:l:R:C:F:O:T:m:G:H:M:ABbZLvP";
   char *program = argv[0];
 
   /* set defaults */
   inputParams->pulsar = NULL;
+  inputParams->paramfilelist = NULL;
   inputParams->filterknee = 0.; /* default is not to filter */
   inputParams->resamplerate = 0.; /* resample to 1 Hz */
   inputParams->samplerate = 0.;
@@ -919,6 +743,9 @@ the pulsar parameter file */
         snprintf(inputParams->paramfileupdate,
           sizeof(inputParams->paramfileupdate), "%s", LALoptarg);
         break;
+      case 'X': /* file containing a list of pulsar parameter files */
+        inputParams->paramfilelist = XLALStringDuplicate( LALoptarg );
+        break;
       case 'k': /* low-pass filter knee frequency */
         {/* find if the string contains a / and get its position */
           CHAR *loc=NULL;
@@ -1104,6 +931,64 @@ heterodyne!\n");
       exit(1);
     }
   }
+
+  /* check that a list of pulsars is only used when reading from frame files,
+     and that each pulsar gets its own output file */
+  if(inputParams->paramfilelist != NULL){
+    CHAR *loc = strstr(inputParams->outputfile, "%s");
+
+    if(inputParams->heterodyneflag != 0 && inputParams->heterodyneflag != 3){
+      fprintf(stderr, "Error... a list of pulsar parameter files can only be \
+used for a coarse (0) or full (3) heterodyne.\n");
+      exit(1);
+    }
+
+    if(loc == NULL || strchr(loc+2, '%') != NULL ||
+       strchr(inputParams->outputfile, '%') != loc){
+      fprintf(stderr, "Error... output file must contain a single %%s to be \
+replaced by the pulsar name when using a list of pulsar parameter files.\n");
+      exit(1);
+    }
+
+    if(inputParams->outputPhase){
+      fprintf(stderr, "Error... the phase evolution cannot be output when using \
+a list of pulsar parameter files.\n");
+      exit(1);
+    }
+  }
+}
+
+/* function to get the pulsar name from its parameters - returns NULL if no
+   name is given */
+const CHAR *get_pulsar_name(PulsarParameters *params){
+  if( PulsarCheckParam( params, "PSRJ" ) )
+    return PulsarGetStringParam( params, "PSRJ" );
+  else if( PulsarCheckParam( params, "PSRB" ) )
+    return PulsarGetStringParam( params, "PSRB" );
+  else if( PulsarCheckParam( params, "NAME" ) )
+    return PulsarGetStringParam( params, "NAME" );
+  else if( PulsarCheckParam( params, "PSR" ) )
+    return PulsarGetStringParam( params, "PSR" );
+
+  return NULL;
+}
+
+/* function to get the time system used by the pulsar parameters */
+TimeCorrectionType get_time_correction_type(PulsarParameters *params,
+  CHAR *timeCorrFile){
+  /* without a time correction file use the original code */
+  if( timeCorrFile == NULL )
+    return TIMECORRECTION_ORIGINAL;
+
+  if ( PulsarCheckParam( params, "UNITS" ) ){
+    if ( !strcmp( PulsarGetStringParam( params, "UNITS" ), "TDB" ) )
+      return TIMECORRECTION_TDB; /* use TDB units i.e. TEMPO standard */
+    else
+      return TIMECORRECTION_TCB; /* default to TCB i.e. TEMPO2 standard */
+  }
+
+  /* don't recognise units type, so default to the original code */
+  return TIMECORRECTION_ORIGINAL;
 }
 
 /* heterodyne data function */
@@ -1114,8 +999,6 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
   REAL8 dtpos=0.; /* time between position epoch and data timestamp */
   INT4 i=0;
 
-  EphemerisData *edat=NULL;
-  TimeCorrectionData *tdat=NULL;
   BarycenterInput baryinput, baryinput2;
   EarthState earth, earth2;
   EmissionTime  emit, emit2;
@@ -1158,15 +1041,10 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
 
   T0 = pepoch;
 
-  /* set up ephemeris files */
+  /* set up barycentring (ephemerides are read in once by the caller) */
   if( hetParams.heterodyneflag > 0){
-    XLAL_CHECK_VOID( (edat = XLALInitBarycenter( hetParams.earthfile, hetParams.sunfile )) != NULL, XLAL_EFUNC );
-
-    /* get files containing Einstein delay correction look-up table */
-    if ( hetParams.ttype != TIMECORRECTION_ORIGINAL ){
-      XLAL_CHECK_VOID( (tdat = XLALInitTimeCorrections(
-        hetParams.timeCorrFile ) ) != NULL, XLAL_EFUNC );
-    }
+    XLAL_CHECK_VOID( hetParams.edat != NULL, XLAL_EFAULT );
+    XLAL_CHECK_VOID( hetParams.ttype == TIMECORRECTION_ORIGINAL || hetParams.tdat != NULL, XLAL_EFAULT );
 
     /* set up location of detector */
     baryinput.site.location[0] = hetParams.detector.location[0]/LAL_C_SI;
@@ -1278,7 +1156,7 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
 
     /* produce initial heterodyne phase for coarse heterodyne with no time delays */
     if(hetParams.heterodyneflag == 0)
-      tdt = hetParams.timestamp + (REAL8)i/hetParams.samplerate - T0;
+      tdt = hetParams.timestamp + (REAL8)(hetParams.offset+i)/hetParams.samplerate - T0;
     else if( hetParams.heterodyneflag == 1 || hetParams.heterodyneflag == 2){
       tdt = times->data[i] - T0;
       tdt_2 = times->data[i] - T0Update;
@@ -1293,13 +1171,17 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       baryinput.alpha = ra + dtpos*pmra/cos(baryinput.delta);
 
       if( hetParams.heterodyneflag == 3 ) /* get data time */
-        t = hetParams.timestamp + (REAL8)i/hetParams.samplerate;
+        t = hetParams.timestamp + (REAL8)(hetParams.offset+i)/hetParams.samplerate;
       else
         t = times->data[i];
 
       XLALGPSSetREAL8(&baryinput.tgps, t);
 
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat, tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+      /* use the Earth's state if it has already been calculated */
+      if( hetParams.earth != NULL )
+        earth = hetParams.earth[i];
+      else
+        XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, hetParams.edat, hetParams.tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
       XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) == XLAL_SUCCESS, XLAL_EFUNC );
 
       /* if binary pulsar add extra time delay */
@@ -1414,13 +1296,13 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       XLALGPSSetREAL8(&baryinput.tgps, t);
       XLALGPSSetREAL8(&baryinput2.tgps, t2);
 
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, edat,
-        tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth, &baryinput.tgps, hetParams.edat,
+        hetParams.tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
       XLAL_CHECK_VOID( XLALBarycenter( &emit, &baryinput, &earth ) ==
                        XLAL_SUCCESS, XLAL_EFUNC );
 
-      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth2, &baryinput2.tgps, edat,
-        tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_VOID( XLALBarycenterEarthNew( &earth2, &baryinput2.tgps, hetParams.edat,
+        hetParams.tdat, hetParams.ttype ) == XLAL_SUCCESS, XLAL_EFUNC );
       XLAL_CHECK_VOID( XLALBarycenter( &emit2, &baryinput2, &earth2 ) ==
                        XLAL_SUCCESS, XLAL_EFUNC );
 
@@ -1546,11 +1428,14 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
       I * (creal(dataTemp)*sin(-deltaphase) + cimag(dataTemp)*cos(-deltaphase));
   }
 
-  if(hetParams.heterodyneflag > 0){
-    XLALDestroyEphemerisData( edat );
-
-    if ( hetParams.ttype != TIMECORRECTION_ORIGINAL )
-      XLALDestroyTimeCorrectionData( tdat );
+  if ( glnum > 0 ){
+    XLALFree( glep );
+    XLALFree( glph );
+    XLALFree( glf0 );
+    XLALFree( glf1 );
+    XLALFree( glf2 );
+    XLALFree( glf0d );
+    XLALFree( gltd );
   }
 
   if ( fpphase != NULL ){
@@ -1558,6 +1443,422 @@ void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times,
   }
 }
 
+/* function to heterodyne a list of pulsars from a single pass through the
+   frame data. Each segment of frame data is read in once and then processed in
+   blocks of BLOCKLENGTH seconds: for a full heterodyne the Earth's barycentring
+   state at each sample in a block is calculated once and shared by all the
+   pulsars, which are then heterodyned, filtered and resampled in parallel */
+INT4 heterodyne_pulsar_list(InputParams *inputParams, int argc, char *argv[]){
+  PulsarHeterodyne *psrs=NULL;
+  UINT4 npsrs=0;
+
+  LALFILE *fpin=NULL;
+  FrameCache cache;
+  INT4 count=0, frcount=0;
+
+  INT4Vector *starts=NULL, *stops=NULL; /* science segment start and stop times */
+  INT4 numSegs=0;
+
+  EphemerisData *edat=NULL;
+  TimeCorrectionData *tdat=NULL;
+  EarthState *earths[TIMECORRECTION_LAST]; /* Earth states for each time system */
+  REAL8TimeSeries *datareal=NULL;
+  INT4 size=0, blocklength=0, tt=0, retn=1;
+
+  CHAR outputfile[256]="", *loc=NULL;
+
+  memset(&cache, 0, sizeof(cache));
+  for( tt=0; tt<TIMECORRECTION_LAST; tt++ ) earths[tt] = NULL;
+
+  /* set output file name format */
+  snprintf(outputfile, sizeof(outputfile), "%s", inputParams->outputfile);
+
+  // check if output should be gzipped due to ".gz" suffix on file name */
+  if ( XLALStringCaseSubstring( outputfile, ".gz" ) != NULL ){
+    if ( inputParams->binaryoutput ){
+      XLALPrintError("Error... do not use a \".gz\" file extension for a binary output file\n");
+    }
+
+    inputParams->gzipoutput = 1;
+    // remove ".gz" suffix
+    CHAR *strloc = XLALStringCaseSubstring( outputfile, ".gz" );
+    strloc[0] = '\0';
+  }
+  loc = strstr(outputfile, "%s");
+
+  /* read in the list of pulsar parameter files */
+  XLAL_CHECK_FAIL( (fpin = XLALFileOpen(inputParams->paramfilelist, "r")) != NULL,
+    XLAL_EIO, "Can't open pulsar parameter file list %s", inputParams->paramfilelist );
+
+  while( !XLALFileEOF(fpin) ){
+    CHAR linebuf[1024], parfile[1024];
+    PulsarHeterodyne *psr=NULL;
+    const CHAR *psrname=NULL;
+
+    if ( XLALFileGets(&linebuf[0], sizeof(linebuf), fpin) == NULL ){
+      // skip this line
+      continue;
+    }
+
+    /* skip blank lines and comments */
+    if ( sscanf(linebuf, "%1023s", parfile) != 1 || parfile[0] == '#' )
+      continue;
+
+    PulsarHeterodyne *newpsrs = XLALRealloc(psrs, (npsrs+1)*sizeof(*psrs));
+    XLAL_CHECK_FAIL( newpsrs != NULL, XLAL_ENOMEM );
+    psrs = newpsrs;
+    psr = &psrs[npsrs++];
+    memset(psr, 0, sizeof(*psr));
+
+    XLAL_CHECK_FAIL( (psr->hetParams.het = XLALReadTEMPOParFile( parfile )) != NULL,
+      XLAL_EFUNC, "Could not read pulsar parameter file %s", parfile );
+
+    XLAL_CHECK_FAIL( (psrname = get_pulsar_name( psr->hetParams.het )) != NULL,
+      XLAL_EINVAL, "No pulsar name specified in %s", parfile );
+
+    /* set a manual epoch if given */
+    if(inputParams->manualEpoch != 0.){
+      PulsarSetParam( psr->hetParams.het, "PEPOCH", &inputParams->manualEpoch );
+      PulsarSetParam( psr->hetParams.het, "POSEPOCH", &inputParams->manualEpoch );
+    }
+
+    psr->hetParams.heterodyneflag = inputParams->heterodyneflag;
+    psr->hetParams.hetUpdate = inputParams->heterodyneflag == 3 ? psr->hetParams.het : NULL;
+    psr->hetParams.detector = *XLALGetSiteInfo( inputParams->ifo );
+    psr->hetParams.samplerate = inputParams->samplerate;
+    psr->hetParams.ttype = TIMECORRECTION_ORIGINAL;
+    if( inputParams->heterodyneflag == 3 )
+      psr->hetParams.ttype = get_time_correction_type( psr->hetParams.het,
+        inputParams->timeCorrFile );
+
+    /* set filters - held for the whole data set for each pulsar */
+    if( inputParams->filterknee > 0. )
+      set_filters(&psr->iirFilters, inputParams->filterknee, inputParams->samplerate);
+
+    /* set output file by replacing %s with the pulsar name */
+    snprintf(psr->outputfile, sizeof(psr->outputfile), "%.*s%s%s",
+      (int)(loc - outputfile), outputfile, psrname, loc + 2);
+    XLAL_CHECK_FAIL( write_output_header(psr->outputfile, argc, argv) == 0,
+      XLAL_EIO, "Could not write header of output file %s", psr->outputfile );
+  }
+  XLALFileClose(fpin);
+  fpin = NULL;
+
+  XLAL_CHECK_FAIL( npsrs > 0, XLAL_EINVAL, "No pulsar parameter files listed in %s",
+    inputParams->paramfilelist );
+
+  if(verbose){ fprintf(stderr, "I've read in the parameters for %u pulsars.\n", npsrs); }
+
+  /* process the data in blocks containing a whole number of resampled data points */
+  size = (INT4)ROUND( inputParams->samplerate/inputParams->resamplerate );
+  blocklength = size*(INT4)ceil( BLOCKLENGTH*inputParams->resamplerate );
+
+  /* set up ephemeris files, and the Earth states for each time system in use -
+     these are shared by all the pulsars */
+  if( inputParams->heterodyneflag == 3 ){
+    XLAL_CHECK_FAIL( (edat = XLALInitBarycenter( inputParams->earthfile,
+      inputParams->sunfile )) != NULL, XLAL_EFUNC );
+
+    if( inputParams->timeCorrFile != NULL ){
+      XLAL_CHECK_FAIL( (tdat = XLALInitTimeCorrections( inputParams->timeCorrFile ))
+        != NULL, XLAL_EFUNC );
+    }
+
+    for( UINT4 p=0; p<npsrs; p++ ){
+      HeterodyneParams *hetParams = &psrs[p].hetParams;
+
+      hetParams->edat = edat;
+      if( hetParams->ttype != TIMECORRECTION_ORIGINAL ) hetParams->tdat = tdat;
+
+      if( earths[hetParams->ttype] == NULL ){
+        XLAL_CHECK_FAIL( (earths[hetParams->ttype] = XLALCalloc(blocklength,
+          sizeof(EarthState))) != NULL, XLAL_ENOMEM );
+      }
+      hetParams->earth = earths[hetParams->ttype];
+    }
+  }
+
+  /* get science segment lists - allocate initial memory for starts and stops */
+  XLAL_CHECK_FAIL( (starts = XLALCreateINT4Vector(1)) != NULL &&
+    (stops = XLALCreateINT4Vector(1)) != NULL, XLAL_EFUNC,
+    "Error allocating segment list memory" );
+  numSegs = get_segment_list(starts, stops, inputParams->segfile,
+    inputParams->heterodyneflag);
+  XLAL_CHECK_FAIL( (starts = XLALResizeINT4Vector(starts, numSegs)) != NULL &&
+    (stops = XLALResizeINT4Vector(stops, numSegs)) != NULL, XLAL_EFUNC,
+    "Error re-allocating segment list memory" );
+
+  if(verbose){ fprintf(stderr, "I've read in the segment list.\n"); }
+
+  /* read in frame filenames (read_frame_cache() closes the file) */
+  XLAL_CHECK_FAIL( (fpin = XLALFileOpen(inputParams->datafile, "r")) != NULL,
+    XLAL_EIO, "Can't open input data file %s", inputParams->datafile );
+  frcount = read_frame_cache(&cache, fpin);
+  fpin = NULL;
+  XLAL_CHECK_FAIL( frcount >= 0, XLAL_EIO, "Could not read frame cache %s",
+    inputParams->datafile );
+
+  if(verbose){  fprintf(stderr, "I've read in the frame list.\n");  }
+
+  /* loop through the science segments, reading in each set of frame data once */
+  do{
+    REAL8 gpstime;
+    INT4 duration, length, offset, nerrors=0;
+    CHAR *smalllist=NULL; /* list of frame files for a science segment */
+    LIGOTimeGPS epochdummy;
+
+    epochdummy.gpsSeconds = 0;
+    epochdummy.gpsNanoSeconds = 0;
+
+    /* if the seg list has segment before the start time of the available
+       data frame then increment the segment and continue */
+    if( stops->data[count] <= cache.starttime[0] ){
+      count++;
+      continue;
+    }
+    /* if there are segments after the last available data from then break */
+    if( cache.starttime[frcount-1] + cache.duration[frcount-1] <=
+        starts->data[count] )
+      break;
+
+    if((duration = stops->data[count] - starts->data[count]) > inputParams->datachunklength)
+      duration = inputParams->datachunklength; /* if duration of science segment is large
+                                                  just get part of it */
+
+    fprintf(stderr, "Getting data between %d and %d.\n", starts->data[count],
+      starts->data[count]+duration);
+
+    gpstime = (REAL8)starts->data[count];
+    length = inputParams->samplerate * duration;
+
+    /* if there was no frame file for that segment move on */
+    if((smalllist = set_frame_files(&starts->data[count], &stops->data[count],
+      cache, frcount, &count, inputParams->datachunklength))==NULL){
+      fprintf(stderr, "Error... no frame files listed between %d and %d.\n",
+        (INT4)gpstime, (INT4)gpstime + duration);
+
+      if(count < numSegs){
+        count++;/*if not finished reading in all data try next set of frames*/
+
+        continue;
+      }
+      else
+        break;
+    }
+
+    /* read in frame data */
+    if( (datareal = get_frame_data(smalllist, inputParams->channel, gpstime,
+      inputParams->samplerate * duration, duration, inputParams->samplerate,
+      inputParams->scaleFac, inputParams->highPass)) == NULL ){
+      fprintf(stderr, "Error... could not open frame files between %d and \
+%d.\n", (INT4)gpstime, (INT4)gpstime + duration);
+
+      XLALFree( smalllist );
+
+      if( count < numSegs ){
+        count++;/*if not finished reading in all data try next set of frames*/
+
+        continue;
+      }
+      else
+        break; /* if at the end of data anyway then break */
+    }
+
+    XLALFree( smalllist );
+
+    count++;
+
+    /* allocate memory for the resampled data of each pulsar */
+    for( UINT4 p=0; p<npsrs; p++ ){
+      psrs[p].hetParams.timestamp = gpstime;
+      psrs[p].count = 0;
+
+      XLAL_CHECK_FAIL( (psrs[p].resampData = XLALCreateCOMPLEX16TimeSeries( "",
+        &epochdummy, 0., 1./inputParams->resamplerate, &lalSecondUnit,
+        length/size + 1 )) != NULL && (psrs[p].times = XLALCreateREAL8Vector(
+        length/size + 1 )) != NULL, XLAL_EFUNC, "Error allocating resampled data memory" );
+    }
+
+    for( offset=0; offset<length; offset+=blocklength ){
+      INT4 blen = offset + blocklength < length ? blocklength : length - offset;
+
+      /* calculate the Earth's state at each sample for all pulsars */
+      for( tt=0; tt<TIMECORRECTION_LAST; tt++ ){
+        EarthState *earth = earths[tt];
+
+        if( earth == NULL ) continue;
+
+#pragma omp parallel for schedule(static) reduction(+:nerrors)
+        for( INT4 i=0; i<blen; i++ ){
+          LIGOTimeGPS tgps;
+
+          XLALGPSSetREAL8(&tgps, gpstime + (REAL8)(offset+i)/inputParams->samplerate);
+          if( XLALBarycenterEarthNew( &earth[i], &tgps, edat, tdat,
+            (TimeCorrectionType)tt ) != XLAL_SUCCESS ) nerrors++;
+        }
+        XLAL_CHECK_FAIL( nerrors == 0, XLAL_EFUNC, "Failed to calculate Earth states" );
+      }
+
+      /* heterodyne, filter and resample the block of data for each pulsar */
+#pragma omp parallel for schedule(dynamic) reduction(+:nerrors)
+      for( UINT4 p=0; p<npsrs; p++ ){
+        if( heterodyne_pulsar_block(&psrs[p], datareal, offset, blen, inputParams)
+          != XLAL_SUCCESS ) nerrors++;
+      }
+      XLAL_CHECK_FAIL( nerrors == 0, XLAL_EFUNC, "Failed to heterodyne data for %d pulsars",
+        nerrors );
+    }
+
+    XLALDestroyREAL8TimeSeries( datareal );
+    datareal = NULL;
+
+    if( verbose ){ fprintf(stderr, "I've heterodyned the data for %u pulsars.\n", npsrs); }
+
+    /* remove outliers, calibrate and output the data for each pulsar */
+#pragma omp parallel for schedule(dynamic) reduction(+:nerrors)
+    for( UINT4 p=0; p<npsrs; p++ ){
+      PulsarHeterodyne *psr = &psrs[p];
+
+      if( psr->count > 0 ){
+        if( (psr->resampData = XLALResizeCOMPLEX16TimeSeries( psr->resampData,
+          0, psr->count )) == NULL ||
+          (psr->times = XLALResizeREAL8Vector( psr->times, psr->count )) == NULL ){
+          XLALPrintError("Error resizing resampled data.\n");
+          nerrors++;
+        }
+        else{
+          clean_data(psr->resampData, psr->times, inputParams,
+            inputParams->freqfactor*PulsarGetREAL8VectorParamIndividual( psr->hetParams.het, "F0" ));
+
+          if( output_data(psr->outputfile, psr->resampData, psr->times, inputParams) )
+            nerrors++;
+        }
+      }
+
+      XLALDestroyCOMPLEX16TimeSeries( psr->resampData );
+      XLALDestroyREAL8Vector( psr->times );
+      psr->resampData = NULL;
+      psr->times = NULL;
+    }
+    XLAL_CHECK_FAIL( nerrors == 0, XLAL_EFUNC, "Failed to output data for %d pulsars",
+      nerrors );
+
+    if( verbose ){ fprintf(stderr, "I've output the data for %u pulsars.\n", npsrs); }
+  }while( count < numSegs );
+
+  /* check whether to gzip the output */
+  for( UINT4 p=0; p<npsrs; p++ ){
+    if ( !inputParams->binaryoutput && inputParams->gzipoutput ){
+      fprintf(stderr, "Outputing %s to gzipped file\n", psrs[p].outputfile);
+      if ( XLALGzipTextFile(psrs[p].outputfile) != XLAL_SUCCESS ){ // gzip it
+        XLALPrintError("Error... problem gzipping the output file.\n");
+      }
+    }
+  }
+
+  fprintf(stderr, "Heterodyning complete.\n");
+
+  retn = 0;
+
+XLAL_FAIL:
+  /* clean up, after an error as well */
+  if( fpin != NULL ){ XLALFileClose(fpin); }
+  XLALDestroyREAL8TimeSeries( datareal );
+
+  for( UINT4 p=0; p<npsrs; p++ ){
+    destroy_filters( &psrs[p].iirFilters );
+    PulsarFreeParams( psrs[p].hetParams.het );
+    XLALDestroyCOMPLEX16TimeSeries( psrs[p].resampData );
+    XLALDestroyREAL8Vector( psrs[p].times );
+  }
+  XLALFree( psrs );
+
+  XLALDestroyINT4Vector( stops );
+  XLALDestroyINT4Vector( starts );
+
+  XLALFree( cache.starttime );
+  XLALFree( cache.duration );
+  if( cache.framelist != NULL ){
+    for( UINT4 ii=0; ii<cache.length; ii++ ) XLALFree(cache.framelist[ii]);
+  }
+  XLALFree( cache.framelist );
+
+  for( tt=0; tt<TIMECORRECTION_LAST; tt++ ) XLALFree( earths[tt] );
+  if( edat != NULL ){ XLALDestroyEphemerisData( edat ); }
+  if( tdat != NULL ){ XLALDestroyTimeCorrectionData( tdat ); }
+
+  return retn;
+}
+
+/* function to heterodyne, filter and resample a block of frame data for one
+   pulsar from a list of pulsars - the resampled data is appended to that for
+   the current segment. This is called from within a parallel loop over the
+   pulsars, so errors are returned rather than raised to the caller */
+INT4 heterodyne_pulsar_block(PulsarHeterodyne *psr, REAL8TimeSeries *datareal,
+  INT4 offset, INT4 length, InputParams *inputParams){
+  COMPLEX16TimeSeries *data=NULL; /* data for heterodyning */
+  COMPLEX16TimeSeries *resampData=NULL; /* resampled data */
+  REAL8Vector *times=NULL;
+  LIGOTimeGPS epochdummy;
+  INT4 i=0, retn=XLAL_FAILURE;
+
+  epochdummy.gpsSeconds = 0;
+  epochdummy.gpsNanoSeconds = 0;
+
+  /* make vector (make sure imaginary parts are set to zero) */
+  XLAL_CHECK_FAIL( (data = XLALCreateCOMPLEX16TimeSeries( "", &epochdummy,
+    PulsarGetREAL8VectorParamIndividual( psr->hetParams.het, "F0" ),
+    1./inputParams->samplerate, &lalSecondUnit, length )) != NULL, XLAL_EFUNC,
+    "Error allocating data memory" );
+
+  for( i=0; i<length; i++ ){
+    data->data->data[i] = (REAL8)datareal->data->data[offset + i];
+  }
+
+  XLALGPSSetREAL8(&data->epoch, psr->hetParams.timestamp +
+    (REAL8)offset/inputParams->samplerate);
+
+  /* heterodyne data - sample times are counted from the segment timestamp.
+     heterodyne_data() only reports errors through xlalErrno */
+  psr->hetParams.offset = offset;
+  psr->hetParams.length = length;
+  XLALClearErrno();
+  heterodyne_data(data, NULL, psr->hetParams, inputParams->freqfactor, NULL);
+  XLAL_CHECK_FAIL( xlalErrno == 0, XLAL_EFUNC, "Failed to heterodyne data for %s",
+    psr->outputfile );
+
+  /* filter data - the filters carry on from the previous block */
+  if( inputParams->filterknee > 0. ){
+    filter_data(data, &psr->iirFilters);
+  }
+
+  /* resample data and data times (a block is a whole number of resampled
+     data points, except possibly at the end of a segment) */
+  if( length >= (INT4)ROUND( inputParams->samplerate/inputParams->resamplerate ) ){
+    XLAL_CHECK_FAIL( (times = XLALCreateREAL8Vector( length )) != NULL, XLAL_EFUNC,
+      "Error creating vector of data times" );
+
+    XLAL_CHECK_FAIL( (resampData = resample_data(data, times, NULL, NULL,
+      inputParams->samplerate, inputParams->resamplerate,
+      inputParams->heterodyneflag)) != NULL, XLAL_EFUNC, "Error resampling data" );
+
+    for( i=0; i<(INT4)resampData->data->length; i++ ){
+      psr->resampData->data->data[psr->count] = resampData->data->data[i];
+      psr->times->data[psr->count] = times->data[i];
+      psr->count++;
+    }
+  }
+
+  retn = XLAL_SUCCESS;
+
+XLAL_FAIL:
+  XLALDestroyCOMPLEX16TimeSeries( resampData );
+  XLALDestroyREAL8Vector( times );
+  XLALDestroyCOMPLEX16TimeSeries( data );
+
+  return retn;
+}
+
 /* function to extract the frame time and duration from the file name */
 void get_frame_times(CHAR *framefile, REAL8 *gpstime, INT4 *duration){
   INT4 j=0;
@@ -1724,6 +2025,16 @@ void filter_data(COMPLEX16TimeSeries *data, Filters *iirFilters){
 
 }
 
+/* function to free the memory for the low-pass filters */
+void destroy_filters(Filters *iirFilters){
+  XLALDestroyREAL8IIRFilter( iirFilters->filter1Re );
+  XLALDestroyREAL8IIRFilter( iirFilters->filter1Im );
+  XLALDestroyREAL8IIRFilter( iirFilters->filter2Re );
+  XLALDestroyREAL8IIRFilter( iirFilters->filter2Im );
+  XLALDestroyREAL8IIRFilter( iirFilters->filter3Re );
+  XLALDestroyREAL8IIRFilter( iirFilters->filter3Im );
+}
+
 /* function to average the data at one sample rate down to a new sample rate */
 COMPLEX16TimeSeries *resample_data(COMPLEX16TimeSeries *data,
   REAL8Vector *times, INT4Vector *starts, INT4Vector *stops, REAL8 sampleRate,
@@ -1891,6 +2202,59 @@ COMPLEX16TimeSeries *resample_data(COMPLEX16TimeSeries *data,
   return series;
 }
 
+/* read in a frame cache file (in the format output by LSCdataFind), closing the
+   file when done - returns the number of frame files, or -1 on failure */
+INT4 read_frame_cache(FrameCache *cache, LALFILE *fpin){
+  CHAR det[10]; /* detector from cache file */
+  CHAR type[256]; /* frame type e.g. RDS_R_L3 - from cache file */
+  INT4 cachecount=0, ch=0, frcount=0, ii=0;
+
+  /* count the number of frame files in the cache file */
+  while( (ch = XLALFileGetc(fpin) ) != EOF ){
+    if( ch == '\n' ) cachecount++;
+  }
+
+  /* rewind file pointer */
+  XLALFileRewind(fpin);
+
+  /* allocate memory for frame cache information */
+  if( (cache->starttime = XLALCalloc(cachecount, sizeof(INT4))) == NULL ||
+      (cache->duration = XLALCalloc(cachecount, sizeof(INT4))) == NULL ||
+      (cache->framelist = XLALCalloc(cachecount, sizeof(CHAR *))) == NULL )
+    {  XLALPrintError("Error allocating frame cache memory.\n");  }
+
+  for( ii=0; ii<cachecount; ii++ ){
+    if( (cache->framelist[ii] = XLALCalloc(MAXSTRLENGTH, sizeof(CHAR))) == NULL )
+      {  XLALPrintError("Error allocating frame list memory.\n");  }
+  }
+  cache->length = cachecount;
+
+  do{
+    CHAR linebuf[1024]; // buffer for each line
+    if ( XLALFileGets(&linebuf[0], 1024, fpin) == NULL ){
+      // skip this line
+      continue;
+    }
+
+    if ( sscanf(linebuf, "%s%s%d%d file://localhost%s", det, type, &cache->starttime[frcount], &cache->duration[frcount],
+           cache->framelist[frcount]) != 5 ){
+      // skip this line
+      continue;
+    }
+
+    frcount++;
+  }while( !XLALFileEOF(fpin) );
+  XLALFileClose(fpin);
+
+  if( frcount != cachecount ){
+    fprintf(stderr, "Error... There's been a problem reading in the frame \
+data!\n");
+    return -1;
+  }
+
+  return frcount;
+}
+
 /* read in science segment list file - returns the number of segments */
 INT4 get_segment_list(INT4Vector *starts, INT4Vector *stops, CHAR *seglistfile,
 INT4 heterodyneflag){
@@ -2292,6 +2656,158 @@ INT4 remove_outliers(COMPLEX16TimeSeries *data, REAL8Vector *times,
   return startlen - j;
 }
 
+/* function to remove outliers from, and calibrate, the resampled data */
+void clean_data(COMPLEX16TimeSeries *resampData, REAL8Vector *times,
+  InputParams *inputParams, REAL8 frequency){
+  /*perform outlier removal twice incase very large outliers skew the stddev*/
+  if( inputParams->stddevthresh != 0. ){
+    INT4 numOutliers=0;
+    numOutliers = remove_outliers(resampData, times,
+      inputParams->stddevthresh);
+    if( verbose ){
+      fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 1st time.\n",
+        100.*(double)numOutliers/(double)resampData->data->length,
+        inputParams->stddevthresh);
+    }
+  }
+
+  /* calibrate */
+  if( inputParams->calibrate ){
+    calibrate(resampData, times, inputParams->calibfiles, frequency,
+      inputParams->channel);
+    if( verbose ){ fprintf(stderr, "I've calibrated the data at %.1lf Hz\n", frequency);  }
+  }
+
+  /* remove outliers above our threshold */
+  if( inputParams->stddevthresh != 0. ){
+    INT4 numOutliers = 0;
+    numOutliers = remove_outliers(resampData, times,
+      inputParams->stddevthresh);
+    if( verbose ){
+      fprintf(stderr, "I've removed %lf%% of data above the threshold %.1lf sigma for 2nd time.\n",
+        100.*(double)numOutliers/(double)resampData->data->length,
+        inputParams->stddevthresh);
+    }
+  }
+}
+
+/* function to write the header information to a new output file - the header
+ * information will be a string consisting of several lines starting with %%s.
+ *  - the first line will contain the time and date of the file creation
+ *  - the next set of lines will contain the version and git hash of the lalsuite versions
+ *  - the penulimate line will contain the command line inputs used to create the file
+ *  - the final will contain headers for the three columns in the file: GPS time, Real, Imag
+ * returns non-zero on failure */
+INT4 write_output_header(CHAR *outputfile, int argc, char *argv[]){
+  FILE *fpout=NULL;
+
+  if( (fpout = fopen(outputfile, "w")) == NULL ){
+    fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
+    return 1;
+  }
+
+  CHAR *headerinfo = XLALStringDuplicate("%% File created on ");
+  headerinfo = XLALStringAppend(headerinfo, LogTimeToString( XLALGetTimeOfDay() ));
+  headerinfo = XLALStringAppend(headerinfo, "\n");
+  headerinfo = XLALStringAppend(headerinfo, XLALGetVersionString( 0 ) );
+  headerinfo = XLALStringAppend(headerinfo, "%% ");
+  for ( INT4 j=0; j<argc; j++ ) {
+    headerinfo = XLALStringAppend(headerinfo, argv[j]);
+    headerinfo = XLALStringAppend(headerinfo, " ");
+  }
+  CHAR dataline[] = "\n%% GPS time\tReal\tImag\n";
+  if ( strlen(headerinfo)+strlen(dataline) > HEADERSIZE ) {
+    fprintf(stderr, "Error... HEADERSIZE needs to be increased to accommodate information\n");
+    XLALFree( headerinfo );
+    fclose(fpout);
+    return 1;
+  }
+  else{
+    /* fill in rest of string with whitespace */
+    for ( INT4 j=strlen(headerinfo); j<HEADERSIZE; j++ ){ headerinfo = XLALStringAppend(headerinfo, " "); }
+    memcpy(&headerinfo[HEADERSIZE-strlen(dataline)], &dataline[0], sizeof(CHAR)*strlen(dataline));
+
+    /* output the header to the file */
+    size_t rc = fwrite(&headerinfo[0], sizeof(CHAR), HEADERSIZE, fpout);
+    if ( ferror(fpout) || !rc ){
+      fprintf(stderr, "Error... problem writing out header data!\n");
+      exit(1);
+    }
+  }
+  XLALFree( headerinfo );
+  fclose(fpout);
+
+  return 0;
+}
+
+/* function to append resampled data to an output file - returns non-zero on
+   failure */
+INT4 output_data(CHAR *outputfile, COMPLEX16TimeSeries *resampData,
+  REAL8Vector *times, InputParams *inputParams){
+  FILE *fpout=NULL;
+  INT4 i=0;
+
+  if( inputParams->binaryoutput ){
+    if((fpout = fopen(outputfile, "ab"))==NULL){
+      fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
+      return 1;
+    }
+  }
+  else{
+    if( (fpout = fopen(outputfile, "a")) == NULL ){
+      fprintf(stderr, "Error... can't open output file %s!\n", outputfile);
+      return 1;
+    }
+  }
+
+  /* buffer the output, so that file system is not thrashed when outputing */
+  /* buffer will be 1Mb */
+  if( setvbuf(fpout, NULL, _IOFBF, 0x100000) ){ fprintf(stderr, "Warning: Unable to set output file buffer!"); }
+
+  for( i=0;i<(INT4)resampData->data->length;i++ ){
+    /* if data has been scaled then undo scaling for output */
+
+    if( inputParams->binaryoutput ){
+      size_t rc = 0;
+      REAL8 tempreal, tempimag;
+
+      tempreal = creal(resampData->data->data[i]);
+      tempimag = cimag(resampData->data->data[i]);
+
+      /* binary output will be same as ASCII text - time real imag */
+      if( inputParams->scaleFac > 1.0 ){
+        tempreal /= inputParams->scaleFac;
+        tempimag /= inputParams->scaleFac;
+      }
+
+      rc = fwrite(&times->data[i], sizeof(REAL8), 1, fpout);
+      rc = fwrite(&tempreal, sizeof(REAL8), 1, fpout);
+      rc = fwrite(&tempimag, sizeof(REAL8), 1, fpout);
+
+      if( ferror(fpout) || !rc ){
+        fprintf(stderr, "Error... problem writing out data to binary file!\n");
+        exit(1);
+      }
+    }
+    else{
+      if( inputParams->scaleFac > 1.0 ){
+        fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
+                creal(resampData->data->data[i])/inputParams->scaleFac,
+                cimag(resampData->data->data[i])/inputParams->scaleFac);
+      }
+      else{
+        fprintf(fpout, "%lf\t%le\t%le\n", times->data[i],
+          creal(resampData->data->data[i]), cimag(resampData->data->data[i]));
+      }
+    }
+
+  }
+
+  fclose(fpout);
+
+  return 0;
+}
+
 FilterResponse *create_filter_response( REAL8 filterKnee ){
   int i = 0;
   int srate, ttime;
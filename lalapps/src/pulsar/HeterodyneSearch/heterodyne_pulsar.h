@@ -92,6 +92,10 @@ extern "C" {
 " --param-file (-f)        name of file containing initial pulsar parameters\n\
                           (.par file)\n"\
 " --param-file-update (-g) name of file containing updated pulsar parameters\n"\
+" --param-file-list (-X)   name of file containing a list of .par files (one\n\
+                          per line) for pulsars to be heterodyned together\n\
+                          from a single pass through the frame data (coarse\n\
+                          heterodyne 0 or full heterodyne 3 only)\n"\
 " --manual-epoch (-M)      a hardwired epoch for the pulsar frequency and\n\
                           position (for use when dealing with hardware\n\
                           injections when this should be set to 751680013.0)\n"\
@@ -111,7 +115,9 @@ extern "C" {
                           at one time from a frame file, overriding\n\
                           MAXDATALENGTH\n"\
 " --channel (-c)           frame data channel (i.e. LSC-DARM_ERR)\n"\
-" --output-file (-o)       full path and filename for the output data\n"\
+" --output-file (-o)       full path and filename for the output data. If\n\
+                          --param-file-list is given this must contain %%s,\n\
+                          which is replaced by each pulsar's name\n"\
 " --seg-file (-l)          name of file containing science segment list\n"\
 " --calibrate (-A)         if specified calibrate data (no argument)\n"\
 " --response-file (-R)     name of file containing the response function\n"\
@@ -139,6 +145,8 @@ extern "C" {
 "\n"
 
 #define MAXDATALENGTH 256   /* maximum length of data to be read from frames */
+#define BLOCKLENGTH 16      /* length of data (in seconds) heterodyned at a time
+                               for all pulsars in a list of pulsars */
 #define MAXSTRLENGTH 1024   /* maximum number of characters in a frame filename */
 #define MAXLISTLENGTH 20000 /* maximum length of a list of frames files */
 
@@ -173,6 +181,7 @@ typedef struct tagInputParams{
   INT4 heterodyneflag;
   CHAR paramfile[256];
   CHAR paramfileupdate[256];
+  CHAR *paramfilelist;
   REAL8 manualEpoch;
 
   REAL8 freqfactor;
@@ -220,11 +229,13 @@ typedef struct tagHeterodyneParams{
   REAL8 samplerate;
   REAL8 timestamp;
   INT4 length;
+  INT4 offset; /* number of samples between timestamp and the start of the data */
 
-  CHAR earthfile[256];
-  CHAR sunfile[256];
-  CHAR *timeCorrFile;
+  EphemerisData *edat;
+  TimeCorrectionData *tdat;
   TimeCorrectionType ttype;
+  const EarthState *earth; /* Earth states at each data sample (or NULL to
+                              calculate them when heterodyning) */
   INT4 outputPhase;
 }HeterodyneParams;
 
@@ -237,6 +248,18 @@ typedef struct tagFilters{
   REAL8IIRFilter *filter3Im;
 }Filters;
 
+/* structure holding the heterodyne of one pulsar from a list of pulsars */
+typedef struct tagPulsarHeterodyne{
+  HeterodyneParams hetParams;
+  Filters iirFilters;
+
+  CHAR outputfile[256];
+
+  COMPLEX16TimeSeries *resampData; /* resampled data for the current segment */
+  REAL8Vector *times;
+  INT4 count; /* number of resampled data points in the current segment */
+}PulsarHeterodyne;
+
 typedef struct tagFilterResponse{
   REAL8Vector *freqResp;
   REAL8Vector *phaseResp;
@@ -251,10 +274,25 @@ void get_input_args(InputParams *inputParams, int argc, char *argv[]);
 void heterodyne_data(COMPLEX16TimeSeries *data, REAL8Vector *times, HeterodyneParams hetParams,
 REAL8 freqfactor, FilterResponse *filtResp);
 
+/* heterodyne a list of pulsars from a single pass through the frame data */
+INT4 heterodyne_pulsar_list(InputParams *inputParams, int argc, char *argv[]);
+
+/* heterodyne, filter and resample a block of frame data for one pulsar from a list of pulsars */
+INT4 heterodyne_pulsar_block(PulsarHeterodyne *psr, REAL8TimeSeries *datareal, INT4 offset,
+INT4 length, InputParams *inputParams);
+
+/* get the pulsar name from its parameters - returns NULL if no name is given */
+const CHAR *get_pulsar_name(PulsarParameters *params);
+
+/* get the time system used by the pulsar parameters */
+TimeCorrectionType get_time_correction_type(PulsarParameters *params, CHAR *timeCorrFile);
+
 void set_filters(Filters *iirFilters, REAL8 filterKnee, REAL8 samplerate);
 
 void filter_data(COMPLEX16TimeSeries *data, Filters *iirFilters);
 
+void destroy_filters(Filters *iirFilters);
+
 COMPLEX16TimeSeries *resample_data(COMPLEX16TimeSeries *data, REAL8Vector *times, INT4Vector
 *starts, INT4Vector *stops, REAL8 sampleRate, REAL8 resampleRate, INT4 heterodyneflag);
 
@@ -266,6 +304,9 @@ REAL8TimeSeries *get_frame_data(CHAR *framefile, CHAR *channel, REAL8 gpstime,
   REAL8 length, INT4 duration, REAL8 samplerate, REAL8 scalefac,
   REAL8 highpass);
 
+/* read in a frame cache file - returns the number of frame files */
+INT4 read_frame_cache(FrameCache *cache, LALFILE *fpin);
+
 /* read in science segment list file - returns the number of segments */
 INT4 get_segment_list(INT4Vector *starts, INT4Vector *stops, CHAR *seglistfile, INT4 heterodyneflag);
 
@@ -284,6 +325,17 @@ frequency);
 of outliers removed */
 INT4 remove_outliers(COMPLEX16TimeSeries *data, REAL8Vector *times, REAL8 stddevthresh);
 
+/* remove outliers and calibrate resampled data */
+void clean_data(COMPLEX16TimeSeries *resampData, REAL8Vector *times, InputParams *inputParams,
+REAL8 frequency);
+
+/* write the header information to a new output file - returns non-zero on failure */
+INT4 write_output_header(CHAR *outputfile, int argc, char *argv[]);
+
+/* append resampled data to an output file - returns non-zero on failure */
+INT4 output_data(CHAR *outputfile, COMPLEX16TimeSeries *resampData, REAL8Vector *times,
+InputParams *inputParams);
+
 FilterResponse *create_filter_response( REAL8 filterKnee );
 
 /* free memory for filter response structure */
@@ -218,6 +218,40 @@ fi
 
 mv $COARSEFILE $COARSEFILE.off
 
+# run code in coarse heterodyne mode for a list of pulsars (using both parameter files) in one go
+echo Performing coarse heterodyne - mode 0 - for a list of pulsars
+PSRNAMELIST=J0000+0001
+PFILELIST=${PSRNAMELIST}.par
+sed "s/$PSRNAME/$PSRNAMELIST/" $PFILEOFF > $PFILELIST
+echo $PFILE > psrlist
+echo $PFILELIST >> psrlist
+LISTFILE=$OUTDIR/coarsehet_%s_${DETECTOR}_${DATASTART}-${DATAEND}.list
+$CODENAME --heterodyne-flag 0 --ifo $DETECTOR --param-file-list psrlist --sample-rate $SRATE1 --resample-rate $SRATE2 --filter-knee $FKNEE --data-file $LOCATION/cachefile --seg-file $LOCATION/segfile --channel $CHANNEL --output-file $LISTFILE --freq-factor 2
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+        echo lalapps_heterodyne_pulsar exited with error $ret_code!
+        exit 2
+fi
+
+# check that the outputs (after the headers) match those from heterodyning each pulsar on its own
+for pair in "$PSRNAME $COARSEFILE.txt" "$PSRNAMELIST $COARSEFILE.off"; do
+  set -- $pair
+  LISTOUT=`echo $LISTFILE | sed "s/%s/$1/"`
+  if [ ! -f $LISTOUT ]; then
+    echo Error! Code has not output a coarse heterodyne file for $1
+    exit 2
+  fi
+  tail -c +2049 $LISTOUT > listdata
+  tail -c +2049 $2 > singledata
+  if ! cmp -s listdata singledata; then
+    echo Error! Coarse heterodyne of $1 from a list of pulsars differs from that for a single pulsar
+    exit 2
+  fi
+  rm -f listdata singledata
+done
+
 # set calibration files
 RESPFILE=H1response.txt
 
@@ -345,6 +379,56 @@ fi
 # move file
 mv $FINEFILE $FINEFILE.full
 
+# perform the heterodyne in one go (mode 3) for the offset pulsar on its own
+echo Performing entire heterodyne in one go - mode 3 - with offset pulsar
+FINEFILELIST=$OUTDIR/finehet_${PSRNAMELIST}_${DETECTOR}
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 3 --ifo $DETECTOR --pulsar $PSRNAMELIST --param-file $PFILELIST --sample-rate $SRATE1 --resample-rate $SRATE3 --filter-knee $FKNEE --data-file $LOCATION/cachefile --output-file $FINEFILELIST --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --calibrate --response-file $RESPFILE --stddev-thresh 5
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+  echo lalapps_heterodyne_pulsar exited with error $ret_code!
+  exit 2
+fi
+
+# check that it produced the right file
+if [ ! -f $FINEFILELIST ]; then
+  echo Error! Code has not output a fine heterodyned file
+  exit 2
+fi
+
+mv $FINEFILELIST $FINEFILELIST.full
+
+# now perform the heterodyne in one go (mode 3) for the list of pulsars, which
+# share the Earth's barycentring states and are heterodyned in parallel
+echo Performing entire heterodyne in one go - mode 3 - for a list of pulsars
+FULLLISTFILE=$OUTDIR/finehet_%s_${DETECTOR}.list
+$CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 3 --ifo $DETECTOR --param-file-list psrlist --sample-rate $SRATE1 --resample-rate $SRATE3 --filter-knee $FKNEE --data-file $LOCATION/cachefile --output-file $FULLLISTFILE --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --calibrate --response-file $RESPFILE --stddev-thresh 5
+
+# check the exit status of the code
+ret_code=$?
+if [ $ret_code != "0" ]; then
+  echo lalapps_heterodyne_pulsar exited with error $ret_code!
+  exit 2
+fi
+
+# check that the outputs (after the headers) match those from heterodyning each pulsar on its own
+for pair in "$PSRNAME $FINEFILE.full" "$PSRNAMELIST $FINEFILELIST.full"; do
+  set -- $pair
+  LISTOUT=`echo $FULLLISTFILE | sed "s/%s/$1/"`
+  if [ ! -f $LISTOUT ]; then
+    echo Error! Code has not output a fine heterodyned file for $1
+    exit 2
+  fi
+  tail -c +2049 $LISTOUT > listdata
+  tail -c +2049 $2 > singledata
+  if ! cmp -s listdata singledata; then
+    echo Error! Full heterodyne of $1 from a list of pulsars differs from that for a single pulsar
+    exit 2
+  fi
+  rm -f listdata singledata
+done
+
 ################### REHETERODYNE THE ALREADY FINE HETERODYNED FILE #####
 echo Performing updating heterodyne of already fine heterodyned data
 $CODENAME --ephem-earth-file $EEPHEM --ephem-sun-file $SEPHEM --ephem-time-file $TEPHEM --heterodyne-flag 4 --ifo $DETECTOR --pulsar $PSRNAME --param-file $PFILEOFF --param-file-update $PFILE --sample-rate $SRATE3 --resample-rate $SRATE3 --filter-knee 0 --data-file $FINEFILE.off2 --output-file $FINEFILE --channel $CHANNEL --seg-file $LOCATION/segfile --freq-factor 2 --stddev-thresh 5
@@ -691,6 +775,8 @@ rm -f segfile
 # remove parameter files
 rm -f $PFILE
 rm -f $PFILEOFF
+rm -f $PFILELIST
+rm -f psrlist
 
 # remove upacked frame files
 rm -f ${LOCATION}/framedir/*
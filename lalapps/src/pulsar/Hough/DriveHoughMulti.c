@@ -276,13 +276,13 @@ int main(int argc, char *argv[]){
     static HOUGHPeakGramVector pgV;  /* vector of peakgrams */
     static UCHARPeakGramVector upgV;  /* vector of expanded peakgrams */
     static PHMDVectorSequence  phmdVS;  /* the partial Hough map derivatives */
-    static UINT8FrequencyIndexVector freqInd; /* for trajectory in time-freq plane */
+    static UINT8FrequencyIndexVectorSequence freqIndVS; /* for trajectories in time-freq plane, one per spin-down */
     static HOUGHResolutionPar parRes;   /* patch grid information */
     static HOUGHPatchGrid  patch;   /* Patch description */
     static HOUGHParamPLUT  parLut;  /* parameters needed to build lut  */
     static HOUGHDemodPar   parDem;  /* demodulation parameters or  */
     static HOUGHSizePar    parSize;
-    static HOUGHMapTotal   ht;   /* the total Hough map */
+    static HOUGHMapTotalVector htV;   /* the total Hough maps, one per spin-down */
     static UINT8Vector     *hist; /* histogram of number counts for a single map */
     static UINT8Vector     *histTotal; /* number count histogram for all maps */
     static HoughStats      stats;  /* statistical information about a Hough map */
@@ -304,7 +304,7 @@ int main(int argc, char *argv[]){
     static HoughSignificantEventVector nStarEventVec;
     
     /* miscellaneous */
-    INT4   iHmap, nSpin1Max ;
+    INT4   iHmap, nSpin1Max, nSpinUpJumps, nSpinDownJumps ;
     UINT4  mObsCoh, mObsCohBest;
     INT8   f0Bin, fLastBin, fBin;
     REAL8  alpha, delta, timeBase, deltaF, f1jump;
@@ -345,6 +345,7 @@ int main(int argc, char *argv[]){
     INT4     uvar_spindownJump;
     
     INT4 uvar_nfLUTvalidity = 0;
+    INT4 uvar_numThreads = 1;
     INT4 uvar_numSkyPartitions = 0;
     INT4 uvar_partitionIndex = 0;
     
@@ -433,6 +434,7 @@ int main(int argc, char *argv[]){
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_refTime,            "refTime",            REAL8,        0,   OPTIONAL,  "GPS reference time of observation") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_deltaF1dot,         "deltaF1dot",         REAL8,        0,   OPTIONAL,  "(Step size for f1dot)*Tcoh [Default: 1/Tobs]") == XLAL_SUCCESS, XLAL_EFUNC);
 
+    XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreads,         "numThreads",        INT4,          0,   OPTIONAL,  "Number of threads used to compute the Hough maps of the spin-downs at each frequency") == XLAL_SUCCESS, XLAL_EFUNC);
     XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_EnableToplistPatch, "EnableToplistPatch",BOOLEAN,       0,   OPTIONAL,  "Enables a toplist per Patch, requires to enableChi2") == XLAL_SUCCESS, XLAL_EFUNC);
 
     
@@ -472,6 +474,11 @@ int main(int argc, char *argv[]){
         exit(1);
     }
     
+    if ( uvar_numThreads < 1 ) {
+        LogPrintf(LOG_CRITICAL, "numThreads must be at least 1\n");
+        exit(1);
+    }
+    
     if ( uvar_nfSizeCylinder < uvar_nSpinUp + 1) {
         LogPrintf(LOG_CRITICAL, "Number of search spin must bigger than the positive ones\n");
         exit(1);
@@ -832,8 +839,6 @@ int main(int argc, char *argv[]){
         LAL_CALL( LALHOUGHCreatePHMDVS( &status, &phmdVS, mObsCohBest, uvar_nfSizeCylinder), &status);
         phmdVS.deltaF  = deltaF;
         
-        LAL_CALL( LALHOUGHCreateFreqIndVector( &status, &freqInd, mObsCohBest, deltaF), &status);
-        
         /* allocating histogram of the number-counts in the Hough maps */
         if ( uvar_EnableExtraInfo ) {
             UINT4 k0;
@@ -876,6 +881,19 @@ int main(int argc, char *argv[]){
         /* ***** for spin-down case ****/
         nSpin1Max = uvar_nfSizeCylinder - 1 - uvar_nSpinUp;
         /* nSpin1Max = floor(uvar_nfSizeCylinder/2.0) ;*/
+        nSpinUpJumps = floor(uvar_nSpinUp/uvar_spindownJump);
+        nSpinDownJumps = floor(nSpin1Max/uvar_spindownJump);
+        
+        /* one trajectory in the time-freq plane per spin-down value, stored contiguously */
+        freqIndVS.length = nSpinUpJumps + nSpinDownJumps + 1;
+        freqIndVS.vectorLength = mObsCohBest;
+        freqIndVS.freqIndV = (UINT8FrequencyIndexVector *)LALCalloc(freqIndVS.length, sizeof(UINT8FrequencyIndexVector));
+        LAL_CALL( LALHOUGHCreateFreqIndVector( &status, &freqIndVS.freqIndV[0], freqIndVS.length*mObsCohBest, deltaF), &status);
+        for (k = 0; k < freqIndVS.length; ++k) {
+            freqIndVS.freqIndV[k].deltaF = deltaF;
+            freqIndVS.freqIndV[k].length = mObsCohBest;
+            freqIndVS.freqIndV[k].data = freqIndVS.freqIndV[0].data + k*mObsCohBest;
+        }
         
         
         if ( XLALUserVarWasSet( &uvar_deltaF1dot ) )
@@ -948,9 +966,17 @@ int main(int argc, char *argv[]){
             
             /* ************ initializing the Total Hough map space *********** */
             
-            LAL_CALL( LALHOUGHCreateHT( &status, &ht, xSide, ySide), &status);
-            ht.mObsCoh = mObsCohBest;
-            ht.deltaF = deltaF;
+            htV.length = freqIndVS.length;
+            htV.ht = (HOUGHMapTotal *)LALCalloc(htV.length, sizeof(HOUGHMapTotal));
+            for (k = 0; k < htV.length; ++k) {
+                LAL_CALL( LALHOUGHCreateHT( &status, &htV.ht[k], xSide, ySide), &status);
+                htV.ht[k].mObsCoh = mObsCohBest;
+                htV.ht[k].deltaF = deltaF;
+                htV.ht[k].spinRes.length = 1;
+                htV.ht[k].spinRes.data = (REAL8 *)LALCalloc(htV.ht[k].spinRes.length, sizeof(REAL8));
+                /* spin-downs are ordered from the largest spin-up to the largest spin-down */
+                htV.ht[k].spinRes.data[0] = (nSpinUpJumps - (INT4)k) * f1jump * deltaF;
+            }
             
             
             /*  Search frequency interval possible using the same LUTs */
@@ -964,46 +990,41 @@ int main(int argc, char *argv[]){
             while ( (fBinSearch <= fLastBin) && (fBinSearch < fBinSearchMax) )
             {
                 
-                /**** study 1 spin-down. at  fBinSearch ****/
+                /**** study all spin-downs at fBinSearch ****/
                 
                 INT4   n;
                 REAL8  f1dis;
                 
-                ht.f0Bin = fBinSearch;
-                ht.spinRes.length = 1;
-                ht.spinRes.data = NULL;
-                ht.spinRes.data = (REAL8 *)LALCalloc(ht.spinRes.length, sizeof(REAL8));
-                for ( n = floor(uvar_nSpinUp/uvar_spindownJump); n >= - floor(nSpin1Max/uvar_spindownJump); --n) {
+                /* construct paths in time-freq plane */
+                for ( n = nSpinUpJumps; n >= - nSpinDownJumps; --n) {
                     /*for ( n = 0; n <= floor(nSpin1Max/uvar_spindownJump); ++n) {*/
                     /* f1dis = - n * f1jump; */
-                    /*loop over all spindown values */
                     
                     f1dis = + n * f1jump;
-                    ht.spinRes.data[0] =  f1dis * deltaF;
-                    
-                    /* construct path in time-freq plane */
+                    htV.ht[nSpinUpJumps - n].f0Bin = fBinSearch;
                     for (j = 0 ; j < mObsCohBest; ++j){
-                        freqInd.data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
-                    }
-                    
-                    if (uvar_weighAM || uvar_weighNoise) {
-                        LAL_CALL( LALHOUGHConstructHMT_W( &status, &ht, &freqInd, &phmdVS ), &status );
-                    }
-                    else {
-                        LAL_CALL( LALHOUGHConstructHMT( &status, &ht, &freqInd, &phmdVS ), &status );
+                        freqIndVS.freqIndV[nSpinUpJumps - n].data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
                     }
+                }
+                
+                /* construct the Hough maps of all spin-downs, in parallel */
+                XLAL_CHECK_MAIN( XLALHOUGHConstructHMTVector( &htV, &freqIndVS, &phmdVS, (uvar_weighAM || uvar_weighNoise), uvar_numThreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+                
+                for ( n = nSpinUpJumps; n >= - nSpinDownJumps; --n) {
+                    /*loop over all spindown values */
                     
+                    HOUGHMapTotal *ht = &htV.ht[nSpinUpJumps - n];
                     
                     /* ********************* perfom stat. analysis on the maps ****************** */
                     
                     if ( uvar_EnableExtraInfo ) {
                         
-                        LAL_CALL( LALHoughStatistics ( &status, &stats, &ht), &status );
+                        LAL_CALL( LALHoughStatistics ( &status, &stats, ht), &status );
                         LAL_CALL( LALStereo2SkyLocation (&status, &sourceLocation,
                                                          stats.maxIndex[0], stats.maxIndex[1], &patch, &parDem), &status);
                         
-                        /*LAL_CALL( LALHoughHistogram ( &status, &hist, &ht), &status);*/
-                        LAL_CALL( LALHoughHistogramSignificance ( &status, hist, &ht, meanN, sigmaN,
+                        /*LAL_CALL( LALHoughHistogram ( &status, &hist, ht), &status);*/
+                        LAL_CALL( LALHoughHistogramSignificance ( &status, hist, ht, meanN, sigmaN,
                                                                  minSignificance, maxSignificance), &status);
                         
                         for(j = 0; j < histTotal->length; j++){
@@ -1012,21 +1033,20 @@ int main(int argc, char *argv[]){
                     }
                     
                     /* select candidates from hough maps */
-                    LAL_CALL( GetToplistFromHoughmap( &status, toplist, &ht, &patch, &parDem, meanN, sigmaN), &status);
+                    LAL_CALL( GetToplistFromHoughmap( &status, toplist, ht, &patch, &parDem, meanN, sigmaN), &status);
                     
                     
                     /* ***** print results *********************** */
                     
                     if( uvar_EnableExtraInfo )
                     {
-                        if( PrintExtraInfo( fileMaps, &fp1, iHmap, &ht, &sourceLocation, &stats, fBinSearch, deltaF))
+                        if( PrintExtraInfo( fileMaps, &fp1, iHmap, ht, &sourceLocation, &stats, fBinSearch, deltaF))
                             return DRIVEHOUGHCOLOR_EFILE;
                     }
                     
                     ++iHmap;
                 } /* end loop over spindown values */
                 
-                LALFree(ht.spinRes.data);
                 
                 
                 /***** shift the search freq. & PHMD structure 1 freq.bin ****** */
@@ -1045,7 +1065,11 @@ int main(int argc, char *argv[]){
             /* ********************  Free partial memory ******************* */
             LALFree(patch.xCoor);
             LALFree(patch.yCoor);
-            LALFree(ht.map);
+            for (k = 0; k < htV.length; ++k) {
+                LALFree(htV.ht[k].map);
+                LALFree(htV.ht[k].spinRes.data);
+            }
+            LALFree(htV.ht);
             
             LALHOUGHDestroyLUTs( &status, &lutV);
             
@@ -1082,8 +1106,9 @@ int main(int argc, char *argv[]){
         LALFree(phmdVS.phmd);
         phmdVS.phmd = NULL;
         
-        LALFree(freqInd.data);
-        freqInd.data = NULL;
+        LALFree(freqIndVS.freqIndV[0].data);
+        LALFree(freqIndVS.freqIndV);
+        freqIndVS.freqIndV = NULL;
         
         if ( uvar_EnableExtraInfo ) {
             XLALDestroyUINT8Vector (hist);
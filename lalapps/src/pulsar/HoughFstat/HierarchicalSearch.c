@@ -418,6 +418,7 @@ int MAIN( int argc, char *argv[]) {
   BOOLEAN uvar_correctFreqs = TRUE;
 
   INT4 uvar_gpu_device = -1;
+  INT4 uvar_numThreads = 1;
   global_status = &status;
 
 #ifdef EAH_LALDEBUGLEVEL
@@ -491,6 +492,7 @@ int MAIN( int argc, char *argv[]) {
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_df1dotRes,        "df1dotRes",        REAL8,   0,   DEVELOPER, "Resolution in residual fdot values (default=df1dot/nf1dotRes)") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_correctFreqs,     "correctFreqs",     BOOLEAN, 0,   DEVELOPER, "Correct candidate output frequencies (ie fix bug #147). Allows reproducing 'historical results'") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_gpu_device,       "device",           INT4,    0,   DEVELOPER, "GPU device id" ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_numThreads,       "numThreads",       INT4,    0,   DEVELOPER, "Number of threads used to compute the Hough maps of the residual spindowns" ) == XLAL_SUCCESS, XLAL_EFUNC);
 
   /* read all command line variables */
   BOOLEAN should_exit = 0;
@@ -527,6 +529,11 @@ int MAIN( int argc, char *argv[]) {
     return( HIERARCHICALSEARCH_EBAD );
   }
 
+  if ( uvar_numThreads < 1 ) {
+    fprintf(stderr, "Invalid number of threads\n");
+    return( HIERARCHICALSEARCH_EBAD );
+  }
+
   if ( uvar_peakThrF < 0 ) {
     fprintf(stderr, "Invalid value of Fstatistic threshold\n");
     return( HIERARCHICALSEARCH_EBAD );
@@ -787,6 +794,7 @@ int MAIN( int argc, char *argv[]) {
   semiCohPar.pixelFactor = uvar_pixelFactor;
   semiCohPar.nfdot = nf1dotRes;
   semiCohPar.dfdot = df1dotRes;
+  semiCohPar.numThreads = uvar_numThreads;
 
   /* allocate memory for Hough candidates */
   semiCohCandList.length = uvar_nCand1;
@@ -1497,7 +1505,8 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
   HOUGHMapTotal ht;
   HOUGHptfLUTVector   lutV; /* the Look Up Table vector*/
   PHMDVectorSequence  phmdVS;  /* the partial Hough map derivatives */
-  UINT8FrequencyIndexVector freqInd; /* for trajectory in time-freq plane */
+  UINT8FrequencyIndexVectorSequence freqIndVS; /* for trajectories in time-freq plane, one per residual spindown */
+  HOUGHMapTotalVector htV; /* Hough maps, one per residual spindown */
   HOUGHResolutionPar parRes;   /* patch grid information */
   HOUGHPatchGrid  patch;   /* Patch description */
   HOUGHParamPLUT  parLut;  /* parameters needed to build lut  */
@@ -1506,7 +1515,7 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
 
   UINT2  xSide, ySide, maxNBins, maxNBorders;
   INT8  fBinIni, fBinFin, fBin;
-  INT4  iHmap, nfdot;
+  INT4  iHmap, nfdot, nfdotBy2;
   UINT4 k, nStacks ;
   REAL8 deltaF, dfdot, alpha, delta;
   REAL8 patchSizeX, patchSizeY;
@@ -1622,11 +1631,30 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
     ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
   }
 
-  /* residual spindown trajectory */
-  freqInd.deltaF = deltaF;
-  freqInd.length = nStacks;
-  freqInd.data = LALCalloc(1, alloc_len = nStacks*sizeof(UINT8));
-  if ( freqInd.data == NULL ) {
+  /* residual spindown trajectories */
+  nfdotBy2 = nfdot/2;
+  freqIndVS.length = 2*nfdotBy2 + 1;
+  freqIndVS.vectorLength = nStacks;
+  freqIndVS.freqIndV = LALCalloc(1, alloc_len = freqIndVS.length*sizeof(UINT8FrequencyIndexVector));
+  if ( freqIndVS.freqIndV == NULL ) {
+    XLALPrintError ("Failed to LALCalloc(1,%d)\n", alloc_len );
+    ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
+  }
+  freqIndVS.freqIndV[0].data = LALCalloc(1, alloc_len = freqIndVS.length*nStacks*sizeof(UINT8));
+  if ( freqIndVS.freqIndV[0].data == NULL ) {
+    XLALPrintError ("Failed to LALCalloc(1,%d)\n", alloc_len );
+    ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
+  }
+  for (k=0; k < freqIndVS.length; k++) {
+    freqIndVS.freqIndV[k].deltaF = deltaF;
+    freqIndVS.freqIndV[k].length = nStacks;
+    freqIndVS.freqIndV[k].data = freqIndVS.freqIndV[0].data + k*nStacks;
+  }
+
+  /* Hough maps of the residual spindowns */
+  htV.length = freqIndVS.length;
+  htV.ht = LALCalloc(1, alloc_len = htV.length*sizeof(HOUGHMapTotal));
+  if ( htV.ht == NULL ) {
     XLALPrintError ("Failed to LALCalloc(1,%d)\n", alloc_len );
     ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
   }
@@ -1884,7 +1912,8 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
     ht.patchSizeX = patchSizeX;
     ht.patchSizeY = patchSizeY;
     ht.dFdot.data[0] = dfdot;
-    ht.map   = LALCalloc(1, alloc_len = xSide*ySide*sizeof(HoughTT));
+    /* maps of all residual spindowns are stored one after another, starting at ht.map */
+    ht.map   = LALCalloc(1, alloc_len = htV.length*xSide*ySide*sizeof(HoughTT));
     if ( ht.map == NULL ) {
       XLALPrintError ("Failed to LALCalloc( 1, %d)\n", alloc_len );
       ABORT ( status, HIERARCHICALSEARCH_EMEM, HIERARCHICALSEARCH_MSGEMEM );
@@ -1901,50 +1930,59 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
 
       /* finally we can construct the hough maps and select candidates */
       {
-	INT4   n, nfdotBy2;
+	INT4   n;
 
-	nfdotBy2 = nfdot/2;
 	ht.f0Bin = fBinSearch;
 
-	/*loop over all values of residual spindown */
-	/* check limits of loop */
+	/* construct the hough maps of all residual spindowns, in parallel */
 	for( n = -nfdotBy2; n <= nfdotBy2 ; n++ ){
 
-	  ht.spinRes.data[0] =  n*dfdot;
-
 	  for (j=0; j < (UINT4)nStacks; j++) {
-	    freqInd.data[j] = fBinSearch + floor( (REAL4)(timeDiffV->data[j]*n*dfdot/deltaF) + 0.5f);
+	    freqIndVS.freqIndV[n + nfdotBy2].data[j] = fBinSearch + floor( (REAL4)(timeDiffV->data[j]*n*dfdot/deltaF) + 0.5f);
 	  }
 
-	  TRY( LALHOUGHConstructHMT_W(status->statusPtr, &ht, &freqInd, &phmdVS),status );
+	  htV.ht[n + nfdotBy2] = ht;
+	  htV.ht[n + nfdotBy2].map = ht.map + (n + nfdotBy2)*xSide*ySide;
+	}
+
+	if ( XLALHOUGHConstructHMTVector( &htV, &freqIndVS, &phmdVS, TRUE, params->numThreads ) != XLAL_SUCCESS ) {
+	  ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
+	}
+
+	/*loop over all values of residual spindown */
+	/* check limits of loop */
+	for( n = -nfdotBy2; n <= nfdotBy2 ; n++ ){
+
+	  HOUGHMapTotal *thisHt = &htV.ht[n + nfdotBy2];
+	  thisHt->spinRes.data[0] =  n*dfdot;
 
 	  /* get candidates */
 	  if ( params->useToplist ) {
-	    TRY(GetHoughCandidates_toplist( status->statusPtr, houghToplist, &ht, &patch, &parDem), status);
+	    TRY(GetHoughCandidates_toplist( status->statusPtr, houghToplist, thisHt, &patch, &parDem), status);
 	  }
 	  else {
-	    TRY(GetHoughCandidates_threshold( status->statusPtr, out, &ht, &patch, &parDem, params->threshold), status);
+	    TRY(GetHoughCandidates_threshold( status->statusPtr, out, thisHt, &patch, &parDem, params->threshold), status);
 	  }
 
 	  /* calculate statistics and histogram */
 	  if ( uvar_printStats && (fpStats != NULL) ) {
-	    TRY( LALHoughStatistics ( status->statusPtr, &stats, &ht), status );
+	    TRY( LALHoughStatistics ( status->statusPtr, &stats, thisHt), status );
 	    TRY( LALStereo2SkyLocation ( status->statusPtr, &sourceLocation,
 					stats.maxIndex[0], stats.maxIndex[1],
 					&patch, &parDem), status);
 
 	    fprintf(fpStats, "%d %f %f %f %f %f %f %f %g \n", iHmap, sourceLocation.alpha, sourceLocation.delta,
 		    (REAL4)stats.maxCount, (REAL4)stats.minCount, (REAL4)stats.avgCount, (REAL4)stats.stdDev,
-		    fBinSearch*deltaF,  ht.spinRes.data[0] );
+		    fBinSearch*deltaF,  thisHt->spinRes.data[0] );
 
-	    TRY( LALHoughHistogram ( status->statusPtr, &hist, &ht), status);
+	    TRY( LALHoughHistogram ( status->statusPtr, &hist, thisHt), status);
 	    for(j=0; j< histTotal.length; ++j)
 	      histTotal.data[j]+=hist.data[j];
 	  }
 
 	  /* print hough map */
 	  if ( uvar_printMaps ) {
-	    TRY( PrintHmap2file( status->statusPtr, &ht, params->outBaseName, iHmap), status);
+	    TRY( PrintHmap2file( status->statusPtr, thisHt, params->outBaseName, iHmap), status);
 	  }
 
 	  if ( uvar_printGrid ) {
@@ -2003,7 +2041,9 @@ void ComputeFstatHoughMap(LALStatus *status,		/**< pointer to LALStatus structur
   LALFree(ht.dFdot.data);
   LALFree(lutV.lut);
   LALFree(phmdVS.phmd);
-  LALFree(freqInd.data);
+  LALFree(freqIndVS.freqIndV[0].data);
+  LALFree(freqIndVS.freqIndV);
+  LALFree(htV.ht);
   LALFree(parDem.spin.data);
 
   TRY( LALDDestroyVector( status->statusPtr, &timeDiffV), status);
@@ -144,6 +144,7 @@ extern "C" {
     REAL8  threshold;          /**< Threshold for candidate selection */
     REAL8Vector *weightsV;     /**< Vector of weights for each stack */
     UINT4 extraBinsFstat;      /**< Extra bins required for Fstat calculation */
+    UINT4 numThreads;          /**< Number of threads used to compute Hough maps */
   } SemiCoherentParams;
 
   /** one hough or stackslide candidate */
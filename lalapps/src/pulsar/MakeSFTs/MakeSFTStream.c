@@ -0,0 +1,293 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_SFTTools
+ * \brief
+ * Make SFTs for a list of data segments, reading each segment from frame files once.
+ *
+ * Unlike lalapps_MakeSFTs, which makes the SFTs of a single frame span per invocation, the data
+ * of each segment are read in blocks and passed through an #SFTStream, which high-pass filters
+ * the data continuously across SFT boundaries, and computes the (possibly overlapping) SFTs with
+ * a single FFT plan on multiple threads. The SFTs of each segment are written to a merged SFT
+ * file in the output directory, named following the SFT naming convention.
+ */
+
+#include <config.h>
+#if !defined HAVE_LIBLALFRAME
+#include <stdio.h>
+int main(void) {fputs("disabled, no lal frame library support.\n", stderr);return 1;}
+#else
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <lal/UserInput.h>
+#include <lal/LALString.h>
+#include <lal/LALCache.h>
+#include <lal/LALFrStream.h>
+#include <lal/Segments.h>
+#include <lal/TimeSeries.h>
+#include <lal/LogPrintf.h>
+#include <lal/SFTfileIO.h>
+#include <lal/SFTStream.h>
+
+#include <lalapps.h>
+
+/* ---------- local types ---------- */
+
+typedef struct
+{
+  CHAR *frameCache;		/**< frame cache file */
+  CHAR *channel;		/**< channel to read from frames */
+  CHAR *IFO;			/**< detector name written to the SFTs */
+  INT4 startTime;		/**< GPS start time of the data, if no segment list is given */
+  INT4 endTime;			/**< GPS end time of the data, if no segment list is given */
+  CHAR *segmentList;		/**< file of data segments to make SFTs for */
+  REAL8 Tsft;			/**< SFT time baseline */
+  REAL8 overlapFraction;	/**< fraction of Tsft by which consecutive SFTs overlap */
+  REAL8 fMin;			/**< lowest frequency in the SFTs */
+  REAL8 Band;			/**< frequency band of the SFTs */
+  CHAR *windowType;		/**< window applied to the data of each SFT */
+  REAL8 windowBeta;		/**< window parameter */
+  REAL8 highPassFreq;		/**< knee frequency of the high-pass filter */
+  REAL8 settleTime;		/**< padding for the high-pass filter to settle */
+  REAL8 blockDuration;		/**< duration of data read from frames at once */
+  CHAR *outputDir;		/**< directory to write merged SFT files to */
+  CHAR *miscDesc;		/**< 'Misc' part of the SFT file names */
+  CHAR *comment;		/**< comment written to the SFTs */
+} UserVariables_t;
+
+/** Merged SFT file being written for the current segment */
+typedef struct
+{
+  CHAR *tmpPath;		/**< temporary path of the file while it is being written */
+  FILE *fp;			/**< open file, or NULL if no SFTs have been written */
+  UINT4 numSFTs;		/**< number of SFTs written */
+  SFTtype first;		/**< header of the first SFT written */
+  LIGOTimeGPS lastEpoch;	/**< epoch of the last SFT written */
+} MergedSFTFile;
+
+/* ---------- local prototypes ---------- */
+static int WriteSFTs ( MergedSFTFile *file, SFTVector *sfts, const UserVariables_t *uvar );
+static int CloseMergedSFTFile ( MergedSFTFile *file, const UserVariables_t *uvar );
+
+/*============================================================
+ * FUNCTION definitions
+ *============================================================*/
+
+int
+main(int argc, char *argv[])
+{
+
+  UserVariables_t XLAL_INIT_DECL(uvar_struct);
+  UserVariables_t *const uvar = &uvar_struct;
+
+  /* set a few defaults */
+  uvar->Tsft = 1800;
+  uvar->overlapFraction = 0;
+  uvar->fMin = 48;
+  uvar->Band = 2000;
+  uvar->windowType = XLALStringDuplicate("tukey");
+  uvar->windowBeta = 0.001;
+  uvar->highPassFreq = 0;
+  uvar->settleTime = 16;
+  uvar->blockDuration = 16384;
+  uvar->outputDir = XLALStringDuplicate(".");
+
+  /* register all user-variables */
+  XLALRegisterUvarMember(	frameCache,	STRING, 'C', REQUIRED,	"Frame cache file");
+  XLALRegisterUvarMember(	channel,	STRING, 'N', REQUIRED,	"Channel to read from frames");
+  XLALRegisterUvarMember(	IFO,		STRING, 'I', OPTIONAL,	"Detector written to the SFTs (default: channel prefix)");
+  XLALRegisterUvarMember(	startTime,	INT4, 's', OPTIONAL,	"GPS start time of the data, if no " UVAR_STR( segmentList ) " is given");
+  XLALRegisterUvarMember(	endTime,	INT4, 'e', OPTIONAL,	"GPS end time of the data, if no " UVAR_STR( segmentList ) " is given");
+  XLALRegisterUvarMember(	segmentList,	STRING, 0,  OPTIONAL,	"File of data segments to make SFTs for, one segment per line as 'start end'");
+  XLALRegisterUvarMember(	Tsft,		REAL8, 't', OPTIONAL,	"SFT time baseline in seconds");
+  XLALRegisterUvarMember(	overlapFraction, REAL8, 'P', OPTIONAL,	"Fraction of " UVAR_STR( Tsft ) " by which consecutive SFTs overlap");
+  XLALRegisterUvarMember(	fMin,		REAL8, 'F', OPTIONAL,	"Lowest frequency to store in the SFTs");
+  XLALRegisterUvarMember(	Band,		REAL8, 'B', OPTIONAL,	"Frequency band to store in the SFTs");
+  XLALRegisterUvarMember(	windowType,	STRING, 'w', OPTIONAL,	"Window applied to the data of each SFT, e.g. 'tukey', 'hann', or 'rectangular'");
+  XLALRegisterUvarMember(	windowBeta,	REAL8, 'r', OPTIONAL,	"Window parameter, e.g. the tapered fraction of a Tukey window");
+  XLALRegisterUvarMember(	highPassFreq,	REAL8, 'f', OPTIONAL,	"Knee frequency of the high-pass Butterworth filter (0 = no filter)");
+  XLALRegisterUvarMember(	settleTime,	REAL8, 0,  OPTIONAL,	"Seconds of data either side of each filtered block for the high-pass filter to settle");
+  XLALRegisterUvarMember(	blockDuration,	REAL8, 0,  OPTIONAL,	"Seconds of data read from frames at once");
+  XLALRegisterUvarMember(	outputDir,	STRING, 'p', OPTIONAL,	"Directory to write merged SFT files to");
+  XLALRegisterUvarMember(	miscDesc,	STRING, 'X', OPTIONAL,	"'Misc' part of the SFT file names");
+  XLALRegisterUvarMember(	comment,	STRING, 'c', OPTIONAL,	"Comment written to the SFTs");
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit(1);
+  }
+
+  /* check user input */
+  XLALUserVarCheck( &should_exit, UVAR_SET2( startTime, endTime ) == 2 || ( UVAR_SET2( startTime, endTime ) == 0 && UVAR_SET( segmentList ) ), "Either both " UVAR_STR2AND( startTime, endTime ) ", or " UVAR_STR( segmentList ) " must be given" );
+  XLALUserVarCheck( &should_exit, !UVAR_SET( segmentList ) || UVAR_SET2( startTime, endTime ) == 0, UVAR_STR( segmentList ) " is mutually exclusive with " UVAR_STR2AND( startTime, endTime ) );
+  XLALUserVarCheck( &should_exit, uvar->Tsft > 0, UVAR_STR( Tsft ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit, 0 <= uvar->overlapFraction && uvar->overlapFraction < 1, UVAR_STR( overlapFraction ) " must be in [0, 1)" );
+  XLALUserVarCheck( &should_exit, uvar->highPassFreq >= 0, UVAR_STR( highPassFreq ) " must be non-negative" );
+  XLALUserVarCheck( &should_exit, uvar->settleTime >= 0, UVAR_STR( settleTime ) " must be non-negative" );
+  XLALUserVarCheck( &should_exit, uvar->blockDuration > 0, UVAR_STR( blockDuration ) " must be strictly positive" );
+  if ( should_exit ) {
+    return EXIT_FAILURE;
+  }
+
+  /* detector written to the SFTs */
+  if ( uvar->IFO == NULL ) {
+    XLAL_CHECK_MAIN( ( uvar->IFO = XLALGetChannelPrefix( uvar->channel ) ) != NULL, XLAL_EFUNC );
+  }
+
+  /* data segments to make SFTs for */
+  LALSegList *segments = NULL;
+  if ( UVAR_SET( segmentList ) ) {
+    XLAL_CHECK_MAIN( ( segments = XLALReadSegmentsFromFile( uvar->segmentList ) ) != NULL, XLAL_EFUNC );
+  } else {
+    XLAL_CHECK_MAIN( ( segments = XLALSegListCreate() ) != NULL, XLAL_EFUNC );
+    LIGOTimeGPS start = { uvar->startTime, 0 }, end = { uvar->endTime, 0 };
+    LALSeg seg;
+    XLAL_CHECK_MAIN( XLALSegSet( &seg, &start, &end, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALSegListAppend( segments, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* open frame stream; gaps in the data within a segment are errors */
+  LALFrStream *framestream = NULL;
+  {
+    LALCache *framecache = XLALCacheImport( uvar->frameCache );
+    XLAL_CHECK_MAIN( framecache != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( framestream = XLALFrStreamCacheOpen( framecache ) ) != NULL, XLAL_EFUNC );
+    XLALDestroyCache( framecache );
+    XLAL_CHECK_MAIN( XLALFrStreamSetMode( framestream, LAL_FR_STREAM_VERBOSE_MODE ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* create SFT stream */
+  SFTStreamParams XLAL_INIT_DECL(params);
+  params.Tsft = uvar->Tsft;
+  params.overlapFraction = uvar->overlapFraction;
+  params.fMin = uvar->fMin;
+  params.Band = uvar->Band;
+  params.windowType = ( XLALStringCaseCompare( uvar->windowType, "rectangular" ) == 0 ) ? NULL : uvar->windowType;
+  params.windowBeta = uvar->windowBeta;
+  params.highPass.name = NULL;
+  params.highPass.nMax = 10;
+  params.highPass.f2 = uvar->highPassFreq;
+  params.highPass.a2 = 0.5;
+  params.highPass.f1 = -1;
+  params.highPass.a1 = -1;
+  params.settleTime = uvar->settleTime;
+  SFTStream *stream = XLALCreateSFTStream( &params );
+  XLAL_CHECK_MAIN( stream != NULL, XLAL_EFUNC );
+
+  /* make SFTs for each segment, reading its data in blocks */
+  for ( UINT4 n = 0; n < segments->length; ++n ) {
+    const LALSeg *seg = &segments->segs[n];
+    const REAL8 segDuration = XLALGPSDiff( &seg->end, &seg->start );
+    if ( segDuration < uvar->Tsft ) {
+      LogPrintf( LOG_NORMAL, "Skipping segment [%d, %d), which is shorter than an SFT\n", seg->start.gpsSeconds, seg->end.gpsSeconds );
+      continue;
+    }
+    LogPrintf( LOG_NORMAL, "Making SFTs for segment [%d, %d) ...\n", seg->start.gpsSeconds, seg->end.gpsSeconds );
+
+    MergedSFTFile XLAL_INIT_DECL(file);
+    for ( REAL8 offset = 0; offset < segDuration; offset += uvar->blockDuration ) {
+      LIGOTimeGPS blockStart = seg->start;
+      XLALGPSAdd( &blockStart, offset );
+      const REAL8 blockDuration = ( offset + uvar->blockDuration <= segDuration ) ? uvar->blockDuration : segDuration - offset;
+      REAL8TimeSeries *series = XLALFrStreamInputREAL8TimeSeries( framestream, uvar->channel, &blockStart, blockDuration, 0 );
+      XLAL_CHECK_MAIN( series != NULL, XLAL_EFUNC, "Failed to read %g seconds of '%s' at GPS time %d", blockDuration, uvar->channel, blockStart.gpsSeconds );
+      strncpy( series->name, uvar->IFO, sizeof( series->name ) - 1 );
+      series->name[sizeof( series->name ) - 1] = '\0';
+      SFTVector *sfts = XLALSFTStreamAppend( stream, series );
+      XLAL_CHECK_MAIN( sfts != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( WriteSFTs( &file, sfts, uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALDestroySFTVector( sfts );
+      XLALDestroyREAL8TimeSeries( series );
+    }
+    SFTVector *sfts = XLALSFTStreamEndSegment( stream );
+    XLAL_CHECK_MAIN( sfts != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( WriteSFTs( &file, sfts, uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroySFTVector( sfts );
+    XLAL_CHECK_MAIN( CloseMergedSFTFile( &file, uvar ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  }
+
+  /* ----- done: free all memory */
+  XLALDestroySFTStream( stream );
+  XLALFrStreamClose( framestream );
+  XLALSegListFree( segments );
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main */
+
+/** Append SFTs to the merged SFT file of the current segment, opening it if needed */
+static int
+WriteSFTs ( MergedSFTFile *file, SFTVector *sfts, const UserVariables_t *uvar )
+{
+  for ( UINT4 i = 0; i < sfts->length; ++i ) {
+    const SFTtype *sft = &sfts->data[i];
+    if ( file->fp == NULL ) {
+      XLAL_CHECK( ( file->tmpPath = XLALStringAppendFmt( NULL, "%s/.%s-%d.sft.tmp", uvar->outputDir, sft->name, sft->epoch.gpsSeconds ) ) != NULL, XLAL_EFUNC );
+      XLAL_CHECK( ( file->fp = fopen( file->tmpPath, "wb" ) ) != NULL, XLAL_EIO, "Failed to open SFT file '%s'", file->tmpPath );
+      file->first = *sft;
+      file->first.data = NULL;
+    }
+    XLAL_CHECK( XLALWriteSFT2fp( sft, file->fp, uvar->comment ) == XLAL_SUCCESS, XLAL_EFUNC );
+    file->lastEpoch = sft->epoch;
+    ++file->numSFTs;
+  }
+  return XLAL_SUCCESS;
+}
+
+/** Close the merged SFT file of the current segment, and move it to its final name */
+static int
+CloseMergedSFTFile ( MergedSFTFile *file, const UserVariables_t *uvar )
+{
+  if ( file->fp == NULL ) {
+    LogPrintf( LOG_NORMAL, "No SFTs made for this segment\n" );
+    return XLAL_SUCCESS;
+  }
+  fclose( file->fp );
+  file->fp = NULL;
+
+  /* name the file following the SFT naming convention */
+  const UINT4 Tsft = (UINT4) round( 1.0 / file->first.deltaF );
+  LIGOTimeGPS lastEnd = file->lastEpoch;
+  XLALGPSAdd( &lastEnd, Tsft );
+  const UINT4 Tspan = (UINT4) ceil( XLALGPSDiff( &lastEnd, &file->first.epoch ) );
+  char *filename = XLALOfficialSFTFilename( file->first.name[0], file->first.name[1], file->numSFTs, Tsft, file->first.epoch.gpsSeconds, Tspan, uvar->miscDesc );
+  XLAL_CHECK( filename != NULL, XLAL_EFUNC );
+  char *path = XLALStringAppendFmt( NULL, "%s/%s", uvar->outputDir, filename );
+  XLAL_CHECK( path != NULL, XLAL_EFUNC );
+  XLAL_CHECK( rename( file->tmpPath, path ) == 0, XLAL_EIO, "Failed to move SFT file '%s' to '%s'", file->tmpPath, path );
+  LogPrintf( LOG_NORMAL, "Wrote %u SFTs to '%s'\n", file->numSFTs, path );
+
+  XLALFree( filename );
+  XLALFree( path );
+  XLALFree( file->tmpPath );
+  file->tmpPath = NULL;
+
+  return XLAL_SUCCESS;
+}
+
+#endif
@@ -46,3 +46,25 @@ if ! eval "$cmdline"; then
     echo "ERROR: something failed when running '$cmdline'"
     exit 1
 fi
+
+## run MakeSFTStream to create a merged SFT file from the fake frame, in two blocks of data
+cmdline="lalapps_MakeSFTStream --frameCache=$framecache --channel=H1:mfdv5 --IFO=H1 --startTime=${tstart} --endTime=${tend} --Tsft=${Tsft} --blockDuration=1000 --windowType=rectangular --highPassFreq=0 --fMin=0 --Band=${Band} --outputDir=. --miscDesc=MSFTS"
+if ! eval "$cmdline"; then
+    echo "ERROR: something failed when running '$cmdline'"
+    exit 1
+fi
+MSFTSsft="./H-1_H1_${Tsft}SFT_MSFTS-${tstart}-${Tsft}.sft"
+for file in $MSFTSsft; do
+    if ! test -f $file; then
+        echo "ERROR: could not find file '$file'"
+        exit 1
+    fi
+done
+
+## compare SFTs produced by MFDv5 and MakeSFTStream, should be very nearly identical
+cmdline="lalapps_compareSFTs -V -e $tol -1 $MFDv5sft -2 $MSFTSsft"
+echo "Comparing SFTs produced by MFDv5 and MakeSFTStream, allowed tolerance=$tol:"
+if ! eval "$cmdline"; then
+    echo "ERROR: something failed when running '$cmdline'"
+    exit 1
+fi
@@ -0,0 +1,100 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalapps_pulsar_SFTTools
+ * \brief
+ * Write SFT noise files alongside a set of SFT files, using XLALWriteSFTNoiseFile().
+ *
+ * An SFT noise file stores the running-median noise estimate and spectral-line flags of each SFT
+ * in an SFT file, over the full frequency band of the SFT. Searches which load the SFTs, e.g.
+ * lalapps_Weave with <tt>--Fstat-SFT-noise-files</tt>, can then read the running medians instead
+ * of recomputing them each time they start.
+ */
+
+/* ---------- includes ---------- */
+#include <stdio.h>
+
+#include <lal/UserInput.h>
+#include <lal/SFTfileIO.h>
+#include <lal/ComputeFstat.h>
+#include <lal/LogPrintf.h>
+
+#include <lalapps.h>
+
+/* ---------- local types ---------- */
+
+typedef struct
+{
+  CHAR *inputSFTs;	/**< pattern matching the SFT files to write noise files for */
+  INT4 blocksRngMed;	/**< running median window size */
+  REAL8 lineThreshold;	/**< threshold on normalised SFT power above which bins are flagged as lines */
+} UserVariables_t;
+
+/*============================================================
+ * FUNCTION definitions
+ *============================================================*/
+
+int
+main(int argc, char *argv[])
+{
+
+  UserVariables_t XLAL_INIT_DECL(uvar_struct);
+  UserVariables_t *const uvar = &uvar_struct;
+
+  /* set a few defaults */
+  uvar->blocksRngMed = FstatOptionalArgsDefaults.runningMedianWindow;
+  uvar->lineThreshold = 20;
+
+  /* register all user-variables */
+  XLALRegisterUvarMember(	inputSFTs,	STRING, 'i', REQUIRED,	"Pattern matching the SFT files to write noise files for");
+  XLALRegisterUvarMember(	blocksRngMed,	INT4, 'w', OPTIONAL,	"Running median window size; must match the window size used by the searches which read the noise files");
+  XLALRegisterUvarMember(	lineThreshold,	REAL8, 0, OPTIONAL,	"Flag SFT bins whose power, normalised by the running median, exceeds this threshold as spectral lines");
+
+  /* read cmdline & cfgfile  */
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalAppsVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    exit(1);
+  }
+
+  /* check user input */
+  XLALUserVarCheck( &should_exit, uvar->blocksRngMed > 0, UVAR_STR( blocksRngMed ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit, uvar->lineThreshold > 0, UVAR_STR( lineThreshold ) " must be strictly positive" );
+  if ( should_exit ) {
+    return EXIT_FAILURE;
+  }
+
+  /* write a noise file for each SFT file */
+  LALStringVector *sftFiles = XLALFindFiles( uvar->inputSFTs );
+  XLAL_CHECK_MAIN( sftFiles != NULL, XLAL_EFUNC, "No SFT files match '%s'\n", uvar->inputSFTs );
+  for ( UINT4 i = 0; i < sftFiles->length; ++i ) {
+    LogPrintf( LOG_NORMAL, "Writing noise file for '%s' ...\n", sftFiles->data[i] );
+    XLAL_CHECK_MAIN( XLALWriteSFTNoiseFile( sftFiles->data[i], uvar->blocksRngMed, uvar->lineThreshold ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  LogPrintf( LOG_NORMAL, "Wrote noise files for %u SFT files\n", sftFiles->length );
+
+  /* ----- done: free all memory */
+  XLALDestroyStringVector( sftFiles );
+  XLALDestroyUserVars();
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main */
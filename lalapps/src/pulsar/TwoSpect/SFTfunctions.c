@@ -129,6 +129,57 @@ MultiSFTVector * getMultiSFTVector(UserInput_t *params, const REAL8 minfbin, con
    return sftvector;
 } // getMultiSFTVector()
 
+/**
+ * Load the running medians of the SFTs returned by getMultiSFTVector() from the SFT noise files written alongside the SFT files
+ * \param [in] params         Pointer to UserInput_t
+ * \param [in] multiSFTvector Pointer to MultiSFTVector returned by getMultiSFTVector()
+ * \return Pointer to MultiPSDVector of running medians, with detectors in the same order as multiSFTvector
+ */
+MultiPSDVector * getMultiSFTNoise(const UserInput_t *params, const MultiSFTVector *multiSFTvector)
+{
+
+   XLAL_CHECK_NULL( params != NULL && multiSFTvector != NULL, XLAL_EINVAL );
+
+   //Get catalog of SFTs, split by detector
+   SFTCatalog *catalog = NULL;
+   XLAL_CHECK_NULL( (catalog = findSFTdata(params)) != NULL, XLAL_EFUNC );
+   MultiSFTCatalogView *multiCatalogView = NULL;
+   XLAL_CHECK_NULL( (multiCatalogView = XLALGetMultiSFTCatalogView(catalog)) != NULL, XLAL_EFUNC );
+
+   fprintf(LOG, "Loading SFT noise files... ");
+   fprintf(stderr, "Loading SFT noise files... ");
+
+   MultiPSDVector *multiSFTnoise = NULL;
+   XLAL_CHECK_NULL( (multiSFTnoise = XLALCalloc(1, sizeof(*multiSFTnoise))) != NULL, XLAL_ENOMEM );
+   XLAL_CHECK_NULL( (multiSFTnoise->data = XLALCalloc(multiSFTvector->length, sizeof(*multiSFTnoise->data))) != NULL, XLAL_ENOMEM );
+   multiSFTnoise->length = multiSFTvector->length;
+
+   //The SFTs have been reordered to the order of the IFO option, so load each detector from its own catalog view
+   for (UINT4 ii=0; ii<multiSFTvector->length; ii++) {
+      const SFTCatalog *catalogX = NULL;
+      for (UINT4 jj=0; jj<multiCatalogView->length && catalogX==NULL; jj++) {
+         if (strncmp(multiCatalogView->data[jj].data[0].header.name, multiSFTvector->data[ii]->data[0].name, 2) == 0) catalogX = &(multiCatalogView->data[jj]);
+      }
+      XLAL_CHECK_NULL( catalogX != NULL, XLAL_EFAILED, "No SFTs in catalog for detector %.2s\n", multiSFTvector->data[ii]->data[0].name );
+
+      MultiSFTVector singleSFTvector = { .length = 1, .data = &(multiSFTvector->data[ii]) };
+      MultiPSDVector *singleSFTnoise = NULL;
+      XLAL_CHECK_NULL( (singleSFTnoise = XLALLoadMultiSFTNoise(catalogX, &singleSFTvector, params->blksize, NULL)) != NULL, XLAL_EFUNC );
+      multiSFTnoise->data[ii] = singleSFTnoise->data[0];
+      singleSFTnoise->data[0] = NULL;
+      XLALDestroyMultiPSDVector(singleSFTnoise);
+   }
+
+   XLALDestroyMultiSFTCatalogView(multiCatalogView);
+   XLALDestroySFTCatalog(catalog);
+
+   fprintf(LOG, "done\n");
+   fprintf(stderr, "done\n");
+
+   return multiSFTnoise;
+
+} // getMultiSFTNoise()
+
 /**
  * Add SFTs together from a MultiSFTVector
  * \param [in]  multiSFTvector    Pointer to a MultiSFTVector containing the SFT data
@@ -1463,6 +1514,52 @@ INT4 tfRngMeans(REAL4VectorAligned *output, const REAL4VectorAligned *tfdata, co
 
 } // tfRngMeans()
 
+/**
+ * Determine the running mean of each SFT from the running medians loaded by getMultiSFTNoise(), instead of computing
+ * them with tfRngMeans(). The running medians are already converted to means, and cover the whole band of the SFT files,
+ * so they are also correct in the (blksize-1)/2 bins at either edge of the loaded band which tfRngMeans() drops.
+ * \param [out] output        Pointer to REAL4VectorAligned of running mean values of each SFT
+ * \param [in]  rngmeds       Pointer to PSDVector of running medians of the SFTs of one detector
+ * \param [in]  params        Pointer to UserInput_t
+ * \param [in]  numffts       Number of SFTs in the observation time
+ * \param [in]  numfbins      Number of frequency bins
+ * \param [in]  normalization Normalization value applied to the SFT powers by convertSFTdataToPowers()
+ * \return Status value
+ */
+INT4 tfRngMeansFromSFTNoise(REAL4VectorAligned *output, const PSDVector *rngmeds, const UserInput_t *params, const UINT4 numffts, const UINT4 numfbins, const REAL8 normalization)
+{
+
+   XLAL_CHECK( output != NULL && rngmeds != NULL && params != NULL && numffts > 0  && numfbins > 0, XLAL_EINVAL );
+
+   fprintf(LOG, "Assessing SFT background from SFT noise files... ");
+   fprintf(stderr, "Assessing SFT background from SFT noise files... ");
+
+   //First bin of the running medians that corresponds to the first output bin, as in tfRngMeans()
+   UINT4 offset = (params->blksize-1)/2;
+
+   //Place the running medians of each SFT in the same time slots as convertSFTdataToPowers()
+   UINT4 nonexistantsft = 0;
+   for (UINT4 ii=0; ii<numffts; ii++) {
+      const REAL8FrequencySeries *rngmed = NULL;
+      if (ii-nonexistantsft < rngmeds->length && rngmeds->data[ii-nonexistantsft].epoch.gpsSeconds == (INT4)round(ii*(params->Tsft-params->SFToverlap)+params->t0)) rngmed = &(rngmeds->data[ii-nonexistantsft]);
+      else nonexistantsft++;
+
+      if (rngmed != NULL) {
+         XLAL_CHECK( rngmed->data->length == numfbins + params->blksize - 1, XLAL_EBADLEN, "Running medians have %u bins, expected %u\n", rngmed->data->length, numfbins + params->blksize - 1 );
+         for (UINT4 jj=0; jj<numfbins; jj++) output->data[ii*numfbins + jj] = (REAL4)(normalization*rngmed->data->data[jj + offset]);
+      } else {
+         memset(&(output->data[ii*numfbins]), 0, sizeof(REAL4)*numfbins);
+      }
+   } /* for ii < numffts */
+
+   fprintf(LOG, "done\n");
+   fprintf(stderr, "done\n");
+   fprintf(stderr,"Mean of running means = %g\n", calcMean(output));
+
+   return XLAL_SUCCESS;
+
+} // tfRngMeansFromSFTNoise()
+
 /**
  * \param [in,out] tfdataarray Pointer to a REAL4VectorAlignedArray that has the time-frequency data of powers
  * \param [in]     numffts     Number of FFTs in the total observation time
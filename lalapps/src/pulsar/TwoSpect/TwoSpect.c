@@ -240,6 +240,10 @@ int main(int argc, char *argv[])
    if (!XLALUserVarWasSet(&uvar.injectionSources) && XLALUserVarWasSet(&uvar.inputSFTs) && !uvar.gaussNoiseWithSFTgaps && !XLALUserVarWasSet(&uvar.timestampsFile) && !XLALUserVarWasSet(&uvar.segmentFile)) XLAL_CHECK( (multiSFTvector = getMultiSFTVector(&uvar, minfbin, maxfbin)) != NULL, XLAL_EFUNC );
    else XLAL_CHECK( (multiSFTvector = generateSFTdata(&uvar, detectors, edat, maxbinshift, rng)) != NULL, XLAL_EFUNC );
 
+   //Load the running medians of the SFTs from SFT noise files, if requested
+   MultiPSDVector *multiSFTnoise = NULL;
+   if (uvar.SFTnoiseFiles && !uvar.signalOnly) XLAL_CHECK( (multiSFTnoise = getMultiSFTNoise(&uvar, multiSFTvector)) != NULL, XLAL_EFUNC );
+
    //Get timestamps of SFTs and determine joint timestamps
    MultiLIGOTimeGPSVector *multiSFTtimestamps = NULL;
    XLAL_CHECK( (multiSFTtimestamps = XLALExtractMultiTimestampsFromSFTs(multiSFTvector)) != NULL, XLAL_EFUNC );
@@ -279,7 +283,8 @@ int main(int argc, char *argv[])
       REAL4VectorAligned *tmpTFdata = NULL;
       XLAL_CHECK( (tmpTFdata = convertSFTdataToPowers(multiSFTvector->data[ii], &uvar, 2.0/(multiNoiseFloor.sqrtSn[0]*multiNoiseFloor.sqrtSn[0])/uvar.Tsft)) != NULL, XLAL_EFUNC );
       //Determine running means
-      if (!uvar.signalOnly) XLAL_CHECK( tfRngMeans(backgrounds->data[ii], tmpTFdata, ffdata->numffts, ffdata->numfbins+2*maxbinshift, uvar.blksize) == XLAL_SUCCESS, XLAL_EFUNC );
+      if (multiSFTnoise != NULL) XLAL_CHECK( tfRngMeansFromSFTNoise(backgrounds->data[ii], multiSFTnoise->data[ii], &uvar, ffdata->numffts, ffdata->numfbins+2*maxbinshift, 2.0/(multiNoiseFloor.sqrtSn[0]*multiNoiseFloor.sqrtSn[0])/uvar.Tsft) == XLAL_SUCCESS, XLAL_EFUNC );
+      else if (!uvar.signalOnly) XLAL_CHECK( tfRngMeans(backgrounds->data[ii], tmpTFdata, ffdata->numffts, ffdata->numfbins+2*maxbinshift, uvar.blksize) == XLAL_SUCCESS, XLAL_EFUNC );
       else memset(backgrounds->data[ii]->data, 0, sizeof(REAL4)*backgrounds->data[ii]->length);
       if (detectors->length==1) {
          XLAL_CHECK( (tfdata = XLALCreateREAL4VectorAligned(tmpTFdata->length, 32)) != NULL, XLAL_EFUNC );
@@ -288,6 +293,7 @@ int main(int argc, char *argv[])
       }
       XLALDestroyREAL4VectorAligned(tmpTFdata);
    }
+   XLALDestroyMultiPSDVector(multiSFTnoise);
    //Replace any zeros in detector 0 with data from first detector available
    XLAL_CHECK( replaceTFdataWithSubsequentTFdata(backgrounds, ffdata->numffts) == XLAL_SUCCESS, XLAL_EFUNC );
    //copy background data from detector 0
@@ -1740,6 +1746,7 @@ INT4 readTwoSpectInputParams(UserInput_t *uvar, int argc, char *argv[])
    XLALRegisterUvarMember(ULmaximumDeltaf,               REAL8, 0 , OPTIONAL,  "Maximum modulation depth counted in the upper limit value (Hz)");
    XLALRegisterUvarMember(allULvalsPerSkyLoc,            BOOLEAN, 0 , OPTIONAL,  "Print all UL values in the band specified by ULminimumDeltaf and ULmaximumDeltaf (default prints only the maximum UL)");
    XLALRegisterUvarMember(markBadSFTs,                   BOOLEAN, 0 , OPTIONAL,  "Mark bad SFTs");
+   XLALRegisterUvarMember(SFTnoiseFiles,                 BOOLEAN, 0 , OPTIONAL,  "Load the running medians of inputSFTs from SFT noise files written by lalapps_SFTnoise with the same blksize, instead of computing them");
    XLALRegisterUvarMember(lineDetection,                 REAL8, 0 , OPTIONAL,  "Detect stationary lines above threshold, and, if any present, set upper limit only, no template follow-up");
    XLALRegisterUvarMember(FFTplanFlag,                    INT4, 0 , OPTIONAL,  "0=Estimate, 1=Measure, 2=Patient, 3=Exhaustive");
    XLALRegisterUvarMember(fastchisqinv,                  BOOLEAN, 0 , OPTIONAL,  "Use a faster central chi-sq inversion function (roughly float precision instead of double)");
@@ -1837,6 +1844,9 @@ INT4 readTwoSpectInputParams(UserInput_t *uvar, int argc, char *argv[])
       XLAL_ERROR(XLAL_FAILURE, "Cannot specify segmentFile and timestampsFile\n");
    }
 
+   //SFT noise files can only be used with SFTs read from inputSFTs
+   if (uvar->SFTnoiseFiles && (!XLALUserVarWasSet(&uvar->inputSFTs) || XLALUserVarWasSet(&uvar->injectionSources) || uvar->gaussNoiseWithSFTgaps)) XLAL_ERROR(XLAL_EINVAL, "SFTnoiseFiles requires inputSFTs, and conflicts with injectionSources and gaussNoiseWithSFTgaps\n");
+
    //Check skyRegion and skyRegionFile options
    if ((XLALUserVarWasSet(&uvar->skyRegion) && XLALUserVarWasSet(&uvar->skyRegionFile)) || (!XLALUserVarWasSet(&uvar->skyRegion) && !XLALUserVarWasSet(&uvar->skyRegionFile))) XLAL_ERROR(XLAL_EINVAL, "Specify only one of skyRegion or skyRegionFile\n");
 
@@ -89,6 +89,7 @@ typedef struct {
    REAL8 ULmaximumDeltaf;
    BOOLEAN allULvalsPerSkyLoc;
    BOOLEAN markBadSFTs;
+   BOOLEAN SFTnoiseFiles;
    REAL8 lineDetection;
    INT4 FFTplanFlag;
    BOOLEAN fastchisqinv;
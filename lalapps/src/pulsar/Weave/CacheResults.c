@@ -28,6 +28,10 @@
 #include <lal/LALHashTbl.h>
 #include <lal/LALBitset.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // Compare two quantities, and return a sort order value if they are unequal
 #define COMPARE_BY( x, y ) do { if ( (x) < (y) ) return -1; if ( (x) > (y) ) return +1; } while(0)
 
@@ -135,6 +139,10 @@ struct tagWeaveCache {
   BOOLEAN all_gc;
   /// Save an no-longer-used cache item for re-use
   cache_item *saved_item;
+#ifdef _OPENMP
+  /// Lock which gives a thread exclusive access to the cache
+  omp_lock_t lock;
+#endif
 };
 
 ///
@@ -610,6 +618,60 @@ int XLALWeaveCacheQueriesGetCounts(
 
 }
 
+///
+/// Move the number of computed coherent results, and number of coherent and semicoherent templates,
+/// from one series of cache queries to another
+///
+int XLALWeaveCacheQueriesMoveCounts(
+  WeaveCacheQueries *queries,
+  WeaveCacheQueries *from_queries
+  )
+{
+
+  // Check input
+  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( from_queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( queries->nqueries == from_queries->nqueries, XLAL_ESIZE );
+
+  // Move counts
+  for ( size_t i = 0; i < queries->nqueries; ++i ) {
+    queries->coh_nres[i] += from_queries->coh_nres[i];
+    from_queries->coh_nres[i] = 0;
+    queries->coh_ntmpl[i] += from_queries->coh_ntmpl[i];
+    from_queries->coh_ntmpl[i] = 0;
+  }
+  queries->semi_ntmpl += from_queries->semi_ntmpl;
+  from_queries->semi_ntmpl = 0;
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Restrict garbage collection performed while retrieving results for a series of cache
+/// queries, so that it keeps all items still relevant to an earlier series of queries
+///
+/// This is needed when several semicoherent frequency blocks are processed concurrently:
+/// an item which is no longer relevant to a later block may still be required by an
+/// earlier block whose results have not yet been retrieved.
+///
+int XLALWeaveCacheQueriesKeepRelevant(
+  WeaveCacheQueries *queries,
+  const WeaveCacheQueries *earlier_queries
+  )
+{
+
+  // Check input
+  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( earlier_queries != NULL, XLAL_EFAULT );
+
+  // Lower the relevance threshold of the semicoherent frequency block, if necessary
+  queries->semi_relevance = GSL_MIN( queries->semi_relevance, earlier_queries->semi_relevance );
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Create a cache
 ///
@@ -637,6 +699,9 @@ WeaveCache *XLALWeaveCacheCreate(
   cache->semi_rssky_transf = semi_rssky_transf;
   cache->coh_input = coh_input;
   cache->generation = 0;
+#ifdef _OPENMP
+  omp_init_lock( &cache->lock );
+#endif
 
   // Set garbage collection mode:
   // - Garbage collection is not performed for a fixed-size cache (i.e. 'max_size > 0'),
@@ -773,6 +838,9 @@ void XLALWeaveCacheDestroy(
     XLALHashTblDestroy( cache->coh_index_hash );
     cache_item_destroy( cache->saved_item );
     XLALBitsetDestroy( cache->coh_computed_bitset );
+#ifdef _OPENMP
+    omp_destroy_lock( &cache->lock );
+#endif
     XLALFree( cache );
   }
 }
@@ -846,6 +914,49 @@ int XLALWeaveCacheClear(
 
 }
 
+///
+/// Acquire exclusive access to a cache
+///
+/// A cache may be shared between threads, each of which must hold the cache while it calls
+/// XLALWeaveCacheRetrieve() and uses the retrieved coherent results, since these may be
+/// removed from the cache (and their memory reused) as soon as another thread retrieves
+/// results. Without OpenMP this function does nothing.
+///
+int XLALWeaveCacheAcquire(
+  WeaveCache *cache
+  )
+{
+
+  // Check input
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+
+#ifdef _OPENMP
+  omp_set_lock( &cache->lock );
+#endif
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Release exclusive access to a cache acquired with XLALWeaveCacheAcquire()
+///
+int XLALWeaveCacheRelease(
+  WeaveCache *cache
+  )
+{
+
+  // Check input
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+
+#ifdef _OPENMP
+  omp_unset_lock( &cache->lock );
+#endif
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Retrieve coherent results for a given query, or compute new coherent results if not found
 ///
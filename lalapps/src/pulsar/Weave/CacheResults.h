@@ -71,6 +71,14 @@ int XLALWeaveCacheQueriesGetCounts(
   UINT8 *coh_ntmpl,
   UINT8 *semi_ntmpl
   );
+int XLALWeaveCacheQueriesMoveCounts(
+  WeaveCacheQueries *queries,
+  WeaveCacheQueries *from_queries
+  );
+int XLALWeaveCacheQueriesKeepRelevant(
+  WeaveCacheQueries *queries,
+  const WeaveCacheQueries *earlier_queries
+  );
 WeaveCache *XLALWeaveCacheCreate(
   const LatticeTiling *coh_tiling,
   const BOOLEAN interpolation,
@@ -94,6 +102,12 @@ int XLALWeaveCacheExpire(
 int XLALWeaveCacheClear(
   WeaveCache *cache
   );
+int XLALWeaveCacheAcquire(
+  WeaveCache *cache
+  );
+int XLALWeaveCacheRelease(
+  WeaveCache *cache
+  );
 int XLALWeaveCacheRetrieve(
   WeaveCache *cache,
   const WeaveCacheQueries *queries,
@@ -28,6 +28,10 @@
 
 #include <lal/UserInputPrint.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 ///
 /// Output results from a search
 ///
@@ -36,6 +40,11 @@ struct tagWeaveOutputResults {
   /// NOTE: this is the *owner* of WeaveStatisticsParams, which is where it will be freed at the end
   /// while toplists will simply hold a reference-pointer
   WeaveStatisticsParams *statistics_params;
+  /// Whether 'statistics_params' is shared with another output results structure, which owns it;
+  /// true for output results created by XLALWeaveOutputResultsCreateWorker()
+  BOOLEAN shares_statistics_params;
+  /// Whether main-loop parameters relevant for completion-loop statistics have been stored
+  BOOLEAN have_nsum2F;
   /// Reference time at which search is conducted
   LIGOTimeGPS ref_time;
   /// Number of spindown parameters to output
@@ -239,7 +248,9 @@ void XLALWeaveOutputResultsDestroy(
   )
 {
   if ( out != NULL ) {
-    XLALWeaveStatisticsParamsDestroy( out->statistics_params );
+    if ( !out->shares_statistics_params ) {
+      XLALWeaveStatisticsParamsDestroy( out->statistics_params );
+    }
     for ( size_t i = 0; i < out->ntoplists; ++i ) {
       XLALWeaveResultsToplistDestroy( out->toplists[i] );
     }
@@ -262,11 +273,14 @@ int XLALWeaveOutputResultsAdd(
   XLAL_CHECK( semi_res != NULL, XLAL_EFAULT );
 
   // Store main-loop parameters relevant for completion-loop statistics calculation
-  static BOOLEAN firstTime = 1;
-  if ( firstTime ) {
-    out->statistics_params->nsum2F = semi_res->nsum2F;
-    memcpy( out->statistics_params->nsum2F_det, semi_res->nsum2F_det, sizeof( semi_res->nsum2F_det ) );
-    firstTime = 0;
+  // - 'statistics_params' may be shared with output results being added to by other threads
+  if ( !out->have_nsum2F ) {
+#pragma omp critical (XLALWeaveOutputResultsAdd)
+    {
+      out->statistics_params->nsum2F = semi_res->nsum2F;
+      memcpy( out->statistics_params->nsum2F_det, semi_res->nsum2F_det, sizeof( semi_res->nsum2F_det ) );
+    }
+    out->have_nsum2F = 1;
   }
 
   // Add results to toplists
@@ -278,6 +292,54 @@ int XLALWeaveOutputResultsAdd(
 
 }
 
+///
+/// Create output results to which a worker thread can add semicoherent results, independently
+/// of 'out'; the results are later merged into 'out' with XLALWeaveOutputResultsMerge()
+///
+WeaveOutputResults *XLALWeaveOutputResultsCreateWorker(
+  const WeaveOutputResults *out
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( out != NULL, XLAL_EFAULT );
+
+  // Create output results which share 'statistics_params' with 'out'
+  WeaveOutputResults *worker_out = XLALWeaveOutputResultsCreate( &out->ref_time, out->nspins, out->statistics_params, out->toplist_limit, out->toplist_tmpl_idx );
+  XLAL_CHECK_NULL( worker_out != NULL, XLAL_EFUNC );
+  worker_out->shares_statistics_params = 1;
+
+  return worker_out;
+
+}
+
+///
+/// Merge output results added to by a worker thread into 'out', leaving the worker's toplists empty
+///
+int XLALWeaveOutputResultsMerge(
+  WeaveOutputResults *out,
+  WeaveOutputResults *worker_out
+  )
+{
+
+  // Check input
+  XLAL_CHECK( out != NULL, XLAL_EFAULT );
+  XLAL_CHECK( worker_out != NULL, XLAL_EFAULT );
+  XLAL_CHECK( worker_out->statistics_params == out->statistics_params, XLAL_EINVAL );
+  XLAL_CHECK( worker_out->ntoplists == out->ntoplists, XLAL_ESIZE );
+
+  // Merge toplists
+  for ( size_t i = 0; i < out->ntoplists; ++i ) {
+    XLAL_CHECK( XLALWeaveResultsToplistMerge( out->toplists[i], worker_out->toplists[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Main-loop parameters are stored in the shared 'statistics_params'
+  out->have_nsum2F = out->have_nsum2F || worker_out->have_nsum2F;
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Compute all the missing 'completion-loop' statistics for all toplist entries
 ///
@@ -52,6 +52,13 @@ int XLALWeaveOutputResultsAdd(
   const WeaveSemiResults *semi_res,
   const UINT4 semi_nfreqs
   );
+WeaveOutputResults *XLALWeaveOutputResultsCreateWorker(
+  const WeaveOutputResults *out
+  );
+int XLALWeaveOutputResultsMerge(
+  WeaveOutputResults *out,
+  WeaveOutputResults *worker_out
+  );
 int XLALWeaveOutputResultsCompletionLoop(
   WeaveOutputResults *out
   );
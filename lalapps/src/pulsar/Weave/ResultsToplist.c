@@ -855,6 +855,46 @@ int XLALWeaveResultsToplistWrite(
 
 }
 
+///
+/// Merge the items of one results toplist into another, leaving the former empty
+///
+int XLALWeaveResultsToplistMerge(
+  WeaveResultsToplist *toplist,
+  WeaveResultsToplist *from_toplist
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( from_toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( toplist->item_get_rank_stat_fcn == from_toplist->item_get_rank_stat_fcn, XLAL_EINVAL );
+  XLAL_CHECK( toplist->nspins == from_toplist->nspins, XLAL_EINVAL );
+
+  // Move all items from 'from_toplist' to 'toplist'
+  while ( XLALHeapSize( from_toplist->heap ) > 0 ) {
+
+    // Extract item with the smallest ranking statistic
+    WeaveResultsToplistItem *item = XLALHeapExtractRoot( from_toplist->heap );
+    XLAL_CHECK( item != NULL, XLAL_EFUNC );
+
+    // Add item to heap; 'item' now contains an item which was not kept, if any
+    XLAL_CHECK( XLALHeapAdd( toplist->heap, ( void ** ) &item ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Save no-longer-used item for re-use
+    if ( item != NULL ) {
+      if ( from_toplist->saved_item == NULL ) {
+        from_toplist->saved_item = item;
+      } else {
+        toplist_item_destroy( item );
+      }
+    }
+
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Read results from a FITS file and append to existing results toplist
 ///
@@ -103,6 +103,10 @@ int XLALWeaveResultsToplistWrite(
   FITSFile *file,
   const WeaveResultsToplist *toplist
   );
+int XLALWeaveResultsToplistMerge(
+  WeaveResultsToplist *toplist,
+  WeaveResultsToplist *from_toplist
+  );
 int XLALWeaveResultsToplistReadAppend(
   FITSFile *file,
   WeaveResultsToplist *toplist
@@ -33,6 +33,15 @@
 #include <lal/LogPrintf.h>
 #include <lal/UserInput.h>
 #include <lal/Random.h>
+#include <lal/SinCosLUT.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
+static int main_loop_block( const WeaveSimulationLevel simulation_level, const UINT4 ndetectors, const UINT4 nsegments, const double dfreq, const WeaveStatisticsParams *statistics_params, WeaveCache *const *coh_cache, WeaveCacheQueries *queries, const UINT8 semi_index, const PulsarDopplerParams *semi_phys, const UINT4 semi_nfreqs, WeaveSemiResults **semi_res, WeaveOutputResults *out, WeaveSearchTiming *tim );
 
 int main( int argc, char *argv[] )
 {
@@ -47,12 +56,12 @@ int main( int argc, char *argv[] )
 
   // Initialise user input variables
   struct uvar_type {
-    BOOLEAN validate_sft_files, interpolation, lattice_rand_offset, toplist_tmpl_idx, segment_info, simulate_search, time_search, cache_all_gc;
+    BOOLEAN validate_sft_files, Fstat_SFT_noise_files, interpolation, lattice_rand_offset, toplist_tmpl_idx, segment_info, simulate_search, time_search, cache_all_gc;
     CHAR *setup_file, *sft_files, *output_file, *ckpt_output_file;
     LALStringVector *sft_timestamps_files, *sft_noise_sqrtSX, *injections, *Fstat_assume_sqrtSX, *lrs_oLGX;
     REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth;
     REAL8Range alpha, delta, freq, f1dot, f2dot, f3dot, f4dot;
-    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size;
+    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size, threads;
     int lattice, Fstat_method, Fstat_SSB_precision, toplists, extra_statistics, recalc_statistics;
   } uvar_struct = {
     .Fstat_Dterms = Fstat_opt_args.Dterms,
@@ -70,6 +79,7 @@ int main( int argc, char *argv[] )
     .extra_statistics = WEAVE_STATISTIC_NONE,
     .recalc_statistics = WEAVE_STATISTIC_NONE,
     .nc_2Fth = 5.2,
+    .threads = 1,
   };
   struct uvar_type *const uvar = &uvar_struct;
 
@@ -225,6 +235,12 @@ int main( int argc, char *argv[] )
     "'3.2,4.3' to this option will assume that H1 SFTs contain noise with a sqrt(Sh) of 3.2, and L1 SFTs contain noise with a sqrt(Sh) of 4.3. "
     "If this option is not given, the SFTs are normalised using noise sqrt(Sh) estimated from the SFTs themselves. "
     );
+  XLALRegisterUvarMember(
+    Fstat_SFT_noise_files, BOOLEAN, 0, DEVELOPER,
+    "Normalise SFTs and compute noise weights using running medians read from the SFT noise files written by lalapps_SFTnoise "
+    "alongside the SFT files matched by " UVAR_STR( sft_files ) ", instead of computing the running medians from the SFTs. "
+    "The running median window used to write the SFT noise files must equal " UVAR_STR( Fstat_run_med_window ) ". "
+    );
   XLALRegisterUvarMember(
     Fstat_Dterms, UINT4, 0, DEVELOPER,
     "Number of Dirichlet kernel terms to use in computing the F-statistic. May not be available for all F-statistic methods. "
@@ -329,6 +345,12 @@ int main( int argc, char *argv[] )
     "If FALSE, whenever an item is added to the internal caches, at most one item that may no longer be required is removed. "
     "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
     );
+  XLALRegisterUvarMember(
+    threads, UINT4, 0, OPTIONAL,
+    "Number of threads used to compute semicoherent results. "
+    "Threads process successive semicoherent frequency blocks concurrently, share the internal caches of coherent results, and add results to separate toplists which are merged before output. "
+    "Values greater than 1 require that lalapps was built with OpenMP support. "
+    );
 
   // Parse user input
   XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC, "A call to XLALRegisterUvarMember() failed" );
@@ -355,6 +377,12 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     !UVAR_SET( sft_timebase ) || uvar->sft_timebase > 0,
                     UVAR_STR( sft_timebase ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    !uvar->Fstat_SFT_noise_files || UVAR_SET( sft_files ),
+                    UVAR_STR( Fstat_SFT_noise_files ) " requires " UVAR_STR( sft_files ) );
+  XLALUserVarCheck( &should_exit,
+                    !uvar->Fstat_SFT_noise_files || !UVAR_SET2( injections, Fstat_assume_sqrtSX ),
+                    UVAR_STR( Fstat_SFT_noise_files ) " is mutually exclusive with " UVAR_STR2AND( injections, Fstat_assume_sqrtSX ) );
   //
   // - Search parameter space
   //
@@ -428,6 +456,17 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     !UVAR_ALLSET2( time_search, ckpt_output_file ),
                     UVAR_STR2AND( time_search, ckpt_output_file ) " are mutually exclusive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads > 0,
+                    UVAR_STR( threads ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    !uvar->time_search || uvar->threads == 1,
+                    UVAR_STR( time_search ) " requires " UVAR_STR( threads ) " to be 1" );
+#ifndef _OPENMP
+  XLALUserVarCheck( &should_exit,
+                    uvar->threads == 1,
+                    UVAR_STR( threads ) " must be 1 since lalapps was built without OpenMP support" );
+#endif
 
   // Exit if required
   if ( should_exit ) {
@@ -801,6 +840,7 @@ int main( int argc, char *argv[] )
   Fstat_opt_args.SSBprec = uvar->Fstat_SSB_precision;
   Fstat_opt_args.Dterms = uvar->Fstat_Dterms;
   Fstat_opt_args.runningMedianWindow = uvar->Fstat_run_med_window;
+  Fstat_opt_args.loadSFTNoiseFiles = uvar->Fstat_SFT_noise_files;
   Fstat_opt_args.FstatMethod = uvar->Fstat_method;
   Fstat_opt_args.injectSources = injections;
   Fstat_opt_args.prevInput = NULL;
@@ -811,6 +851,10 @@ int main( int argc, char *argv[] )
   const LALStringVector *Fstat_assume_sqrtSX = UVAR_SET( Fstat_assume_sqrtSX ) ? uvar->Fstat_assume_sqrtSX : NULL;
   LogPrintf( LOG_NORMAL, "Loading input data for coherent results ...\n" );
   for ( size_t i = 0; i < nsegments; ++i ) {
+    if ( uvar->threads > 1 ) {
+      // Coherent results in different segments may be computed concurrently, so must not share an F-statistic workspace
+      Fstat_opt_args.prevInput = NULL;
+    }
     statistics_params->coh_input[i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], dfreq, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args, statistics_params, 0 );
     XLAL_CHECK_MAIN( statistics_params->coh_input[i] != NULL, XLAL_EFUNC );
   }
@@ -834,12 +878,31 @@ int main( int argc, char *argv[] )
   WeaveSearchIterator *main_loop_itr = XLALWeaveMainLoopSearchIteratorCreate( tiling[isemi], uvar->freq_partitions, uvar->f1dot_partitions );
   XLAL_CHECK_MAIN( main_loop_itr != NULL, XLAL_EFUNC );
 
-  // Create storage for cache queries for coherent results in each segment
+  // Number of threads used to compute semicoherent results
+  const UINT4 nthreads = uvar->threads;
+
+  // Maximum number of semicoherent frequency blocks which are iterated over and queried, then processed concurrently
+  // - Blocks are handed out to threads dynamically, so give each thread several blocks to balance their work
+  const UINT4 nblocks_max = ( nthreads > 1 ) ? 16 * nthreads : 1;
+
+  // Create storage for cache queries for coherent results in each segment:
+  // - 'queries' accumulates the number of computed coherent results and templates
+  // - 'block_queries' stores the queries for each semicoherent frequency block to be processed
   WeaveCacheQueries *queries = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
   XLAL_CHECK_MAIN( queries != NULL, XLAL_EFUNC );
+  WeaveCacheQueries *XLAL_INIT_DECL( block_queries, [nblocks_max] );
+  for ( size_t j = 0; j < nblocks_max; ++j ) {
+    block_queries[j] = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
+    XLAL_CHECK_MAIN( block_queries[j] != NULL, XLAL_EFUNC );
+  }
 
-  // Pointer to final semicoherent results
-  WeaveSemiResults *semi_res = NULL;
+  // Sequential indexes, physical coordinates, and number of frequencies of each semicoherent frequency block to be processed
+  UINT8 XLAL_INIT_DECL( block_semi_index, [nblocks_max] );
+  PulsarDopplerParams XLAL_INIT_DECL( block_semi_phys, [nblocks_max] );
+  UINT4 XLAL_INIT_DECL( block_semi_nfreqs, [nblocks_max] );
+
+  // Pointers to final semicoherent results for each thread
+  WeaveSemiResults *XLAL_INIT_DECL( semi_res, [nthreads] );
 
   // Create output results structure
   WeaveOutputResults *out = XLALWeaveOutputResultsCreate( &setup.ref_time, ninputspins, statistics_params, uvar->toplist_limit, uvar->toplist_tmpl_idx );
@@ -884,6 +947,29 @@ int main( int argc, char *argv[] )
 
   }
 
+  // Output results and search timing structures for each thread:
+  // - The main thread adds directly to 'out', and records timing in 'tim'
+  // - Other threads add to their own toplists, which are merged into 'out' before it is written,
+  //   and do not collect detailed timing information
+  WeaveOutputResults *XLAL_INIT_DECL( thread_out, [nthreads] );
+  WeaveSearchTiming *XLAL_INIT_DECL( thread_tim, [nthreads] );
+  thread_out[0] = out;
+  thread_tim[0] = tim;
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    thread_out[t] = XLALWeaveOutputResultsCreateWorker( out );
+    XLAL_CHECK_MAIN( thread_out[t] != NULL, XLAL_EFUNC );
+    thread_tim[t] = XLALWeaveSearchTimingCreate( 0, statistics_params );
+    XLAL_CHECK_MAIN( thread_tim[t] != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( thread_tim[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  if ( nthreads > 1 ) {
+    LogPrintf( LOG_NORMAL, "Computing semicoherent results with %u threads\n", nthreads );
+
+    // Initialise lookup tables used by the F-statistic before they can be accessed by more than one thread
+    XLALSinCosLUTInit();
+
+  }
+
   // Start timing main search loop
   XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( tim ) == XLAL_SUCCESS, XLAL_EFUNC );
 
@@ -901,89 +987,102 @@ int main( int argc, char *argv[] )
   // Print initial progress
   LogPrintf( LOG_NORMAL, "Starting main loop at %.3g%% complete, peak memory %.1fMB\n", XLALWeaveSearchIteratorProgress( main_loop_itr ), XLALGetPeakHeapUsageMB() );
 
+  // Current semicoherent frequency block returned by main loop iterator
+  BOOLEAN expire_cache = 0;
+  UINT8 semi_index = 0;
+  const gsl_vector *semi_rssky = NULL;
+  INT4 semi_left = 0;
+  INT4 semi_right = 0;
+  UINT4 freq_partition_index = 0;
+
+  // Whether the current semicoherent frequency block is still to be queried
+  BOOLEAN block_pending = 0;
+
   // Begin main loop
   BOOLEAN search_complete = 0;
   while ( !search_complete ) {
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Get next semicoherent frequency block
-    // - Exit main loop if iteration is complete
-    // - Expire cache items if requested by iterator
-    BOOLEAN expire_cache = 0;
-    UINT8 semi_index = 0;
-    const gsl_vector *semi_rssky = NULL;
-    INT4 semi_left = 0;
-    INT4 semi_right = 0;
-    UINT4 freq_partition_index = 0;
-    XLAL_CHECK( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( search_complete ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      break;
-    } else if ( expire_cache ) {
-      for ( size_t i = 0; i < nsegments; ++i ) {
-        XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Iterate over semicoherent frequency blocks, and query for their coherent results
+    UINT4 nblocks = 0;
+    while ( nblocks < nblocks_max ) {
+
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // Get next semicoherent frequency block, unless the current block is still to be queried
+      // - Exit iteration if main loop iteration is complete
+      // - Expire cache items if requested by iterator; since items may still be required by the
+      //   blocks already queried, these must be processed before the current block is queried
+      if ( !block_pending ) {
+        XLAL_CHECK_MAIN( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+        if ( search_complete ) {
+          XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+          break;
+        } else if ( expire_cache && nblocks > 0 ) {
+          block_pending = 1;
+          XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+          break;
+        }
+      }
+      block_pending = 0;
+      if ( expire_cache ) {
+        for ( size_t i = 0; i < nsegments; ++i ) {
+          XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+        expire_cache = 0;
       }
-    }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Initialise cache queries
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Initialise cache queries
+      WeaveCacheQueries *block_query = block_queries[nblocks];
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( block_query, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Query for coherent results for each segment
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
-    }
+      // Query for coherent results for each segment
+      for ( size_t i = 0; i < nsegments; ++i ) {
+        XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], block_query, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
 
-    // Finalise cache queries
-    PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
-    UINT4 semi_nfreqs = 0;
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( semi_nfreqs == 0 ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      continue;
-    }
+      // Finalise cache queries
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesFinal( block_query, &block_semi_phys[nblocks], &block_semi_nfreqs[nblocks] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Switch timing section
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Retrieve coherent results from each segment
-    const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
-    UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
-    UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( coh_res[i] != NULL, XLAL_EFUNC );
-    }
+      // Skip semicoherent frequency block if it has no points in this frequency partition
+      if ( block_semi_nfreqs[nblocks] == 0 ) {
+        continue;
+      }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Keep cache items which are still relevant to the first queried block while this block is processed
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesKeepRelevant( block_query, block_queries[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // Initialise semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsInit( &semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Add semicoherent frequency block to those to be processed
+      block_semi_index[nblocks] = semi_index;
+      ++nblocks;
 
-    // Add coherent results to semicoherent results
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveSemiResultsAdd( semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Compute all toplist-ranking semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsComputeMain( semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Add semicoherent results to output
-    XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Compute semicoherent results for each queried semicoherent frequency block, and add them to output results
+    int nerrors = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) reduction(+:nerrors)
+    for ( UINT4 j = 0; j < nblocks; ++j ) {
+#ifdef _OPENMP
+      const int t = omp_get_thread_num();
+#else
+      const int t = 0;
+#endif
+      if ( nerrors == 0 && main_loop_block( simulation_level, ndetectors, nsegments, dfreq, statistics_params, coh_cache, block_queries[j], block_semi_index[j], &block_semi_phys[j], block_semi_nfreqs[j], &semi_res[t], thread_out[t], thread_tim[t] ) != XLAL_SUCCESS ) {
+        ++nerrors;
+      }
+    }
+    XLAL_CHECK_MAIN( nerrors == 0, XLAL_EFUNC, "Failed to compute semicoherent results" );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+    // Accumulate number of computed coherent results and templates
+    for ( size_t j = 0; j < nblocks_max; ++j ) {
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesMoveCounts( queries, block_queries[j] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
 
     // Main iterator percentage complete
     const REAL4 prog_per_cent = XLALWeaveSearchIteratorProgress( main_loop_itr );
@@ -1027,7 +1126,8 @@ int main( int argc, char *argv[] )
     }
 
     // Checkpoint output results, if required
-    if ( UVAR_SET( ckpt_output_file ) ) {
+    // - Iterator state includes the current semicoherent frequency block, so wait until it has been processed
+    if ( UVAR_SET( ckpt_output_file ) && !block_pending ) {
 
       // Switch timing section
       XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_CKPT ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1047,7 +1147,10 @@ int main( int argc, char *argv[] )
         ++ckpt_output_count;
         XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "ckptcnt", ckpt_output_count, "number of checkpoints" ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-        // Write output results
+        // Merge output results of all threads, then write output results
+        for ( size_t t = 1; t < nthreads; ++t ) {
+          XLAL_CHECK_MAIN( XLALWeaveOutputResultsMerge( out, thread_out[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
         XLAL_CHECK_MAIN( XLALWeaveOutputResultsWrite( file, out ) == XLAL_SUCCESS, XLAL_EFUNC );
 
         // Save state of main loop iterator
@@ -1078,6 +1181,11 @@ int main( int argc, char *argv[] )
 
   }   // End of main loop
 
+  // Merge output results of all threads
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    XLAL_CHECK_MAIN( XLALWeaveOutputResultsMerge( out, thread_out[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
   // Clear all cache items from memory
   for ( size_t i = 0; i < nsegments; ++i ) {
     XLAL_CHECK_MAIN( XLALWeaveCacheClear( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1205,18 +1313,29 @@ int main( int argc, char *argv[] )
 
   // Cleanup memory from search timing
   XLALWeaveSearchTimingDestroy( tim );
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    XLALWeaveSearchTimingDestroy( thread_tim[t] );
+  }
 
   // Cleanup memory from output results
+  for ( size_t t = 1; t < nthreads; ++t ) {
+    XLALWeaveOutputResultsDestroy( thread_out[t] );
+  }
   XLALWeaveOutputResultsDestroy( out );
 
   // Cleanup memory from semicoherent results
-  XLALWeaveSemiResultsDestroy( semi_res );
+  for ( size_t t = 0; t < nthreads; ++t ) {
+    XLALWeaveSemiResultsDestroy( semi_res[t] );
+  }
 
   // Cleanup memory from parameter-space iteration
   XLALWeaveSearchIteratorDestroy( main_loop_itr );
 
   // Cleanup memory from computing 'stage 0' coherent results
   XLALWeaveCacheQueriesDestroy( queries );
+  for ( size_t j = 0; j < nblocks_max; ++j ) {
+    XLALWeaveCacheQueriesDestroy( block_queries[j] );
+  }
   for ( size_t i = 0; i < nsegments; ++i ) {
     XLALWeaveCacheDestroy( coh_cache[i] );
   }
@@ -1253,6 +1372,79 @@ int main( int argc, char *argv[] )
 
 }
 
+///
+/// Compute semicoherent results for a queried semicoherent frequency block, and add them to output results
+///
+/// Coherent results are retrieved from caches which may be shared between threads; each cache is held
+/// while its coherent results are retrieved (and computed, if required) and added to the semicoherent
+/// results, so that no other thread can remove them from the cache in the meantime.
+///
+int main_loop_block(
+  const WeaveSimulationLevel simulation_level,
+  const UINT4 ndetectors,
+  const UINT4 nsegments,
+  const double dfreq,
+  const WeaveStatisticsParams *statistics_params,
+  WeaveCache *const *coh_cache,
+  WeaveCacheQueries *queries,
+  const UINT8 semi_index,
+  const PulsarDopplerParams *semi_phys,
+  const UINT4 semi_nfreqs,
+  WeaveSemiResults **semi_res,
+  WeaveOutputResults *out,
+  WeaveSearchTiming *tim
+  )
+{
+
+  // Initialise semicoherent results
+  XLAL_CHECK( XLALWeaveSemiResultsInit( semi_res, simulation_level, ndetectors, nsegments, semi_index, semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Retrieve coherent results from each segment, and add them to semicoherent results
+  for ( size_t i = 0; i < nsegments; ++i ) {
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Retrieve coherent results, switch timing section, and add coherent results to semicoherent results
+    // - Release cache before checking for errors, so that other threads are not left waiting for it
+    XLAL_CHECK( XLALWeaveCacheAcquire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const WeaveCohResults *coh_res = NULL;
+    UINT8 coh_index = 0;
+    UINT4 coh_offset = 0;
+    int retn = XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res, &coh_index, &coh_offset, tim );
+    if ( retn == XLAL_SUCCESS ) {
+      retn = XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG );
+    }
+    if ( retn == XLAL_SUCCESS ) {
+      retn = XLALWeaveSemiResultsAdd( *semi_res, coh_res, coh_index, coh_offset, tim );
+    }
+    XLAL_CHECK( XLALWeaveCacheRelease( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Switch timing section
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  }
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Compute all toplist-ranking semicoherent results
+  XLAL_CHECK( XLALWeaveSemiResultsComputeMain( *semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Add semicoherent results to output
+  XLAL_CHECK( XLALWeaveOutputResultsAdd( out, *semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
 // Local Variables:
 // c-file-style: "linux"
 // c-basic-offset: 2
@@ -0,0 +1,66 @@
+# Perform an interpolating and a non-interpolating search without/with multiple threads, and check for consistent results
+
+export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
+
+for setup in interpolating non_interpolating; do
+
+    case ${setup} in
+
+        interpolating)
+            weave_search_options="--alpha=0.9/1.4 --delta=-1.2/2.3 --freq=50.5/0.01 --f1dot=-1.5e-9,0 --semi-max-mismatch=5 --coh-max-mismatch=0.3 --freq-partitions=2"
+            ;;
+
+        non_interpolating)
+            weave_search_options="--interpolation=no --alpha=0.9/0.4 --delta=-1.2/1.3 --freq=50.5/0.005 --f1dot=-1.5e-9,0 --semi-max-mismatch=5"
+            ;;
+
+        *)
+            echo "$0: unknown setup '${setup}'"
+            exit 1
+
+    esac
+
+    echo "=== Setup '${setup}': Create search setup ==="
+    set -x
+    lalapps_WeaveSetup --first-segment=1122332211/90000 --segment-count=3 --detectors=H1,L1 --output-file=WeaveSetup.fits
+    lalapps_fits_overview WeaveSetup.fits
+    set +x
+    echo
+
+    echo "=== Setup '${setup}': Perform search with 1 thread ==="
+    set -x
+    lalapps_Weave --threads=1 --output-file=WeaveOut1.fits \
+        --toplists=all --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
+        --rand-seed=3456 --sft-timebase=1800 --sft-noise-sqrtSX=1,1 \
+        ${weave_search_options}
+    lalapps_fits_overview WeaveOut1.fits
+    set +x
+    echo
+
+    echo "=== Setup '${setup}': Perform search with 3 threads ==="
+    set -x
+    lalapps_Weave --threads=3 --output-file=WeaveOut3.fits \
+        --toplists=all --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
+        --rand-seed=3456 --sft-timebase=1800 --sft-noise-sqrtSX=1,1 \
+        ${weave_search_options}
+    lalapps_fits_overview WeaveOut3.fits
+    set +x
+    echo
+
+    echo "=== Setup '${setup}': Check that number of coherent results and templates are equal ==="
+    set -x
+    for keyword in NCOHRES NCOHTPL NSEMITPL; do
+        value_1=`lalapps_fits_header_getval "WeaveOut1.fits[0]" "${keyword}" | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+        value_3=`lalapps_fits_header_getval "WeaveOut3.fits[0]" "${keyword}" | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+        expr ${value_1} '=' ${value_3}
+    done
+    set +x
+    echo
+
+    echo "=== Setup '${setup}': Compare F-statistics from lalapps_Weave with 1 and 3 threads ==="
+    set -x
+    env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOut1.fits --result-file-2=WeaveOut3.fits
+    set +x
+    echo
+
+done
@@ -21,13 +21,33 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+#include <unistd.h>
 #include <lal/LALInference.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALInferenceReadData.h>
 #include <lal/LALInferenceCalibrationErrors.h>
 #include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceProposal.h>
 #include <lal/LALInferenceTemplate.h>
-#include <sys/resource.h>
+#include <lal/LALInferenceVCSInfo.h>
+#include <lal/LALSimInspiral.h>
+#include <lal/DetResponse.h>
+#include <lal/TimeDelay.h>
+#include <lal/Date.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
 
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
@@ -36,28 +56,72 @@
 #endif
 
 const char HELPSTR[]=\
-"lalinference_bench: Benchmark template and likelihood functions.\n\
+"lalinference_bench: Benchmark the components of the likelihood calculation.\n\
+ Each component is timed call by call, and the timings are written as JSON\n\
+ with per-component percentiles and allocations per call, so that they can\n\
+ be compared between releases and machines.\n\
  Options:\n\
-    --Niter            : Number of calls to time (delfault 1000) \n\
-    --bench-template   : Only benchmark template function\n\
-    --bench-likelihood : Only benchmark likelihood function\n\
-                         (defaults to benchmarking both)\n\
+    --Niter N            : Number of calls to time per component and parameter point (default 1000)\n\
+    --Npoints N          : Number of parameter points to sweep over; the first is the starting\n\
+                           point, the others are drawn from the prior (default 1)\n\
+    --bench-template     : Only benchmark the template function\n\
+    --bench-likelihood   : Only benchmark the likelihood function\n\
+                           (defaults to benchmarking all components)\n\
+    --bench-variants     : Also time the undecomposed and phase-marginalised likelihoods\n\
+                           alongside the one selected by the likelihood options\n\
+    --bench-threads N    : Measure the throughput of the full likelihood on 1, 2, 4, ..., N\n\
+                           threads (requires OpenMP, default 1)\n\
+    --bench-output FILE  : Write the JSON report to FILE (default stdout)\n\
  Example (for 1.0-1.0 binary with seglen 8, srate 4096): \n\
  $ ./lalinference_bench --psdlength 1000 --psdstart 1 --seglen 8 --srate 4096 --trigtime 0 --ifo H1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --dataseed 1324 --Niter 10000 --fix-chirpmass 1.218 --fix-q 1.0\n\n\n\
 ";
 
-void fprintf_bench(FILE *fp, struct rusage start, struct rusage end, UINT4 Niter);
-void fprintf_bench(FILE *fp, struct rusage start, struct rusage end, UINT4 Niter)
+/*
+ * Count calls to the C allocator, by interposing malloc, calloc and realloc
+ * on top of the glibc implementations.  Counting is switched on only while a
+ * single-threaded component is being timed.
+ */
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t n);
+extern void *__libc_calloc(size_t m, size_t n);
+extern void *__libc_realloc(void *p, size_t n);
+static volatile int bench_count_allocs = 0;
+static UINT8 bench_allocs = 0;
+void *malloc(size_t n)
 {
-  REAL8 utime = (end.ru_utime.tv_sec - start.ru_utime.tv_sec) + 1e-6 * (end.ru_utime.tv_usec - start.ru_utime.tv_usec);
-  REAL8 stime = (end.ru_stime.tv_sec - start.ru_stime.tv_sec) + 1e-6 * (end.ru_stime.tv_usec - start.ru_stime.tv_usec);
-  
-  fprintf(fp,"USER Total: %lf s\n",utime);
-  fprintf(fp,"USER Per iteration: %e s\n",utime / (double) Niter);
-  
-  fprintf(fp,"SYS Total: %lf s\n",stime);
-  fprintf(fp,"SYS Per iteration: %e s\n",stime / (double) Niter);
+  if (bench_count_allocs) bench_allocs++;
+  return __libc_malloc(n);
 }
+void *calloc(size_t m, size_t n)
+{
+  if (bench_count_allocs) bench_allocs++;
+  return __libc_calloc(m, n);
+}
+void *realloc(void *p, size_t n)
+{
+  if (bench_count_allocs) bench_allocs++;
+  return __libc_realloc(p, n);
+}
+#define BENCH_COUNT_ALLOCS 1
+#endif
+
+static REAL8 bench_clock(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/* Timings of one component, accumulated over the parameter sweep */
+typedef struct tagBenchComponent {
+  char name[64];
+  REAL8 *times;
+  UINT4 ncalls;
+  UINT8 nallocs;
+  UINT4 noop_template; /* Time on templates that have already been generated */
+} BenchComponent;
+
+typedef void (*BenchFunction)(LALInferenceRunState *runState, LALInferenceThreadState *thread, LALInferenceLikelihoodFunction likelihood);
 
 void LALInferenceTemplateNoop(UNUSED LALInferenceModel *model);
 void LALInferenceTemplateNoop(UNUSED LALInferenceModel *model)
@@ -65,51 +129,175 @@ void LALInferenceTemplateNoop(UNUSED LALInferenceModel *model)
   return;
 }
 
-void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter);
-void bench_likelihood(LALInferenceRunState *runState,UINT4 Niter)
-{
-  UINT4 i=0;
-  struct rusage r_usage_start,r_usage_end;
-  
-  /* Clear the template */
-  LALInferenceTemplateNullFreqdomain(runState->threads[0].model);
-  
-  LALInferenceTemplateFunction old_templt=runState->threads[0].model->templt;
-  runState->threads[0].model->templt=LALInferenceTemplateNoop;
-  
-  fprintf(stdout,"Benchmarking likelihood:\n");
-  getrusage(RUSAGE_SELF, &r_usage_start);
-  for(i=0;i<Niter;i++)
-  {
-    runState->likelihood(runState->threads[0].model->params,runState->data, runState->threads[0].model);
+static void bench_prior(LALInferenceRunState *runState, LALInferenceThreadState *thread, UNUSED LALInferenceLikelihoodFunction likelihood)
+{
+  runState->prior(runState, thread->currentParams, thread->model);
+}
+
+static void bench_proposal(UNUSED LALInferenceRunState *runState, LALInferenceThreadState *thread, UNUSED LALInferenceLikelihoodFunction likelihood)
+{
+  thread->proposal(thread, thread->currentParams, thread->proposedParams);
+}
+
+static void bench_template(UNUSED LALInferenceRunState *runState, LALInferenceThreadState *thread, UNUSED LALInferenceLikelihoodFunction likelihood)
+{
+  thread->model->templt(thread->model);
+}
+
+/*
+ * Project the plus and cross polarisations onto each detector and shift
+ * them to the arrival time there, as the likelihood does before summing
+ * over frequency bins.
+ */
+static void bench_projection(LALInferenceRunState *runState, LALInferenceThreadState *thread, UNUSED LALInferenceLikelihoodFunction likelihood)
+{
+  LALInferenceModel *model = thread->model;
+  LALInferenceVariables *params = thread->currentParams;
+  const REAL8 ra = LALInferenceGetREAL8Variable(params, "rightascension");
+  const REAL8 dec = LALInferenceGetREAL8Variable(params, "declination");
+  const REAL8 psi = LALInferenceGetREAL8Variable(params, "polarisation");
+  const REAL8 tc = LALInferenceGetREAL8Variable(params, "time");
+  LIGOTimeGPS GPSlal;
+  XLALGPSSetREAL8(&GPSlal, tc);
+  const REAL8 gmst = XLALGreenwichMeanSiderealTime(&GPSlal);
+  const REAL8 tmodel = XLALGPSGetREAL8(&model->freqhPlus->epoch);
+
+  LALInferenceIFOData *dataPtr;
+  UINT4 ifo;
+  for (dataPtr = runState->data, ifo = 0; dataPtr; dataPtr = dataPtr->next, ifo++) {
+    REAL8 Fplus, Fcross;
+    XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
+    const REAL8 timeshift = (tc - tmodel) + XLALTimeDelayFromEarthCenter(dataPtr->detector->location, ra, dec, &GPSlal);
+    const REAL8 deltaF = model->deltaF;
+    const UINT4 lower = (UINT4) ceil(dataPtr->fLow / deltaF);
+    UINT4 upper = (UINT4) floor(dataPtr->fHigh / deltaF);
+    if (upper >= model->freqhs[ifo]->data->length) upper = model->freqhs[ifo]->data->length - 1;
+    const COMPLEX16 *hp = model->freqhPlus->data->data;
+    const COMPLEX16 *hc = model->freqhCross->data->data;
+    COMPLEX16 *h = model->freqhs[ifo]->data->data;
+    for (UINT4 i = lower; i <= upper; i++)
+      h[i] = (Fplus * hp[i] + Fcross * hc[i]) * cexp(-I * LAL_TWOPI * timeshift * deltaF * i);
   }
-  getrusage(RUSAGE_SELF, &r_usage_end);
-  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
-  runState->threads[0].model->templt=old_templt;
-  
 }
 
-void bench_template(LALInferenceRunState *runState, UINT4 Niter);
-void bench_template(LALInferenceRunState *runState, UINT4 Niter)
+static void bench_likelihood(LALInferenceRunState *runState, LALInferenceThreadState *thread, LALInferenceLikelihoodFunction likelihood)
 {
-  UINT4 i=0;
-  struct rusage r_usage_start,r_usage_end;
-  fprintf(stdout,"Benchmarking template:\n");
-  getrusage(RUSAGE_SELF, &r_usage_start);
-  for(i=0;i<Niter;i++)
-  {
-    runState->threads[0].model->templt(runState->threads[0].model);
+  likelihood(thread->currentParams, runState->data, thread->model);
+}
+
+/* Time niter calls of a component on thread 0, appending to its timings */
+static void bench_component(BenchComponent *c, BenchFunction f, LALInferenceRunState *runState,
+                            LALInferenceLikelihoodFunction likelihood, UINT4 niter)
+{
+  LALInferenceThreadState *thread = &runState->threads[0];
+#ifdef BENCH_COUNT_ALLOCS
+  const UINT8 allocs = bench_allocs;
+  bench_count_allocs = 1;
+#endif
+  for (UINT4 i = 0; i < niter; i++) {
+    const REAL8 start = bench_clock();
+    f(runState, thread, likelihood);
+    c->times[c->ncalls++] = bench_clock() - start;
+  }
+#ifdef BENCH_COUNT_ALLOCS
+  bench_count_allocs = 0;
+  c->nallocs += bench_allocs - allocs;
+#endif
+}
+
+static int compare_REAL8(const void *a, const void *b)
+{
+  const REAL8 x = *(const REAL8 *)a, y = *(const REAL8 *)b;
+  return (x > y) - (x < y);
+}
+
+static REAL8 percentile(const REAL8 *sorted, UINT4 n, REAL8 p)
+{
+  const REAL8 x = p * (n - 1);
+  const UINT4 i = (UINT4) floor(x);
+  if (i + 1 >= n) return sorted[n - 1];
+  return sorted[i] + (x - i) * (sorted[i + 1] - sorted[i]);
+}
+
+static void fprintf_json_string(FILE *fp, const char *s)
+{
+  fputc('"', fp);
+  for (; s && *s; s++) {
+    if (*s == '"' || *s == '\\') fprintf(fp, "\\%c", *s);
+    else if ((unsigned char)*s < 0x20) fprintf(fp, "\\u%04x", *s);
+    else fputc(*s, fp);
+  }
+  fputc('"', fp);
+}
+
+static void fprintf_component(FILE *fp, BenchComponent *c)
+{
+  REAL8 sum = 0;
+  for (UINT4 i = 0; i < c->ncalls; i++) sum += c->times[i];
+  qsort(c->times, c->ncalls, sizeof(REAL8), compare_REAL8);
+  fprintf(fp, "    {\"name\": ");
+  fprintf_json_string(fp, c->name);
+  fprintf(fp, ", \"calls\": %u, \"total\": %.6e, \"mean\": %.6e, \"min\": %.6e, \"p50\": %.6e, \"p90\": %.6e, \"p99\": %.6e, \"max\": %.6e, ",
+          c->ncalls, sum, sum / c->ncalls, c->times[0], percentile(c->times, c->ncalls, 0.5),
+          percentile(c->times, c->ncalls, 0.9), percentile(c->times, c->ncalls, 0.99), c->times[c->ncalls - 1]);
+#ifdef BENCH_COUNT_ALLOCS
+  fprintf(fp, "\"allocations_per_call\": %.3f}", (REAL8) c->nallocs / c->ncalls);
+#else
+  fprintf(fp, "\"allocations_per_call\": null}");
+#endif
+}
+
+static const char *likelihood_name(LALInferenceLikelihoodFunction likelihood)
+{
+  if (likelihood == &LALInferenceUndecomposedFreqDomainLogLikelihood) return "undecomposed";
+  if (likelihood == &LALInferenceMarginalisedPhaseLogLikelihood) return "margphi";
+  if (likelihood == &LALInferenceMarginalisedTimeLogLikelihood) return "margtime";
+  if (likelihood == &LALInferenceMarginalisedTimePhaseLogLikelihood) return "margtimephi";
+  if (likelihood == &LALInferenceFreqDomainStudentTLogLikelihood) return "studentT";
+  if (likelihood == &LALInferenceZeroLogLikelihood) return "zero";
+  if (likelihood == &LALInferenceFastSineGaussianLogLikelihood) return "fastSineGaussian";
+  return "other";
+}
+
+/* Move every thread to the same parameter point, and fill its template buffers */
+static void bench_set_point(LALInferenceRunState *runState, UINT4 point)
+{
+  LALInferenceThreadState *thread = &runState->threads[0];
+  if (point > 0) {
+    /* Draw until the point is inside the prior, including its constraints */
+    LALInferenceVariables start;
+    memset(&start, 0, sizeof(start));
+    LALInferenceCopyVariables(thread->currentParams, &start);
+    UINT4 tries;
+    for (tries = 0; tries < 1000; tries++) {
+      LALInferenceCopyVariables(&start, thread->currentParams);
+      LALInferenceDrawFromPrior(thread->currentParams, runState->priorArgs, thread->GSLrandom);
+      if (runState->prior(runState, thread->currentParams, thread->model) > -INFINITY)
+        break;
+    }
+    if (tries == 1000)
+      LALInferenceCopyVariables(&start, thread->currentParams);
+    LALInferenceClearVariables(&start);
+  }
+  for (INT4 t = 0; t < runState->nthreads; t++) {
+    LALInferenceThreadState *th = &runState->threads[t];
+    if (t > 0) LALInferenceCopyVariables(thread->currentParams, th->currentParams);
+    LALInferenceCopyVariables(th->currentParams, th->proposedParams);
+    th->currentLikelihood = runState->likelihood(th->currentParams, runState->data, th->model);
+    th->currentPrior = runState->prior(runState, th->currentParams, th->model);
   }
-  getrusage(RUSAGE_SELF, &r_usage_end);
-  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
 }
 
 int main(int argc, char *argv[]){
   ProcessParamsTable *procParams = NULL,*ppt=NULL;
   LALInferenceRunState *runState=NULL;
   UINT4 Niter=1000;
+  UINT4 Npoints=1;
+  INT4 Nthreads=1;
   UINT4 bench_L=1;
   UINT4 bench_T=1;
+  UINT4 bench_variants=0;
+  FILE *fpout=stdout;
   int helpflag=0;
   procParams=LALInferenceParseCommandLine(argc,argv);
 
@@ -121,6 +309,10 @@ int main(int argc, char *argv[]){
   }
   if((ppt=LALInferenceGetProcParamVal(procParams,"--Niter")))
      Niter=atoi(ppt->value);
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--Npoints")))
+     Npoints=atoi(ppt->value);
+  if((ppt=LALInferenceGetProcParamVal(procParams,"--bench-threads")))
+     Nthreads=atoi(ppt->value);
   if(LALInferenceGetProcParamVal(procParams,"--bench-template"))
   {
     bench_T=1; bench_L=0;
@@ -129,8 +321,21 @@ int main(int argc, char *argv[]){
   {
     bench_T=0; bench_L=1;
   }
+  if(LALInferenceGetProcParamVal(procParams,"--bench-variants"))
+    bench_variants=1;
+  if(Niter<1 || Npoints<1 || Nthreads<1)
+  {
+    fprintf(stderr,"--Niter, --Npoints and --bench-threads must be positive\n");
+    exit(1);
+  }
+#ifndef _OPENMP
+  if(Nthreads>1)
+  {
+    fprintf(stderr,"Warning: not built with OpenMP, ignoring --bench-threads %d\n",Nthreads);
+    Nthreads=1;
+  }
+#endif
 
-  
   runState = LALInferenceInitRunState(procParams);
 
   if(runState && !helpflag) {
@@ -139,28 +344,162 @@ int main(int argc, char *argv[]){
     /* Simulate calibration errors */
     LALInferenceApplyCalibrationErrors(runState->data,runState->commandLine);
   }
-  
-  /* Set up the template and likelihood functions */
-  LALInferenceInitCBCThreads(runState,1);
+
+  /* Set up the template, prior and likelihood functions */
+  LALInferenceInitCBCThreads(runState,Nthreads);
+  LALInferenceInitCBCPrior(runState);
   LALInferenceInitLikelihood(runState);
+  if (helpflag) return(0);
 
-  /* Disable waveform caching */
-  if (!helpflag) runState->threads[0].model->waveformCache=NULL;
-  
-  if(bench_T)
-  {
-    printf("Template test will run with parameters:\n");
-    LALInferencePrintVariables(runState->threads[0].model->params);
-    printf("\n");
+  for (INT4 t = 0; t < runState->nthreads; t++) {
+    LALInferenceThreadState *thread = &runState->threads[t];
+    /* Disable waveform caching */
+    thread->model->waveformCache=NULL;
+    thread->proposal = &LALInferenceCyclicProposal;
+    thread->proposalArgs = LALInferenceParseProposalArgs(runState);
+    thread->cycle = LALInferenceSetupDefaultInspiralProposalCycle(thread->proposalArgs);
+    LALInferenceRandomizeProposalCycle(thread->cycle, thread->GSLrandom);
+  }
+  LALInferenceThreadState *thread = &runState->threads[0];
+  LALInferenceModel *model = thread->model;
+
+  fprintf(stderr,"Benchmark will start from parameters:\n");
+  LALInferencePrintVariables(thread->currentParams);
 
-    bench_template(runState,Niter);
-    printf("\n");
+  /* Likelihoods to time: the configured one, and optionally the others that
+   * need no extra setup and are compatible with ROQ and relative binning */
+  LALInferenceLikelihoodFunction likelihoods[3] = {runState->likelihood, NULL, NULL};
+  UINT4 nlikelihoods = 1;
+  if (bench_variants) {
+    LALInferenceLikelihoodFunction variants[2] = {&LALInferenceUndecomposedFreqDomainLogLikelihood, &LALInferenceMarginalisedPhaseLogLikelihood};
+    for (UINT4 v = 0; v < 2; v++)
+      if (variants[v] != runState->likelihood)
+        likelihoods[nlikelihoods++] = variants[v];
   }
-  if(bench_L)
-  {
-    bench_likelihood(runState,Niter);
-    printf("\n");
+
+  /* Projection on the full frequency grid is only meaningful without ROQ or relative binning */
+  const UINT4 bench_P = bench_L && !model->roq_flag && !model->relbin_flag && model->freqhs;
+
+  BenchComponent components[16];
+  BenchFunction functions[16];
+  LALInferenceLikelihoodFunction args[16];
+  UINT4 ncomp = 0;
+#define ADD_COMPONENT(n, f, l, noop) do { \
+    snprintf(components[ncomp].name, sizeof(components[ncomp].name), "%s", n); \
+    components[ncomp].times = XLALMalloc(Niter * Npoints * sizeof(REAL8)); \
+    components[ncomp].ncalls = 0; \
+    components[ncomp].nallocs = 0; \
+    components[ncomp].noop_template = noop; \
+    functions[ncomp] = f; \
+    args[ncomp] = l; \
+    ncomp++; \
+  } while (0)
+  if (bench_L) {
+    ADD_COMPONENT("prior", bench_prior, NULL, 0);
+    ADD_COMPONENT("proposal", bench_proposal, NULL, 0);
+  }
+  if (bench_T)
+    ADD_COMPONENT("template", bench_template, NULL, 0);
+  if (bench_P)
+    ADD_COMPONENT("projection", bench_projection, NULL, 0);
+  if (bench_L) {
+    for (UINT4 l = 0; l < nlikelihoods; l++) {
+      char name[64];
+      snprintf(name, sizeof(name), "likelihood:%s", likelihood_name(likelihoods[l]));
+      ADD_COMPONENT(name, bench_likelihood, likelihoods[l], 1);
+    }
+    ADD_COMPONENT("full", bench_likelihood, runState->likelihood, 0);
+  }
+#undef ADD_COMPONENT
+
+  for (UINT4 p = 0; p < Npoints; p++) {
+    bench_set_point(runState, p);
+    for (UINT4 c = 0; c < ncomp; c++) {
+      /* The likelihood alone is timed on templates that have already been
+       * generated, and so includes only projection and summation */
+      LALInferenceTemplateFunction old_templt = model->templt;
+      if (components[c].noop_template)
+        model->templt = LALInferenceTemplateNoop;
+      bench_component(&components[c], functions[c], runState, args[c], Niter);
+      model->templt = old_templt;
+    }
+  }
+
+  /* Throughput of the full likelihood on increasing numbers of threads */
+  UINT4 nscaling = 0;
+  INT4 scaling_threads[32];
+  REAL8 scaling_rate[32];
+  if (bench_L) {
+    for (INT4 n = 1; nscaling < 32; n *= 2) {
+      if (n > Nthreads) n = Nthreads;
+      const REAL8 start = bench_clock();
+      #pragma omp parallel for num_threads(n)
+      for (INT4 t = 0; t < n; t++) {
+        LALInferenceThreadState *th = &runState->threads[t];
+        for (UINT4 i = 0; i < Niter; i++)
+          runState->likelihood(th->currentParams, runState->data, th->model);
+      }
+      scaling_threads[nscaling] = n;
+      scaling_rate[nscaling] = n * Niter / (bench_clock() - start);
+      nscaling++;
+      if (n == Nthreads) break;
+    }
+  }
+
+  /* Write the report */
+  if ((ppt = LALInferenceGetProcParamVal(procParams, "--bench-output"))) {
+    fpout = fopen(ppt->value, "w");
+    if (!fpout) {
+      fprintf(stderr, "Unable to open %s for writing\n", ppt->value);
+      exit(1);
+    }
   }
-  
+  char host[256] = "";
+  gethostname(host, sizeof(host) - 1);
+  char date[64] = "";
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+  fprintf(fpout, "{\n  \"program\": \"lalinference_bench\",\n  \"lalinference_version\": ");
+  fprintf_json_string(fpout, lalInferenceVCSInfo.version);
+  fprintf(fpout, ",\n  \"vcs_id\": ");
+  fprintf_json_string(fpout, lalInferenceVCSInfo.vcsId);
+  fprintf(fpout, ",\n  \"host\": ");
+  fprintf_json_string(fpout, host);
+  fprintf(fpout, ",\n  \"date\": ");
+  fprintf_json_string(fpout, date);
+  fprintf(fpout, ",\n  \"config\": {\n    \"likelihood\": ");
+  fprintf_json_string(fpout, likelihood_name(runState->likelihood));
+  fprintf(fpout, ",\n    \"approximant\": ");
+  if (LALInferenceCheckVariable(model->params, "LAL_APPROXIMANT"))
+    fprintf_json_string(fpout, XLALSimInspiralGetStringFromApproximant(*(Approximant *) LALInferenceGetVariable(model->params, "LAL_APPROXIMANT")));
+  else
+    fprintf(fpout, "null");
+  fprintf(fpout, ",\n    \"roq\": %s,\n    \"relative_binning\": %s,\n    \"margdist\": %s,\n    \"spline_calibration\": %s,\n",
+          model->roq_flag ? "true" : "false", model->relbin_flag ? "true" : "false",
+          (LALInferenceCheckVariable(model->params, "MARGDIST") && LALInferenceGetUINT4Variable(model->params, "MARGDIST")) ? "true" : "false",
+          (LALInferenceCheckVariable(thread->currentParams, "spcal_active") && LALInferenceGetUINT4Variable(thread->currentParams, "spcal_active")) ? "true" : "false");
+  fprintf(fpout, "    \"ifos\": [");
+  for (LALInferenceIFOData *ifo = runState->data; ifo; ifo = ifo->next) {
+    fprintf_json_string(fpout, ifo->name);
+    if (ifo->next) fprintf(fpout, ", ");
+  }
+  fprintf(fpout, "],\n    \"deltaF\": %.6e,\n    \"freq_length\": %u,\n    \"niter\": %u,\n    \"npoints\": %u\n  },\n",
+          runState->data->freqData->deltaF, runState->data->freqData->data->length, Niter, Npoints);
+
+  fprintf(fpout, "  \"components\": [\n");
+  for (UINT4 c = 0; c < ncomp; c++) {
+    fprintf_component(fpout, &components[c]);
+    fprintf(fpout, "%s\n", c + 1 < ncomp ? "," : "");
+    XLALFree(components[c].times);
+  }
+  fprintf(fpout, "  ],\n  \"thread_scaling\": [\n");
+  for (UINT4 i = 0; i < nscaling; i++)
+    fprintf(fpout, "    {\"threads\": %d, \"calls_per_second\": %.6e, \"efficiency\": %.4f}%s\n",
+            scaling_threads[i], scaling_rate[i], scaling_rate[i] / (scaling_threads[i] * scaling_rate[0]),
+            i + 1 < nscaling ? "," : "");
+  fprintf(fpout, "  ]\n}\n");
+  if (fpout != stdout) fclose(fpout);
+
   return(0);
 }
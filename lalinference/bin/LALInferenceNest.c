@@ -124,8 +124,12 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one for each live point replaced per iteration */
+  INT4 nthreads=1;
+  if (LALInferenceGetProcParamVal(procParams,"--Nbatch"))
+    nthreads=atoi(LALInferenceGetProcParamVal(procParams,"--Nbatch")->value);
+  if (nthreads<1) nthreads=1;
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
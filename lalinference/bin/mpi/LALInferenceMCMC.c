@@ -94,12 +94,18 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     (--adapt-tau)       Adaptation decay power, results in adapt length of 10^tau (5)\n\
     (--no-adapt)        Do not adapt run\n\
     (--randomseed seed) Random seed of sampling distribution (random)\n\
+    (--differential-buffer-limit N) Number of points held in each chain's differential\n\
+                        evolution history, allocated up front (100000)\n\
+    (--de-cross-chain)  Draw differential evolution jumps from the histories of all\n\
+                        chains of the process, not only the chain's own\n\
     \n\
     ----------------------------------------------\n\
     --- Parallel Tempering Algorithm Parameters --\n\
     ----------------------------------------------\n\
     (--adapt-temps)     Adapt the spacing between temperatures for uniform swap acceptance\n\
     (--temp-skip N)     Number of steps between temperature swap proposals (100)\n\
+    (--swap-staleness N) Rounds of temperature swaps an MPI process may run ahead of its\n\
+                        neighbours before waiting on them; 0 keeps all processes in lock-step (4)\n\
     (--tempKill N)      Iteration number to stop temperature swapping (Niter)\n\
     (--ntemps N)         Number of temperature chains in ladder (as many as needed)\n\
     (--temp-min T)      Lowest temperature for parallel tempering (1.0)\n\
@@ -221,6 +227,16 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     if (ppt)
         Tskip = atoi(ppt->value);
 
+    /* Rounds of swaps a process may run ahead before waiting on its neighbours */
+    INT4 swap_staleness = 4;
+    ppt = LALInferenceGetProcParamVal(command_line, "--swap-staleness");
+    if (ppt)
+        swap_staleness = atoi(ppt->value);
+    if (swap_staleness < 0) {
+        fprintf(stderr, "ERROR: --swap-staleness must be non-negative.\n");
+        return XLAL_FAILURE;
+    }
+
     /* Counter for triggering PT swaps */
     INT4 nsteps_until_swap = Tskip;
 
@@ -253,11 +269,16 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
         tempMax = strtod(ppt->value, (char **)NULL);
 
     /* Limit the size of the differential evolution buffer */
-    INT4 de_buffer_limit = 1000000;
+    INT4 de_buffer_limit = 100000;
     ppt = LALInferenceGetProcParamVal(command_line, "--differential-buffer-limit");
     if (ppt)
         de_buffer_limit = atoi(ppt->value);
 
+    /* Let chains use each other's differential evolution histories */
+    INT4 de_cross_chain = 0;
+    if (LALInferenceGetProcParamVal(command_line, "--de-cross-chain"))
+        de_cross_chain = 1;
+
     /* Network SNR of trigger */
     REAL8 trigSNR = 0.0;
     ppt = LALInferenceGetProcParamVal(command_line, "--trigger-snr");
@@ -292,6 +313,7 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     LALInferenceAddINT4Variable(algorithm_params, "neff", neff, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "tskip", Tskip, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "nsteps_until_swap", nsteps_until_swap, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "swap_staleness", swap_staleness, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "mpirank", mpi_rank, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "mpisize", mpi_size, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "ntemps", ntemps, LALINFERENCE_PARAM_OUTPUT);
@@ -314,6 +336,7 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
 
     /* Add some settings settings to runstate proposal args so their copied to threads */
     LALInferenceAddINT4Variable(runState->proposalArgs, "de_skip", skip, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(runState->proposalArgs, "de_cross_chain", de_cross_chain, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(runState->proposalArgs, "output_snrs", outputSNRs, LALINFERENCE_PARAM_OUTPUT);
 
     /* Parse proposal args for runSTate and initialize the walkers on this MPI thread */
@@ -39,6 +39,9 @@
 #include <lal/GenerateInspiral.h>
 #include <lal/TimeDelay.h>
 #include <mpi.h>
+#if !defined(MPI_VERSION) || MPI_VERSION < 3
+#error "Parallel tempering requires the nonblocking collectives of MPI-3"
+#endif
 #include <lal/LALInference.h>
 #include "LALInferenceMCMCSampler.h"
 #include <lal/LALInferencePrior.h>
@@ -61,6 +64,9 @@
 #define CVS_DATE "$Date$"
 #define CVS_NAME_STRING "$Name$"
 
+/* Number of samples buffered in memory per chain before they are written */
+#define MCMC_OUTPUT_BUFFER_LENGTH 1024
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -68,67 +74,20 @@
 #endif
 
 static void
-thinDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
-    size_t i;
-    size_t newSize;
-
-    /* Delete all the even-index points. */
-    for (i = 0; i < thread->differentialPointsLength; i += 2) {
-        LALInferenceClearVariables(thread->differentialPoints[i]);
-        XLALFree(thread->differentialPoints[i]);
-        thread->differentialPoints[i] = NULL;
-    }
-
-    /* Copy the odd points into the first part of the array. */
-    for (i = 1; i < thread->differentialPointsLength; i += 2) {
-        thread->differentialPoints[i/2] = thread->differentialPoints[i];
-        thread->differentialPoints[i] = NULL;
-    }
-
-    newSize = thread->differentialPointsLength / 2;
-
-    /* Now shrink the buffer down. */
-    thread->differentialPoints = XLALRealloc(thread->differentialPoints, 2*newSize*sizeof(LALInferenceVariables *));
-    thread->differentialPointsSize = 2*newSize;
-    thread->differentialPointsLength = newSize;
-    thread->differentialPointsSkip *= 2;
-}
-
-static void
-accumulateDifferentialEvolutionSample(LALInferenceThreadState *thread, size_t buffer_limit) {
-    if (thread->differentialPointsSize == thread->differentialPointsLength) {
-        size_t newSize = thread->differentialPointsSize*2;
-
-        if (buffer_limit < newSize) {
-            /* Then thin, and record sample. */
-            thinDifferentialEvolutionPoints(thread);
-            return accumulateDifferentialEvolutionSample(thread, buffer_limit);
-        } else {
-            thread->differentialPoints = XLALRealloc(thread->differentialPoints, newSize*sizeof(LALInferenceVariables *));
-            thread->differentialPointsSize = newSize;
-        }
+accumulateDifferentialEvolutionSample(LALInferenceThreadState *thread) {
+    if (LALInferenceDEBufferAdd(thread->deBuffer, thread->currentParams) != XLAL_SUCCESS) {
+        fprintf(stderr, "Unable to add sample to differential evolution buffer of chain %s\n", thread->name);
+        MPI_Abort(MPI_COMM_WORLD, XLAL_EFUNC);
     }
 
-    thread->differentialPoints[thread->differentialPointsLength] = XLALCalloc(1, sizeof(LALInferenceVariables));
-    LALInferenceCopyVariables(thread->currentParams, thread->differentialPoints[thread->differentialPointsLength]);
-
-    thread->differentialPointsLength += 1;
+    /* The buffer doubles its thinning interval when it fills up */
+    thread->differentialPointsSkip = thread->deBuffer->skip;
 }
 
 static void
 resetDifferentialEvolutionBuffer(LALInferenceThreadState *thread) {
-    size_t i;
-
-    for (i = 0; i < thread->differentialPointsLength; i++) {
-        LALInferenceClearVariables(thread->differentialPoints[i]);
-        XLALFree(thread->differentialPoints[i]);
-        thread->differentialPoints[i] = NULL;
-    }
-
-    thread->differentialPoints = XLALRealloc(thread->differentialPoints, sizeof(LALInferenceVariables *));
-    thread->differentialPointsLength = 0;
-    thread->differentialPointsSize = 1;
     thread->differentialPointsSkip = LALInferenceGetINT4Variable(thread->proposalArgs, "de_skip");
+    LALInferenceDEBufferClear(thread->deBuffer, thread->differentialPointsSkip);
 }
 
 /* This is checked by the main loop to determine when to checkpoint */
@@ -153,6 +112,8 @@ static void catch_interrupt(UNUSED int sig, UNUSED siginfo_t *siginfo,UNUSED voi
 		__master_exitFlag=1;
 }
 
+static void pt_sync_control(LALInferenceRunState *runState, const INT4 *control_in, INT4 *control_out);
+
 static struct itimerval checkpoint_timer;
 
 /**
@@ -200,6 +161,7 @@ static void install_resume_handler(int checkpoint_exit)
 void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 t=0; //indexes for for() loops
     INT4 runComplete = 0;
+    INT4 neffReached = 0;
     REAL8 timestamp_epoch=0.0;
     INT4 MPIrank, MPIsize;
     LALStatus status;
@@ -247,9 +209,6 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 *kde_update_interval = XLALCalloc(n_local_threads, sizeof(INT4));
     INT4 *last_kde_update = XLALCalloc(n_local_threads, sizeof(INT4)); // effective sample size at last KDE update
 
-    INT4 diffEvo = 1;
-    if (runState->threads[0].differentialPoints == NULL)
-        diffEvo = 0;
 
     /* Adaptation settings */
     INT4 no_adapt = LALInferenceGetINT4Variable(runState->algorithmParams, "no_adapt");
@@ -328,9 +287,20 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 	{
         record_likelihoods(&runState->threads[t]);
 		LALInferenceSortVariablesByName(runState->threads[t].currentParams);
+
+        /* The DE history is allocated once, so other chains can read it while it grows */
+        thread = &runState->threads[t];
+        thread->deBuffer = LALInferenceCreateDEBuffer(thread->currentParams, de_buffer_limit, thread->differentialPointsSkip);
+        if (thread->deBuffer == NULL) {
+            fprintf(stderr, "Unable to allocate differential evolution buffer of %d points\n", de_buffer_limit);
+            MPI_Abort(MPI_COMM_WORLD, XLAL_ENOMEM);
+        }
     }
     LALInferenceNameOutputs(runState);
     LALInferenceResumeMCMC(runState);
+    LALInferenceOpenMCMCOutput(runState);
+    LALInferenceH5ChainOutput *chain_output = *(LALInferenceH5ChainOutput **)
+        LALInferenceGetVariable(runState->algorithmParams, "chain_output");
     
     if (benchmark) {
         struct timeval start_tv;
@@ -412,8 +382,13 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
                         last_kde_update[t] = thread->effective_sample_size;
                     }
 
-                    if (diffEvo && (thread->step % thread->differentialPointsSkip == 0))
-                        accumulateDifferentialEvolutionSample(thread, de_buffer_limit);
+                    if (thread->step % thread->differentialPointsSkip == 0) {
+                        accumulateDifferentialEvolutionSample(thread);
+
+                        /* Grow the clustered-KDE proposal between updates */
+                        if (LALInferenceGetProcParamVal(runState->commandLine, "--proposal-kde"))
+                            LALInferenceClusteredKDEProposalAddSample(thread);
+                    }
                     /*
                     if (benchmark) {
                         gettimeofday(&tv, NULL);
@@ -422,7 +397,10 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
                     //LALInferenceSaveSample(thread, resumeoutputs[t]);
                     //LALInferencePrintMCMCSample(thread, runState->data, thread->step, timestamp, threadoutputs[t]);
-                    LALInferenceLogSampleToArray(thread->algorithmParams, thread->currentParams);
+                    if (LALInferenceH5ChainOutputAppend(chain_output, t, thread->name, thread->currentParams) != XLAL_SUCCESS) {
+                        fprintf(stderr, "Process %i failed to write samples to %s\n", MPIrank, runState->outFileName);
+                        MPI_Abort(MPI_COMM_WORLD, 1);
+                    }
 
                     if (adaptVerbose && !no_adapt) {
                         sprintf(outfilename, "PTMCMC.statistics.%u.%2.2d",
@@ -455,57 +433,6 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             }
         }
 
-		/* Synchronise interruptions */
-		if(MPIrank==0){
-                    local_saveStateFlag=__master_saveStateFlag;
-                    local_exitFlag=__master_exitFlag;
-		}
-		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
-        INT4 saveattempts=0;
-        INT4 retrydelay=5; /* 5 seconds before initial retry */
-        INT4 retcode=XLAL_SUCCESS;
-        /* The following checkpoint code is wrapped in do {} while loops
-         * to allow 10 retries, in case of filesystem congestion
-         */
-		if(local_saveStateFlag!=0)
-		{
-            do
-            {
-                XLAL_TRY(LALInferenceCheckpointMCMC(runState), retcode);
-                if(retcode!=XLAL_SUCCESS) 
-                {
-                    saveattempts+=1;
-                    fprintf(stderr,"Process %i failed to write checkpoint file %s \
-                    at attempt %i, waiting to retry\n",MPIrank, runState->resumeOutFileName, saveattempts);
-                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
-                }
-            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
-            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
-            saveattempts=0;
-            do
-            {
-                XLAL_TRY(LALInferenceWriteMCMCSamples(runState), retcode);
-                if(retcode!=XLAL_SUCCESS) 
-                {
-                    saveattempts+=1;
-                    fprintf(stderr,"Process %i failed to write samples file %s \
-                    at attempt %i, waiting to retry\n",MPIrank, runState->outFileName, saveattempts);
-                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
-                }
-            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
-            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
-            /* Wait for all processes to save */
-			MPI_Barrier(MPI_COMM_WORLD);
-			__master_saveStateFlag=0;
-            local_saveStateFlag=0;
-		}
-		if(local_exitFlag) {
-				/* Wait for all processes to be ready to exit */
-				MPI_Barrier(MPI_COMM_WORLD);
-				exit(CondorExitCode);
-		}
-
         /* Open swap file if going verbose */
         verbose_file = NULL;
         if (tempVerbose) {
@@ -523,9 +450,8 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         if (tempVerbose)
             fclose(verbose_file);
 
-        /* Check if run should end */
-        if (runState->threads[0].step > Niter)
-            runComplete=1;
+        /* Check if run should end.  Every rank reaches this step in the same round. */
+        INT4 reachedNiter = (runState->threads[0].step > Niter);
 
         /* Have the cold chain decide when to compute ACLs, and calculate for all chains.  This is done
          * in a similar way to the write interval: ten times each sampling decade.
@@ -553,18 +479,67 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
                 if (MPIrank == 0 && t == 0 && thread->effective_sample_size > Neff) {
                     fprintf(stdout,"Thread %i has %i effective samples. Stopping...\n", MPIrank, thread->effective_sample_size);
-                    runComplete = 1;          // Sampling is done!
+                    neffReached = 1;          // Sampling is done!
                 }
             }
 
             step_last_acl_check = runState->threads[0].step;
         }
 
-        /* Broadcast the root's decision on run completion */
-        MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        /* Share the root's decisions on interruption and completion.  The
+         * broadcast is nonblocking, and all ranks act on the decision made
+         * swap_staleness rounds ago so they stop or checkpoint in step. */
+        INT4 control[3] = {0, 0, 0}; /* save state, exit, run complete */
+        if (MPIrank == 0) {
+            control[0] = __master_saveStateFlag;
+            control[1] = __master_exitFlag;
+            control[2] = neffReached;
+            __master_saveStateFlag = 0;
+        }
+        pt_sync_control(runState, control, control);
+        local_saveStateFlag = control[0];
+        local_exitFlag = control[1];
+        runComplete = control[2] || reachedNiter;
+
+        if (local_saveStateFlag || local_exitFlag)
+            LALInferenceFlushPTswap();
+
+        INT4 saveattempts=0;
+        INT4 retrydelay=5; /* 5 seconds before initial retry */
+        INT4 retcode=XLAL_SUCCESS;
+		if(local_saveStateFlag!=0)
+		{
+            do
+            {
+                XLAL_TRY(LALInferenceCheckpointMCMC(runState), retcode);
+                if(retcode!=XLAL_SUCCESS) 
+                {
+                    saveattempts+=1;
+                    fprintf(stderr,"Process %i failed to write checkpoint file %s \
+                    at attempt %i, waiting to retry\n",MPIrank, runState->resumeOutFileName, saveattempts);
+                    sleep(retrydelay*saveattempts); /* In case of IO failure wait progressively longer */
+                }
+            } while (retcode!=XLAL_SUCCESS && saveattempts<10);
+            if(retcode!=XLAL_SUCCESS) {fprintf(stderr,"Process %i failed to checkpoint\n", MPIrank);}
+            /* Wait for all processes to save */
+			MPI_Barrier(MPI_COMM_WORLD);
+            local_saveStateFlag=0;
+		}
+		if(local_exitFlag) {
+				/* Wait for all processes to be ready to exit */
+				MPI_Barrier(MPI_COMM_WORLD);
+				exit(CondorExitCode);
+		}
+
     }// while (!runComplete)
+    LALInferenceShutdownLadder();
     LALInferenceWriteMCMCSamples(runState);
     MPI_Barrier(MPI_COMM_WORLD);
+
+    for (t = 0; t < n_local_threads; t++) {
+        LALInferenceDestroyDEBuffer(runState->threads[t].deBuffer);
+        runState->threads[t].deBuffer = NULL;
+    }
 }
 
 void record_likelihoods(LALInferenceThreadState *thread) {
@@ -672,291 +647,544 @@ void mcmc_step(LALInferenceRunState *runState, LALInferenceThreadState *thread)
 
 
 //-----------------------------------------
-// Temperature adaptation à la arXiv:1501.05823
+// Asynchronous parallel tempering
 //-----------------------------------------
-void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
-    INT4 MPIrank, MPIsize;
-    INT4 n_local_threads, ntemps;
-    INT4 t;
-    INT4 *local_nsteps, *nsteps;
-    REAL8 *local_temperatures, *temperatures;
-    REAL8 *local_acceptance_ratios, *acceptance_ratios;
+/*
+ * Swaps between chains on the same rank are made in place.  Swaps across a
+ * rank boundary, between the hottest chain of rank r and the coldest chain
+ * of rank r+1, use a nonblocking offer/reply exchange: the cold side posts
+ * its state and carries on stepping, and the hot side decides on the swap
+ * when it next looks for messages and replies with its own state.
+ *
+ * Staleness is bounded by swap_staleness rounds (one round being temp_skip
+ * steps): the cold side waits for an outstanding reply once it is that many
+ * rounds past its offer, and the ladder gathers and control broadcasts,
+ * which every rank posts once per round, are completed that many rounds
+ * after being posted.  With swap_staleness = 0 every exchange completes in
+ * the round it was started.  Any rank blocked in one of these waits keeps
+ * answering offers from its colder neighbour, so the ranks cannot deadlock.
+ */
 
-    INT4 adaptLength = LALInferenceGetINT4Variable(runState->algorithmParams, "adaptLength");
-    INT4 temp_skip = LALInferenceGetINT4Variable(runState->algorithmParams, "tskip");
+/* Offer: kind, round, nPar, temperature, likelihood, prior, parameters */
+#define PT_OFFER_HEADER 6
+/* Reply: accepted, likelihood, prior, parameters */
+#define PT_REPLY_HEADER 3
+#define PT_OFFER_SWAP 1.0
+#define PT_OFFER_FLUSH 0.0
+/* Control word broadcast by the root: save state, exit, run complete */
+#define PT_CONTROL_LENGTH 3
+
+typedef struct tagPTAsyncState {
+    LALInferenceRunState *runState;
+    INT4 rank, size, n_local_threads, ntemps, nPar;
+    INT4 staleness;
+    INT4 nslots;
+    INT4 round;             /* Swap rounds started by this rank */
+    FILE *swapfile;         /* Swap log while inside LALInferencePTswap() */
+
+    /* Cold side of the boundary with rank+1 */
+    INT4 offer_pending;
+    INT4 offer_round;
+    REAL8 *offer_out, *reply_in;
+    MPI_Request offer_send_req, reply_recv_req;
+
+    /* Hot side of the boundary with rank-1 */
+    INT4 listening;
+    INT4 flushed;
+    REAL8 *offer_in, *reply_out;
+    MPI_Request offer_recv_req, reply_send_req;
+
+    /* Ladder adaptation: every rank holds the full ladder */
+    REAL8 *ladder;
+    INT4 ladder_posted;
+    REAL8 *ladder_send, *ladder_recv;
+    INT4 *ladder_step;
+    MPI_Request *ladder_req;
+
+    /* Control broadcasts */
+    INT4 control_posted;
+    INT4 *control;
+    MPI_Request *control_req;
+} PTAsyncState;
+
+static PTAsyncState *pt_async = NULL;
+
+static void pt_apply_reply(void);
+
+static void pt_async_init(LALInferenceRunState *runState) {
+    INT4 i;
+
+    if (pt_async)
+        return;
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
-    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+    pt_async = XLALCalloc(1, sizeof(PTAsyncState));
+    pt_async->runState = runState;
+    MPI_Comm_rank(MPI_COMM_WORLD, &pt_async->rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &pt_async->size);
+    pt_async->n_local_threads = runState->nthreads;
+    pt_async->ntemps = pt_async->size * runState->nthreads;
+    pt_async->nPar = LALInferenceGetVariableDimensionNonFixed(runState->threads[0].currentParams);
+
+    pt_async->staleness = 0;
+    if (LALInferenceCheckVariable(runState->algorithmParams, "swap_staleness"))
+        pt_async->staleness = LALInferenceGetINT4Variable(runState->algorithmParams, "swap_staleness");
+    pt_async->nslots = pt_async->staleness + 1;
+
+    pt_async->offer_out = XLALCalloc(PT_OFFER_HEADER + pt_async->nPar, sizeof(REAL8));
+    pt_async->offer_in = XLALCalloc(PT_OFFER_HEADER + pt_async->nPar, sizeof(REAL8));
+    pt_async->reply_out = XLALCalloc(PT_REPLY_HEADER + pt_async->nPar, sizeof(REAL8));
+    pt_async->reply_in = XLALCalloc(PT_REPLY_HEADER + pt_async->nPar, sizeof(REAL8));
+    pt_async->offer_send_req = pt_async->reply_recv_req = MPI_REQUEST_NULL;
+    pt_async->offer_recv_req = pt_async->reply_send_req = MPI_REQUEST_NULL;
+
+    pt_async->ladder_send = XLALCalloc(pt_async->nslots * pt_async->n_local_threads, sizeof(REAL8));
+    pt_async->ladder_recv = XLALCalloc(pt_async->nslots * pt_async->ntemps, sizeof(REAL8));
+    pt_async->ladder_step = XLALCalloc(pt_async->nslots, sizeof(INT4));
+    pt_async->ladder_req = XLALCalloc(pt_async->nslots, sizeof(MPI_Request));
+    pt_async->control = XLALCalloc(pt_async->nslots * PT_CONTROL_LENGTH, sizeof(INT4));
+    pt_async->control_req = XLALCalloc(pt_async->nslots, sizeof(MPI_Request));
+    for (i = 0; i < pt_async->nslots; i++)
+        pt_async->ladder_req[i] = pt_async->control_req[i] = MPI_REQUEST_NULL;
+}
 
-    n_local_threads = runState->nthreads;
-    ntemps = MPIsize*n_local_threads;
+/* Start listening for an offer from the colder neighbour */
+static void pt_listen(void) {
+    if (pt_async->rank == 0 || pt_async->listening)
+        return;
 
-    /* Return if running with only a single temperature */
-    if (ntemps == 1)
+    MPI_Irecv(pt_async->offer_in, PT_OFFER_HEADER + pt_async->nPar, MPI_DOUBLE,
+              pt_async->rank-1, PT_SWAP_OFFER_COM, MPI_COMM_WORLD, &pt_async->offer_recv_req);
+    pt_async->listening = 1;
+}
+
+/* Decide on a received offer with the coldest local chain and reply */
+static void pt_answer_offer(void) {
+    LALInferenceRunState *runState = pt_async->runState;
+    LALInferenceThreadState *hot_thread = &runState->threads[0];
+    REAL8 *offer = pt_async->offer_in;
+    REAL8 *reply = pt_async->reply_out;
+    REAL8 logThreadSwap;
+    INT4 swapAccepted;
+
+    pt_async->listening = 0;
+
+    if (offer[0] == PT_OFFER_FLUSH) {
+        pt_async->flushed = 1;
         return;
+    }
 
-    local_nsteps = XLALCalloc(n_local_threads, sizeof(INT4));
-    local_temperatures = XLALCalloc(n_local_threads, sizeof(REAL8));
-    local_acceptance_ratios = XLALCalloc(n_local_threads, sizeof(REAL8));
-    for (t=0; t<n_local_threads; t++) {
-        local_nsteps[t] = runState->threads[t].step;
-        local_temperatures[t] = runState->threads[t].temperature;
+    if ((INT4)offer[2] != pt_async->nPar) {
+        XLALPrintError("Swap offer from rank %d has %d parameters, expected %d\n",
+                       pt_async->rank-1, (INT4)offer[2], pt_async->nPar);
+        XLAL_ERROR_VOID(XLAL_EBADLEN);
+    }
 
-        REAL8 acc_ratio = 0.0;
-        for (INT4 i=0; i<runState->threads[t].temp_swap_window; i++)
-            acc_ratio += (REAL8)runState->threads[t].temp_swap_accepts[i] / runState->threads[t].temp_swap_window;
-        local_acceptance_ratios[t] = acc_ratio;
+    /* The reply buffer may still be in use by the previous reply */
+    MPI_Wait(&pt_async->reply_send_req, MPI_STATUS_IGNORE);
+
+    logThreadSwap = 1.0/offer[3] - 1.0/hot_thread->temperature;
+    logThreadSwap *= hot_thread->currentLikelihood - offer[4];
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+
+    if (pt_async->swapfile != NULL) {
+        fprintf(pt_async->swapfile, "%d\t%f\t%f\t%f\t%f\t%f\t%i\t%d\n",
+                hot_thread->step, offer[3], hot_thread->temperature,
+                logThreadSwap, offer[4], hot_thread->currentLikelihood,
+                swapAccepted, pt_async->round - (INT4)offer[1]);
+        fflush(pt_async->swapfile);
     }
 
-    nsteps = XLALCalloc(ntemps, sizeof(INT4));
-    temperatures = XLALCalloc(ntemps, sizeof(REAL8));
-    acceptance_ratios = XLALCalloc(ntemps, sizeof(REAL8));
+    reply[0] = swapAccepted;
+    if (swapAccepted) {
+        reply[1] = hot_thread->currentLikelihood;
+        reply[2] = hot_thread->currentPrior;
+        LALInferenceCopyVariablesToArray(hot_thread->currentParams, &reply[PT_REPLY_HEADER]);
 
-    MPI_Gather(local_nsteps, n_local_threads, MPI_INT,
-               nsteps, n_local_threads, MPI_INT,
-               0, MPI_COMM_WORLD);
+        hot_thread->currentLikelihood = offer[4];
+        hot_thread->currentPrior = offer[5];
+        LALInferenceCopyArrayToVariables(&offer[PT_OFFER_HEADER], hot_thread->currentParams);
+    }
 
-    MPI_Gather(local_temperatures, n_local_threads, MPI_DOUBLE,
-               temperatures, n_local_threads, MPI_DOUBLE,
-               0, MPI_COMM_WORLD);
+    MPI_Isend(reply, swapAccepted ? PT_REPLY_HEADER + pt_async->nPar : 1, MPI_DOUBLE,
+              pt_async->rank-1, PT_SWAP_REPLY_COM, MPI_COMM_WORLD, &pt_async->reply_send_req);
 
-    MPI_Gather(local_acceptance_ratios, n_local_threads, MPI_DOUBLE,
-               acceptance_ratios, n_local_threads, MPI_DOUBLE,
-               0, MPI_COMM_WORLD);
+    if (!pt_async->flushed)
+        pt_listen();
+}
 
-    if (MPIrank == 0) {
-        REAL8 delta = 0;
-        for (t=1; t < ntemps-1; t++) {
-            REAL8 steps = adaptLength + nsteps[t-1];
+/*
+ * Whether offers from the colder neighbour can be answered now.  With one
+ * chain per rank that chain is also the one offered to the hotter neighbour,
+ * and it may only take part in one exchange at a time.
+ */
+static INT4 pt_can_answer(void) {
+    return pt_async->listening && !(pt_async->n_local_threads == 1 && pt_async->offer_pending);
+}
+
+/*
+ * Wait for a request to complete, meanwhile answering swap offers and
+ * collecting the reply to our own offer.
+ */
+static void pt_wait(MPI_Request *req) {
+    while (*req != MPI_REQUEST_NULL) {
+        MPI_Request reqs[3];
+        int idx;
+
+        reqs[0] = *req;
+        reqs[1] = (pt_async->offer_pending && req != &pt_async->reply_recv_req) ? pt_async->reply_recv_req : MPI_REQUEST_NULL;
+        reqs[2] = pt_can_answer() ? pt_async->offer_recv_req : MPI_REQUEST_NULL;
+        MPI_Waitany(3, reqs, &idx, MPI_STATUS_IGNORE);
+
+        if (idx == 0) {
+            *req = MPI_REQUEST_NULL;
+        } else if (idx == 1) {
+            pt_async->reply_recv_req = MPI_REQUEST_NULL;
+            pt_apply_reply();
+        } else if (idx == 2) {
+            pt_async->offer_recv_req = MPI_REQUEST_NULL;
+            pt_answer_offer();
+        }
+    }
+}
+
+/* Answer any offers that have already arrived */
+static void pt_poll_offers(void) {
+    int flag = 1;
+
+    pt_listen();
+    while (pt_can_answer() && flag) {
+        MPI_Test(&pt_async->offer_recv_req, &flag, MPI_STATUS_IGNORE);
+        if (flag)
+            pt_answer_offer();
+    }
+}
+
+/* Offer the hottest local chain to the hotter neighbour */
+static void pt_send_offer(void) {
+    LALInferenceThreadState *cold_thread = &pt_async->runState->threads[pt_async->n_local_threads-1];
+    REAL8 *offer = pt_async->offer_out;
+
+    /* The previous offer has been answered, so its send is complete */
+    MPI_Wait(&pt_async->offer_send_req, MPI_STATUS_IGNORE);
+
+    offer[0] = PT_OFFER_SWAP;
+    offer[1] = pt_async->round;
+    offer[2] = pt_async->nPar;
+    offer[3] = cold_thread->temperature;
+    offer[4] = cold_thread->currentLikelihood;
+    offer[5] = cold_thread->currentPrior;
+    LALInferenceCopyVariablesToArray(cold_thread->currentParams, &offer[PT_OFFER_HEADER]);
+
+    MPI_Irecv(pt_async->reply_in, PT_REPLY_HEADER + pt_async->nPar, MPI_DOUBLE,
+              pt_async->rank+1, PT_SWAP_REPLY_COM, MPI_COMM_WORLD, &pt_async->reply_recv_req);
+    MPI_Isend(offer, PT_OFFER_HEADER + pt_async->nPar, MPI_DOUBLE,
+              pt_async->rank+1, PT_SWAP_OFFER_COM, MPI_COMM_WORLD, &pt_async->offer_send_req);
+
+    pt_async->offer_pending = 1;
+    pt_async->offer_round = pt_async->round;
+}
 
-            // Modulate temperature adjustments with a hyperbolic decay.
-            REAL8 decay = adaptLength / (steps + adaptLength);
-            REAL8 kappa = decay / (10*temp_skip);
+/* Apply the reply to our last offer to the hottest local chain */
+static void pt_apply_reply(void) {
+    LALInferenceThreadState *cold_thread = &pt_async->runState->threads[pt_async->n_local_threads-1];
+    REAL8 *reply = pt_async->reply_in;
+    INT4 swapAccepted = (INT4)reply[0];
 
-            // Construct temperature adjustments.
-            REAL8 dS = kappa * (acceptance_ratios[t-1] - acceptance_ratios[t]);
+    pt_async->offer_pending = 0;
 
-            // Compute new ladder (hottest and coldest chains don't move).
-            REAL8 deltaT = (temperatures[t] - temperatures[t-1]) * exp(dS);
-            delta += deltaT;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
 
-            temperatures[t] =  delta + temperatures[0];
+    if (swapAccepted) {
+        cold_thread->currentLikelihood = reply[1];
+        cold_thread->currentPrior = reply[2];
+        LALInferenceCopyArrayToVariables(&reply[PT_REPLY_HEADER], cold_thread->currentParams);
+    }
+}
+
+/* Check on the outstanding offer, waiting for the reply if it is too old */
+static void pt_check_reply(INT4 force) {
+    int flag = 0;
+
+    if (!pt_async->offer_pending)
+        return;
+
+    MPI_Test(&pt_async->reply_recv_req, &flag, MPI_STATUS_IGNORE);
+    if (!flag && (force || pt_async->round - pt_async->offer_round >= pt_async->staleness)) {
+        pt_wait(&pt_async->reply_recv_req);
+        flag = 1;
+    }
+
+    if (flag)
+        pt_apply_reply();
+}
+
+/* Swap two chains held by this rank */
+static void pt_local_swap(LALInferenceRunState *runState, INT4 cold_ind, INT4 hot_ind, FILE *swapfile) {
+    LALInferenceThreadState *cold_thread = &runState->threads[cold_ind % runState->nthreads];
+    LALInferenceThreadState *hot_thread = &runState->threads[hot_ind % runState->nthreads];
+    LALInferenceVariables *temp_params;
+    REAL8 logThreadSwap, temp_prior, temp_like;
+    INT4 swapAccepted;
+
+    /* Determine if swap is accepted */
+    logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
+    logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
+
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+    /* Print to file if verbose is chosen */
+    if (swapfile != NULL) {
+        REAL8 acc_frac = 0.0;
+        for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+            acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+        fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                cold_thread->step, cold_ind, cold_thread->temperature,
+                hot_ind, hot_thread->temperature,
+                logThreadSwap, cold_thread->currentLikelihood,
+                hot_thread->currentLikelihood, swapAccepted, acc_frac);
+    }
+
+    if (swapAccepted) {
+        temp_params = hot_thread->currentParams;
+        temp_prior = hot_thread->currentPrior;
+        temp_like = hot_thread->currentLikelihood;
+
+        hot_thread->currentParams = cold_thread->currentParams;
+        hot_thread->currentPrior = cold_thread->currentPrior;
+        hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+
+        cold_thread->currentParams = temp_params;
+        cold_thread->currentPrior = temp_prior;
+        cold_thread->currentLikelihood = temp_like;
+    }
+}
+
+/* Complete any swap across rank boundaries that is in flight */
+void LALInferenceFlushPTswap(void) {
+    if (!pt_async)
+        return;
+
+    /* Cold side: collect the last reply, then tell the neighbour we are done */
+    if (pt_async->rank < pt_async->size-1) {
+        pt_check_reply(1);
+        MPI_Wait(&pt_async->offer_send_req, MPI_STATUS_IGNORE);
+        pt_async->offer_out[0] = PT_OFFER_FLUSH;
+        MPI_Isend(pt_async->offer_out, PT_OFFER_HEADER + pt_async->nPar, MPI_DOUBLE,
+                  pt_async->rank+1, PT_SWAP_OFFER_COM, MPI_COMM_WORLD, &pt_async->offer_send_req);
+        pt_wait(&pt_async->offer_send_req);
+    }
+
+    /* Hot side: answer offers until the neighbour says it is done */
+    if (pt_async->rank > 0) {
+        pt_listen();
+        while (!pt_async->flushed) {
+            MPI_Wait(&pt_async->offer_recv_req, MPI_STATUS_IGNORE);
+            pt_answer_offer();
         }
+        MPI_Wait(&pt_async->reply_send_req, MPI_STATUS_IGNORE);
+        pt_async->flushed = 0;
     }
+}
 
-    MPI_Scatter(temperatures, n_local_threads, MPI_DOUBLE,
-                local_temperatures, n_local_threads, MPI_DOUBLE,
-                0, MPI_COMM_WORLD);
+/* Complete the outstanding ladder gathers and control broadcasts, and free the exchange state */
+void LALInferenceShutdownLadder(void) {
+    INT4 i;
 
-    for (t=0; t<n_local_threads; t++)
-        runState->threads[t].temperature = local_temperatures[t];
+    if (!pt_async)
+        return;
 
-    XLALFree(nsteps);
-    XLALFree(temperatures);
-    XLALFree(acceptance_ratios);
+    LALInferenceFlushPTswap();
+    for (i = 0; i < pt_async->nslots; i++) {
+        MPI_Wait(&pt_async->ladder_req[i], MPI_STATUS_IGNORE);
+        MPI_Wait(&pt_async->control_req[i], MPI_STATUS_IGNORE);
+    }
 
-    XLALFree(local_nsteps);
-    XLALFree(local_temperatures);
-    XLALFree(local_acceptance_ratios);
+    XLALFree(pt_async->offer_out);
+    XLALFree(pt_async->offer_in);
+    XLALFree(pt_async->reply_out);
+    XLALFree(pt_async->reply_in);
+    XLALFree(pt_async->ladder);
+    XLALFree(pt_async->ladder_send);
+    XLALFree(pt_async->ladder_recv);
+    XLALFree(pt_async->ladder_step);
+    XLALFree(pt_async->ladder_req);
+    XLALFree(pt_async->control);
+    XLALFree(pt_async->control_req);
+    XLALFree(pt_async);
+    pt_async = NULL;
+}
 
-    return;
+/*
+ * Post this round's control broadcast from the root and return, in
+ * control_out, the control word posted swap_staleness rounds ago (zeros
+ * until then).  Every rank acts on the same word in the same round.
+ */
+static void pt_sync_control(LALInferenceRunState *runState, const INT4 *control_in, INT4 *control_out) {
+    INT4 i, slot;
+
+    pt_async_init(runState);
+
+    slot = pt_async->control_posted % pt_async->nslots;
+    for (i = 0; i < PT_CONTROL_LENGTH; i++)
+        pt_async->control[slot*PT_CONTROL_LENGTH + i] = control_in[i];
+    MPI_Ibcast(&pt_async->control[slot*PT_CONTROL_LENGTH], PT_CONTROL_LENGTH, MPI_INT,
+               0, MPI_COMM_WORLD, &pt_async->control_req[slot]);
+    pt_async->control_posted++;
+
+    for (i = 0; i < PT_CONTROL_LENGTH; i++)
+        control_out[i] = 0;
+
+    if (pt_async->control_posted > pt_async->staleness) {
+        slot = (pt_async->control_posted - 1 - pt_async->staleness) % pt_async->nslots;
+        pt_wait(&pt_async->control_req[slot]);
+        for (i = 0; i < PT_CONTROL_LENGTH; i++)
+            control_out[i] = pt_async->control[slot*PT_CONTROL_LENGTH + i];
+    }
 }
 
 //-----------------------------------------
-// Swap routines:
+// Temperature adaptation à la arXiv:1501.05823
 //-----------------------------------------
-void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
-    INT4 MPIrank, MPIsize;
-    MPI_Status MPIstatus;
-    INT4 nPar, adjNPar, n_local_threads, ntemps;
-    INT4 low;
-    INT4 ind, cold_ind, hot_ind;
-    INT4 cold_rank, hot_rank;
-    INT4 swapAccepted;
-    INT4 *cold_inds;
-    REAL8 adjCurrentLikelihood, adjCurrentPrior;
-    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp;
-    LALInferenceThreadState *cold_thread = &runState->threads[0];
-    LALInferenceThreadState *hot_thread;
-    LALInferenceVariables *temp_params;
+/*
+ * Each round every rank posts its swap acceptance ratios in a nonblocking
+ * all-gather.  The gather posted swap_staleness rounds earlier is then
+ * completed and every rank applies the same update to its own copy of the
+ * full ladder, so no root or scatter is needed and the copies stay identical.
+ */
+void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
+    INT4 n_local_threads, ntemps;
+    INT4 t, slot;
+    REAL8 *acceptance_ratios;
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
-    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+    INT4 adaptLength = LALInferenceGetINT4Variable(runState->algorithmParams, "adaptLength");
+    INT4 temp_skip = LALInferenceGetINT4Variable(runState->algorithmParams, "tskip");
 
-    n_local_threads = runState->nthreads;
-    ntemps = MPIsize*n_local_threads;
+    pt_async_init(runState);
+    n_local_threads = pt_async->n_local_threads;
+    ntemps = pt_async->ntemps;
 
     /* Return if running with only a single temperature */
     if (ntemps == 1)
         return;
 
-    cold_inds = XLALCalloc(ntemps-1, sizeof(INT4));
-
-    /* Have the root process choose a random order of ladder swaps and share it */
-    if (MPIrank == 0) {
-        for (low = 0; low < ntemps-1; low++)
-            cold_inds[low] = low;
+    /* Collect the starting ladder on the first call */
+    if (!pt_async->ladder) {
+        MPI_Request req;
+        REAL8 *local_temperatures = XLALCalloc(n_local_threads, sizeof(REAL8));
+        for (t=0; t<n_local_threads; t++)
+            local_temperatures[t] = runState->threads[t].temperature;
+        pt_async->ladder = XLALCalloc(ntemps, sizeof(REAL8));
+        MPI_Iallgather(local_temperatures, n_local_threads, MPI_DOUBLE,
+                       pt_async->ladder, n_local_threads, MPI_DOUBLE,
+                       MPI_COMM_WORLD, &req);
+        pt_wait(&req);
+        XLALFree(local_temperatures);
+    }
 
-        gsl_ran_shuffle(runState->GSLrandom, cold_inds, ntemps-1, sizeof(INT4));
+    /* Post this round's acceptance ratios */
+    slot = pt_async->ladder_posted % pt_async->nslots;
+    for (t=0; t<n_local_threads; t++) {
+        REAL8 acc_ratio = 0.0;
+        for (INT4 i=0; i<runState->threads[t].temp_swap_window; i++)
+            acc_ratio += (REAL8)runState->threads[t].temp_swap_accepts[i] / runState->threads[t].temp_swap_window;
+        pt_async->ladder_send[slot*n_local_threads + t] = acc_ratio;
     }
+    pt_async->ladder_step[slot] = runState->threads[0].step;
+    MPI_Iallgather(&pt_async->ladder_send[slot*n_local_threads], n_local_threads, MPI_DOUBLE,
+                   &pt_async->ladder_recv[slot*ntemps], n_local_threads, MPI_DOUBLE,
+                   MPI_COMM_WORLD, &pt_async->ladder_req[slot]);
+    pt_async->ladder_posted++;
 
-    MPI_Bcast(cold_inds, ntemps-1, MPI_INT, 0, MPI_COMM_WORLD);
-
-    for (ind=0; ind < ntemps-1; ind++) {
-        cold_ind = cold_inds[ind];
-        hot_ind = cold_ind+1;
-
-        /* Check if cold chain is handled by this thread */
-        cold_rank = cold_ind/n_local_threads;
-        hot_rank = hot_ind/n_local_threads;
-
-        if (cold_rank == hot_rank) {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
-
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    REAL8 acc_frac = 0.0;
-                    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
-                        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
-                    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
-                    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
-                            cold_thread->step, cold_ind, cold_thread->temperature,
-                            hot_ind, hot_thread->temperature,
-                            logThreadSwap, cold_thread->currentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted, acc_frac);
-                }
+    if (pt_async->ladder_posted <= pt_async->staleness)
+        return;
 
-                if (swapAccepted) {
-                    temp_params = hot_thread->currentParams;
-                    temp_prior = hot_thread->currentPrior;
-                    temp_like = hot_thread->currentLikelihood;
+    /* Apply the update from swap_staleness rounds ago */
+    slot = (pt_async->ladder_posted - 1 - pt_async->staleness) % pt_async->nslots;
+    pt_wait(&pt_async->ladder_req[slot]);
+    acceptance_ratios = &pt_async->ladder_recv[slot*ntemps];
 
-                    hot_thread->currentParams = cold_thread->currentParams;
-                    hot_thread->currentPrior = cold_thread->currentPrior;
-                    hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+    REAL8 *temperatures = pt_async->ladder;
+    REAL8 delta = 0;
+    for (t=1; t < ntemps-1; t++) {
+        REAL8 steps = adaptLength + pt_async->ladder_step[slot];
 
-                    cold_thread->currentParams = temp_params;
-                    cold_thread->currentPrior = temp_prior;
-                    cold_thread->currentLikelihood = temp_like;
-                }
+        // Modulate temperature adjustments with a hyperbolic decay.
+        REAL8 decay = adaptLength / (steps + adaptLength);
+        REAL8 kappa = decay / (10*temp_skip);
 
-            }
-        } else {
-            if (MPIrank == cold_rank) {
-                cold_thread = &runState->threads[cold_ind % n_local_threads];
-
-                /* Send current likelihood for swap proposal */
-                MPI_Send(&(cold_thread->temperature), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-                MPI_Send(&(cold_thread->currentLikelihood), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-
-                /* Determine if swap was accepted */
-                MPI_Recv(&swapAccepted, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Perform Swap */
-                if (swapAccepted) {
-                    /* Set new likelihood */
-                    MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    cold_thread->currentLikelihood = adjCurrentLikelihood;
-
-                    /* Exchange current prior values */
-                    MPI_Send(&(cold_thread->currentPrior), 1, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-                    MPI_Recv(&adjCurrentPrior, 1, MPI_DOUBLE, hot_rank, 0, MPI_COMM_WORLD, &MPIstatus);
-                    cold_thread->currentPrior = adjCurrentPrior;
-
-                    /* Package and send parameters */
-                    nPar = LALInferenceGetVariableDimensionNonFixed(cold_thread->currentParams);
-                    MPI_Send(&nPar, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD);
-                    MPI_Recv(&adjNPar, 1, MPI_INT, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                    REAL8 *parameters = XLALMalloc(nPar * sizeof(REAL8));
-                    LALInferenceCopyVariablesToArray(cold_thread->currentParams, parameters);
-                    MPI_Send(parameters, nPar, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD);
-
-                    /* Recieve and unpack parameters */
-                    REAL8 *adjParameters = XLALMalloc(adjNPar * sizeof(REAL8));
-                    MPI_Recv(adjParameters, adjNPar, MPI_DOUBLE, hot_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    LALInferenceCopyArrayToVariables(adjParameters, cold_thread->currentParams);
-
-                    XLALFree(parameters);
-                    XLALFree(adjParameters);
-                }
-            } else if (MPIrank == hot_rank) {
-                hot_thread = &runState->threads[hot_ind % n_local_threads];
-
-                MPI_Recv(&cold_temp, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                /* Receive adjacent likelilhood */
-                MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_temp - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - adjCurrentLikelihood;
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-
-                MPI_Send(&swapAccepted, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD);
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    fprintf(swapfile, "%d%f\t%f\t\t%f\t%f\t%f\t%i\n",
-                            hot_thread->step, cold_temp, hot_thread->temperature,
-                            logThreadSwap, adjCurrentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted);
-                    fflush(swapfile);
-                }
+        // Construct temperature adjustments.
+        REAL8 dS = kappa * (acceptance_ratios[t-1] - acceptance_ratios[t]);
+
+        // Compute new ladder (hottest and coldest chains don't move).
+        REAL8 deltaT = (temperatures[t] - temperatures[t-1]) * exp(dS);
+        delta += deltaT;
+
+        temperatures[t] =  delta + temperatures[0];
+    }
+
+    for (t=0; t<n_local_threads; t++)
+        runState->threads[t].temperature = temperatures[pt_async->rank*n_local_threads + t];
 
-                /* Perform Swap */
-                if (swapAccepted) {
-                    /* Swap likelihoods */
-                    MPI_Send(&(hot_thread->currentLikelihood), 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
-                    hot_thread->currentLikelihood = adjCurrentLikelihood;
+    return;
+}
+
+//-----------------------------------------
+// Swap routines:
+//-----------------------------------------
+void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
+    INT4 n_local_threads, ntemps;
+    INT4 low, rank;
+    INT4 *cold_inds;
 
-                    /* Exchange current prior values */
-                    MPI_Recv(&adjCurrentPrior, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(&(hot_thread->currentPrior), 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
-                    hot_thread->currentPrior = adjCurrentPrior;
+    pt_async_init(runState);
+    n_local_threads = pt_async->n_local_threads;
+    ntemps = pt_async->ntemps;
+    rank = pt_async->rank;
 
-                    /* Package parameters */
-                    nPar = LALInferenceGetVariableDimensionNonFixed(hot_thread->currentParams);
-                    MPI_Recv(&adjNPar, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(&nPar, 1, MPI_INT, cold_rank, PT_COM, MPI_COMM_WORLD);
+    /* Return if running with only a single temperature */
+    if (ntemps == 1)
+        return;
 
-                    REAL8 *parameters = XLALMalloc(nPar * sizeof(REAL8));
-                    LALInferenceCopyVariablesToArray(hot_thread->currentParams, parameters);
+    pt_async->swapfile = swapfile;
 
-                    /* Swap parameters */
-                    REAL8 *adjParameters = XLALMalloc(adjNPar * sizeof(REAL8));
-                    MPI_Recv(adjParameters, adjNPar, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
-                    MPI_Send(parameters, nPar, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD);
+    /* Answer the colder neighbour, and start or check our own offer */
+    pt_poll_offers();
+    if (rank < pt_async->size-1) {
+        pt_check_reply(0);
+        if (!pt_async->offer_pending)
+            pt_send_offer();
+        pt_check_reply(0);
+    }
 
-                    /* Unpack parameters */
-                    LALInferenceCopyArrayToVariables(adjParameters, hot_thread->currentParams);
+    /* Swaps between chains on this rank, in a random order */
+    if (n_local_threads > 1) {
+        cold_inds = XLALCalloc(n_local_threads-1, sizeof(INT4));
+        for (low = 0; low < n_local_threads-1; low++)
+            cold_inds[low] = rank*n_local_threads + low;
 
-                    XLALFree(parameters);
-                    XLALFree(adjParameters);
-                }
-            }
+        gsl_ran_shuffle(runState->GSLrandom, cold_inds, n_local_threads-1, sizeof(INT4));
+
+        for (low = 0; low < n_local_threads-1; low++) {
+            /* The hottest local chain sits out while its state is on offer */
+            if (pt_async->offer_pending && cold_inds[low]+1 == (rank+1)*n_local_threads-1)
+                continue;
+            pt_local_swap(runState, cold_inds[low], cold_inds[low]+1, swapfile);
         }
+
+        XLALFree(cold_inds);
     }
 
-    XLALFree(cold_inds);
+    pt_async->round++;
+    pt_async->swapfile = NULL;
 
     return;
 }
@@ -1312,6 +1540,14 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
 
+    /* Samples are appended to the output as they are collected, so only
+     * those still buffered need writing before the state is recorded */
+    LALInferenceH5ChainOutput *chain_output = *(LALInferenceH5ChainOutput **)
+        LALInferenceGetVariable(runState->algorithmParams, "chain_output");
+    if (LALInferenceH5ChainOutputFlush(chain_output) != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC, "Failed to write samples to %s", runState->outFileName);
+    LALInferencePrintCheckpointFileInfo(runState->outFileName);
+
     resume_file = XLALH5FileOpen(runState->resumeOutFileName, "w");
     if(resume_file == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
@@ -1338,8 +1574,21 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
         free(chain_group_name);
         */
 
-        /* Create run identifier group */
-        LALInferenceH5VariablesArrayToDataset(chain_group, thread->differentialPoints, thread->differentialPointsLength, "differential_points");
+        /* Store the DE history in the same layout as the chain output */
+        UINT4 de_length = LALInferenceDEBufferLength(thread->deBuffer);
+        LALInferenceVariables **de_points = XLALCalloc(de_length, sizeof(LALInferenceVariables *));
+        for (i = 0; i < (INT4)de_length; i++) {
+            de_points[i] = XLALCalloc(1, sizeof(LALInferenceVariables));
+            LALInferenceCopyVariables(thread->currentParams, de_points[i]);
+            LALInferenceDEBufferPointToVariables(thread->deBuffer, i, de_points[i]);
+        }
+        LALInferenceH5VariablesArrayToDataset(chain_group, de_points, de_length, "differential_points");
+        for (i = 0; i < (INT4)de_length; i++) {
+            LALInferenceClearVariables(de_points[i]);
+            XLALFree(de_points[i]);
+        }
+        XLALFree(de_points);
+
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->proposalArgs), 1, "proposal_arguments");
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->currentParams), 1, "current_parameters");
         XLALH5FileAddScalarAttribute(chain_group, "temperature", &(thread->temperature), LAL_D_TYPE_CODE);
@@ -1347,6 +1596,10 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
         XLALH5FileAddScalarAttribute(chain_group, "effective_sample_size", &(thread->effective_sample_size), LAL_I4_TYPE_CODE);
         XLALH5FileAddScalarAttribute(chain_group, "differential_point_skip", &(thread->differentialPointsSkip), LAL_I4_TYPE_CODE);
 
+        /* Samples beyond this in the output were collected after the checkpoint */
+        UINT4 output_rows = LALInferenceH5ChainOutputLength(chain_output, t);
+        XLALH5FileAddScalarAttribute(chain_group, "output_rows", &output_rows, LAL_U4_TYPE_CODE);
+
         /* Store the total number of temperature swaps accepted over the stored window */
         REAL8 temp_acc_rate = 0;
         for (i=0; i<thread->temp_swap_window; i++)
@@ -1410,6 +1663,8 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
         XLAL_ERROR_VOID(XLAL_EIO);
     }
+    /* The samples stay in the output, which is reopened to append to them */
+    XLALH5FileClose(output);
 
     LALH5File *li_group = XLALH5GroupOpen(resume_file, "lalinference");
     LALH5File *group = XLALH5GroupOpen(li_group, runState->runID);
@@ -1427,8 +1682,22 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         XLAL_TRY(de_group = XLALH5DatasetRead(chain_group, "differential_points"), retcode);
         if (retcode==XLAL_SUCCESS)
         {
-            LALInferenceH5DatasetToVariablesArray(de_group, &(thread->differentialPoints), (UINT4 *)&(thread->differentialPointsLength));
-            thread->differentialPointsSize = thread->differentialPointsLength;
+            LALInferenceVariables **de_points = NULL;
+            UINT4 de_length = 0;
+            LALInferenceH5DatasetToVariablesArray(de_group, &de_points, &de_length);
+
+            /* Keep the most recent points if the buffer limit has been lowered */
+            LALInferenceDEBufferClear(thread->deBuffer, thread->deBuffer->skip);
+            for (k = 0; k < de_length; k++) {
+                if (k + thread->deBuffer->capacity >= de_length &&
+                    LALInferenceDEBufferAdd(thread->deBuffer, de_points[k]) != XLAL_SUCCESS) {
+                    fprintf(stderr, "Differential evolution points in checkpoint do not match the run parameters\n");
+                    MPI_Abort(MPI_COMM_WORLD, XLAL_EINVAL);
+                }
+                LALInferenceClearVariables(de_points[k]);
+                XLALFree(de_points[k]);
+            }
+            XLALFree(de_points);
         }
 
         /* Restore proposal arguments, most importantly adaptation settings */
@@ -1469,6 +1738,17 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         XLALH5FileQueryScalarAttributeValue(&(thread->temperature), chain_group, "temperature");
         XLALH5FileQueryScalarAttributeValue(&(thread->step), chain_group, "last_step");
         XLALH5FileQueryScalarAttributeValue(&(thread->differentialPointsSkip), chain_group, "differential_point_skip");
+        thread->deBuffer->skip = thread->differentialPointsSkip;
+
+        /* Output written after the checkpoint is discarded when the output
+         * is reopened; older checkpoints were written together with the
+         * whole output */
+        LALH5Generic gchain_group = {.file = chain_group};
+        UINT4 output_rows = LAL_UINT4_MAX;
+        if (XLALH5AttributeCheckExists(gchain_group, "output_rows"))
+            XLALH5FileQueryScalarAttributeValue(&output_rows, chain_group, "output_rows");
+        LALInferenceAddVariable(thread->algorithmParams, "output_rows", &output_rows,
+                                LALINFERENCE_UINT4_t, LALINFERENCE_PARAM_FIXED);
 
         /* Spread the count of accepted temp swaps at checkpoint evenly across the window */
         REAL8 temp_acc_rate;
@@ -1487,56 +1767,52 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     XLALH5FileClose(li_group);
     XLALH5FileClose(resume_file);
 
-    /* Read in samples collected so far */
-    
-
-    li_group = XLALH5GroupOpen(output, "lalinference");
-    group = XLALH5GroupOpen(li_group, runState->runID);
-
-    n_local_threads = runState->nthreads;
-    for (t = 0; t < n_local_threads; t++) {
-        thread = &runState->threads[t];
-
-        LALH5Dataset *chain_dataset=NULL;
-        XLAL_TRY(chain_dataset = XLALH5DatasetRead(group, thread->name), retcode);
-        if(retcode==XLAL_SUCCESS)
-        {
-            LALInferenceVariables **input_array;
-            UINT4 j, N;
-            LALInferenceH5DatasetToVariablesArray(chain_dataset, &input_array, &N);
-            for (j=0; j<N; j++){
-                LALInferenceLogSampleToArray(thread->algorithmParams, input_array[j]);
-                LALInferenceClearVariables(input_array[j]);
-            }
-            XLALFree(input_array);
-            XLALH5DatasetFree(chain_dataset);
-        }
-    }
-    XLALH5FileClose(group);
-    XLALH5FileClose(li_group);
-    XLALH5FileClose(output);
-
     return;
 }
 
 
-void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
-    //ProcessParamsTable *ppt;
-    INT4 MPIrank;
+/* Create the output file, or reopen it to append to the samples kept by --resume */
+void LALInferenceOpenMCMCOutput(LALInferenceRunState *runState) {
     INT4 t, n_local_threads;
-    LALH5File *output = NULL;
     LALInferenceThreadState *thread;
+    LALInferenceH5ChainOutput *chain_output;
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    n_local_threads = runState->nthreads;
+    if (n_local_threads > 0 && LALInferenceCheckVariable(runState->threads[0].algorithmParams, "output_rows")) {
+        const char *names[n_local_threads];
+        UINT4 output_rows[n_local_threads];
+        for (t = 0; t < n_local_threads; t++) {
+            thread = &runState->threads[t];
+            names[t] = thread->name;
+            output_rows[t] = *(UINT4 *)LALInferenceGetVariable(thread->algorithmParams, "output_rows");
+            LALInferenceRemoveVariable(thread->algorithmParams, "output_rows");
+        }
+        chain_output = LALInferenceH5ChainOutputResume(
+            runState->outFileName, "lalinference", runState->runID,
+            n_local_threads, MCMC_OUTPUT_BUFFER_LENGTH, names, output_rows);
+        if(chain_output == NULL){
+            XLALErrorHandler = XLALExitErrorHandler;
+            XLALPrintError("Unable to reopen %s to resume. (in %s, line %d)\n",runState->outFileName,__FILE__, __LINE__);
+            XLAL_ERROR_VOID(XLAL_EIO);
+        }
+        LALInferenceAddVariable(runState->algorithmParams, "chain_output", &chain_output,
+                                LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_FIXED);
+        /* The metadata were written when the output was created */
+        return;
+    }
 
-    output = XLALH5FileOpen(runState->outFileName, "w");
-    if(output == NULL){
+    chain_output = LALInferenceH5ChainOutputOpen(
+        runState->outFileName, "lalinference", runState->runID,
+        n_local_threads, MCMC_OUTPUT_BUFFER_LENGTH);
+    if(chain_output == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
         XLAL_ERROR_VOID(XLAL_EIO);
     }
+    LALInferenceAddVariable(runState->algorithmParams, "chain_output", &chain_output,
+                            LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_FIXED);
 
-    LALH5File *group = LALInferenceH5CreateGroupStructure(output, "lalinference", runState->runID);
+    LALH5File *group = LALInferenceH5ChainOutputGroup(chain_output);
     /* Print injection parameters if there are any */
     LALInferenceVariables *injParams = NULL;
     if ( (injParams=LALInferencePrintInjectionSample(runState)) )
@@ -1546,26 +1822,25 @@ void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
         XLALFree(injParams);
     }
 
-    n_local_threads = runState->nthreads;
-    for (t = 0; t < n_local_threads; t++) {
-        thread = &runState->threads[t];
-
-        LALInferenceVariables **output_array=NULL;
-        UINT4 N_output_array=0;
-        if(LALInferenceCheckVariable(thread->algorithmParams, "outputarray")
-                && LALInferenceCheckVariable(thread->algorithmParams, "N_outputarray") ) {
-            output_array=*(LALInferenceVariables ***)LALInferenceGetVariable(thread->algorithmParams,"outputarray");
-            N_output_array=*(UINT4 *)LALInferenceGetVariable(thread->algorithmParams,"N_outputarray");
-
-            /* Create run identifier group */
-            LALInferenceH5VariablesArrayToDataset(group, output_array, N_output_array, thread->name);
-        }
-    }
     char *cl=NULL;
     cl=LALInferencePrintCommandLine(runState->commandLine);
     XLALH5FileAddStringAttribute(group,"CommandLine",cl);
-    XLALH5FileClose(group);
-    XLALH5FileClose(output);
+    XLALFree(cl);
+
+    if (LALInferenceH5ChainOutputFlush(chain_output) != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC, "Failed to write samples to %s", runState->outFileName);
+    return;
+}
+
+
+/* Write any buffered samples and close the output file */
+void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
+    LALInferenceH5ChainOutput *chain_output = *(LALInferenceH5ChainOutput **)
+        LALInferenceGetVariable(runState->algorithmParams, "chain_output");
+
+    if (LALInferenceH5ChainOutputClose(chain_output) != XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC, "Failed to write samples to %s", runState->outFileName);
+    LALInferenceRemoveVariable(runState->algorithmParams, "chain_output");
     LALInferencePrintCheckpointFileInfo(runState->outFileName);
     return;
 }
@@ -1971,7 +2246,7 @@ void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState
 void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     char filename[FILENAME_MAX];
     FILE *out;
-    UINT4 ui;
+    UINT4 ui, ifo;
 
     snprintf(filename, sizeof(filename), "freqTemplatehPlus.dat");
     out = fopen(filename, "w");
@@ -1993,14 +2268,19 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     }
     fclose(out);
 
-    while (data != NULL) {
+    for (ifo = 0; data != NULL; ifo++) {
+        /* responses of the model's last likelihood evaluation */
+        REAL8 fPlus = model->ifo_fPlus[ifo];
+        REAL8 fCross = model->ifo_fCross[ifo];
+        REAL8 timeshift = model->ifo_timeshifts[ifo];
+
         snprintf(filename, sizeof(filename), "%s-freqTemplateStrain.dat", data->name);
         out = fopen(filename, "w");
         for (ui = 0; ui < model->freqhCross->data->length; ui++) {
             REAL8 f = model->freqhCross->deltaF * ui;
             COMPLEX16 d;
-            d = data->fPlus * model->freqhPlus->data->data[ui] +
-            data->fCross * model->freqhCross->data->data[ui];
+            d = fPlus * model->freqhPlus->data->data[ui] +
+            fCross * model->freqhCross->data->data[ui];
 
             fprintf(out, "%g %g %g\n", f, creal(d), cimag(d) );
         }
@@ -2010,9 +2290,9 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         out = fopen(filename, "w");
         for (ui = 0; ui < model->timehCross->data->length; ui++) {
             REAL8 tt = XLALGPSGetREAL8(&(model->timehCross->epoch)) +
-            data->timeshift + ui*model->timehCross->deltaT;
-            REAL8 d = data->fPlus*model->timehPlus->data->data[ui] +
-            data->fCross*model->timehCross->data->data[ui];
+            timeshift + ui*model->timehCross->deltaT;
+            REAL8 d = fPlus*model->timehPlus->data->data[ui] +
+            fCross*model->timehCross->data->data[ui];
 
             fprintf(out, "%.6f %g\n", tt, d);
         }
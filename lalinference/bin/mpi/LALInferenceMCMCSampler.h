@@ -52,6 +52,8 @@ void record_likelihoods(LALInferenceThreadState *thread);
 /* MPI communications */
 typedef enum {
     PT_COM,          /** Parallel tempering communications */
+    PT_SWAP_OFFER_COM,    /** Swap offer from the colder neighbour */
+    PT_SWAP_REPLY_COM,    /** Swap decision from the hotter neighbour */
     LADDER_UPDATE_COM,    /** Update positions across the ladder */
     RUN_PHASE_COM,   /** runPhase passing */
     RUN_COMPLETE       /** Run complete */
@@ -71,7 +73,9 @@ void acknowledgePhase(LALInferenceRunState *runState);
 void LALInferenceAdaptation(LALInferenceThreadState *thread);
 void LALInferenceAdaptationRestart(LALInferenceThreadState *thread);
 REAL8 LALInferenceAdaptationEnvelope(INT4 step, INT4 tau, INT4 length, INT4 fix_adapt_len);
+/** Complete outstanding ladder gathers and control broadcasts and free the swap state */
 void LALInferenceShutdownLadder(void);
+/** Complete any swap across MPI ranks that is still in flight */
 void LALInferenceFlushPTswap(void);
 void LALInferenceLadderUpdate(LALInferenceRunState *runState, INT4 sourceChainFlag, INT4 cycle);
 
@@ -84,6 +88,7 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model);
 void LALInferenceSaveSample(LALInferenceThreadState *thread, FILE *output);
 void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState *thread);
 void LALInferencePrintMCMCSample(LALInferenceThreadState *thread, LALInferenceIFOData *data, INT4 iteration, REAL8 timestamp, FILE *threadoutput);
+void LALInferenceOpenMCMCOutput(LALInferenceRunState *runState);
 void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState);
 void LALInferenceNameOutputs(LALInferenceRunState *runState);
 void LALInferenceCheckpointMCMC(LALInferenceRunState *runState);
@@ -24,6 +24,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
@@ -37,7 +38,6 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_eigen.h>
-#include <gsl/gsl_interp.h>
 #include <lal/LALHashFunc.h>
 #include <lal/LALSimNeutronStar.h>
 
@@ -130,6 +130,7 @@ LALInferenceThreadState *LALInferenceInitThread(LALInferenceThreadState *thread)
     thread->differentialPointsLength = 0;
     thread->differentialPointsSize = 1;
     thread->differentialPointsSkip = 1;
+    thread->deBuffer = NULL;
 
     return thread;
 }
@@ -1593,6 +1594,9 @@ INT4 LALInferenceThinnedBufferToArray(LALInferenceThreadState *thread, REAL8** D
     LALInferenceVariableItem *ptr;
     INT4 i=0, p=0;
 
+    if (thread->deBuffer)
+        return LALInferenceDEBufferToArray(thread->deBuffer, DEarray, step);
+
     INT4 nPoints = thread->differentialPointsLength;
     for (i = 0; i < nPoints; i+=step) {
         ptr=thread->differentialPoints[i]->head;
@@ -1617,6 +1621,175 @@ INT4 LALInferenceBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray)
 }
 
 
+size_t LALInferenceDifferentialPointsLength(const LALInferenceThreadState *thread) {
+    if (thread->deBuffer)
+        return LALInferenceDEBufferLength(thread->deBuffer);
+    return thread->differentialPointsLength;
+}
+
+
+/*
+ * The differential evolution buffer is written by its owning chain and read
+ * by the other chains of the process without locks.  Points below the
+ * published length are never modified except while thinning or clearing,
+ * which is bracketed by the generation counter in the manner of a seqlock.
+ */
+#define DEBUFFER_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define DEBUFFER_STORE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+
+static void DEBufferBeginRearrange(LALInferenceDEBuffer *buffer) {
+    __atomic_store_n(&buffer->generation, buffer->generation + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void DEBufferEndRearrange(LALInferenceDEBuffer *buffer) {
+    DEBUFFER_STORE(&buffer->generation, buffer->generation + 1);
+}
+
+LALInferenceDEBuffer *LALInferenceCreateDEBuffer(LALInferenceVariables *params, UINT4 capacity, UINT4 skip) {
+    XLAL_CHECK_NULL(params != NULL, XLAL_EFAULT);
+    XLAL_CHECK_NULL(capacity >= 2, XLAL_EINVAL, "Buffer must hold at least two points");
+    XLAL_CHECK_NULL(skip > 0, XLAL_EINVAL);
+
+    UINT4 dim = 0;
+    LALInferenceVariableItem *item;
+    for (item = params->head; item; item = item->next)
+        if (item->type == LALINFERENCE_REAL8_t && LALInferenceCheckVariableNonFixed(params, item->name))
+            dim++;
+    XLAL_CHECK_NULL(dim > 0, XLAL_EINVAL, "No non-fixed REAL8 parameters to store");
+
+    LALInferenceDEBuffer *buffer = XLALCalloc(1, sizeof(*buffer));
+    XLAL_CHECK_NULL(buffer != NULL, XLAL_ENOMEM);
+    buffer->dim = dim;
+    buffer->capacity = capacity;
+    buffer->skip = skip;
+    buffer->names = XLALCalloc(dim, sizeof(char *));
+    buffer->points = XLALMalloc((size_t)capacity * dim * sizeof(REAL8));
+    if (buffer->names == NULL || buffer->points == NULL) {
+        LALInferenceDestroyDEBuffer(buffer);
+        XLAL_ERROR_NULL(XLAL_ENOMEM, "Unable to allocate %u points of dimension %u", capacity, dim);
+    }
+
+    UINT4 p = 0;
+    for (item = params->head; item; item = item->next)
+        if (item->type == LALINFERENCE_REAL8_t && LALInferenceCheckVariableNonFixed(params, item->name))
+            buffer->names[p++] = XLALStringDuplicate(item->name);
+
+    return buffer;
+}
+
+void LALInferenceDestroyDEBuffer(LALInferenceDEBuffer *buffer) {
+    if (buffer == NULL)
+        return;
+    if (buffer->names)
+        for (UINT4 p = 0; p < buffer->dim; p++)
+            XLALFree(buffer->names[p]);
+    XLALFree(buffer->names);
+    XLALFree(buffer->points);
+    XLALFree(buffer);
+}
+
+int LALInferenceDEBufferAdd(LALInferenceDEBuffer *buffer, LALInferenceVariables *params) {
+    XLAL_CHECK(buffer != NULL && params != NULL, XLAL_EFAULT);
+
+    UINT4 length = buffer->length;
+    if (length == buffer->capacity) {
+        /* Keep the odd-index points, so the newest point survives */
+        DEBufferBeginRearrange(buffer);
+        for (UINT4 i = 1; i < length; i += 2)
+            memcpy(&buffer->points[(size_t)(i/2) * buffer->dim], &buffer->points[(size_t)i * buffer->dim], buffer->dim * sizeof(REAL8));
+        length /= 2;
+        buffer->skip *= 2;
+        __atomic_store_n(&buffer->length, length, __ATOMIC_RELAXED);
+        DEBufferEndRearrange(buffer);
+    }
+
+    /* The slot is beyond the published length, so no reader can be looking at it */
+    REAL8 *point = &buffer->points[(size_t)length * buffer->dim];
+    for (UINT4 p = 0; p < buffer->dim; p++) {
+        XLAL_CHECK(LALInferenceCheckVariable(params, buffer->names[p]) &&
+                   LALInferenceGetVariableType(params, buffer->names[p]) == LALINFERENCE_REAL8_t, XLAL_EINVAL,
+                   "REAL8 parameter '%s' of the differential evolution buffer is missing", buffer->names[p]);
+        point[p] = LALInferenceGetREAL8Variable(params, buffer->names[p]);
+    }
+
+    DEBUFFER_STORE(&buffer->length, length + 1);
+    return XLAL_SUCCESS;
+}
+
+void LALInferenceDEBufferClear(LALInferenceDEBuffer *buffer, UINT4 skip) {
+    if (buffer == NULL)
+        return;
+    DEBufferBeginRearrange(buffer);
+    __atomic_store_n(&buffer->length, 0, __ATOMIC_RELAXED);
+    buffer->skip = skip > 0 ? skip : 1;
+    DEBufferEndRearrange(buffer);
+}
+
+UINT4 LALInferenceDEBufferLength(const LALInferenceDEBuffer *buffer) {
+    return buffer ? DEBUFFER_LOAD(&buffer->length) : 0;
+}
+
+UINT4 LALInferenceDEBufferDrawPoints(const LALInferenceDEBuffer *buffer, gsl_rng *rng, UINT4 n, REAL8 **pts) {
+    if (buffer == NULL || n == 0)
+        return 0;
+
+    UINT4 idx[n];
+    for (;;) {
+        UINT4 generation = DEBUFFER_LOAD(&buffer->generation);
+        if (generation & 1)
+            continue; /* Owner is thinning, points are being moved */
+
+        UINT4 length = DEBUFFER_LOAD(&buffer->length);
+        if (length < n || length < 2)
+            return 0;
+
+        for (UINT4 k = 0; k < n; k++) {
+            UINT4 l;
+            do {
+                idx[k] = gsl_rng_uniform_int(rng, length);
+                for (l = 0; l < k && idx[l] != idx[k]; l++);
+            } while (l < k);
+            memcpy(pts[k], &buffer->points[(size_t)idx[k] * buffer->dim], buffer->dim * sizeof(REAL8));
+        }
+
+        /* Discard the copies if the points moved while they were read */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&buffer->generation, __ATOMIC_RELAXED) == generation)
+            return length;
+    }
+}
+
+UINT4 LALInferenceDEBufferDrawPair(const LALInferenceDEBuffer *buffer, gsl_rng *rng, REAL8 *ptI, REAL8 *ptJ) {
+    REAL8 *pts[2] = {ptI, ptJ};
+    return LALInferenceDEBufferDrawPoints(buffer, rng, 2, pts);
+}
+
+INT4 LALInferenceDEBufferIndex(const LALInferenceDEBuffer *buffer, const char *name) {
+    for (UINT4 p = 0; p < buffer->dim; p++)
+        if (strcmp(buffer->names[p], name) == 0)
+            return p;
+    return -1;
+}
+
+INT4 LALInferenceDEBufferToArray(const LALInferenceDEBuffer *buffer, REAL8 **DEarray, INT4 step) {
+    INT4 i;
+    INT4 nPoints = buffer->length;
+
+    for (i = 0; i < nPoints; i += step)
+        memcpy(DEarray[i/step], &buffer->points[(size_t)i * buffer->dim], buffer->dim * sizeof(REAL8));
+
+    return nPoints/step;
+}
+
+void LALInferenceDEBufferPointToVariables(const LALInferenceDEBuffer *buffer, UINT4 i, LALInferenceVariables *vars) {
+    const REAL8 *point = &buffer->points[(size_t)i * buffer->dim];
+    for (UINT4 p = 0; p < buffer->dim; p++)
+        if (LALInferenceCheckVariable(vars, buffer->names[p]))
+            LALInferenceSetREAL8Variable(vars, buffer->names[p], point[p]);
+}
+
+
 void LALInferenceCopyVariablesToArray(LALInferenceVariables *origin, REAL8 *target) {
   gsl_matrix *m = NULL; //for dealing with noise parameters
   REAL8Vector *v8 = NULL;
@@ -2343,17 +2516,9 @@ LALSimNeutronStarFamily *fam = NULL;
 eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si, gamma1, gamma2, gamma3);
 fam = XLALCreateSimNeutronStarFamily(eos);
 
-// Calculate lambda1(m1|eos)
-double r = XLALSimNeutronStarRadius(mass1_kg, fam);
-double k = XLALSimNeutronStarLoveNumberK2(mass1_kg, fam);
-double c = mass1 * LAL_MRSUN_SI / r;
-*lambda1= (2.0/3.0) * k / pow(c , 5.0);
-
-// Calculate lambda2(m2|eos)
-r = XLALSimNeutronStarRadius(mass2_kg, fam);
-k = XLALSimNeutronStarLoveNumberK2(mass2_kg, fam);
-c = mass2 * LAL_MRSUN_SI / r;
-*lambda2= (2.0/3.0) * k / pow(c , 5.0);
+// Calculate lambda1,2(m1,2|eos)
+XLALSimNeutronStarTidalProperties(NULL, NULL, lambda1, mass1_kg, fam);
+XLALSimNeutronStarTidalProperties(NULL, NULL, lambda2, mass2_kg, fam);
 
 // Clean up
 XLALDestroySimNeutronStarFamily(fam);
@@ -2380,17 +2545,9 @@ else{
   eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,size);
   fam = XLALCreateSimNeutronStarFamily(eos);
 
-  // Calculate lambda1(m1|eos)
-  double r = XLALSimNeutronStarRadius(mass1_kg, fam);
-  double k = XLALSimNeutronStarLoveNumberK2(mass1_kg, fam);
-  double c = mass1 * LAL_MRSUN_SI / r;
-  *lambda1= (2.0/3.0) * k / pow(c , 5.0);
-
-  // Calculate lambda2(m1|eos)
-  r = XLALSimNeutronStarRadius(mass2_kg, fam);
-  k = XLALSimNeutronStarLoveNumberK2(mass2_kg, fam);
-  c = mass2 * LAL_MRSUN_SI / r;
-  *lambda2= (2.0/3.0) * k / pow(c , 5.0);
+  // Calculate lambda1,2(m1,2|eos)
+  XLALSimNeutronStarTidalProperties(NULL, NULL, lambda1, mass1_kg, fam);
+  XLALSimNeutronStarTidalProperties(NULL, NULL, lambda2, mass2_kg, fam);
 
   // Clean up
   XLALDestroySimNeutronStarFamily(fam);
@@ -2399,164 +2556,315 @@ else{
 
 }
 
+/* EOS parameterisations that can be cached */
+typedef enum {
+  LALINFERENCE_EOS_NONE = 0,
+  LALINFERENCE_EOS_PIECEWISE_POLYTROPE,
+  LALINFERENCE_EOS_SPECTRAL
+} LALInferenceEOSParameterisation;
+
+/* One cached EOS and its family of stars */
+typedef struct tagLALInferenceEOSFamilyCacheEntry {
+  LALInferenceEOSParameterisation type;
+  REAL8 eosParams[4];
+  LALSimNeutronStarEOS *eos;     /* NULL if the parameters were rejected before building the EOS */
+  LALSimNeutronStarFamily *fam;
+  int turnoverOK;                /* mass does not turn over within the first few pressures */
+  REAL8 min_mass_kg, max_mass_kg;
+  REAL8 vsmax;                   /* speed of sound at the maximum-mass star */
+  UINT8 lastUsed;
+} LALInferenceEOSFamilyCacheEntry;
+
+struct tagLALInferenceEOSFamilyCache {
+  UINT4 size;
+  UINT8 clock;
+  UINT8 hits, misses;
+  LALInferenceEOSFamilyCacheEntry *entries;
+};
 
-/* Checks if EOS allows for acausal speed of sound and unphysical maximum masses */
-int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine){
-int ret;
+/* Read the EOS parameterisation and its parameters from params */
+static LALInferenceEOSParameterisation LALInferenceGetEOSParams(LALInferenceVariables *params, REAL8 eosParams[4]){
+  if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(params, "gamma1") && LALInferenceCheckVariable(params, "gamma2") && LALInferenceCheckVariable(params, "gamma3"))
+  {
+    eosParams[0]=*(REAL8 *)LALInferenceGetVariable(params,"logp1");
+    eosParams[1]=*(REAL8 *)LALInferenceGetVariable(params,"gamma1");
+    eosParams[2]=*(REAL8 *)LALInferenceGetVariable(params,"gamma2");
+    eosParams[3]=*(REAL8 *)LALInferenceGetVariable(params,"gamma3");
+    return LALINFERENCE_EOS_PIECEWISE_POLYTROPE;
+  }
+  else if(LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
+  {
+    eosParams[0]=*(REAL8 *)LALInferenceGetVariable(params,"SDgamma0");
+    eosParams[1]=*(REAL8 *)LALInferenceGetVariable(params,"SDgamma1");
+    eosParams[2]=*(REAL8 *)LALInferenceGetVariable(params,"SDgamma2");
+    eosParams[3]=*(REAL8 *)LALInferenceGetVariable(params,"SDgamma3");
+    return LALINFERENCE_EOS_SPECTRAL;
+  }
+  return LALINFERENCE_EOS_NONE;
+}
 
-LALSimNeutronStarEOS *eos=NULL;
-LALSimNeutronStarFamily *fam=NULL;
+/* Make the EOS, or return NULL if the spectral parameters are unreasonable */
+static LALSimNeutronStarEOS *LALInferenceMakeEOS(LALInferenceEOSParameterisation type, REAL8 eosParams[4]){
+  if(type==LALINFERENCE_EOS_PIECEWISE_POLYTROPE)
+    // Convert logp1 to SI
+    return XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(eosParams[0]-1.0,eosParams[1],eosParams[2],eosParams[3]);
+  if(type==LALINFERENCE_EOS_SPECTRAL && LALInferenceSDGammaCheck(eosParams, 4) == XLAL_SUCCESS)
+    return XLALSimNeutronStarEOSSpectralDecomposition(eosParams,4);
+  return NULL;
+}
 
-// If using 4-piece polytrope eos params...
-if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(params, "gamma1") && LALInferenceCheckVariable(params, "gamma2") && LALInferenceCheckVariable(params, "gamma3"))
-{
-  // Retrieve EOS params from params linked list
-  double logp1=*(double *)LALInferenceGetVariable(params,"logp1");
-  double gamma1=*(double *)LALInferenceGetVariable(params,"gamma1");
-  double gamma2=*(double *)LALInferenceGetVariable(params,"gamma2");
-  double gamma3=*(double *)LALInferenceGetVariable(params,"gamma3");
+/* FIXME: This is a little clunky,
+   Check to make sure family will contain
+   enough pts for interpolation */
+static int LALInferenceEOSTurnoverCheck(LALSimNeutronStarEOS *eos){
+  double pdat;
+  double mdat;
+  double mdat_prev;
+  double rdat;
+  double kdat;
+
+  /* Initialize previous value for mdat comparison, set to something that will always
+     make (mdat <= mdat_prev) == true. */
+  mdat_prev = 0.0;
+
+  // Ensure mass turnover does not happen too soon
+  const double logpmin = 75.5;
+  double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
+  double dlogp = (logpmax - logpmin) / 100.;
+  // Need at least 8 points
+  for (int i = 0; i < 4; ++i) {
+    pdat = exp(logpmin + i * dlogp);
+    XLALSimNeutronStarTOVODEIntegrate(&rdat, &mdat, &kdat, pdat, eos);
+    /* determine if maximum mass has been found */
+    if (mdat <= mdat_prev)
+      return XLAL_FAILURE;
+    mdat_prev = mdat;
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Read the masses from params in solar masses */
+static int LALInferenceEOSCheckMasses(LALInferenceVariables *params, double *mass1, double *mass2){
+  if(LALInferenceCheckVariable(params,"mass1") && LALInferenceCheckVariable(params,"mass2")) {
+    // If using (mass1,mass2) parameterization, no need to convert
+    *mass1=*(double *)LALInferenceGetVariable(params,"mass1");
+    *mass2=*(double *)LALInferenceGetVariable(params,"mass2");
+  }
+  else if(LALInferenceCheckVariable(params,"chirpmass") && LALInferenceCheckVariable(params,"q")) {
+    // Convert from (chirpmass,q) -> (m1,m2)
+    double chirpmass=*(double *)LALInferenceGetVariable(params,"chirpmass");
+    double q=*(double *)LALInferenceGetVariable(params,"q");
+    LALInferenceMcQ2Masses(chirpmass,q,mass1,mass2);
+  }
+  else if(LALInferenceCheckVariable(params, "chirpmass") && LALInferenceCheckVariable(params, "eta")) {
+    // Convert from (chirpmass,eta) -> (m1,m2)
+    double chirpmass=*(double *)LALInferenceGetVariable(params,"chirpmass");
+    double eta=*(double *)LALInferenceGetVariable(params,"eta");
+    LALInferenceMcEta2Masses(chirpmass,eta,mass1,mass2);
+  }
+  else {
+    // Else fail
+    fprintf(stdout,"ERROR: NO MASS PARAMETERS FOUND\n");
+    return XLAL_FAILURE;
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Check the masses and command-line maximum NS mass against a family with
+ * maximum-mass speed of sound vsmax */
+static int LALInferenceEOSFamilyCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine, double min_mass_kg, double max_mass_kg, double vsmax){
+  double mass1 = 0.;
+  double mass2 = 0.;
+  if(LALInferenceEOSCheckMasses(params, &mass1, &mass2) == XLAL_FAILURE)
+    return XLAL_FAILURE;
 
   // Convert to SI
-  REAL8 logp1_si=logp1-1.0;
+  double mass1_kg= mass1*LAL_MSUN_SI;
+  double mass2_kg= mass2*LAL_MSUN_SI;
 
-  // Make 4-piece polytrope eos
-  eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si,gamma1,gamma2,gamma3);
+  // Read in max observed NS mass, which eos must support
+  REAL8 ns_max_mass = 0.;
+  if(LALInferenceGetProcParamVal(commandLine,"--ns-max-mass")) {
+    ns_max_mass= atof(LALInferenceGetProcParamVal(commandLine,"--ns-max-mass")->value);
+  }
+  // If none, then set max to proposed mass, since EOS must support this mass anyway
+  else{
+    ns_max_mass = mass2;
+  }
 
-// Else if using 4-coeff spectral eos params...
+  // If m1 and m2 are supported by min and max mass allowed by eos
+  // and if the speed of sound is less than 1.1c (the 0.1 is some wiggle room, since eos is not exact)
+  // and if the max-mass NS is supported
+  if(mass1_kg <= max_mass_kg && mass2_kg <= max_mass_kg && mass1_kg >= min_mass_kg && mass2_kg >= min_mass_kg && vsmax <= 1.1 && max_mass_kg >= ns_max_mass*LAL_MSUN_SI)
+    return XLAL_SUCCESS;
+  return XLAL_FAILURE;
 }
-else if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
-{
-  // Retrieve EOS params from params linked list
-  double SDgamma0=*(double *)LALInferenceGetVariable(params,"SDgamma0");
-  double SDgamma1=*(double *)LALInferenceGetVariable(params,"SDgamma1");
-  double SDgamma2=*(double *)LALInferenceGetVariable(params,"SDgamma2");
-  double SDgamma3=*(double *)LALInferenceGetVariable(params,"SDgamma3");
-  double gamma[]={SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-
-  if(LALInferenceSDGammaCheck(gamma, 4) == XLAL_FAILURE)
-    return XLAL_FAILURE;
-
-  // Make 4-piece polytrope eos
-  eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,4);
 
+/* Speed of sound at the centre of the maximum-mass star */
+static double LALInferenceEOSMaxMassSpeedOfSound(LALSimNeutronStarEOS *eos, LALSimNeutronStarFamily *fam){
+  double max_mass_kg = XLALSimNeutronStarMaximumMass(fam);
+  double pmax = XLALSimNeutronStarCentralPressure(max_mass_kg, fam);
+  double hmax = XLALSimNeutronStarEOSPseudoEnthalpyOfPressure(pmax, eos);
+  return XLALSimNeutronStarEOSSpeedOfSoundGeometerized(hmax, eos);
 }
-// Else fail, since you need an eos
-else {
+
+/* Checks if EOS allows for acausal speed of sound and unphysical maximum masses */
+int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine){
+int ret;
+REAL8 eosParams[4];
+
+LALSimNeutronStarEOS *eos=NULL;
+LALSimNeutronStarFamily *fam=NULL;
+
+LALInferenceEOSParameterisation type = LALInferenceGetEOSParams(params, eosParams);
+// Fail if there are no eos params
+if(type==LALINFERENCE_EOS_NONE) {
   fprintf(stdout,"NO EOS PARAMETERS FOUND\n");
   return XLAL_FAILURE;
 }
 
-/* FIXME: This is a little clunky,
-  Check to make sure family will contain
-  enough pts for interpolation */
-double pdat;
-double mdat;
-double mdat_prev;
-double rdat;
-double kdat;
-
-/* Initialize previous value for mdat comparison, set to something that will always
-   make (mdat <= mdat_prev) == true. */
-mdat_prev = 0.0;
-
-// Ensure mass turnover does not happen too soon
-const double logpmin = 75.5;
-double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
-double dlogp = (logpmax - logpmin) / 100.;
-// Need at least 8 points
-for (int i = 0; i < 4; ++i) {
-   pdat = exp(logpmin + i * dlogp);
-   XLALSimNeutronStarTOVODEIntegrate(&rdat, &mdat, &kdat, pdat, eos);
-   /* determine if maximum mass has been found */
-   if (mdat <= mdat_prev){
-      fprintf(stdout,"EOS has too few points. Sample rejected.\n");
-      if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariable(params,"SDgamma1") && LALInferenceCheckVariable(params,"SDgamma2") && LALInferenceCheckVariable(params,"SDgamma3"))
-      {
-        // Retrieve EOS params from params linked list
-        double SDgamma0=*(double *)LALInferenceGetVariable(params,"SDgamma0");
-        double SDgamma1=*(double *)LALInferenceGetVariable(params,"SDgamma1");
-        double SDgamma2=*(double *)LALInferenceGetVariable(params,"SDgamma2");
-        double SDgamma3=*(double *)LALInferenceGetVariable(params,"SDgamma3");
-        fprintf(stdout,"spectral: %f %f %f %f\n",SDgamma0,SDgamma1,SDgamma2,SDgamma3);
-      }
-      // Clean up
-      XLALDestroySimNeutronStarFamily(fam);
-      XLALDestroySimNeutronStarEOS(eos);
-      return XLAL_FAILURE;
-    }
-    mdat_prev = mdat;
-}
+eos = LALInferenceMakeEOS(type, eosParams);
+if(!eos)
+  return XLAL_FAILURE;
 
+if(LALInferenceEOSTurnoverCheck(eos) == XLAL_FAILURE){
+  fprintf(stdout,"EOS has too few points. Sample rejected.\n");
+  if(type==LALINFERENCE_EOS_SPECTRAL)
+    fprintf(stdout,"spectral: %f %f %f %f\n",eosParams[0],eosParams[1],eosParams[2],eosParams[3]);
+  XLALDestroySimNeutronStarEOS(eos);
+  return XLAL_FAILURE;
+}
 
 // Make family
 fam = XLALCreateSimNeutronStarFamily(eos);
 
-// Determine which mass parameterization is used
-double mass1 = 0.;
-double mass2 = 0.;
+// Calculate speed of sound and max and min mass allowed by eos
+ret = LALInferenceEOSFamilyCheck(params, commandLine, XLALSimNeutronStarFamMinimumMass(fam), XLALSimNeutronStarMaximumMass(fam), LALInferenceEOSMaxMassSpeedOfSound(eos, fam));
 
-if(LALInferenceCheckVariable(params,"mass1") && LALInferenceCheckVariable(params,"mass2")) {
-  // If using (mass1,mass2) parameterization, no need to convert
-  mass1=*(double *)LALInferenceGetVariable(params,"mass1");
-  mass2=*(double *)LALInferenceGetVariable(params,"mass2");
+// Clean up
+XLALDestroySimNeutronStarFamily(fam);
+XLALDestroySimNeutronStarEOS(eos);
+return ret;
 }
-else if(LALInferenceCheckVariable(params,"chirpmass") && LALInferenceCheckVariable(params,"q")) {
-  // Convert from (chirpmass,q) -> (m1,m2)
-  double chirpmass=*(double *)LALInferenceGetVariable(params,"chirpmass");
-  double q=*(double *)LALInferenceGetVariable(params,"q");
-  LALInferenceMcQ2Masses(chirpmass,q,&mass1,&mass2);
+
+LALInferenceEOSFamilyCache *LALInferenceCreateEOSFamilyCache(UINT4 size){
+  if(size==0) XLAL_ERROR_NULL(XLAL_EINVAL, "EOS family cache size must be positive");
+  LALInferenceEOSFamilyCache *cache = XLALCalloc(1, sizeof(*cache));
+  if(!cache) XLAL_ERROR_NULL(XLAL_ENOMEM);
+  cache->entries = XLALCalloc(size, sizeof(*cache->entries));
+  if(!cache->entries) {
+    XLALFree(cache);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  cache->size = size;
+  return cache;
 }
 
-else if(LALInferenceCheckVariable(params, "chirpmass") && LALInferenceCheckVariable(params, "eta")) {
-  // Convert from (chirpmass,eta) -> (m1,m2)
-  double chirpmass=*(double *)LALInferenceGetVariable(params,"chirpmass");
-  double eta=*(double *)LALInferenceGetVariable(params,"eta");
-  LALInferenceMcEta2Masses(chirpmass,eta,&mass1,&mass2);
+static void LALInferenceClearEOSFamilyCacheEntry(LALInferenceEOSFamilyCacheEntry *entry){
+  XLALDestroySimNeutronStarFamily(entry->fam);
+  XLALDestroySimNeutronStarEOS(entry->eos);
+  memset(entry, 0, sizeof(*entry));
 }
-else {
-  // Else fail
-  fprintf(stdout,"ERROR: NO MASS PARAMETERS FOUND\n");
-  // Clean up
-  XLALDestroySimNeutronStarFamily(fam);
-  XLALDestroySimNeutronStarEOS(eos);
-  return XLAL_FAILURE;
+
+void LALInferenceDestroyEOSFamilyCache(LALInferenceEOSFamilyCache *cache){
+  if(!cache) return;
+  for(UINT4 i=0;i<cache->size;i++)
+    LALInferenceClearEOSFamilyCacheEntry(&cache->entries[i]);
+  XLALFree(cache->entries);
+  XLALFree(cache);
 }
 
-// Convert to SI
-double mass1_kg= mass1*LAL_MSUN_SI;
-double mass2_kg= mass2*LAL_MSUN_SI;
+/* Find the cache entry for the eos parameters, building it in the least
+ * recently used slot if it is not present */
+static LALInferenceEOSFamilyCacheEntry *LALInferenceEOSFamilyCacheLookup(LALInferenceEOSFamilyCache *cache, LALInferenceEOSParameterisation type, REAL8 eosParams[4]){
+  LALInferenceEOSFamilyCacheEntry *entry = NULL;
+  UINT4 i;
 
-// Calculate speed of sound and max and min mass allowed by eos
-double min_mass_kg = XLALSimNeutronStarFamMinimumMass(fam);
-double max_mass_kg = XLALSimNeutronStarMaximumMass(fam);
-double pmax = XLALSimNeutronStarCentralPressure(max_mass_kg, fam);
-double hmax = XLALSimNeutronStarEOSPseudoEnthalpyOfPressure(pmax, eos);
-double vsmax = XLALSimNeutronStarEOSSpeedOfSoundGeometerized(hmax, eos);
-
-// Read in max observed NS mass, which eos must support
-REAL8 ns_max_mass = 0.;
-if(LALInferenceGetProcParamVal(commandLine,"--ns-max-mass")) {
-  ns_max_mass= atof(LALInferenceGetProcParamVal(commandLine,"--ns-max-mass")->value);
-}
-// If none, then set max to proposed mass, since EOS must support this mass anyway
-else{
-  ns_max_mass = mass2;
+  cache->clock++;
+  for(i=0;i<cache->size;i++){
+    LALInferenceEOSFamilyCacheEntry *e = &cache->entries[i];
+    if(e->type==type && !memcmp(e->eosParams, eosParams, sizeof(e->eosParams))){
+      e->lastUsed = cache->clock;
+      cache->hits++;
+      return e;
+    }
+    if(!entry || e->lastUsed < entry->lastUsed)
+      entry = e;
+  }
+
+  cache->misses++;
+  LALInferenceClearEOSFamilyCacheEntry(entry);
+  entry->type = type;
+  memcpy(entry->eosParams, eosParams, sizeof(entry->eosParams));
+  entry->lastUsed = cache->clock;
+  entry->eos = LALInferenceMakeEOS(type, eosParams);
+  if(entry->eos){
+    entry->turnoverOK = LALInferenceEOSTurnoverCheck(entry->eos) == XLAL_SUCCESS;
+    // The family cannot be built if the mass turns over too soon
+    if(entry->turnoverOK)
+      entry->fam = XLALCreateSimNeutronStarFamily(entry->eos);
+  }
+  if(entry->fam){
+    entry->min_mass_kg = XLALSimNeutronStarFamMinimumMass(entry->fam);
+    entry->max_mass_kg = XLALSimNeutronStarMaximumMass(entry->fam);
+    entry->vsmax = LALInferenceEOSMaxMassSpeedOfSound(entry->eos, entry->fam);
+  }
+  return entry;
 }
 
-// If m1 and m2 are supported by min and max mass allowed by eos
-// and if the speed of sound is less than 1.1c (the 0.1 is some wiggle room, since eos is not exact)
-// and if the max-mass NS is supported
-if(mass1_kg <= max_mass_kg && mass2_kg <= max_mass_kg && mass1_kg >= min_mass_kg && mass2_kg >= min_mass_kg && vsmax <= 1.1 && max_mass_kg >= ns_max_mass*LAL_MSUN_SI){
-  ret=XLAL_SUCCESS;
-// Else fail
-}else{
-  ret=XLAL_FAILURE;
+int LALInferenceEOSPhysicalCheckCached(LALInferenceEOSFamilyCache *cache, LALInferenceVariables *params, ProcessParamsTable *commandLine){
+  REAL8 eosParams[4];
+  LALInferenceEOSParameterisation type;
+
+  if(!cache)
+    return LALInferenceEOSPhysicalCheck(params, commandLine);
+
+  type = LALInferenceGetEOSParams(params, eosParams);
+  if(type==LALINFERENCE_EOS_NONE) {
+    fprintf(stdout,"NO EOS PARAMETERS FOUND\n");
+    return XLAL_FAILURE;
+  }
+
+  LALInferenceEOSFamilyCacheEntry *entry = LALInferenceEOSFamilyCacheLookup(cache, type, eosParams);
+  if(!entry->eos)
+    return XLAL_FAILURE;
+  if(!entry->turnoverOK){
+    fprintf(stdout,"EOS has too few points. Sample rejected.\n");
+    if(type==LALINFERENCE_EOS_SPECTRAL)
+      fprintf(stdout,"spectral: %f %f %f %f\n",eosParams[0],eosParams[1],eosParams[2],eosParams[3]);
+    return XLAL_FAILURE;
+  }
+  if(!entry->fam)
+    return XLAL_FAILURE;
+
+  return LALInferenceEOSFamilyCheck(params, commandLine, entry->min_mass_kg, entry->max_mass_kg, entry->vsmax);
 }
 
-// Clean up
-XLALDestroySimNeutronStarFamily(fam);
-XLALDestroySimNeutronStarEOS(eos);
-return ret;
+void LALInferenceEOSFamilyCacheCounts(const LALInferenceEOSFamilyCache *cache, UINT8 *hits, UINT8 *misses){
+  if(hits) *hits = cache ? cache->hits : 0;
+  if(misses) *misses = cache ? cache->misses : 0;
+}
+
+int LALInferenceEOSMasses2LambdasCached(LALInferenceEOSFamilyCache *cache, LALInferenceVariables *params, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
+  REAL8 eosParams[4];
+  LALInferenceEOSParameterisation type;
+
+  *lambda1 = 0.;
+  *lambda2 = 0.;
+  if(!cache) XLAL_ERROR(XLAL_EFAULT, "NULL EOS family cache");
+  type = LALInferenceGetEOSParams(params, eosParams);
+  if(type==LALINFERENCE_EOS_NONE) XLAL_ERROR(XLAL_EINVAL, "No EOS parameters found");
+
+  LALInferenceEOSFamilyCacheEntry *entry = LALInferenceEOSFamilyCacheLookup(cache, type, eosParams);
+  // If unreasonable gammas, do not find lambdas
+  if(!entry->fam)
+    return XLAL_SUCCESS;
+
+  // Calculate lambda1,2(m1,2|eos)
+  if(XLALSimNeutronStarTidalProperties(NULL, NULL, lambda1, mass1*LAL_MSUN_SI, entry->fam) != XLAL_SUCCESS
+     || XLALSimNeutronStarTidalProperties(NULL, NULL, lambda2, mass2*LAL_MSUN_SI, entry->fam) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+  return XLAL_SUCCESS;
 }
 
 
@@ -4246,82 +4554,228 @@ void LALInferenceSetstringVariable(LALInferenceVariables* vars,const char* name,
   LALInferenceSetVariable(vars,name,&value);
 }
 
-int LALInferenceSplineCalibrationFactor(REAL8Vector *logfreqs,
-					REAL8Vector *deltaAmps,
-					REAL8Vector *deltaPhases,
-					COMPLEX16FrequencySeries *calFactor) {
-  size_t i = 0;
-  gsl_interp_accel *ampAcc = NULL, *phaseAcc = NULL;
-  gsl_interp *ampInterp = NULL, *phaseInterp = NULL;
+void LALInferenceDestroyModel(LALInferenceModel *model, UINT4 nifo)
+{
+  if (!model) return;
 
-  int status = XLAL_SUCCESS;
-  const char *fmt = "";
+  if (model->params) {
+    LALInferenceClearVariables(model->params);
+    XLALFree(model->params);
+  }
 
-  size_t N = 0;
+  XLALFree(model->ifo_loglikelihoods);
+  XLALFree(model->ifo_SNRs);
+  XLALFree(model->ifo_fPlus);
+  XLALFree(model->ifo_fCross);
+  XLALFree(model->ifo_timeshifts);
 
-  if (logfreqs == NULL || deltaAmps == NULL || deltaPhases == NULL || calFactor == NULL) {
-    status = XLAL_EINVAL;
-    fmt = "bad input";
-    goto cleanup;
+  XLALDestroyREAL8TimeSeries(model->timehPlus);
+  XLALDestroyREAL8TimeSeries(model->timehCross);
+  XLALDestroyCOMPLEX16FrequencySeries(model->freqhPlus);
+  XLALDestroyCOMPLEX16FrequencySeries(model->freqhCross);
+  if (model->freqhs) {
+    for (UINT4 i = 0; i < nifo; i++)
+      XLALDestroyCOMPLEX16FrequencySeries(model->freqhs[i]);
+    XLALFree(model->freqhs);
   }
 
-  if (logfreqs->length != deltaAmps->length || deltaAmps->length != deltaPhases->length) {
-    status = XLAL_EINVAL;
-    fmt = "input lengths differ";
-    goto cleanup;
+  if (model->spcal) {
+    for (UINT4 i = 0; i < 2 * nifo; i++)
+      LALInferenceDestroySplineCalibration(model->spcal[i]);
+    XLALFree(model->spcal);
   }
 
-  N = logfreqs->length;
+  XLALDestroyDict(model->LALpars);
+  XLALDestroySimInspiralWaveformCache(model->waveformCache);
+  XLALDestroySimBurstWaveformCache(model->burstWaveformCache);
+  XLALDestroySimNeutronStarFamily(model->eos_fam);
+  LALInferenceDestroyEOSFamilyCache(model->eos_cache);
 
-  ampInterp = gsl_interp_alloc(gsl_interp_cspline, N);
-  phaseInterp = gsl_interp_alloc(gsl_interp_cspline, N);
+  XLALFree(model);
+}
 
-  if (ampInterp == NULL || phaseInterp == NULL) {
-    status = XLAL_ENOMEM;
-    fmt = "could not allocate GSL interpolation objects";
-    goto cleanup;
-  }
+/*
+ * Precomputed natural cubic spline kernel.  With the node abscissae x_k
+ * fixed, the spline value at x in [x_k, x_{k+1}] is
+ *   A y_k + B y_{k+1} + C M_k + D M_{k+1}
+ * where A, B, C, D depend only on x and the second derivatives M = R y
+ * are a fixed linear map of the node values y.  This is the same spline
+ * as gsl_interp_cspline (natural boundary conditions, M_0 = M_{n-1} = 0).
+ */
+struct tagLALInferenceSplineCalibration {
+  UINT4 npts;          /* Number of spline nodes */
+  REAL8 *logfreqs;     /* Node log-frequencies the kernel was built for */
+  REAL8 *R;            /* npts x npts map from node values to second derivatives */
+  UINT4 length;        /* Number of output frequencies */
+  const REAL8 *freqs;  /* Output frequencies, or NULL for a uniform grid */
+  REAL8 deltaF;        /* Spacing of the uniform grid */
+  INT4 *idx;           /* Lower bracketing node of each frequency, -1 outside the nodes */
+  REAL8 *wA, *wB, *wC, *wD; /* Spline basis weights of each frequency */
+};
 
-  ampAcc = gsl_interp_accel_alloc();
-  phaseAcc = gsl_interp_accel_alloc();
+void LALInferenceDestroySplineCalibration(LALInferenceSplineCalibration *cal)
+{
+  if (!cal) return;
+  XLALFree(cal->logfreqs);
+  XLALFree(cal->R);
+  XLALFree(cal->idx);
+  XLALFree(cal->wA);
+  XLALFree(cal->wB);
+  XLALFree(cal->wC);
+  XLALFree(cal->wD);
+  XLALFree(cal);
+}
+
+LALInferenceSplineCalibration *LALInferenceCreateSplineCalibration(const REAL8 *logfreqs, UINT4 npts,
+                                                                   const REAL8 *freqs, REAL8 deltaF, UINT4 length)
+{
+  XLAL_CHECK_NULL(logfreqs != NULL, XLAL_EFAULT);
+  XLAL_CHECK_NULL(npts >= 3, XLAL_EINVAL, "Need at least 3 spline nodes, got %u", npts);
+  XLAL_CHECK_NULL(freqs != NULL || deltaF > 0, XLAL_EINVAL, "Need frequencies or a positive deltaF");
+  for (UINT4 k = 0; k + 1 < npts; k++)
+    XLAL_CHECK_NULL(logfreqs[k] < logfreqs[k+1], XLAL_EINVAL, "Spline nodes must be strictly increasing");
+
+  LALInferenceSplineCalibration *cal = XLALCalloc(1, sizeof(*cal));
+  XLAL_CHECK_NULL(cal != NULL, XLAL_ENOMEM);
+  cal->npts = npts;
+  cal->length = length;
+  cal->freqs = freqs;
+  cal->deltaF = deltaF;
+  cal->logfreqs = XLALMalloc(npts * sizeof(REAL8));
+  cal->R = XLALCalloc(npts * npts, sizeof(REAL8));
+  cal->idx = XLALMalloc((length ? length : 1) * sizeof(INT4));
+  cal->wA = XLALMalloc((length ? length : 1) * sizeof(REAL8));
+  cal->wB = XLALMalloc((length ? length : 1) * sizeof(REAL8));
+  cal->wC = XLALMalloc((length ? length : 1) * sizeof(REAL8));
+  cal->wD = XLALMalloc((length ? length : 1) * sizeof(REAL8));
+  if (!cal->logfreqs || !cal->R || !cal->idx || !cal->wA || !cal->wB || !cal->wC || !cal->wD) {
+    LALInferenceDestroySplineCalibration(cal);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  memcpy(cal->logfreqs, logfreqs, npts * sizeof(REAL8));
+
+  /* Columns of R: second derivatives of the spline through each unit
+   * vector, from the tridiagonal system for the interior nodes */
+  const UINT4 n = npts - 2;
+  REAL8 h[npts-1], diag[n], cp[n], rhs[n];
+  for (UINT4 k = 0; k + 1 < npts; k++)
+    h[k] = logfreqs[k+1] - logfreqs[k];
+  for (UINT4 j = 0; j < npts; j++) {
+    for (UINT4 i = 0; i < n; i++) {
+      /* Row i + 1 of 6 * (second difference of e_j) */
+      REAL8 r = 0;
+      if (j == i + 2) r += 6.0 / h[i+1];
+      if (j == i + 1) r -= 6.0 / h[i+1] + 6.0 / h[i];
+      if (j == i) r += 6.0 / h[i];
+      rhs[i] = r;
+    }
+    /* Thomas algorithm; the system is diagonally dominant */
+    for (UINT4 i = 0; i < n; i++) {
+      diag[i] = 2.0 * (h[i] + h[i+1]);
+      if (i > 0) {
+        const REAL8 m = h[i] / diag[i-1];
+        diag[i] -= m * cp[i-1];
+        rhs[i] -= m * rhs[i-1];
+      }
+      cp[i] = h[i+1];
+    }
+    for (UINT4 i = n; i-- > 0; ) {
+      if (i + 1 < n) rhs[i] -= cp[i] * rhs[i+1];
+      rhs[i] /= diag[i];
+      cal->R[(i + 1) * npts + j] = rhs[i];
+    }
+  }
 
-  if (ampAcc == NULL || phaseAcc == NULL) {
-    status = XLAL_ENOMEM;
-    fmt = "could not allocate interpolation acceleration objects";
-    goto cleanup;
+  /* Bracketing node and basis weights at each output frequency */
+  const REAL8 lowf = exp(logfreqs[0]);
+  const REAL8 highf = exp(logfreqs[npts-1]);
+  UINT4 k = 0;
+  for (UINT4 i = 0; i < length; i++) {
+    const REAL8 f = freqs ? freqs[i] : deltaF * i;
+    if (!(f >= lowf && f <= highf)) {
+      cal->idx[i] = -1;
+      cal->wA[i] = cal->wB[i] = cal->wC[i] = cal->wD[i] = 0;
+      continue;
+    }
+    const REAL8 x = log(f);
+    /* Frequencies are usually sorted, so start from the previous node */
+    if (x < logfreqs[k]) k = 0;
+    while (k + 2 < npts && x >= logfreqs[k+1]) k++;
+    const REAL8 A = (logfreqs[k+1] - x) / h[k];
+    const REAL8 B = 1.0 - A;
+    cal->idx[i] = k;
+    cal->wA[i] = A;
+    cal->wB[i] = B;
+    cal->wC[i] = (A*A*A - A) * h[k]*h[k] / 6.0;
+    cal->wD[i] = (B*B*B - B) * h[k]*h[k] / 6.0;
   }
 
-  gsl_interp_init(ampInterp, logfreqs->data, deltaAmps->data, N);
-  gsl_interp_init(phaseInterp, logfreqs->data, deltaPhases->data, N);
+  return cal;
+}
 
-  REAL8 lowf = exp(logfreqs->data[0]);
-  REAL8 highf = exp(logfreqs->data[N-1]);
-  for (i = 0; i < calFactor->data->length; i++) {
-    REAL8 dA = 0.0, dPhi = 0.0;
-    REAL8 f = calFactor->deltaF*i;
+int LALInferenceUpdateSplineCalibration(LALInferenceSplineCalibration **cal, const REAL8 *logfreqs, UINT4 npts,
+                                        const REAL8 *freqs, REAL8 deltaF, UINT4 length)
+{
+  XLAL_CHECK(cal != NULL, XLAL_EFAULT);
+  if (*cal && (*cal)->npts == npts && (*cal)->length == length && (*cal)->freqs == freqs
+      && (*cal)->deltaF == deltaF && memcmp((*cal)->logfreqs, logfreqs, npts * sizeof(REAL8)) == 0)
+    return XLAL_SUCCESS;
+  LALInferenceDestroySplineCalibration(*cal);
+  *cal = LALInferenceCreateSplineCalibration(logfreqs, npts, freqs, deltaF, length);
+  XLAL_CHECK(*cal != NULL, XLAL_EFUNC);
+  return XLAL_SUCCESS;
+}
 
-    if (f < lowf || f > highf) {
-      dA = 0.0;
-      dPhi = 0.0;
-    } else {
-      dA = gsl_interp_eval(ampInterp, logfreqs->data, deltaAmps->data, log(f), ampAcc);
-      dPhi = gsl_interp_eval(phaseInterp, logfreqs->data, deltaPhases->data, log(f), phaseAcc);
+int LALInferenceApplySplineCalibration(const LALInferenceSplineCalibration *cal,
+                                       const REAL8 *deltaAmps, const REAL8 *deltaPhases,
+                                       COMPLEX16 *calFactor)
+{
+  XLAL_CHECK(cal != NULL && deltaAmps != NULL && deltaPhases != NULL, XLAL_EFAULT);
+  XLAL_CHECK(calFactor != NULL || cal->length == 0, XLAL_EFAULT);
+  const UINT4 npts = cal->npts;
+
+  /* Second derivatives at the nodes */
+  REAL8 Ma[npts], Mp[npts];
+  for (UINT4 i = 0; i < npts; i++) {
+    REAL8 sa = 0, sp = 0;
+    for (UINT4 j = 0; j < npts; j++) {
+      sa += cal->R[i * npts + j] * deltaAmps[j];
+      sp += cal->R[i * npts + j] * deltaPhases[j];
     }
+    Ma[i] = sa;
+    Mp[i] = sp;
+  }
 
-    calFactor->data->data[i] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
+  /* (1 + dA) (2 + i dPhi) / (2 - i dPhi), without the complex division */
+  for (UINT4 i = 0; i < cal->length; i++) {
+    const INT4 k = cal->idx[i];
+    if (k < 0) {
+      calFactor[i] = 1.0;
+      continue;
+    }
+    const REAL8 dA = cal->wA[i] * deltaAmps[k] + cal->wB[i] * deltaAmps[k+1] + cal->wC[i] * Ma[k] + cal->wD[i] * Ma[k+1];
+    const REAL8 dPhi = cal->wA[i] * deltaPhases[k] + cal->wB[i] * deltaPhases[k+1] + cal->wC[i] * Mp[k] + cal->wD[i] * Mp[k+1];
+    const REAL8 scale = (1.0 + dA) / (4.0 + dPhi * dPhi);
+    calFactor[i] = crect(scale * (4.0 - dPhi * dPhi), scale * 4.0 * dPhi);
   }
 
- cleanup:
-  if (ampInterp != NULL) gsl_interp_free(ampInterp);
-  if (phaseInterp != NULL) gsl_interp_free(phaseInterp);
-  if (ampAcc != NULL) gsl_interp_accel_free(ampAcc);
-  if (phaseAcc != NULL) gsl_interp_accel_free(phaseAcc);
+  return XLAL_SUCCESS;
+}
 
-  if (status == XLAL_SUCCESS) {
-    return status;
-  } else {
-    XLAL_ERROR(status, "%s", fmt);
-  }
+int LALInferenceSplineCalibrationFactor(REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					COMPLEX16FrequencySeries *calFactor) {
+  XLAL_CHECK(logfreqs != NULL && deltaAmps != NULL && deltaPhases != NULL && calFactor != NULL, XLAL_EINVAL, "bad input");
+  XLAL_CHECK(logfreqs->length == deltaAmps->length && deltaAmps->length == deltaPhases->length, XLAL_EINVAL, "input lengths differ");
+
+  LALInferenceSplineCalibration *cal = LALInferenceCreateSplineCalibration(logfreqs->data, logfreqs->length,
+                                                                           NULL, calFactor->deltaF, calFactor->data->length);
+  XLAL_CHECK(cal != NULL, XLAL_EFUNC);
+  int status = LALInferenceApplySplineCalibration(cal, deltaAmps->data, deltaPhases->data, calFactor->data->data);
+  LALInferenceDestroySplineCalibration(cal);
+  XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC);
+  return XLAL_SUCCESS;
 }
 
 int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
@@ -4331,94 +4785,123 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					COMPLEX16Sequence **calFactorROQLin,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad) {
+  XLAL_CHECK(logfreqs != NULL && deltaAmps != NULL && deltaPhases != NULL && freqNodesLin != NULL, XLAL_EINVAL, "bad input");
+  XLAL_CHECK(logfreqs->length == deltaAmps->length && deltaAmps->length == deltaPhases->length
+             && freqNodesLin->length == (*calFactorROQLin)->length
+             && !(freqNodesQuad && freqNodesQuad->length != (*calFactorROQQuad)->length), XLAL_EINVAL, "input lengths differ");
 
-  gsl_interp_accel *ampAcc = NULL, *phaseAcc = NULL;
-  gsl_interp *ampInterp = NULL, *phaseInterp = NULL;
- 
-  int status = XLAL_SUCCESS;
-  const char *fmt = "";
-
-  size_t N = 0;
-  
-  /* should I check that calFactorROQ = NULL as well? */
-
-  if (logfreqs == NULL || deltaAmps == NULL || deltaPhases == NULL || freqNodesLin == NULL || freqNodesQuad == NULL) {
-    status = XLAL_EINVAL;
-    fmt = "bad input";
-    goto cleanup;
+  REAL8Sequence *nodes[2] = {freqNodesLin, freqNodesQuad};
+  COMPLEX16Sequence *factors[2] = {*calFactorROQLin, freqNodesQuad ? *calFactorROQQuad : NULL};
+  for (UINT4 i = 0; i < 2 && nodes[i]; i++) {
+    LALInferenceSplineCalibration *cal = LALInferenceCreateSplineCalibration(logfreqs->data, logfreqs->length,
+                                                                             nodes[i]->data, 0, nodes[i]->length);
+    XLAL_CHECK(cal != NULL, XLAL_EFUNC);
+    int status = LALInferenceApplySplineCalibration(cal, deltaAmps->data, deltaPhases->data, factors[i]->data);
+    LALInferenceDestroySplineCalibration(cal);
+    XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC);
   }
+  return XLAL_SUCCESS;
+}
 
-  if (logfreqs->length != deltaAmps->length || deltaAmps->length != deltaPhases->length || freqNodesLin->length != (*calFactorROQLin)->length || freqNodesQuad->length != (*calFactorROQQuad)->length) {
-    status = XLAL_EINVAL;
-    fmt = "input lengths differ";
-    goto cleanup;
-  }
-  
-  
-  N = logfreqs->length;
-
-  ampInterp = gsl_interp_alloc(gsl_interp_cspline, N);
-  phaseInterp = gsl_interp_alloc(gsl_interp_cspline, N);
-
-  if (ampInterp == NULL || phaseInterp == NULL) {
-    status = XLAL_ENOMEM;
-    fmt = "could not allocate GSL interpolation objects";
-    goto cleanup;
-  }
-
-  ampAcc = gsl_interp_accel_alloc();
-  phaseAcc = gsl_interp_accel_alloc();
-
-  if (ampAcc == NULL || phaseAcc == NULL) {
-    status = XLAL_ENOMEM;
-    fmt = "could not allocate interpolation acceleration objects";
-    goto cleanup;
+/*
+ * Locate timeshift on the uniform grid of the ROQ linear weights and
+ * compute the four-point Lagrange coefficients for time steps j-1 .. j+2.
+ */
+static int roq_lagrange_coefficients(const LALInferenceROQLinearWeights *weights, REAL8 timeshift, UINT4 *j0, REAL8 c[4])
+{
+  XLAL_CHECK(weights->n_times >= 4, XLAL_EINVAL, "Need at least 4 ROQ time steps, got %u", weights->n_times);
+  const REAL8 u = (timeshift - weights->t0) / weights->dt;
+  XLAL_CHECK(u >= 0 && u <= weights->n_times - 1, XLAL_EDOM, "Time shift %g outside the ROQ weights range [%g, %g]",
+             timeshift, weights->t0, weights->t0 + (weights->n_times - 1)*weights->dt);
+
+  /* Keep the stencil inside the table; near the ends this becomes an
+   * off-centre interpolation rather than an extrapolation */
+  INT4 j = (INT4) floor(u);
+  if (j < 1) j = 1;
+  if (j > (INT4) weights->n_times - 3) j = weights->n_times - 3;
+  const REAL8 x = u - j;
+
+  c[0] = -x*(x - 1.0)*(x - 2.0)/6.0;
+  c[1] = (x + 1.0)*(x - 1.0)*(x - 2.0)/2.0;
+  c[2] = -(x + 1.0)*x*(x - 2.0)/2.0;
+  c[3] = (x + 1.0)*x*(x - 1.0)/6.0;
+  *j0 = j - 1;
+  return XLAL_SUCCESS;
+}
+
+int LALInferenceROQLinearInnerProduct(COMPLEX16 *d_inner_h,
+                                      const LALInferenceROQLinearWeights *weights,
+                                      const COMPLEX16 *hplus,
+                                      const COMPLEX16 *hcross,
+                                      REAL8 Fplus,
+                                      REAL8 Fcross,
+                                      const COMPLEX16 *calFactor,
+                                      REAL8 timeshift)
+{
+  XLAL_CHECK(d_inner_h && weights && hplus && hcross, XLAL_EFAULT);
+
+  UINT4 j0;
+  REAL8 c[4];
+  XLAL_CHECK(roq_lagrange_coefficients(weights, timeshift, &j0, c) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  /* Interpolating the weights and summing over the nodes commute, so
+   * accumulate the inner product against each of the four rows and
+   * combine them at the end; every row is a contiguous run over nodes */
+  const UINT4 n = weights->n_nodes;
+  const COMPLEX16 *restrict w0 = weights->weights + (size_t) j0*n;
+  const COMPLEX16 *restrict w1 = w0 + n;
+  const COMPLEX16 *restrict w2 = w1 + n;
+  const COMPLEX16 *restrict w3 = w2 + n;
+  COMPLEX16 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+  if (calFactor) {
+    for (UINT4 i = 0; i < n; i++) {
+      const COMPLEX16 h = conj(calFactor[i]*(Fplus*hplus[i] + Fcross*hcross[i]));
+      s0 += w0[i]*h;
+      s1 += w1[i]*h;
+      s2 += w2[i]*h;
+      s3 += w3[i]*h;
+    }
+  } else {
+    for (UINT4 i = 0; i < n; i++) {
+      const COMPLEX16 h = conj(Fplus*hplus[i] + Fcross*hcross[i]);
+      s0 += w0[i]*h;
+      s1 += w1[i]*h;
+      s2 += w2[i]*h;
+      s3 += w3[i]*h;
+    }
   }
 
-  gsl_interp_init(ampInterp, logfreqs->data, deltaAmps->data, N);
-  gsl_interp_init(phaseInterp, logfreqs->data, deltaPhases->data, N);
+  *d_inner_h = c[0]*s0 + c[1]*s1 + c[2]*s2 + c[3]*s3;
+  return XLAL_SUCCESS;
+}
 
-  REAL8 lowf = exp(logfreqs->data[0]);
-  REAL8 highf = exp(logfreqs->data[N-1]);
-  REAL8 dA = 0.0, dPhi = 0.0;
-  
-  for (unsigned int i = 0; i < freqNodesLin->length; i++) {
-    REAL8 f = freqNodesLin->data[i];
-    if (f < lowf || f > highf) {
-      dA = 0.0;
-      dPhi = 0.0;
-    } else {
-      dA = gsl_interp_eval(ampInterp, logfreqs->data, deltaAmps->data, log(f), ampAcc);
-      dPhi = gsl_interp_eval(phaseInterp, logfreqs->data, deltaPhases->data, log(f), phaseAcc);
-    }
-    
-    (*calFactorROQLin)->data[i] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
-  }
-  
-  for (unsigned int j = 0; j < freqNodesQuad->length; j++) {
-    REAL8 f = freqNodesQuad->data[j];
-    if (f < lowf || f > highf) {
-      dA = 0.0;
-      dPhi = 0.0;
-    } else {
-      dA = gsl_interp_eval(ampInterp, logfreqs->data, deltaAmps->data, log(f), ampAcc);
-      dPhi = gsl_interp_eval(phaseInterp, logfreqs->data, deltaPhases->data, log(f), phaseAcc);
-    }
+int LALInferenceROQLinearWeightsAtTime(COMPLEX16 *out,
+                                       const LALInferenceROQLinearWeights *weights,
+                                       REAL8 timeshift)
+{
+  XLAL_CHECK(out && weights, XLAL_EFAULT);
 
-    (*calFactorROQQuad)->data[j] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
+  UINT4 j0;
+  REAL8 c[4];
+  XLAL_CHECK(roq_lagrange_coefficients(weights, timeshift, &j0, c) == XLAL_SUCCESS, XLAL_EFUNC);
 
-  }
+  const UINT4 n = weights->n_nodes;
+  const COMPLEX16 *restrict w0 = weights->weights + (size_t) j0*n;
+  const COMPLEX16 *restrict w1 = w0 + n;
+  const COMPLEX16 *restrict w2 = w1 + n;
+  const COMPLEX16 *restrict w3 = w2 + n;
+  for (UINT4 i = 0; i < n; i++)
+    out[i] = c[0]*w0[i] + c[1]*w1[i] + c[2]*w2[i] + c[3]*w3[i];
 
- cleanup:
-  if (ampInterp != NULL) gsl_interp_free(ampInterp);
-  if (phaseInterp != NULL) gsl_interp_free(phaseInterp);
-  if (ampAcc != NULL) gsl_interp_accel_free(ampAcc);
-  if (phaseAcc != NULL) gsl_interp_accel_free(phaseAcc);
+  return XLAL_SUCCESS;
+}
 
-  if (status == XLAL_SUCCESS) {
-    return status;
-  } else {
-    XLAL_ERROR(status, "%s", fmt);
+void LALInferenceDestroyROQLinearWeights(LALInferenceROQLinearWeights *weights)
+{
+  if (weights) {
+    XLALFree(weights->weights);
+    XLALFree(weights);
   }
 }
 
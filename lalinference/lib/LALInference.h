@@ -361,7 +361,8 @@ int LALInferenceSplineCalibrationFactor(REAL8Vector *freqs,
 
  /** Modified version of LALInferenceSplineCalibrationFactor to compute the 
  *	calibration factors for the specific frequency nodes used for 
- *	Reduced Order Quadrature likelihoods.
+ *	Reduced Order Quadrature likelihoods.  The quadratic nodes may be
+ *	NULL, in which case only the linear nodes are evaluated.
  */
 
 int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
@@ -372,6 +373,38 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad);
 
+/**
+ * Precomputed spline calibration model for one detector on a fixed set
+ * of frequencies.  For fixed node frequencies the spline through the
+ * node values is linear in those values, so the kernel caches the
+ * bracketing node and spline basis weights at every frequency; applying
+ * new node values then costs one small matrix-vector product and a few
+ * multiply-adds per frequency.  The results are those of
+ * LALInferenceSplineCalibrationFactor().
+ */
+typedef struct tagLALInferenceSplineCalibration LALInferenceSplineCalibration;
+
+/** Build a spline calibration kernel for \a npts nodes at \a logfreqs,
+ *  evaluated at the \a length frequencies \a freqs, or at
+ *  \f$i \Delta f\f$ when \a freqs is NULL.  \a freqs is referenced,
+ *  not copied, and must outlive the kernel.
+ */
+LALInferenceSplineCalibration *LALInferenceCreateSplineCalibration(const REAL8 *logfreqs, UINT4 npts,
+                                                                   const REAL8 *freqs, REAL8 deltaF, UINT4 length);
+
+/** Rebuild \a *cal if it is NULL or was built for different nodes or
+ *  frequencies; otherwise leave it untouched. */
+int LALInferenceUpdateSplineCalibration(LALInferenceSplineCalibration **cal, const REAL8 *logfreqs, UINT4 npts,
+                                        const REAL8 *freqs, REAL8 deltaF, UINT4 length);
+
+/** Compute the calibration factors for the node values \a deltaAmps and
+ *  \a deltaPhases into the \a length elements of \a calFactor. */
+int LALInferenceApplySplineCalibration(const LALInferenceSplineCalibration *cal,
+                                       const REAL8 *deltaAmps, const REAL8 *deltaPhases,
+                                       COMPLEX16 *calFactor);
+
+void LALInferenceDestroySplineCalibration(LALInferenceSplineCalibration *cal);
+
 
 //Wrapper for template computation
 //(relies on LAL libraries for implementation) <- could be a #DEFINE ?
@@ -438,6 +471,16 @@ tagLALInferenceIFOModel
   struct tagLALInferenceIFOModel *next; /** A pointer to the next set of parameters for linked list */
 } LALInferenceIFOModel;
 
+/**
+ * Least-recently-used cache of neutron star families, keyed on the sampled
+ * EOS parameters (4-piece polytrope or 4-coefficient spectral).  A cache is
+ * not thread-safe: use one per LALInferenceModel.
+ */
+typedef struct tagLALInferenceEOSFamilyCache LALInferenceEOSFamilyCache;
+
+/** Default number of EOS families held by the cache of each model */
+#define LALINFERENCE_EOS_FAMILY_CACHE_SIZE 8
+
 /**
  * Structure to constain a model and its parameters.
  */
@@ -453,6 +496,9 @@ typedef struct tagLALInferenceModel
   REAL8                        SNR; /** Network SNR at *params* */
   REAL8*                       ifo_loglikelihoods; /** Array of single-IFO likelihoods at *params* */
   REAL8*                       ifo_SNRs; /** Array of single-IFO SNRs at *params* */
+  REAL8*                       ifo_fPlus; /** Array of single-IFO plus-polarisation responses at *params* */
+  REAL8*                       ifo_fCross; /** Array of single-IFO cross-polarisation responses at *params* */
+  REAL8*                       ifo_timeshifts; /** Array of single-IFO template time shifts at *params* */
 
   REAL8                        fLow;   /** Start frequency for waveform generation */
   REAL8                        fHigh;   /** End frequency for waveform generation */
@@ -471,10 +517,23 @@ typedef struct tagLALInferenceModel
   REAL8                        padding; /** The padding of the above window */
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
+  struct tagLALInferenceRelBinModel *relbin; /** Relative binning template at the bin edges */
+  int relbin_flag;            /** Is relative binning enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  LALInferenceEOSFamilyCache  *eos_cache; /** Cache of families for sampled EOS parameters */
+  struct tagLALInferenceDistanceMargTable *distance_marg; /** Distance marginalisation table, shared between threads */
+  struct tagLALInferenceSplineCalibration **spcal; /** Spline calibration kernels, two per IFO, built on first use */
 
 } LALInferenceModel;
 
+/**
+ * Free a model and the buffers it owns, including its spline calibration
+ * kernels.  \a nifo is the number of IFOs its per-IFO arrays were allocated
+ * for.  The window, FFT plans, ROQ and relative binning data and distance
+ * marginalisation table are shared with the run state and are not freed.
+ */
+void LALInferenceDestroyModel(LALInferenceModel *model, UINT4 nifo);
+
 
 /**
  * Type declaration for variables init function, can be user-declared.
@@ -542,6 +601,33 @@ tagLALInferenceProposalCycle
     LALInferenceVariables *proposalArgs; /** Storage for arguments needed by proposal functions (e.g. number of detectors) */
 } LALInferenceProposalCycle;
 
+/**
+ * Fixed-capacity history of chain samples for differential evolution.
+ *
+ * Each point is stored as a packed vector of the non-fixed REAL8 parameters,
+ * in the order they appear in the parameters the buffer was created from.
+ * The memory is allocated once; when the buffer fills up every other point
+ * is dropped and the thinning interval \c skip doubles, so the buffer always
+ * holds an evenly thinned, time-ordered history of the chain.
+ *
+ * Only the owning chain may add to or clear the buffer, but any number of
+ * other chains may draw from it concurrently without locking: appended points
+ * are published through \c length, and thinning or clearing is bracketed by
+ * \c generation, which is odd while the stored points are being rearranged.
+ * Readers that see \c generation change retry their draw.
+ */
+typedef struct
+tagLALInferenceDEBuffer
+{
+    UINT4 dim; /** Number of parameters in each point */
+    char **names; /** Names of the stored parameters */
+    UINT4 capacity; /** Maximum number of points held */
+    UINT4 length; /** Number of points currently held */
+    UINT4 skip; /** Number of accumulated samples per stored point */
+    UINT4 generation; /** Incremented before and after points are rearranged */
+    REAL8 *points; /** capacity x dim block of stored points */
+} LALInferenceDEBuffer;
+
 /**
  * Structure containing chain-specific variables
  */
@@ -574,6 +660,8 @@ tagLALInferenceThreadState
                                         Can also be removed. */
     size_t differentialPointsSkip; /** When the DE buffer gets too long, start storing
                                        only every n-th output point; this counter stores n */
+    LALInferenceDEBuffer *deBuffer; /** Packed differential evolution history; when set it
+                                        replaces differentialPoints for the DE proposals */
     REAL8 *currentIFOSNRs; /** Array storing single-IFO SNRs of current sample */
     REAL8 *currentIFOLikelihoods; /** Array storing single-IFO likelihoods of current sample */
     REAL8 currentSNR; /** Array storing network SNR of current sample */
@@ -665,6 +753,7 @@ tagLALInferenceIFOData
   UINT4                     likeli_counter; /** counts how many time the likelihood has been calculated */
   UINT4                     templa_counter; /** counts how many time the template has been calculated */
   struct tagLALInferenceROQData *roq; /** ROQ data */
+  struct tagLALInferenceRelBinData *relbin; /** Relative binning summary data */
 
   struct tagLALInferenceIFOData      *next;     /** A pointer to the next set of data for linked list */
 } LALInferenceIFOData;
@@ -681,7 +770,7 @@ tagLALInferenceROQData
   FILE *weightsFileQuadratic;
 
 
-  struct tagLALInferenceROQSplineWeightsLinear *weights_linear;
+  struct tagLALInferenceROQLinearWeights *linear_weights; /** linear weights tabulated on a uniform time grid */
 
  
   /* Deprecated functions that should be removed at some point */ 
@@ -693,20 +782,51 @@ tagLALInferenceROQData
 } LALInferenceROQData;
 
 /**
- *  *  * Structure to contain spline of ROQ weights as a function of tc
- *   *   */
-
+ * Structure to contain the ROQ linear weights as a function of the time
+ * shift.  The weights are tabulated on a uniform time grid and stored as a
+ * single contiguous matrix, time-major, so that all the nodes at one time
+ * step are adjacent in memory and can be interpolated together.
+ */
 typedef struct
-tagLALInferenceROQSplineWeightsLinear
+tagLALInferenceROQLinearWeights
 {
-  
- 
-  gsl_spline *spline_real_weight_linear;
-  gsl_spline *spline_imag_weight_linear; 
-  gsl_interp_accel *acc_real_weight_linear;
-  gsl_interp_accel *acc_imag_weight_linear;
+  UINT4 n_nodes; /** number of linear frequency nodes */
+  UINT4 n_times; /** number of time steps */
+  REAL8 t0; /** time shift of the first time step */
+  REAL8 dt; /** spacing of the time steps */
+  COMPLEX16 *weights; /** n_times x n_nodes matrix; weights[j*n_nodes + i] is node i at time step j */
+} LALInferenceROQLinearWeights;
+
+/**
+ * Compute the ROQ approximation to the complex inner product
+ * \f$\sum_i w_i(t) \, h_i^*\f$ at time shift \c timeshift, where
+ * \f$h_i = c_i (F_+ h_{+,i} + F_\times h_{\times,i})\f$ at the linear frequency
+ * nodes and \f$c_i\f$ is the (optional, may be NULL) calibration factor.
+ * The weights are interpolated in time with four-point Lagrange
+ * interpolation, which is fused with the sum over nodes.  Returns
+ * XLAL_EDOM if \c timeshift lies outside the tabulated range.
+ */
+int LALInferenceROQLinearInnerProduct(COMPLEX16 *d_inner_h,
+                                      const LALInferenceROQLinearWeights *weights,
+                                      const COMPLEX16 *hplus,
+                                      const COMPLEX16 *hcross,
+                                      REAL8 Fplus,
+                                      REAL8 Fcross,
+                                      const COMPLEX16 *calFactor,
+                                      REAL8 timeshift);
+
+/**
+ * Interpolate the ROQ linear weights to time shift \c timeshift, filling
+ * \c out with \c weights->n_nodes values.  For use by likelihoods, such as
+ * time-marginalised ones, that reuse the weights at one time for several
+ * templates.
+ */
+int LALInferenceROQLinearWeightsAtTime(COMPLEX16 *out,
+                                       const LALInferenceROQLinearWeights *weights,
+                                       REAL8 timeshift);
 
-} LALInferenceROQSplineWeights;
+/** Free a LALInferenceROQLinearWeights structure */
+void LALInferenceDestroyROQLinearWeights(LALInferenceROQLinearWeights *weights);
 /**
  *  * Structure to contain model-related Reduced Order Quadrature quantities
  *   */
@@ -740,6 +860,39 @@ tagLALInferenceROQModel
 
 } LALInferenceROQModel;
 
+/**
+ * Structure to contain model-related relative binning quantities.
+ * The template is generated only at the bin edges, and the likelihood is
+ * computed from its ratio to a fiducial waveform, which is assumed to vary
+ * linearly in frequency across each bin (Zackay, Dai & Venumadhav 2018).
+ */
+typedef struct
+tagLALInferenceRelBinModel
+{
+  REAL8Sequence *binEdges; /** frequencies of the bin edges, which lie on the data frequency grid */
+  COMPLEX16FrequencySeries *hptilde; /** plus polarisation at the bin edges */
+  COMPLEX16FrequencySeries *hctilde; /** cross polarisation at the bin edges */
+  COMPLEX16Sequence *calFactor; /** calibration factor at the bin edges */
+  REAL8 epsilon; /** maximum allowed phase difference across a bin, in radians */
+} LALInferenceRelBinModel;
+
+/**
+ * Structure to contain data-related relative binning quantities: the
+ * fiducial waveform at the bin edges, and the summary data
+ * \f$A_0, A_1, B_0, B_1\f$ of each bin, which are the zeroth and first
+ * frequency moments of \f$\langle d|h_0\rangle\f$ and \f$\langle h_0|h_0\rangle\f$
+ * about the bin centre.
+ */
+typedef struct
+tagLALInferenceRelBinData
+{
+  COMPLEX16Sequence *fiducial; /** projected fiducial strain at the bin edges */
+  COMPLEX16Sequence *A0; /** per-bin zeroth moment of <d|h0> */
+  COMPLEX16Sequence *A1; /** per-bin first moment of <d|h0> */
+  REAL8Sequence *B0; /** per-bin zeroth moment of <h0|h0> */
+  REAL8Sequence *B1; /** per-bin first moment of <h0|h0> */
+} LALInferenceRelBinData;
+
 /**
  * Structure to contain data-related Reduced Order Quadrature quantities
  */
@@ -851,6 +1004,61 @@ void LALInferenceSortVariablesByName(LALInferenceVariables *vars);
 INT4 LALInferenceThinnedBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray, INT4 step);
 INT4 LALInferenceBufferToArray(LALInferenceThreadState *thread, REAL8** DEarray);
 
+/** Number of points in the differential evolution history of \a thread */
+size_t LALInferenceDifferentialPointsLength(const LALInferenceThreadState *thread);
+
+/**
+ * Create a differential evolution buffer holding up to \a capacity points of
+ * the non-fixed REAL8 parameters in \a params, storing one point per \a skip
+ * accumulated samples.  \a capacity must be at least 2.
+ */
+LALInferenceDEBuffer *LALInferenceCreateDEBuffer(LALInferenceVariables *params, UINT4 capacity, UINT4 skip);
+
+/** Free a differential evolution buffer */
+void LALInferenceDestroyDEBuffer(LALInferenceDEBuffer *buffer);
+
+/**
+ * Store the non-fixed REAL8 parameters of \a params at the end of \a buffer,
+ * first thinning the buffer by a factor of two if it is full.  Must only be
+ * called by the chain owning the buffer.
+ */
+int LALInferenceDEBufferAdd(LALInferenceDEBuffer *buffer, LALInferenceVariables *params);
+
+/** Empty \a buffer and restart it with thinning interval \a skip */
+void LALInferenceDEBufferClear(LALInferenceDEBuffer *buffer, UINT4 skip);
+
+/** Number of points currently in \a buffer; safe to call from any chain */
+UINT4 LALInferenceDEBufferLength(const LALInferenceDEBuffer *buffer);
+
+/**
+ * Draw two distinct points from \a buffer into \a ptI and \a ptJ, each of
+ * length \a buffer->dim.  Safe to call from any chain while the owner adds
+ * points, and does not allocate.  Returns the number of points the draw was
+ * made from, or 0 (leaving \a ptI and \a ptJ untouched) if there were fewer
+ * than two.
+ */
+UINT4 LALInferenceDEBufferDrawPair(const LALInferenceDEBuffer *buffer, gsl_rng *rng, REAL8 *ptI, REAL8 *ptJ);
+
+/**
+ * Draw \a n distinct points from \a buffer into \a pts[0], ..., \a pts[n-1],
+ * each of length \a buffer->dim, with the same guarantees as
+ * LALInferenceDEBufferDrawPair().  Returns the number of points the draw was
+ * made from, or 0 if there were fewer than \a n (or fewer than two).
+ */
+UINT4 LALInferenceDEBufferDrawPoints(const LALInferenceDEBuffer *buffer, gsl_rng *rng, UINT4 n, REAL8 **pts);
+
+/** Index of parameter \a name within the points of \a buffer, or -1 if it is not stored */
+INT4 LALInferenceDEBufferIndex(const LALInferenceDEBuffer *buffer, const char *name);
+
+/**
+ * Copy every \a step-th point of \a buffer into the rows of \a DEarray and
+ * return the number of rows written.  Must only be called by the owning chain.
+ */
+INT4 LALInferenceDEBufferToArray(const LALInferenceDEBuffer *buffer, REAL8 **DEarray, INT4 step);
+
+/** Set the parameters of \a vars stored in \a buffer to the values of point \a i */
+void LALInferenceDEBufferPointToVariables(const LALInferenceDEBuffer *buffer, UINT4 i, LALInferenceVariables *vars);
+
 /** LALInference variables to an array, and vica versa */
 void LALInferenceCopyVariablesToArray(LALInferenceVariables *origin, REAL8 *target);
 
@@ -895,6 +1103,30 @@ void LALInferenceSDGammasMasses2Lambdas(REAL8 gamma[], REAL8 mass1, REAL8 mass2,
 /** Check for causality violation and mass conflict given masses and eos */
 int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine);
 
+/** Create a cache holding up to \a size neutron star families */
+LALInferenceEOSFamilyCache *LALInferenceCreateEOSFamilyCache(UINT4 size);
+
+/** Free a neutron star family cache */
+void LALInferenceDestroyEOSFamilyCache(LALInferenceEOSFamilyCache *cache);
+
+/**
+ * As LALInferenceEOSPhysicalCheck(), but the EOS, its family, and the
+ * mass-independent parts of the check are taken from \a cache, building
+ * them only for EOS parameters not seen recently.  Falls back to
+ * LALInferenceEOSPhysicalCheck() if \a cache is NULL.
+ */
+int LALInferenceEOSPhysicalCheckCached(LALInferenceEOSFamilyCache *cache, LALInferenceVariables *params, ProcessParamsTable *commandLine);
+
+/** Number of lookups in \a cache which found, or had to build, their family */
+void LALInferenceEOSFamilyCacheCounts(const LALInferenceEOSFamilyCache *cache, UINT8 *hits, UINT8 *misses);
+
+/**
+ * Calculate lambda1,2(m1,2|eos) for the EOS parameters in \a params
+ * (either parameterisation) using the family held in \a cache.
+ * The lambdas are zero if the spectral parameters are unreasonable.
+ */
+int LALInferenceEOSMasses2LambdasCached(LALInferenceEOSFamilyCache *cache, LALInferenceVariables *params, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2);
+
 /** Specral decomposition of eos's adiabatic index */
 double AdiabaticIndex(double gamma[],double x, int size);
 
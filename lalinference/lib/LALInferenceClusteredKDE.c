@@ -46,6 +46,11 @@
 #define omp ignore
 #endif
 
+/* Clusters with at least this many samples are evaluated through a KDE tree,
+ * with densities accurate to the given relative tolerance */
+#define KMEANS_KDE_TREE_MIN_NPTS 1024
+#define KMEANS_KDE_TREE_TOLERANCE 1e-4
+
 
 
 /**
@@ -1220,7 +1225,9 @@ void euclidean_centroid(gsl_vector *centroid, gsl_matrix *data, INT4 *mask) {
  *
  * Given the current clustering, estimate the distribution of each cluster
  * using a kernel density estimator.  This will be used to evaluate the Bayes
- * Information Criteria when deciding the optimal clustering.
+ * Information Criteria when deciding the optimal clustering.  Large clusters
+ * are given a KDE tree, so that evaluating their density does not require a
+ * pass over every sample in the cluster.
  * @param kmeans The kmeans to estimate the cluster distributions of.
  */
 void LALInferenceKmeansBuildKDE(LALInferenceKmeans *kmeans) {
@@ -1232,10 +1239,73 @@ void LALInferenceKmeansBuildKDE(LALInferenceKmeans *kmeans) {
     for (i = 0; i < kmeans->k; i++) {
         LALInferenceKmeansConstructMask(kmeans, kmeans->mask, i);
         kmeans->KDEs[i] = LALInferenceNewKDEfromMat(kmeans->data, kmeans->mask);
+
+        if (kmeans->KDEs[i]->npts >= KMEANS_KDE_TREE_MIN_NPTS &&
+                LALInferenceKDEBuildTree(kmeans->KDEs[i], KMEANS_KDE_TREE_TOLERANCE) != XLAL_SUCCESS) {
+            fprintf(stderr, "ERROR: Unable to build KDE tree.\n");
+            exit(-1);
+        }
     }
 }
 
 
+/**
+ * Add a sample to the kernel density estimates of a kmeans clustering.
+ *
+ * The sample is whitened as the clustered data were, assigned to the nearest
+ *  centroid, and added to the KDE of that cluster with
+ *  LALInferenceKDEAddPoint(), without reclustering or retuning any bandwidth.
+ *  The cluster weights are updated to the new cluster sizes.  The clustered
+ *  data itself is left as is.
+ * @param kmeans The kmeans clustering to add the sample to.
+ * @param pt     Array containing the (unwhitened) sample.
+ * @return XLAL_SUCCESS, or an XLAL error code on failure.
+ */
+INT4 LALInferenceKmeansAddPoint(LALInferenceKmeans *kmeans, REAL8 *pt) {
+    INT4 j;
+    INT4 best_cluster = 0;
+    REAL8 best_dist = INFINITY;
+    INT4 total = 0;
+
+    XLAL_CHECK(kmeans != NULL, XLAL_EFAULT);
+    XLAL_CHECK(pt != NULL, XLAL_EFAULT);
+
+    if (kmeans->KDEs == NULL)
+        LALInferenceKmeansBuildKDE(kmeans);
+
+    /* Whiten a local copy of the point */
+    gsl_vector *y = gsl_vector_alloc(kmeans->dim);
+    XLAL_CHECK(y != NULL, XLAL_ENOMEM);
+    gsl_vector_view pt_view = gsl_vector_view_array(pt, kmeans->dim);
+    gsl_vector_memcpy(y, &pt_view.vector);
+    gsl_vector_sub(y, kmeans->mean);
+    gsl_vector_div(y, kmeans->std);
+
+    /* Find the closest centroid */
+    for (j = 0; j < kmeans->k; j++) {
+        gsl_vector_view c = gsl_matrix_row(kmeans->centroids, j);
+        REAL8 dist = kmeans->dist(y, &c.vector);
+
+        if (dist < best_dist) {
+            best_cluster = j;
+            best_dist = dist;
+        }
+    }
+
+    INT4 status = LALInferenceKDEAddPoint(kmeans->KDEs[best_cluster], y->data);
+    gsl_vector_free(y);
+    XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC);
+
+    /* Reweight the clusters by their sizes */
+    for (j = 0; j < kmeans->k; j++)
+        total += kmeans->KDEs[j]->npts;
+    for (j = 0; j < kmeans->k; j++)
+        kmeans->weights[j] = (REAL8)(kmeans->KDEs[j]->npts) / (REAL8)total;
+
+    return XLAL_SUCCESS;
+}
+
+
 /**
  * Calculate max likelihood of a kmeans assuming spherical Gaussian clusters.
  *
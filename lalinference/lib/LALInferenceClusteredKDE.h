@@ -139,6 +139,9 @@ void euclidean_centroid(gsl_vector *centroid, gsl_matrix *data, INT4 *mask);
 /* Build the kernel density estimate from a kmeans clustering. */
 void LALInferenceKmeansBuildKDE(LALInferenceKmeans *kmeans);
 
+/* Add a sample to the kernel density estimates of a kmeans clustering. */
+INT4 LALInferenceKmeansAddPoint(LALInferenceKmeans *kmeans, REAL8 *pt);
+
 /* Calculate the maximum likelihood of a given kmeans assuming spherical Gaussian clusters. */
 REAL8 LALInferenceKmeansMaxLogL(LALInferenceKmeans *kmeans);
 
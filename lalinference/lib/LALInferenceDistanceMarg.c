@@ -7,7 +7,11 @@
 
 #include "LALInferenceDistanceMarg.h"
 #include <math.h>
+#include <string.h>
 #include <gsl/gsl_integration.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+#include <lal/distance_integrator.h>
 
 
 struct integrand_args
@@ -39,3 +43,143 @@ double dist_snr_pdf(double dL, void *args)
 	return result;
 }
 
+
+struct tagLALInferenceDistanceMargTable
+{
+    double dist_min, dist_max, pmax;
+    int cosmology, margphi;
+    size_t size;
+    double log_norm;  /* log of the prior normalisation */
+    double *samples;  /* size x size table underlying the integrator */
+    log_radial_integrator *integrator;
+};
+
+/* Identifies the file format; bump the trailing digit if it changes */
+static const char dist_marg_table_magic[8] = {'L','A','L','D','M','A','R','1'};
+
+static LALInferenceDistanceMargTable *dist_marg_table_from_samples(double *samples, double dist_min, double dist_max, int cosmology, int margphi, double pmax, size_t size)
+{
+    LALInferenceDistanceMargTable *table = XLALCalloc(1, sizeof(*table));
+    XLAL_CHECK_NULL(table, XLAL_ENOMEM);
+    table->dist_min = dist_min;
+    table->dist_max = dist_max;
+    table->pmax = pmax;
+    table->cosmology = cosmology;
+    table->margphi = margphi;
+    table->size = size;
+    table->samples = samples;
+    table->integrator = log_radial_integrator_init_from_samples(samples, dist_min, dist_max, 2, pmax, size);
+    if (!table->integrator)
+    {
+        LALInferenceDestroyDistanceMargTable(table);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    table->log_norm = log_radial_integrator_eval(table->integrator, 0, 0, -INFINITY, -INFINITY);
+    return table;
+}
+
+LALInferenceDistanceMargTable *LALInferenceCreateDistanceMargTable(double dist_min, double dist_max, int cosmology, int margphi, double pmax, size_t size)
+{
+    XLAL_CHECK_NULL(dist_min > 0 && dist_max > dist_min, XLAL_EDOM, "Invalid distance range [%g, %g]", dist_min, dist_max);
+    XLAL_CHECK_NULL(pmax > 0 && size >= 4, XLAL_EINVAL);
+
+    double *samples = XLALMalloc(size * size * sizeof(*samples));
+    XLAL_CHECK_NULL(samples, XLAL_ENOMEM);
+    if (log_radial_integrator_samples(samples, dist_min, dist_max, 2, cosmology, pmax, size, !margphi) != XLAL_SUCCESS)
+    {
+        XLALFree(samples);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    return dist_marg_table_from_samples(samples, dist_min, dist_max, cosmology, margphi, pmax, size);
+}
+
+void LALInferenceDestroyDistanceMargTable(LALInferenceDistanceMargTable *table)
+{
+    if (table)
+    {
+        log_radial_integrator_free(table->integrator);
+        XLALFree(table->samples);
+        XLALFree(table);
+    }
+}
+
+int LALInferenceWriteDistanceMargTable(const LALInferenceDistanceMargTable *table, const char *fname)
+{
+    XLAL_CHECK(table && fname, XLAL_EFAULT);
+    FILE *fp = fopen(fname, "wb");
+    XLAL_CHECK(fp, XLAL_EIO, "Cannot open %s for writing", fname);
+
+    const INT4 flags[2] = {table->cosmology, table->margphi};
+    const UINT8 size = table->size;
+    const double range[3] = {table->dist_min, table->dist_max, table->pmax};
+    int ok = fwrite(dist_marg_table_magic, sizeof(dist_marg_table_magic), 1, fp) == 1
+        && fwrite(range, sizeof(range), 1, fp) == 1
+        && fwrite(flags, sizeof(flags), 1, fp) == 1
+        && fwrite(&size, sizeof(size), 1, fp) == 1
+        && fwrite(table->samples, sizeof(*table->samples), size * size, fp) == size * size;
+    ok = (fclose(fp) == 0) && ok;
+    XLAL_CHECK(ok, XLAL_EIO, "Error writing distance marginalisation table to %s", fname);
+    return XLAL_SUCCESS;
+}
+
+LALInferenceDistanceMargTable *LALInferenceReadDistanceMargTable(const char *fname)
+{
+    XLAL_CHECK_NULL(fname, XLAL_EFAULT);
+    FILE *fp = fopen(fname, "rb");
+    XLAL_CHECK_NULL(fp, XLAL_EIO, "Cannot open %s for reading", fname);
+
+    char magic[sizeof(dist_marg_table_magic)];
+    INT4 flags[2];
+    UINT8 size = 0;
+    double range[3];
+    double *samples = NULL;
+    int ok = fread(magic, sizeof(magic), 1, fp) == 1
+        && memcmp(magic, dist_marg_table_magic, sizeof(magic)) == 0
+        && fread(range, sizeof(range), 1, fp) == 1
+        && fread(flags, sizeof(flags), 1, fp) == 1
+        && fread(&size, sizeof(size), 1, fp) == 1
+        && size >= 4 && size <= 65536;
+    if (ok)
+    {
+        samples = XLALMalloc(size * size * sizeof(*samples));
+        ok = samples && fread(samples, sizeof(*samples), size * size, fp) == size * size;
+    }
+    fclose(fp);
+    if (!ok)
+    {
+        XLALFree(samples);
+        XLAL_ERROR_NULL(XLAL_EIO, "%s is not a valid distance marginalisation table", fname);
+    }
+    return dist_marg_table_from_samples(samples, range[0], range[1], flags[0], flags[1], range[2], size);
+}
+
+LALInferenceDistanceMargTable *LALInferenceGetDistanceMargTable(const char *fname, double dist_min, double dist_max, int cosmology, int margphi, double pmax, size_t size)
+{
+    LALInferenceDistanceMargTable *table = NULL;
+    FILE *fp = fname ? fopen(fname, "rb") : NULL;
+    if (fp)
+    {
+        fclose(fp);
+        table = LALInferenceReadDistanceMargTable(fname);
+        XLAL_CHECK_NULL(table, XLAL_EFUNC);
+        if (table->dist_min == dist_min && table->dist_max == dist_max && table->pmax == pmax
+            && table->size == size && table->cosmology == cosmology && table->margphi == margphi)
+            return table;
+        XLAL_PRINT_WARNING("Distance marginalisation table in %s was built with different settings; rebuilding it", fname);
+        LALInferenceDestroyDistanceMargTable(table);
+    }
+
+    table = LALInferenceCreateDistanceMargTable(dist_min, dist_max, cosmology, margphi, pmax, size);
+    XLAL_CHECK_NULL(table, XLAL_EFUNC);
+    if (fname)
+        XLAL_CHECK_NULL(LALInferenceWriteDistanceMargTable(table, fname) == XLAL_SUCCESS, XLAL_EFUNC);
+    return table;
+}
+
+double LALInferenceDistanceMargTableLogLikelihood(const LALInferenceDistanceMargTable *table, double OptimalSNR, double d_inner_h)
+{
+    XLAL_CHECK_REAL8(table, XLAL_EFAULT);
+    if (isnan(OptimalSNR) || isnan(d_inner_h) || table->pmax < OptimalSNR)
+        XLAL_ERROR_REAL8(XLAL_ERANGE, "warning: Optimal SNR %lf exceeded pmax %lf\n", OptimalSNR, table->pmax);
+    return log_radial_integrator_eval(table->integrator, OptimalSNR, d_inner_h, log(OptimalSNR), log(d_inner_h)) - table->log_norm;
+}
@@ -21,4 +21,52 @@ double dist_integral(double rho_opt, double rho_match, double dist_min, double d
 
 double dist_snr_pdf(double dL, void *args);
 
+/** Default largest optimal SNR supported by distance marginalisation tables */
+#define LALINFERENCE_DISTANCE_MARG_PMAX 100000.0
+
+/** Default number of samples along each axis of distance marginalisation tables */
+#define LALINFERENCE_DISTANCE_MARG_SIZE 2000
+
+/**
+ * Precomputed lookup table for the distance-marginalised likelihood, as a
+ * function of the optimal SNR and the matched-filter SNR at unit distance.
+ * The table is immutable once built, so one table may be shared between
+ * threads and models.  It can be written to disk and read back so that runs
+ * with the same distance prior skip its construction.
+ */
+typedef struct tagLALInferenceDistanceMargTable LALInferenceDistanceMargTable;
+
+/**
+ * Build a distance marginalisation table for a prior \f$p(D) \propto D^2\f$
+ * between \c dist_min and \c dist_max (Mpc), or uniform in comoving volume
+ * if \c cosmology is non-zero.  If \c margphi is non-zero the likelihood is
+ * also marginalised over phase.  \c pmax is the largest optimal SNR
+ * supported and \c size the number of samples along each axis.
+ */
+LALInferenceDistanceMargTable *LALInferenceCreateDistanceMargTable(double dist_min, double dist_max, int cosmology, int margphi, double pmax, size_t size);
+
+/** Free a distance marginalisation table */
+void LALInferenceDestroyDistanceMargTable(LALInferenceDistanceMargTable *table);
+
+/** Write a distance marginalisation table to a binary file */
+int LALInferenceWriteDistanceMargTable(const LALInferenceDistanceMargTable *table, const char *fname);
+
+/** Read a distance marginalisation table written by LALInferenceWriteDistanceMargTable() */
+LALInferenceDistanceMargTable *LALInferenceReadDistanceMargTable(const char *fname);
+
+/**
+ * Read a distance marginalisation table from \c fname if it exists and was
+ * built with the same arguments, otherwise build it and, if \c fname is not
+ * NULL, write it there for later runs.
+ */
+LALInferenceDistanceMargTable *LALInferenceGetDistanceMargTable(const char *fname, double dist_min, double dist_max, int cosmology, int margphi, double pmax, size_t size);
+
+/**
+ * Evaluate the log of the distance-marginalised likelihood, normalised by
+ * the prior, for optimal SNR \c OptimalSNR and matched-filter SNR
+ * \c d_inner_h of a template at unit distance.  Fails with XLAL_ERANGE if
+ * the SNR lies outside the table.
+ */
+double LALInferenceDistanceMargTableLogLikelihood(const LALInferenceDistanceMargTable *table, double OptimalSNR, double d_inner_h);
+
 #endif /* LALInferenceDistanceMarg_h */
@@ -22,9 +22,16 @@
 #include <lal/H5FileIO.h>
 #include <lal/LALVCSInfoType.h>
 #include <lal/LALInferenceHDF5.h>
+#include <lal/LALConfig.h>
+#include <lal/LALString.h>
+#include <lal/LALStdio.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
 
 const char LALInferenceHDF5PosteriorSamplesDatasetName[] = "posterior_samples";
 const char LALInferenceHDF5NestedSamplesDatasetName[] = "nested_samples";
@@ -208,30 +215,21 @@ int LALInferenceH5DatasetToVariablesArray(
 }
 
 
-int LALInferenceH5VariablesArrayToDataset(
-    LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
-    const char *TableName)
+/* Resolve the table layout of a set of variables: non-fixed variables become
+ * columns, and fixed variables are listed in fixed_names to become attributes.
+ * All arrays must have room for vars->dimension entries.  Returns the size of
+ * one row. */
+static size_t LALInferenceH5ResolveColumns(
+    LALInferenceVariables *vars, const char **column_names,
+    LALTYPECODE *column_types, size_t *column_sizes, size_t *column_offsets,
+    int *vary, UINT4 *Nvary, char **fixed_names, UINT4 *Nfixed)
 {
-    /* Sanity check input */
-    if (!varsArray)
-        XLAL_ERROR(XLAL_EFAULT, "Received null varsArray pointer");
-    if (!h5file)
-        XLAL_ERROR(XLAL_EFAULT, "Received null h5file pointer");
-    if (N == 0)
-        return 0;
-
-    const char *column_names[varsArray[0]->dimension];
-    UINT4 Nvary = 0;
     size_t type_size = 0;
-    size_t column_offsets[varsArray[0]->dimension];
-    size_t column_sizes[varsArray[0]->dimension];
-    LALTYPECODE column_types[varsArray[0]->dimension];
-    char *fixed_names[varsArray[0]->dimension];
-    int vary[varsArray[0]->dimension];
-    UINT4 Nfixed = 0;
+    *Nvary = 0;
+    *Nfixed = 0;
 
     /* Build a list of PARAM and FIELD elements */
-    for (LALInferenceVariableItem *varitem = varsArray[0]->head; varitem;
+    for (LALInferenceVariableItem *varitem = vars->head; varitem;
          varitem = varitem->next)
     {
         switch(varitem->vary)
@@ -263,22 +261,77 @@ int LALInferenceH5VariablesArrayToDataset(
                             varitem->type, varitem->name);
                         continue;
                 } /* End switch */
-                vary[Nvary] = varitem->vary;
-                column_types[Nvary] = tp;
-                column_sizes[Nvary] = sz;
-                column_offsets[Nvary] = type_size;
+                vary[*Nvary] = varitem->vary;
+                column_types[*Nvary] = tp;
+                column_sizes[*Nvary] = sz;
+                column_offsets[*Nvary] = type_size;
                 type_size += sz;
-                column_names[Nvary++] = varitem->name;
+                column_names[(*Nvary)++] = varitem->name;
                 break;
             }
             case LALINFERENCE_PARAM_FIXED:
-                fixed_names[Nfixed++] = varitem->name;
+                fixed_names[(*Nfixed)++] = varitem->name;
                 break;
             default:
                 XLALPrintWarning("Unknown param vary type");
         }
     }
 
+    return type_size;
+}
+
+
+/* Label the columns of a table with their vary types, and attach the fixed
+ * variables of vars as attributes */
+static void LALInferenceH5LabelTable(
+    LALH5Dataset *dataset, LALInferenceVariables *vars, const int *vary,
+    UINT4 Nvary, char **fixed_names, UINT4 Nfixed)
+{
+    int ret;
+    (void) ret;
+
+    LALH5Generic gdataset = {.dset = dataset};
+    for (UINT4 i = 0; i < Nvary; i ++)
+    {
+        INT4 value = vary[i];
+        char pname[] = "FIELD_NNN_VARY";
+        snprintf(pname, sizeof(pname), "FIELD_%d_VARY", i);
+        ret = XLALH5AttributeAddScalar(
+            gdataset, pname, &value, LAL_I4_TYPE_CODE);
+        assert(ret == 0);
+    }
+
+    /* Write attributes, if any */
+    for (UINT4 i = 0; i < Nfixed; i++)
+        LALInferenceH5VariableToAttribute(gdataset, vars, fixed_names[i]);
+}
+
+
+int LALInferenceH5VariablesArrayToDataset(
+    LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
+    const char *TableName)
+{
+    /* Sanity check input */
+    if (!varsArray)
+        XLAL_ERROR(XLAL_EFAULT, "Received null varsArray pointer");
+    if (!h5file)
+        XLAL_ERROR(XLAL_EFAULT, "Received null h5file pointer");
+    if (N == 0)
+        return 0;
+
+    const char *column_names[varsArray[0]->dimension];
+    UINT4 Nvary = 0;
+    size_t column_offsets[varsArray[0]->dimension];
+    size_t column_sizes[varsArray[0]->dimension];
+    LALTYPECODE column_types[varsArray[0]->dimension];
+    char *fixed_names[varsArray[0]->dimension];
+    int vary[varsArray[0]->dimension];
+    UINT4 Nfixed = 0;
+
+    size_t type_size = LALInferenceH5ResolveColumns(
+        varsArray[0], column_names, column_types, column_sizes,
+        column_offsets, vary, &Nvary, fixed_names, &Nfixed);
+
     /* Gather together data in one big array */
     char *data = XLALCalloc(N, type_size);
     assert(data);
@@ -302,21 +355,8 @@ int LALInferenceH5VariablesArrayToDataset(
     assert(ret == 0);
     XLALFree(data);
 
-    LALH5Generic gdataset = {.dset = dataset};
-    for (UINT4 i = 0; i < Nvary; i ++)
-    {
-        INT4 value = vary[i];
-        char pname[] = "FIELD_NNN_VARY";
-        snprintf(pname, sizeof(pname), "FIELD_%d_VARY", i);
-        ret = XLALH5AttributeAddScalar(
-            gdataset, pname, &value, LAL_I4_TYPE_CODE);
-        assert(ret == 0);
-    }
-
-    /* Write attributes, if any */
-    for (UINT4 i = 0; i < Nfixed; i++)
-        LALInferenceH5VariableToAttribute(
-            gdataset, varsArray[0], fixed_names[i]);
+    LALInferenceH5LabelTable(
+        dataset, varsArray[0], vary, Nvary, fixed_names, Nfixed);
 
     XLALH5DatasetFree(dataset);
     return XLAL_SUCCESS;
@@ -347,3 +387,544 @@ static void LALInferenceH5VariableToAttribute(
     XLALH5AttributeAddScalar(
         gdataset, name, LALInferenceGetVariable(vars,name), laltype);
 }
+
+
+/*
+ * Appendable chain output.
+ *
+ * Each chain owns a ring buffer of packed rows.  Samplers pack rows at head,
+ * and rows in [tail, head) are appended to the chain's table, either by a
+ * background writer thread or, without pthread support, synchronously when
+ * the buffer fills.  head and tail only ever increase; a row's position in the
+ * ring is its count modulo the buffer length.
+ */
+
+typedef struct
+{
+    char *name;                     /* Name of the table */
+    UINT4 ncols;                    /* Number of columns */
+    char **cols;                    /* Column names */
+    LALTYPECODE *types;             /* Column types */
+    size_t *sizes;                  /* Column sizes */
+    size_t *offsets;                /* Column offsets within a row */
+    int *vary;                      /* Vary types of columns */
+    size_t rowsz;                   /* Size of a row */
+    LALInferenceVariables *first;   /* First sample, labels the table */
+    LALH5Dataset *table;            /* Table, once created */
+    char *ring;                     /* Buffered rows */
+    UINT8 head;                     /* Number of rows packed */
+    UINT8 tail;                     /* Number of rows written */
+    UINT4 resumed;                  /* Number of rows in the table when opened */
+    UINT4 flushed;                  /* Number of rows on disk at last flush */
+    UINT8 dropped;                  /* Number of rows that failed to write */
+} LALInferenceH5Chain;
+
+struct tagLALInferenceH5ChainOutput
+{
+    LALH5File *file;
+    LALH5File *group;
+    UINT4 nchains;
+    UINT4 length;
+    LALInferenceH5Chain *chains;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t work;            /* Signalled when rows are ready to write */
+    pthread_cond_t space;           /* Signalled when rows have been written */
+    int flush;
+    int stop;
+    int status;                     /* First error met by the writer */
+#endif
+};
+
+
+/* Resolve the column layout of a chain from its first sample */
+static int LALInferenceH5ChainLayout(
+    LALInferenceH5Chain *chain, const char *name, LALInferenceVariables *vars)
+{
+    const char *column_names[vars->dimension];
+    char *fixed_names[vars->dimension];
+    UINT4 Nfixed;
+
+    chain->types = XLALCalloc(vars->dimension, sizeof(LALTYPECODE));
+    chain->sizes = XLALCalloc(vars->dimension, sizeof(size_t));
+    chain->offsets = XLALCalloc(vars->dimension, sizeof(size_t));
+    chain->vary = XLALCalloc(vars->dimension, sizeof(int));
+    XLAL_CHECK(chain->types && chain->sizes && chain->offsets && chain->vary,
+               XLAL_ENOMEM);
+
+    chain->rowsz = LALInferenceH5ResolveColumns(
+        vars, column_names, chain->types, chain->sizes, chain->offsets,
+        chain->vary, &chain->ncols, fixed_names, &Nfixed);
+    XLAL_CHECK(chain->ncols > 0, XLAL_EINVAL,
+               "Sample for table %s has no columns", name);
+
+    chain->cols = XLALCalloc(chain->ncols, sizeof(char *));
+    XLAL_CHECK(chain->cols, XLAL_ENOMEM);
+    for (UINT4 j = 0; j < chain->ncols; j++)
+        chain->cols[j] = XLALStringDuplicate(column_names[j]);
+    chain->name = XLALStringDuplicate(name);
+
+    chain->first = XLALCalloc(1, sizeof(LALInferenceVariables));
+    XLAL_CHECK(chain->first, XLAL_ENOMEM);
+    LALInferenceCopyVariables(vars, chain->first);
+    return XLAL_SUCCESS;
+}
+
+
+/* Append the rows [tail, head) of a chain's buffer to its table */
+static int LALInferenceH5ChainWrite(
+    LALInferenceH5ChainOutput *output, LALInferenceH5Chain *chain,
+    UINT8 tail, UINT8 head)
+{
+    if (head == tail)
+        return XLAL_SUCCESS;
+
+    if (chain->table && chain->first)
+    {
+        /* A table reopened to resume must take the same rows */
+        XLAL_CHECK(XLALH5TableQueryNColumns(chain->table) == chain->ncols,
+                   XLAL_EINVAL, "Samples do not match the columns of table %s",
+                   chain->name);
+        LALInferenceClearVariables(chain->first);
+        XLALFree(chain->first);
+        chain->first = NULL;
+    }
+    else if (!chain->table)
+    {
+        char *fixed_names[chain->first->dimension];
+        UINT4 Nfixed = 0;
+        for (LALInferenceVariableItem *item = chain->first->head; item;
+             item = item->next)
+            if (item->vary == LALINFERENCE_PARAM_FIXED)
+                fixed_names[Nfixed++] = item->name;
+
+        chain->table = XLALH5TableAlloc(
+            output->group, chain->name, chain->ncols,
+            (const char **) chain->cols, chain->types, chain->offsets,
+            chain->rowsz);
+        XLAL_CHECK(chain->table, XLAL_EFUNC);
+        LALInferenceH5LabelTable(chain->table, chain->first, chain->vary,
+                                 chain->ncols, fixed_names, Nfixed);
+
+        LALInferenceClearVariables(chain->first);
+        XLALFree(chain->first);
+        chain->first = NULL;
+    }
+
+    /* The rows wrap around the end of the ring at most once */
+    size_t start = tail % output->length;
+    size_t n = head - tail;
+    size_t n1 = n < output->length - start ? n : output->length - start;
+    XLAL_CHECK(XLALH5TableAppend(
+        chain->table, chain->offsets, chain->sizes, n1, chain->rowsz,
+        chain->ring + start * chain->rowsz) == 0, XLAL_EFUNC);
+    if (n > n1)
+        XLAL_CHECK(XLALH5TableAppend(
+            chain->table, chain->offsets, chain->sizes, n - n1, chain->rowsz,
+            chain->ring) == 0, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+
+#ifdef LAL_PTHREAD_LOCK
+/* Background writer: append rows whenever a buffer is half full, or
+ * everything when a flush is requested */
+static void *LALInferenceH5ChainWriter(void *arg)
+{
+    LALInferenceH5ChainOutput *output = arg;
+    const UINT8 threshold = (output->length + 1) / 2;
+
+    pthread_mutex_lock(&output->lock);
+    for (;;)
+    {
+        int pending = 0;
+        for (UINT4 c = 0; c < output->nchains; c++)
+        {
+            UINT8 n = output->chains[c].head - output->chains[c].tail;
+            if (n >= threshold || (output->flush && n > 0))
+                pending = 1;
+        }
+
+        if (!pending)
+        {
+            if (output->stop)
+                break;
+            pthread_cond_wait(&output->work, &output->lock);
+            continue;
+        }
+
+        for (UINT4 c = 0; c < output->nchains; c++)
+        {
+            LALInferenceH5Chain *chain = &output->chains[c];
+            UINT8 tail = chain->tail, head = chain->head;
+            if (head == tail)
+                continue;
+
+            pthread_mutex_unlock(&output->lock);
+            int errnum;
+            XLAL_TRY(LALInferenceH5ChainWrite(output, chain, tail, head), errnum);
+            pthread_mutex_lock(&output->lock);
+
+            /* Rows that failed to write are dropped so that the samplers can
+             * never deadlock, but counted and reported to every later caller */
+            if (errnum != XLAL_SUCCESS)
+            {
+                chain->dropped += head - tail;
+                if (output->status == XLAL_SUCCESS)
+                    output->status = errnum;
+            }
+            chain->tail = head;
+            pthread_cond_broadcast(&output->space);
+        }
+    }
+    pthread_mutex_unlock(&output->lock);
+
+    return NULL;
+}
+#endif
+
+
+/* Free an output whose writer thread is not running */
+static void LALInferenceH5ChainOutputFree(LALInferenceH5ChainOutput *output)
+{
+    if (!output)
+        return;
+    for (UINT4 c = 0; output->chains && c < output->nchains; c++)
+    {
+        LALInferenceH5Chain *ch = &output->chains[c];
+        if (ch->table)
+            XLALH5DatasetFree(ch->table);
+        if (ch->first)
+        {
+            LALInferenceClearVariables(ch->first);
+            XLALFree(ch->first);
+        }
+        for (UINT4 j = 0; j < ch->ncols; j++)
+            XLALFree(ch->cols[j]);
+        XLALFree(ch->cols);
+        XLALFree(ch->types);
+        XLALFree(ch->sizes);
+        XLALFree(ch->offsets);
+        XLALFree(ch->vary);
+        XLALFree(ch->name);
+        XLALFree(ch->ring);
+    }
+    XLALFree(output->chains);
+    if (output->group)
+        XLALH5FileClose(output->group);
+    if (output->file)
+        XLALH5FileClose(output->file);
+    XLALFree(output);
+}
+
+
+/* Open the existing file \a filename to append to its /codename/runID/
+ * group, with no chains started */
+static LALInferenceH5ChainOutput *LALInferenceH5ChainOutputAttach(
+    const char *filename, const char *codename, const char *runID,
+    UINT4 nchains, UINT4 buffer_length)
+{
+    LALInferenceH5ChainOutput *output = XLALCalloc(1, sizeof(*output));
+    XLAL_CHECK_NULL(output, XLAL_ENOMEM);
+    output->nchains = nchains;
+    output->length = buffer_length;
+    output->chains = XLALCalloc(nchains, sizeof(LALInferenceH5Chain));
+    XLAL_CHECK_FAIL(output->chains, XLAL_ENOMEM);
+
+    output->file = XLALH5FileOpen(filename, "a");
+    XLAL_CHECK_FAIL(output->file, XLAL_EFUNC);
+    {
+        char path[strlen(codename) + strlen(runID) + 2];
+        snprintf(path, sizeof(path), "%s/%s", codename, runID);
+        output->group = XLALH5GroupOpen(output->file, path);
+    }
+    XLAL_CHECK_FAIL(output->group, XLAL_EFUNC);
+
+    return output;
+
+XLAL_FAIL:
+    LALInferenceH5ChainOutputFree(output);
+    return NULL;
+}
+
+
+/* Start the background writer of an output */
+static int LALInferenceH5ChainOutputStart(LALInferenceH5ChainOutput *output)
+{
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_init(&output->lock, NULL);
+    pthread_cond_init(&output->work, NULL);
+    pthread_cond_init(&output->space, NULL);
+    output->status = XLAL_SUCCESS;
+    if (pthread_create(&output->writer, NULL, LALInferenceH5ChainWriter,
+                       output) != 0)
+    {
+        pthread_cond_destroy(&output->space);
+        pthread_cond_destroy(&output->work);
+        pthread_mutex_destroy(&output->lock);
+        XLAL_ERROR(XLAL_ESYS, "Could not start HDF5 writer thread");
+    }
+#else
+    (void)output;
+#endif
+    return XLAL_SUCCESS;
+}
+
+
+/**
+ * Create the output file \a filename, with the group structure
+ * /codename/runID/, and open it for appending the samples of \a nchains
+ * chains, each buffered in memory for up to \a buffer_length rows.
+ */
+LALInferenceH5ChainOutput *LALInferenceH5ChainOutputOpen(
+    const char *filename, const char *codename, const char *runID,
+    UINT4 nchains, UINT4 buffer_length)
+{
+    XLAL_CHECK_NULL(filename && codename && runID, XLAL_EFAULT);
+    XLAL_CHECK_NULL(nchains > 0 && buffer_length > 0, XLAL_EINVAL);
+
+    /* Create the file and its groups, then reopen it to append in place */
+    LALH5File *file = XLALH5FileOpen(filename, "w");
+    XLAL_CHECK_NULL(file, XLAL_EFUNC);
+    LALH5File *group = LALInferenceH5CreateGroupStructure(file, codename, runID);
+    if (!group)
+    {
+        XLALH5FileClose(file);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    XLALH5FileClose(group);
+    XLALH5FileClose(file);
+
+    LALInferenceH5ChainOutput *output = LALInferenceH5ChainOutputAttach(
+        filename, codename, runID, nchains, buffer_length);
+    XLAL_CHECK_NULL(output, XLAL_EFUNC);
+    if (LALInferenceH5ChainOutputStart(output) != XLAL_SUCCESS)
+    {
+        LALInferenceH5ChainOutputFree(output);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    return output;
+}
+
+
+/**
+ * Reopen the output file \a filename, written by
+ * LALInferenceH5ChainOutputOpen(), to carry on appending the samples of
+ * \a nchains chains.  The table \a names[c] of each chain c is kept in place
+ * but truncated to its first \a rows[c] rows, discarding any rows written
+ * after that point; later samples are appended after them.  Chains whose
+ * table does not exist yet start a new table, as for
+ * LALInferenceH5ChainOutputOpen().
+ */
+LALInferenceH5ChainOutput *LALInferenceH5ChainOutputResume(
+    const char *filename, const char *codename, const char *runID,
+    UINT4 nchains, UINT4 buffer_length, const char **names,
+    const UINT4 *rows)
+{
+    XLAL_CHECK_NULL(filename && codename && runID && names && rows,
+                    XLAL_EFAULT);
+    XLAL_CHECK_NULL(nchains > 0 && buffer_length > 0, XLAL_EINVAL);
+
+    LALInferenceH5ChainOutput *output = LALInferenceH5ChainOutputAttach(
+        filename, codename, runID, nchains, buffer_length);
+    XLAL_CHECK_NULL(output, XLAL_EFUNC);
+
+    for (UINT4 c = 0; c < nchains; c++)
+    {
+        LALInferenceH5Chain *ch = &output->chains[c];
+        if (!XLALH5FileCheckDatasetExists(output->group, names[c]))
+            continue;
+        ch->table = XLALH5DatasetRead(output->group, names[c]);
+        XLAL_CHECK_FAIL(ch->table, XLAL_EFUNC);
+        size_t nrows = XLALH5TableQueryNRows(ch->table);
+        XLAL_CHECK_FAIL(nrows != (size_t)(-1), XLAL_EFUNC);
+        if (rows[c] < nrows)
+        {
+            XLAL_CHECK_FAIL(XLALH5TableTruncate(ch->table, rows[c]) == 0,
+                            XLAL_EFUNC, "Could not truncate table %s",
+                            names[c]);
+            nrows = rows[c];
+        }
+        ch->resumed = ch->flushed = nrows;
+    }
+    XLAL_CHECK_FAIL(XLALH5FileFlush(output->file) == 0, XLAL_EFUNC);
+
+    XLAL_CHECK_FAIL(LALInferenceH5ChainOutputStart(output) == XLAL_SUCCESS,
+                    XLAL_EFUNC);
+    return output;
+
+XLAL_FAIL:
+    LALInferenceH5ChainOutputFree(output);
+    return NULL;
+}
+
+
+/**
+ * Append a sample to the table \a name of chain \a chain.  The first sample
+ * of each chain fixes the columns of its table; every later sample must
+ * contain the same non-fixed variables.  Different chains may be appended to
+ * concurrently.
+ */
+int LALInferenceH5ChainOutputAppend(
+    LALInferenceH5ChainOutput *output, UINT4 chain, const char *name,
+    LALInferenceVariables *vars)
+{
+    XLAL_CHECK(output && name && vars, XLAL_EFAULT);
+    XLAL_CHECK(chain < output->nchains, XLAL_EINVAL,
+               "Chain %u out of range", chain);
+    LALInferenceH5Chain *ch = &output->chains[chain];
+
+    if (!ch->cols)
+    {
+        XLAL_CHECK(LALInferenceH5ChainLayout(ch, name, vars) == XLAL_SUCCESS,
+                   XLAL_EFUNC);
+        ch->ring = XLALMalloc(output->length * ch->rowsz);
+        XLAL_CHECK(ch->ring, XLAL_ENOMEM);
+    }
+
+    /* Wait for a free row */
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&output->lock);
+    while (ch->head - ch->tail == output->length)
+    {
+        pthread_cond_signal(&output->work);
+        pthread_cond_wait(&output->space, &output->lock);
+    }
+    int status = output->status;
+    UINT8 dropped = ch->dropped;
+    pthread_mutex_unlock(&output->lock);
+    XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC,
+               "Failed to write samples to HDF5 file (%s); %" LAL_UINT8_FORMAT
+               " samples of chain %u lost", XLALErrorString(status), dropped,
+               chain);
+#else
+    if (ch->head - ch->tail == output->length)
+    {
+        XLAL_CHECK(LALInferenceH5ChainWrite(output, ch, ch->tail, ch->head)
+                   == XLAL_SUCCESS, XLAL_EFUNC);
+        ch->tail = ch->head;
+    }
+#endif
+
+    char *row = ch->ring + (ch->head % output->length) * ch->rowsz;
+    for (UINT4 j = 0; j < ch->ncols; j++)
+    {
+        LALInferenceVariableItem *item = LALInferenceGetItem(vars, ch->cols[j]);
+        XLAL_CHECK(item, XLAL_EINVAL, "Sample for table %s has no column %s",
+                   ch->name, ch->cols[j]);
+        memcpy(row + ch->offsets[j], item->value, ch->sizes[j]);
+    }
+
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&output->lock);
+    ch->head++;
+    if (ch->head - ch->tail >= (output->length + 1) / 2)
+        pthread_cond_signal(&output->work);
+    pthread_mutex_unlock(&output->lock);
+#else
+    ch->head++;
+#endif
+
+    return XLAL_SUCCESS;
+}
+
+
+/**
+ * Write all buffered samples and flush the output file to disk, so that it
+ * is complete and readable.  No samples may be appended during the flush.
+ * Fails if any sample could not be written since the output was opened;
+ * once that happens, every later append and flush fails as well.
+ */
+int LALInferenceH5ChainOutputFlush(LALInferenceH5ChainOutput *output)
+{
+    XLAL_CHECK(output, XLAL_EFAULT);
+
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&output->lock);
+    output->flush = 1;
+    pthread_cond_signal(&output->work);
+    for (UINT4 c = 0; c < output->nchains; c++)
+        while (output->chains[c].head != output->chains[c].tail)
+            pthread_cond_wait(&output->space, &output->lock);
+    output->flush = 0;
+    int status = output->status;
+    UINT8 dropped = 0;
+    for (UINT4 c = 0; c < output->nchains; c++)
+        dropped += output->chains[c].dropped;
+    pthread_mutex_unlock(&output->lock);
+    XLAL_CHECK(status == XLAL_SUCCESS, XLAL_EFUNC,
+               "Failed to write samples to HDF5 file (%s); %" LAL_UINT8_FORMAT
+               " samples lost", XLALErrorString(status), dropped);
+#else
+    for (UINT4 c = 0; c < output->nchains; c++)
+    {
+        LALInferenceH5Chain *ch = &output->chains[c];
+        XLAL_CHECK(LALInferenceH5ChainWrite(output, ch, ch->tail, ch->head)
+                   == XLAL_SUCCESS, XLAL_EFUNC);
+        ch->tail = ch->head;
+    }
+#endif
+
+    for (UINT4 c = 0; c < output->nchains; c++)
+        output->chains[c].flushed = output->chains[c].resumed
+                                    + output->chains[c].head;
+    XLAL_CHECK(XLALH5FileFlush(output->file) == 0, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+
+/**
+ * Number of samples of chain \a chain on disk as of the last call to
+ * LALInferenceH5ChainOutputFlush(), including those kept by
+ * LALInferenceH5ChainOutputResume().
+ */
+UINT4 LALInferenceH5ChainOutputLength(
+    LALInferenceH5ChainOutput *output, UINT4 chain)
+{
+    XLAL_CHECK_VAL(0, output, XLAL_EFAULT);
+    XLAL_CHECK_VAL(0, chain < output->nchains, XLAL_EINVAL);
+    return output->chains[chain].flushed;
+}
+
+
+/**
+ * The /codename/runID/ group of the output file, for adding metadata.
+ */
+LALH5File *LALInferenceH5ChainOutputGroup(LALInferenceH5ChainOutput *output)
+{
+    XLAL_CHECK_NULL(output, XLAL_EFAULT);
+    return output->group;
+}
+
+
+/**
+ * Flush and close the output file, and free \a output.
+ */
+int LALInferenceH5ChainOutputClose(LALInferenceH5ChainOutput *output)
+{
+    if (!output)
+        return XLAL_SUCCESS;
+
+    int errnum;
+    XLAL_TRY(LALInferenceH5ChainOutputFlush(output), errnum);
+
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&output->lock);
+    output->stop = 1;
+    pthread_cond_signal(&output->work);
+    pthread_mutex_unlock(&output->lock);
+    pthread_join(output->writer, NULL);
+    pthread_cond_destroy(&output->space);
+    pthread_cond_destroy(&output->work);
+    pthread_mutex_destroy(&output->lock);
+#endif
+
+    LALInferenceH5ChainOutputFree(output);
+
+    XLAL_CHECK(errnum == XLAL_SUCCESS, XLAL_EFUNC, "Failed to flush HDF5 file");
+    return XLAL_SUCCESS;
+}
@@ -48,6 +48,40 @@ int LALInferenceH5DatasetToVariablesArray(
 LALH5File *LALInferenceH5CreateGroupStructure(
     LALH5File *h5file, const char *codename, const char *runID);
 
+/**
+ * Appendable HDF5 output for the samples of one or more chains.
+ *
+ * Samples are packed as binary rows into a ring buffer per chain, with a
+ * column layout resolved once from the first sample of each chain, and
+ * appended to chunked tables in a file that is modified in place.  When LAL is
+ * built with pthread support the tables are written by a background thread,
+ * so samplers only wait if a buffer fills faster than it can be written.  The
+ * tables have the same layout as those of LALInferenceH5VariablesArrayToDataset().
+ */
+typedef struct tagLALInferenceH5ChainOutput LALInferenceH5ChainOutput;
+
+LALInferenceH5ChainOutput *LALInferenceH5ChainOutputOpen(
+    const char *filename, const char *codename, const char *runID,
+    UINT4 nchains, UINT4 buffer_length);
+
+LALInferenceH5ChainOutput *LALInferenceH5ChainOutputResume(
+    const char *filename, const char *codename, const char *runID,
+    UINT4 nchains, UINT4 buffer_length, const char **names,
+    const UINT4 *rows);
+
+int LALInferenceH5ChainOutputAppend(
+    LALInferenceH5ChainOutput *output, UINT4 chain, const char *name,
+    LALInferenceVariables *vars);
+
+int LALInferenceH5ChainOutputFlush(LALInferenceH5ChainOutput *output);
+
+UINT4 LALInferenceH5ChainOutputLength(
+    LALInferenceH5ChainOutput *output, UINT4 chain);
+
+LALH5File *LALInferenceH5ChainOutputGroup(LALInferenceH5ChainOutput *output);
+
+int LALInferenceH5ChainOutputClose(LALInferenceH5ChainOutput *output);
+
 extern const char LALInferenceHDF5PosteriorSamplesDatasetName[];
 extern const char LALInferenceHDF5NestedSamplesDatasetName[];
 
@@ -225,6 +225,9 @@ void LALInferenceInitCBCThreads(LALInferenceRunState *run_state, INT4 nthreads)
     /* Set up CBC model and parameter array */
     thread->model = LALInferenceInitCBCModel(run_state);
     thread->model->roq_flag = 0;
+    thread->model->relbin = NULL;
+    thread->model->relbin_flag = 0;
+    thread->model->distance_marg = NULL;
 
     /* Allocate IFO likelihood holders */
     nifo = 0;
@@ -930,6 +933,7 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
+  model->eos_cache = LALInferenceCreateEOSFamilyCache(LALINFERENCE_EOS_FAMILY_CACHE_SIZE);
 
   UINT4 signal_flag=1;
   ppt = LALInferenceGetProcParamVal(commandLine, "--noiseonly");
@@ -1630,6 +1634,9 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   /* Choose proper template */
   model->templt = LALInferenceInitCBCTemplate(state);
@@ -1678,6 +1685,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence(LALInferenceRunState *sta
     /* Create arrays for holding single-IFO likelihoods, etc. */
     model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
     model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
 	i=0;
 
@@ -1724,6 +1734,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_bimod(LALInferenceRunStat
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
@@ -1769,6 +1782,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_banana(LALInferenceRunSta
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include <gsl/gsl_randist.h>
@@ -41,6 +42,41 @@
 #define omp ignore
 #endif
 
+/* Number of samples held by a leaf of the KDE ball tree before it is split */
+#define KDE_TREE_LEAF_SIZE 16
+
+/**
+ * Node of a ball tree over the whitened samples of a KDE.  Internal nodes
+ *  keep their centre fixed once built, and only grow their radius as samples
+ *  are inserted, so the bound always encloses every sample below the node.
+ */
+typedef struct tagKDETreeNode {
+    INT4 npts;                      /**< Number of samples below this node */
+    REAL8 *centre;                  /**< Centre of the bounding ball */
+    REAL8 radius;                   /**< Radius of the bounding ball */
+    INT4 *idx;                      /**< Indices of samples (leaves only) */
+    INT4 size;                      /**< Allocated length of \a idx */
+    struct tagKDETreeNode *left;    /**< Child nodes (NULL for leaves) */
+    struct tagKDETreeNode *right;
+} KDETreeNode;
+
+/**
+ * Ball tree of the samples of a KDE, in coordinates whitened by the kernel
+ *  covariance so that every kernel is a unit spherical Gaussian.
+ */
+struct tagKDETree {
+    INT4 dim;                       /**< Dimension of samples */
+    INT4 npts;                      /**< Number of whitened samples */
+    INT4 size;                      /**< Allocated rows of \a whitened */
+    REAL8 *whitened;                /**< Whitened samples, row-major */
+    REAL8 tolerance;                /**< Maximum relative error of evaluations */
+    KDETreeNode *root;              /**< Root of the tree (NULL if not built) */
+};
+
+static void kde_tree_clear(struct tagKDETree *tree);
+static INT4 kde_tree_populate(LALInferenceKDE *kde);
+static REAL8 kde_tree_log_sum(LALInferenceKDE *kde, const REAL8 *point);
+
 
 
 /**
@@ -193,13 +229,20 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
         gsl_matrix_free(kde->cholesky_decomp_cov_lower);
         gsl_matrix_free(kde->cov);
 
-        if (kde->npts > 0) gsl_matrix_free(kde->data);
+        if (kde->buffer) gsl_matrix_free(kde->buffer);
+        else if (kde->npts > 0) gsl_matrix_free(kde->data);
 
         XLALFree(kde->lower_bound_types);
         XLALFree(kde->upper_bound_types);
         XLALFree(kde->lower_bounds);
         XLALFree(kde->upper_bounds);
 
+        if (kde->tree) {
+            kde_tree_clear(kde->tree);
+            XLALFree(kde->tree->whitened);
+            XLALFree(kde->tree);
+        }
+
         XLALFree(kde);
     }
 }
@@ -250,6 +293,10 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     INT4 i, j;
     INT4 status;
 
+    /* Any existing tree is built in the old whitened coordinates */
+    if (kde->tree)
+        kde_tree_clear(kde->tree);
+
     /* If data set is empty, set the normalization to infinity */
     if (kde->npts == 0) {
         kde->log_norm_factor = INFINITY;
@@ -284,6 +331,11 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     kde->log_norm_factor =
         log(kde->npts * sqrt(pow(2*LAL_PI, kde->dim) * det_cov));
 
+    if (kde->tree && kde_tree_populate(kde) != XLAL_SUCCESS) {
+        fprintf(stderr, "ERROR: Unable to rebuild KDE tree.\n");
+        exit(-1);
+    }
+
     return;
 }
 
@@ -292,7 +344,9 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
  * Evaluate the (log) PDF from a KDE at a single point.
  *
  * Calculate the (log) value of the probability density function estimate from
- * a kernel density estimate at a single point.
+ * a kernel density estimate at a single point.  If a tree has been built with
+ * LALInferenceKDEBuildTree() the sum over kernels is approximated to within
+ * the tree's relative tolerance, otherwise every kernel is evaluated.
  * @param[in] kde   The kernel density estimate to evaluate.
  * @param[in] point An array containing the point to evaluate the PDF at.
  * @return The value of the estimated probability density function at \a point.
@@ -376,6 +430,12 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
     for (i = 0; i < n_evals; i++) {
         gsl_vector_view pt = gsl_matrix_row(points, i);
 
+        if (kde->tree && kde->tree->root) {
+            eval_results[i] =
+                kde_tree_log_sum(kde, pt.vector.data) - kde->log_norm_factor;
+            continue;
+        }
+
         /* Loop over points in KDE dataset, using the Cholesky decomposition
          * of the covariance to avoid ever inverting the covariance matrix */
         #pragma omp parallel
@@ -490,6 +550,381 @@ REAL8 *LALInferenceDrawKDESample(LALInferenceKDE *kde, gsl_rng *rng) {
 }
 
 
+/* Squared Euclidean distance between two whitened points */
+static REAL8 kde_tree_dist2(const REAL8 *x, const REAL8 *y, INT4 dim) {
+    REAL8 d2 = 0.;
+    for (INT4 k = 0; k < dim; k++)
+        d2 += (x[k] - y[k]) * (x[k] - y[k]);
+    return d2;
+}
+
+
+/* Whiten a point by the (lower) Cholesky factor of the kernel covariance */
+static void kde_tree_whiten(LALInferenceKDE *kde, const REAL8 *x, REAL8 *w) {
+    for (INT4 i = 0; i < kde->dim; i++) {
+        REAL8 val = x[i];
+        for (INT4 j = 0; j < i; j++)
+            val -= gsl_matrix_get(kde->cholesky_decomp_cov_lower, i, j) * w[j];
+        w[i] = val / gsl_matrix_get(kde->cholesky_decomp_cov_lower, i, i);
+    }
+}
+
+
+/* Partially order idx so that element k is the median along dimension d */
+static void kde_tree_select(const struct tagKDETree *tree, INT4 *idx, INT4 n, INT4 k, INT4 d) {
+    const REAL8 *w = tree->whitened;
+    const INT4 dim = tree->dim;
+    INT4 lo = 0, hi = n - 1;
+
+    while (lo < hi) {
+        REAL8 pivot = w[idx[(lo + hi) / 2]*dim + d];
+        INT4 i = lo, j = hi;
+        while (i <= j) {
+            while (w[idx[i]*dim + d] < pivot) i++;
+            while (w[idx[j]*dim + d] > pivot) j--;
+            if (i <= j) {
+                INT4 tmp = idx[i];
+                idx[i++] = idx[j];
+                idx[j--] = tmp;
+            }
+        }
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            break;
+    }
+}
+
+
+static void kde_tree_free_node(KDETreeNode *node) {
+    if (node) {
+        kde_tree_free_node(node->left);
+        kde_tree_free_node(node->right);
+        XLALFree(node->centre);
+        XLALFree(node->idx);
+        XLALFree(node);
+    }
+}
+
+
+/* Build a subtree over the samples indexed by idx, which is reordered */
+static KDETreeNode *kde_tree_build_node(const struct tagKDETree *tree, INT4 *idx, INT4 n) {
+    const INT4 dim = tree->dim;
+    INT4 i, k;
+
+    KDETreeNode *node = XLALCalloc(1, sizeof(KDETreeNode));
+    XLAL_CHECK_NULL(node != NULL, XLAL_ENOMEM);
+    node->npts = n;
+    node->centre = XLALCalloc(dim, sizeof(REAL8));
+    XLAL_CHECK_NULL(node->centre != NULL, XLAL_ENOMEM);
+
+    /* Centre the ball on the mean, and find the most extended dimension */
+    INT4 split = 0;
+    REAL8 widest = 0.;
+    for (k = 0; k < dim; k++) {
+        REAL8 min = INFINITY, max = -INFINITY;
+        for (i = 0; i < n; i++) {
+            REAL8 val = tree->whitened[idx[i]*dim + k];
+            node->centre[k] += val;
+            if (val < min) min = val;
+            if (val > max) max = val;
+        }
+        node->centre[k] /= n;
+        if (max - min > widest) {
+            widest = max - min;
+            split = k;
+        }
+    }
+
+    REAL8 max_d2 = 0.;
+    for (i = 0; i < n; i++) {
+        REAL8 d2 = kde_tree_dist2(node->centre, tree->whitened + idx[i]*dim, dim);
+        if (d2 > max_d2) max_d2 = d2;
+    }
+    node->radius = sqrt(max_d2);
+
+    /* Small or degenerate sets become leaves */
+    if (n <= KDE_TREE_LEAF_SIZE || widest == 0.) {
+        node->size = n > 2*KDE_TREE_LEAF_SIZE ? n : 2*KDE_TREE_LEAF_SIZE;
+        node->idx = XLALMalloc(node->size * sizeof(INT4));
+        XLAL_CHECK_NULL(node->idx != NULL, XLAL_ENOMEM);
+        memcpy(node->idx, idx, n * sizeof(INT4));
+        return node;
+    }
+
+    /* Otherwise split at the median of the most extended dimension */
+    kde_tree_select(tree, idx, n, n/2, split);
+    node->left = kde_tree_build_node(tree, idx, n/2);
+    node->right = kde_tree_build_node(tree, idx + n/2, n - n/2);
+    XLAL_CHECK_NULL(node->left != NULL && node->right != NULL, XLAL_EFUNC);
+
+    return node;
+}
+
+
+/* Insert whitened sample i below node, splitting leaves as they fill */
+static INT4 kde_tree_insert(const struct tagKDETree *tree, KDETreeNode *node, INT4 i) {
+    const INT4 dim = tree->dim;
+    const REAL8 *w = tree->whitened + i*dim;
+
+    for (;;) {
+        REAL8 r = sqrt(kde_tree_dist2(node->centre, w, dim));
+        if (r > node->radius)
+            node->radius = r;
+
+        if (node->left == NULL && node->npts == node->size) {
+            /* Rebuild a full leaf in place, growing it if it can't be split */
+            KDETreeNode *rebuilt = kde_tree_build_node(tree, node->idx, node->npts);
+            XLAL_CHECK(rebuilt != NULL, XLAL_EFUNC);
+            XLALFree(node->centre);
+            XLALFree(node->idx);
+            *node = *rebuilt;
+            XLALFree(rebuilt);
+
+            if (node->left == NULL) {
+                node->size *= 2;
+                node->idx = XLALRealloc(node->idx, node->size * sizeof(INT4));
+                XLAL_CHECK(node->idx != NULL, XLAL_ENOMEM);
+            }
+            r = sqrt(kde_tree_dist2(node->centre, w, dim));
+            if (r > node->radius)
+                node->radius = r;
+        }
+
+        node->npts++;
+        if (node->left == NULL) {
+            node->idx[node->npts - 1] = i;
+            return XLAL_SUCCESS;
+        }
+
+        /* Descend towards the nearer child */
+        if (kde_tree_dist2(node->left->centre, w, dim) <=
+                kde_tree_dist2(node->right->centre, w, dim))
+            node = node->left;
+        else
+            node = node->right;
+    }
+}
+
+
+static void kde_tree_clear(struct tagKDETree *tree) {
+    kde_tree_free_node(tree->root);
+    tree->root = NULL;
+    tree->npts = 0;
+}
+
+
+/* Whiten the samples of a KDE with tuned bandwidth and (re)build its tree */
+static INT4 kde_tree_populate(LALInferenceKDE *kde) {
+    struct tagKDETree *tree = kde->tree;
+    INT4 i;
+
+    kde_tree_clear(tree);
+
+    /* Without a valid kernel covariance there is nothing to whiten by */
+    if (kde->npts == 0 || isinf(kde->log_norm_factor))
+        return XLAL_SUCCESS;
+
+    if (tree->size < kde->npts) {
+        tree->size = kde->npts;
+        tree->whitened = XLALRealloc(tree->whitened, tree->size * tree->dim * sizeof(REAL8));
+        XLAL_CHECK(tree->whitened != NULL, XLAL_ENOMEM);
+    }
+
+    for (i = 0; i < kde->npts; i++) {
+        gsl_vector_view d = gsl_matrix_row(kde->data, i);
+        kde_tree_whiten(kde, d.vector.data, tree->whitened + i*tree->dim);
+    }
+    tree->npts = kde->npts;
+
+    INT4 *idx = XLALMalloc(kde->npts * sizeof(INT4));
+    XLAL_CHECK(idx != NULL, XLAL_ENOMEM);
+    for (i = 0; i < kde->npts; i++)
+        idx[i] = i;
+    tree->root = kde_tree_build_node(tree, idx, kde->npts);
+    XLALFree(idx);
+    XLAL_CHECK(tree->root != NULL, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+
+/* Running log(sum(exp(x))) that never overflows */
+typedef struct {
+    REAL8 max;
+    REAL8 sum;
+} KDELogSum;
+
+static void kde_log_sum_add(KDELogSum *acc, REAL8 x) {
+    if (x == -INFINITY)
+        return;
+    if (x <= acc->max) {
+        acc->sum += exp(x - acc->max);
+    } else {
+        acc->sum = acc->sum * exp(acc->max - x) + 1.;
+        acc->max = x;
+    }
+}
+
+static REAL8 kde_log_sum_value(const KDELogSum *acc) {
+    return acc->sum > 0. ? acc->max + log(acc->sum) : -INFINITY;
+}
+
+
+/*
+ * Accumulate the kernels below node.  A node is approximated by the mean of
+ * the upper and lower bounds on its kernels once the error this introduces,
+ * per sample, is below log_budget times the current lower bound on the full
+ * sum; summed over the tree the relative error is then bounded by tolerance.
+ */
+static void kde_tree_eval(const struct tagKDETree *tree, const KDETreeNode *node, const REAL8 *q,
+                          REAL8 log_budget, KDELogSum *est, KDELogSum *lower) {
+    const INT4 dim = tree->dim;
+
+    REAL8 d = sqrt(kde_tree_dist2(q, node->centre, dim));
+    REAL8 dmin = d > node->radius ? d - node->radius : 0.;
+    REAL8 dmax = d + node->radius;
+    REAL8 emax = -dmin*dmin/2.;
+    REAL8 emin = -dmax*dmax/2.;
+
+    REAL8 log_err = emax + log1p(-exp(emin - emax)) - LAL_LN2;
+    if (log_err <= log_budget + kde_log_sum_value(lower)) {
+        REAL8 log_n = log((REAL8)node->npts);
+        kde_log_sum_add(est, log_n + emax + log1p(exp(emin - emax)) - LAL_LN2);
+        kde_log_sum_add(lower, log_n + emin);
+        return;
+    }
+
+    if (node->left == NULL) {
+        for (INT4 i = 0; i < node->npts; i++) {
+            REAL8 e = -kde_tree_dist2(q, tree->whitened + node->idx[i]*dim, dim)/2.;
+            kde_log_sum_add(est, e);
+            kde_log_sum_add(lower, e);
+        }
+        return;
+    }
+
+    /* Visit the nearer child first to tighten the lower bound quickly */
+    if (kde_tree_dist2(q, node->left->centre, dim) <= kde_tree_dist2(q, node->right->centre, dim)) {
+        kde_tree_eval(tree, node->left, q, log_budget, est, lower);
+        kde_tree_eval(tree, node->right, q, log_budget, est, lower);
+    } else {
+        kde_tree_eval(tree, node->right, q, log_budget, est, lower);
+        kde_tree_eval(tree, node->left, q, log_budget, est, lower);
+    }
+}
+
+
+/* log of the (unnormalised) sum of all kernels at a point, using the tree */
+static REAL8 kde_tree_log_sum(LALInferenceKDE *kde, const REAL8 *point) {
+    struct tagKDETree *tree = kde->tree;
+    KDELogSum est = {-INFINITY, 0.};
+    KDELogSum lower = {-INFINITY, 0.};
+
+    REAL8 *q = XLALMalloc(tree->dim * sizeof(REAL8));
+    kde_tree_whiten(kde, point, q);
+
+    REAL8 log_budget = log(tree->tolerance) - log((REAL8)tree->npts);
+    kde_tree_eval(tree, tree->root, q, log_budget, &est, &lower);
+
+    XLALFree(q);
+    return kde_log_sum_value(&est);
+}
+
+
+/**
+ * Build a ball tree for approximate evaluation of a KDE.
+ *
+ * Samples are stored in coordinates whitened by the kernel covariance, where
+ *  every kernel is a unit spherical Gaussian.  Evaluation then descends the
+ *  tree nearest-first, replacing whole subtrees whose kernels are bounded
+ *  tightly enough (in particular those far beyond the bulk of the density)
+ *  by a single term, so that LALInferenceKDEEvaluatePoint() costs far fewer
+ *  than \a npts kernel evaluations.  The summed density is guaranteed to be
+ *  within a fraction \a tolerance of the exact sum.  The tree is rebuilt
+ *  whenever LALInferenceSetKDEBandwidth() is called, and is freed along with
+ *  the KDE.
+ * @param kde       The kernel density estimate to build a tree for.
+ * @param tolerance Maximum relative error of evaluated densities (0 for exact).
+ * @return XLAL_SUCCESS, or an XLAL error code on failure.
+ * \sa LALInferenceKDEAddPoint()
+ */
+INT4 LALInferenceKDEBuildTree(LALInferenceKDE *kde, REAL8 tolerance) {
+    XLAL_CHECK(kde != NULL, XLAL_EFAULT);
+    XLAL_CHECK(tolerance >= 0., XLAL_EINVAL, "Tolerance must be non-negative, got %g", tolerance);
+
+    if (kde->tree == NULL) {
+        kde->tree = XLALCalloc(1, sizeof(struct tagKDETree));
+        XLAL_CHECK(kde->tree != NULL, XLAL_ENOMEM);
+        kde->tree->dim = kde->dim;
+    }
+    kde->tree->tolerance = tolerance;
+
+    XLAL_CHECK(kde_tree_populate(kde) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+
+/**
+ * Add a sample to a KDE without retuning its bandwidth.
+ *
+ * The sample is appended to the data, and inserted into the KDE's tree if one
+ *  has been built, without rebuilding it.  The kernel covariance is left as
+ *  is, and the normalization updated for the new number of kernels, so samples
+ *  can be accumulated cheaply as they arrive; call
+ *  LALInferenceSetKDEBandwidth() to retune the bandwidth to the enlarged set.
+ *  A KDE without a tuned bandwidth must be tuned before it can be evaluated.
+ * @param kde   The kernel density estimate to add to.
+ * @param point Array of length \a dim containing the sample.
+ * @return XLAL_SUCCESS, or an XLAL error code on failure.
+ */
+INT4 LALInferenceKDEAddPoint(LALInferenceKDE *kde, REAL8 *point) {
+    XLAL_CHECK(kde != NULL, XLAL_EFAULT);
+    XLAL_CHECK(point != NULL, XLAL_EFAULT);
+    INT4 dim = kde->dim;
+
+    /* Grow the storage geometrically, and point the data at a view of the
+     * rows in use */
+    if (kde->buffer == NULL || kde->npts == (INT4)kde->buffer->size1) {
+        gsl_matrix *buffer = gsl_matrix_alloc(kde->npts > 0 ? 2*kde->npts : 2*KDE_TREE_LEAF_SIZE, dim);
+        XLAL_CHECK(buffer != NULL, XLAL_ENOMEM);
+        if (kde->npts > 0) {
+            gsl_matrix_view rows = gsl_matrix_submatrix(buffer, 0, 0, kde->npts, dim);
+            gsl_matrix_memcpy(&rows.matrix, kde->data);
+        }
+        if (kde->buffer) gsl_matrix_free(kde->buffer);
+        else if (kde->npts > 0) gsl_matrix_free(kde->data);
+        kde->buffer = buffer;
+    }
+    kde->data_view = gsl_matrix_submatrix(kde->buffer, 0, 0, kde->npts + 1, dim);
+    kde->data = &kde->data_view.matrix;
+
+    gsl_vector_view x = gsl_vector_view_array(point, dim);
+    gsl_matrix_set_row(kde->data, kde->npts, &x.vector);
+    kde->npts++;
+
+    if (!isinf(kde->log_norm_factor))
+        kde->log_norm_factor += log((REAL8)kde->npts / (REAL8)(kde->npts - 1));
+
+    struct tagKDETree *tree = kde->tree;
+    if (tree && tree->root) {
+        if (tree->npts == tree->size) {
+            tree->size *= 2;
+            tree->whitened = XLALRealloc(tree->whitened, tree->size * dim * sizeof(REAL8));
+            XLAL_CHECK(tree->whitened != NULL, XLAL_ENOMEM);
+        }
+        kde_tree_whiten(kde, point, tree->whitened + tree->npts*dim);
+        XLAL_CHECK(kde_tree_insert(tree, tree->root, tree->npts) == XLAL_SUCCESS, XLAL_EFUNC);
+        tree->npts++;
+    }
+
+    return XLAL_SUCCESS;
+}
+
+
 /**
  * Calculate the determinant of a matrix.
  *
@@ -28,6 +28,7 @@
 #include <lal/LALInference.h>
 
 struct tagkmeans;
+struct tagKDETree;
 
 /**
  * Structure containing the Guassian kernel density of a set of samples.
@@ -36,6 +37,9 @@ typedef struct
 tagKDE
 {
     gsl_matrix *data;                       /**< Data to estimate the underlying distribution of */
+    gsl_matrix *buffer;                     /**< Storage of \a data, with spare rows, once samples are
+                                                  added by LALInferenceKDEAddPoint() (NULL before) */
+    gsl_matrix_view data_view;              /**< View of the rows of \a buffer in use, pointed to by \a data */
     INT4 dim;                               /**< Dimension of points in \a data. */
     INT4 npts;                              /**< Number of points in \a data. */
     REAL8 bandwidth;                        /**< Bandwidth of kernels. */
@@ -51,6 +55,9 @@ tagKDE
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
     REAL8 * upper_bounds;              /**< Upper param bounds */
+
+    struct tagKDETree * tree;          /**< Optional ball tree of the whitened data, used for
+                                            approximate evaluation (see LALInferenceKDEBuildTree()) */
 } LALInferenceKDE;
 
 /* Allocate, fill, and tune a Gaussian kernel density estimate given an array of points. */
@@ -71,6 +78,12 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde);
 /* Evaluate the (log) PDF from a KDE at a single point. */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point);
 
+/* Build a ball tree for approximate evaluation of a KDE to a given relative tolerance. */
+INT4 LALInferenceKDEBuildTree(LALInferenceKDE *kde, REAL8 tolerance);
+
+/* Add a sample to a KDE without retuning its bandwidth. */
+INT4 LALInferenceKDEAddPoint(LALInferenceKDE *kde, REAL8 *point);
+
 /* Draw a sample from a kernel density estimate. */
 REAL8 *LALInferenceDrawKDESample(LALInferenceKDE *kde, gsl_rng *rng);
 
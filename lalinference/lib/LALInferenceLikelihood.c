@@ -23,6 +23,7 @@
 
 #include <complex.h>
 #include <assert.h>
+#include <limits.h>
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferencePrior.h>
 #include <lal/LALInference.h>
@@ -34,6 +35,8 @@
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/LALInferenceDistanceMarg.h>
+#include <lal/LALInferenceReadData.h>
+#include <lal/LIGOLwXMLInspiralRead.h>
 
 #include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_sf_dawson.h>
@@ -73,19 +76,14 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 static double integrate_interpolated_log(double h, REAL8 *log_ys, size_t n, double *imean, size_t *imax);
 
-static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases);
-static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases)
+static double model_marginal_distance_loglikelihood(LALInferenceModel *model, double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi);
+
+static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, UINT4 npts, REAL8 *logfreqs, REAL8 *amps, REAL8 *phases);
+static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, UINT4 npts, REAL8 *logfreqs, REAL8 *amps, REAL8 *phases)
 {
-  UINT4 npts = LALInferenceGetUINT4Variable(vars, "spcal_npts");
   char ampname[VARNAME_MAX];
   char phasename[VARNAME_MAX];
   char freqname[VARNAME_MAX];
-  if(!*logfreqs) *logfreqs = XLALCreateREAL8Vector(npts);
-  if(!*amps) *amps = XLALCreateREAL8Vector(npts);
-  if(!*phases) *phases = XLALCreateREAL8Vector(npts);
-  assert((*logfreqs)->length==npts);
-  assert((*amps)->length==npts);
-  assert((*phases)->length==npts);
 
   for(UINT4 i=0;i<npts;i++)
   {
@@ -93,13 +91,320 @@ static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, RE
     if((VARNAME_MAX <= snprintf(ampname, VARNAME_MAX, "%s_spcal_amp_%i", ifoname, i))) XLAL_ERROR(XLAL_EINVAL,"Variable name too long");
     if((VARNAME_MAX <= snprintf(phasename, VARNAME_MAX, "%s_spcal_phase_%i", ifoname, i))) XLAL_ERROR(XLAL_EINVAL,"Variable name too long");
 
-    (*logfreqs)->data[i] = LALInferenceGetREAL8Variable(vars, freqname);
-    (*amps)->data[i] =  LALInferenceGetREAL8Variable(vars, ampname);
-    (*phases)->data[i] = LALInferenceGetREAL8Variable(vars, phasename);
+    logfreqs[i] = LALInferenceGetREAL8Variable(vars, freqname);
+    amps[i] =  LALInferenceGetREAL8Variable(vars, ampname);
+    phases[i] = LALInferenceGetREAL8Variable(vars, phasename);
   }
   return(XLAL_SUCCESS);
 }
 
+/*
+ * Calibration factors of detector ifo at the frequencies used by the
+ * likelihood: the ROQ linear and quadratic nodes, the relative binning
+ * bin edges, or the full frequency grid into calFactor.  The spline
+ * kernels are kept on the model, so they are only rebuilt if the spline
+ * node frequencies or the frequencies themselves change.
+ */
+static int apply_calib_spline(LALInferenceModel *model, LALInferenceVariables *vars, LALInferenceIFOData *dataPtr,
+                              int ifo, int Nifos, COMPLEX16FrequencySeries *calFactor)
+{
+  UINT4 npts = LALInferenceGetUINT4Variable(vars, "spcal_npts");
+  REAL8 logfreqs[npts], amps[npts], phases[npts];
+  XLAL_CHECK(get_calib_spline(vars, dataPtr->name, npts, logfreqs, amps, phases) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  if (model->spcal == NULL) {
+    model->spcal = XLALCalloc(2 * Nifos, sizeof(LALInferenceSplineCalibration *));
+    XLAL_CHECK(model->spcal != NULL, XLAL_ENOMEM);
+  }
+  LALInferenceSplineCalibration **cal = &model->spcal[2 * ifo];
+
+  if (model->roq_flag) {
+    REAL8Sequence *lin = model->roq->frequencyNodesLinear;
+    REAL8Sequence *quad = model->roq->frequencyNodesQuadratic;
+    XLAL_CHECK(LALInferenceUpdateSplineCalibration(&cal[0], logfreqs, npts, lin->data, 0, lin->length) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(LALInferenceUpdateSplineCalibration(&cal[1], logfreqs, npts, quad->data, 0, quad->length) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(LALInferenceApplySplineCalibration(cal[0], amps, phases, model->roq->calFactorLinear->data) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(LALInferenceApplySplineCalibration(cal[1], amps, phases, model->roq->calFactorQuadratic->data) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  else if (model->relbin_flag) {
+    REAL8Sequence *edges = model->relbin->binEdges;
+    XLAL_CHECK(LALInferenceUpdateSplineCalibration(&cal[0], logfreqs, npts, edges->data, 0, edges->length) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(LALInferenceApplySplineCalibration(cal[0], amps, phases, model->relbin->calFactor->data) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  else {
+    XLAL_CHECK(LALInferenceUpdateSplineCalibration(&cal[0], logfreqs, npts, NULL, calFactor->deltaF, calFactor->data->length) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(LALInferenceApplySplineCalibration(cal[0], amps, phases, calFactor->data->data) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Phase-difference bound of Zackay, Dai & Venumadhav (arXiv:1806.08792),
+ * used to place the relative binning bin edges.  Any waveform in the
+ * posterior differs from the fiducial by at most this much phase in each
+ * post-Newtonian power law; it is monotonic in f.
+ */
+static REAL8 relbin_phase_bound(REAL8 f, REAL8 fmin, REAL8 fmax)
+{
+  static const REAL8 gammas[] = {-5.0/3.0, -2.0/3.0, 1.0, 5.0/3.0, 7.0/3.0};
+  REAL8 psi = 0.0;
+  for (UINT4 i = 0; i < XLAL_NUM_ELEM(gammas); i++) {
+    if (gammas[i] < 0)
+      psi -= pow(f/fmin, gammas[i]);
+    else
+      psi += pow(f/fmax, gammas[i]);
+  }
+  return LAL_TWOPI*psi;
+}
+
+/* Read "name value" pairs from a file into the fiducial parameters */
+static int relbin_read_fiducial(const char *fname, LALInferenceVariables *params)
+{
+  FILE *fp = fopen(fname, "r");
+  XLAL_CHECK(fp != NULL, XLAL_EIO, "Cannot open relative binning fiducial file %s", fname);
+  char name[VARNAME_MAX];
+  REAL8 value;
+  int ret;
+  while ((ret = fscanf(fp, "%39s %lf", name, &value)) == 2) {
+    if (!LALInferenceCheckVariable(params, name) || LALInferenceGetVariableType(params, name) != LALINFERENCE_REAL8_t) {
+      fclose(fp);
+      XLAL_ERROR(XLAL_EINVAL, "Fiducial parameter %s is not a REAL8 parameter of the model", name);
+    }
+    LALInferenceSetREAL8Variable(params, name, value);
+  }
+  fclose(fp);
+  XLAL_CHECK(ret == EOF, XLAL_EIO, "Malformed line in relative binning fiducial file %s", fname);
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Take the fiducial parameters from the injection selected by --inj and
+ * --event.  Every varying REAL8 parameter of the model must be set by the
+ * injection, otherwise the fiducial would partly be a random prior draw.
+ */
+static int relbin_injection_fiducial(ProcessParamsTable *commandLine, LALInferenceVariables *params)
+{
+  ProcessParamsTable *ppt = LALInferenceGetProcParamVal(commandLine, "--inj");
+  XLAL_CHECK(ppt, XLAL_EINVAL, "Relative binning needs a fiducial waveform: pass --relbin-fiducial or --inj");
+  SimInspiralTable *injTable = NULL;
+  SimInspiralTableFromLIGOLw(&injTable, ppt->value, 0, 0);
+  XLAL_CHECK(injTable, XLAL_EIO, "Unable to read injection file %s", ppt->value);
+  SimInspiralTable *theEventTable = injTable;
+  if ((ppt = LALInferenceGetProcParamVal(commandLine, "--event")))
+    for (INT4 i = 0; i < atoi(ppt->value) && theEventTable; i++)
+      theEventTable = theEventTable->next;
+
+  LALInferenceVariables injParams;
+  memset(&injParams, 0, sizeof(injParams));
+  if (theEventTable)
+    LALInferenceInjectionToVariables(theEventTable, &injParams);
+  while (injTable) {
+    SimInspiralTable *next = injTable->next;
+    LALFree(injTable);
+    injTable = next;
+  }
+  XLAL_CHECK(theEventTable, XLAL_EINVAL, "Injection event %s not found", ppt->value);
+
+  int retn = XLAL_SUCCESS;
+  for (LALInferenceVariableItem *item = params->head; item; item = item->next) {
+    if (item->type != LALINFERENCE_REAL8_t || !LALInferenceCheckVariableNonFixed(params, item->name))
+      continue;
+    if (!LALInferenceCheckVariable(&injParams, item->name) || LALInferenceGetVariableType(&injParams, item->name) != LALINFERENCE_REAL8_t) {
+      XLALPrintError("%s: parameter %s is not set by the injection; pass --relbin-fiducial instead\n", __func__, item->name);
+      retn = XLAL_FAILURE;
+      continue;
+    }
+    LALInferenceSetREAL8Variable(params, item->name, LALInferenceGetREAL8Variable(&injParams, item->name));
+  }
+  LALInferenceClearVariables(&injParams);
+  XLAL_CHECK(retn == XLAL_SUCCESS, XLAL_EINVAL, "Cannot take the relative binning fiducial from the injection");
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Set up relative binning: choose the bin edges, generate the fiducial
+ * waveform on the full frequency grid, compute the per-bin summary data
+ * for each detector and switch every thread's template to the one that
+ * only generates the waveform at the bin edges.
+ */
+static int LALInferenceSetupRelativeBinning(LALInferenceRunState *runState)
+{
+  ProcessParamsTable *ppt = NULL;
+  LALInferenceIFOData *data = runState->data;
+  LALInferenceModel *model = runState->threads[0].model;
+
+  XLAL_CHECK(model->domain == LAL_SIM_DOMAIN_FREQUENCY && !model->roq_flag, XLAL_EINVAL,
+             "Relative binning requires a frequency-domain template and is incompatible with ROQ");
+  if (LALInferenceGetProcParamVal(runState->commandLine, "--margtime") ||
+      LALInferenceGetProcParamVal(runState->commandLine, "--margtimephi") ||
+      LALInferenceGetProcParamVal(runState->commandLine, "--studentTLikelihood"))
+    XLAL_ERROR(XLAL_EINVAL, "Relative binning does not support time marginalisation or the Student-t likelihood");
+  if (LALInferenceGetProcParamVal(runState->commandLine, "--psdFit") ||
+      LALInferenceGetProcParamVal(runState->commandLine, "--psd-fit") ||
+      LALInferenceGetProcParamVal(runState->commandLine, "--glitchFit") ||
+      LALInferenceGetProcParamVal(runState->commandLine, "--glitch-fit"))
+    XLAL_ERROR(XLAL_EINVAL, "Relative binning does not support PSD or glitch fitting");
+  if (LALInferenceCheckVariable(runState->threads[0].currentParams, "constantcal_active") &&
+      *(UINT4 *)LALInferenceGetVariable(runState->threads[0].currentParams, "constantcal_active"))
+    XLAL_ERROR(XLAL_EINVAL, "Relative binning does not support constant calibration errors");
+
+  REAL8 epsilon = 0.3;
+  if ((ppt = LALInferenceGetProcParamVal(runState->commandLine, "--relbin-epsilon")))
+    epsilon = atof(ppt->value);
+  XLAL_CHECK(epsilon > 0, XLAL_EINVAL, "--relbin-epsilon must be positive");
+
+  /* All detectors share one template, so the bins span the union of their bands */
+  const REAL8 deltaF = data->freqData->deltaF;
+  UINT4 kmin = UINT_MAX, kmax = 0;
+  for (LALInferenceIFOData *ifo = data; ifo; ifo = ifo->next) {
+    XLAL_CHECK(ifo->freqData->deltaF == deltaF, XLAL_EINVAL, "Relative binning requires all detectors to share a frequency resolution");
+    UINT4 lower = (UINT4)ceil(ifo->fLow / deltaF);
+    UINT4 upper = (UINT4)floor(ifo->fHigh / deltaF);
+    if (lower < 1) lower = 1;
+    if (upper > ifo->freqData->data->length - 1) upper = ifo->freqData->data->length - 1;
+    if (lower < kmin) kmin = lower;
+    if (upper > kmax) kmax = upper;
+  }
+  XLAL_CHECK(kmax > kmin, XLAL_EINVAL, "Empty frequency band for relative binning");
+
+  /* Walk the grid, starting a new bin whenever the phase bound has grown by epsilon */
+  const REAL8 fmin = kmin*deltaF, fmax = kmax*deltaF;
+  UINT4Sequence *edgeIdx = XLALCreateUINT4Sequence(kmax - kmin + 1);
+  XLAL_CHECK(edgeIdx, XLAL_EFUNC);
+  UINT4 nedges = 0;
+  edgeIdx->data[nedges++] = kmin;
+  REAL8 psi_edge = relbin_phase_bound(fmin, fmin, fmax);
+  for (UINT4 k = kmin + 1; k < kmax; k++) {
+    REAL8 psi = relbin_phase_bound(k*deltaF, fmin, fmax);
+    if (psi - psi_edge > epsilon) {
+      edgeIdx->data[nedges++] = k;
+      psi_edge = psi;
+    }
+  }
+  edgeIdx->data[nedges++] = kmax;
+  edgeIdx = XLALResizeUINT4Sequence(edgeIdx, 0, nedges);
+  XLAL_CHECK(edgeIdx, XLAL_EFUNC);
+  const UINT4 nbins = nedges - 1;
+
+  REAL8Sequence *binEdges = XLALCreateREAL8Sequence(nedges);
+  XLAL_CHECK(binEdges, XLAL_EFUNC);
+  for (UINT4 e = 0; e < nedges; e++)
+    binEdges->data[e] = edgeIdx->data[e]*deltaF;
+
+  /* The starting point of the sampler is usually a random prior draw, so the
+   * fiducial must be given explicitly, or be the injection */
+  LALInferenceVariables fiducial;
+  memset(&fiducial, 0, sizeof(fiducial));
+  LALInferenceCopyVariables(runState->threads[0].currentParams, &fiducial);
+  if ((ppt = LALInferenceGetProcParamVal(runState->commandLine, "--relbin-fiducial")))
+    XLAL_CHECK(relbin_read_fiducial(ppt->value, &fiducial) == XLAL_SUCCESS, XLAL_EFUNC);
+  else
+    XLAL_CHECK(relbin_injection_fiducial(runState->commandLine, &fiducial) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  /* Generate the fiducial on the full grid by pointing the bin edges at every frequency */
+  LALInferenceRelBinModel fullGrid;
+  memset(&fullGrid, 0, sizeof(fullGrid));
+  fullGrid.binEdges = XLALCreateREAL8Sequence(kmax - kmin + 1);
+  XLAL_CHECK(fullGrid.binEdges, XLAL_EFUNC);
+  for (UINT4 k = kmin; k <= kmax; k++)
+    fullGrid.binEdges->data[k - kmin] = k*deltaF;
+  model->relbin = &fullGrid;
+  LALInferenceCopyVariables(&fiducial, model->params);
+  int errnum;
+  XLAL_TRY(LALInferenceRelBinWrapperForXLALSimInspiralChooseFDWaveformSequence(model), errnum);
+  model->relbin = NULL;
+  XLAL_CHECK(errnum == XLAL_SUCCESS && fullGrid.hptilde && fullGrid.hctilde, XLAL_EFUNC, "Failed to generate the relative binning fiducial waveform");
+  const REAL8 modeltime = LALInferenceGetREAL8Variable(model->params, "time");
+
+  /* Sky position and arrival time of the fiducial, as in the likelihood */
+  REAL8 ra, dec, GPSdouble;
+  if (LALInferenceCheckVariable(&fiducial, "SKY_FRAME") && *(INT4 *)LALInferenceGetVariable(&fiducial, "SKY_FRAME")) {
+    XLAL_CHECK(data->next, XLAL_EINVAL, "Cannot use --detector-frame with less than 2 detectors");
+    REAL8 t0 = LALInferenceGetREAL8Variable(&fiducial, "t0");
+    REAL8 alph = acos(LALInferenceGetREAL8Variable(&fiducial, "cosalpha"));
+    REAL8 theta = LALInferenceGetREAL8Variable(&fiducial, "azimuth");
+    LALInferenceDetFrameToEquatorial(data->detector, data->next->detector, t0, alph, theta, &GPSdouble, &ra, &dec);
+  } else {
+    ra = LALInferenceGetREAL8Variable(&fiducial, "rightascension");
+    dec = LALInferenceGetREAL8Variable(&fiducial, "declination");
+    GPSdouble = LALInferenceGetREAL8Variable(&fiducial, "time");
+  }
+  const REAL8 psi = LALInferenceGetREAL8Variable(&fiducial, "polarisation");
+  LIGOTimeGPS GPSlal;
+  XLALGPSSetREAL8(&GPSlal, GPSdouble);
+  const REAL8 gmst = XLALGreenwichMeanSiderealTime(&GPSlal);
+
+  /* Per-detector summary data */
+  for (LALInferenceIFOData *ifo = data; ifo; ifo = ifo->next) {
+    double Fplus, Fcross;
+    XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])ifo->detector->response, ra, dec, psi, gmst);
+    const REAL8 timedelay = XLALTimeDelayFromEarthCenter(ifo->detector->location, ra, dec, &GPSlal);
+    const REAL8 timeshift = (GPSdouble - modeltime) + timedelay;
+    const UINT4 lower = (UINT4)ceil(ifo->fLow / deltaF);
+    const UINT4 upper = (UINT4)floor(ifo->fHigh / deltaF);
+
+    LALInferenceRelBinData *rb = XLALCalloc(1, sizeof(*rb));
+    XLAL_CHECK(rb, XLAL_ENOMEM);
+    rb->fiducial = XLALCreateCOMPLEX16Sequence(nedges);
+    rb->A0 = XLALCreateCOMPLEX16Sequence(nbins);
+    rb->A1 = XLALCreateCOMPLEX16Sequence(nbins);
+    rb->B0 = XLALCreateREAL8Sequence(nbins);
+    rb->B1 = XLALCreateREAL8Sequence(nbins);
+    XLAL_CHECK(rb->fiducial && rb->A0 && rb->A1 && rb->B0 && rb->B1, XLAL_EFUNC);
+
+    for (UINT4 b = 0; b < nbins; b++) {
+      const UINT4 kb = edgeIdx->data[b], ke = edgeIdx->data[b+1];
+      const UINT4 kend = (b == nbins - 1) ? ke : ke - 1;
+      const REAL8 fm = 0.5*(kb + ke)*deltaF;
+      COMPLEX16 A0 = 0, A1 = 0;
+      REAL8 B0 = 0, B1 = 0;
+      for (UINT4 k = kb; k <= kend; k++) {
+        const REAL8 f = k*deltaF;
+        const COMPLEX16 h0 = (Fplus*fullGrid.hptilde->data->data[k - kmin] + Fcross*fullGrid.hctilde->data->data[k - kmin])
+                             * cexp(-I*LAL_TWOPI*f*timeshift);
+        if (k == kb) rb->fiducial->data[b] = h0;
+        if (k == ke) rb->fiducial->data[b+1] = h0;
+        if (k < lower || k > upper) continue;
+        /* 4 deltaF / S(f), the normalisation of the ROQ inner products */
+        const REAL8 w = 4.0*deltaF/ifo->oneSidedNoisePowerSpectrum->data->data[k];
+        const COMPLEX16 dh0 = w*ifo->freqData->data->data[k]*conj(h0);
+        const REAL8 h0h0 = w*(creal(h0)*creal(h0) + cimag(h0)*cimag(h0));
+        A0 += dh0;
+        A1 += dh0*(f - fm);
+        B0 += h0h0;
+        B1 += h0h0*(f - fm);
+      }
+      rb->A0->data[b] = A0;
+      rb->A1->data[b] = A1;
+      rb->B0->data[b] = B0;
+      rb->B1->data[b] = B1;
+    }
+    ifo->relbin = rb;
+  }
+
+  XLALDestroyCOMPLEX16FrequencySeries(fullGrid.hptilde);
+  XLALDestroyCOMPLEX16FrequencySeries(fullGrid.hctilde);
+  XLALDestroyREAL8Sequence(fullGrid.binEdges);
+  XLALDestroyUINT4Sequence(edgeIdx);
+  LALInferenceClearVariables(&fiducial);
+
+  /* Each thread generates its own template at the shared bin edges */
+  for (INT4 t = 0; t < runState->nthreads; t++) {
+    LALInferenceModel *m = runState->threads[t].model;
+    m->relbin = XLALCalloc(1, sizeof(LALInferenceRelBinModel));
+    XLAL_CHECK(m->relbin, XLAL_ENOMEM);
+    m->relbin->binEdges = binEdges;
+    m->relbin->calFactor = XLALCreateCOMPLEX16Sequence(nedges);
+    XLAL_CHECK(m->relbin->calFactor, XLAL_EFUNC);
+    m->relbin->epsilon = epsilon;
+    m->relbin_flag = 1;
+    m->templt = &LALInferenceRelBinWrapperForXLALSimInspiralChooseFDWaveformSequence;
+  }
+
+  fprintf(stdout, "Using relative binning likelihood with %u bins between %g and %g Hz.\n", nbins, fmin, fmax);
+  return XLAL_SUCCESS;
+}
+
 void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 {
     char help[]="\
@@ -117,6 +422,10 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
     (--margtimephi)                  Using marginalised in time and phase likelihood\n\
     (--margdist)                     Using marginalisation in distance with d^2 prior (compatible with --margphi and --margtimephi)\n\
     (--margdist-comoving)            Using marginalisation in distance with uniform-in-comoving-volume prior (compatible with --margphi and --margtimephi)\n\
+    (--margdist-table FILE)          Read the distance marginalisation lookup table from FILE, or build it and save it there\n\
+    (--relative-binning)             Use relative binning around a fiducial waveform (compatible with --margphi and --margdist)\n\
+    (--relbin-epsilon EPS)           Maximum fiducial phase error across a relative binning bin, in radians (default 0.3)\n\
+    (--relbin-fiducial FILE)         File of \"name value\" lines giving the fiducial parameters (default: the injection given by --inj)\n\
     \n";
 
     /* Print command line arguments if help requested */
@@ -185,6 +494,35 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
       runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
    }
 
+   /* Build (or load) the distance marginalisation table once and share it between threads */
+   if (LALInferenceCheckVariable(thread->model->params, "MARGDIST") && LALInferenceGetUINT4Variable(thread->model->params, "MARGDIST")) {
+     double dist_min, dist_max;
+     LALInferenceGetMinMaxPrior(thread->model->params, "logdistance", &dist_min, &dist_max);
+     int cosmology = 0;
+     if (LALInferenceCheckVariable(thread->model->params, "MARGDIST_COSMOLOGY"))
+       cosmology = LALInferenceGetINT4Variable(thread->model->params, "MARGDIST_COSMOLOGY");
+     int margphi = (runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood ||
+                    runState->likelihood==&LALInferenceMarginalisedTimePhaseLogLikelihood);
+     ProcessParamsTable *ppt = LALInferenceGetProcParamVal(commandLine, "--margdist-table");
+     fprintf(stdout, "Initialising distance integration lookup table\n");
+     LALInferenceDistanceMargTable *table = LALInferenceGetDistanceMargTable(ppt ? ppt->value : NULL,
+                                                                            exp(dist_min), exp(dist_max), cosmology, margphi,
+                                                                            LALINFERENCE_DISTANCE_MARG_PMAX, LALINFERENCE_DISTANCE_MARG_SIZE);
+     if (!table) {
+       fprintf(stderr, "ERROR: failed to set up the distance marginalisation table. Exiting...\n");
+       exit(1);
+     }
+     for(INT4 t=0; t < runState->nthreads; t++)
+       runState->threads[t].model->distance_marg = table;
+   }
+
+   if (LALInferenceGetProcParamVal(commandLine, "--relative-binning")) {
+     if (LALInferenceSetupRelativeBinning(runState) != XLAL_SUCCESS) {
+       fprintf(stderr, "ERROR: failed to set up the relative binning likelihood. Exiting...\n");
+       exit(1);
+     }
+   }
+
    /* Try to determine a model-less likelihood, if such a thing makes sense */
    if (runState->likelihood==&LALInferenceUndecomposedFreqDomainLogLikelihood || runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood ){
 
@@ -360,10 +698,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   COMPLEX16FrequencySeries *calFactor = NULL;
   COMPLEX16 calF = 0.0;
 
-  REAL8Vector *logfreqs = NULL;
-  REAL8Vector *amps = NULL;
-  REAL8Vector *phases = NULL;
-
   UINT4 spcal_active = 0;
   REAL8 calamp=0.0;
   REAL8 calpha=0.0;
@@ -402,6 +736,10 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     fprintf(stderr,"ERROR: cannot use ROQ likelihood and constant calibration error marginalization together. Exiting...\n");
     exit(1);
   }
+  if (model->relbin_flag && constantcal_active){
+    fprintf(stderr,"ERROR: cannot use relative binning likelihood and constant calibration error marginalization together. Exiting...\n");
+    exit(1);
+  }
 
   REAL8 degreesOfFreedom=2.0;
   REAL8 chisq=0.0;
@@ -418,6 +756,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     margtime=1;
 
   if(model->roq_flag && margtime) XLAL_ERROR_REAL8(XLAL_EINVAL,"ROQ does not support time marginalisation");
+  if(model->relbin_flag && margtime) XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning does not support time marginalisation");
 
   
   LALStatus status;
@@ -682,34 +1021,17 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         /* Calibration stuff if necessary */
         /*spline*/
         if (spcal_active) {
-          logfreqs = NULL;
-          amps = NULL;
-          phases = NULL;
-	  /* get_calib_spline creates and fills the logfreqs, amps, phases arrays */
-	  get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
-	  if (model->roq_flag) {
-
-             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
-						model->roq->frequencyNodesLinear,
-						&(model->roq->calFactorLinear),
-						model->roq->frequencyNodesQuadratic,
-						&(model->roq->calFactorQuadratic));
-	  }
-
-	  else{
-	    if (calFactor == NULL) {
-	      calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors",
+	  if (calFactor == NULL && !model->roq_flag && !model->relbin_flag) {
+	    calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors",
                        &(dataPtr->freqData->epoch),
                        0, dataPtr->freqData->deltaF,
                        &lalDimensionlessUnit,
                        dataPtr->freqData->data->length);
-	    }
-          LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
-	}
-	if(logfreqs) XLALDestroyREAL8Vector(logfreqs);
-	if(amps) XLALDestroyREAL8Vector(amps);
-	if(phases) XLALDestroyREAL8Vector(phases);
-
+	  }
+	  if (apply_calib_spline(model, currentParams, dataPtr, ifo, Nifos, calFactor) != XLAL_SUCCESS) {
+	    if(calFactor) XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+	    XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to compute calibration factors for %s", dataPtr->name);
+	  }
         }
         /*constant*/
         if (constantcal_active){
@@ -748,9 +1070,13 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         Fplus*=amp_prefactor;
         Fcross*=amp_prefactor;
 
-        dataPtr->fPlus = Fplus;
-        dataPtr->fCross = Fcross;
-        dataPtr->timeshift = timeshift;
+        /* record the responses on the model, not the shared data, so that
+           several models can be evaluated on the same data at once */
+        if (model->ifo_fPlus) {
+          model->ifo_fPlus[ifo] = Fplus;
+          model->ifo_fCross[ifo] = Fcross;
+          model->ifo_timeshifts[ifo] = timeshift;
+        }
     }//end signalFlag condition
 
     /* determine frequency range & loop over frequency bins: */
@@ -797,45 +1123,59 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       }
     }
 
-    if (model->roq_flag) {
+    if (model->roq_flag || model->relbin_flag) {
 
-	double complex weight_iii;
+	if (model->relbin_flag) {
+	    /* Relative binning: the ratio r = h/h0 of the template to the
+	       fiducial is linear across each bin, r = r0 + r1 (f - fm), so
+	       <d|h> and <h|h> follow from the per-bin summary data */
+	    const REAL8Sequence *edges = model->relbin->binEdges;
+	    const COMPLEX16 *h0 = dataPtr->relbin->fiducial->data;
+	    COMPLEX16 r_lo = 0.0, r_hi = 0.0;
 
-	if (spcal_active){
+	    for(unsigned int e=0; e < edges->length; e++){
 
-	    for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
+		COMPLEX16 template_EI = (Fplus*model->relbin->hptilde->data->data[e] + Fcross*model->relbin->hctilde->data->data[e])
+					* cexp(-I*twopit*edges->data[e]);
+		if (spcal_active) template_EI *= model->relbin->calFactor->data[e];
 
-			complex double template_EI = model->roq->calFactorLinear->data[iii] * (dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii] );
+		r_lo = r_hi;
+		r_hi = (h0[e] != 0.0) ? template_EI/h0[e] : 0.0;
+		if (e == 0) continue;
 
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
+		COMPLEX16 r0 = 0.5*(r_lo + r_hi);
+		COMPLEX16 r1 = (r_hi - r_lo)/(edges->data[e] - edges->data[e-1]);
 
-			this_ifo_d_inner_h += ( weight_iii * ( conj( template_EI ) ) );
-		}
+		this_ifo_d_inner_h += dataPtr->relbin->A0->data[e-1]*conj(r0) + dataPtr->relbin->A1->data[e-1]*conj(r1);
+		this_ifo_s += dataPtr->relbin->B0->data[e-1]*creal(r0*conj(r0)) + 2.0*dataPtr->relbin->B1->data[e-1]*creal(r0*conj(r1));
+	    }
+	}
+	else {
+
+	if (LALInferenceROQLinearInnerProduct(&this_ifo_d_inner_h, dataPtr->roq->linear_weights,
+					      model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data,
+					      Fplus, Fcross,
+					      spcal_active ? model->roq->calFactorLinear->data : NULL,
+					      timeshift) != XLAL_SUCCESS)
+	  XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to evaluate the ROQ linear weights");
+
+	if (spcal_active){
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 
-			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) );
+			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) );
 		}
 	}
 
 	else{
 
-		for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii];
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += weight_iii*conj(template_EI) ;
-
-		}
-
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 			complex double template_EI = model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross;
 
 			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj(template_EI) * (template_EI) );
 					}
 	}
+	}
 
     d_inner_h += creal(this_ifo_d_inner_h);
     // D gets the factor of 2 inside nullloglikelihood
@@ -1067,11 +1407,11 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       {
           if (margphi)
           {
-            XLAL_TRY(model->ifo_loglikelihoods[ifo] = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(this_ifo_S), 2.0*cabs(this_ifo_Rcplx), cosmology, margphi), errnum);
+            XLAL_TRY(model->ifo_loglikelihoods[ifo] = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(this_ifo_S), 2.0*cabs(this_ifo_Rcplx), cosmology, margphi), errnum);
           }
           else
           {
-            XLAL_TRY(model->ifo_loglikelihoods[ifo] = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(this_ifo_S), 2.0*creal(this_ifo_Rcplx), cosmology, margphi), errnum);
+            XLAL_TRY(model->ifo_loglikelihoods[ifo] = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(this_ifo_S), 2.0*creal(this_ifo_Rcplx), cosmology, margphi), errnum);
           } 
           errnum&=~XLAL_EFUNC;
           if(errnum!=XLAL_SUCCESS)
@@ -1164,7 +1504,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       
       if(margdist )
       {
-        XLAL_TRY(loglikelihood = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), R, cosmology, margphi), errnum);
+        XLAL_TRY(loglikelihood = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(S), R, cosmology, margphi), errnum);
         errnum&=~XLAL_EFUNC;
         if(errnum!=XLAL_SUCCESS)
         {
@@ -1192,7 +1532,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       d_inner_h = creal(Rcplx);
       if(margdist )
       {
-        XLAL_TRY(loglikelihood = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), 2.0*d_inner_h, cosmology, margphi), errnum);
+        XLAL_TRY(loglikelihood = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(S), 2.0*d_inner_h, cosmology, margphi), errnum);
         errnum&=~XLAL_EFUNC;
         if(errnum!=XLAL_SUCCESS)
         {
@@ -1253,7 +1593,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
               
               if(margdist)
               {
-                XLAL_TRY(dh_S->data[i]=LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), x, cosmology, margphi) + S, errnum);
+                XLAL_TRY(dh_S->data[i]=model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(S), x, cosmology, margphi) + S, errnum);
 	        errnum&=~XLAL_EFUNC;
         	if(errnum!=XLAL_SUCCESS)
 	        {
@@ -1283,7 +1623,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
             {
                 for (i = istart; i < iend; i++)
                 {
-                    XLAL_TRY(dh_S->data[i]=LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), dh_S->data[i], cosmology, margphi) + S, errnum);
+                    XLAL_TRY(dh_S->data[i]=model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(S), dh_S->data[i], cosmology, margphi) + S, errnum);
                     errnum&=~XLAL_EFUNC;
                     if(errnum!=XLAL_SUCCESS)
                     {
@@ -1408,44 +1748,29 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
 {
-        static const size_t default_log_radial_integrator_size = 400;
-        double loglikelihood=0;
-        static double log_norm = 0;
-        static log_radial_integrator *integrator;
+        static LALInferenceDistanceMargTable *table;
 
-        double pmax = 100000; /* CHECKME: Max SNR allowed ? */
+        /* Callers without a table in their model share one built on first use */
         #pragma omp critical
         {
-            if (integrator == NULL)
+            if (table == NULL)
             {
                 printf("Initialising distance integration lookup table\n");
-                /* Initialise the integrator for the first time */
-                integrator = log_radial_integrator_init(
-                                dist_min,
-                                dist_max,
-                                2, /* Power of distance in prior */
-                                cosmology,
-                                pmax,
-                                default_log_radial_integrator_size * 5, /* CHECKME: fudge factor of 5 compared to bayestar */
-                                !margphi);
-                /* distance prior normalisation */
-                log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
+                table = LALInferenceCreateDistanceMargTable(dist_min, dist_max, cosmology, margphi,
+                                                            LALINFERENCE_DISTANCE_MARG_PMAX, LALINFERENCE_DISTANCE_MARG_SIZE);
             }
         }
-        #pragma omp barrier
-        if (!integrator) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
-        
-        if (isnan(OptimalSNR) || isnan(d_inner_h) || pmax<OptimalSNR)
-        {
-            loglikelihood=-INFINITY;
-            XLAL_ERROR(XLAL_ERANGE,"warning: Optimal SNR %lf exceeded pmax %lf\n",OptimalSNR, pmax);
-        }
-        else
-        {
-            double marg_l = log_radial_integrator_eval(integrator, OptimalSNR , d_inner_h, log(OptimalSNR), log(d_inner_h));
-            loglikelihood = marg_l - log_norm; /* Normalise prior */
-        }
-        return (loglikelihood);
+        if (!table) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
+
+        return LALInferenceDistanceMargTableLogLikelihood(table, OptimalSNR, d_inner_h);
+}
+
+/* Use the model's distance marginalisation table if it has one */
+static double model_marginal_distance_loglikelihood(LALInferenceModel *model, double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
+{
+        if (model->distance_marg)
+            return LALInferenceDistanceMargTableLogLikelihood(model->distance_marg, OptimalSNR, d_inner_h);
+        return LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, OptimalSNR, d_inner_h, cosmology, margphi);
 }
 
 /***************************************************************/
@@ -1805,9 +2130,11 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       Fplus*=amp_prefactor;
       Fcross*=amp_prefactor;
 
-      dataPtr->fPlus = Fplus;
-      dataPtr->fCross = Fcross;
-      dataPtr->timeshift = timeshift;
+      if (model->ifo_fPlus) {
+        model->ifo_fPlus[ifo] = Fplus;
+        model->ifo_fCross[ifo] = Fcross;
+        model->ifo_timeshifts[ifo] = timeshift;
+      }
 
 
       /* determine frequency range & loop over frequency bins: */
@@ -2032,8 +2359,10 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
     /* determine beam pattern response (F_plus and F_cross) for given Ifo: */
     XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
 
-    dataPtr->fPlus = Fplus;
-    dataPtr->fCross = Fcross;
+    if (model->ifo_fPlus) {
+      model->ifo_fPlus[ifo] = Fplus;
+      model->ifo_fCross[ifo] = Fcross;
+    }
 
     /* determine frequency range & loop over frequency bins: */
     deltaT = dataPtr->timeData->deltaT;
@@ -27,6 +27,10 @@
 
 #include "logaddexp.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #define PROGRAM_NAME "LALInferenceNestedSampler.c"
 #define CVS_ID_STRING "$Id$"
 #define CVS_REVISION "$Revision$"
@@ -91,6 +95,61 @@ static int _loadNSintegralStateH5(LALH5File *group, NSintegralState *s)
   return(0);
 }
 
+/* Save and restore the states of the run's random number generator and of
+ * those of the threads, so that a resumed run continues the same sequences */
+static int _saveRNGStatesH5(LALH5File *group, LALInferenceRunState *runState);
+static int _saveRNGStatesH5(LALH5File *group, LALInferenceRunState *runState)
+{
+  char name[64];
+  CHARVector state;
+  state.length = gsl_rng_size(runState->GSLrandom);
+  state.data = gsl_rng_state(runState->GSLrandom);
+  if(XLALH5FileWriteCHARVector(group, "rng_state", &state)) return(1);
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    snprintf(name,sizeof(name),"thread_rng_state_%d",t);
+    state.length = gsl_rng_size(runState->threads[t].GSLrandom);
+    state.data = gsl_rng_state(runState->threads[t].GSLrandom);
+    if(XLALH5FileWriteCHARVector(group, name, &state)) return(1);
+  }
+  return(0);
+}
+
+static int _loadRNGState(LALH5File *group, const char *name, gsl_rng *rng);
+static int _loadRNGState(LALH5File *group, const char *name, gsl_rng *rng)
+{
+  CHARVector *state=NULL;
+  int retcode;
+  XLAL_TRY_SILENT(state = XLALH5FileReadCHARVector(group, name), retcode);
+  if(retcode!=XLAL_SUCCESS || !state)
+  {
+    fprintf(stderr,"Warning: no %s in resume file, random number sequence will differ from uninterrupted run\n",name);
+    return(0);
+  }
+  if(state->length!=gsl_rng_size(rng))
+  {
+    fprintf(stderr,"Unable to restore %s: size %u does not match generator size %zu\n",name,state->length,gsl_rng_size(rng));
+    XLALDestroyCHARVector(state);
+    return(1);
+  }
+  memcpy(gsl_rng_state(rng), state->data, state->length);
+  XLALDestroyCHARVector(state);
+  return(0);
+}
+
+static int _loadRNGStatesH5(LALH5File *group, LALInferenceRunState *runState);
+static int _loadRNGStatesH5(LALH5File *group, LALInferenceRunState *runState)
+{
+  char name[64];
+  int retcode = _loadRNGState(group, "rng_state", runState->GSLrandom);
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    snprintf(name,sizeof(name),"thread_rng_state_%d",t);
+    retcode |= _loadRNGState(group, name, runState->threads[t].GSLrandom);
+  }
+  return(retcode);
+}
+
 
 static int ReadNSCheckPointH5(char *filename, LALInferenceRunState *runState, NSintegralState *s);
 static int WriteNSCheckPointH5(char *filename, LALInferenceRunState *runState, NSintegralState *s);
@@ -112,6 +171,8 @@ static int WriteNSCheckPointH5(char *filename, LALInferenceRunState *runState, N
   if(retcode!=XLAL_SUCCESS) return(retcode);
   retcode = _saveNSintegralStateH5(group,s);
   if(retcode) XLAL_ERROR(XLAL_EFAILED,"Unable to save integral state\n");
+  retcode = _saveRNGStatesH5(group,runState);
+  if(retcode) XLAL_ERROR(XLAL_EFAILED,"Unable to save random number generator states\n");
   LALInferenceH5VariablesArrayToDataset(group, runState->livePoints, Nlive, "live_points");
   INT4 N_output_array=0;
   if(LALInferenceCheckVariable(runState->algorithmParams,"N_outputarray")) N_output_array=LALInferenceGetINT4Variable(runState->algorithmParams,"N_outputarray");
@@ -190,6 +251,11 @@ static int ReadNSCheckPointH5(char *filename, LALInferenceRunState *runState, NS
     XLALH5FileClose(h5file);
     return 1;
   }
+  if(_loadRNGStatesH5(group,runState)){
+    fprintf(stderr,"Unable to read random number generator states - unable to resume!\n");
+    XLALH5FileClose(h5file);
+    return 1;
+  }
   LALH5Dataset *liveGroup = XLALH5DatasetRead(group,"live_points");
   retcode = LALInferenceH5DatasetToVariablesArray(liveGroup , &(runState->livePoints), &Nlive );
   printf("restored %i live points\n",Nlive);
@@ -312,6 +378,7 @@ static double logsubexp(double a, double b)
 }
 
 static void SetupEigenProposals(LALInferenceRunState *runState);
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin, UINT4 Nmcmc, REAL8 *sloppyfraction_ptr, REAL8 *accept_rate_ptr, REAL8 *sub_accept_rate_ptr);
 
 /**
  * Update the internal state of the integrator after receiving the lowest logL
@@ -586,6 +653,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--Nbatch K)                     Replace the K lowest live points at each iteration, evolving\n\
+                                     the K replacements in parallel on K threads (1)\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -640,15 +709,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
   /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t].proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -665,6 +732,22 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   }
   LALInferenceAddVariable(runState->algorithmParams,"Nlive",&tmpi, LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
 
+  /* Number of live points replaced per iteration, one per thread */
+  ppt=LALInferenceGetProcParamVal(commandLine,"--Nbatch");
+  if(ppt){
+    INT4 Nlive=tmpi;
+    tmpi=atoi(ppt->value);
+    if(tmpi<1 || tmpi>=Nlive){
+      fprintf(stderr,"Error, --Nbatch must be at least 1 and less than the number of live points\n");
+      exit(1);
+    }
+    if(tmpi>runState->nthreads){
+      fprintf(stderr,"Error, --Nbatch %i needs %i threads but only %i have been set up\n",tmpi,tmpi,runState->nthreads);
+      exit(1);
+    }
+    LALInferenceAddVariable(runState->algorithmParams,"Nbatch",&tmpi,LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
+  }
+
   /* Number of points in MCMC chain */
   ppt=LALInferenceGetProcParamVal(commandLine,"--Nmcmc");
   if(!ppt) ppt=LALInferenceGetProcParamVal(commandLine,"--nmcmc");
@@ -713,6 +796,82 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 }
 
 
+/**
+ * Replace the Nbatch lowest likelihood live points in one go, evolving one
+ * replacement on each of the first Nbatch threads in parallel.
+ *
+ * Removing the k lowest of N points at once is equivalent to removing them
+ * one at a time while the number of live points shrinks from N to N-k+1,
+ * so the removed points are passed to the integrator in ascending order
+ * with that number of live points, as in the final corrections at the end
+ * of the run.  Every replacement is drawn from the prior constrained above
+ * the highest of the removed likelihoods, which is returned in *logLmin.
+ * Each thread uses its own random number generator, proposal and sloppy
+ * fraction (sloppyfrac[t]), so the result does not depend on scheduling.
+ * Returns the updated log evidence.
+ */
+static REAL8 NestedSamplingBatchReplace(LALInferenceRunState *runState, NSintegralState *s, UINT4 Nbatch, REAL8 *sloppyfrac, UINT4 samplePrior, REAL8 *logLmin, REAL8 *logLmax)
+{
+  UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
+  UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+  REAL8 *logLikelihoods=(REAL8 *)(*(REAL8Vector **)LALInferenceGetVariable(runState->algorithmParams,"logLikelihoods"))->data;
+  UINT4 *order=XLALMalloc(Nlive*sizeof(UINT4));
+  REAL8 accept_rate[Nbatch],sub_accept_rate[Nbatch];
+  REAL8 logZ=-INFINITY;
+  UINT4 i,k;
+
+  /* Partial selection sort: order[0..Nbatch-1] are the points to remove, in
+   * ascending order of likelihood, and the rest are the survivors */
+  for(i=0;i<Nlive;i++) order[i]=i;
+  for(k=0;k<Nbatch;k++){
+    UINT4 min=k;
+    for(i=k+1;i<Nlive;i++)
+      if(logLikelihoods[order[i]]<logLikelihoods[order[min]]) min=i;
+    UINT4 tmp=order[k]; order[k]=order[min]; order[min]=tmp;
+  }
+
+  for(k=0;k<Nbatch;k++){
+    logZ=incrementEvidenceSamples(runState->GSLrandom, Nlive-k, logLikelihoods[order[k]], s);
+    if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[order[k]]);
+  }
+  REAL8 bound = samplePrior ? -INFINITY : logLikelihoods[order[Nbatch-1]];
+
+  /* Evolve the replacements, each from a randomly chosen survivor */
+  #pragma omp parallel for num_threads(Nbatch) schedule(dynamic,1)
+  for(k=0;k<Nbatch;k++)
+  {
+    LALInferenceThreadState *thread=&runState->threads[k];
+    do{
+      UINT4 j=order[Nbatch+gsl_rng_uniform_int(thread->GSLrandom,Nlive-Nbatch)];
+      LALInferenceCopyVariables(runState->livePoints[j],thread->currentParams);
+      thread->currentLikelihood=logLikelihoods[j];
+      NestedSamplingSloppySampleThread(runState,thread,thread->GSLrandom,bound,Nmcmc,&sloppyfrac[k],&accept_rate[k],&sub_accept_rate[k]);
+    }while(thread->currentLikelihood<=bound || accept_rate[k]==0.0);
+  }
+
+  REAL8 logw=mean(s->logwarray->data,s->size);
+  REAL8 mean_accept=0,mean_sub_accept=0,mean_sloppy=0;
+  for(k=0;k<Nbatch;k++){
+    LALInferenceThreadState *thread=&runState->threads[k];
+    LALInferenceCopyVariables(thread->currentParams,runState->livePoints[order[k]]);
+    logLikelihoods[order[k]]=thread->currentLikelihood;
+    LALInferenceAddVariable(runState->livePoints[order[k]],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    if(thread->currentLikelihood>*logLmax) *logLmax=thread->currentLikelihood;
+    mean_accept+=accept_rate[k]/Nbatch;
+    mean_sub_accept+=sub_accept_rate[k]/Nbatch;
+    mean_sloppy+=sloppyfrac[k]/Nbatch;
+  }
+  /* Summary statistics for progress output and checkpointing */
+  LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&bound);
+  LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&mean_accept);
+  LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&mean_sub_accept);
+  LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&mean_sloppy);
+
+  XLALFree(order);
+  *logLmin=bound;
+  return logZ;
+}
+
 /* NestedSamplingAlgorithm implements the nested sampling algorithm,
  see e.g. Sivia & Skilling "Data Analysis: A Bayesian Tutorial, 2nd edition.
  REQUIREMENTS:
@@ -725,7 +884,7 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 {
-  UINT4 iter=0,i,j,minpos;
+  UINT4 iter=0,i,j,minpos,Nbatch=1,nreplaced=1;
   /* Single thread here */
   LALInferenceThreadState *threadState = &runState->threads[0];
   UINT4 HDFOUTPUT=1;
@@ -741,6 +900,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   REAL8 *logLikelihoods=NULL;
   UINT4 verbose=0;
   REAL8 sloppyfrac;
+  REAL8 *batchsloppyfrac=NULL;
   UINT4 displayprogress=0;
   LALInferenceVariables *currentVars=XLALCalloc(1,sizeof(LALInferenceVariables));
   UINT4 samplePrior=0; //If this flag is set to a positive integer, code will just draw this many samples from the prior
@@ -777,6 +937,10 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   if(LALInferenceCheckVariable(runState->algorithmParams,"Nruns"))
     Nruns = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nruns");
 
+  /* Replace several live points per iteration if requested */
+  if(LALInferenceCheckVariable(runState->algorithmParams,"Nbatch"))
+    Nbatch = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nbatch");
+
   /* Create workspace for arrays */
   NSintegralState *s=NULL;
 
@@ -834,9 +998,11 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   SetupEigenProposals(runState);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
-  syncLivePointsDifferentialPoints(runState,threadState);
-  threadState->differentialPointsSkip=1;
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
+    runState->threads[t].differentialPointsSkip=1;
+  }
 
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
@@ -937,6 +1103,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   minpos=0;
   threadState->currentParams=currentVars;
+  if(Nbatch>1)
+  {
+    /* Each thread adapts its own sloppy fraction */
+    batchsloppyfrac=XLALMalloc(Nbatch*sizeof(REAL8));
+    for(i=0;i<Nbatch;i++)
+      batchsloppyfrac[i]=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    fprintf(stdout,"Replacing %i live points per iteration\n",Nbatch);
+  }
   fprintf(stdout,"Starting nested sampling loop!\n");
   /* Install interrupt handler for resuming */
   if(LALInferenceGetProcParamVal(runState->commandLine,"--resume"))
@@ -945,6 +1119,17 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   /* Iterate until termination condition is met */
   do {
+    UINT4 itercounter=0;
+    if(Nbatch>1)
+    {
+      /* Replace the Nbatch lowest points in parallel */
+      logZ=NestedSamplingBatchReplace(runState,s,Nbatch,batchsloppyfrac,samplePrior,&logLmin,&logLmax);
+      H=mean(Harray,Nruns);
+      itercounter=1;
+      nreplaced=Nbatch;
+    }
+    else
+    {
     /* Find minimum likelihood sample to replace */
     minpos=0;
     for(i=1;i<Nlive;i++){
@@ -959,7 +1144,6 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     H=mean(Harray,Nruns);
     logZ=logZnew;
     if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
-    UINT4 itercounter=0;
 
     /* Generate a new live point */
     do{ /* This loop is here in case it is necessary to find a different sample */
@@ -980,6 +1164,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 
   logw=mean(logwarray,Nruns);
   LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    }
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -996,7 +1181,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=nreplaced;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1011,8 +1196,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     exit(CondorExitCode);
   }
 
-  /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  /* Update the proposal every Nlive/10 replacements */
+  if(iter/(Nlive/10) != (iter-nreplaced)/(Nlive/10)) {
     /* Update the covariance matrix */
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
       SetupEigenProposals(runState);
@@ -1022,7 +1207,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     UpdateNMCMC(runState);
 
     /* Sync the live points to differential points */
-    syncLivePointsDifferentialPoints(runState,threadState);
+    for(INT4 t=0;t<runState->nthreads;t++)
+      syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
 
     /* Output some information */
     if(verbose){
@@ -1150,6 +1336,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   
   /* Free memory */
   XLALFree(logtarray); XLALFree(logwarray); XLALFree(logZarray);
+  if(batchsloppyfrac) XLALFree(batchsloppyfrac);
 }
 
 /* Calculate the autocorrelation function of the sampler (runState->evolve) for each parameter
@@ -1334,11 +1521,10 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   return(acls);
 }
 
-/* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
-UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+/* Perform one MCMC iteration on threadState->currentParams, drawing random
+ * numbers from rng. Return 1 if accepted or 0 if not */
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin)
 {
-    /* Single threaded here */
-    LALInferenceThreadState * threadState=&runState->threads[0];
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1346,7 +1532,6 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     //LALInferenceVariables *oldParams=&tempParams;
     LALInferenceVariables proposedParams;
     memset(&proposedParams,0,sizeof(proposedParams));
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
     REAL8 thislogL=-INFINITY;
     UINT4 accepted=0;
 
@@ -1360,7 +1545,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(rng)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1387,6 +1572,14 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     return(accepted);
 }
 
+/* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
+UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+{
+    /* Single threaded here */
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    return(MCMCSamplePriorThread(runState,&runState->threads[0],runState->GSLrandom,logLmin));
+}
+
 /* Sample the prior N times, returns number of acceptances */
 UINT4 LALInferenceMCMCSamplePriorNTimes(LALInferenceRunState *runState, UINT4 N)
 {
@@ -1479,14 +1672,14 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
 
 /* Sample the limited prior distribution using the MCMC method as usual, but
    only check the likelihood bound x fraction of the time. Always returns a fulled checked sample.
-   x=LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction")
+   Operates on threadState, drawing random numbers from rng, and only reads
+   from runState->algorithmParams so several threads can run it at once.
+   x=*sloppyfraction is adapted on return, and the acceptance rates are
+   returned in *accept_rate and *sub_accept_rate.
    */
-
-INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin, UINT4 Nmcmc, REAL8 *sloppyfraction_ptr, REAL8 *accept_rate_ptr, REAL8 *sub_accept_rate_ptr)
 {
     LALInferenceVariables oldParams;
-    /* Single thread here */
-    LALInferenceThreadState *threadState = &runState->threads[0];
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1494,14 +1687,10 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 logLold=*(REAL8 *)LALInferenceGetVariable(threadState->currentParams,"logL");
     memset(&oldParams,0,sizeof(oldParams));
     LALInferenceCopyVariables(threadState->currentParams,&oldParams);
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
-    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
     REAL8 maxsloppyfraction=((REAL8)Nmcmc-1)/(REAL8)Nmcmc ;
-    REAL8 sloppyfraction=maxsloppyfraction/2.0;
+    REAL8 sloppyfraction=*sloppyfraction_ptr;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1527,7 +1716,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=MCMCSamplePriorThread(runState,threadState,rng,logLmin);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1599,8 +1788,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     /* Compute some statistics for information */
     REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
     REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    *accept_rate_ptr=accept_rate;
+    *sub_accept_rate_ptr=sub_accept_rate;
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
         if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
@@ -1608,7 +1797,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	*sloppyfraction_ptr=sloppyfraction;
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1616,6 +1805,31 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     return Naccepted;
 }
 
+/* Sample the limited prior distribution using the MCMC method as usual, but
+   only check the likelihood bound x fraction of the time. Always returns a fulled checked sample.
+   x=LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction")
+   */
+
+INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+{
+    /* Single thread here */
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+    REAL8 sloppyfraction=(((REAL8)Nmcmc-1)/(REAL8)Nmcmc)/2.0;
+    REAL8 accept_rate=0,sub_accept_rate=0;
+    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+
+    INT4 Naccepted=NestedSamplingSloppySampleThread(runState,&runState->threads[0],runState->GSLrandom,logLmin,Nmcmc,&sloppyfraction,&accept_rate,&sub_accept_rate);
+
+    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    if(isfinite(logLmin))
+      LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+
+    return Naccepted;
+}
+
 
 /* Evolve nested sampling algorithm by one step, i.e.
  evolve runState->currentParams to a new point with higher
@@ -1676,10 +1890,8 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 }
 
 
-static void SetupEigenProposals(LALInferenceRunState *runState)
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
   gsl_matrix *eVectors=NULL;
   gsl_vector *eValues =NULL;
   REAL8Vector *eigenValues=NULL;
@@ -1737,6 +1949,13 @@ static void SetupEigenProposals(LALInferenceRunState *runState)
   XLALFree(cvm);
 }
 
+/* Set up the eigenvector proposals of every thread from the live points */
+static void SetupEigenProposals(LALInferenceRunState *runState)
+{
+  for(INT4 t=0;t<runState->nthreads;t++)
+    SetupEigenProposalsThread(runState,&runState->threads[t]);
+}
+
 
 static int syncLivePointsDifferentialPoints(LALInferenceRunState *state, LALInferenceThreadState *thread)
 {
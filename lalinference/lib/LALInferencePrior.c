@@ -675,14 +675,14 @@ REAL8 LALInferenceInspiralPrior(LALInferenceRunState *runState, LALInferenceVari
   if((LALInferenceCheckVariable(params,"logp1")&&LALInferenceCheckVariable(params,"gamma1")&&LALInferenceCheckVariable(params,"gamma2")&&LALInferenceCheckVariable(params,"gamma3")))
   {
     /*If EOS params and masses are aphysical, return -INFINITY to ensure point is rejected*/
-    if(LALInferenceEOSPhysicalCheck(params,runState->commandLine)==XLAL_FAILURE){
+    if(LALInferenceEOSPhysicalCheckCached(model ? model->eos_cache : NULL,params,runState->commandLine)==XLAL_FAILURE){
        return -INFINITY;
     }
   }
   else if((LALInferenceCheckVariable(params,"SDgamma0")&&LALInferenceCheckVariable(params,"SDgamma1")&&LALInferenceCheckVariable(params,"SDgamma2")&&LALInferenceCheckVariable(params,"SDgamma3")))
   {
     /*If EOS params and masses are aphysical, return -INFINITY to ensure point is rejected*/
-    if(LALInferenceEOSPhysicalCheck(params,runState->commandLine)==XLAL_FAILURE){
+    if(LALInferenceEOSPhysicalCheckCached(model ? model->eos_cache : NULL,params,runState->commandLine)==XLAL_FAILURE){
        return -INFINITY;
     }
   }
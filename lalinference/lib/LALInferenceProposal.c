@@ -470,7 +470,10 @@ LALInferenceVariables *LALInferenceParseProposalArgs(LALInferenceRunState *runSt
     if (singleadapt){
       LALInferenceModel *model = LALInferenceInitCBCModel(runState);
       LALInferenceSetupAdaptiveProposals(propArgs, model->params);
-      XLALFree(model);
+      UINT4 nifo = 0;
+      for (LALInferenceIFOData *data = runState->data; data; data = data->next)
+          nifo++;
+      LALInferenceDestroyModel(model, nifo);
     }
 
     /* Setup now since we need access to the data */
@@ -864,6 +867,99 @@ REAL8 LALInferenceEnsembleStretchExtrinsic(LALInferenceThreadState *thread,
     return logPropRatio;
 }
 
+/*
+ * Packed DE buffer to draw history points from.  If "de_cross_chain" is set in
+ * the proposal arguments this is the buffer of a randomly chosen chain of this
+ * process, which is read without locking while that chain continues to run.
+ */
+static const LALInferenceDEBuffer *DEBufferToDraw(LALInferenceThreadState *thread) {
+    const LALInferenceDEBuffer *buffer = thread->deBuffer;
+
+    if (LALInferenceCheckVariable(thread->proposalArgs, "de_cross_chain") &&
+        LALInferenceGetINT4Variable(thread->proposalArgs, "de_cross_chain") &&
+        thread->parent != NULL && thread->parent->nthreads > 1) {
+        const LALInferenceDEBuffer *other = thread->parent->threads[gsl_rng_uniform_int(thread->GSLrandom, thread->parent->nthreads)].deBuffer;
+        if (other != NULL && other->dim == buffer->dim)
+            buffer = other;
+    }
+
+    return buffer;
+}
+
+/* Ensemble stretch about a point drawn from the packed DE buffer */
+static REAL8 EnsembleStretchPacked(LALInferenceThreadState *thread,
+                                   LALInferenceVariables *currentParams,
+                                   LALInferenceVariables *proposedParams,
+                                   const char **names) {
+    const LALInferenceDEBuffer *buffer = DEBufferToDraw(thread);
+    const REAL8 maxScale = 3.0;
+    size_t i, Ndim = 0;
+
+    REAL8 *ptI = alloca(buffer->dim * sizeof(REAL8));
+    if (LALInferenceDEBufferDrawPoints(buffer, thread->GSLrandom, 1, &ptI) == 0)
+        return 0.0; /* Quit now, since we don't have any points to use. */
+
+    LALInferenceCopyVariables(currentParams, proposedParams);
+
+    /* Draw scale uniform in log between 1/max and max, as in the unpacked jump */
+    REAL8 logmax = log(maxScale);
+    REAL8 scale = exp(2.0*logmax*gsl_rng_uniform(thread->GSLrandom) - logmax);
+
+    for (i = 0; names[i] != NULL; i++) {
+        if (!LALInferenceCheckVariableNonFixed(currentParams, names[i]))
+            continue;
+        INT4 p = LALInferenceDEBufferIndex(buffer, names[i]);
+        if (p < 0)
+            continue; /* Ignore variable if it's not stored in the buffer. */
+        REAL8 x = ptI[p] + scale*(LALInferenceGetREAL8Variable(currentParams, names[i]) - ptI[p]);
+        LALInferenceSetVariable(proposedParams, names[i], &x);
+        Ndim++;
+    }
+
+    if (scale < maxScale && scale > (1.0/maxScale))
+        return log(scale)*((REAL8)Ndim);
+    else
+        return -INFINITY;
+}
+
+/* Ensemble walk using points drawn from the packed DE buffer */
+static REAL8 EnsembleWalkPacked(LALInferenceThreadState *thread,
+                                LALInferenceVariables *currentParams,
+                                LALInferenceVariables *proposedParams,
+                                const char **names, size_t sample_size) {
+    const LALInferenceDEBuffer *buffer = DEBufferToDraw(thread);
+    size_t i, k;
+
+    REAL8 *pts[sample_size];
+    REAL8 *store = alloca(sample_size * buffer->dim * sizeof(REAL8));
+    for (i = 0; i < sample_size; i++)
+        pts[i] = store + i*buffer->dim;
+    if (LALInferenceDEBufferDrawPoints(buffer, thread->GSLrandom, sample_size, pts) == 0)
+        return 0.0; /* Quit now, since we don't have any points to use. */
+
+    LALInferenceCopyVariables(currentParams, proposedParams);
+
+    double univariate_normals[sample_size];
+    for (i = 0; i < sample_size; i++) univariate_normals[i] = gsl_ran_ugaussian(thread->GSLrandom);
+
+    for (k = 0; names[k] != NULL; k++) {
+        if (!LALInferenceCheckVariableNonFixed(proposedParams, names[k]))
+            continue;
+        INT4 p = LALInferenceDEBufferIndex(buffer, names[k]);
+        if (p < 0)
+            continue; /* Ignore variable if it's not stored in the buffer. */
+        REAL8 centre_of_mass = 0.0, w = 0.0;
+        for (i = 0; i < sample_size; i++)
+            centre_of_mass += pts[i][p]/((REAL8)sample_size);
+        for (i = 0; i < sample_size; i++)
+            w += univariate_normals[i] * (pts[i][p] - centre_of_mass);
+        REAL8 tmp = LALInferenceGetREAL8Variable(proposedParams, names[k]) + w;
+        LALInferenceSetVariable(proposedParams, names[k], &tmp);
+    }
+
+    return 0.0;
+}
+
 /* This jump uses the current sample 'A' and another randomly
  * drawn 'B' from the ensemble of live points, and proposes
  * C = B+Z(A-B) where Z is a scale factor */
@@ -910,6 +1006,9 @@ REAL8 LALInferenceEnsembleStretchNames(LALInferenceThreadState *thread,
             Ndim++;
     }
 
+    if (thread->deBuffer)
+        return EnsembleStretchPacked(thread, currentParams, proposedParams, names);
+
     dePts = thread->differentialPoints;
     nPts = thread->differentialPointsLength;
 
@@ -1017,6 +1116,9 @@ REAL8 LALInferenceEnsembleWalkNames(LALInferenceThreadState *thread,
   size_t k=0;
   size_t sample_size=3;
 
+  if (thread->deBuffer)
+    return EnsembleWalkPacked(thread, currentParams, proposedParams, names, sample_size);
+
   LALInferenceVariables **dePts = thread->differentialPoints;
   size_t nPts = thread->differentialPointsLength;
 
@@ -1061,6 +1163,54 @@ REAL8 LALInferenceEnsembleWalkNames(LALInferenceThreadState *thread,
   return logPropRatio;
 }
 
+/* Scale of a differential evolution jump along the difference vector */
+static REAL8 DifferentialEvolutionScale(gsl_rng *rng, size_t Ndim) {
+    const REAL8 modeHoppingFrac = 0.5;
+    /* Some fraction of the time, we do a "mode hopping" jump,
+       where we jump exactly along the difference vector. */
+    if (gsl_rng_uniform(rng) < modeHoppingFrac)
+        return 1.0;
+
+    /* Otherwise scale is chosen uniform in log between 0.1 and 10 times the
+    desired jump size. */
+    return 2.38/sqrt(Ndim) * exp(log(0.1) + log(100.0) * gsl_rng_uniform(rng));
+}
+
+/*
+ * Differential evolution jump drawing from packed DE buffers.  The difference
+ * vector is taken from the buffer chosen by DEBufferToDraw().
+ */
+static REAL8 DifferentialEvolutionPacked(LALInferenceThreadState *thread,
+                                         LALInferenceVariables *currentParams,
+                                         LALInferenceVariables *proposedParams,
+                                         const char **names, size_t Ndim) {
+    gsl_rng *rng = thread->GSLrandom;
+    const LALInferenceDEBuffer *buffer = DEBufferToDraw(thread);
+    size_t i;
+
+    REAL8 *ptI = alloca(2 * buffer->dim * sizeof(REAL8));
+    REAL8 *ptJ = ptI + buffer->dim;
+    if (LALInferenceDEBufferDrawPair(buffer, rng, ptI, ptJ) == 0)
+        return 0.0; /* Quit now, since we don't have any points to use. */
+
+    LALInferenceCopyVariables(currentParams, proposedParams);
+
+    REAL8 scale = DifferentialEvolutionScale(rng, Ndim);
+
+    for (i = 0; names[i] != NULL; i++) {
+        if (!LALInferenceCheckVariableNonFixed(currentParams, names[i]))
+            continue;
+        INT4 p = LALInferenceDEBufferIndex(buffer, names[i]);
+        if (p < 0)
+            continue; /* Ignore variable if it's not stored in the buffer. */
+        REAL8 x = LALInferenceGetREAL8Variable(currentParams, names[i]);
+        x += scale * (ptJ[p] - ptI[p]);
+        LALInferenceSetVariable(proposedParams, names[i], &x);
+    }
+
+    return 0.0;
+}
+
 REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
                                     LALInferenceVariables *currentParams,
                                     LALInferenceVariables *proposedParams,
@@ -1101,6 +1251,9 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
             Ndim++;
     }
 
+    if (thread->deBuffer)
+        return DifferentialEvolutionPacked(thread, currentParams, proposedParams, names, Ndim);
+
     dePts = thread->differentialPoints;
     nPts = thread->differentialPointsLength;
 
@@ -1118,16 +1271,7 @@ REAL8 LALInferenceDifferentialEvolutionNames(LALInferenceThreadState *thread,
     ptI = dePts[i];
     ptJ = dePts[j];
 
-    const REAL8 modeHoppingFrac = 0.5;
-    /* Some fraction of the time, we do a "mode hopping" jump,
-       where we jump exactly along the difference vector. */
-    if (gsl_rng_uniform(rng) < modeHoppingFrac) {
-        scale = 1.0;
-    } else {
-        /* Otherwise scale is chosen uniform in log between 0.1 and 10 times the
-        desired jump size. */
-        scale = 2.38/sqrt(Ndim) * exp(log(0.1) + log(100.0) * gsl_rng_uniform(rng));
-    }
+    scale = DifferentialEvolutionScale(rng, Ndim);
 
     for (i = 0; names[i] != NULL; i++) {
         if (!LALInferenceCheckVariableNonFixed(currentParams, names[i]) ||
@@ -3275,6 +3419,41 @@ void LALInferenceDestroyClusteredKDEProposal(LALInferenceClusteredKDE *proposal)
 }
 
 
+/* Build a clustered-KDE proposal from samples of a run, to which every
+ * thin-th sample later added to the differential evolution buffer is
+ * added (none if thin is 0) */
+static void setup_clustered_kde_proposal_from_run(LALInferenceThreadState *thread, REAL8 *samples, INT4 size, INT4 cyclic_reflective, INT4 ntrials, INT4 thin) {
+    REAL8 weight=2.;
+
+    /* Keep track of clustered parameter names */
+    LALInferenceVariables *backwardClusterParams = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceVariables *clusterParams = XLALCalloc(1, sizeof(LALInferenceVariables));
+    LALInferenceVariableItem *item;
+    for (item = thread->currentParams->head; item; item = item->next)
+        if (LALInferenceCheckVariableNonFixed(thread->currentParams, item->name))
+            LALInferenceAddVariable(backwardClusterParams, item->name, item->value, item->type, item->vary);
+    for (item = backwardClusterParams->head; item; item = item->next)
+        LALInferenceAddVariable(clusterParams, item->name, item->value, item->type, item->vary);
+
+    /* Build the proposal */
+    LALInferenceClusteredKDE *proposal = XLALCalloc(1, sizeof(LALInferenceClusteredKDE));
+    LALInferenceInitClusteredKDEProposal(thread, proposal, samples, size, clusterParams, clusteredKDEProposalName, weight, LALInferenceOptimizedKmeans, cyclic_reflective, ntrials);
+
+    proposal->thin = thin;
+
+    /* Only add the kmeans was successfully setup */
+    if (proposal->kmeans)
+        LALInferenceAddClusteredKDEProposalToSet(thread->proposalArgs, proposal);
+    else {
+        LALInferenceClearVariables(clusterParams);
+        XLALFree(clusterParams);
+        XLALFree(proposal);
+    }
+
+    LALInferenceClearVariables(backwardClusterParams);
+    XLALFree(backwardClusterParams);
+}
+
 /**
  * Setup a clustered-KDE proposal from the differential evolution buffer.
  *
@@ -3286,7 +3465,7 @@ void LALInferenceSetupClusteredKDEProposalFromDEBuffer(LALInferenceThreadState *
     INT4 i;
 
     /* If ACL can be estimated, thin DE buffer to only have independent samples */
-    REAL8 bufferSize = (REAL8) thread->differentialPointsLength;
+    REAL8 bufferSize = (REAL8) LALInferenceDifferentialPointsLength(thread);
     REAL8 effSampleSize = (REAL8) LALInferenceComputeEffectiveSampleSize(thread);
 
     /* Correlations wont effect the proposal much, so floor is taken instead of ceil
@@ -3311,8 +3490,10 @@ void LALInferenceSetupClusteredKDEProposalFromDEBuffer(LALInferenceThreadState *
     /* Check if imposing cyclic reflective bounds */
     INT4 cyclic_reflective = LALInferenceGetINT4Variable(thread->proposalArgs, "cyclic_reflective_kde");
 
+    /* Samples added to the buffer until the next rebuild are added to the
+     * proposal with the same thinning */
     INT4 ntrials = 5;
-    LALInferenceSetupClusteredKDEProposalFromRun(thread, DEsamples[0], nPoints, cyclic_reflective, ntrials);
+    setup_clustered_kde_proposal_from_run(thread, DEsamples[0], nPoints, cyclic_reflective, ntrials, step);
 
     /* The proposal copies the data, so the local array can be freed */
     XLALFree(temp);
@@ -3332,33 +3513,50 @@ void LALInferenceSetupClusteredKDEProposalFromDEBuffer(LALInferenceThreadState *
  * @param ntrials  Number of tirals at fixed-k to find optimal BIC
  */
 void LALInferenceSetupClusteredKDEProposalFromRun(LALInferenceThreadState *thread, REAL8 *samples, INT4 size, INT4 cyclic_reflective, INT4 ntrials) {
-    REAL8 weight=2.;
+    setup_clustered_kde_proposal_from_run(thread, samples, size, cyclic_reflective, ntrials, 0);
+}
 
-    /* Keep track of clustered parameter names */
-    LALInferenceVariables *backwardClusterParams = XLALCalloc(1, sizeof(LALInferenceVariables));
-    LALInferenceVariables *clusterParams = XLALCalloc(1, sizeof(LALInferenceVariables));
+
+/**
+ * Add the latest sample of the differential evolution buffer to the
+ * clustered-KDE proposal built from the buffer.
+ *
+ * Between rebuilds by LALInferenceSetupClusteredKDEProposalFromDEBuffer(), the
+ * current parameters are inserted into the existing estimate each time they are
+ * added to the buffer, thinned as the buffer was when the proposal was built,
+ * without reclustering or retuning the kernel bandwidths.
+ * @param thread The LALInferenceThreadState whose current parameters were just
+ *               added to its differential evolution buffer.
+ */
+void LALInferenceClusteredKDEProposalAddSample(LALInferenceThreadState *thread) {
     LALInferenceVariableItem *item;
-    for (item = thread->currentParams->head; item; item = item->next)
-        if (LALInferenceCheckVariableNonFixed(thread->currentParams, item->name))
-            LALInferenceAddVariable(backwardClusterParams, item->name, item->value, item->type, item->vary);
-    for (item = backwardClusterParams->head; item; item = item->next)
-        LALInferenceAddVariable(clusterParams, item->name, item->value, item->type, item->vary);
 
-    /* Build the proposal */
-    LALInferenceClusteredKDE *proposal = XLALCalloc(1, sizeof(LALInferenceClusteredKDE));
-    LALInferenceInitClusteredKDEProposal(thread, proposal, samples, size, clusterParams, clusteredKDEProposalName, weight, LALInferenceOptimizedKmeans, cyclic_reflective, ntrials);
+    if (!LALInferenceCheckVariable(thread->proposalArgs, clusteredKDEProposalName))
+        return;
 
-    /* Only add the kmeans was successfully setup */
-    if (proposal->kmeans)
-        LALInferenceAddClusteredKDEProposalToSet(thread->proposalArgs, proposal);
-    else {
-        LALInferenceClearVariables(clusterParams);
-        XLALFree(clusterParams);
-        XLALFree(proposal);
+    LALInferenceClusteredKDE *kde = *((LALInferenceClusteredKDE **)LALInferenceGetVariable(thread->proposalArgs, clusteredKDEProposalName));
+    while (kde != NULL && kde->thin == 0)
+        kde = kde->next;
+
+    if (kde == NULL || ++kde->nskipped < kde->thin)
+        return;
+    kde->nskipped = 0;
+
+    REAL8 *sample = XLALCalloc(kde->dimension, sizeof(REAL8));
+    INT4 i=0;
+    for (item = kde->params->head; item; item = item->next) {
+        if (LALInferenceCheckVariableNonFixed(kde->params, item->name)) {
+            sample[i] = *(REAL8 *) LALInferenceGetVariable(thread->currentParams, item->name);
+            i++;
+        }
     }
 
-    LALInferenceClearVariables(backwardClusterParams);
-    XLALFree(backwardClusterParams);
+    if (LALInferenceKmeansAddPoint(kde->kmeans, sample) != XLAL_SUCCESS) {
+        fprintf(stderr, "ERROR: Unable to add sample to clustered-KDE proposal.\n");
+        exit(-1);
+    }
+
+    XLALFree(sample);
 }
 
 
@@ -3486,7 +3684,7 @@ void LALInferenceComputeMaxAutoCorrLenFromDE(LALInferenceThreadState *thread, IN
     REAL8 max_acl;
 
     nPar = LALInferenceGetVariableDimensionNonFixed(thread->currentParams);
-    nPoints = thread->differentialPointsLength;
+    nPoints = LALInferenceDifferentialPointsLength(thread);
 
     /* Determine the number of iterations between each entry in the DE buffer */
     nSkip = thread->differentialPointsSkip;
@@ -3610,7 +3808,7 @@ INT4 LALInferenceComputeEffectiveSampleSize(LALInferenceThreadState *thread) {
     }
 
     /* Estimate the total number of samples post-burnin based on samples in DE buffer */
-    INT4 nPoints =  thread->differentialPointsLength * thread->differentialPointsSkip;
+    INT4 nPoints =  LALInferenceDifferentialPointsLength(thread) * thread->differentialPointsSkip;
     INT4 iEff = nPoints/acl;
     return iEff;
 }
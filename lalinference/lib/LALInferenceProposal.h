@@ -277,6 +277,9 @@ tagLALInferenceClusteredKDEProposal
     REAL8 weight;
     INT4 dimension;
     LALInferenceVariables *params;
+    INT4 thin;      /**< Add every \a thin-th sample of the differential evolution buffer
+                         to the estimate (0 if it is not built from the buffer) */
+    INT4 nskipped;  /**< Buffer samples skipped since the last one was added */
     struct tagLALInferenceClusteredKDEProposal *next;
 } LALInferenceClusteredKDE;
 
@@ -298,6 +301,9 @@ void LALInferenceSetupClusteredKDEProposalFromDEBuffer(LALInferenceThreadState *
 /* Setup a clustered-KDE proposal from the parameters in a run. */
 void LALInferenceSetupClusteredKDEProposalFromRun(LALInferenceThreadState *thread, REAL8 *samples, INT4 size, INT4 cyclic_reflective, INT4 ntrials);
 
+/* Add a sample of the differential evolution buffer to the clustered-KDE proposal built from it. */
+void LALInferenceClusteredKDEProposalAddSample(LALInferenceThreadState *thread);
+
 /* A proposal based on the clustered kernal density estimate of a set of samples. */
 REAL8 LALInferenceClusteredKDEProposal(LALInferenceThreadState *thread, LALInferenceVariables *currentParams, LALInferenceVariables *proposedParams);
 REAL8 LALInferenceStoredClusteredKDEProposal(LALInferenceThreadState *thread, LALInferenceVariables *currentParams, LALInferenceVariables *proposedParams, REAL8 *propDensity);
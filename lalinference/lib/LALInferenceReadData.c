@@ -2592,7 +2592,6 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
     while (thisData) {
       thisData->roq = XLALMalloc(sizeof(LALInferenceROQData));
 
-      thisData->roq->weights_linear = XLALMalloc(n_basis_linear*sizeof(LALInferenceROQSplineWeights));
 
       sprintf(tmp, "--%s-roqweightsLinear", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
@@ -2604,7 +2603,12 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
 	fprintf(stderr, "Error code %i: %s\n", errsave, strerror(errsave));
 	exit(errsave);
       }
-      thisData->roq->weightsLinear = (double complex*)malloc(n_basis_linear*time_steps*(sizeof(double complex)));
+      thisData->roq->weightsLinear = NULL;
+      LALInferenceROQLinearWeights *linear_weights = XLALMalloc(sizeof(LALInferenceROQLinearWeights));
+      linear_weights->n_nodes = n_basis_linear;
+      linear_weights->n_times = time_steps;
+      linear_weights->weights = XLALMalloc(n_basis_linear*time_steps*sizeof(COMPLEX16));
+      thisData->roq->linear_weights = linear_weights;
 
       //0.045 comes from the diameter of the earth in light seconds: the maximum time-delay between earth-based observatories
       thisData->roq->time_weights_width = 2*dt + 2*0.045;
@@ -2615,9 +2619,6 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
       fprintf(stderr, "basis_size = %d\n", n_basis_linear);
       fprintf(stderr, "time steps = %d\n", time_steps);
 
-      double *tmp_real_weight = malloc(time_steps*(sizeof(double)));
-      double *tmp_imag_weight = malloc(time_steps*(sizeof(double)));
-
       double *tmp_tcs = malloc(time_steps*(sizeof(double)));
 
       sprintf(tmp, "--roq-times");
@@ -2635,26 +2636,31 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
 	fread(&(tmp_tcs[gg]), sizeof(double), 1, tcFile);
       }
 
+      /* The likelihood interpolates the weights on a uniform time grid */
+      if (time_steps < 4) {
+	fprintf(stderr, "Error: need at least 4 ROQ time steps, got %u\n", time_steps);
+	exit(1);
+      }
+      linear_weights->t0 = tmp_tcs[0];
+      linear_weights->dt = (tmp_tcs[time_steps-1] - tmp_tcs[0])/(time_steps-1);
+      for(unsigned int gg=1;gg < time_steps; gg++){
+	if (fabs(tmp_tcs[gg] - tmp_tcs[gg-1] - linear_weights->dt) > 1e-6*fabs(linear_weights->dt)) {
+	  fprintf(stderr, "Error: ROQ times are not uniformly spaced (step %u)\n", gg);
+	  exit(1);
+	}
+      }
+
+      /* The file is node-major; store time-major so that all the nodes at
+         one time step are contiguous */
       for(unsigned int ii=0; ii<n_basis_linear;ii++){
 	for(unsigned int jj=0; jj<time_steps;jj++){
-	  fread(&(thisData->roq->weightsLinear[ii*time_steps + jj]), sizeof(double complex), 1, thisData->roq->weightsFileLinear);
-	  tmp_real_weight[jj] = creal(thisData->roq->weightsLinear[ii*time_steps + jj]);
-	  tmp_imag_weight[jj] = cimag(thisData->roq->weightsLinear[ii*time_steps + jj]);
+	  fread(&(linear_weights->weights[jj*n_basis_linear + ii]), sizeof(double complex), 1, thisData->roq->weightsFileLinear);
 	}
-  //gsl_interp_accel is not thread-safe, and each OpenMP thread will need its
-  //own gsl_interp_accel object.
-	thisData->roq->weights_linear[ii].acc_real_weight_linear = NULL;
- 	thisData->roq->weights_linear[ii].acc_imag_weight_linear = NULL;
-
-	thisData->roq->weights_linear[ii].spline_real_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_real_weight_linear, tmp_tcs, tmp_real_weight, time_steps);
-
-        thisData->roq->weights_linear[ii].spline_imag_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_imag_weight_linear, tmp_tcs, tmp_imag_weight, time_steps);
       }
       fclose(thisData->roq->weightsFileLinear);
       thisData->roq->weightsFileLinear = NULL;
       fclose(tcFile);
+      free(tmp_tcs);
 
       sprintf(tmp, "--%s-roqweightsQuadratic", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
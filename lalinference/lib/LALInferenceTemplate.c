@@ -222,15 +222,25 @@ static void q2masses(double mc, double q, double *m1, double *m2)
   return;
 }
 
-void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
-/*************************************************************************************************************************/
+/*
+ * Generate the plus and cross polarisations for the parameters in model->params
+ * at the frequencies in freqs1 and (optionally, if freqs2 is non-NULL) freqs2.
+ * Shared by the ROQ and relative-binning templates, which both only need the
+ * waveform at a sparse set of frequencies.
+ */
+static void LALInferenceChooseFDWaveformSequences(LALInferenceModel *model,
+                                                  COMPLEX16FrequencySeries **hptilde1,
+                                                  COMPLEX16FrequencySeries **hctilde1,
+                                                  REAL8Sequence *freqs1,
+                                                  COMPLEX16FrequencySeries **hptilde2,
+                                                  COMPLEX16FrequencySeries **hctilde2,
+                                                  REAL8Sequence *freqs2)
+{
   Approximant approximant = (Approximant) 0;
 
   int ret=0;
   INT4 errnum=0;
 
-  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
-  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
   REAL8 mc;
   REAL8 phi0, m1, m2, distance, inclination;
 
@@ -388,7 +398,10 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     gamma2 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma2");
     gamma3 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma3");
     // Find lambda1,2(m1,2|eos)
-    LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
+    if(model->eos_cache)
+      LALInferenceEOSMasses2LambdasCached(model->eos_cache,model->params,m1,m2,&lambda1,&lambda2);
+    else
+      LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -407,7 +420,10 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     SDgamma2 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma2");
     SDgamma3 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma3");
     REAL8 gamma[] = {SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-    LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
+    if(model->eos_cache)
+      LALInferenceEOSMasses2LambdasCached(model->eos_cache,model->params,m1,m2,&lambda1,&lambda2);
+    else
+      LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -452,11 +468,12 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
   /* ==== Call the waveform generator ==== */
     /* Correct distance to account for renormalisation of data due to window RMS */
     double corrected_distance = distance * sqrt(model->window->sumofsquares/model->window->data->length);
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeLinear), &(model->roq->hctildeLinear), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesLinear)), errnum);
+    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (hptilde1, hctilde1, phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
+                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, freqs1), errnum);
 
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeQuadratic), &(model->roq->hctildeQuadratic), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-							spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesQuadratic)), errnum);
+    if (freqs2)
+      XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (hptilde2, hctilde2, phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
+							spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, corrected_distance, inclination, model->LALpars, approximant, freqs2), errnum);
 
     REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
     LALInferenceSetVariable(model->params, "time", &instant);
@@ -464,6 +481,30 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
         return;
 }
 
+void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+/*************************************************************************************************************************/
+  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
+  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
+
+  LALInferenceChooseFDWaveformSequences(model,
+                                        &(model->roq->hptildeLinear), &(model->roq->hctildeLinear), model->roq->frequencyNodesLinear,
+                                        &(model->roq->hptildeQuadratic), &(model->roq->hctildeQuadratic), model->roq->frequencyNodesQuadratic);
+  return;
+}
+
+void LALInferenceRelBinWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+/*************************************************************************************************************************/
+  /* Templates from the previous call are owned by the model and replaced here */
+  if (model->relbin->hptilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+  if (model->relbin->hctilde) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+  model->relbin->hptilde=NULL, model->relbin->hctilde=NULL;
+
+  LALInferenceChooseFDWaveformSequences(model,
+                                        &(model->relbin->hptilde), &(model->relbin->hctilde), model->relbin->binEdges,
+                                        NULL, NULL, NULL);
+  return;
+}
+
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model)
 /*****************************************************/
 /* Sine-Gaussian (burst) template.                   */
@@ -858,23 +899,15 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveform(LALInferenceModel *model)
   if(model->eos_fam)
   {
       LALSimNeutronStarFamily *eos_fam = model->eos_fam;
-      REAL8 r1=0, r2=0, k2_1=0, k2_2=0, lambda1=0, lambda2=0;
+      REAL8 r1=0, r2=0, lambda1=0, lambda2=0;
       REAL8 mass_max = XLALSimNeutronStarMaximumMass(eos_fam) / LAL_MSUN_SI;
       REAL8 mass_min = XLALSimNeutronStarFamMinimumMass(eos_fam) / LAL_MSUN_SI;
 
+      /* Compute l1, l2 from mass and EOS */
       if(m1<mass_max && m1>mass_min)
-      {
-        /* Compute l1, l2 from mass and EOS */
-        r1 = XLALSimNeutronStarRadius(m1*LAL_MSUN_SI, eos_fam);
-        k2_1 = XLALSimNeutronStarLoveNumberK2(m1*LAL_MSUN_SI, eos_fam);
-        lambda1 = (2./3.)*k2_1 * pow(r1/(m1*LAL_MRSUN_SI), 5.0);
-      }
+        XLALSimNeutronStarTidalProperties(&r1, NULL, &lambda1, m1*LAL_MSUN_SI, eos_fam);
       if(m2<mass_max && m2>mass_min)
-      {
-         r2 = XLALSimNeutronStarRadius(m2*LAL_MSUN_SI, eos_fam);
-         k2_2 = XLALSimNeutronStarLoveNumberK2(m2*LAL_MSUN_SI, eos_fam);
-         lambda2 = (2./3.)*k2_2 * pow(r2/(m2*LAL_MRSUN_SI), 5.0);          
-      }
+        XLALSimNeutronStarTidalProperties(&r2, NULL, &lambda2, m2*LAL_MSUN_SI, eos_fam);
       /* Set waveform params */
       XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
       XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
@@ -923,7 +956,10 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveform(LALInferenceModel *model)
     gamma2 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma2");
     gamma3 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma3");
     // Find lambda1,2(m1,2|eos)
-    LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
+    if(model->eos_cache)
+      LALInferenceEOSMasses2LambdasCached(model->eos_cache,model->params,m1,m2,&lambda1,&lambda2);
+    else
+      LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -942,7 +978,10 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveform(LALInferenceModel *model)
     SDgamma2 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma2");
     SDgamma3 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma3");
     REAL8 gamma[] = {SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-    LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
+    if(model->eos_cache)
+      LALInferenceEOSMasses2LambdasCached(model->eos_cache,model->params,m1,m2,&lambda1,&lambda2);
+    else
+      LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
     XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
     XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
   }
@@ -1465,7 +1504,10 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveformPhaseInterpolated(LALInfer
       gamma2 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma2");
       gamma3 = *(REAL8*) LALInferenceGetVariable(model->params, "gamma3");
       // Find lambda1,2(m1,2|eos)
-      LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
+      if(model->eos_cache)
+        LALInferenceEOSMasses2LambdasCached(model->eos_cache,model->params,m1,m2,&lambda1,&lambda2);
+      else
+        LALInferenceLogp1GammasMasses2Lambdas(logp1,gamma1,gamma2,gamma3,m1,m2,&lambda1,&lambda2);
       XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
       XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
     }
@@ -1483,7 +1525,10 @@ void LALInferenceTemplateXLALSimInspiralChooseWaveformPhaseInterpolated(LALInfer
       SDgamma2 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma2");
       SDgamma3 = *(REAL8*) LALInferenceGetVariable(model->params,"SDgamma3");
       REAL8 gamma[] = {SDgamma0,SDgamma1,SDgamma2,SDgamma3};
-      LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
+      if(model->eos_cache)
+        LALInferenceEOSMasses2LambdasCached(model->eos_cache,model->params,m1,m2,&lambda1,&lambda2);
+      else
+        LALInferenceSDGammasMasses2Lambdas(gamma,m1,m2,&lambda1,&lambda2,4);
       XLALSimInspiralWaveformParamsInsertTidalLambda1(model->LALpars, lambda1);
       XLALSimInspiralWaveformParamsInsertTidalLambda2(model->LALpars, lambda2);
     }
@@ -123,6 +123,14 @@ void LALInferenceTemplateNullTimedomain(LALInferenceModel *model);
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model);
 
 void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
+
+/**
+ * Relative binning template: generates the plus and cross polarisations
+ * only at the frequencies in \c model->relbin->binEdges, storing them in
+ * \c model->relbin->hptilde and \c model->relbin->hctilde.  The parameters
+ * are the same as for LALInferenceTemplateXLALSimInspiralChooseWaveform().
+ */
+void LALInferenceRelBinWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
 /**
  * Damped Sinusoid template.
  *
@@ -266,41 +266,38 @@ double log_radial_integral(double r1, double r2, double p, double b, int k,
 }
 
 
-log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, int cosmology,
-                                                  double pmax, size_t size, int gaussian)
+/* Geometry of the lookup table, which depends only on r1, r2, k, pmax and size */
+typedef struct {
+    double xmin, xmax, ymin, ymax, vmax, umin, d;
+} log_radial_integrator_grid;
+
+static log_radial_integrator_grid log_radial_integrator_get_grid(double r1, double r2, int k, double pmax, size_t size)
 {
-    log_radial_integrator *integrator = NULL;
-    bicubic_interp *region0 = NULL;
-    cubic_interp *region1 = NULL, *region2 = NULL;
+    log_radial_integrator_grid grid;
     const double alpha = 4;
     const double p0 = 0.5 * (k >= 0 ? r2 : r1);
-    const double xmax = log(pmax);
-    const double x0 = GSL_MIN_DBL(log(p0), xmax);
-    const double xmin = x0 - (1 + M_SQRT2) * alpha;
-    const double ymax = x0 + alpha;
-    const double ymin = 2 * x0 - M_SQRT2 * alpha - xmax;
-    const double d = (xmax - xmin) / (size - 1); /* dx = dy = du */
-    const double umin = - (1 + M_SQRT1_2) * alpha;
-    const double vmax = x0 - M_SQRT1_2 * alpha;
-    
-    double *z1=calloc(size,sizeof(*z1));
-    double *z2=calloc(size,sizeof(*z2));
-    double *z0=calloc(size*size,sizeof(*z0));
-    assert(z0 && z1 && z2);
-    /*
-    for (size_t i=0;i<size;i++)
-    {
-        z0[i]=calloc(size,sizeof(*z0[i]));
-        assert(z0[i]);
-    }
-    */
+    grid.xmax = log(pmax);
+    const double x0 = GSL_MIN_DBL(log(p0), grid.xmax);
+    grid.xmin = x0 - (1 + M_SQRT2) * alpha;
+    grid.ymax = x0 + alpha;
+    grid.ymin = 2 * x0 - M_SQRT2 * alpha - grid.xmax;
+    grid.d = (grid.xmax - grid.xmin) / (size - 1); /* dx = dy = du */
+    grid.umin = - (1 + M_SQRT1_2) * alpha;
+    grid.vmax = x0 - M_SQRT1_2 * alpha;
     /* const double umax = xmax - vmax; */ /* unused */
+    return grid;
+}
+
+
+int log_radial_integrator_samples(double *z0, double r1, double r2, int k, int cosmology,
+                                  double pmax, size_t size, int gaussian)
+{
+    const log_radial_integrator_grid grid = log_radial_integrator_get_grid(r1, r2, k, pmax, size);
 
     if(cosmology) dVC_dVL_init();
-    
+
     int interrupted=0;
     OMP_BEGIN_INTERRUPTIBLE
-    integrator = malloc(sizeof(*integrator));
     /* Temporarily turn off gsl_error handler which isn't thread safe. */
     gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
 
@@ -313,8 +310,8 @@ log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, i
 
         const size_t ix = i / size;
         const size_t iy = i % size;
-        const double x = xmin + ix * d;
-        const double y = ymin + iy * d;
+        const double x = grid.xmin + ix * grid.d;
+        const double y = grid.ymin + iy * grid.d;
         const double p = exp(x);
         const double r0 = exp(y);
         const double b = 2 * gsl_pow_2(p) / r0;
@@ -322,26 +319,43 @@ log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, i
         z0[ix*size + iy] = log_radial_integral(r1, r2, p, b, k, cosmology, gaussian);
     }
     gsl_set_error_handler(old_handler);
-    
-	if (OMP_WAS_INTERRUPTED)
-        goto done;
 
-    region0 = bicubic_interp_init(z0, size, size, xmin, ymin, d, d);
+    interrupted = OMP_WAS_INTERRUPTED;
+    OMP_END_INTERRUPTIBLE
 
-    for (size_t i = 0; i < size; i ++)
-        z1[i] = z0[i*size + (size - 1)];
-    region1 = cubic_interp_init(z1, size, xmin, d);
+    if (interrupted)
+        XLAL_ERROR(XLAL_EFUNC, "interrupted while computing distance integrator");
+    return XLAL_SUCCESS;
+}
 
-    for (size_t i = 0; i < size; i ++)
-        z2[i] = z0[i*size + (size - 1 - i)];
-    region2 = cubic_interp_init(z2, size, umin, d);
 
-done:
-    interrupted = OMP_WAS_INTERRUPTED;
-    OMP_END_INTERRUPTIBLE
-    
-    free(z2); free(z1); free(z0);
-    if (interrupted || !(integrator && region0 && region1 && region2))
+log_radial_integrator *log_radial_integrator_init_from_samples(const double *z0, double r1, double r2, int k,
+                                                               double pmax, size_t size)
+{
+    log_radial_integrator *integrator = NULL;
+    bicubic_interp *region0 = NULL;
+    cubic_interp *region1 = NULL, *region2 = NULL;
+    const log_radial_integrator_grid grid = log_radial_integrator_get_grid(r1, r2, k, pmax, size);
+
+    double *z1=calloc(size,sizeof(*z1));
+    double *z2=calloc(size,sizeof(*z2));
+    integrator = malloc(sizeof(*integrator));
+
+    if (z1 && z2 && integrator)
+    {
+        region0 = bicubic_interp_init(z0, size, size, grid.xmin, grid.ymin, grid.d, grid.d);
+
+        for (size_t i = 0; i < size; i ++)
+            z1[i] = z0[i*size + (size - 1)];
+        region1 = cubic_interp_init(z1, size, grid.xmin, grid.d);
+
+        for (size_t i = 0; i < size; i ++)
+            z2[i] = z0[i*size + (size - 1 - i)];
+        region2 = cubic_interp_init(z2, size, grid.umin, grid.d);
+    }
+
+    free(z2); free(z1);
+    if (!(integrator && region0 && region1 && region2))
     {
         free(integrator);
         free(region0);
@@ -353,9 +367,9 @@ done:
     integrator->region0 = region0;
     integrator->region1 = region1;
     integrator->region2 = region2;
-    integrator->xmax = xmax;
-    integrator->ymax = ymax;
-    integrator->vmax = vmax;
+    integrator->xmax = grid.xmax;
+    integrator->ymax = grid.ymax;
+    integrator->vmax = grid.vmax;
     integrator->r1 = r1;
     integrator->r2 = r2;
     integrator->k = k;
@@ -363,6 +377,24 @@ done:
 }
 
 
+log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, int cosmology,
+                                                  double pmax, size_t size, int gaussian)
+{
+    log_radial_integrator *integrator = NULL;
+    double *z0=calloc(size*size,sizeof(*z0));
+    if (!z0)
+        XLAL_ERROR_NULL(XLAL_ENOMEM, "not enough memory to allocate integrator");
+
+    if (log_radial_integrator_samples(z0, r1, r2, k, cosmology, pmax, size, gaussian) == XLAL_SUCCESS)
+        integrator = log_radial_integrator_init_from_samples(z0, r1, r2, k, pmax, size);
+
+    free(z0);
+    if (!integrator)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    return integrator;
+}
+
+
 void log_radial_integrator_free(log_radial_integrator *integrator)
 {
     if (integrator)
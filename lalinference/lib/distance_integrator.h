@@ -43,6 +43,23 @@ double log_radial_integral(double r1, double r2, double p, double b, int k,
  */
 log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, int cosmology, double pmax, size_t size, int gaussian);
 
+/**
+ * Compute the size x size table of log distance integrals underlying a
+ * log_radial_integrator, with the same arguments as
+ * log_radial_integrator_init(), into \c z0.  Together with
+ * log_radial_integrator_init_from_samples() this allows the table to be
+ * stored and reused.
+ */
+int log_radial_integrator_samples(double *z0, double r1, double r2, int k, int cosmology,
+                                  double pmax, size_t size, int gaussian);
+
+/**
+ * Build an integrator from a table computed by log_radial_integrator_samples()
+ * with the same r1, r2, k, pmax and size.
+ */
+log_radial_integrator *log_radial_integrator_init_from_samples(const double *z0, double r1, double r2, int k,
+                                                               double pmax, size_t size);
+
 /**
  * Free an integrator
  */
@@ -0,0 +1,154 @@
+#include <math.h>
+#include <lal/XLALError.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceProposal.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_test.h>
+
+#define CAPACITY 8
+
+/* Point number i of the test chain */
+static void set_point(LALInferenceVariables *vars, INT4 i)
+{
+  LALInferenceSetREAL8Variable(vars, "a", i);
+  LALInferenceSetREAL8Variable(vars, "b", -i);
+  LALInferenceSetREAL8Variable(vars, "c", 2.0*i);
+}
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+  LALInferenceVariables vars = {0};
+  LALInferenceAddREAL8Variable(&vars, "a", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddREAL8Variable(&vars, "b", 0, LALINFERENCE_PARAM_CIRCULAR);
+  LALInferenceAddREAL8Variable(&vars, "c", 0, LALINFERENCE_PARAM_FIXED);
+  LALInferenceAddINT4Variable(&vars, "n", 0, LALINFERENCE_PARAM_LINEAR);
+
+  /* Only the non-fixed REAL8 parameters are stored */
+  LALInferenceDEBuffer *buffer = LALInferenceCreateDEBuffer(&vars, CAPACITY, 1);
+  gsl_test_int(buffer->dim, 2, "stored dimension");
+  gsl_test_int(LALInferenceDEBufferIndex(buffer, "c"), -1, "fixed parameter is not stored");
+  const INT4 ia = LALInferenceDEBufferIndex(buffer, "a");
+  const INT4 ib = LALInferenceDEBufferIndex(buffer, "b");
+  gsl_test(ia < 0 || ib < 0 || ia == ib, "varying parameters are stored");
+
+  REAL8 ptI[2], ptJ[2];
+  gsl_test_int(LALInferenceDEBufferDrawPair(buffer, rng, ptI, ptJ), 0, "no draw from an empty buffer");
+
+  /* Filling past capacity thins to every other point and doubles the skip */
+  INT4 added = 0;
+  for (INT4 i = 0; i < 3*CAPACITY; i++) {
+    if (i % buffer->skip)
+      continue;
+    set_point(&vars, i);
+    LALInferenceDEBufferAdd(buffer, &vars);
+    added++;
+  }
+  gsl_test_int(buffer->skip, 4, "thinning interval after %d additions", added);
+  gsl_test_int(LALInferenceDEBufferLength(buffer), 6, "length after %d additions", added);
+
+  REAL8 *rows[CAPACITY];
+  REAL8 store[CAPACITY][2];
+  for (UINT4 i = 0; i < CAPACITY; i++)
+    rows[i] = store[i];
+  INT4 n = LALInferenceDEBufferToArray(buffer, rows, 1);
+  /* Thinned history is in order and ends with the newest point */
+  const REAL8 expected[] = {3, 7, 10, 14, 16, 20};
+  gsl_test_int(n, XLAL_NUM_ELEM(expected), "points copied out");
+  for (INT4 i = 0; i < n; i++) {
+    gsl_test_abs(rows[i][ia], expected[i], 0.0, "point %d of thinned history", i);
+    gsl_test_abs(rows[i][ib], -expected[i], 0.0, "point %d keeps its parameters together", i);
+  }
+
+  /* Draws are of two distinct stored points */
+  for (INT4 k = 0; k < 100; k++) {
+    gsl_test_int(LALInferenceDEBufferDrawPair(buffer, rng, ptI, ptJ), n, "draw %d length", k);
+    gsl_test(ptI[ia] == ptJ[ia] || ptI[ib] != -ptI[ia] || ptJ[ib] != -ptJ[ia], "draw %d is of distinct stored points", k);
+  }
+
+  /* Stored points can be written back to the parameters */
+  LALInferenceDEBufferPointToVariables(buffer, 2, &vars);
+  gsl_test_abs(LALInferenceGetREAL8Variable(&vars, "a"), 10.0, 0.0, "point written back to parameters");
+
+  /* Several distinct points can be drawn at once, but no more than are stored */
+  REAL8 *pts[CAPACITY];
+  for (UINT4 i = 0; i < CAPACITY; i++)
+    pts[i] = store[i];
+  gsl_test_int(LALInferenceDEBufferDrawPoints(buffer, rng, n, pts), n, "draw of every stored point");
+  REAL8 sum = 0;
+  for (INT4 i = 0; i < n; i++)
+    sum += pts[i][ia];
+  gsl_test_abs(sum, 70.0, 0.0, "draw of every stored point is of distinct points");
+  gsl_test_int(LALInferenceDEBufferDrawPoints(buffer, rng, n + 1, pts), 0, "no draw of more points than are stored");
+
+  /* Ensemble jumps draw from the packed buffer and move the chain */
+  LALInferenceThreadState thread = {0};
+  LALInferenceVariables proposalArgs = {0};
+  thread.GSLrandom = rng;
+  thread.deBuffer = buffer;
+  thread.proposalArgs = &proposalArgs;
+  LALInferenceVariables proposed = {0};
+  set_point(&vars, 100);
+  for (INT4 k = 0; k < 10; k++) {
+    REAL8 logPropRatio = LALInferenceEnsembleStretchFull(&thread, &vars, &proposed);
+    REAL8 a = LALInferenceGetREAL8Variable(&proposed, "a");
+    gsl_test(a == 100.0 || LALInferenceGetREAL8Variable(&proposed, "b") != -a, "stretch %d moves along the line to a stored point", k);
+    gsl_test_abs(LALInferenceGetREAL8Variable(&proposed, "c"), 200.0, 0.0, "stretch %d leaves fixed parameter", k);
+    gsl_test(!isfinite(logPropRatio), "stretch %d proposal ratio", k);
+    LALInferenceEnsembleWalkFull(&thread, &vars, &proposed);
+    a = LALInferenceGetREAL8Variable(&proposed, "a");
+    gsl_test(a == 100.0 || LALInferenceGetREAL8Variable(&proposed, "b") != -a, "walk %d moves within the span of stored points", k);
+    gsl_test_abs(LALInferenceGetREAL8Variable(&proposed, "c"), 200.0, 0.0, "walk %d leaves fixed parameter", k);
+  }
+  LALInferenceClearVariables(&proposed);
+
+  LALInferenceDEBufferClear(buffer, 1);
+  gsl_test_int(LALInferenceDEBufferLength(buffer), 0, "cleared buffer is empty");
+  LALInferenceDestroyDEBuffer(buffer);
+
+  /* Another chain reads the buffer while it is being thinned */
+  buffer = LALInferenceCreateDEBuffer(&vars, 1024, 1);
+  INT4 torn = 0;
+#pragma omp parallel sections num_threads(2)
+  {
+#pragma omp section
+    {
+      LALInferenceVariables local = {0};
+      LALInferenceCopyVariables(&vars, &local);
+      for (INT4 i = 0; i < 100000; i++) {
+        set_point(&local, i);
+        LALInferenceDEBufferAdd(buffer, &local);
+      }
+      LALInferenceClearVariables(&local);
+    }
+#pragma omp section
+    {
+      gsl_rng *rng2 = gsl_rng_alloc(gsl_rng_mt19937);
+      REAL8 qI[2], qJ[2];
+      for (INT4 k = 0; k < 100000; k++)
+        if (LALInferenceDEBufferDrawPair(buffer, rng2, qI, qJ) && (qI[ib] != -qI[ia] || qJ[ib] != -qJ[ia]))
+          torn++;
+      gsl_rng_free(rng2);
+    }
+  }
+  gsl_test_int(torn, 0, "concurrent draws see whole points");
+
+  /* A buffer must be able to hold a pair */
+  XLALSetErrorHandler(XLALDefaultErrorHandler);
+  LALInferenceDEBuffer *bad;
+  int errnum;
+  XLAL_TRY(bad = LALInferenceCreateDEBuffer(&vars, 1, 1), errnum);
+  gsl_test(bad != NULL || errnum != XLAL_EINVAL, "capacity of one point is rejected");
+
+  LALInferenceDestroyDEBuffer(buffer);
+  LALInferenceClearVariables(&vars);
+  gsl_rng_free(rng);
+  LALCheckMemoryLeaks();
+
+  return gsl_test_summary();
+}
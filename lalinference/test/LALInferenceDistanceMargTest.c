@@ -0,0 +1,48 @@
+#include <math.h>
+#include <stdio.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+#include <lal/LALInferenceDistanceMarg.h>
+#include <lal/distance_integrator.h>
+#include <gsl/gsl_test.h>
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  const double dist_min = 10, dist_max = 1000, pmax = 1000;
+  const size_t size = 200;
+  const char *fname = "test_distance_marg.dat";
+
+  for (int margphi = 0; margphi < 2; margphi ++)
+  {
+    LALInferenceDistanceMargTable *table = LALInferenceGetDistanceMargTable(
+      fname, dist_min, dist_max, 0, margphi, pmax, size);
+    LALInferenceDistanceMargTable *loaded = LALInferenceReadDistanceMargTable(fname);
+
+    /* Compare against direct integration, normalised by the prior */
+    const double log_norm = log((pow(dist_max, 3) - pow(dist_min, 3)) / 3);
+    const double snrs[][2] = {{100, 5}, {300, 100}, {1000, 1500}, {2000, 2500}};
+    for (size_t i = 0; i < XLAL_NUM_ELEM(snrs); i ++)
+    {
+      const double p = sqrt(snrs[i][0]), b = snrs[i][1];
+      const double expected = log_radial_integral(dist_min, dist_max, p, b, 2, 0, !margphi)
+        + pow(0.5 * b / p, 2) - log_norm;
+      const double result = LALInferenceDistanceMargTableLogLikelihood(table, p, b);
+      gsl_test_abs(result, expected, 1e-2, "margphi=%d table at p=%g, b=%g", margphi, p, b);
+      gsl_test_abs(LALInferenceDistanceMargTableLogLikelihood(loaded, p, b), result, 0,
+                   "margphi=%d reloaded table at p=%g, b=%g", margphi, p, b);
+    }
+
+    LALInferenceDestroyDistanceMargTable(loaded);
+    LALInferenceDestroyDistanceMargTable(table);
+  }
+
+  remove(fname);
+  LALCheckMemoryLeaks();
+
+  return gsl_test_summary();
+}
@@ -0,0 +1,115 @@
+#include <math.h>
+#include <lal/XLALError.h>
+#include <lal/LALConstants.h>
+#include <lal/LALInference.h>
+#include <lal/LALSimNeutronStar.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_test.h>
+
+/* Piecewise-polytrope parameters (logp1 in cgs) of three equations of state */
+static const REAL8 eosParams[3][4] = {
+  {34.384, 3.005, 2.988, 2.851},
+  {34.495, 3.446, 3.572, 3.213},
+  {34.269, 2.830, 3.445, 3.348}
+};
+
+static void set_eos(LALInferenceVariables *vars, UINT4 n)
+{
+  LALInferenceSetREAL8Variable(vars, "logp1", eosParams[n][0]);
+  LALInferenceSetREAL8Variable(vars, "gamma1", eosParams[n][1]);
+  LALInferenceSetREAL8Variable(vars, "gamma2", eosParams[n][2]);
+  LALInferenceSetREAL8Variable(vars, "gamma3", eosParams[n][3]);
+}
+
+/* Look up EOS n and check the cache counts afterwards */
+static void lookup(LALInferenceEOSFamilyCache *cache, LALInferenceVariables *vars, UINT4 n, UINT8 hits, UINT8 misses)
+{
+  REAL8 lambda1, lambda2;
+  UINT8 h, m;
+  set_eos(vars, n);
+  gsl_test_int(LALInferenceEOSMasses2LambdasCached(cache, vars, 1.4, 1.3, &lambda1, &lambda2), XLAL_SUCCESS, "lookup of EOS %u", n);
+  LALInferenceEOSFamilyCacheCounts(cache, &h, &m);
+  gsl_test_int(h, hits, "hits after lookup of EOS %u", n);
+  gsl_test_int(m, misses, "misses after lookup of EOS %u", n);
+}
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  LALInferenceVariables vars = {0};
+  LALInferenceAddREAL8Variable(&vars, "logp1", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddREAL8Variable(&vars, "gamma1", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddREAL8Variable(&vars, "gamma2", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddREAL8Variable(&vars, "gamma3", 0, LALINFERENCE_PARAM_LINEAR);
+
+  /* Hits, misses and least-recently-used eviction in a cache of two */
+  LALInferenceEOSFamilyCache *cache = LALInferenceCreateEOSFamilyCache(2);
+  lookup(cache, &vars, 0, 0, 1);
+  lookup(cache, &vars, 0, 1, 1);
+  lookup(cache, &vars, 1, 1, 2);
+  lookup(cache, &vars, 0, 2, 2);  /* 1 is now least recently used */
+  lookup(cache, &vars, 2, 2, 3);  /* evicts 1 */
+  lookup(cache, &vars, 0, 3, 3);
+  lookup(cache, &vars, 2, 4, 3);
+  lookup(cache, &vars, 1, 4, 4);  /* evicts 0 */
+  lookup(cache, &vars, 2, 5, 4);
+  lookup(cache, &vars, 0, 5, 5);  /* evicts 1 */
+
+  /* Cached tidal deformabilities agree with those of a newly built family */
+  const REAL8 masses[] = {1.1, 1.35, 1.6, 1.9};
+  for (UINT4 n = 0; n < XLAL_NUM_ELEM(eosParams); n++)
+  {
+    LALSimNeutronStarEOS *eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(eosParams[n][0] - 1.0, eosParams[n][1], eosParams[n][2], eosParams[n][3]);
+    LALSimNeutronStarFamily *fam = XLALCreateSimNeutronStarFamily(eos);
+    set_eos(&vars, n);
+    for (UINT4 i = 0; i < XLAL_NUM_ELEM(masses); i++)
+    {
+      const REAL8 m = masses[i] * LAL_MSUN_SI;
+      const REAL8 r = XLALSimNeutronStarRadius(m, fam);
+      const REAL8 k2 = XLALSimNeutronStarLoveNumberK2(m, fam);
+      const REAL8 expected = (2.0 / 3.0) * k2 * pow(r / (m * LAL_MRSUN_SI / LAL_MSUN_SI), 5);
+      REAL8 radius, love, lambda, lambda1, lambda2;
+      gsl_test_int(XLALSimNeutronStarTidalProperties(&radius, &love, &lambda, m, fam), XLAL_SUCCESS, "EOS %u tidal properties at %g Msun", n, masses[i]);
+      gsl_test_rel(radius, r, 1e-12, "EOS %u radius at %g Msun", n, masses[i]);
+      gsl_test_rel(love, k2, 1e-12, "EOS %u k2 at %g Msun", n, masses[i]);
+      gsl_test_rel(lambda, expected, 1e-12, "EOS %u lambda at %g Msun", n, masses[i]);
+      gsl_test_int(LALInferenceEOSMasses2LambdasCached(cache, &vars, masses[i], masses[i], &lambda1, &lambda2), XLAL_SUCCESS, "EOS %u cached lambdas at %g Msun", n, masses[i]);
+      gsl_test_rel(lambda1, lambda, 1e-12, "EOS %u cached lambda at %g Msun", n, masses[i]);
+      LALInferenceLogp1GammasMasses2Lambdas(eosParams[n][0], eosParams[n][1], eosParams[n][2], eosParams[n][3], masses[i], masses[i], &lambda1, &lambda2);
+      gsl_test_rel(lambda2, lambda, 1e-12, "EOS %u uncached lambda at %g Msun", n, masses[i]);
+    }
+    XLALDestroySimNeutronStarFamily(fam);
+    XLALDestroySimNeutronStarEOS(eos);
+  }
+
+  /* A mass beyond the family is a GSL domain error, as for the radius
+   * alone, and with the GSL error handler off gives a NaN deformability */
+  gsl_error_handler_t *gsl_handler = gsl_set_error_handler_off();
+  {
+    LALSimNeutronStarEOS *eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(eosParams[0][0] - 1.0, eosParams[0][1], eosParams[0][2], eosParams[0][3]);
+    LALSimNeutronStarFamily *fam = XLALCreateSimNeutronStarFamily(eos);
+    const REAL8 m = 2.0 * XLALSimNeutronStarMaximumMass(fam);
+    REAL8 lambda, lambda1, lambda2;
+    gsl_test(!isnan(XLALSimNeutronStarRadius(m, fam)), "radius beyond the maximum mass");
+    gsl_test_int(XLALSimNeutronStarTidalProperties(NULL, NULL, &lambda, m, fam), XLAL_SUCCESS, "tidal properties beyond the maximum mass");
+    gsl_test(!isnan(lambda), "lambda beyond the maximum mass");
+    set_eos(&vars, 0);
+    gsl_test_int(LALInferenceEOSMasses2LambdasCached(cache, &vars, m / LAL_MSUN_SI, 1.4, &lambda1, &lambda2), XLAL_SUCCESS, "cached lambdas beyond the maximum mass");
+    gsl_test(!isnan(lambda1), "cached lambda beyond the maximum mass");
+    LALInferenceLogp1GammasMasses2Lambdas(eosParams[0][0], eosParams[0][1], eosParams[0][2], eosParams[0][3], m / LAL_MSUN_SI, 1.4, &lambda1, &lambda2);
+    gsl_test(!isnan(lambda1), "uncached lambda beyond the maximum mass");
+    XLALDestroySimNeutronStarFamily(fam);
+    XLALDestroySimNeutronStarEOS(eos);
+  }
+  gsl_set_error_handler(gsl_handler);
+
+  LALInferenceDestroyEOSFamilyCache(cache);
+  LALInferenceClearVariables(&vars);
+  LALCheckMemoryLeaks();
+
+  return gsl_test_summary();
+}
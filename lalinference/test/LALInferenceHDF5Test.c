@@ -1,7 +1,168 @@
+#include <stdio.h>
 #include <lal/XLALError.h>
 #include <lal/LALInferenceHDF5.h>
 #include <gsl/gsl_test.h>
 
+#define CHAIN_FILE "test_chain.hdf5"
+#define CHAIN_BUFFER_LENGTH 8
+#define NCHAINS 2
+
+static const char *chain_names[NCHAINS] = {"chain_00", "chain_01"};
+
+/* Set a sample of chain c at step i */
+static void set_chain_sample(LALInferenceVariables *vars, UINT4 c, INT4 i)
+{
+  LALInferenceAddREAL8Variable(vars, "x", 100 * c + i, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddINT4Variable (vars, "step", i, LALINFERENCE_PARAM_OUTPUT);
+  LALInferenceAddREAL8Variable(vars, "f", 5, LALINFERENCE_PARAM_FIXED);
+}
+
+/* Append the samples [start, end) of every chain */
+static void append_chain_samples(LALInferenceH5ChainOutput *output, INT4 start, INT4 end)
+{
+  for (INT4 i = start; i < end; i ++)
+    for (UINT4 c = 0; c < NCHAINS; c ++)
+    {
+      LALInferenceVariables vars = {0};
+      set_chain_sample(&vars, c, i);
+      gsl_test_int(LALInferenceH5ChainOutputAppend(output, c, chain_names[c], &vars),
+        XLAL_SUCCESS, "append sample %d of chain %u", i, c);
+      LALInferenceClearVariables(&vars);
+    }
+}
+
+/* Read back chain c, and check that it holds the samples [0, n) */
+static void check_chain(UINT4 c, UINT4 n, UINT4 *output_rows)
+{
+  LALH5File *file = XLALH5FileOpen(CHAIN_FILE, "r");
+  LALH5File *group = XLALH5GroupOpen(file, "lalinference/lalinference_mcmc");
+  LALH5Dataset *dataset = XLALH5DatasetRead(group, chain_names[c]);
+  LALInferenceVariables **vars_array = NULL;
+  UINT4 N = 0;
+  LALInferenceH5DatasetToVariablesArray(dataset, &vars_array, &N);
+
+  gsl_test_int(N, n, "number of rows of %s", chain_names[c]);
+  for (UINT4 i = 0; i < N; i ++)
+  {
+    gsl_test_abs(LALInferenceGetREAL8Variable(vars_array[i], "x"), 100 * c + i, 0,
+      "value of column x of %s row %u", chain_names[c], i);
+    gsl_test_int(LALInferenceGetINT4Variable(vars_array[i], "step"), i,
+      "value of column step of %s row %u", chain_names[c], i);
+    gsl_test_abs(LALInferenceGetREAL8Variable(vars_array[i], "f"), 5, 0,
+      "value of column f of %s row %u", chain_names[c], i);
+    LALInferenceClearVariables(vars_array[i]);
+    XLALFree(vars_array[i]);
+  }
+  XLALFree(vars_array);
+  XLALH5DatasetFree(dataset);
+
+  /* The checkpoint records how many rows were on disk when it was made */
+  if (output_rows)
+  {
+    char checkpoint_name[64];
+    snprintf(checkpoint_name, sizeof(checkpoint_name), "%s-checkpoint", chain_names[c]);
+    LALH5File *checkpoint = XLALH5GroupOpen(group, checkpoint_name);
+    XLALH5FileQueryScalarAttributeValue(output_rows, checkpoint, "output_rows");
+    XLALH5FileClose(checkpoint);
+  }
+
+  XLALH5FileClose(group);
+  XLALH5FileClose(file);
+}
+
+/* Write chains through an appendable output in several flushes, checkpoint
+ * part way through, and resume from the checkpoint as lalinference_mcmc does:
+ * the output is reopened in place, the rows written after the checkpoint are
+ * discarded, and sampling carries on from there */
+static void test_chain_output(void)
+{
+  const INT4 n_checkpoint = 2 * CHAIN_BUFFER_LENGTH + 3;
+  const INT4 n_stop = n_checkpoint + CHAIN_BUFFER_LENGTH + 5;
+  const INT4 n_resumed = n_stop + 3 * CHAIN_BUFFER_LENGTH + 1;
+
+  LALInferenceH5ChainOutput *output = LALInferenceH5ChainOutputOpen(
+    CHAIN_FILE, "lalinference", "lalinference_mcmc", NCHAINS, CHAIN_BUFFER_LENGTH);
+  append_chain_samples(output, 0, CHAIN_BUFFER_LENGTH / 2);
+  gsl_test_int(LALInferenceH5ChainOutputFlush(output), XLAL_SUCCESS, "first flush");
+  append_chain_samples(output, CHAIN_BUFFER_LENGTH / 2, n_checkpoint);
+  gsl_test_int(LALInferenceH5ChainOutputFlush(output), XLAL_SUCCESS, "checkpoint flush");
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+  {
+    UINT4 output_rows = LALInferenceH5ChainOutputLength(output, c);
+    gsl_test_int(output_rows, n_checkpoint, "output length of %s at checkpoint", chain_names[c]);
+    char checkpoint_name[64];
+    snprintf(checkpoint_name, sizeof(checkpoint_name), "%s-checkpoint", chain_names[c]);
+    LALH5File *checkpoint = XLALH5GroupOpen(LALInferenceH5ChainOutputGroup(output), checkpoint_name);
+    XLALH5FileAddScalarAttribute(checkpoint, "output_rows", &output_rows, LAL_U4_TYPE_CODE);
+    XLALH5FileClose(checkpoint);
+  }
+
+  /* Rows appended after the checkpoint, then an interrupted run */
+  append_chain_samples(output, n_checkpoint, n_stop);
+  gsl_test_int(LALInferenceH5ChainOutputClose(output), XLAL_SUCCESS, "close");
+
+  /* Every row reached the file, and the checkpoint marks the resume point */
+  UINT4 output_rows[NCHAINS];
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+  {
+    check_chain(c, n_stop, &output_rows[c]);
+    gsl_test_int(output_rows[c], n_checkpoint, "output_rows attribute of %s", chain_names[c]);
+  }
+
+  /* Resume: the tables are truncated to the checkpoint, and new rows follow */
+  output = LALInferenceH5ChainOutputResume(
+    CHAIN_FILE, "lalinference", "lalinference_mcmc", NCHAINS, CHAIN_BUFFER_LENGTH,
+    chain_names, output_rows);
+  gsl_test(output == NULL, "resume output");
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+    gsl_test_int(LALInferenceH5ChainOutputLength(output, c), n_checkpoint,
+      "output length of %s on resume", chain_names[c]);
+  append_chain_samples(output, n_checkpoint, n_resumed);
+  gsl_test_int(LALInferenceH5ChainOutputFlush(output), XLAL_SUCCESS, "flush after resume");
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+    gsl_test_int(LALInferenceH5ChainOutputLength(output, c), n_resumed,
+      "output length of %s after resume", chain_names[c]);
+  gsl_test_int(LALInferenceH5ChainOutputClose(output), XLAL_SUCCESS, "close after resume");
+
+  /* The file was not recreated, so the checkpoint is still there */
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+  {
+    check_chain(c, n_resumed, &output_rows[c]);
+    gsl_test_int(output_rows[c], n_checkpoint, "output_rows attribute of %s after resume", chain_names[c]);
+  }
+
+  /* Checkpoints older than the output_rows attribute keep every row */
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+    output_rows[c] = LAL_UINT4_MAX;
+  output = LALInferenceH5ChainOutputResume(
+    CHAIN_FILE, "lalinference", "lalinference_mcmc", NCHAINS, CHAIN_BUFFER_LENGTH,
+    chain_names, output_rows);
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+    gsl_test_int(LALInferenceH5ChainOutputLength(output, c), n_resumed,
+      "output length of %s on resume without a row count", chain_names[c]);
+  gsl_test_int(LALInferenceH5ChainOutputClose(output), XLAL_SUCCESS, "close after resume without a row count");
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+    check_chain(c, n_resumed, NULL);
+
+  /* A failed write is reported: here both chains write to the same table,
+   * so whichever is written second cannot create it */
+  int errnum;
+  output = LALInferenceH5ChainOutputOpen(
+    CHAIN_FILE, "lalinference", "lalinference_mcmc", NCHAINS, CHAIN_BUFFER_LENGTH);
+  for (UINT4 c = 0; c < NCHAINS; c ++)
+  {
+    LALInferenceVariables vars = {0};
+    set_chain_sample(&vars, c, 0);
+    gsl_test_int(LALInferenceH5ChainOutputAppend(output, c, chain_names[0], &vars),
+      XLAL_SUCCESS, "append sample of chain %u to %s", c, chain_names[0]);
+    LALInferenceClearVariables(&vars);
+  }
+  XLAL_TRY_SILENT(LALInferenceH5ChainOutputFlush(output), errnum);
+  gsl_test_int(errnum, XLAL_EFUNC, "flush reports the failed write");
+  XLAL_TRY_SILENT(LALInferenceH5ChainOutputClose(output), errnum);
+  gsl_test_int(errnum, XLAL_EFUNC, "close reports the failed write");
+}
+
 int main(int argc, char **argv)
 {
   /* Not used */
@@ -113,6 +274,9 @@ int main(int argc, char **argv)
   /* Close file. */
   XLALH5FileClose(file);
 
+  /* Appendable chain output. */
+  test_chain_output();
+
   /* Check for memory leaks. */
   LALCheckMemoryLeaks();
 
@@ -0,0 +1,81 @@
+#include <math.h>
+#include <stdio.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+#include <lal/LALInferenceKDE.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_test.h>
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  const INT4 dim = 3, npts = 4000, nextra = 1000, ntest = 50;
+  const REAL8 tolerance = 1e-4;
+  gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(rng, 1234);
+
+  /* Two separated, differently shaped clusters */
+  REAL8 *pts = XLALMalloc((npts + nextra) * dim * sizeof(REAL8));
+  for (INT4 i = 0; i < npts + nextra; i++)
+    for (INT4 j = 0; j < dim; j++)
+      pts[i*dim + j] = (i % 2 ? 10. : 0.) + (j + 1) * gsl_ran_ugaussian(rng);
+
+  LALInferenceKDE *exact = LALInferenceNewKDE(pts, npts, dim, NULL);
+  LALInferenceKDE *approx = LALInferenceNewKDE(pts, npts, dim, NULL);
+  XLAL_CHECK_MAIN(LALInferenceKDEBuildTree(approx, tolerance) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  for (INT4 pass = 0; pass < 3; pass++)
+  {
+    for (INT4 i = 0; i < ntest; i++)
+    {
+      /* Test near the data, and well away from it */
+      REAL8 pt[3];
+      for (INT4 j = 0; j < dim; j++)
+        pt[j] = pts[(i % npts)*dim + j] + (i % 5) * gsl_ran_ugaussian(rng);
+
+      const REAL8 expected = LALInferenceKDEEvaluatePoint(exact, pt);
+      const REAL8 result = LALInferenceKDEEvaluatePoint(approx, pt);
+      gsl_test_abs(result, expected, 2 * tolerance, "pass %d tree evaluation at point %d", pass, i);
+    }
+
+    if (pass == 0)
+    {
+      /* Insert samples incrementally into both estimates */
+      for (INT4 i = npts; i < npts + nextra; i++)
+      {
+        XLAL_CHECK_MAIN(LALInferenceKDEAddPoint(exact, pts + i*dim) == XLAL_SUCCESS, XLAL_EFUNC);
+        XLAL_CHECK_MAIN(LALInferenceKDEAddPoint(approx, pts + i*dim) == XLAL_SUCCESS, XLAL_EFUNC);
+      }
+      gsl_test_int(approx->npts, npts + nextra, "number of points after insertion");
+
+      /* The data is a consistent view of the rows in use */
+      gsl_test_int(approx->data->size1, npts + nextra, "rows of data after insertion");
+      gsl_test(approx->buffer == NULL || approx->data->block != approx->buffer->block
+               || approx->buffer->size1 < approx->data->size1, "data is a view of the KDE storage");
+      INT4 nwrong = 0;
+      for (INT4 i = 0; i < npts + nextra; i++)
+        for (INT4 j = 0; j < dim; j++)
+          nwrong += gsl_matrix_get(approx->data, i, j) != pts[i*dim + j];
+      gsl_test_int(nwrong, 0, "data after insertion");
+    }
+    else if (pass == 1)
+    {
+      /* Retune both, which rebuilds the tree */
+      LALInferenceSetKDEBandwidth(exact);
+      LALInferenceSetKDEBandwidth(approx);
+    }
+  }
+
+  LALInferenceDestroyKDE(approx);
+  LALInferenceDestroyKDE(exact);
+  XLALFree(pts);
+  gsl_rng_free(rng);
+  LALCheckMemoryLeaks();
+
+  return gsl_test_summary();
+}
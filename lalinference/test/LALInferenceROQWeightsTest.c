@@ -0,0 +1,78 @@
+#include <math.h>
+#include <complex.h>
+#include <lal/XLALError.h>
+#include <lal/LALInference.h>
+#include <gsl/gsl_test.h>
+
+/* Cubic in time, which four-point Lagrange interpolation reproduces exactly */
+static COMPLEX16 test_weight(UINT4 i, REAL8 t)
+{
+  return (1.0 + 0.1*i) + (0.5 - 0.01*i)*t + I*(0.3*t*t - 0.02*i*t*t*t);
+}
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  const UINT4 n_nodes = 37, n_times = 50;
+  LALInferenceROQLinearWeights weights;
+  weights.n_nodes = n_nodes;
+  weights.n_times = n_times;
+  weights.t0 = -0.1;
+  weights.dt = 0.2/(n_times - 1);
+  weights.weights = XLALMalloc(n_nodes*n_times*sizeof(COMPLEX16));
+  for (UINT4 j = 0; j < n_times; j ++)
+    for (UINT4 i = 0; i < n_nodes; i ++)
+      weights.weights[j*n_nodes + i] = test_weight(i, weights.t0 + j*weights.dt);
+
+  COMPLEX16 hplus[n_nodes], hcross[n_nodes], cal[n_nodes], w[n_nodes];
+  for (UINT4 i = 0; i < n_nodes; i ++)
+  {
+    hplus[i] = cexp(I*0.3*i);
+    hcross[i] = I*cexp(I*0.3*i)*0.5;
+    cal[i] = 1.0 + 0.01*I*i;
+  }
+  const REAL8 Fplus = 0.4, Fcross = -0.7;
+
+  /* Include both ends of the grid, where the stencil is off-centre */
+  const REAL8 times[] = {-0.1, -0.0987, -0.0312, 0.0, 0.0421, 0.0999, 0.1};
+  for (UINT4 k = 0; k < XLAL_NUM_ELEM(times); k ++)
+  {
+    const REAL8 t = times[k];
+    COMPLEX16 expected = 0.0, expected_cal = 0.0;
+    for (UINT4 i = 0; i < n_nodes; i ++)
+    {
+      const COMPLEX16 h = Fplus*hplus[i] + Fcross*hcross[i];
+      expected += test_weight(i, t)*conj(h);
+      expected_cal += test_weight(i, t)*conj(cal[i]*h);
+    }
+
+    COMPLEX16 result;
+    LALInferenceROQLinearInnerProduct(&result, &weights, hplus, hcross, Fplus, Fcross, NULL, t);
+    gsl_test_rel(creal(result), creal(expected), 1e-10, "real inner product at t=%g", t);
+    gsl_test_rel(cimag(result), cimag(expected), 1e-10, "imag inner product at t=%g", t);
+
+    LALInferenceROQLinearInnerProduct(&result, &weights, hplus, hcross, Fplus, Fcross, cal, t);
+    gsl_test_rel(creal(result), creal(expected_cal), 1e-10, "real calibrated inner product at t=%g", t);
+    gsl_test_rel(cimag(result), cimag(expected_cal), 1e-10, "imag calibrated inner product at t=%g", t);
+
+    LALInferenceROQLinearWeightsAtTime(w, &weights, t);
+    for (UINT4 i = 0; i < n_nodes; i ++)
+      gsl_test_abs(cabs(w[i] - test_weight(i, t)), 0.0, 1e-12, "weight %u at t=%g", i, t);
+  }
+
+  /* Out of range time shifts are an error */
+  COMPLEX16 result;
+  XLALSetErrorHandler(XLALDefaultErrorHandler);
+  int ret;
+  XLAL_TRY(ret = LALInferenceROQLinearInnerProduct(&result, &weights, hplus, hcross, Fplus, Fcross, NULL, 0.2), ret);
+  gsl_test((ret & ~XLAL_EFUNC) != XLAL_EDOM, "out of range time shift returns XLAL_EDOM");
+
+  XLALFree(weights.weights);
+  LALCheckMemoryLeaks();
+
+  return gsl_test_summary();
+}
@@ -0,0 +1,97 @@
+#include <math.h>
+#include <string.h>
+#include <lal/XLALError.h>
+#include <lal/StringVector.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceInit.h>
+#include <lal/LALInferenceReadData.h>
+#include <lal/LALInferenceLikelihood.h>
+#include <lal/LIGOLwXMLInspiralRead.h>
+#include <gsl/gsl_test.h>
+
+/* Set the varying REAL8 parameters of params to those of the injection */
+static void set_injection_params(LALInferenceVariables *params)
+{
+  SimInspiralTable *injTable = NULL;
+  SimInspiralTableFromLIGOLw(&injTable, TEST_DATA_DIR "injection_standard.xml", 0, 0);
+  XLAL_CHECK_VOID(injTable != NULL, XLAL_EIO, "Unable to read the injection file");
+  LALInferenceVariables injParams;
+  memset(&injParams, 0, sizeof(injParams));
+  LALInferenceInjectionToVariables(injTable, &injParams);
+  for (LALInferenceVariableItem *item = params->head; item; item = item->next)
+    if (item->type == LALINFERENCE_REAL8_t && LALInferenceCheckVariableNonFixed(params, item->name))
+      LALInferenceSetREAL8Variable(params, item->name, LALInferenceGetREAL8Variable(&injParams, item->name));
+  LALInferenceClearVariables(&injParams);
+  while (injTable) {
+    SimInspiralTable *next = injTable->next;
+    LALFree(injTable);
+    injTable = next;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  /* Two detectors of simulated noise containing the injection, analysed
+   * with the relative binning likelihood around that injection */
+  LALStringVector *args = XLALCreateStringVector("LALInferenceRelBinTest",
+    "--ifo", "H1", "--H1-cache", "LALSimAdLIGO", "--H1-channel", "LALSimAdLIGO",
+    "--ifo", "L1", "--L1-cache", "LALSimAdLIGO", "--L1-channel", "LALSimAdLIGO",
+    "--psdstart", "441417500", "--psdlength", "64", "--seglen", "4", "--srate", "1024",
+    "--trigtime", "441417609", "--dataseed", "1234", "--randomseed", "4321",
+    "--inj", TEST_DATA_DIR "injection_standard.xml",
+    "--approx", "IMRPhenomPv2", "--disable-spin",
+    "--relative-binning", NULL);
+  ProcessParamsTable *procParams = LALInferenceParseCommandLineStringVector(args);
+  LALInferenceRunState *runState = LALInferenceInitRunState(procParams);
+  LALInferenceInjectInspiralSignal(runState->data, runState->commandLine);
+  LALInferenceInitCBCThreads(runState, 1);
+  LALInferenceInitLikelihood(runState);
+
+  LALInferenceModel *relbin = runState->threads[0].model;
+  gsl_test_int(relbin->relbin_flag, 1, "relative binning enabled");
+
+  /* A second model that generates the template on the full frequency grid */
+  LALInferenceModel *full = LALInferenceInitCBCModel(runState);
+  full->roq_flag = 0;
+  full->relbin = NULL;
+  full->relbin_flag = 0;
+  full->distance_marg = NULL;
+
+  LALInferenceVariables params;
+  memset(&params, 0, sizeof(params));
+  LALInferenceCopyVariables(runState->threads[0].currentParams, &params);
+  set_injection_params(&params);
+  const REAL8 mc = LALInferenceGetREAL8Variable(&params, "chirpmass");
+  const REAL8 time = LALInferenceGetREAL8Variable(&params, "time");
+  const REAL8 phase = LALInferenceGetREAL8Variable(&params, "phase");
+
+  /* At the fiducial the waveform ratio is exactly 1, so only rounding
+   * errors remain; near it the ratio is smooth across each bin */
+  const struct {
+    REAL8 dmc, dtime, dphase, tol;
+  } points[] = {
+    {0, 0, 0, 1e-6},
+    {1e-3, 0, 0, 0.1},
+    {0, 1e-4, 0, 0.1},
+    {0, 0, 0.1, 0.1},
+    {-1e-3, -2e-4, -0.2, 0.1},
+  };
+  for (UINT4 i = 0; i < XLAL_NUM_ELEM(points); i++) {
+    LALInferenceSetREAL8Variable(&params, "chirpmass", mc*(1.0 + points[i].dmc));
+    LALInferenceSetREAL8Variable(&params, "time", time + points[i].dtime);
+    LALInferenceSetREAL8Variable(&params, "phase", phase + points[i].dphase);
+    const REAL8 logL_relbin = runState->likelihood(&params, runState->data, relbin);
+    const REAL8 logL_full = runState->likelihood(&params, runState->data, full);
+    gsl_test_abs(logL_relbin, logL_full, points[i].tol, "relative binning logL at point %u", i);
+  }
+
+  LALInferenceClearVariables(&params);
+  LALInferenceDestroyModel(full, 2);
+
+  return gsl_test_summary();
+}
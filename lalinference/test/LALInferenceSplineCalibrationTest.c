@@ -0,0 +1,120 @@
+#include <math.h>
+#include <complex.h>
+#include <lal/XLALError.h>
+#include <lal/LALInference.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Sequence.h>
+#include <lal/Units.h>
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_test.h>
+
+#define NPTS 7
+
+/* Natural cubic spline through (x, y), evaluated independently by GSL */
+static REAL8 reference_spline(const REAL8 *x, const REAL8 *y, UINT4 n, REAL8 xi)
+{
+  gsl_spline *spline = gsl_spline_alloc(gsl_interp_cspline, n);
+  gsl_spline_init(spline, x, y, n);
+  /* Guard against rounding just outside the nodes */
+  const REAL8 result = gsl_spline_eval(spline, fmin(fmax(xi, x[0]), x[n-1]), NULL);
+  gsl_spline_free(spline);
+  return result;
+}
+
+int main(int argc, char **argv)
+{
+  /* Not used */
+  (void)argc;
+  (void)argv;
+  XLALSetErrorHandler(XLALExitErrorHandler);
+
+  REAL8Vector *logfreqs = XLALCreateREAL8Vector(NPTS);
+  REAL8Vector *amps = XLALCreateREAL8Vector(NPTS);
+  REAL8Vector *phases = XLALCreateREAL8Vector(NPTS);
+  for (UINT4 k = 0; k < NPTS; k++) {
+    logfreqs->data[k] = log(20.0) + k*(log(1024.0) - log(20.0))/(NPTS - 1) + 0.05*sin(3.0*k);
+    amps->data[k] = 0.05*sin(1.3*k + 0.2);
+    phases->data[k] = 0.03*cos(0.7*k - 0.4);
+  }
+
+  /* Full frequency grid, including bins outside the spline nodes */
+  const REAL8 deltaF = 0.25;
+  const LIGOTimeGPS epoch = {0, 0};
+  COMPLEX16FrequencySeries *calFactor = XLALCreateCOMPLEX16FrequencySeries("cal", &epoch, 0, deltaF, &lalDimensionlessUnit, 8192);
+  LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+  for (UINT4 i = 0; i < calFactor->data->length; i++) {
+    const REAL8 f = i*deltaF;
+    COMPLEX16 expected = 1.0;
+    if (f >= exp(logfreqs->data[0]) && f <= exp(logfreqs->data[NPTS-1])) {
+      const REAL8 dA = reference_spline(logfreqs->data, amps->data, NPTS, log(f));
+      const REAL8 dPhi = reference_spline(logfreqs->data, phases->data, NPTS, log(f));
+      expected = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
+    }
+    gsl_test_abs(cabs(calFactor->data->data[i] - expected), 0.0, 1e-13, "calibration factor at %g Hz", f);
+  }
+
+  /* Arbitrary frequencies, which pass exactly through the nodes */
+  REAL8Sequence *nodes = XLALCreateREAL8Sequence(NPTS + 2);
+  COMPLEX16Sequence *nodeFactor = XLALCreateCOMPLEX16Sequence(NPTS + 2);
+  REAL8Sequence *quadNodes = XLALCreateREAL8Sequence(3);
+  COMPLEX16Sequence *quadFactor = XLALCreateCOMPLEX16Sequence(3);
+  for (UINT4 k = 0; k < NPTS; k++)
+    nodes->data[k] = exp(logfreqs->data[NPTS - 1 - k]);
+  nodes->data[NPTS] = 10.0;
+  nodes->data[NPTS + 1] = 2048.0;
+  quadNodes->data[0] = 35.0;
+  quadNodes->data[1] = 150.0;
+  quadNodes->data[2] = 900.0;
+  LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases, nodes, &nodeFactor, quadNodes, &quadFactor);
+  for (UINT4 k = 0; k < NPTS; k++) {
+    const REAL8 dA = amps->data[NPTS - 1 - k], dPhi = phases->data[NPTS - 1 - k];
+    const COMPLEX16 expected = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
+    gsl_test_abs(cabs(nodeFactor->data[k] - expected), 0.0, 1e-13, "calibration factor at node %u", k);
+  }
+  gsl_test(nodeFactor->data[NPTS] != 1.0, "calibration factor below the nodes is 1");
+  gsl_test(nodeFactor->data[NPTS + 1] != 1.0, "calibration factor above the nodes is 1");
+  for (UINT4 j = 0; j < quadNodes->length; j++) {
+    const REAL8 x = log(quadNodes->data[j]);
+    const REAL8 dA = reference_spline(logfreqs->data, amps->data, NPTS, x);
+    const REAL8 dPhi = reference_spline(logfreqs->data, phases->data, NPTS, x);
+    const COMPLEX16 expected = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
+    gsl_test_abs(cabs(quadFactor->data[j] - expected), 0.0, 1e-13, "quadratic calibration factor at %g Hz", quadNodes->data[j]);
+  }
+
+  /* A kernel is only rebuilt when its nodes or frequencies change */
+  LALInferenceSplineCalibration *cal = NULL;
+  LALInferenceUpdateSplineCalibration(&cal, logfreqs->data, NPTS, NULL, deltaF, 8192);
+  LALInferenceSplineCalibration *first = cal;
+  LALInferenceUpdateSplineCalibration(&cal, logfreqs->data, NPTS, NULL, deltaF, 8192);
+  gsl_test(cal != first, "unchanged kernel is reused");
+  logfreqs->data[NPTS-1] += 0.1;
+  LALInferenceUpdateSplineCalibration(&cal, logfreqs->data, NPTS, NULL, deltaF, 8192);
+  COMPLEX16 *factor = XLALMalloc(8192*sizeof(COMPLEX16));
+  LALInferenceApplySplineCalibration(cal, amps->data, phases->data, factor);
+  const REAL8 f = exp(logfreqs->data[NPTS-1] - 0.05);
+  const UINT4 i = (UINT4)(f/deltaF);
+  const REAL8 dA = reference_spline(logfreqs->data, amps->data, NPTS, log(i*deltaF));
+  const REAL8 dPhi = reference_spline(logfreqs->data, phases->data, NPTS, log(i*deltaF));
+  gsl_test_abs(cabs(factor[i] - (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi)), 0.0, 1e-13, "kernel rebuilt for moved nodes");
+
+  /* Fewer than three nodes is an error */
+  XLALSetErrorHandler(XLALDefaultErrorHandler);
+  LALInferenceSplineCalibration *bad;
+  int errnum;
+  XLAL_TRY(bad = LALInferenceCreateSplineCalibration(logfreqs->data, 2, NULL, deltaF, 16), errnum);
+  gsl_test(bad != NULL || errnum != XLAL_EINVAL, "two spline nodes are rejected");
+
+  XLALFree(factor);
+  LALInferenceDestroySplineCalibration(cal);
+  XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+  XLALDestroyREAL8Sequence(nodes);
+  XLALDestroyCOMPLEX16Sequence(nodeFactor);
+  XLALDestroyREAL8Sequence(quadNodes);
+  XLALDestroyCOMPLEX16Sequence(quadFactor);
+  XLALDestroyREAL8Vector(logfreqs);
+  XLALDestroyREAL8Vector(amps);
+  XLALDestroyREAL8Vector(phases);
+  LALCheckMemoryLeaks();
+
+  return gsl_test_summary();
+}
@@ -0,0 +1,54 @@
+#!/bin/sh
+
+# Smoke test of parallel tempering across two MPI processes: the hottest
+# chain of the first process swaps with the coldest chain of the second
+# through the nonblocking offer/reply exchange, with the processes allowed
+# to run (--swap-staleness) rounds ahead of each other, for the analytic
+# correlated Gaussian likelihood.
+
+if [ -z "${LAL_TEST_BUILDDIR}" ]; then
+    LAL_TEST_BUILDDIR=`dirname $0`
+fi
+MCMC="${LAL_TEST_BUILDDIR}/../bin/mpi/lalinference_mcmc"
+MPIRUN="${MPIRUN:-mpirun}"
+
+if ! command -v ${MPIRUN} > /dev/null 2>&1; then
+    echo "${MPIRUN} not found, skipping"
+    exit 77
+fi
+
+SEED=4321
+OUT=test_mcmc_mpi.hdf5
+ARGS="--correlatedGaussianLikelihood --nsteps 5000 --skip 50 --ntemps 4 \
+ --temp-skip 10 --adapt-temps --temp-verbose --randomseed ${SEED} \
+ --ifo H1 --H1-cache LALSimAdLIGO --psdstart 0 --psdlength 1 --seglen 1 --trigtime 1 \
+ --srate 1024 --dataseed 1234 --approx SpinTaylorT4 --outfile ${OUT}"
+
+for STALENESS in 0 2; do
+    rm -f ${OUT} ${OUT}.01 PTMCMC.tempswaps.${SEED}.*
+    ${MPIRUN} -np 2 ${MCMC} ${ARGS} --swap-staleness ${STALENESS} > test_mcmc_mpi_${STALENESS}.out 2>&1
+    if [ $? != "0" ]; then
+        echo "lalinference_mcmc on 2 processes with --swap-staleness ${STALENESS} failed"
+        cat test_mcmc_mpi_${STALENESS}.out
+        exit 1
+    fi
+
+    # each process writes its own chains
+    for f in ${OUT} ${OUT}.01; do
+        if [ ! -s ${f} ]; then
+            echo "lalinference_mcmc with --swap-staleness ${STALENESS} did not write ${f}"
+            exit 1
+        fi
+    done
+
+    # the second process answers the swap offers of the first, and records
+    # each one after the header line
+    SWAPS=`tail -n +2 PTMCMC.tempswaps.${SEED}.01 2>/dev/null | wc -l`
+    if [ ${SWAPS} -eq 0 ]; then
+        echo "No temperature swaps between processes with --swap-staleness ${STALENESS}"
+        exit 1
+    fi
+    echo "--swap-staleness ${STALENESS}: ${SWAPS} swaps recorded by the second process"
+done
+
+exit 0
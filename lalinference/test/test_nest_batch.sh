@@ -0,0 +1,42 @@
+#!/bin/sh
+
+# Check that replacing several live points per nested sampling iteration
+# (--Nbatch) gives the same evidence as replacing one at a time, for the
+# analytic correlated Gaussian likelihood.
+
+if [ -z "${LAL_TEST_BUILDDIR}" ]; then
+    LAL_TEST_BUILDDIR=`dirname $0`
+fi
+NEST="${LAL_TEST_BUILDDIR}/../bin/lalinference_nest"
+
+NLIVE=512
+ARGS="--correlatedGaussianLikelihood --Nlive ${NLIVE} --Nmcmc 100 --tolerance 0.1 \
+ --ifo H1 --H1-cache LALSimAdLIGO --psdstart 0 --psdlength 1 --seglen 1 --trigtime 1 \
+ --srate 1024 --dataseed 1234 --approx SpinTaylorT4"
+
+for NBATCH in 1 4; do
+    OUT=test_nest_batch_${NBATCH}.dat
+    rm -f ${OUT} ${OUT}_B.txt
+    ${NEST} ${ARGS} --Nbatch ${NBATCH} --randomseed 4321 --outfile ${OUT} > test_nest_batch_${NBATCH}.out 2>&1
+    if [ $? != "0" ] || [ ! -f ${OUT}_B.txt ]; then
+        echo "lalinference_nest --Nbatch ${NBATCH} failed"
+        cat test_nest_batch_${NBATCH}.out
+        exit 1
+    fi
+done
+
+# Second column of the _B.txt file is the log evidence. The statistical
+# error of each run is about sqrt(H/Nlive) ~ 0.15 for this likelihood, so
+# the difference should be within ~0.6 (3 sigma)
+awk -v nlive=${NLIVE} 'FNR==1 { logZ[++n] = $2 }
+END {
+    diff = logZ[1] - logZ[2]; if (diff < 0) diff = -diff
+    printf "logZ(Nbatch=1) = %.3f, logZ(Nbatch=4) = %.3f, |difference| = %.3f\n", logZ[1], logZ[2], diff
+    exit (diff > 0.6)
+}' test_nest_batch_1.dat_B.txt test_nest_batch_4.dat_B.txt
+if [ $? != "0" ]; then
+    echo "Evidences with and without batched replacement differ"
+    exit 1
+fi
+
+exit 0
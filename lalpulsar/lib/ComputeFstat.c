@@ -77,6 +77,7 @@ const FstatOptionalArgs FstatOptionalArgsDefaults = {
   .injectSources = NULL,
   .injectSqrtSX = NULL,
   .assumeSqrtSX = NULL,
+  .loadSFTNoiseFiles = 0,
   .prevInput = NULL,
   .collectTiming = 0,
   .resampFFTPowerOf2 = 1
@@ -426,6 +427,8 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   const BOOLEAN loadSFTs = (SFTcatalog->data[0].locator != NULL);
   const BOOLEAN generateSFTs = (optArgs.injectSources != NULL) || (optArgs.injectSqrtSX != NULL);
   XLAL_CHECK_NULL ( loadSFTs || generateSFTs, XLAL_EINVAL, "Can neither load nor generate SFTs with given parameters" );
+  XLAL_CHECK_NULL ( !optArgs.loadSFTNoiseFiles || ( loadSFTs && !generateSFTs && optArgs.assumeSqrtSX == NULL ), XLAL_EINVAL,
+                    "SFT noise files can only be used with SFTs loaded from files, without injections or assumed noise floors" );
 
   // Create top-level input data struct
   FstatInput* input;
@@ -569,7 +572,17 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
 
   // Normalise SFTs using either running median or assumed PSDs
   MultiPSDVector *runningMedian;
-  XLAL_CHECK_NULL ( (runningMedian = XLALNormalizeMultiSFTVect ( multiSFTs, optArgs.runningMedianWindow, optArgs.assumeSqrtSX )) != NULL, XLAL_EFUNC );
+  if ( optArgs.loadSFTNoiseFiles )
+    {
+      // Running medians were precomputed over the full band of the SFT files, so they agree with those
+      // computed from the loaded SFTs everywhere except near the edges of 'minFreqFull' and 'maxFreqFull'
+      XLAL_CHECK_NULL ( (runningMedian = XLALLoadMultiSFTNoise ( SFTcatalog, multiSFTs, optArgs.runningMedianWindow, NULL )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_NULL ( XLALNormalizeMultiSFTVectByPSD ( multiSFTs, runningMedian ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  else
+    {
+      XLAL_CHECK_NULL ( (runningMedian = XLALNormalizeMultiSFTVect ( multiSFTs, optArgs.runningMedianWindow, optArgs.assumeSqrtSX )) != NULL, XLAL_EFUNC );
+    }
 
   // Calculate SFT noise weights from PSD
   XLAL_CHECK_NULL ( (common->multiNoiseWeights = XLALComputeMultiNoiseWeights ( runningMedian, optArgs.runningMedianWindow, 0 )) != NULL, XLAL_EFUNC );
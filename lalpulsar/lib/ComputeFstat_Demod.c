@@ -74,6 +74,7 @@ typedef struct {
   MultiSFTVector *multiSFTs;			// Input multi-detector SFTs
   REAL8 prevAlpha, prevDelta;			// buffering: previous skyposition computed
   LIGOTimeGPS prevRefTime;			// buffering: keep track of previous refTime for SSBtimes buffering
+  MultiSSBtimesBatch *ssbBatch;			// sky-independent SSB-timing quantities, unique to SFTs
   MultiSSBtimes *prevMultiSSBtimes;		// buffering: previous multiSSB times, unique to skypos + SFTs
   MultiAMCoeffs *prevMultiAMcoef;		// buffering: previous AM-coeffs, unique to skypos + SFTs
 
@@ -164,12 +165,16 @@ XLALComputeFstatDemod ( FstatResults* Fstats,
       skypos.system = COORDINATESYSTEM_EQUATORIAL;
       skypos.longitude = thisPoint.Alpha;
       skypos.latitude  = thisPoint.Delta;
-      XLAL_CHECK ( (multiSSB = XLALGetMultiSSBtimes ( multiDetStates, skypos, thisPoint.refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+      // sky-independent SSB-timing quantities are computed once, on first use
+      if ( demod->ssbBatch == NULL ) {
+        XLAL_CHECK ( (demod->ssbBatch = XLALCreateMultiSSBtimesBatch ( multiDetStates, common->SSBprec )) != NULL, XLAL_EFUNC );
+      }
+      // SSB times are computed in-place in the buffer, re-using its memory
+      XLAL_CHECK ( XLALGetMultiSSBtimesBatch ( &demod->prevMultiSSBtimes, demod->ssbBatch, &skypos, 1, thisPoint.refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
+      multiSSB = demod->prevMultiSSBtimes;
       XLAL_CHECK ( (multiAMcoef = XLALComputeMultiAMCoeffs ( multiDetStates, multiWeights, skypos )) != NULL, XLAL_EFUNC );
 
       // store these for possible later re-use in buffer
-      XLALDestroyMultiSSBtimes ( demod->prevMultiSSBtimes );
-      demod->prevMultiSSBtimes = multiSSB;
       demod->prevRefTime = thisPoint.refTime;
       XLALDestroyMultiAMCoeffs ( demod->prevMultiAMcoef );
       demod->prevMultiAMcoef = multiAMcoef;
@@ -361,6 +366,7 @@ XLALDestroyDemodMethodData ( void* method_data )
   DemodMethodData *demod = (DemodMethodData*) method_data;
 
   XLALDestroyMultiSFTVector ( demod->multiSFTs);
+  XLALDestroyMultiSSBtimesBatch ( demod->ssbBatch );
   XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
   XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
   XLALFree ( demod );
@@ -523,6 +529,7 @@ XLALFstatInputTimeslice_Demod ( const void *method_data,
   demod_slice->prevAlpha = 0;
   demod_slice->prevDelta = 0;
   XLAL_INIT_MEM(demod_slice->prevRefTime);
+  demod_slice->ssbBatch = NULL;
   demod_slice->prevMultiSSBtimes = NULL;
   demod_slice->prevMultiAMcoef = NULL;
 
@@ -546,6 +553,7 @@ XLALDestroyFstatInputTimeslice_Demod ( void *method_data )
 
   DemodMethodData *demod = (DemodMethodData*) method_data;
 
+  XLALDestroyMultiSSBtimesBatch ( demod->ssbBatch );
   XLALDestroyMultiSSBtimes  ( demod->prevMultiSSBtimes );
   XLALDestroyMultiAMCoeffs  ( demod->prevMultiAMcoef );
 
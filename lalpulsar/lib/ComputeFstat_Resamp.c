@@ -146,6 +146,7 @@ typedef struct
   // ----- buffering -----
   PulsarDopplerParams prev_doppler;			// buffering: previous phase-evolution ("doppler") parameters
   MultiAMCoeffs *multiAMcoef;				// buffered antenna-pattern functions
+  MultiSSBtimesBatch *ssbBatch;				// sky-independent SSB-timing quantities
   MultiSSBtimes *multiSSBtimes;				// buffered SSB times, including *only* sky-position corrections, not binary
   MultiSSBtimes *multiBinaryTimes;			// buffered SRC times, including both sky- and binary corrections [to avoid re-allocating this]
 
@@ -242,6 +243,7 @@ XLALDestroyResampMethodData ( void* method_data )
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_a );
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_b );
   XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
+  XLALDestroyMultiSSBtimesBatch ( resamp->ssbBatch );
   XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
   XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
 
@@ -969,8 +971,11 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
           resamp->MmunuX[X].Dd = resamp->multiAMcoef->data[X]->D;
         }
 
-      XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
-      XLAL_CHECK ( (resamp->multiSSBtimes = XLALGetMultiSSBtimes ( common->multiDetectorStates, skypos, thisPoint->refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+      // sky-independent SSB-timing quantities are computed once, on first use
+      if ( resamp->ssbBatch == NULL ) {
+        XLAL_CHECK ( (resamp->ssbBatch = XLALCreateMultiSSBtimesBatch ( common->multiDetectorStates, common->SSBprec )) != NULL, XLAL_EFUNC );
+      }
+      XLAL_CHECK ( XLALGetMultiSSBtimesBatch ( &resamp->multiSSBtimes, resamp->ssbBatch, &skypos, 1, thisPoint->refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     } // if cannot re-use buffered solution ie if !(same_skypos && same_binary)
 
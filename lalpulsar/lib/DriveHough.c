@@ -19,6 +19,10 @@
 
 #include <lal/LALHough.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /** \cond DONT_DOXYGEN */
 
 #ifdef __GNUC__
@@ -580,6 +584,105 @@ void LALHOUGHConstructHMT_W (LALStatus                  *status,	/**< pointer to
 
 
 
+/**
+ * Calculates the total Hough map for a given trajectory in the time-frequency
+ * plane from a set of partial Hough map derivatives, optionally using their
+ * weights. This is the XLAL equivalent of LALHOUGHConstructHMT() and
+ * LALHOUGHConstructHMT_W(), except that the Hough map derivative \p hd is
+ * supplied by the caller, e.g.\ from XLALHOUGHCreateHD(), and must be zero on
+ * input; it is reset to zero on return, so it can be reused for the next map
+ * without being reallocated or re-initialized.
+ */
+int XLALHOUGHConstructHMT ( HOUGHMapTotal                   *ht,	/**< [out] the Hough map */
+			    HOUGHMapDeriv                   *hd,	/**< [in,out] Hough map derivative workspace; zero on input and return */
+			    const UINT8FrequencyIndexVector *freqInd,	/**< [in] time-frequency trajectory */
+			    const PHMDVectorSequence        *phmdVS,	/**< [in] set of partial Hough map derivatives */
+			    BOOLEAN                         useWeights	/**< [in] whether to use the weights of the partial Hough map derivatives */
+			    )
+{
+
+  XLAL_CHECK ( ht != NULL && hd != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( freqInd != NULL && freqInd->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( phmdVS != NULL && phmdVS->phmd != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( freqInd->length == phmdVS->length, XLAL_ESIZE, "Trajectory length %u != number of PHMDs per frequency %u", freqInd->length, phmdVS->length );
+  XLAL_CHECK ( freqInd->deltaF == phmdVS->deltaF, XLAL_EINVAL, "Trajectory frequency resolution %g != PHMD frequency resolution %g", freqInd->deltaF, phmdVS->deltaF );
+  XLAL_CHECK ( phmdVS->length > 0 && phmdVS->nfSize > 0, XLAL_ESIZE );
+  XLAL_CHECK ( phmdVS->breakLine < phmdVS->nfSize, XLAL_EINVAL );
+
+  const UINT4 length = phmdVS->length;
+  const UINT4 nfSize = phmdVS->nfSize;
+
+  /* check the trajectory lies within the cylinder before touching the map derivative */
+  for ( UINT4 k = 0; k < length; ++k ) {
+    XLAL_CHECK ( phmdVS->fBinMin <= freqInd->data[k] && freqInd->data[k] < phmdVS->fBinMin + nfSize, XLAL_EDOM, "Frequency bin %" LAL_UINT8_FORMAT " outside of PHMD cylinder [%" LAL_UINT8_FORMAT ",%" LAL_UINT8_FORMAT ")", freqInd->data[k], phmdVS->fBinMin, phmdVS->fBinMin + nfSize );
+  }
+
+  for ( UINT4 k = 0; k < length; ++k ) {
+    const UINT4 j = ( freqInd->data[k] - phmdVS->fBinMin + phmdVS->breakLine ) % nfSize;
+    if ( XLALHOUGHAddPHMD2HD ( hd, &phmdVS->phmd[j * length + k], useWeights ) != XLAL_SUCCESS ) {
+      memset ( hd->map, 0, hd->ySide * ( hd->xSide + 1 ) * sizeof ( hd->map[0] ) );
+      XLAL_ERROR ( XLAL_EFUNC );
+    }
+  }
+
+  XLAL_CHECK ( XLALHOUGHIntegrHD2HT ( ht, hd ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+/**
+ * Calculates a vector of total Hough maps, one for each trajectory in the
+ * time-frequency plane in \p freqIndVS (e.g.\ one per residual spindown), from
+ * the same set of partial Hough map derivatives. The maps are independent, and are
+ * computed in parallel by up to \p numThreads threads, each accumulating into its
+ * own Hough map derivative. The maps in \p htV must all be allocated with the same size.
+ */
+int XLALHOUGHConstructHMTVector ( HOUGHMapTotalVector                     *htV,	/**< [out] the Hough maps */
+				  const UINT8FrequencyIndexVectorSequence *freqIndVS,	/**< [in] time-frequency trajectories, one per Hough map */
+				  const PHMDVectorSequence                *phmdVS,	/**< [in] set of partial Hough map derivatives */
+				  BOOLEAN                                 useWeights,	/**< [in] whether to use the weights of the partial Hough map derivatives */
+				  UINT4                                   numThreads	/**< [in] maximum number of threads */
+				  )
+{
+
+  XLAL_CHECK ( htV != NULL && freqIndVS != NULL && phmdVS != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( htV->length == freqIndVS->length, XLAL_ESIZE, "Number of Hough maps %u != number of trajectories %u", htV->length, freqIndVS->length );
+  XLAL_CHECK ( numThreads > 0, XLAL_EINVAL );
+  if ( htV->length == 0 ) {
+    return XLAL_SUCCESS;
+  }
+  XLAL_CHECK ( htV->ht != NULL && freqIndVS->freqIndV != NULL, XLAL_EFAULT );
+  const UINT2 xSide = htV->ht[0].xSide;
+  const UINT2 ySide = htV->ht[0].ySide;
+  for ( UINT4 i = 1; i < htV->length; ++i ) {
+    XLAL_CHECK ( htV->ht[i].xSide == xSide && htV->ht[i].ySide == ySide, XLAL_ESIZE, "Hough maps have different sizes" );
+  }
+
+  int nerrors = 0;
+#pragma omp parallel num_threads(numThreads) reduction(+:nerrors)
+  {
+    HOUGHMapDeriv *hd = XLALHOUGHCreateHD ( xSide, ySide );
+    if ( hd == NULL ) {
+      ++nerrors;
+    }
+#pragma omp for schedule(dynamic)
+    for ( UINT4 i = 0; i < htV->length; ++i ) {
+      if ( hd == NULL ) {
+        continue;
+      }
+      if ( XLALHOUGHConstructHMT ( &htV->ht[i], hd, &freqIndVS->freqIndV[i], phmdVS, useWeights ) != XLAL_SUCCESS ) {
+        ++nerrors;
+      }
+    }
+    XLALHOUGHDestroyHD ( hd );
+  }
+  XLAL_CHECK ( nerrors == 0, XLAL_EFUNC, "Failed to compute %i Hough maps", nerrors );
+
+  return XLAL_SUCCESS;
+
+}
+
 /**
  * Adds weight factors for set of partial hough map derivatives -- the
  * weights must be calculated outside this function.
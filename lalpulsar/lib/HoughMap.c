@@ -440,3 +440,143 @@ void LALStereo2SkyLocation (LALStatus  *status,
   RETURN (status);
 }
 
+
+/**
+ * Create a Hough map derivative for use with XLALHOUGHAddPHMD2HD() and XLALHOUGHIntegrHD2HT(),
+ * with all pixels initialized to zero.
+ */
+HOUGHMapDeriv *XLALHOUGHCreateHD ( UINT2 xSide,	/**< number of physical pixels in the x direction */
+				   UINT2 ySide	/**< number of physical pixels in the y direction */
+				   )
+{
+  XLAL_CHECK_NULL ( xSide > 0 && ySide > 0, XLAL_ESIZE );
+
+  HOUGHMapDeriv *hd = XLALCalloc ( 1, sizeof ( *hd ) );
+  XLAL_CHECK_NULL ( hd != NULL, XLAL_ENOMEM );
+  hd->xSide = xSide;
+  hd->ySide = ySide;
+  hd->map = XLALCalloc ( ySide * ( xSide + 1 ), sizeof ( hd->map[0] ) );
+  if ( hd->map == NULL ) {
+    XLALFree ( hd );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
+
+  return hd;
+}
+
+/** Destroy a Hough map derivative created by XLALHOUGHCreateHD() */
+void XLALHOUGHDestroyHD ( HOUGHMapDeriv *hd )
+{
+  if ( hd != NULL ) {
+    XLALFree ( hd->map );
+    XLALFree ( hd );
+  }
+}
+
+/* Add a weight to the pixels of a Hough map derivative marked by a border, one pixel per row */
+static int AddBorder2HD ( HoughDT *map, UINT4 stride, UINT2 xSide, UINT2 ySide, const HOUGHBorder *border, HoughDT weight )
+{
+
+  INT4 yLower = border->yLower;
+  INT4 yUpper = border->yUpper;
+  if ( yLower < 0 ) {
+    XLALPrintWarning ( "%s: fixing yLower (%d -> 0)\n", __func__, yLower );
+    yLower = 0;
+  }
+  if ( yUpper >= ySide ) {
+    XLALPrintWarning ( "%s: fixing yUpper (%d -> %d)\n", __func__, yUpper, ySide - 1 );
+    yUpper = ySide - 1;
+  }
+  if ( yUpper < yLower ) {
+    return XLAL_SUCCESS;
+  }
+
+  /* check the x pixels of all rows in one pass, so that the update loop is free of branches */
+  const COORType *xPixel = border->xPixel;
+  COORType xMin = xPixel[yLower], xMax = xPixel[yLower];
+  for ( INT4 j = yLower + 1; j <= yUpper; ++j ) {
+    xMin = ( xPixel[j] < xMin ) ? xPixel[j] : xMin;
+    xMax = ( xPixel[j] > xMax ) ? xPixel[j] : xMax;
+  }
+  XLAL_CHECK ( 0 <= xMin && xMax <= xSide, XLAL_ESIZE, "Border x pixels [%d,%d] outside of map derivative [0,%d]", xMin, xMax, xSide );
+
+  HoughDT *row = map + yLower * stride;
+  for ( INT4 j = yLower; j <= yUpper; ++j, row += stride ) {
+    row[xPixel[j]] += weight;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+/**
+ * Accumulate a partial Hough map derivative into a Hough map derivative, adding
+ * its weight (if \p useWeight is true) or 1 (otherwise) to the pixels of its left
+ * borders, and subtracting it from the pixels of its right borders.
+ */
+int XLALHOUGHAddPHMD2HD ( HOUGHMapDeriv *hd,		/**< [in,out] Hough map derivative */
+			  const HOUGHphmd *phmd,	/**< [in] partial Hough map derivative */
+			  BOOLEAN useWeight		/**< [in] whether to use the weight of \p phmd */
+			  )
+{
+
+  XLAL_CHECK ( hd != NULL && hd->map != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( phmd != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( hd->xSide > 0 && hd->ySide > 0, XLAL_ESIZE );
+
+  const UINT2 xSide = hd->xSide;
+  const UINT2 ySide = hd->ySide;
+  const UINT4 stride = xSide + 1;
+  const HoughDT weight = useWeight ? phmd->weight : 1;
+
+  /* first column correction */
+  for ( UINT4 k = 0; k < ySide; ++k ) {
+    hd->map[k * stride] += phmd->firstColumn[k] * weight;
+  }
+
+  /* left borders => increase according to weight */
+  for ( UINT4 k = 0; k < phmd->lengthLeft; ++k ) {
+    XLAL_CHECK ( AddBorder2HD ( hd->map, stride, xSide, ySide, phmd->leftBorderP[k], weight ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* right borders => decrease according to weight */
+  for ( UINT4 k = 0; k < phmd->lengthRight; ++k ) {
+    XLAL_CHECK ( AddBorder2HD ( hd->map, stride, xSide, ySide, phmd->rightBorderP[k], -weight ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+/**
+ * Construct a total Hough map from its derivative by integrating each row
+ * (x-direction). The derivative is reset to zero in the same pass, so that it can
+ * be reused to accumulate the next map without being re-initialized.
+ */
+int XLALHOUGHIntegrHD2HT ( HOUGHMapTotal *ht,	/**< [out] total Hough map */
+			   HOUGHMapDeriv *hd	/**< [in,out] Hough map derivative; reset to zero on return */
+			   )
+{
+
+  XLAL_CHECK ( hd != NULL && hd->map != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( ht != NULL && ht->map != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( hd->xSide > 0 && hd->ySide > 0, XLAL_ESIZE );
+  XLAL_CHECK ( ht->xSide == hd->xSide && ht->ySide == hd->ySide, XLAL_ESIZE, "Size mismatch between Hough map (%ux%u) and derivative (%ux%u)", ht->xSide, ht->ySide, hd->xSide, hd->ySide );
+
+  const UINT2 xSide = ht->xSide;
+  const UINT2 ySide = ht->ySide;
+
+  for ( UINT4 j = 0; j < ySide; ++j ) {
+    HoughDT *hdRow = &hd->map[j * ( xSide + 1 )];
+    HoughTT *htRow = &ht->map[j * xSide];
+    HoughTT accumulator = 0;
+    for ( UINT4 i = 0; i < xSide; ++i ) {
+      htRow[i] = ( accumulator += hdRow[i] );
+      hdRow[i] = 0;
+    }
+    hdRow[xSide] = 0;
+  }
+
+  return XLAL_SUCCESS;
+
+}
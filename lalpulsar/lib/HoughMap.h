@@ -182,6 +182,11 @@ void LALStereo2SkyLocation (LALStatus  *status,
 			    HOUGHPatchGrid    *patch,
 			    HOUGHDemodPar     *parDem);
 
+HOUGHMapDeriv *XLALHOUGHCreateHD ( UINT2 xSide, UINT2 ySide );
+void XLALHOUGHDestroyHD ( HOUGHMapDeriv *hd );
+int XLALHOUGHAddPHMD2HD ( HOUGHMapDeriv *hd, const HOUGHphmd *phmd, BOOLEAN useWeight );
+int XLALHOUGHIntegrHD2HT ( HOUGHMapTotal *ht, HOUGHMapDeriv *hd );
+
 /** @} */
 
 #ifdef  __cplusplus
@@ -56,6 +56,37 @@ struct tagBarycenterBuffer
   BOOLEAN active;		/// switch set on TRUE of buffer has been filled
 }; // struct tagBarycenterBuffer
 
+/// ---------- internal type for batch Barycentering function ----------
+struct tagBarycenterBatch
+{
+  LALDetector site;		/// detector site, with location in light-seconds
+  fixed_site_t fixed_site;	/// fixed-site quantities
+  UINT4 length;			/// number of arrival times
+  INT4 *tgpsSec;		/// arrival times: GPS seconds
+  REAL8 *tgpsNs;		/// arrival times: GPS nanoseconds
+  REAL8 *posNow[3];		/// Earth's position, from EarthState
+  REAL8 *velNow[3];		/// Earth's velocity, from EarthState
+  REAL8 *r2;			/// squared distance from SSB to center of Earth
+  REAL8 *dr2;			/// time derivative of r2
+  REAL8 *obsTerm;		/// observatory term correction (if in TDB)
+  REAL8 *einstein;		/// Einstein delay, from EarthState
+  REAL8 *deinstein;		/// time derivative of Einstein delay, from EarthState
+  REAL8 *tzeA;			/// lunisolar precession variable, from EarthState
+  REAL8 *cosThetaA;		/// cos(thetaA)
+  REAL8 *sinThetaA;		/// sin(thetaA)
+  REAL8 *cosGastZA;		/// cos(gastRad + longitude - zA)
+  REAL8 *sinGastZA;		/// sin(gastRad + longitude - zA)
+  REAL8 *cosGastLong;		/// cos(gastRad + longitude)
+  REAL8 *sinGastLong;		/// sin(gastRad + longitude)
+  REAL8 *delpsi;		/// Earth nutation variable, from EarthState
+  REAL8 *deleps;		/// Earth nutation variable, from EarthState
+  REAL8 *se[3];			/// Sun-to-Earth vector, from EarthState
+  REAL8 *dse[3];		/// time derivative of se, from EarthState
+  REAL8 *rse;			/// length of se, from EarthState
+  REAL8 *drse;			/// time derivative of rse, from EarthState
+  REAL8 *data;			/// storage for all of the above arrays
+}; // struct tagBarycenterBatch
+
 /* Internal functions */
 static void precessionMatrix( REAL8 prn[3][3], REAL8 mjd, REAL8 dpsi, REAL8 deps );
 static void observatoryEarth( REAL8 obsearth[3], const LALDetector det, const LIGOTimeGPS *tgps, REAL8 gmst, REAL8 dpsi, REAL8 deps );
@@ -519,7 +550,7 @@ XLALBarycenterEarthNew ( EarthState *earth,                /**< [out] the earth'
     REAL8 tdiffS;
     REAL8 tdiff2S;
 
-    static REAL8 scorr; /* SI second/metre correction factor */
+    REAL8 scorr; /* SI second/metre correction factor */
 
     INT4 j; /*dummy index */
 
@@ -1461,6 +1492,323 @@ XLALBarycenterOpt ( EmissionTime *emit, 		/**< [out] emission-time information *
 
 } /* XLALBarycenterOpt() */
 
+/**
+ * \brief Create a batch of arrival times at a detector, for use with XLALBarycenterBatch().
+ *
+ * The batch stores, for each arrival time set with XLALSetBarycenterBatchTime(), all quantities
+ * of XLALBarycenterOpt() which are independent of the source sky-position. The detector site
+ * location must be given in light-seconds, as for BarycenterInput.
+ */
+BarycenterBatch *
+XLALCreateBarycenterBatch ( const LALDetector *site,	/**< [in] detector site, with location in light-seconds */
+                            UINT4 length		/**< [in] number of arrival times */
+                            )
+{
+  XLAL_CHECK_NULL ( site != NULL, XLAL_EINVAL, "Invalid input: site == NULL");
+  XLAL_CHECK_NULL ( length > 0, XLAL_EINVAL, "Invalid input: length == 0");
+
+  BarycenterBatch *batch = XLALCalloc ( 1, sizeof(*batch) );
+  XLAL_CHECK_NULL ( batch != NULL, XLAL_ENOMEM );
+  batch->length = length;
+
+  // compute detector site-position dependent quantities, as in XLALBarycenterOpt()
+  batch->site = (*site);
+  fixed_site_t *fs = &batch->fixed_site;
+  fs->rd = sqrt( + site->location[0]*site->location[0]
+                 + site->location[1]*site->location[1]
+                 + site->location[2]*site->location[2] );
+  fs->longitude = atan2 ( site->location[1], site->location[0] );
+  if ( fs->rd == 0.0 )
+    fs->latitude = LAL_PI_2;	// avoid division by 0, for detector at center of earth
+  else
+    fs->latitude = LAL_PI_2 - acos ( site->location[2] / fs->rd );
+  fs->sinLat = sin ( fs->latitude );
+  fs->cosLat = cos ( fs->latitude );
+  fs->rd_sinLat = fs->rd * fs->sinLat;
+  fs->rd_cosLat = fs->rd * fs->cosLat;
+
+  // allocate one contiguous array per quantity
+  const UINT4 numArrays = 29;
+  batch->tgpsSec = XLALCalloc ( length, sizeof(batch->tgpsSec[0]) );
+  batch->data = XLALCalloc ( numArrays * length, sizeof(batch->data[0]) );
+  if ( batch->tgpsSec == NULL || batch->data == NULL )
+    {
+      XLALDestroyBarycenterBatch ( batch );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM );
+    }
+  REAL8 *p = batch->data;
+  batch->tgpsNs = p; p += length;
+  for ( UINT4 j = 0; j < 3; j++ ) {
+    batch->posNow[j] = p; p += length;
+    batch->velNow[j] = p; p += length;
+    batch->se[j] = p; p += length;
+    batch->dse[j] = p; p += length;
+  }
+  batch->r2 = p; p += length;
+  batch->dr2 = p; p += length;
+  batch->obsTerm = p; p += length;
+  batch->einstein = p; p += length;
+  batch->deinstein = p; p += length;
+  batch->tzeA = p; p += length;
+  batch->cosThetaA = p; p += length;
+  batch->sinThetaA = p; p += length;
+  batch->cosGastZA = p; p += length;
+  batch->sinGastZA = p; p += length;
+  batch->cosGastLong = p; p += length;
+  batch->sinGastLong = p; p += length;
+  batch->delpsi = p; p += length;
+  batch->deleps = p; p += length;
+  batch->rse = p; p += length;
+  batch->drse = p; p += length;
+  if ( p != batch->data + numArrays * length )
+    {
+      XLALDestroyBarycenterBatch ( batch );
+      XLAL_ERROR_NULL ( XLAL_EFAILED );
+    }
+
+  return batch;
+
+} /* XLALCreateBarycenterBatch() */
+
+/**
+ * \brief Destroy a batch of arrival times created with XLALCreateBarycenterBatch().
+ */
+void
+XLALDestroyBarycenterBatch ( BarycenterBatch *batch )
+{
+  if ( batch == NULL )
+    return;
+  XLALFree ( batch->tgpsSec );
+  XLALFree ( batch->data );
+  XLALFree ( batch );
+} /* XLALDestroyBarycenterBatch() */
+
+/**
+ * \brief Set the 'i'th arrival time of a batch, and compute its sky-independent quantities.
+ */
+int
+XLALSetBarycenterBatchTime ( BarycenterBatch *batch,	/**< [in/out] batch of arrival times */
+                             UINT4 i,			/**< [in] index of arrival time */
+                             const LIGOTimeGPS *tgps,	/**< [in] GPS arrival time */
+                             const EarthState *earth	/**< [in] earth-state at 'tgps' (from XLALBarycenterEarth()) */
+                             )
+{
+  XLAL_CHECK ( batch != NULL, XLAL_EINVAL, "Invalid input: batch == NULL");
+  XLAL_CHECK ( i < batch->length, XLAL_EINVAL, "Invalid input: i = %u >= %u = batch->length", i, batch->length );
+  XLAL_CHECK ( tgps != NULL, XLAL_EINVAL, "Invalid input: tgps == NULL");
+  XLAL_CHECK ( earth != NULL, XLAL_EINVAL, "Invalid input: earth == NULL");
+
+  batch->tgpsSec[i] = tgps->gpsSeconds;
+  batch->tgpsNs[i]  = tgps->gpsNanoSeconds;
+
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      batch->posNow[j][i] = earth->posNow[j];
+      batch->velNow[j][i] = earth->velNow[j];
+      batch->se[j][i]     = earth->se[j];
+      batch->dse[j][i]    = earth->dse[j];
+    }
+
+  // squared distance from SSB to center of earth, and its time derivative
+  REAL8 r2 = 0, dr2 = 0;
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      r2  += earth->posNow[j] * earth->posNow[j];
+      dr2 += 2.0 * earth->posNow[j] * earth->velNow[j];
+    }
+  batch->r2[i]  = r2;
+  batch->dr2[i] = dr2;
+
+  // observatory term (if in TDB)
+  REAL8 obsTerm = 0;
+  if ( earth->ttype != TIMECORRECTION_ORIGINAL )
+    {
+      REAL8 obsEarth[3];
+      observatoryEarth( obsEarth, batch->site, tgps, earth->gmstRad, earth->delpsi, earth->deleps );
+
+      for ( UINT4 j = 0; j < 3; j++ )
+        obsTerm += obsEarth[j] * earth->velNow[j];
+
+      obsTerm /= (1.0-IFTE_LC)*(REAL8)IFTE_K;
+    }
+  batch->obsTerm[i] = obsTerm;
+
+  batch->einstein[i]  = earth->einstein;
+  batch->deinstein[i] = earth->deinstein;
+
+  // Earth rotation, lunisolar precession and nutation
+  const REAL8 longitude = batch->fixed_site.longitude;
+  batch->tzeA[i]        = earth->tzeA;
+  batch->cosThetaA[i]   = cos ( earth->thetaA );
+  batch->sinThetaA[i]   = sin ( earth->thetaA );
+  batch->cosGastZA[i]   = cos ( earth->gastRad + longitude-earth->zA );
+  batch->sinGastZA[i]   = sin ( earth->gastRad + longitude-earth->zA );
+  batch->cosGastLong[i] = cos ( earth->gastRad + longitude );
+  batch->sinGastLong[i] = sin ( earth->gastRad + longitude );
+  batch->delpsi[i]      = earth->delpsi;
+  batch->deleps[i]      = earth->deleps;
+
+  // Sun-Earth vector
+  batch->rse[i]  = earth->rse;
+  batch->drse[i] = earth->drse;
+
+  return XLAL_SUCCESS;
+
+} /* XLALSetBarycenterBatchTime() */
+
+/**
+ * \brief Batch version of XLALBarycenterOpt(), for all arrival times of a batch and many sky-positions.
+ *
+ * Only the sky-dependent parts of XLALBarycenterOpt() are computed here; these are evaluated for
+ * each sky-position in a single loop over the arrival times, each quantity of which is stored
+ * contiguously in the batch. The same expressions as in XLALBarycenterOpt() are evaluated, so the
+ * results agree with it to within floating-point rounding.
+ *
+ * The emission times \c te and their derivatives \c tDot for arrival time \c i and sky-position
+ * \c k are returned in element <tt>k*length + i</tt>, where \c length is the number of arrival times.
+ */
+int
+XLALBarycenterBatch ( LIGOTimeGPS *te,			/**< [out] emission times, for each sky-position and arrival time */
+                      REAL8 *tDot,			/**< [out] d(emission time)/d(arrival time), for each sky-position and arrival time */
+                      const BarycenterBatch *batch,	/**< [in] batch of arrival times */
+                      const REAL8 *alpha,		/**< [in] source right ascensions in ICRS J2000 coords (radians) */
+                      const REAL8 *delta,		/**< [in] source declinations in ICRS J2000 coords (radians) */
+                      REAL8 dInv,			/**< [in] 1/(distance to source), in 1/sec */
+                      UINT4 numSky			/**< [in] number of sky-positions */
+                      )
+{
+  XLAL_CHECK ( te != NULL, XLAL_EINVAL, "Invalid input: te == NULL");
+  XLAL_CHECK ( tDot != NULL, XLAL_EINVAL, "Invalid input: tDot == NULL");
+  XLAL_CHECK ( batch != NULL, XLAL_EINVAL, "Invalid input: batch == NULL");
+  XLAL_CHECK ( alpha != NULL, XLAL_EINVAL, "Invalid input: alpha == NULL");
+  XLAL_CHECK ( delta != NULL, XLAL_EINVAL, "Invalid input: delta == NULL");
+
+  // physical constants used by Curt (see XLALBarycenterOpt())
+  const REAL8 OMEGA = 7.29211510e-5;  /* ang. vel. of Earth (rad/sec)*/
+  const REAL8 sinEps0 = 0.397777155931914; 	// sin ( eps0 );
+  const REAL8 cosEps0 = 0.917482062069182;	// cos ( eps0 );
+  const REAL8 rsun = 2.322; /*radius of sun in sec */
+
+  const UINT4 length = batch->length;
+  const REAL8 rd_sinLat = batch->fixed_site.rd_sinLat;
+  const REAL8 rd_cosLat = batch->fixed_site.rd_cosLat;
+
+  for ( UINT4 k = 0; k < numSky; k++ )
+    {
+      XLAL_CHECK ( fabs(alpha[k]) <= LAL_TWOPI, XLAL_EDOM, "alpha = %f outside of allowed range [-2pi,2pi]\n", alpha[k] );
+      XLAL_CHECK ( fabs(delta[k]) <= LAL_PI_2,  XLAL_EDOM, "delta = %f outside of allowed range [-pi/2,pi/2]\n", delta[k] );
+
+      // ---------- sky-position dependent quantities
+      const REAL8 sinDelta = cos ( LAL_PI/2.0 - delta[k] );	// this weird way of computing it is required to stay binary identical to Curt's function
+      const REAL8 cosDelta = sin ( LAL_PI/2.0 - delta[k] );
+      const REAL8 sinAlpha = sin ( alpha[k] );
+      const REAL8 cosAlpha = cos ( alpha[k] );
+      const REAL8 n0 = cosDelta * cosAlpha;
+      const REAL8 n1 = cosDelta * sinAlpha;
+      const REAL8 n2 = sinDelta;
+
+      // nutation direction terms (see XLALBarycenterOpt())
+      const REAL8 nutX = cosDelta * sinAlpha * cosEps0 + sinDelta * sinEps0;
+      const REAL8 nutYpsi = cosDelta * cosAlpha * cosEps0;
+      const REAL8 nutZpsi = cosDelta * cosAlpha * sinEps0;
+      const REAL8 nutZeps = cosDelta * sinAlpha;
+
+      LIGOTimeGPS *te_k = &te[(size_t)k * length];
+      REAL8 *tDot_k = &tDot[(size_t)k * length];
+
+      // ---------- loop over arrival times
+      for ( UINT4 i = 0; i < length; i++ )
+        {
+          /* Roemer delay and its time derivative */
+          REAL8 roemer = 0, droemer = 0;
+          roemer  += n0 * batch->posNow[0][i];
+          droemer += n0 * batch->velNow[0][i];
+          roemer  += n1 * batch->posNow[1][i];
+          droemer += n1 * batch->velNow[1][i];
+          roemer  += n2 * batch->posNow[2][i];
+          droemer += n2 * batch->velNow[2][i];
+
+          /* Earth's rotation, including luni-solar precession */
+          const REAL8 sinAlphaMinusZA = sin ( alpha[k] + batch->tzeA[i] );
+          const REAL8 cosAlphaMinusZA = cos ( alpha[k] + batch->tzeA[i] );
+          const REAL8 cosThetaA = batch->cosThetaA[i];
+          const REAL8 sinThetaA = batch->sinThetaA[i];
+
+          const REAL8 cosDeltaSinAlphaMinusZA = sinAlphaMinusZA * cosDelta;
+          const REAL8 cosDeltaCosAlphaMinusZA = cosAlphaMinusZA * cosThetaA * cosDelta - sinThetaA * sinDelta;
+          const REAL8 sinDeltaCurt = cosAlphaMinusZA * sinThetaA * cosDelta + cosThetaA * sinDelta;
+
+          const REAL8 cosGastZA = batch->cosGastZA[i];
+          const REAL8 sinGastZA = batch->sinGastZA[i];
+
+          REAL8 erot = rd_sinLat * sinDeltaCurt + rd_cosLat * ( cosGastZA * cosDeltaCosAlphaMinusZA + sinGastZA * cosDeltaSinAlphaMinusZA );
+          REAL8 derot = OMEGA * rd_cosLat * ( - sinGastZA * cosDeltaCosAlphaMinusZA + cosGastZA * cosDeltaSinAlphaMinusZA );
+
+          /* approximate nutation */
+          const REAL8 delXNut = - batch->delpsi[i] * nutX;
+          const REAL8 delYNut = nutYpsi * batch->delpsi[i] - sinDelta * batch->deleps[i];
+          const REAL8 delZNut = nutZpsi * batch->delpsi[i] + nutZeps * batch->deleps[i];
+
+          const REAL8 cosGastLong = batch->cosGastLong[i];
+          const REAL8 sinGastLong = batch->sinGastLong[i];
+
+          erot += rd_sinLat * delZNut + rd_cosLat * cosGastLong * delXNut + rd_cosLat * sinGastLong * delYNut;
+          derot += OMEGA * ( - rd_cosLat * sinGastLong * delXNut + rd_cosLat * cosGastLong * delYNut );
+
+          /* Shapiro delay */
+          const REAL8 seDotN  = batch->se[2][i]  * sinDelta + ( batch->se[0][i]  * cosAlpha + batch->se[1][i]  * sinAlpha ) * cosDelta;
+          const REAL8 dseDotN = batch->dse[2][i] * sinDelta + ( batch->dse[0][i] * cosAlpha + batch->dse[1][i] * sinAlpha ) * cosDelta;
+          const REAL8 rse  = batch->rse[i];
+          const REAL8 drse = batch->drse[i];
+
+          const REAL8 b = sqrt ( rse * rse - seDotN * seDotN );
+          const REAL8 db = ( rse * drse - seDotN * dseDotN ) / b;
+
+          REAL8 shapiro, dshapiro;
+          if ( ( b < rsun ) && ( seDotN < 0 ) ) /* if gw travels thru interior of Sun*/
+            {
+              shapiro  = 9.852e-6 * log ( (LAL_AU_SI/LAL_C_SI) / ( seDotN + sqrt ( rsun*rsun + seDotN*seDotN ) ) ) + 19.704e-6 * ( 1.0 - b / rsun );
+              dshapiro = - 19.704e-6 * db / rsun;
+            }
+          else /* else the usual expression*/
+            {
+              shapiro  =  9.852e-6 * log( (LAL_AU_SI/LAL_C_SI) / ( rse + seDotN ) );
+              dshapiro = -9.852e-6 * ( drse + dseDotN ) / ( rse + seDotN );
+            }
+
+          /* correct Roemer delay for finite distance to source */
+          REAL8 finiteDistCorr = 0, dfiniteDistCorr = 0;
+          if ( dInv > 1.0e-11 )	/* implement if corr.  > 1 microsec */
+            {
+              finiteDistCorr  = - 0.5 * ( batch->r2[i] - roemer * roemer ) * dInv;
+              dfiniteDistCorr = - ( 0.5 * batch->dr2[i] - roemer * droemer ) * dInv;
+            }
+
+          /* add it all up */
+          const REAL8 deltaT = roemer + erot + batch->einstein[i] - shapiro + finiteDistCorr + batch->obsTerm[i];
+          tDot_k[i] = 1.0 + droemer + derot + batch->deinstein[i] - dshapiro + dfiniteDistCorr;
+
+          const INT4 deltaTint = floor ( deltaT );
+          const REAL8 tgpsNs = batch->tgpsNs[i];
+          if ( ( 1e-9 * tgpsNs + deltaT - deltaTint ) >= 1.e0 )
+            {
+              te_k[i].gpsSeconds     = batch->tgpsSec[i] + deltaTint + 1;
+              te_k[i].gpsNanoSeconds = floor ( 1e9 * ( tgpsNs * 1e-9 + deltaT - deltaTint - 1.0 ) );
+            }
+          else
+            {
+              te_k[i].gpsSeconds     = batch->tgpsSec[i] + deltaTint;
+              te_k[i].gpsNanoSeconds = floor ( 1e9 * ( tgpsNs * 1e-9 + deltaT - deltaTint ) );
+            }
+
+        } /* for i < length */
+
+    } /* for k < numSky */
+
+  return XLAL_SUCCESS;
+
+} /* XLALBarycenterBatch() */
+
 /**
  * Function to calculate the precession matrix give Earth nutation values
  * depsilon and dpsi for a given MJD time.
@@ -1542,9 +1890,9 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
                        REAL8 dpsi,            /**< [in] dpsi for Earth nutation */
                        REAL8 deps             /**< [in] deps for Earth nutation */
                       ){
-  static REAL8 erad; /* observatory distance from Earth centre */
-  static REAL8 hlt;  /* observatory latitude */
-  static REAL8 alng; /* observatory longitude */
+  REAL8 erad; /* observatory distance from Earth centre */
+  REAL8 hlt;  /* observatory latitude */
+  REAL8 alng; /* observatory longitude */
   REAL8 tmjd = 44244. + ( XLALGPSGetREAL8( tgps ) + 51.184 )/86400.;
 
   INT4 j = 0;
@@ -1558,7 +1906,7 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
 
   alng = atan2(-det.location[1], det.location[0]);
 
-  static REAL8 siteCoord[3];
+  REAL8 siteCoord[3];
   REAL8 eeq[3], prn[3][3];
 
   siteCoord[0] = erad * cos(hlt);
@@ -265,11 +265,20 @@ EmissionTime;
 /// internal (opaque) buffer type for optimized Barycentering function
 typedef struct tagBarycenterBuffer BarycenterBuffer;
 
+/// internal (opaque) type holding the sky-independent quantities of a batch of arrival times at one detector
+typedef struct tagBarycenterBatch BarycenterBatch;
+
 /* Function prototypes. */
 int XLALBarycenterEarth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat);
 int XLALBarycenter ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth);
 int XLALBarycenterOpt ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth, BarycenterBuffer **buffer);
 
+/* Batch Barycentering: sky-independent quantities are computed once per arrival time */
+BarycenterBatch *XLALCreateBarycenterBatch ( const LALDetector *site, UINT4 length );
+void XLALDestroyBarycenterBatch ( BarycenterBatch *batch );
+int XLALSetBarycenterBatchTime ( BarycenterBatch *batch, UINT4 i, const LIGOTimeGPS *tgps, const EarthState *earth );
+int XLALBarycenterBatch ( LIGOTimeGPS *te, REAL8 *tDot, const BarycenterBatch *batch, const REAL8 *alpha, const REAL8 *delta, REAL8 dInv, UINT4 numSky );
+
 /* Function that uses time delay look-up tables to calculate time delays */
 int XLALBarycenterEarthNew ( EarthState *earth,
                              const LIGOTimeGPS *tGPS,
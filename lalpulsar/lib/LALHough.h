@@ -251,6 +251,10 @@ void LALHOUGHWeighSpacePHMD  (LALStatus            *status,
 			      REAL8Vector *weightV
 			      );
 
+int XLALHOUGHConstructHMT ( HOUGHMapTotal *ht, HOUGHMapDeriv *hd, const UINT8FrequencyIndexVector *freqInd, const PHMDVectorSequence *phmdVS, BOOLEAN useWeights );
+
+int XLALHOUGHConstructHMTVector ( HOUGHMapTotalVector *htV, const UINT8FrequencyIndexVectorSequence *freqIndVS, const PHMDVectorSequence *phmdVS, BOOLEAN useWeights, UINT4 numThreads );
+
 void LALHOUGHInitializeWeights  (LALStatus            *status,
 				 REAL8Vector *weightV
 				 );
@@ -18,6 +18,22 @@
 *  MA  02111-1307  USA
 */
 
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define USE_MMAP 1
+#endif
+
+#include <gsl/gsl_multifit.h>
+
 #include <lal/FileIO.h>
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
@@ -32,6 +48,18 @@
 #define NORM3D(x) ( SQ( (x)[0]) + SQ( (x)[1] ) + SQ ( (x)[2] ) )
 #define LENGTH3D(x) ( sqrt( NORM3D ( (x) ) ) )
 
+/* ----- binary ephemeris format ---------- */
+#define EPHEM_BINARY_MAGIC      "LALEPHEM"	/* first 8 bytes of a binary ephemeris file */
+#define EPHEM_BINARY_VERSION    1		/* current version of the binary format */
+#define EPHEM_BINARY_BYTEORDER  0x01020304	/* used to detect files written with a different byte order */
+#define EPHEM_BINARY_MAX_COEFFS 32		/* maximum number of Chebyshev coefficients per segment */
+
+/* content of a binary ephemeris file */
+enum { EPHEM_BINARY_EARTH = 1, EPHEM_BINARY_SUN = 2, EPHEM_BINARY_TIMECORR = 3 };
+
+/* encoding of the data in a binary ephemeris file */
+enum { EPHEM_BINARY_TABLE = 0, EPHEM_BINARY_CHEBYSHEV = 1 };
+
 /** \endcond */
 
 /* ----- local type definitions ---------- */
@@ -46,9 +74,34 @@ typedef struct
   UINT4 length;      	/**< number of ephemeris-data entries */
   REAL8 dt;      	/**< spacing in seconds between consecutive instants in ephemeris table.*/
   PosVelAcc *data;    	/**< array containing pos,vel,acc as extracted from ephem file. Units are sec, 1, 1/sec respectively */
+  INT4 etype;		/**< ephemeris type read from a binary ephemeris file, or -1 if not known */
+  UINT4 body;		/**< body (Earth or Sun) read from a binary ephemeris file, or 0 if not known */
 }
 EphemerisVector;
 
+/**
+ * Header of a binary ephemeris file, which is followed by the data. For a #EPHEM_BINARY_TABLE
+ * encoding, the data is the table of 'length' entries, either (gps, pos[3], vel[3], acc[3])
+ * for the Earth or Sun, or single time corrections. For a #EPHEM_BINARY_CHEBYSHEV encoding,
+ * the data is 'numCoeffs' Chebyshev coefficients for each of the 3 position components in each
+ * segment of 'segEntries' table intervals, from which the table is reconstructed on loading.
+ */
+typedef struct
+{
+  CHAR magic[8];	/**< #EPHEM_BINARY_MAGIC, without terminating NUL */
+  UINT4 byteOrder;	/**< #EPHEM_BINARY_BYTEORDER */
+  UINT4 version;	/**< #EPHEM_BINARY_VERSION */
+  UINT4 content;	/**< content of the file: Earth, Sun or time corrections */
+  INT4 etype;		/**< EphemerisType of the Earth or Sun ephemeris */
+  UINT4 encoding;	/**< encoding of the data: table or Chebyshev coefficients */
+  UINT4 length;		/**< number of table entries */
+  REAL8 start;		/**< GPS time of the first table entry */
+  REAL8 dt;		/**< spacing in seconds between consecutive table entries */
+  UINT4 numCoeffs;	/**< number of Chebyshev coefficients per segment and component */
+  UINT4 segEntries;	/**< number of table intervals spanned by each Chebyshev segment */
+}
+EphemerisBinaryHeader;
+
 /* ----- internal prototypes ---------- */
 EphemerisVector *XLALCreateEphemerisVector ( UINT4 length );
 void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
@@ -56,6 +109,15 @@ void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
 EphemerisVector * XLALReadEphemerisFile ( const CHAR *fname);
 int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3], REAL8 range[3] );
 
+static int IsEphemerisBinaryFile ( const char *fname_path );
+static int MapEphemerisBinaryFile ( const void **data, size_t *size, const char *fname_path );
+static void UnmapEphemerisBinaryFile ( const void *data, size_t size );
+static int ReadEphemerisBinaryHeader ( EphemerisBinaryHeader *header, const void *data, size_t size, const char *fname );
+static EphemerisVector *ReadEphemerisBinaryFile ( const char *fname_path );
+static UINT4 ChebyshevNumSegments ( UINT4 length, UINT4 segEntries );
+static UINT4 ChebyshevSegmentFirst ( UINT4 length, UINT4 segEntries, UINT4 seg );
+static void ChebyshevBasis ( REAL8 *T, REAL8 *dT, REAL8 *ddT, UINT4 numCoeffs, REAL8 x );
+
 /* ----- function definitions ---------- */
 
 /* ========== exported API ========== */
@@ -78,6 +140,10 @@ int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3],
  * Chebychev polynomials in these files using the conversion in the lalapps code
  * lalapps_create_time_correction_ephemeris
  *
+ * The file may also be a binary time correction file written by XLALWriteTimeCorrectionBinaryFile(),
+ * e.g.\ with lalapps_convert_ephemeris_binary, which is recognised by its content and loaded
+ * without any text parsing.
+ *
  * \ingroup LALBarycenter_h
  */
 TimeCorrectionData *
@@ -96,6 +162,37 @@ XLALInitTimeCorrections ( const CHAR *timeCorrectionFile /**< File containing Ea
   char *fname_path;
   XLAL_CHECK_NULL ( (fname_path = XLALPulsarFileResolvePath ( timeCorrectionFile )) != NULL, XLAL_EINVAL );
 
+  /* binary time correction files are mapped into memory, and copied directly into the table */
+  if ( IsEphemerisBinaryFile ( fname_path ) )
+    {
+      const void *data = NULL;
+      size_t size = 0;
+      if ( MapEphemerisBinaryFile ( &data, &size, fname_path ) != XLAL_SUCCESS ) {
+        XLALFree ( fname_path );
+        XLAL_ERROR_NULL ( XLAL_EFUNC );
+      }
+      XLALFree ( fname_path );
+      EphemerisBinaryHeader header;
+      if ( ReadEphemerisBinaryHeader ( &header, data, size, timeCorrectionFile ) != XLAL_SUCCESS || header.content != EPHEM_BINARY_TIMECORR ) {
+        UnmapEphemerisBinaryFile ( data, size );
+        XLAL_ERROR_NULL ( XLAL_EIO, "'%s' is not a valid binary time correction file\n", timeCorrectionFile );
+      }
+
+      TimeCorrectionData *tdat;
+      if ( ( tdat = XLALCalloc ( 1, sizeof(*tdat) ) ) == NULL || ( tdat->timeCorrs = XLALMalloc ( header.length * sizeof(REAL8) ) ) == NULL ) {
+        XLALFree ( tdat );
+        UnmapEphemerisBinaryFile ( data, size );
+        XLAL_ERROR_NULL ( XLAL_ENOMEM );
+      }
+      tdat->timeCorrStart = header.start;
+      tdat->dtTtable = header.dt;
+      tdat->nentriesT = header.length;
+      memcpy ( tdat->timeCorrs, ( (const char*) data ) + sizeof(header), header.length * sizeof(REAL8) );
+      UnmapEphemerisBinaryFile ( data, size );
+
+      return tdat;
+    }
+
   /* read in file with XLALParseDataFile to ignore comment header lines */
   if ( XLALParseDataFile ( &flines, fname_path ) != XLAL_SUCCESS ) {
     XLALFree ( fname_path );
@@ -192,6 +289,10 @@ XLALDestroyTimeCorrectionData ( TimeCorrectionData *tcd )
  * at that instant.  All in units of seconds; e.g. positions have
  * units of seconds, and accelerations have units 1/sec.
  *
+ * Either file may also be a binary ephemeris file written by XLALWriteEphemerisBinaryFile(),
+ * e.g.\ with lalapps_convert_ephemeris_binary, which is recognised by its content and loaded
+ * without any text parsing; its ephemeris type is then taken from the file, not the file name.
+ *
  * \ingroup LALBarycenter_h
  */
 EphemerisData *
@@ -233,18 +334,20 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   else
     sun_etype = EPHEM_DE405;
 
-  // check consistency
-  if ( earth_etype != sun_etype )
-    XLAL_ERROR_NULL (XLAL_EINVAL, "Earth '%s' and Sun '%s' ephemeris-files have inconsistent coordinate-types %d != %d\n",
-                     earthEphemerisFile, sunEphemerisFile, earth_etype, sun_etype );
-  else
-    etype = earth_etype;
-
   EphemerisVector *ephemV;
   /* ----- read EARTH ephemeris file ---------- */
   if ( ( ephemV = XLALReadEphemerisFile ( earthEphemerisFile )) == NULL )
     XLAL_ERROR_NULL (XLAL_EFUNC, "XLALReadEphemerisFile('%s') failed\n", earthEphemerisFile );
 
+  /* binary ephemeris files know their body and type */
+  if ( ephemV->body != 0 && ephemV->body != EPHEM_BINARY_EARTH )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLAL_ERROR_NULL ( XLAL_EINVAL, "Binary ephemeris-file '%s' does not contain an Earth ephemeris\n", earthEphemerisFile );
+    }
+  if ( ephemV->etype >= 0 )
+    earth_etype = ephemV->etype;
+
   /* typical position, velocity and acceleration and allowed ranged */
   REAL8 avgE[3] = {499.0,  1e-4, 2e-11 };
   REAL8 rangeE[3] = {25.0, 1e-5, 3e-12 };
@@ -264,7 +367,6 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->nentriesE = ephemV->length;
   edat->dtEtable  = ephemV->dt;
   edat->ephemE    = ephemV->data;
-  edat->etype     = etype;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
@@ -275,6 +377,16 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
       XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALReadEphemerisFile('%s') failed\n", sunEphemerisFile );
     }
 
+  /* binary ephemeris files know their body and type */
+  if ( ephemV->body != 0 && ephemV->body != EPHEM_BINARY_SUN )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLALDestroyEphemerisData ( edat );
+      XLAL_ERROR_NULL ( XLAL_EINVAL, "Binary ephemeris-file '%s' does not contain a Sun ephemeris\n", sunEphemerisFile );
+    }
+  if ( ephemV->etype >= 0 )
+    sun_etype = ephemV->etype;
+
   /* typical position, velocity and acceleration and allowed ranged */
   REAL8 avgS[3] = { 2.7, 4.2e-8, 7.0e-16 };
   REAL8 rangeS[3] = { 2.5, 1.4e-8, 2.8e-16 };
@@ -293,6 +405,17 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
+  // check consistency
+  if ( earth_etype != sun_etype )
+    {
+      XLALDestroyEphemerisData ( edat );
+      XLAL_ERROR_NULL (XLAL_EINVAL, "Earth '%s' and Sun '%s' ephemeris-files have inconsistent coordinate-types %d != %d\n",
+                       earthEphemerisFile, sunEphemerisFile, earth_etype, sun_etype );
+    }
+  else
+    etype = earth_etype;
+  edat->etype = etype;
+
   // store *copy* of ephemeris-file names in output structure
   edat->filenameE = XLALStringDuplicate( earthEphemerisFile );
   edat->filenameS = XLALStringDuplicate( sunEphemerisFile );
@@ -394,6 +517,185 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
 } /* XLALRestrictEphemerisData() */
 
 
+/**
+ * Write the Earth or Sun table of the EphemerisData 'edat' to a binary ephemeris file,
+ * which can be read back by XLALInitBarycenter() much faster than an ASCII ephemeris file.
+ *
+ * If 'numCoeffs' is zero, the table is written as is, and is read back exactly.
+ * Otherwise, the table is split into segments of 'segEntries' table intervals, and
+ * each component of the position in each segment is stored as 'numCoeffs' coefficients
+ * of a Chebyshev polynomial, fitted to the tabulated positions, velocities and accelerations;
+ * the table is then reconstructed from the polynomials and their derivatives when read back.
+ * This stores the ephemeris in fewer bytes, at an accuracy which depends on 'numCoeffs' and
+ * 'segEntries'.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteEphemerisBinaryFile ( const CHAR *fname,		/**< [in] Name of binary ephemeris file to write */
+                               const EphemerisData *edat,	/**< [in] Ephemeris data */
+                               BOOLEAN sun,			/**< [in] Write the Sun table if true, the Earth table otherwise */
+                               UINT4 numCoeffs,			/**< [in] Number of Chebyshev coefficients per segment, or zero to write the table */
+                               UINT4 segEntries			/**< [in] Number of table intervals per Chebyshev segment */
+                               )
+{
+
+  // Check input
+  XLAL_CHECK ( fname != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( edat != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( numCoeffs <= EPHEM_BINARY_MAX_COEFFS, XLAL_EINVAL, "Number of Chebyshev coefficients %u exceeds maximum %u\n", numCoeffs, EPHEM_BINARY_MAX_COEFFS );
+
+  const PosVelAcc *table = sun ? edat->ephemS : edat->ephemE;
+  const INT4 length = sun ? edat->nentriesS : edat->nentriesE;
+  const REAL8 dt = sun ? edat->dtStable : edat->dtEtable;
+  XLAL_CHECK ( table != NULL && length > 0, XLAL_EINVAL, "Empty %s ephemeris table\n", sun ? "Sun" : "Earth" );
+  for ( INT4 j = 1; j < length; ++j ) {
+    XLAL_CHECK ( table[j].gps - table[j-1].gps == dt, XLAL_EINVAL, "Invalid timestep in entry %d: t_i - t_{i-1} = %g != %g\n", j, table[j].gps - table[j-1].gps, dt );
+  }
+
+  // Fill header
+  EphemerisBinaryHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) );
+  header.byteOrder = EPHEM_BINARY_BYTEORDER;
+  header.version = EPHEM_BINARY_VERSION;
+  header.content = sun ? EPHEM_BINARY_SUN : EPHEM_BINARY_EARTH;
+  header.etype = edat->etype;
+  header.encoding = ( numCoeffs > 0 ) ? EPHEM_BINARY_CHEBYSHEV : EPHEM_BINARY_TABLE;
+  header.length = length;
+  header.start = table[0].gps;
+  header.dt = dt;
+  if ( numCoeffs > 0 ) {
+    XLAL_CHECK ( segEntries > 0 && segEntries < header.length, XLAL_EINVAL, "Chebyshev segments of %u table intervals must be shorter than the table of %u entries\n", segEntries, header.length );
+    XLAL_CHECK ( numCoeffs <= 3 * ( segEntries + 1 ), XLAL_EINVAL, "Too many Chebyshev coefficients %u for segments of %u table intervals\n", numCoeffs, segEntries );
+    header.numCoeffs = numCoeffs;
+    header.segEntries = segEntries;
+  }
+
+  // Compute data
+  REAL8 *payload = NULL;
+  size_t payload_len = 0;
+  if ( header.encoding == EPHEM_BINARY_TABLE ) {
+
+    payload_len = 10 * header.length;
+    XLAL_CHECK ( ( payload = XLALMalloc ( payload_len * sizeof(*payload) ) ) != NULL, XLAL_ENOMEM );
+    for ( UINT4 j = 0; j < header.length; ++j ) {
+      REAL8 *p = &payload[10*j];
+      p[0] = table[j].gps;
+      memcpy ( &p[1], table[j].pos, 3 * sizeof(REAL8) );
+      memcpy ( &p[4], table[j].vel, 3 * sizeof(REAL8) );
+      memcpy ( &p[7], table[j].acc, 3 * sizeof(REAL8) );
+    }
+
+  } else {
+
+    // Fit Chebyshev polynomials in each segment to positions, and to velocities and accelerations
+    // scaled by the derivative 'h' of time with respect to the Chebyshev variable in [-1, 1]
+    const UINT4 numSeg = ChebyshevNumSegments ( header.length, segEntries );
+    const UINT4 numRows = 3 * ( segEntries + 1 );
+    const REAL8 h = 0.5 * segEntries * dt;
+    payload_len = numSeg * 3 * numCoeffs;
+    XLAL_CHECK ( ( payload = XLALMalloc ( payload_len * sizeof(*payload) ) ) != NULL, XLAL_ENOMEM );
+    gsl_matrix *X = gsl_matrix_alloc ( numRows, numCoeffs );
+    gsl_vector *y = gsl_vector_alloc ( numRows );
+    gsl_vector *c = gsl_vector_alloc ( numCoeffs );
+    gsl_matrix *cov = gsl_matrix_alloc ( numCoeffs, numCoeffs );
+    gsl_multifit_linear_workspace *work = gsl_multifit_linear_alloc ( numRows, numCoeffs );
+    int errnum = ( X == NULL || y == NULL || c == NULL || cov == NULL || work == NULL ) ? XLAL_ENOMEM : 0;
+    for ( UINT4 seg = 0; errnum == 0 && seg < numSeg; ++seg ) {
+      const UINT4 first = ChebyshevSegmentFirst ( header.length, segEntries, seg );
+      for ( UINT4 i = 0; i <= segEntries; ++i ) {
+        REAL8 T[EPHEM_BINARY_MAX_COEFFS], dT[EPHEM_BINARY_MAX_COEFFS], ddT[EPHEM_BINARY_MAX_COEFFS];
+        ChebyshevBasis ( T, dT, ddT, numCoeffs, -1.0 + 2.0 * i / segEntries );
+        for ( UINT4 k = 0; k < numCoeffs; ++k ) {
+          gsl_matrix_set ( X, 3*i + 0, k, T[k] );
+          gsl_matrix_set ( X, 3*i + 1, k, dT[k] );
+          gsl_matrix_set ( X, 3*i + 2, k, ddT[k] );
+        }
+      }
+      for ( UINT4 a = 0; errnum == 0 && a < 3; ++a ) {
+        for ( UINT4 i = 0; i <= segEntries; ++i ) {
+          const PosVelAcc *e = &table[first + i];
+          gsl_vector_set ( y, 3*i + 0, e->pos[a] );
+          gsl_vector_set ( y, 3*i + 1, e->vel[a] * h );
+          gsl_vector_set ( y, 3*i + 2, e->acc[a] * h * h );
+        }
+        double chisq = 0;
+        if ( gsl_multifit_linear ( X, y, c, cov, &chisq, work ) != 0 ) {
+          errnum = XLAL_EFAILED;
+          break;
+        }
+        for ( UINT4 k = 0; k < numCoeffs; ++k ) {
+          payload[( 3*seg + a ) * numCoeffs + k] = gsl_vector_get ( c, k );
+        }
+      }
+    }
+    gsl_multifit_linear_free ( work );
+    gsl_matrix_free ( cov );
+    gsl_vector_free ( c );
+    gsl_vector_free ( y );
+    gsl_matrix_free ( X );
+    if ( errnum != 0 ) {
+      XLALFree ( payload );
+      XLAL_ERROR ( errnum, "Failed to fit Chebyshev polynomials to %s ephemeris\n", sun ? "Sun" : "Earth" );
+    }
+
+  }
+
+  // Write file
+  FILE *fp = fopen ( fname, "wb" );
+  if ( fp == NULL ) {
+    XLALFree ( payload );
+    XLAL_ERROR ( XLAL_EIO, "Failed to open '%s' for writing: %s\n", fname, strerror ( errno ) );
+  }
+  const int ok = ( fwrite ( &header, sizeof(header), 1, fp ) == 1 ) && ( fwrite ( payload, sizeof(*payload), payload_len, fp ) == payload_len );
+  XLALFree ( payload );
+  XLAL_CHECK ( fclose ( fp ) == 0 && ok, XLAL_EIO, "Failed to write '%s'\n", fname );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteEphemerisBinaryFile() */
+
+
+/**
+ * Write the TimeCorrectionData 'tdat' to a binary time correction file,
+ * which can be read back exactly by XLALInitTimeCorrections() much faster than an ASCII file.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteTimeCorrectionBinaryFile ( const CHAR *fname,			/**< [in] Name of binary time correction file to write */
+                                    const TimeCorrectionData *tdat	/**< [in] Time correction data */
+                                    )
+{
+
+  // Check input
+  XLAL_CHECK ( fname != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( tdat != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( tdat->timeCorrs != NULL && tdat->nentriesT > 0, XLAL_EINVAL, "Empty time correction table\n" );
+
+  // Fill header
+  EphemerisBinaryHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) );
+  header.byteOrder = EPHEM_BINARY_BYTEORDER;
+  header.version = EPHEM_BINARY_VERSION;
+  header.content = EPHEM_BINARY_TIMECORR;
+  header.etype = -1;
+  header.encoding = EPHEM_BINARY_TABLE;
+  header.length = tdat->nentriesT;
+  header.start = tdat->timeCorrStart;
+  header.dt = tdat->dtTtable;
+
+  // Write file
+  FILE *fp = fopen ( fname, "wb" );
+  XLAL_CHECK ( fp != NULL, XLAL_EIO, "Failed to open '%s' for writing: %s\n", fname, strerror ( errno ) );
+  const int ok = ( fwrite ( &header, sizeof(header), 1, fp ) == 1 ) && ( fwrite ( tdat->timeCorrs, sizeof(REAL8), header.length, fp ) == header.length );
+  XLAL_CHECK ( fclose ( fp ) == 0 && ok, XLAL_EIO, "Failed to write '%s'\n", fname );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteTimeCorrectionBinaryFile() */
+
+
 /* ========== internal function definitions ========== */
 
 /** simple creator function for EphemerisVector type */
@@ -411,6 +713,8 @@ XLALCreateEphemerisVector ( UINT4 length )
     }
 
   ret->length = length;
+  ret->etype = -1;
+  ret->body = 0;
 
   return ret;
 
@@ -454,6 +758,9 @@ XLALPulsarFileResolvePath ( const char *fname	  //!< [in] filename or file-path
  *
  * NOTE2: files are searches first locally, then in LAL_DATA_PATH, and finally in PKG_DATA_DIR
  * using XLALPulsarFileResolvePath()
+ *
+ * NOTE3: binary ephemeris files written by XLALWriteEphemerisBinaryFile() are recognised by
+ * their content, and read by mapping them into memory instead of parsing them.
  */
 EphemerisVector *
 XLALReadEphemerisFile ( const CHAR *fname )
@@ -480,6 +787,15 @@ XLALReadEphemerisFile ( const CHAR *fname )
 
   // if we're here, it means we found it
 
+  // binary ephemeris files are read directly
+  if ( IsEphemerisBinaryFile ( fname_path ) )
+    {
+      EphemerisVector *ephemV = ReadEphemerisBinaryFile ( fname_path );
+      XLALFree ( fname_path );
+      XLAL_CHECK_NULL ( ephemV != NULL, XLAL_EFUNC, "Failed to read binary ephemeris-file '%s'\n", fname );
+      return ephemV;
+    }
+
   // read in whole file (compressed or not) with XLALParseDataFile(), which ignores comment header lines
   LALParsedDataFile *flines = NULL;
   XLAL_CHECK_NULL ( XLALParseDataFile ( &flines, fname_path ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -648,3 +964,217 @@ XLALCheckEphemerisRanges ( const EphemerisVector *ephemV, REAL8 avg[3], REAL8 ra
   return XLAL_SUCCESS;
 
 } /* XLALCheckEphemerisRanges() */
+
+
+/** Check whether a file is a binary ephemeris file, from its first bytes */
+static int
+IsEphemerisBinaryFile ( const char *fname_path )
+{
+  FILE *fp = fopen ( fname_path, "rb" );
+  if ( fp == NULL ) {
+    return 0;
+  }
+  CHAR magic[8];
+  const int is_binary = ( fread ( magic, sizeof(magic), 1, fp ) == 1 ) && ( memcmp ( magic, EPHEM_BINARY_MAGIC, sizeof(magic) ) == 0 );
+  fclose ( fp );
+  return is_binary;
+} /* IsEphemerisBinaryFile() */
+
+/** Map a binary ephemeris file into memory, or read it if mmap() is not available */
+static int
+MapEphemerisBinaryFile ( const void **data, size_t *size, const char *fname_path )
+{
+#ifdef USE_MMAP
+  int fd = open ( fname_path, O_RDONLY );
+  XLAL_CHECK ( fd >= 0, XLAL_EIO, "Failed to open '%s': %s\n", fname_path, strerror ( errno ) );
+  struct stat st;
+  if ( fstat ( fd, &st ) != 0 || st.st_size <= 0 ) {
+    close ( fd );
+    XLAL_ERROR ( XLAL_EIO, "Failed to determine size of '%s'\n", fname_path );
+  }
+  void *p = mmap ( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  close ( fd );
+  XLAL_CHECK ( p != MAP_FAILED, XLAL_EIO, "Failed to map '%s': %s\n", fname_path, strerror ( errno ) );
+  *data = p;
+  *size = st.st_size;
+#else
+  FILE *fp = fopen ( fname_path, "rb" );
+  XLAL_CHECK ( fp != NULL, XLAL_EIO, "Failed to open '%s': %s\n", fname_path, strerror ( errno ) );
+  long len = -1;
+  if ( fseek ( fp, 0, SEEK_END ) == 0 ) {
+    len = ftell ( fp );
+  }
+  void *p = ( len > 0 && fseek ( fp, 0, SEEK_SET ) == 0 ) ? XLALMalloc ( len ) : NULL;
+  if ( p == NULL || fread ( p, len, 1, fp ) != 1 ) {
+    XLALFree ( p );
+    fclose ( fp );
+    XLAL_ERROR ( XLAL_EIO, "Failed to read '%s'\n", fname_path );
+  }
+  fclose ( fp );
+  *data = p;
+  *size = len;
+#endif
+  return XLAL_SUCCESS;
+} /* MapEphemerisBinaryFile() */
+
+/** Unmap a binary ephemeris file mapped with MapEphemerisBinaryFile() */
+static void
+UnmapEphemerisBinaryFile ( const void *data, size_t size )
+{
+#ifdef USE_MMAP
+  munmap ( (void*) data, size );
+#else
+  (void) size;
+  XLALFree ( (void*) data );
+#endif
+} /* UnmapEphemerisBinaryFile() */
+
+/** Read and check the header of a mapped binary ephemeris file */
+static int
+ReadEphemerisBinaryHeader ( EphemerisBinaryHeader *header, const void *data, size_t size, const char *fname )
+{
+  XLAL_CHECK ( size >= sizeof(*header), XLAL_EIO, "Binary ephemeris file '%s' is truncated\n", fname );
+  memcpy ( header, data, sizeof(*header) );
+  XLAL_CHECK ( memcmp ( header->magic, EPHEM_BINARY_MAGIC, sizeof(header->magic) ) == 0, XLAL_EIO, "'%s' is not a binary ephemeris file\n", fname );
+  XLAL_CHECK ( header->byteOrder == EPHEM_BINARY_BYTEORDER, XLAL_EIO, "Binary ephemeris file '%s' was written with a different byte order\n", fname );
+  XLAL_CHECK ( header->version == EPHEM_BINARY_VERSION, XLAL_EIO, "Binary ephemeris file '%s' has unsupported version %u (expected %u)\n", fname, header->version, EPHEM_BINARY_VERSION );
+  XLAL_CHECK ( header->length > 0 && header->dt > 0, XLAL_EIO, "Binary ephemeris file '%s' has an invalid table length %u or spacing %g\n", fname, header->length, header->dt );
+
+  size_t payload_len = 0;
+  switch ( header->content ) {
+  case EPHEM_BINARY_EARTH:
+  case EPHEM_BINARY_SUN:
+    switch ( header->encoding ) {
+    case EPHEM_BINARY_TABLE:
+      payload_len = 10 * (size_t) header->length;
+      break;
+    case EPHEM_BINARY_CHEBYSHEV:
+      XLAL_CHECK ( 0 < header->numCoeffs && header->numCoeffs <= EPHEM_BINARY_MAX_COEFFS, XLAL_EIO, "Binary ephemeris file '%s' has invalid number of Chebyshev coefficients %u\n", fname, header->numCoeffs );
+      XLAL_CHECK ( 0 < header->segEntries && header->segEntries < header->length, XLAL_EIO, "Binary ephemeris file '%s' has invalid Chebyshev segment length %u\n", fname, header->segEntries );
+      payload_len = 3 * (size_t) header->numCoeffs * ChebyshevNumSegments ( header->length, header->segEntries );
+      break;
+    default:
+      XLAL_ERROR ( XLAL_EIO, "Binary ephemeris file '%s' has unknown encoding %u\n", fname, header->encoding );
+    }
+    break;
+  case EPHEM_BINARY_TIMECORR:
+    XLAL_CHECK ( header->encoding == EPHEM_BINARY_TABLE, XLAL_EIO, "Binary time correction file '%s' has unsupported encoding %u\n", fname, header->encoding );
+    payload_len = header->length;
+    break;
+  default:
+    XLAL_ERROR ( XLAL_EIO, "Binary ephemeris file '%s' has unknown content %u\n", fname, header->content );
+  }
+  XLAL_CHECK ( size == sizeof(*header) + payload_len * sizeof(REAL8), XLAL_EIO, "Binary ephemeris file '%s' has size %zu, expected %zu\n", fname, size, sizeof(*header) + payload_len * sizeof(REAL8) );
+
+  return XLAL_SUCCESS;
+} /* ReadEphemerisBinaryHeader() */
+
+/** Read an Earth or Sun binary ephemeris file into an EphemerisVector */
+static EphemerisVector *
+ReadEphemerisBinaryFile ( const char *fname_path )
+{
+  const void *data = NULL;
+  size_t size = 0;
+  XLAL_CHECK_NULL ( MapEphemerisBinaryFile ( &data, &size, fname_path ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  EphemerisBinaryHeader header;
+  if ( ReadEphemerisBinaryHeader ( &header, data, size, fname_path ) != XLAL_SUCCESS || header.content == EPHEM_BINARY_TIMECORR ) {
+    UnmapEphemerisBinaryFile ( data, size );
+    XLAL_ERROR_NULL ( XLAL_EIO, "'%s' is not a valid binary Earth or Sun ephemeris file\n", fname_path );
+  }
+
+  EphemerisVector *ephemV = XLALCreateEphemerisVector ( header.length );
+  if ( ephemV == NULL ) {
+    UnmapEphemerisBinaryFile ( data, size );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+  ephemV->dt = header.dt;
+  ephemV->etype = header.etype;
+  ephemV->body = header.content;
+
+  const REAL8 *payload = (const REAL8 *) ( ( (const char*) data ) + sizeof(header) );
+  if ( header.encoding == EPHEM_BINARY_TABLE ) {
+
+    // Copy table
+    for ( UINT4 j = 0; j < header.length; ++j ) {
+      const REAL8 *p = &payload[10*j];
+      ephemV->data[j].gps = p[0];
+      memcpy ( ephemV->data[j].pos, &p[1], 3 * sizeof(REAL8) );
+      memcpy ( ephemV->data[j].vel, &p[4], 3 * sizeof(REAL8) );
+      memcpy ( ephemV->data[j].acc, &p[7], 3 * sizeof(REAL8) );
+    }
+
+  } else {
+
+    // Reconstruct table from Chebyshev polynomials and their derivatives
+    const UINT4 numSeg = ChebyshevNumSegments ( header.length, header.segEntries );
+    const REAL8 h = 0.5 * header.segEntries * header.dt;
+    for ( UINT4 j = 0; j < header.length; ++j ) {
+      UINT4 seg = j / header.segEntries;
+      if ( seg >= numSeg ) {
+        seg = numSeg - 1;
+      }
+      const UINT4 first = ChebyshevSegmentFirst ( header.length, header.segEntries, seg );
+      REAL8 T[EPHEM_BINARY_MAX_COEFFS], dT[EPHEM_BINARY_MAX_COEFFS], ddT[EPHEM_BINARY_MAX_COEFFS];
+      ChebyshevBasis ( T, dT, ddT, header.numCoeffs, -1.0 + 2.0 * ( j - first ) / header.segEntries );
+      ephemV->data[j].gps = header.start + j * header.dt;
+      for ( UINT4 a = 0; a < 3; ++a ) {
+        REAL8 c[EPHEM_BINARY_MAX_COEFFS];
+        memcpy ( c, &payload[( 3*seg + a ) * header.numCoeffs], header.numCoeffs * sizeof(REAL8) );
+        REAL8 f = 0, df = 0, ddf = 0;
+        for ( UINT4 k = 0; k < header.numCoeffs; ++k ) {
+          f += c[k] * T[k];
+          df += c[k] * dT[k];
+          ddf += c[k] * ddT[k];
+        }
+        ephemV->data[j].pos[a] = f;
+        ephemV->data[j].vel[a] = df / h;
+        ephemV->data[j].acc[a] = ddf / ( h * h );
+      }
+    }
+
+  }
+
+  UnmapEphemerisBinaryFile ( data, size );
+
+  return ephemV;
+
+} /* ReadEphemerisBinaryFile() */
+
+/** Number of Chebyshev segments, each spanning 'segEntries' intervals, needed to cover a table of 'length' entries */
+static UINT4
+ChebyshevNumSegments ( UINT4 length, UINT4 segEntries )
+{
+  return ( length - 1 + segEntries - 1 ) / segEntries;
+} /* ChebyshevNumSegments() */
+
+/**
+ * Index of the first table entry of Chebyshev segment 'seg'; the last segment is moved back
+ * to end at the last table entry, so that all segments span the same number of intervals
+ */
+static UINT4
+ChebyshevSegmentFirst ( UINT4 length, UINT4 segEntries, UINT4 seg )
+{
+  const UINT4 first = seg * segEntries;
+  return ( first + segEntries > length - 1 ) ? length - 1 - segEntries : first;
+} /* ChebyshevSegmentFirst() */
+
+/** Compute Chebyshev polynomials T_k(x), and their first and second derivatives, for k < numCoeffs */
+static void
+ChebyshevBasis ( REAL8 *T, REAL8 *dT, REAL8 *ddT, UINT4 numCoeffs, REAL8 x )
+{
+  for ( UINT4 k = 0; k < numCoeffs; ++k ) {
+    if ( k == 0 ) {
+      T[k] = 1;
+      dT[k] = ddT[k] = 0;
+    } else if ( k == 1 ) {
+      T[k] = x;
+      dT[k] = 1;
+      ddT[k] = 0;
+    } else {
+      T[k] = 2*x*T[k-1] - T[k-2];
+      dT[k] = 2*T[k-1] + 2*x*dT[k-1] - dT[k-2];
+      ddT[k] = 4*dT[k-1] + 2*x*ddT[k-1] - ddT[k-2];
+    }
+  }
+} /* ChebyshevBasis() */
@@ -37,6 +37,9 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
 TimeCorrectionData *XLALInitTimeCorrections ( const CHAR *timeCorrectionFile );
 void XLALDestroyTimeCorrectionData( TimeCorrectionData *tcd );
 
+int XLALWriteEphemerisBinaryFile ( const CHAR *fname, const EphemerisData *edat, BOOLEAN sun, UINT4 numCoeffs, UINT4 segEntries );
+int XLALWriteTimeCorrectionBinaryFile ( const CHAR *fname, const TimeCorrectionData *tdat );
+
 char *XLALPulsarFileResolvePath ( const char *fname );
 
 /** \endcond */
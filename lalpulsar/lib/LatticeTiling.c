@@ -30,6 +30,10 @@
 #include <lal/MetricUtils.h>
 #include <lal/GSLHelpers.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -79,6 +83,17 @@ typedef struct tagLT_FITSRecord {
   INT4 direction;                       ///< Direction of iteration in each tiled parameter-space dimension
 } LT_FITSRecord;
 
+///
+/// FITS record for for saving and restoring a lattice tiling block partition.
+///
+typedef struct tagLT_BlockFITSRecord {
+  INT4 int_lower;                       ///< Lower bound on generating integers of block in lowest tiled dimension
+  INT4 int_upper;                       ///< Upper bound on generating integers of block in lowest tiled dimension
+  UINT8 index;                          ///< Index of first lattice tiling point in block
+  UINT8 count;                          ///< Number of lattice tiling points in block
+  INT4 state;                           ///< Block state: 0=unclaimed, 1=claimed, 2=finished
+} LT_BlockFITSRecord;
+
 ///
 /// Lattice tiling index trie for one dimension.
 ///
@@ -123,6 +138,11 @@ struct tagLatticeTilingIterator {
   INT4 *int_upper;                      ///< Current upper parameter-space bound in generating integers
   INT4 *direction;                      ///< Direction of iteration in each tiled parameter-space dimension
   UINT8 index;                          ///< Index of current lattice tiling point
+  bool is_block;                        ///< If true, iterate over one block of a lattice tiling block partition
+  UINT4 block;                          ///< Index of block to iterate over
+  INT4 block_int_lower;                 ///< Lower bound on generating integers of block in lowest tiled dimension
+  INT4 block_int_upper;                 ///< Upper bound on generating integers of block in lowest tiled dimension
+  UINT8 block_index;                    ///< Index of first lattice tiling point in block
 };
 
 struct tagLatticeTilingLocator {
@@ -132,6 +152,17 @@ struct tagLatticeTilingLocator {
   LT_IndexTrie *index_trie;             ///< Trie for locating unique index of nearest point
 };
 
+struct tagLatticeTilingBlocks {
+  const LatticeTiling *tiling;          ///< Lattice tiling
+  size_t itr_ndim;                      ///< Number of parameter-space dimensions to iterate over
+  UINT4 nblocks;                        ///< Number of blocks
+  LT_BlockFITSRecord *blocks;           ///< Bounds, point counts, and states of each block
+  UINT4 nworkers;                       ///< Number of workers blocks are assigned to
+  UINT4 *queue;                         ///< Unfinished blocks, in order of assignment to workers
+  UINT4 *queue_head;                    ///< Start of each worker's queue of blocks
+  UINT4 *queue_tail;                    ///< End of each worker's queue of blocks
+};
+
 const UserChoices TilingLatticeChoices = {
   { TILING_LATTICE_CUBIC,               "Zn" },
   { TILING_LATTICE_CUBIC,               "cubic" },
@@ -364,6 +395,20 @@ static int LT_InitFITSRecordTable( FITSFile *file )
   return XLAL_SUCCESS;
 }
 
+///
+/// Initialise FITS table for saving and restoring a lattice tiling block partition
+///
+static int LT_InitBlockFITSRecordTable( FITSFile *file )
+{
+  XLAL_FITS_TABLE_COLUMN_BEGIN( LT_BlockFITSRecord );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, INT4, int_lower ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, INT4, int_upper ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, index ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, count ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, INT4, state ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
 ///
 /// Free memory pointed to by an index trie. The trie itself should be freed by the caller.
 ///
@@ -380,6 +425,25 @@ static void LT_FreeIndexTrie(
   }
 }
 
+///
+/// Count the number of points in a given dimension of the lattice tiling, within an index trie.
+///
+static UINT8 LT_CountIndexTrie(
+  const LT_IndexTrie *trie,             ///< [in] Lattice tiling index trie
+  const size_t ti,                      ///< [in] Current depth of the trie
+  const size_t count_ti                 ///< [in] Depth of the trie at which to count points
+  )
+{
+  if ( ti == count_ti ) {
+    return trie->int_upper - trie->int_lower + 1;
+  }
+  UINT8 count = 0;
+  for ( INT4 i = trie->int_lower; i <= trie->int_upper; ++i ) {
+    count += LT_CountIndexTrie( &trie->next[i - trie->int_lower], ti + 1, count_ti );
+  }
+  return count;
+}
+
 ///
 /// Find the nearest point within the parameter-space bounds of the lattice tiling, by polling
 /// the neighbours of an 'original' nearest point found by LT_FindNearestPoints().
@@ -1673,6 +1737,7 @@ LatticeTilingIterator *XLALCreateLatticeTilingIterator(
   itr->alternating = false;
   itr->state = 0;
   itr->index = 0;
+  itr->is_block = false;
 
   // Determine the maximum tiled dimension to iterate over
   itr->tiled_itr_ndim = 0;
@@ -1795,7 +1860,7 @@ int XLALNextLatticeTilingPoint(
     }
 
     // Initialise index
-    itr->index = 0;
+    itr->index = itr->is_block ? itr->block_index : 0;
 
     // All dimensions have changed
     changed_ti = 0;
@@ -1924,6 +1989,13 @@ int XLALNextLatticeTilingPoint(
         if ( bound->padf & LATTICE_TILING_PAD_UINTP ) {
           itr->int_upper[ti] += 1;
         }
+
+        // Restrict integer bounds in the lowest tiled dimension to the block being iterated over
+        if ( itr->is_block && ti == 0 && itr->tiled_itr_ndim > 0 ) {
+          itr->int_lower[ti] = GSL_MAX( itr->int_lower[ti], itr->block_int_lower );
+          itr->int_upper[ti] = GSL_MIN( itr->int_upper[ti], itr->block_int_upper );
+          XLAL_CHECK( itr->int_lower[ti] <= itr->int_upper[ti], XLAL_EFAILED, "Block #%u is outside the lattice tiling", itr->block );
+        }
       }
       const INT4 int_lower_i = itr->int_lower[ti];
       const INT4 int_upper_i = itr->int_upper[ti];
@@ -2159,6 +2231,16 @@ int XLALSaveLatticeTilingIterator(
     XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "index", indx, "index of current lattice tiling point" ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
+  // Write block properties
+  if ( itr->is_block ) {
+    UINT4 block = itr->block;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "block", block, "index of block to iterate over" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    INT4 block_int_lower = itr->block_int_lower;
+    XLAL_CHECK( XLALFITSHeaderWriteINT4( file, "block_int_lower", block_int_lower, "lower bound on generating integers of block" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    INT4 block_int_upper = itr->block_int_upper;
+    XLAL_CHECK( XLALFITSHeaderWriteINT4( file, "block_int_upper", block_int_upper, "upper bound on generating integers of block" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
   return XLAL_SUCCESS;
 
 }
@@ -2228,6 +2310,19 @@ int XLALRestoreLatticeTilingIterator(
     itr->index = indx;
   }
 
+  // Read and check block properties
+  if ( itr->is_block ) {
+    UINT4 block;
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "block", &block ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( block == itr->block, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
+    INT4 block_int_lower;
+    XLAL_CHECK( XLALFITSHeaderReadINT4( file, "block_int_lower", &block_int_lower ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( block_int_lower == itr->block_int_lower, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
+    INT4 block_int_upper;
+    XLAL_CHECK( XLALFITSHeaderReadINT4( file, "block_int_upper", &block_int_upper ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( block_int_upper == itr->block_int_upper, XLAL_EIO, "Could not restore iterator; invalid HDU '%s'", name );
+  }
+
   // Read FITS records from table
   for ( size_t i = 0, ti = 0; i < n; ++i ) {
 
@@ -2261,6 +2356,354 @@ int XLALRestoreLatticeTilingIterator(
 
 }
 
+LatticeTilingBlocks *XLALCreateLatticeTilingBlocks(
+  const LatticeTiling *tiling,
+  const size_t itr_ndim,
+  const UINT4 nblocks
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( tiling != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( tiling->lattice < TILING_LATTICE_MAX, XLAL_EINVAL );
+  XLAL_CHECK_NULL( 0 < itr_ndim && itr_ndim <= tiling->ndim, XLAL_EINVAL );
+  XLAL_CHECK_NULL( nblocks > 0, XLAL_EINVAL );
+
+  // Allocate memory
+  LatticeTilingBlocks *blocks = XLALCalloc( 1, sizeof( *blocks ) );
+  XLAL_CHECK_NULL( blocks != NULL, XLAL_ENOMEM );
+
+  // Store reference to lattice tiling
+  blocks->tiling = tiling;
+
+  // Set fields
+  blocks->itr_ndim = itr_ndim;
+
+  // Determine the number of tiled dimensions to iterate over
+  size_t tiled_itr_ndim = 0;
+  for ( size_t i = 0; i < itr_ndim; ++i ) {
+    if ( tiling->bounds[i].is_tiled ) {
+      ++tiled_itr_ndim;
+    }
+  }
+
+  if ( tiled_itr_ndim == 0 ) {
+
+    // Only one point to iterate over, so only one block
+    blocks->nblocks = 1;
+    blocks->blocks = XLALCalloc( 1, sizeof( *blocks->blocks ) );
+    XLAL_CHECK_NULL( blocks->blocks != NULL, XLAL_ENOMEM );
+    blocks->blocks[0].count = 1;
+
+  } else {
+
+    // Build index trie, and count the number of points over the iterated-over dimensions
+    // for each generating integer in the lowest tiled dimension
+    LatticeTilingLocator *loc = XLALCreateLatticeTilingLocator( tiling );
+    XLAL_CHECK_NULL( loc != NULL, XLAL_EFUNC );
+    const LT_IndexTrie *trie = loc->index_trie;
+    const size_t nslices = trie->int_upper - trie->int_lower + 1;
+    UINT8 *slice_count = XLALCalloc( nslices, sizeof( *slice_count ) );
+    XLAL_CHECK_NULL( slice_count != NULL, XLAL_ENOMEM );
+    UINT8 total = 0;
+    for ( size_t k = 0; k < nslices; ++k ) {
+      slice_count[k] = ( tiled_itr_ndim > 1 ) ? LT_CountIndexTrie( &trie->next[k], 1, tiled_itr_ndim - 1 ) : 1;
+      total += slice_count[k];
+    }
+
+    // Assign each slice to the block containing the start of the slice, when the points are
+    // divided evenly into blocks; this may leave some blocks empty, which are discarded
+    const UINT4 max_nblocks = GSL_MIN( nblocks, nslices );
+    blocks->blocks = XLALCalloc( max_nblocks, sizeof( *blocks->blocks ) );
+    XLAL_CHECK_NULL( blocks->blocks != NULL, XLAL_ENOMEM );
+    UINT8 index = 0;
+    UINT4 prev_b = 0;
+    for ( size_t k = 0; k < nslices; ++k ) {
+      const UINT4 b = GSL_MIN( ( index * max_nblocks ) / total, max_nblocks - 1 );
+      const INT4 int_k = trie->int_lower + k;
+      if ( blocks->nblocks == 0 || b != prev_b ) {
+        LT_BlockFITSRecord *block = &blocks->blocks[blocks->nblocks++];
+        block->int_lower = int_k;
+        block->index = index;
+        prev_b = b;
+      }
+      LT_BlockFITSRecord *block = &blocks->blocks[blocks->nblocks - 1];
+      block->int_upper = int_k;
+      block->count += slice_count[k];
+      index += slice_count[k];
+    }
+
+    // Cleanup
+    XLALFree( slice_count );
+    XLALDestroyLatticeTilingLocator( loc );
+
+  }
+
+  // Assign all blocks to a single worker
+  XLAL_CHECK_NULL( XLALAssignLatticeTilingBlocks( blocks, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return blocks;
+
+}
+
+void XLALDestroyLatticeTilingBlocks(
+  LatticeTilingBlocks *blocks
+  )
+{
+  if ( blocks ) {
+    XLALFree( blocks->blocks );
+    XLALFree( blocks->queue );
+    XLALFree( blocks->queue_head );
+    XLALFree( blocks->queue_tail );
+    XLALFree( blocks );
+  }
+}
+
+UINT4 XLALLatticeTilingBlockCount(
+  const LatticeTilingBlocks *blocks
+  )
+{
+
+  // Check input
+  XLAL_CHECK_VAL( 0, blocks != NULL, XLAL_EFAULT );
+
+  return blocks->nblocks;
+
+}
+
+UINT8 XLALLatticeTilingBlockPoints(
+  const LatticeTilingBlocks *blocks,
+  const UINT4 block
+  )
+{
+
+  // Check input
+  XLAL_CHECK_VAL( 0, blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK_VAL( 0, block < blocks->nblocks, XLAL_EINVAL );
+
+  return blocks->blocks[block].count;
+
+}
+
+LatticeTilingIterator *XLALCreateLatticeTilingBlockIterator(
+  const LatticeTilingBlocks *blocks,
+  const UINT4 block
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( block < blocks->nblocks, XLAL_EINVAL );
+
+  // Create iterator over the whole lattice tiling
+  LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator( blocks->tiling, blocks->itr_ndim );
+  XLAL_CHECK_NULL( itr != NULL, XLAL_EFUNC );
+
+  // Restrict iterator to block
+  itr->is_block = true;
+  itr->block = block;
+  itr->block_int_lower = blocks->blocks[block].int_lower;
+  itr->block_int_upper = blocks->blocks[block].int_upper;
+  itr->block_index = blocks->blocks[block].index;
+
+  return itr;
+
+}
+
+int XLALAssignLatticeTilingBlocks(
+  LatticeTilingBlocks *blocks,
+  const UINT4 nworkers
+  )
+{
+
+  // Check input
+  XLAL_CHECK( blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nworkers > 0, XLAL_EINVAL );
+
+  // (Re)allocate memory
+  XLALFree( blocks->queue );
+  XLALFree( blocks->queue_head );
+  XLALFree( blocks->queue_tail );
+  blocks->nworkers = nworkers;
+  blocks->queue = XLALCalloc( blocks->nblocks, sizeof( *blocks->queue ) );
+  XLAL_CHECK( blocks->queue != NULL, XLAL_ENOMEM );
+  blocks->queue_head = XLALCalloc( nworkers, sizeof( *blocks->queue_head ) );
+  XLAL_CHECK( blocks->queue_head != NULL, XLAL_ENOMEM );
+  blocks->queue_tail = XLALCalloc( nworkers, sizeof( *blocks->queue_tail ) );
+  XLAL_CHECK( blocks->queue_tail != NULL, XLAL_ENOMEM );
+
+  // Queue unfinished blocks in order
+  UINT4 nqueue = 0;
+  for ( UINT4 b = 0; b < blocks->nblocks; ++b ) {
+    if ( blocks->blocks[b].state < 2 ) {
+      blocks->queue[nqueue++] = b;
+    }
+  }
+
+  // Give each worker a contiguous, equal share of the queue
+  for ( UINT4 w = 0; w < nworkers; ++w ) {
+    blocks->queue_head[w] = ( ( UINT8 ) w * nqueue ) / nworkers;
+    blocks->queue_tail[w] = ( ( UINT8 )( w + 1 ) * nqueue ) / nworkers;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALNextLatticeTilingBlock(
+  LatticeTilingBlocks *blocks,
+  const UINT4 worker,
+  UINT4 *block,
+  BOOLEAN *started
+  )
+{
+
+  // Check input
+  XLAL_CHECK( blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK( worker < blocks->nworkers, XLAL_EINVAL );
+  XLAL_CHECK( block != NULL, XLAL_EFAULT );
+  XLAL_CHECK( started != NULL, XLAL_EFAULT );
+
+  int retn = 0;
+#pragma omp critical (XLALLatticeTilingBlocks)
+  {
+
+    // Find a worker with a non-empty queue: this worker if possible, otherwise the worker with
+    // the longest queue; stealing from the end of its queue least disturbs the order in which
+    // that worker iterates over its blocks
+    UINT4 w = worker;
+    if ( blocks->queue_head[w] == blocks->queue_tail[w] ) {
+      for ( UINT4 v = 0; v < blocks->nworkers; ++v ) {
+        if ( blocks->queue_tail[v] - blocks->queue_head[v] > blocks->queue_tail[w] - blocks->queue_head[w] ) {
+          w = v;
+        }
+      }
+    }
+
+    // Claim block
+    if ( blocks->queue_head[w] < blocks->queue_tail[w] ) {
+      const UINT4 b = ( w == worker ) ? blocks->queue[blocks->queue_head[w]++] : blocks->queue[--blocks->queue_tail[w]];
+      *block = b;
+      *started = ( blocks->blocks[b].state == 1 );
+      blocks->blocks[b].state = 1;
+      retn = 1;
+    }
+
+  }
+
+  return retn;
+
+}
+
+int XLALFinishLatticeTilingBlock(
+  LatticeTilingBlocks *blocks,
+  const UINT4 block
+  )
+{
+
+  // Check input
+  XLAL_CHECK( blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK( block < blocks->nblocks, XLAL_EINVAL );
+  XLAL_CHECK( blocks->blocks[block].state == 1, XLAL_EINVAL, "Block #%u has not been claimed", block );
+
+  // Block is now finished
+#pragma omp critical (XLALLatticeTilingBlocks)
+  blocks->blocks[block].state = 2;
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALSaveLatticeTilingBlocks(
+  const LatticeTilingBlocks *blocks,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+
+  // Take a consistent copy of the block states
+  LT_BlockFITSRecord *records = XLALCalloc( blocks->nblocks, sizeof( *records ) );
+  XLAL_CHECK( records != NULL, XLAL_ENOMEM );
+#pragma omp critical (XLALLatticeTilingBlocks)
+  memcpy( records, blocks->blocks, blocks->nblocks * sizeof( *records ) );
+
+  // Open FITS table for writing
+  XLAL_CHECK( XLALFITSTableOpenWrite( file, name, "serialised lattice tiling block partition" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( LT_InitBlockFITSRecordTable( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Write FITS records to table
+  for ( UINT4 b = 0; b < blocks->nblocks; ++b ) {
+    XLAL_CHECK( XLALFITSTableWriteRow( file, &records[b] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write block partition properties
+  {
+    UINT4 ndim = blocks->tiling->ndim;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "ndim", ndim, "number of parameter-space dimensions" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT4 itr_ndim = blocks->itr_ndim;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "itr_ndim", itr_ndim, "number of parameter-space dimensions to iterate over" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Cleanup
+  XLALFree( records );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALRestoreLatticeTilingBlocks(
+  LatticeTilingBlocks *blocks,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( blocks != NULL, XLAL_EFAULT );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+
+  // Open FITS table for reading
+  UINT8 nrows = 0;
+  XLAL_CHECK( XLALFITSTableOpenRead( file, name, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( nrows == ( UINT8 ) blocks->nblocks, XLAL_EIO, "Could not restore block partition; invalid HDU '%s'", name );
+  XLAL_CHECK( LT_InitBlockFITSRecordTable( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Read and check block partition properties
+  {
+    UINT4 ndim;
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "ndim", &ndim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( ndim == blocks->tiling->ndim, XLAL_EIO, "Could not restore block partition; invalid HDU '%s'", name );
+  } {
+    UINT4 itr_ndim;
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "itr_ndim", &itr_ndim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( itr_ndim == blocks->itr_ndim, XLAL_EIO, "Could not restore block partition; invalid HDU '%s'", name );
+  }
+
+  // Read and check FITS records from table; the partition must be identical
+  for ( UINT4 b = 0; b < blocks->nblocks; ++b ) {
+    LT_BlockFITSRecord XLAL_INIT_DECL( record );
+    XLAL_CHECK( XLALFITSTableReadRow( file, &record, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const LT_BlockFITSRecord *block = &blocks->blocks[b];
+    XLAL_CHECK( record.int_lower == block->int_lower && record.int_upper == block->int_upper, XLAL_EIO, "Could not restore block partition; invalid HDU '%s'", name );
+    XLAL_CHECK( record.index == block->index && record.count == block->count, XLAL_EIO, "Could not restore block partition; invalid HDU '%s'", name );
+    XLAL_CHECK( 0 <= record.state && record.state <= 2, XLAL_EIO, "Could not restore block partition; invalid HDU '%s'", name );
+    blocks->blocks[b].state = record.state;
+  }
+
+  // Reassign unfinished blocks to the current number of workers
+  XLAL_CHECK( XLALAssignLatticeTilingBlocks( blocks, blocks->nworkers ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
 LatticeTilingLocator *XLALCreateLatticeTilingLocator(
   const LatticeTiling *tiling
   )
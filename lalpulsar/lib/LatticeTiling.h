@@ -57,6 +57,11 @@ typedef struct tagLatticeTilingIterator LatticeTilingIterator;
 ///
 typedef struct tagLatticeTilingLocator LatticeTilingLocator;
 
+///
+/// Partitions a lattice tiling into blocks which may be iterated over independently.
+///
+typedef struct tagLatticeTilingBlocks LatticeTilingBlocks;
+
 ///
 /// Type of lattice to generate tiling with.
 ///
@@ -454,6 +459,107 @@ int XLALRestoreLatticeTilingIterator(
   const char *name                      ///< [in] FITS HDU to restore iterator from
   );
 
+///
+/// Partition a lattice tiling into at most \c nblocks blocks of contiguous points in the lowest
+/// tiled dimension. Blocks are chosen, using the point counts of an internal index trie, to contain
+/// as near as possible equal numbers of points over the first \c itr_ndim dimensions. The partition
+/// depends only on the tiling and its arguments, so it is reproduced exactly by e.g. restarted jobs.
+///
+#ifdef SWIG // SWIG interface directives
+SWIGLAL( RETURN_OWNED_BY_1ST_ARG( int, XLALCreateLatticeTilingBlocks ) );
+#endif
+LatticeTilingBlocks *XLALCreateLatticeTilingBlocks(
+  const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  const size_t itr_ndim,                ///< [in] Number of parameter-space dimensions to iterate over
+  const UINT4 nblocks                   ///< [in] Maximum number of blocks
+  );
+
+///
+/// Destroy a lattice tiling block partition.
+///
+void XLALDestroyLatticeTilingBlocks(
+  LatticeTilingBlocks *blocks           ///< [in] Lattice tiling block partition
+  );
+
+///
+/// Return the number of blocks in a lattice tiling block partition.
+///
+UINT4 XLALLatticeTilingBlockCount(
+  const LatticeTilingBlocks *blocks     ///< [in] Lattice tiling block partition
+  );
+
+///
+/// Return the number of points in a block of a lattice tiling block partition.
+///
+UINT8 XLALLatticeTilingBlockPoints(
+  const LatticeTilingBlocks *blocks,    ///< [in] Lattice tiling block partition
+  const UINT4 block                     ///< [in] Block index
+  );
+
+///
+/// Create a new lattice tiling iterator over the points in one block of a lattice tiling block
+/// partition. XLALCurrentLatticeTilingIndex() returns the index of the current point within the
+/// whole lattice tiling, and XLALTotalLatticeTilingPoints() the total number of points in the
+/// whole lattice tiling.
+///
+#ifdef SWIG // SWIG interface directives
+SWIGLAL( RETURN_OWNED_BY_1ST_ARG( int, XLALCreateLatticeTilingBlockIterator ) );
+#endif
+LatticeTilingIterator *XLALCreateLatticeTilingBlockIterator(
+  const LatticeTilingBlocks *blocks,    ///< [in] Lattice tiling block partition
+  const UINT4 block                     ///< [in] Block index
+  );
+
+///
+/// Distribute all unfinished blocks of a lattice tiling block partition into contiguous queues,
+/// one for each of \c nworkers workers. May be called again, e.g. after
+/// XLALRestoreLatticeTilingBlocks(), to rebalance the remaining blocks over a different number of
+/// workers, but not while any blocks are being iterated over.
+///
+int XLALAssignLatticeTilingBlocks(
+  LatticeTilingBlocks *blocks,          ///< [in] Lattice tiling block partition
+  const UINT4 nworkers                  ///< [in] Number of workers
+  );
+
+///
+/// Claim the next block for a worker from its queue. If the queue is empty, a block is instead
+/// stolen from the end of the longest queue of another worker. Returns 1 if a block was claimed,
+/// 0 if there are no more blocks, and XLAL_FAILURE on error. Claiming blocks is thread-safe.
+///
+int XLALNextLatticeTilingBlock(
+  LatticeTilingBlocks *blocks,          ///< [in] Lattice tiling block partition
+  const UINT4 worker,                   ///< [in] Worker index
+  UINT4 *block,                         ///< [out] Index of claimed block
+  BOOLEAN *started                      ///< [out] Whether block was claimed but not finished before a restore
+  );
+
+///
+/// Mark a block of a lattice tiling block partition as finished.
+///
+int XLALFinishLatticeTilingBlock(
+  LatticeTilingBlocks *blocks,          ///< [in] Lattice tiling block partition
+  const UINT4 block                     ///< [in] Block index
+  );
+
+///
+/// Save the state of a lattice tiling block partition to a FITS file. Iterators over any blocks in
+/// progress should be saved alongside with XLALSaveLatticeTilingIterator().
+///
+int XLALSaveLatticeTilingBlocks(
+  const LatticeTilingBlocks *blocks,    ///< [in] Lattice tiling block partition
+  FITSFile *file,                       ///< [in] FITS file to save block partition to
+  const char *name                      ///< [in] FITS HDU to save block partition to
+  );
+
+///
+/// Restore the state of a lattice tiling block partition from a FITS file.
+///
+int XLALRestoreLatticeTilingBlocks(
+  LatticeTilingBlocks *blocks,          ///< [in] Lattice tiling block partition
+  FITSFile *file,                       ///< [in] FITS file to restore block partition from
+  const char *name                      ///< [in] FITS HDU to restore block partition from
+  );
+
 ///
 /// Create a new lattice tiling locator. If there are tiled dimensions, an index trie is internally built.
 ///
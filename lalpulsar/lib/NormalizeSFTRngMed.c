@@ -49,6 +49,7 @@
  * XLALNormalizeSFT ()
  * XLALNormalizeSFTVect ()
  * XLALNormalizeMultiSFTVect ()
+ * XLALNormalizeMultiSFTVectByPSD ()
  * \endcode
  *
  * The function XLALNormalizeSFTVect() takes as input a vector of SFTs and normalizes
@@ -57,10 +58,26 @@
  * XLALPeriodoToRngmed () which applies the running median algorithm to find a vector
  * of medians.  The function XLALNormalizeMultiSFTVect() normalizes a multi-IFO collection
  * of SFT vectors and also returns a collection of power-estimates for these vectors using
- * the Running median method.
+ * the Running median method.  The function XLALNormalizeMultiSFTVectByPSD() instead normalizes
+ * a multi-IFO collection of SFT vectors by previously computed power-estimates, such as those
+ * stored in SFT noise files by XLALWriteSFTNoiseFile().
  *
  */
 
+/* divide SFT data by the square root of a given rng-median smoothed periodogram */
+static void
+NormalizeSFTByRngmed ( SFTtype *sft, const REAL8FrequencySeries *rngmed )
+{
+  /* loop over sft and normalize */
+  for (UINT4 j = 0; j < sft->data->length; j++)
+    {
+      REAL8 Tsft_Sn_b2 = rngmed->data->data[j];		/* Wiener-Kinchine: E[|data|^2] = Tsft * Sn / 2 */
+      REAL8 norm = 1.0 / sqrt(Tsft_Sn_b2);
+      /* frequency domain normalization */
+      sft->data->data[j] *= ((REAL4) norm);
+    } // for j < length
+} /* NormalizeSFTByRngmed() */
+
 /**
  * Normalize an sft based on RngMed estimated PSD, and returns running-median.
  */
@@ -102,14 +119,8 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
       }
     }
 
-  /* loop over sft and normalize */
-  for (UINT4 j = 0; j < length; j++)
-    {
-      REAL8 Tsft_Sn_b2 = rngmed->data->data[j];		/* Wiener-Kinchine: E[|data|^2] = Tsft * Sn / 2 */
-      REAL8 norm = 1.0 / sqrt(Tsft_Sn_b2);
-      /* frequency domain normalization */
-      sft->data->data[j] *= ((REAL4) norm);
-    } // for j < length
+  /* normalize sft */
+  NormalizeSFTByRngmed ( sft, rngmed );
 
   return XLAL_SUCCESS;
 
@@ -211,6 +222,38 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
 } /* XLALNormalizeMultiSFTVect() */
 
 
+/**
+ * Function for normalizing a multi vector of SFTs by given running-median estimates of the power,
+ * e.g. as returned by XLALNormalizeMultiSFTVect() or loaded by XLALLoadMultiSFTNoise().
+ * Normalizing SFTs by the running medians they were estimated from gives the same result as XLALNormalizeMultiSFTVect().
+ */
+int
+XLALNormalizeMultiSFTVectByPSD ( MultiSFTVector *multsft,		/**< [in/out] multi-vector of SFTs which will be normalized */
+                                 const MultiPSDVector *multiPSD		/**< [in] rng-median smoothed periodograms of the SFTs (Tsft*Sn/2) */
+                                 )
+{
+  /* check input argments */
+  XLAL_CHECK ( multsft && multsft->data && multsft->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input 'multsft'");
+  XLAL_CHECK ( multiPSD && multiPSD->data && multiPSD->length == multsft->length, XLAL_EINVAL, "Invalid NULL input 'multiPSD', or number of IFOs differs from 'multsft'" );
+
+  for ( UINT4 X = 0; X < multsft->length; X++ )
+    {
+      XLAL_CHECK ( multiPSD->data[X]->length == multsft->data[X]->length, XLAL_EINVAL, "IFO X = %d: number of PSDs (%d) differs from number of SFTs (%d)", X, multiPSD->data[X]->length, multsft->data[X]->length );
+      for ( UINT4 j = 0; j < multsft->data[X]->length; j++ )
+        {
+          SFTtype *sft = &multsft->data[X]->data[j];
+          const REAL8FrequencySeries *rngmed = &multiPSD->data[X]->data[j];
+          XLAL_CHECK ( rngmed->data != NULL && rngmed->data->length == sft->data->length, XLAL_EINVAL, "IFO X = %d, SFT %d: SFT length (%d) differs from rngmed length", X, j, sft->data->length );
+          XLAL_CHECK ( XLALGPSCmp ( &rngmed->epoch, &sft->epoch ) == 0 && fabs ( rngmed->f0 - sft->f0 ) < 0.5 * sft->deltaF, XLAL_EINVAL, "IFO X = %d, SFT %d: rngmed and SFT have different timestamps or frequencies", X, j );
+          NormalizeSFTByRngmed ( sft, rngmed );
+        } /* for j < numsft */
+    } /* for X < numifo */
+
+  return XLAL_SUCCESS;
+
+} /* XLALNormalizeMultiSFTVectByPSD() */
+
+
 /**
  * Calculates a smoothed (running-median) periodogram for the given SFT.
  */
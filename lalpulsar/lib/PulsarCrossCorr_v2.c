@@ -31,6 +31,23 @@
 #define FALSE (1==0)
 
 
+// ----- local types ----------
+
+/** Internal definition of SFT pair generator */
+struct tagSFTPairGenerator {
+  UINT4 numSFTs;		/**< number of SFTs */
+  BOOLEAN inclAutoCorr;		/**< whether a "pair" of an SFT with itself is allowed */
+  UINT4 numPairs;		/**< total number of pairs */
+  UINT4 *timeOrder;		/**< indices of the SFTs in the SFT index list, in time order */
+  UINT4 *lastPartner;		/**< for each SFT in time order, the position of the last later SFT within the maximum lag */
+};
+
+/** Epoch of an SFT and its position in the SFT index list, for sorting SFTs by time */
+typedef struct tagSFTPairGeneratorTime {
+  LIGOTimeGPS epoch;
+  UINT4 sftNum;
+} SFTPairGeneratorTime;
+
 // ----- local prototypes ----------
 static int
 XLALApplyCrossCorrFreqShiftResamp
@@ -302,6 +319,136 @@ int XLALCreateSFTPairIndexList
   return XLAL_SUCCESS;
 }
 
+/** Compare SFTs by epoch, then by position in the SFT index list */
+static int
+CompareSFTPairGeneratorTimes ( const void *a, const void *b )
+{
+  const SFTPairGeneratorTime *ta = (const SFTPairGeneratorTime *) a;
+  const SFTPairGeneratorTime *tb = (const SFTPairGeneratorTime *) b;
+  int cmp = XLALGPSCmp ( &ta->epoch, &tb->epoch );
+  if ( cmp == 0 ) {
+    cmp = ( ta->sftNum > tb->sftNum ) - ( ta->sftNum < tb->sftNum );
+  }
+  return cmp;
+}
+
+/**
+ * Construct a generator of SFT pairs for inclusion in statistic.
+ * The generator yields the same pairs as XLALCreateSFTPairIndexList(), but in order of the time of their
+ * earlier SFT, and in blocks of a given length, so that the full list of pairs never needs to be stored.
+ * Only the time order of the SFTs and, for each SFT, the last SFT within the maximum lag are stored.
+ */
+SFTPairGenerator *XLALCreateSFTPairGenerator
+  (
+   const SFTIndexList     *indexList, /**< [in] list of indices to locate SFTs */
+   const MultiSFTVector        *sfts, /**< [in] set of per-detector SFT vectors */
+   REAL8                      maxLag, /**< [in] maximum allowed lag time */
+   BOOLEAN              inclAutoCorr  /**< [in] flag indicating whether a "pair" of an SFT with itself is allowed */
+  )
+{
+  XLAL_CHECK_NULL ( indexList != NULL && sfts != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( maxLag >= 0, XLAL_EINVAL );
+
+  const UINT4 numSFTs = indexList->length;
+  for ( UINT4 k = 0; k < numSFTs; k++ ) {
+    const UINT4 detInd = indexList->data[k].detInd;
+    const UINT4 sftInd = indexList->data[k].sftInd;
+    XLAL_CHECK_NULL ( detInd < sfts->length && sftInd < sfts->data[detInd]->length, XLAL_EINVAL,
+                      "SFT index %"LAL_UINT4_FORMAT" (detInd=%"LAL_UINT4_FORMAT", sftInd=%"LAL_UINT4_FORMAT") is off the end of the SFTs", k, detInd, sftInd );
+  }
+
+  SFTPairGenerator *ret = NULL;
+  XLAL_CHECK_NULL ( ( ret = XLALCalloc ( 1, sizeof ( *ret ) ) ) != NULL, XLAL_ENOMEM );
+  ret->numSFTs = numSFTs;
+  ret->inclAutoCorr = inclAutoCorr;
+  ret->timeOrder = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *ret->timeOrder ) );
+  ret->lastPartner = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *ret->lastPartner ) );
+  SFTPairGeneratorTime *times = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *times ) );
+  if ( ret->timeOrder == NULL || ret->lastPartner == NULL || times == NULL ) {
+    XLALFree ( times );
+    XLALDestroySFTPairGenerator ( ret );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
+
+  /* sort SFTs by time */
+  for ( UINT4 k = 0; k < numSFTs; k++ ) {
+    times[k].epoch = sfts->data[indexList->data[k].detInd]->data[indexList->data[k].sftInd].epoch;
+    times[k].sftNum = k;
+  }
+  qsort ( times, numSFTs, sizeof ( times[0] ), CompareSFTPairGeneratorTimes );
+
+  /* for each SFT in time order, find the last later SFT within the maximum lag */
+  UINT4 last = 0;
+  for ( UINT4 p = 0; p < numSFTs; p++ ) {
+    ret->timeOrder[p] = times[p].sftNum;
+    if ( last < p ) {
+      last = p;
+    }
+    while ( last + 1 < numSFTs && XLALGPSDiff ( &times[last + 1].epoch, &times[p].epoch ) <= maxLag ) {
+      ++last;
+    }
+    ret->lastPartner[p] = last;
+    ret->numPairs += last - p + ( inclAutoCorr ? 1 : 0 );
+  }
+
+  XLALFree ( times );
+
+  return ret;
+
+} /* XLALCreateSFTPairGenerator() */
+
+/** Return the total number of SFT pairs yielded by an SFT pair generator */
+UINT4 XLALSFTPairGeneratorNumPairs
+  (
+   const SFTPairGenerator  *generator /**< [in] SFT pair generator */
+  )
+{
+  XLAL_CHECK ( generator != NULL, XLAL_EFAULT );
+  return generator->numPairs;
+}
+
+/**
+ * Fill a block with the next SFT pairs from an SFT pair generator, starting at, and advancing, the given cursor.
+ * The block must have space for \c maxLength pairs; on return, <tt>block->length</tt> is the number of pairs
+ * in the block, which is zero once all pairs have been generated. As in XLALCreateSFTPairIndexList(),
+ * the first SFT of each pair precedes the second in the SFT index list.
+ */
+int XLALNextSFTPairBlock
+  (
+   SFTPairIndexList           *block, /**< [out] block of SFT pairs */
+   UINT4                   maxLength, /**< [in] maximum number of pairs in the block */
+   SFTPairGeneratorCursor     *cursor, /**< [in/out] position of the generator in its sequence of pairs */
+   const SFTPairGenerator  *generator /**< [in] SFT pair generator */
+  )
+{
+  XLAL_CHECK ( block != NULL && cursor != NULL && generator != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( maxLength > 0 && block->data != NULL, XLAL_EINVAL );
+
+  const UINT4 minLag = generator->inclAutoCorr ? 0 : 1;
+  UINT4 p = cursor->first;
+  UINT4 lag = MYMAX ( cursor->lag, minLag );
+  UINT4 n = 0;
+  while ( p < generator->numSFTs && n < maxLength ) {
+    if ( p + lag <= generator->lastPartner[p] ) {
+      const UINT4 sftNum1 = generator->timeOrder[p];
+      const UINT4 sftNum2 = generator->timeOrder[p + lag];
+      block->data[n].sftNum[0] = MYMIN ( sftNum1, sftNum2 );
+      block->data[n].sftNum[1] = MYMAX ( sftNum1, sftNum2 );
+      ++n;
+      ++lag;
+    } else {
+      ++p;
+      lag = minLag;
+    }
+  }
+  block->length = n;
+  cursor->first = p;
+  cursor->lag = lag;
+
+  return XLAL_SUCCESS;
+
+} /* XLALNextSFTPairBlock() */
+
 
 /** Resampling-modified: construct list of SFT pairs for inclusion in statistic */
 /* Allocates memory as well */
@@ -1044,7 +1191,162 @@ int XLALCalculateCrossCorrGammasResampShort
 } // end XLALCalculateCrossCorrGammasResampShort
 
 
-/** Calculate multi-bin cross-correlation statistic */
+/*
+ * Sum the numBins SFT bins used by the cross-correlation statistic for each SFT s, weighted by their
+ * sinc factors, the alternating sign (-1)^k of bin k, and the conjugate signal phase:
+ *   Y_s = e^{-i Phi_s} sum_j (-1)^(lowestBin_s + j) sinc_{s,j} data_s[lowestBin_s + j],   W_s = sum_j sinc_{s,j}^2
+ * The double sum over bins of each SFT pair alpha = (s1, s2) in the statistic then factorises into
+ *   nume_alpha = curlyGAmp_alpha Re[ conj(Y_s1) Y_s2 ],   curlyGSqr_alpha = curlyGAmp_alpha^2 W_s1 W_s2
+ * SFTs whose bins would run off the end of the SFT data are flagged with W_s = -1.
+ * Allocates memory for the output arrays as well.
+ */
+static int
+XLALCrossCorrWeightedBinSums
+  (
+   REAL8                   **binSumRe, /* Output: real parts of Y_s */
+   REAL8                   **binSumIm, /* Output: imaginary parts of Y_s */
+   REAL8                 **sincSqrSum, /* Output: W_s */
+   COMPLEX8Vector     *expSignalPhases, /* Input: Phase of signal for each SFT */
+   UINT4Vector             *lowestBins, /* Input: Bin index to start with for each SFT */
+   REAL8VectorSequence       *sincList, /* Input: the sinc factors */
+   SFTIndexList            *sftIndices, /* Input: flat list of SFTs */
+   MultiSFTVector           *inputSFTs, /* Input: SFT data */
+   UINT4                       numBins  /* Input: number of frequency bins to be taken into calc */
+  )
+{
+  UINT4 numSFTs = sftIndices->length;
+  REAL8 *Yre = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *Yre ) );
+  REAL8 *Yim = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *Yim ) );
+  REAL8 *W = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *W ) );
+  if ( Yre == NULL || Yim == NULL || W == NULL ) {
+    XLALFree ( Yre );
+    XLALFree ( Yim );
+    XLALFree ( W );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+
+  for (UINT4 sftNum = 0; sftNum < numSFTs; sftNum++) {
+    UINT4 detInd = sftIndices->data[sftNum].detInd;
+    UINT4 sftInd = sftIndices->data[sftNum].sftInd;
+    if ( detInd >= inputSFTs->length || sftInd >= inputSFTs->data[detInd]->length
+         || lowestBins->data[sftNum] + numBins > inputSFTs->data[detInd]->data[sftInd].data->length ) {
+      W[sftNum] = -1;
+      continue;
+    }
+    const COMPLEX8 *data = inputSFTs->data[detInd]->data[sftInd].data->data + lowestBins->data[sftNum];
+    const REAL8 *sinc = sincList->data + sftNum * numBins;
+    REAL8 sign = ( lowestBins->data[sftNum] % 2 == 0 ) ? 1 : -1;
+    COMPLEX16 Y = 0;
+    for (UINT4 j = 0; j < numBins; j++) {
+      Y += sign * sinc[j] * data[j];
+      W[sftNum] += SQUARE( sinc[j] );
+      sign = -sign;
+    }
+    Y *= conj( expSignalPhases->data[sftNum] );
+    Yre[sftNum] = creal( Y );
+    Yim[sftNum] = cimag( Y );
+  }
+
+  (*binSumRe) = Yre;
+  (*binSumIm) = Yim;
+  (*sincSqrSum) = W;
+  return XLAL_SUCCESS;
+}
+
+/* Check that the SFTs of a list of SFT pairs are valid, given the output W_s of XLALCrossCorrWeightedBinSums() */
+static int
+XLALCrossCorrCheckPairs
+  (
+   const SFTPairIndex  *pairs, /* Input: SFT pairs */
+   UINT4             numPairs, /* Input: number of SFT pairs */
+   UINT4              numSFTs, /* Input: number of SFTs */
+   const REAL8    *sincSqrSum  /* Input: W_s */
+  )
+{
+  for (UINT4 alpha = 0; alpha < numPairs; alpha++) {
+    UINT4 sftNum1 = pairs[alpha].sftNum[0];
+    UINT4 sftNum2 = pairs[alpha].sftNum[1];
+    XLAL_CHECK ( ( sftNum1 < numSFTs ) && ( sftNum2 < numSFTs ),
+		 XLAL_EINVAL,
+		 "SFT pair asked for SFT index off end of list:\n alpha=%"LAL_UINT4_FORMAT", sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", numSFTs=%"LAL_UINT4_FORMAT"\n",
+		 alpha,  sftNum1, sftNum2, numSFTs );
+    XLAL_CHECK ( ( sincSqrSum[sftNum1] >= 0 ) && ( sincSqrSum[sftNum2] >= 0 ),
+		 XLAL_EINVAL,
+		 "SFT pair asked for SFT or frequency bins off end of list:\n alpha=%"LAL_UINT4_FORMAT", sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT"\n",
+		 alpha,  sftNum1, sftNum2 );
+  }
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Add the terms of a list of SFT pairs to the sums nume and curlyGSqr of the cross-correlation statistic,
+ * given the outputs of XLALCrossCorrWeightedBinSums(). The loop keeps four independent partial sums,
+ * so that the compiler can vectorise it without reordering floating-point additions.
+ */
+static void
+XLALCrossCorrPairSums
+  (
+   REAL8                     *nume, /* Input/output: sum of curlyGAmp_alpha Re[ conj(Y_s1) Y_s2 ] */
+   REAL8                *curlyGSqr, /* Input/output: sum of curlyGAmp_alpha^2 W_s1 W_s2 */
+   const SFTPairIndex       *pairs, /* Input: SFT pairs */
+   const REAL8          *curlyGAmp, /* Input: amplitude of curly G for each pair */
+   UINT4                  numPairs, /* Input: number of SFT pairs */
+   const REAL8           *binSumRe, /* Input: real parts of Y_s */
+   const REAL8           *binSumIm, /* Input: imaginary parts of Y_s */
+   const REAL8         *sincSqrSum  /* Input: W_s */
+  )
+{
+  REAL8 sumNume[4] = {0, 0, 0, 0};
+  REAL8 sumGSqr[4] = {0, 0, 0, 0};
+  UINT4 alpha = 0;
+  for ( ; alpha + 4 <= numPairs; alpha += 4) {
+    for (UINT4 v = 0; v < 4; v++) {
+      const UINT4 s1 = pairs[alpha + v].sftNum[0];
+      const UINT4 s2 = pairs[alpha + v].sftNum[1];
+      const REAL8 G = curlyGAmp[alpha + v];
+      sumNume[v] += G * ( binSumRe[s1] * binSumRe[s2] + binSumIm[s1] * binSumIm[s2] );
+      sumGSqr[v] += SQUARE( G ) * sincSqrSum[s1] * sincSqrSum[s2];
+    }
+  }
+  for ( ; alpha < numPairs; alpha++) {
+    const UINT4 s1 = pairs[alpha].sftNum[0];
+    const UINT4 s2 = pairs[alpha].sftNum[1];
+    const REAL8 G = curlyGAmp[alpha];
+    sumNume[0] += G * ( binSumRe[s1] * binSumRe[s2] + binSumIm[s1] * binSumIm[s2] );
+    sumGSqr[0] += SQUARE( G ) * sincSqrSum[s1] * sincSqrSum[s2];
+  }
+  (*nume) += ( sumNume[0] + sumNume[1] ) + ( sumNume[2] + sumNume[3] );
+  (*curlyGSqr) += ( sumGSqr[0] + sumGSqr[1] ) + ( sumGSqr[2] + sumGSqr[3] );
+}
+
+/* Compute the cross-correlation statistic rho and (E[rho]/h0^2)^2 from the sums nume and curlyGSqr */
+static void
+XLALCrossCorrStatisticFromSums
+  (
+   REAL8                        *ccStat, /* Output: cross-correlation statistic rho */
+   REAL8                     *evSquared, /* Output: (E[rho]/h0^2)^2 */
+   REAL8                           nume, /* Input: sum of curlyGAmp_alpha Re[ conj(Y_s1) Y_s2 ] */
+   REAL8                      curlyGSqr, /* Input: sum of curlyGAmp_alpha^2 W_s1 W_s2 */
+   const MultiNoiseWeights *multiWeights  /* Input: nomalizeation factor S^-1 */
+  )
+{
+  if (curlyGSqr == 0.0)
+    {
+      *evSquared = 0.0;
+      *ccStat = 0.0;
+    }
+  else
+    {
+      *evSquared = 8 * SQUARE(multiWeights->Sinv_Tsft) * curlyGSqr;
+      *ccStat = 4 * multiWeights->Sinv_Tsft * nume / sqrt(*evSquared);
+    }
+}
+
+/**
+ * Calculate multi-bin cross-correlation statistic.
+ * The double sum over the frequency bins of each SFT pair is factorised into sums over the bins of each SFT,
+ * so the cost is O(numSFTs * numBins + numPairs) rather than O(numPairs * numBins^2).
+ */
 /* This assumes rectangular or nearly-rectangular windowing */
 int XLALCalculatePulsarCrossCorrStatistic
 (
@@ -1075,91 +1377,121 @@ int XLALCalculatePulsarCrossCorrStatistic
     XLALPrintError("Lengths of pair-indexed lists don't match!");
     XLAL_ERROR(XLAL_EBADLEN );
   }
+  REAL8 *binSumRe = NULL, *binSumIm = NULL, *sincSqrSum = NULL;
+  XLAL_CHECK ( XLALCrossCorrWeightedBinSums ( &binSumRe, &binSumIm, &sincSqrSum, expSignalPhases, lowestBins, sincList, sftIndices, inputSFTs, numBins ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   REAL8 nume = 0;
   REAL8 curlyGSqr = 0;
-  *ccStat = 0.0;
-  *evSquared = 0.0;
-  for (UINT4 alpha = 0; alpha < numPairs; alpha++) {
-    UINT4 sftNum1 = sftPairs->data[alpha].sftNum[0];
-    UINT4 sftNum2 = sftPairs->data[alpha].sftNum[1];
+  int retn = XLALCrossCorrCheckPairs ( sftPairs->data, numPairs, numSFTs, sincSqrSum );
+  if ( retn == XLAL_SUCCESS ) {
+    XLALCrossCorrPairSums ( &nume, &curlyGSqr, sftPairs->data, curlyGAmp->data, numPairs, binSumRe, binSumIm, sincSqrSum );
+  }
+  XLALFree ( binSumRe );
+  XLALFree ( binSumIm );
+  XLALFree ( sincSqrSum );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
 
-    XLAL_CHECK ( ( sftNum1 < numSFTs ) && ( sftNum2 < numSFTs ),
-		 XLAL_EINVAL,
-		 "SFT pair asked for SFT index off end of list:\n alpha=%"LAL_UINT4_FORMAT", sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", numSFTs=%"LAL_UINT4_FORMAT"\n",
-		 alpha,  sftNum1, sftNum2, numSFTs );
+  XLALCrossCorrStatisticFromSums ( ccStat, evSquared, nume, curlyGSqr, multiWeights );
 
-    UINT4 detInd1 = sftIndices->data[sftNum1].detInd;
-    UINT4 detInd2 = sftIndices->data[sftNum2].detInd;
+  return XLAL_SUCCESS;
+}
 
-    XLAL_CHECK ( ( detInd1 < inputSFTs->length )
-		 && ( detInd2 < inputSFTs->length ),
-		 XLAL_EINVAL,
-		 "SFT asked for detector index off end of list:\n sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", detInd1=%"LAL_UINT4_FORMAT", detInd2=%"LAL_UINT4_FORMAT", inputSFTs->length=%d\n",
-		 sftNum1, sftNum2, detInd1, detInd2, inputSFTs->length );
+/**
+ * Calculate multi-bin cross-correlation statistic, as XLALCalculatePulsarCrossCorrStatistic(),
+ * but generating the SFT pairs in blocks of \c pairBlockLength pairs with an SFT pair generator,
+ * and computing the pair amplitudes \f$\Gamma^{\mathrm{ave}}_\alpha\f$ of XLALCalculateCrossCorrGammas() on the fly,
+ * so that neither the SFT pairs nor their amplitudes need to be stored.
+ */
+/* This assumes rectangular or nearly-rectangular windowing */
+int XLALCalculatePulsarCrossCorrStatisticStreamed
+(
+ REAL8                         *ccStat, /* Output: cross-correlation statistic rho */
+ REAL8                      *evSquared, /* Output: (E[rho]/h0^2)^2 */
+ const SFTPairGenerator *pairGenerator, /* Input: generator of SFT pairs */
+ UINT4                 pairBlockLength, /* Input: number of SFT pairs to generate at once */
+ MultiAMCoeffs            *multiCoeffs, /* Input: AM coefficients */
+ COMPLEX8Vector       *expSignalPhases, /* Input: Phase of signal for each SFT */
+ UINT4Vector               *lowestBins, /* Input: Bin index to start with for each SFT */
+ REAL8VectorSequence         *sincList, /* Input: input the sinc factors*/
+ SFTIndexList              *sftIndices, /* Input: flat list of SFTs */
+ MultiSFTVector             *inputSFTs, /* Input: SFT data */
+ MultiNoiseWeights       *multiWeights, /* Input: nomalizeation factor S^-1 & weights for each SFT */
+ UINT4                         numBins  /* Input Number of frequency bins to be taken into calc */
+ )
+{
 
-    UINT4 sftInd1 = sftIndices->data[sftNum1].sftInd;
-    UINT4 sftInd2 = sftIndices->data[sftNum2].sftInd;
+  XLAL_CHECK ( pairGenerator != NULL && multiCoeffs != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( pairBlockLength > 0, XLAL_EINVAL );
 
-    XLAL_CHECK ( ( sftInd1 < inputSFTs->data[detInd1]->length )
-		 && ( sftInd2 < inputSFTs->data[detInd2]->length ),
-		 XLAL_EINVAL,
-		 "SFT asked for SFT index off end of list:\n sftNum1=%"LAL_UINT4_FORMAT", sftNum2=%"LAL_UINT4_FORMAT", detInd1=%"LAL_UINT4_FORMAT", detInd2=%"LAL_UINT4_FORMAT", sftInd1=%"LAL_UINT4_FORMAT", sftInd2=%"LAL_UINT4_FORMAT", inputSFTs->data[detInd1]->length=%d, inputSFTs->data[detInd2]->length=%d\n",
-		 sftNum1, sftNum2, detInd1, detInd2, sftInd1, sftInd2,
-		 inputSFTs->data[detInd1]->length,
-		 inputSFTs->data[detInd2]->length );
-
-    COMPLEX8 *dataArray1 = inputSFTs->data[detInd1]->data[sftInd1].data->data;
-    COMPLEX8 *dataArray2 = inputSFTs->data[detInd2]->data[sftInd2].data->data;
-    UINT4 lenDataArray1 = inputSFTs->data[detInd1]->data[sftInd1].data->length;
-    UINT4 lenDataArray2 = inputSFTs->data[detInd2]->data[sftInd2].data->length;
-    COMPLEX8 GalphaCC = curlyGAmp->data[alpha]
-      * expSignalPhases->data[sftNum1]
-      * conj( expSignalPhases->data[sftNum2] );
-    INT4 baseCCSign = 1; /* Alternating sign is (-1)**(k1-k2) */
-    if ( ( (lowestBins->data[sftNum1]-lowestBins->data[sftNum2]) % 2) != 0 ) {
-      baseCCSign = -1;
-    }
+  UINT4 numSFTs = sftIndices->length;
+  if ( expSignalPhases->length !=numSFTs
+       || lowestBins->length !=numSFTs
+       || sincList->length !=numSFTs
+       || pairGenerator->numSFTs !=numSFTs) {
+    XLALPrintError("Lengths of SFT-indexed lists don't match!");
+    XLAL_ERROR(XLAL_EBADLEN );
+  }
 
-    UINT4 lowestBin1 = lowestBins->data[sftNum1];
-    XLAL_CHECK ( ((lowestBin1 + numBins - 1) < lenDataArray1),
-		 XLAL_EINVAL,
-		 "Loop would run off end of array:\n lowestBin1=%d, numBins=%d, len(dataArray1)=%d\n",
-		 lowestBin1, numBins, lenDataArray1 );
-    for (UINT4 j = 0; j < numBins; j++) {
-      COMPLEX8 data1 = dataArray1[lowestBin1+j];
-
-      INT4 ccSign = baseCCSign;
-      UINT4 lowestBin2 = lowestBins->data[sftNum2];
-      XLAL_CHECK ( ((lowestBin2 + numBins - 1) < lenDataArray2),
-		   XLAL_EINVAL,
-		   "Loop would run off end of array:\n lowestBin2=%d, numBins=%d, len(dataArray2)=%d\n",
-		   lowestBin2, numBins, lenDataArray2 );
-      for (UINT4 k = 0; k < numBins; k++) {
-	COMPLEX8 data2 = dataArray2[lowestBins->data[sftNum2]+k];
-	REAL8 sincFactor =1;
-
-	sincFactor = sincList->data[sftNum1 * numBins + j] * sincList->data[sftNum2 * numBins + k];
-	nume +=  ccSign * sincFactor * creal(GalphaCC * conj(data1) * data2);
-	/*nume += creal ( GalphaCC * ccSign * sincFactor * conj(data1) * data2 );=> abs(GalphaCC)*abs(data1)*abs(data2) * cos(arg(GalphaCC)-arg(data1)+arg(data2))*/
-	/*multiWeights->data[detInd1]->data[sftNum1] *  multiWeights->data[detInd2]->data[sftNum2] **/
-	REAL8 GalphaAmp = curlyGAmp->data[alpha] * sincFactor ;
-	/** multiWeights->data[detInd1]->data[sftNum1] *  multiWeights->data[detInd2]->data[sftNum2]*/
-	curlyGSqr += SQUARE( GalphaAmp );
-	ccSign *= -1;
-      }
-      baseCCSign *= -1;
+  /* flat lists of AM coefficients for each SFT */
+  REAL8 *a = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *a ) );
+  REAL8 *b = XLALCalloc ( MYMAX ( numSFTs, 1 ), sizeof ( *b ) );
+  SFTPairIndexList block = { 0, XLALCalloc ( pairBlockLength, sizeof ( *block.data ) ) };
+  REAL8 *curlyGAmp = XLALCalloc ( pairBlockLength, sizeof ( *curlyGAmp ) );
+  REAL8 *binSumRe = NULL, *binSumIm = NULL, *sincSqrSum = NULL;
+  int retn = XLAL_SUCCESS;
+  if ( a == NULL || b == NULL || block.data == NULL || curlyGAmp == NULL ) {
+    retn = XLAL_ENOMEM;
+  }
+  for ( UINT4 sftNum = 0; retn == XLAL_SUCCESS && sftNum < numSFTs; sftNum++ ) {
+    const UINT4 detInd = sftIndices->data[sftNum].detInd;
+    const UINT4 sftInd = sftIndices->data[sftNum].sftInd;
+    if ( detInd >= multiCoeffs->length || sftInd >= multiCoeffs->data[detInd]->a->length ) {
+      XLALPrintError("SFT asked for AM coefficients off end of list:\n sftNum=%"LAL_UINT4_FORMAT", detInd=%"LAL_UINT4_FORMAT", sftInd=%"LAL_UINT4_FORMAT"\n", sftNum, detInd, sftInd );
+      retn = XLAL_EINVAL;
+      break;
     }
+    a[sftNum] = multiCoeffs->data[detInd]->a->data[sftInd];
+    b[sftNum] = multiCoeffs->data[detInd]->b->data[sftInd];
   }
-  if (curlyGSqr == 0.0)
-    {
-      *evSquared = 0.0;
-      *ccStat = 0.0;
+  if ( retn == XLAL_SUCCESS && XLALCrossCorrWeightedBinSums ( &binSumRe, &binSumIm, &sincSqrSum, expSignalPhases, lowestBins, sincList, sftIndices, inputSFTs, numBins ) != XLAL_SUCCESS ) {
+    retn = XLAL_EFUNC;
+  }
+
+  /* sum over blocks of SFT pairs */
+  REAL8 nume = 0;
+  REAL8 curlyGSqr = 0;
+  SFTPairGeneratorCursor XLAL_INIT_DECL(cursor);
+  while ( retn == XLAL_SUCCESS ) {
+    if ( XLALNextSFTPairBlock ( &block, pairBlockLength, &cursor, pairGenerator ) != XLAL_SUCCESS ) {
+      retn = XLAL_EFUNC;
+      break;
     }
-  else
-    {
-      *evSquared = 8 * SQUARE(multiWeights->Sinv_Tsft) * curlyGSqr;
-      *ccStat = 4 * multiWeights->Sinv_Tsft * nume / sqrt(*evSquared);
+    if ( block.length == 0 ) {
+      break;
+    }
+    for ( UINT4 alpha = 0; alpha < block.length; alpha++ ) {
+      const UINT4 sftNum1 = block.data[alpha].sftNum[0];
+      const UINT4 sftNum2 = block.data[alpha].sftNum[1];
+      curlyGAmp[alpha] = 0.1 * ( a[sftNum1] * a[sftNum2] + b[sftNum1] * b[sftNum2] );
     }
+    if ( XLALCrossCorrCheckPairs ( block.data, block.length, numSFTs, sincSqrSum ) != XLAL_SUCCESS ) {
+      retn = XLAL_EFUNC;
+      break;
+    }
+    XLALCrossCorrPairSums ( &nume, &curlyGSqr, block.data, curlyGAmp, block.length, binSumRe, binSumIm, sincSqrSum );
+  }
+
+  XLALFree ( a );
+  XLALFree ( b );
+  XLALFree ( block.data );
+  XLALFree ( curlyGAmp );
+  XLALFree ( binSumRe );
+  XLALFree ( binSumIm );
+  XLALFree ( sincSqrSum );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, retn );
+
+  XLALCrossCorrStatisticFromSums ( ccStat, evSquared, nume, curlyGSqr, multiWeights );
+
   return XLAL_SUCCESS;
 }
 
@@ -3151,6 +3483,23 @@ XLALDestroySFTPairIndexList ( SFTPairIndexList *sftPairs )
 
 } /* XLALDestroySFTPairIndexList() */
 
+/**
+ * Destroy an SFT pair generator.
+ */
+void
+XLALDestroySFTPairGenerator ( SFTPairGenerator *generator )
+{
+  if ( ! generator )
+    return;
+
+  XLALFree ( generator->timeOrder );
+  XLALFree ( generator->lastPartner );
+  XLALFree ( generator );
+
+  return;
+
+} /* XLALDestroySFTPairGenerator() */
+
 void XLALDestroyResampSFTIndexList( ResampSFTIndexList *sftResampList )
 {
   if ( !sftResampList )
@@ -108,6 +108,15 @@ extern "C" {
     SFTPairIndex *data; /**< array of SFT Pair indices */
   } SFTPairIndexList;
 
+/** Generator of the SFT pairs of an #SFTIndexList in order of SFT time, which yields the pairs in blocks rather than storing them all */
+  typedef struct tagSFTPairGenerator SFTPairGenerator;
+
+/** Position of an #SFTPairGenerator in its sequence of pairs; initialise to zero to start from the first pair */
+  typedef struct tagSFTPairGeneratorCursor {
+    UINT4 first; /**< position in time order of the first SFT of the next pair */
+    UINT4 lag; /**< offset in time order of the second SFT of the next pair from the first */
+  } SFTPairGeneratorCursor;
+
 
 /** Resampling Counter of matching SFTs for a given detector Y_K_X matching SFT K_X */
   typedef struct tagSFTCount {
@@ -293,6 +302,30 @@ int XLALCreateSFTPairIndexList
    )
   ;
 
+SFTPairGenerator *XLALCreateSFTPairGenerator
+(
+   const SFTIndexList     *indexList,
+   const MultiSFTVector        *sfts,
+   REAL8                      maxLag,
+   BOOLEAN              inclAutoCorr
+   )
+  ;
+
+UINT4 XLALSFTPairGeneratorNumPairs
+(
+   const SFTPairGenerator  *generator
+   )
+  ;
+
+int XLALNextSFTPairBlock
+(
+   SFTPairIndexList           *block,
+   UINT4                   maxLength,
+   SFTPairGeneratorCursor     *cursor,
+   const SFTPairGenerator  *generator
+   )
+  ;
+
 int XLALCreateSFTPairIndexListResamp
 (
    MultiResampSFTPairMultiIndexList  ** resampPairIndexList,
@@ -367,6 +400,23 @@ int XLALCalculatePulsarCrossCorrStatistic
    )
   ;
 
+int XLALCalculatePulsarCrossCorrStatisticStreamed
+  (
+   REAL8                         *ccStat,
+   REAL8                      *evSquared,
+   const SFTPairGenerator *pairGenerator,
+   UINT4                 pairBlockLength,
+   MultiAMCoeffs            *multiCoeffs,
+   COMPLEX8Vector       *expSignalPhases,
+   UINT4Vector               *lowestBins,
+   REAL8VectorSequence         *sincList,
+   SFTIndexList              *sftIndices,
+   MultiSFTVector             *inputSFTs,
+   MultiNoiseWeights       *multiWeights,
+   UINT4                         numBins
+   )
+  ;
+
 int XLALCalculatePulsarCrossCorrStatisticResamp
   (
    REAL8Vector                             *_LAL_RESTRICT_ ccStatVector,
@@ -643,6 +693,8 @@ void XLALDestroySFTIndexList ( SFTIndexList *sftIndices );
 
 void XLALDestroySFTPairIndexList ( SFTPairIndexList *sftPairs );
 
+void XLALDestroySFTPairGenerator ( SFTPairGenerator *generator );
+
 void XLALDestroyResampSFTIndexList( ResampSFTIndexList *sftResampList );
 
 void XLALDestroyResampSFTMultiIndexList( ResampSFTMultiIndexList *sftResampMultiList );
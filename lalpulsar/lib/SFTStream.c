@@ -0,0 +1,379 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <config.h>
+#include <string.h>
+#include <math.h>
+
+#include <lal/SFTStream.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/Window.h>
+#include <lal/RealFFT.h>
+#include <lal/LALString.h>
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+#define MYMAX(x,y) ( (x) > (y) ? (x) : (y) )
+
+/* ---------- internal types ---------- */
+
+/*
+ * Sample indices below are counted from the start of the current segment.
+ * Unfiltered data are kept from the start of the high-pass filter padding for the next block;
+ * filtered data are kept from the start of the next SFT.
+ */
+struct tagSFTStream {
+  SFTStreamParams params;		/* stream parameters; windowType points to an owned copy */
+  CHAR name[LALNameLength];		/* name of the time series, copied to the SFTs */
+  REAL8 deltaT;				/* sampling time of the time series; zero until data are first appended */
+  INT8 numTimesteps;			/* number of samples in an SFT */
+  INT8 stepTimesteps;			/* number of samples between consecutive SFT start times */
+  INT8 settleTimesteps;			/* number of samples of high-pass filter padding */
+  UINT4 firstBin;			/* first frequency bin to store in the SFTs */
+  UINT4 numBins;			/* number of frequency bins to store in the SFTs */
+  REAL8 windowNorm;			/* SFT normalisation: deltaT / root-mean-square of the window */
+  REAL8Window *window;			/* window applied before each FFT, or NULL */
+  REAL8FFTPlan *plan;			/* forward FFT plan, shared between threads */
+  BOOLEAN inSegment;			/* whether a segment is in progress */
+  LIGOTimeGPS segStart;			/* start time of the current segment */
+  INT8 rawFirst, rawEnd;		/* range of unfiltered samples in 'raw' */
+  REAL8 *raw;				/* unfiltered samples */
+  size_t rawCapacity;			/* allocated length of 'raw' */
+  INT8 filtFirst, filtEnd;		/* range of filtered samples in 'filt' */
+  REAL8 *filt;				/* filtered samples */
+  size_t filtCapacity;			/* allocated length of 'filt' */
+  INT8 nextSFT;				/* index of the first sample of the next SFT */
+};
+
+/* ---------- internal prototypes ---------- */
+static int SFTStreamInit ( SFTStream *stream, REAL8 deltaT );
+static int SFTStreamReserve ( REAL8 **buffer, size_t *capacity, size_t length );
+static SFTVector *SFTStreamProcess ( SFTStream *stream, BOOLEAN endOfSegment );
+
+/*==================== FUNCTION DEFINITIONS ====================*/
+
+/**
+ * Create an #SFTStream with the given parameters.
+ */
+SFTStream *
+XLALCreateSFTStream ( const SFTStreamParams *params )
+{
+  XLAL_CHECK_NULL ( params != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( params->Tsft > 0, XLAL_EDOM, "Invalid Tsft=%g, must be > 0\n", params->Tsft );
+  XLAL_CHECK_NULL ( params->overlapFraction >= 0 && params->overlapFraction < 1, XLAL_EDOM, "Invalid overlapFraction=%g, must be in [0, 1)\n", params->overlapFraction );
+  XLAL_CHECK_NULL ( params->fMin >= 0, XLAL_EDOM, "Invalid fMin=%g, must be >= 0\n", params->fMin );
+  XLAL_CHECK_NULL ( params->Band >= 0, XLAL_EDOM, "Invalid Band=%g, must be >= 0\n", params->Band );
+  XLAL_CHECK_NULL ( params->settleTime >= 0, XLAL_EDOM, "Invalid settleTime=%g, must be >= 0\n", params->settleTime );
+
+  SFTStream *stream = XLALCalloc ( 1, sizeof(*stream) );
+  XLAL_CHECK_NULL ( stream != NULL, XLAL_ENOMEM );
+  stream->params = (*params);
+  stream->params.windowType = NULL;
+  if ( params->windowType != NULL ) {
+    if ( ( stream->params.windowType = XLALStringDuplicate ( params->windowType ) ) == NULL ) {
+      XLALDestroySFTStream ( stream );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
+  }
+
+  return stream;
+
+} // XLALCreateSFTStream()
+
+/**
+ * Destroy an #SFTStream. Data of any unfinished segment are discarded.
+ */
+void
+XLALDestroySFTStream ( SFTStream *stream )
+{
+  if ( stream == NULL ) {
+    return;
+  }
+  XLALFree ( (CHAR *) stream->params.windowType );
+  XLALDestroyREAL8Window ( stream->window );
+  XLALDestroyREAL8FFTPlan ( stream->plan );
+  XLALFree ( stream->raw );
+  XLALFree ( stream->filt );
+  XLALFree ( stream );
+}
+
+/**
+ * Append a stretch of time-series data to an #SFTStream, and return the SFTs completed by it;
+ * the returned vector may be empty. If the data do not follow on from previously-appended data,
+ * the current segment is ended first, and its final SFTs are also returned.
+ */
+SFTVector *
+XLALSFTStreamAppend ( SFTStream *stream,		///< [in] SFT stream
+                      const REAL8TimeSeries *series	///< [in] next stretch of time-series data
+                      )
+{
+  XLAL_CHECK_NULL ( stream != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( series != NULL && series->data != NULL && series->data->length > 0, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( series->f0 == 0, XLAL_EINVAL, "Heterodyned time series (f0=%g) are not supported\n", series->f0 );
+
+  // Set up stream on first call
+  if ( stream->deltaT == 0 ) {
+    XLAL_CHECK_NULL ( SFTStreamInit ( stream, series->deltaT ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLAL_CHECK_NULL ( fabs ( series->deltaT - stream->deltaT ) <= 1e-9 * stream->deltaT, XLAL_EINVAL, "Sampling time %g differs from previous %g\n", series->deltaT, stream->deltaT );
+
+  // End the current segment if the data do not follow on from it
+  SFTVector *sfts = NULL;
+  if ( stream->inSegment ) {
+    const REAL8 offset = XLALGPSDiff ( &series->epoch, &stream->segStart ) / stream->deltaT - stream->rawEnd;
+    if ( fabs ( offset ) > 1e-3 ) {
+      XLAL_CHECK_NULL ( ( sfts = SFTStreamProcess ( stream, 1 ) ) != NULL, XLAL_EFUNC );
+    }
+  }
+
+  // Start a new segment if needed
+  if ( !stream->inSegment ) {
+    stream->inSegment = 1;
+    stream->segStart = series->epoch;
+    stream->rawFirst = stream->rawEnd = 0;
+    stream->filtFirst = stream->filtEnd = 0;
+    stream->nextSFT = 0;
+  }
+  strncpy ( stream->name, series->name, sizeof(stream->name) - 1 );
+
+  // Append data to unfiltered samples
+  const size_t rawLength = stream->rawEnd - stream->rawFirst;
+  if ( SFTStreamReserve ( &stream->raw, &stream->rawCapacity, rawLength + series->data->length ) != XLAL_SUCCESS ) {
+    XLALDestroySFTVector ( sfts );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+  memcpy ( stream->raw + rawLength, series->data->data, series->data->length * sizeof(stream->raw[0]) );
+  stream->rawEnd += series->data->length;
+
+  // Make any SFTs completed by the new data
+  SFTVector *newsfts = SFTStreamProcess ( stream, 0 );
+  if ( newsfts == NULL ) {
+    XLALDestroySFTVector ( sfts );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+  if ( sfts == NULL ) {
+    return newsfts;
+  }
+  for ( UINT4 i = 0; i < newsfts->length; ++i ) {
+    if ( XLALAppendSFT2Vector ( sfts, &newsfts->data[i] ) != XLAL_SUCCESS ) {
+      XLALDestroySFTVector ( sfts );
+      XLALDestroySFTVector ( newsfts );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
+  }
+  XLALDestroySFTVector ( newsfts );
+
+  return sfts;
+
+} // XLALSFTStreamAppend()
+
+/**
+ * End the current segment of an #SFTStream, and return its remaining SFTs; the returned vector
+ * may be empty. Data at the end of the segment which do not fill an SFT are discarded.
+ */
+SFTVector *
+XLALSFTStreamEndSegment ( SFTStream *stream )
+{
+  XLAL_CHECK_NULL ( stream != NULL, XLAL_EFAULT );
+
+  if ( !stream->inSegment ) {
+    SFTVector *sfts = XLALCalloc ( 1, sizeof(*sfts) );
+    XLAL_CHECK_NULL ( sfts != NULL, XLAL_ENOMEM );
+    return sfts;
+  }
+
+  SFTVector *sfts = SFTStreamProcess ( stream, 1 );
+  XLAL_CHECK_NULL ( sfts != NULL, XLAL_EFUNC );
+
+  return sfts;
+
+} // XLALSFTStreamEndSegment()
+
+/// Set up an #SFTStream for time-series data with a given sampling time
+static int
+SFTStreamInit ( SFTStream *stream, REAL8 deltaT )
+{
+  XLAL_CHECK ( deltaT > 0, XLAL_EINVAL, "Invalid sampling time %g\n", deltaT );
+  const SFTStreamParams *params = &stream->params;
+
+  // Number of samples in an SFT must be an integer
+  const REAL8 numTimesteps0 = params->Tsft / deltaT;
+  stream->numTimesteps = llround ( numTimesteps0 );
+  XLAL_CHECK ( stream->numTimesteps > 0 && fabs ( numTimesteps0 - stream->numTimesteps ) < 1e-6, XLAL_EINVAL, "Tsft=%g is not an integer multiple of sampling time %g\n", params->Tsft, deltaT );
+  stream->stepTimesteps = llround ( ( 1.0 - params->overlapFraction ) * numTimesteps0 );
+  XLAL_CHECK ( stream->stepTimesteps > 0, XLAL_EDOM, "overlapFraction=%g is too close to 1\n", params->overlapFraction );
+  stream->settleTimesteps = ( params->highPass.f2 > 0 ) ? llround ( params->settleTime / deltaT ) : 0;
+
+  // Frequency bins to store in the SFTs
+  XLAL_CHECK ( XLALFindCoveringSFTBins ( &stream->firstBin, &stream->numBins, params->fMin, params->Band, params->Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( stream->firstBin + stream->numBins <= stream->numTimesteps / 2 + 1, XLAL_EDOM, "Requested band [%g, %g) Hz is above the Nyquist frequency %g Hz\n", params->fMin, params->fMin + params->Band, 0.5 / deltaT );
+
+  // Create window; the SFT normalisation follows the SFTv2 specification, see XLALMakeSFTsFromREAL8TimeSeries()
+  REAL8 sigma_window = 1;
+  if ( params->windowType != NULL ) {
+    XLAL_CHECK ( ( stream->window = XLALCreateNamedREAL8Window ( params->windowType, params->windowBeta, stream->numTimesteps ) ) != NULL, XLAL_EFUNC );
+    sigma_window = sqrt ( stream->window->sumofsquares / stream->window->data->length );
+  }
+  stream->windowNorm = deltaT / sigma_window;
+
+  // Create FFT plan; it is used for many SFTs, so it is worth measuring
+  XLAL_CHECK ( ( stream->plan = XLALCreateForwardREAL8FFTPlan ( stream->numTimesteps, 1 ) ) != NULL, XLAL_EFUNC );
+
+  stream->deltaT = deltaT;
+
+  return XLAL_SUCCESS;
+
+} // SFTStreamInit()
+
+/// Ensure that a buffer can hold a given number of samples
+static int
+SFTStreamReserve ( REAL8 **buffer, size_t *capacity, size_t length )
+{
+  if ( length > *capacity ) {
+    const size_t newCapacity = MYMAX ( length, 2 * (*capacity) );
+    REAL8 *newBuffer = XLALRealloc ( *buffer, newCapacity * sizeof(**buffer) );
+    XLAL_CHECK ( newBuffer != NULL, XLAL_ENOMEM );
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+  }
+  return XLAL_SUCCESS;
+}
+
+/// Filter any newly-settled data, and make all SFTs which are complete
+static SFTVector *
+SFTStreamProcess ( SFTStream *stream, BOOLEAN endOfSegment )
+{
+  const INT8 M = stream->settleTimesteps;
+  const INT8 N = stream->numTimesteps;
+
+  // Filter unfiltered data which are at least 'M' samples from the end of the data,
+  // or all unfiltered data at the end of the segment
+  const INT8 newEnd = endOfSegment ? stream->rawEnd : stream->rawEnd - M;
+  if ( newEnd > stream->filtEnd ) {
+    const INT8 blockFirst = MYMAX ( stream->rawFirst, stream->filtEnd - M );
+    const INT8 blockLength = stream->rawEnd - blockFirst;
+    const INT8 filtLength = stream->filtEnd - stream->filtFirst;
+    XLAL_CHECK_NULL ( SFTStreamReserve ( &stream->filt, &stream->filtCapacity, filtLength + ( newEnd - stream->filtEnd ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( M > 0 ) {
+      REAL8TimeSeries *block = XLALCreateREAL8TimeSeries ( "", &stream->segStart, 0, stream->deltaT, &lalDimensionlessUnit, blockLength );
+      XLAL_CHECK_NULL ( block != NULL, XLAL_EFUNC );
+      memcpy ( block->data->data, stream->raw + ( blockFirst - stream->rawFirst ), blockLength * sizeof(block->data->data[0]) );
+      if ( XLALButterworthREAL8TimeSeries ( block, &stream->params.highPass ) != XLAL_SUCCESS ) {
+        XLALDestroyREAL8TimeSeries ( block );
+        XLAL_ERROR_NULL ( XLAL_EFUNC );
+      }
+      memcpy ( stream->filt + filtLength, block->data->data + ( stream->filtEnd - blockFirst ), ( newEnd - stream->filtEnd ) * sizeof(stream->filt[0]) );
+      XLALDestroyREAL8TimeSeries ( block );
+    } else {
+      memcpy ( stream->filt + filtLength, stream->raw + ( stream->filtEnd - stream->rawFirst ), ( newEnd - stream->filtEnd ) * sizeof(stream->filt[0]) );
+    }
+    stream->filtEnd = newEnd;
+  }
+
+  // Discard unfiltered data no longer needed as filter padding
+  {
+    const INT8 keepFirst = MYMAX ( stream->rawFirst, stream->filtEnd - M );
+    memmove ( stream->raw, stream->raw + ( keepFirst - stream->rawFirst ), ( stream->rawEnd - keepFirst ) * sizeof(stream->raw[0]) );
+    stream->rawFirst = keepFirst;
+  }
+
+  // Count SFTs which are complete
+  UINT4 numSFTs = 0;
+  while ( stream->nextSFT + numSFTs * stream->stepTimesteps + N <= stream->filtEnd ) {
+    ++numSFTs;
+  }
+
+  // Create output SFT vector
+  SFTVector *sfts = NULL;
+  if ( numSFTs > 0 ) {
+    XLAL_CHECK_NULL ( ( sfts = XLALCreateSFTVector ( numSFTs, stream->numBins ) ) != NULL, XLAL_EFUNC );
+  } else {
+    XLAL_CHECK_NULL ( ( sfts = XLALCalloc ( 1, sizeof(*sfts) ) ) != NULL, XLAL_ENOMEM );
+  }
+
+  // Compute SFTs, sharing the FFT plan between threads
+  int nerrors = 0;
+#pragma omp parallel reduction(+:nerrors)
+  {
+    REAL8Vector *timeStretch = XLALCreateREAL8Vector ( N );
+    COMPLEX16Vector *fftOut = XLALCreateCOMPLEX16Vector ( N / 2 + 1 );
+    if ( timeStretch == NULL || fftOut == NULL ) {
+      ++nerrors;
+    }
+#pragma omp for schedule(static)
+    for ( UINT4 i = 0; i < numSFTs; ++i ) {
+      if ( timeStretch == NULL || fftOut == NULL ) {
+        continue;
+      }
+      SFTtype *sft = &sfts->data[i];
+      const INT8 start = stream->nextSFT + i * stream->stepTimesteps;
+
+      // Copy and window data for this SFT
+      const REAL8 *data = stream->filt + ( start - stream->filtFirst );
+      if ( stream->window != NULL ) {
+        const REAL8 *win = stream->window->data->data;
+        for ( INT8 k = 0; k < N; ++k ) {
+          timeStretch->data[k] = win[k] * data[k];
+        }
+      } else {
+        memcpy ( timeStretch->data, data, N * sizeof(timeStretch->data[0]) );
+      }
+
+      // FFT this time stretch
+      if ( XLALREAL8ForwardFFT ( fftOut, timeStretch, stream->plan ) != XLAL_SUCCESS ) {
+        ++nerrors;
+        continue;
+      }
+
+      // Fill SFT header and normalised data
+      strncpy ( sft->name, stream->name, sizeof(sft->name) - 1 );
+      sft->epoch = stream->segStart;
+      XLALGPSAdd ( &sft->epoch, start * stream->deltaT );
+      sft->f0 = stream->firstBin / stream->params.Tsft;
+      sft->deltaF = 1.0 / stream->params.Tsft;
+      for ( UINT4 k = 0; k < stream->numBins; ++k ) {
+        sft->data->data[k] = (COMPLEX8) ( stream->windowNorm * fftOut->data[stream->firstBin + k] );
+      }
+
+    }
+    XLALDestroyREAL8Vector ( timeStretch );
+    XLALDestroyCOMPLEX16Vector ( fftOut );
+  }
+  if ( nerrors > 0 ) {
+    XLALDestroySFTVector ( sfts );
+    XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to compute %i SFTs\n", nerrors );
+  }
+  stream->nextSFT += numSFTs * stream->stepTimesteps;
+
+  // Discard filtered data before the next SFT
+  {
+    const INT8 keepFirst = MYMAX ( stream->filtFirst, ( stream->nextSFT < stream->filtEnd ) ? stream->nextSFT : stream->filtEnd );
+    memmove ( stream->filt, stream->filt + ( keepFirst - stream->filtFirst ), ( stream->filtEnd - keepFirst ) * sizeof(stream->filt[0]) );
+    stream->filtFirst = keepFirst;
+  }
+
+  // Reset the segment at its end
+  if ( endOfSegment ) {
+    stream->inSegment = 0;
+  }
+
+  return sfts;
+
+} // SFTStreamProcess()
@@ -0,0 +1,76 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \defgroup SFTStream_h Header SFTStream.h
+ * \ingroup lalpulsar_sft
+ * \brief Make SFTs from a stream of contiguous time-series data.
+ *
+ * An #SFTStream is fed successive stretches of a time series, e.g. as they are read from frame
+ * files, and returns the SFTs which have become complete. Stretches which follow on from each
+ * other without a gap form a segment: within a segment, the data are high-pass filtered as a
+ * whole rather than SFT by SFT, and SFTs start at the beginning of the segment and then every
+ * <tt>(1 - overlapFraction) * Tsft</tt> seconds. A gap in the data, or a call to
+ * XLALSFTStreamEndSegment(), ends the current segment.
+ *
+ * The high-pass filter is the zero-phase Butterworth filter of XLALButterworthREAL8TimeSeries().
+ * Since this filter runs both forwards and backwards in time, the data are filtered in blocks
+ * which are padded by \c settleTime seconds of neighbouring data on either side, which is then
+ * discarded; \c settleTime should be long enough for the filter response to decay.
+ *
+ * The SFTs are computed in parallel, if OpenMP is enabled, using a single FFT plan.
+ */
+/** @{ */
+
+#ifndef _SFTSTREAM_H
+#define _SFTSTREAM_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#include <lal/LALDatatypes.h>
+#include <lal/BandPassTimeSeries.h>
+#include <lal/SFTutils.h>
+
+/** Parameters of an #SFTStream */
+typedef struct tagSFTStreamParams {
+  REAL8 Tsft;				/**< SFT time baseline, in seconds */
+  REAL8 overlapFraction;		/**< Fraction of \c Tsft by which consecutive SFTs overlap, in [0, 1) */
+  REAL8 fMin;				/**< Lowest frequency to store in the SFTs */
+  REAL8 Band;				/**< Frequency band to store in the SFTs */
+  const CHAR *windowType;		/**< Window applied before each FFT, see XLALCreateNamedREAL8Window(); NULL for no window */
+  REAL8 windowBeta;			/**< Window parameter, if any */
+  PassBandParamStruc highPass;		/**< High-pass filter parameters, see XLALButterworthREAL8TimeSeries(); <tt>highPass.f2 <= 0</tt> for no filter */
+  REAL8 settleTime;			/**< Time in seconds either side of each filtered block for the high-pass filter to settle */
+} SFTStreamParams;
+
+/** Opaque state of a stream of time-series data being made into SFTs */
+typedef struct tagSFTStream SFTStream;
+
+SFTStream *XLALCreateSFTStream ( const SFTStreamParams *params );
+void XLALDestroySFTStream ( SFTStream *stream );
+SFTVector *XLALSFTStreamAppend ( SFTStream *stream, const REAL8TimeSeries *series );
+SFTVector *XLALSFTStreamEndSegment ( SFTStream *stream );
+
+/** @} */
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* _SFTSTREAM_H */
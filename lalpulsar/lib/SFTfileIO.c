@@ -58,6 +58,11 @@
 #include <lal/UserInputParse.h>
 #include <lal/LogPrintf.h>
 #include <lal/SFTutils.h>
+#include <lal/NormalizeSFTRngMed.h>
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
 
 /*---------- DEFINES ----------*/
 
@@ -75,6 +80,12 @@
 #define SFTFILEIO_REALLOC_BLOCKSIZE 100
 #endif
 
+/* ----- SFT noise file format ---------- */
+#define SFT_NOISE_MAGIC         "LALSFTNZ"	/* first 8 bytes of an SFT noise file */
+#define SFT_NOISE_VERSION       1		/* current version of the SFT noise file format */
+#define SFT_NOISE_BYTEORDER     0x01020304	/* used to detect files written with a different byte order */
+#define SFT_NOISE_SUFFIX        ".noise"	/* appended to the SFT file name to give the SFT noise file name */
+
 /*----- Macros ----- */
 
 #define GPS2REAL8(gps) (1.0 * (gps).gpsSeconds + 1.e-9 * (gps).gpsNanoSeconds )
@@ -117,6 +128,39 @@ typedef struct {
   struct tagSFTLocator *lastfrom;  /**< last bin read from this locator */
 } SFTReadSegment;
 
+/** header of an SFT noise file */
+typedef struct {
+  CHAR magic[8];		/**< #SFT_NOISE_MAGIC, without terminating NUL */
+  UINT4 byteOrder;		/**< #SFT_NOISE_BYTEORDER */
+  UINT4 version;		/**< #SFT_NOISE_VERSION */
+  UINT4 blockSize;		/**< running median window used to compute the running medians */
+  UINT4 numSFTs;		/**< number of SFT records which follow */
+  REAL8 lineThreshold;		/**< bins with normalised power above this threshold are flagged as lines */
+} SFTNoiseFileHeader;
+
+/** header of each SFT record in an SFT noise file; followed by 'numBins' REAL8 running medians,
+ * then 'numBins' UCHAR line flags, padded to a multiple of 8 bytes */
+typedef struct {
+  CHAR detector[2];		/**< detector prefix of the SFT */
+  CHAR padding[2];
+  INT4 gpsSeconds;		/**< timestamp of the SFT */
+  INT4 gpsNanoSeconds;
+  UINT4 firstBin;		/**< index of the first frequency bin of the SFT */
+  UINT4 numBins;		/**< number of frequency bins of the SFT */
+  UINT4 padding2;
+  REAL8 deltaF;			/**< frequency spacing of the SFT */
+} SFTNoiseRecordHeader;
+
+/** an SFT noise file opened for reading */
+typedef struct {
+  CHAR *sftFile;		/**< name of the SFT file this noise file belongs to */
+  FILE *fp;			/**< open noise file */
+  SFTNoiseFileHeader header;	/**< header of the noise file */
+  SFTNoiseRecordHeader *records;	/**< headers of the SFT records */
+  long *offsets;		/**< file offsets of the running medians of each SFT record */
+  UINT4 next;			/**< record following the last record found, where the next search starts */
+} SFTNoiseFile;
+
 /*---------- Global variables ----------*/
 static REAL8 fudge_up   = 1 + 10 * LAL_REAL8_EPS;	// about ~1 + 2e-15
 static REAL8 fudge_down = 1 - 10 * LAL_REAL8_EPS;	// about ~1 - 2e-15
@@ -137,6 +181,9 @@ static UINT4 read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 fi
 static int read_sft_header_from_fp (FILE *fp, SFTtype  *header, UINT4 *version, UINT8 *crc64, BOOLEAN *swapEndian, CHAR **SFTcomment, UINT4 *numBins );
 static int read_v2_header_from_fp ( FILE *fp, SFTtype *header, UINT4 *nsamples, UINT8 *header_crc64, UINT8 *ref_crc64, CHAR **SFTcomment, BOOLEAN swapEndian);
 
+static int open_SFTNoiseFile ( SFTNoiseFile *nf, const CHAR *sftFile );
+static void close_SFTNoiseFile ( SFTNoiseFile *nf );
+
 int compareSFTdesc(const void *ptr1, const void *ptr2);
 static int compareSFTloc(const void *ptr1, const void *ptr2);
 static int compareDetNameCatalogs ( const void *ptr1, const void *ptr2 );
@@ -1044,6 +1091,299 @@ XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView,/**< The
 } // XLALLoadMultiSFTsFromView()
 
 
+/**
+ * Write an SFT noise file for all SFTs in a given SFT file: for each SFT, the running-median
+ * smoothed periodogram computed by XLALSFTtoRngmed() over the full frequency band of the SFT,
+ * and a flag for each frequency bin whose normalised power exceeds a given threshold, i.e. which
+ * is likely to contain a spectral line. The running medians are computed in parallel, if OpenMP
+ * is enabled.
+ *
+ * The noise file is named after the SFT file, with suffix \c .noise appended, and is read back
+ * by XLALLoadMultiSFTNoise(). It is stored in a binary format in the byte order of the machine
+ * which wrote it.
+ */
+int
+XLALWriteSFTNoiseFile ( const CHAR *sftFile,	/**< [in] SFT file to write noise file for */
+                        UINT4 blockSize,	/**< [in] running median window size */
+                        REAL8 lineThreshold	/**< [in] threshold on normalised power above which frequency bins are flagged as lines */
+                        )
+{
+  XLAL_CHECK ( sftFile != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( blockSize > 0, XLAL_EINVAL, "Running median window size must be > 0" );
+  XLAL_CHECK ( lineThreshold > 0, XLAL_EINVAL, "Line threshold must be > 0" );
+
+  SFTCatalog *catalog = NULL;
+  MultiSFTVector *multiSFTs = NULL;
+  const SFTtype **sfts = NULL;
+  REAL8FrequencySeries *rngmeds = NULL;
+  UCHAR **flags = NULL;
+  CHAR *noiseFile = NULL, *tmpFile = NULL;
+  FILE *fp = NULL;
+  UINT4 numSFTs = 0;
+  int retn = XLAL_FAILURE;
+
+  // Load all SFTs in the file over their full frequency band
+  catalog = XLALSFTdataFind ( sftFile, NULL );
+  XLAL_CHECK_FAIL ( catalog != NULL, XLAL_EFUNC );
+  XLAL_CHECK_FAIL ( catalog->length > 0, XLAL_EIO, "No SFTs found in '%s'", sftFile );
+  multiSFTs = XLALLoadMultiSFTs ( catalog, -1, -1 );
+  XLAL_CHECK_FAIL ( multiSFTs != NULL, XLAL_EFUNC );
+
+  // Make a flat list of all SFTs
+  for ( UINT4 X = 0; X < multiSFTs->length; ++X ) {
+    numSFTs += multiSFTs->data[X]->length;
+  }
+  sfts = XLALCalloc ( numSFTs, sizeof(*sfts) );
+  XLAL_CHECK_FAIL ( sfts != NULL, XLAL_ENOMEM );
+  for ( UINT4 X = 0, n = 0; X < multiSFTs->length; ++X ) {
+    for ( UINT4 j = 0; j < multiSFTs->data[X]->length; ++j, ++n ) {
+      sfts[n] = &multiSFTs->data[X]->data[j];
+    }
+  }
+
+  // Compute running medians and line flags of all SFTs
+  rngmeds = XLALCalloc ( numSFTs, sizeof(*rngmeds) );
+  flags = XLALCalloc ( numSFTs, sizeof(*flags) );
+  XLAL_CHECK_FAIL ( rngmeds != NULL && flags != NULL, XLAL_ENOMEM );
+  int nerrors = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:nerrors)
+  for ( UINT4 n = 0; n < numSFTs; ++n ) {
+    const SFTtype *sft = sfts[n];
+    const UINT4 numBins = sft->data->length;
+    REAL8FrequencySeries periodo;
+    periodo.data = XLALCreateREAL8Vector ( numBins );
+    rngmeds[n].data = XLALCreateREAL8Vector ( numBins );
+    flags[n] = XLALCalloc ( numBins, sizeof(*flags[n]) );
+    if ( periodo.data == NULL || rngmeds[n].data == NULL || flags[n] == NULL
+         || XLALSFTtoPeriodogram ( &periodo, sft ) != XLAL_SUCCESS
+         || XLALPeriodoToRngmed ( &rngmeds[n], &periodo, blockSize ) != XLAL_SUCCESS ) {
+      ++nerrors;
+    } else {
+      for ( UINT4 k = 0; k < numBins; ++k ) {
+        flags[n][k] = ( periodo.data->data[k] > lineThreshold * rngmeds[n].data->data[k] );
+      }
+    }
+    XLALDestroyREAL8Vector ( periodo.data );
+  }
+  XLAL_CHECK_FAIL ( nerrors == 0, XLAL_EFUNC, "Failed to compute running medians of %d SFTs in '%s'", nerrors, sftFile );
+
+  // Write noise file under a temporary name, then rename it, so that an incomplete noise file is never read
+  noiseFile = XLALStringAppend ( XLALStringDuplicate ( sftFile ), SFT_NOISE_SUFFIX );
+  tmpFile = XLALStringAppend ( XLALStringDuplicate ( noiseFile ), ".tmp" );
+  XLAL_CHECK_FAIL ( noiseFile != NULL && tmpFile != NULL, XLAL_EFUNC );
+  fp = fopen ( tmpFile, "wb" );
+  XLAL_CHECK_FAIL ( fp != NULL, XLAL_EIO, "Failed to open '%s' for writing: %s", tmpFile, strerror ( errno ) );
+
+  SFTNoiseFileHeader XLAL_INIT_DECL(header);
+  memcpy ( header.magic, SFT_NOISE_MAGIC, sizeof(header.magic) );
+  header.byteOrder = SFT_NOISE_BYTEORDER;
+  header.version = SFT_NOISE_VERSION;
+  header.blockSize = blockSize;
+  header.numSFTs = numSFTs;
+  header.lineThreshold = lineThreshold;
+  XLAL_CHECK_FAIL ( fwrite ( &header, sizeof(header), 1, fp ) == 1, XLAL_EIO, "Failed to write to '%s'", tmpFile );
+
+  const UCHAR padding[8] = { 0 };
+  for ( UINT4 n = 0; n < numSFTs; ++n ) {
+    const SFTtype *sft = sfts[n];
+    SFTNoiseRecordHeader XLAL_INIT_DECL(record);
+    memcpy ( record.detector, sft->name, sizeof(record.detector) );
+    record.gpsSeconds = sft->epoch.gpsSeconds;
+    record.gpsNanoSeconds = sft->epoch.gpsNanoSeconds;
+    record.firstBin = lround ( sft->f0 / sft->deltaF );
+    record.numBins = sft->data->length;
+    record.deltaF = sft->deltaF;
+    XLAL_CHECK_FAIL ( fwrite ( &record, sizeof(record), 1, fp ) == 1, XLAL_EIO, "Failed to write to '%s'", tmpFile );
+    XLAL_CHECK_FAIL ( fwrite ( rngmeds[n].data->data, sizeof(REAL8), record.numBins, fp ) == record.numBins, XLAL_EIO, "Failed to write to '%s'", tmpFile );
+    XLAL_CHECK_FAIL ( fwrite ( flags[n], sizeof(UCHAR), record.numBins, fp ) == record.numBins, XLAL_EIO, "Failed to write to '%s'", tmpFile );
+    const size_t numPadding = ( 8 - record.numBins % 8 ) % 8;
+    XLAL_CHECK_FAIL ( fwrite ( padding, sizeof(UCHAR), numPadding, fp ) == numPadding, XLAL_EIO, "Failed to write to '%s'", tmpFile );
+  }
+
+  const int fclose_retn = fclose ( fp );
+  fp = NULL;
+  XLAL_CHECK_FAIL ( fclose_retn == 0, XLAL_EIO, "Failed to close '%s': %s", tmpFile, strerror ( errno ) );
+  XLAL_CHECK_FAIL ( rename ( tmpFile, noiseFile ) == 0, XLAL_EIO, "Failed to rename '%s' to '%s': %s", tmpFile, noiseFile, strerror ( errno ) );
+  retn = XLAL_SUCCESS;
+
+XLAL_FAIL:
+
+  // Cleanup; on failure, also remove any partially-written noise file
+  if ( fp != NULL ) {
+    fclose ( fp );
+  }
+  if ( retn != XLAL_SUCCESS && tmpFile != NULL ) {
+    remove ( tmpFile );
+  }
+  for ( UINT4 n = 0; n < numSFTs; ++n ) {
+    if ( rngmeds != NULL ) {
+      XLALDestroyREAL8Vector ( rngmeds[n].data );
+    }
+    if ( flags != NULL ) {
+      XLALFree ( flags[n] );
+    }
+  }
+  XLALFree ( rngmeds );
+  XLALFree ( flags );
+  XLALFree ( sfts );
+  XLALFree ( noiseFile );
+  XLALFree ( tmpFile );
+  XLALDestroyMultiSFTVector ( multiSFTs );
+  XLALDestroySFTCatalog ( catalog );
+
+  return retn;
+
+} // XLALWriteSFTNoiseFile()
+
+
+/**
+ * Load the running-median smoothed periodograms of SFTs loaded from a catalog by XLALLoadMultiSFTs(),
+ * from the SFT noise files written by XLALWriteSFTNoiseFile() alongside the SFT files.
+ *
+ * Since the running medians were computed over the full frequency band of the SFT files, their values
+ * at the edges of the loaded frequency band are true running medians, whereas XLALNormalizeMultiSFTVect()
+ * has to extrapolate the running medians of the loaded SFTs over <tt>blockSize/2</tt> bins at either edge.
+ * Away from these edges, the loaded running medians are identical to those computed by
+ * XLALNormalizeMultiSFTVect(), and therefore so are noise weights computed by XLALComputeMultiNoiseWeights().
+ *
+ * If \a multiLineFlags is not NULL, it returns for each SFT frequency bin 1 if it was flagged as a line,
+ * and 0 otherwise.
+ */
+MultiPSDVector *
+XLALLoadMultiSFTNoise ( const SFTCatalog *catalog,		/**< [in] catalog the SFTs were loaded from */
+                        const MultiSFTVector *multiSFTs,	/**< [in] SFTs loaded by XLALLoadMultiSFTs() */
+                        UINT4 blockSize,			/**< [in] running median window size; must match that of the noise files */
+                        MultiPSDVector **multiLineFlags		/**< [out] optional: line flags of the SFT frequency bins */
+                        )
+{
+  XLAL_CHECK_NULL ( catalog != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( multiSFTs != NULL && multiSFTs->length > 0, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( multiLineFlags == NULL || *multiLineFlags == NULL, XLAL_EINVAL );
+
+  MultiSFTCatalogView *multiCatalogView = NULL;
+  MultiPSDVector *multiPSD = NULL, *multiFlags = NULL;
+  SFTNoiseFile XLAL_INIT_DECL(nf);
+  UCHAR *buf = NULL;
+
+  // Create a multi-view of SFT catalog, whose detectors are in the same order as the loaded SFTs
+  multiCatalogView = XLALGetMultiSFTCatalogView ( catalog );
+  XLAL_CHECK_FAIL ( multiCatalogView != NULL, XLAL_EFUNC );
+  XLAL_CHECK_FAIL ( multiCatalogView->length == multiSFTs->length, XLAL_EINVAL, "Number of IFOs in catalog (%d) differs from number of IFOs in SFTs (%d)", multiCatalogView->length, multiSFTs->length );
+
+  // Allocate running medians and line flags
+  const UINT4 numIFOs = multiSFTs->length;
+  multiPSD = XLALCalloc ( 1, sizeof(*multiPSD) );
+  XLAL_CHECK_FAIL ( multiPSD != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( ( multiPSD->data = XLALCalloc ( numIFOs, sizeof(*multiPSD->data) ) ) != NULL, XLAL_ENOMEM );
+  multiPSD->length = numIFOs;
+  if ( multiLineFlags != NULL ) {
+    XLAL_CHECK_FAIL ( ( multiFlags = XLALCalloc ( 1, sizeof(*multiFlags) ) ) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_FAIL ( ( multiFlags->data = XLALCalloc ( numIFOs, sizeof(*multiFlags->data) ) ) != NULL, XLAL_ENOMEM );
+    multiFlags->length = numIFOs;
+  }
+
+  for ( UINT4 X = 0; X < numIFOs; ++X ) {
+    const SFTCatalog *catalogX = &multiCatalogView->data[X];
+    const SFTVector *sftsX = multiSFTs->data[X];
+    const UINT4 numSFTs = sftsX->length;
+
+    XLAL_CHECK_FAIL ( ( multiPSD->data[X] = XLALCalloc ( 1, sizeof(*multiPSD->data[X]) ) ) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK_FAIL ( ( multiPSD->data[X]->data = XLALCalloc ( numSFTs, sizeof(*multiPSD->data[X]->data) ) ) != NULL, XLAL_ENOMEM );
+    multiPSD->data[X]->length = numSFTs;
+    if ( multiFlags != NULL ) {
+      XLAL_CHECK_FAIL ( ( multiFlags->data[X] = XLALCalloc ( 1, sizeof(*multiFlags->data[X]) ) ) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( ( multiFlags->data[X]->data = XLALCalloc ( numSFTs, sizeof(*multiFlags->data[X]->data) ) ) != NULL, XLAL_ENOMEM );
+      multiFlags->data[X]->length = numSFTs;
+    }
+
+    for ( UINT4 j = 0, i = 0; j < numSFTs; ++j ) {
+      const SFTtype *sft = &sftsX->data[j];
+      const UINT4 firstBin = lround ( sft->f0 / sft->deltaF );
+      const UINT4 numBins = sft->data->length;
+
+      // Find the catalog entry of this SFT which covers its frequency band; SFTs and catalog are both sorted by time
+      const SFTDescriptor *desc = NULL;
+      for ( ; i < catalogX->length && desc == NULL; ++i ) {
+        const SFTDescriptor *d = &catalogX->data[i];
+        const UINT4 descFirstBin = lround ( d->header.f0 / d->header.deltaF );
+        if ( GPSEQUAL ( d->header.epoch, sft->epoch ) && descFirstBin <= firstBin && firstBin + numBins <= descFirstBin + d->numBins ) {
+          desc = d;
+        }
+      }
+      XLAL_CHECK_FAIL ( desc != NULL, XLAL_EINVAL, "No single SFT file in catalog covers the frequency band of %s SFT at GPS %d", sft->name, sft->epoch.gpsSeconds );
+      --i;
+
+      // Open the noise file of the SFT file, if not already open
+      if ( nf.sftFile == NULL || strcmp ( nf.sftFile, desc->locator->fname ) != 0 ) {
+        close_SFTNoiseFile ( &nf );
+        XLAL_CHECK_FAIL ( open_SFTNoiseFile ( &nf, desc->locator->fname ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_FAIL ( nf.header.blockSize == blockSize, XLAL_EINVAL, "SFT noise file for '%s' has running median window size %u, not %u", nf.sftFile, nf.header.blockSize, blockSize );
+      }
+
+      // Find the record of this SFT in the noise file, starting from where the previous search ended
+      const SFTNoiseRecordHeader *record = NULL;
+      long offset = 0;
+      for ( UINT4 n = 0; n < nf.header.numSFTs && record == NULL; ++n ) {
+        const UINT4 r = ( nf.next + n ) % nf.header.numSFTs;
+        if ( strncmp ( nf.records[r].detector, sft->name, sizeof(nf.records[r].detector) ) == 0 && nf.records[r].gpsSeconds == sft->epoch.gpsSeconds && nf.records[r].gpsNanoSeconds == sft->epoch.gpsNanoSeconds ) {
+          record = &nf.records[r];
+          offset = nf.offsets[r];
+          nf.next = r + 1;
+        }
+      }
+      XLAL_CHECK_FAIL ( record != NULL, XLAL_EIO, "SFT noise file for '%s' has no record for %s SFT at GPS %d", nf.sftFile, sft->name, sft->epoch.gpsSeconds );
+      XLAL_CHECK_FAIL ( record->deltaF == sft->deltaF && record->firstBin <= firstBin && firstBin + numBins <= record->firstBin + record->numBins, XLAL_EIO,
+                        "SFT noise file for '%s' does not cover the frequency band of %s SFT at GPS %d", nf.sftFile, sft->name, sft->epoch.gpsSeconds );
+      const UINT4 k0 = firstBin - record->firstBin;
+
+      // Read running medians
+      REAL8FrequencySeries *rngmed = &multiPSD->data[X]->data[j];
+      strncpy ( rngmed->name, sft->name, sizeof(rngmed->name) - 1 );
+      rngmed->epoch = sft->epoch;
+      rngmed->f0 = sft->f0;
+      rngmed->deltaF = sft->deltaF;
+      XLAL_CHECK_FAIL ( ( rngmed->data = XLALCreateREAL8Vector ( numBins ) ) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_FAIL ( fseek ( nf.fp, offset + k0 * sizeof(REAL8), SEEK_SET ) == 0 && fread ( rngmed->data->data, sizeof(REAL8), numBins, nf.fp ) == numBins, XLAL_EIO,
+                        "Failed to read running medians from SFT noise file for '%s'", nf.sftFile );
+
+      // Read line flags
+      if ( multiFlags != NULL ) {
+        REAL8FrequencySeries *lineFlags = &multiFlags->data[X]->data[j];
+        *lineFlags = *rngmed;
+        XLAL_CHECK_FAIL ( ( lineFlags->data = XLALCreateREAL8Vector ( numBins ) ) != NULL, XLAL_EFUNC );
+        XLAL_CHECK_FAIL ( ( buf = XLALRealloc ( buf, numBins * sizeof(*buf) ) ) != NULL, XLAL_ENOMEM );
+        XLAL_CHECK_FAIL ( fseek ( nf.fp, offset + record->numBins * sizeof(REAL8) + k0, SEEK_SET ) == 0 && fread ( buf, sizeof(*buf), numBins, nf.fp ) == numBins, XLAL_EIO,
+                          "Failed to read line flags from SFT noise file for '%s'", nf.sftFile );
+        for ( UINT4 k = 0; k < numBins; ++k ) {
+          lineFlags->data->data[k] = buf[k] ? 1 : 0;
+        }
+      }
+
+    } // for j < numSFTs
+
+  } // for X < numIFOs
+
+  // Cleanup
+  close_SFTNoiseFile ( &nf );
+  XLALFree ( buf );
+  XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+
+  if ( multiLineFlags != NULL ) {
+    *multiLineFlags = multiFlags;
+  }
+  return multiPSD;
+
+XLAL_FAIL:
+  close_SFTNoiseFile ( &nf );
+  XLALFree ( buf );
+  XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+  XLALDestroyMultiPSDVector ( multiPSD );
+  XLALDestroyMultiPSDVector ( multiFlags );
+  return NULL;
+
+} // XLALLoadMultiSFTNoise()
+
+
 /// backwards compatible wrapper to XLALReadTimestampsFileConstrained() without GPS-time constraints
 LIGOTimeGPSVector *
 XLALReadTimestampsFile ( const CHAR *fname )
@@ -1984,6 +2324,62 @@ fopen_SFTLocator ( const struct tagSFTLocator *locator )
 } /* fopen_SFTLocator() */
 
 
+/* open the noise file of an SFT file, and read the headers of all its SFT records */
+static int
+open_SFTNoiseFile ( SFTNoiseFile *nf, const CHAR *sftFile )
+{
+  XLAL_CHECK ( nf != NULL && nf->fp == NULL, XLAL_EINVAL );
+
+  XLAL_CHECK ( ( nf->sftFile = XLALStringDuplicate ( sftFile ) ) != NULL, XLAL_EFUNC );
+  CHAR *noiseFile = XLALStringAppend ( XLALStringDuplicate ( sftFile ), SFT_NOISE_SUFFIX );
+  XLAL_CHECK_FAIL ( noiseFile != NULL, XLAL_EFUNC );
+  nf->fp = fopen ( noiseFile, "rb" );
+  XLAL_CHECK_FAIL ( nf->fp != NULL, XLAL_EIO, "Failed to open SFT noise file '%s' for reading: %s", noiseFile, strerror ( errno ) );
+  XLALFree ( noiseFile );
+  noiseFile = NULL;
+
+  SFTNoiseFileHeader *header = &nf->header;
+  XLAL_CHECK_FAIL ( fread ( header, sizeof(*header), 1, nf->fp ) == 1, XLAL_EIO, "Failed to read header of SFT noise file for '%s'", sftFile );
+  XLAL_CHECK_FAIL ( memcmp ( header->magic, SFT_NOISE_MAGIC, sizeof(header->magic) ) == 0, XLAL_EIO, "SFT noise file for '%s' is not an SFT noise file", sftFile );
+  XLAL_CHECK_FAIL ( header->byteOrder == SFT_NOISE_BYTEORDER, XLAL_EIO, "SFT noise file for '%s' was written with a different byte order", sftFile );
+  XLAL_CHECK_FAIL ( header->version == SFT_NOISE_VERSION, XLAL_EIO, "SFT noise file for '%s' has unsupported version %u (expected %u)", sftFile, header->version, SFT_NOISE_VERSION );
+  XLAL_CHECK_FAIL ( header->numSFTs > 0, XLAL_EIO, "SFT noise file for '%s' contains no SFTs", sftFile );
+
+  XLAL_CHECK_FAIL ( ( nf->records = XLALCalloc ( header->numSFTs, sizeof(*nf->records) ) ) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( ( nf->offsets = XLALCalloc ( header->numSFTs, sizeof(*nf->offsets) ) ) != NULL, XLAL_ENOMEM );
+  for ( UINT4 r = 0; r < header->numSFTs; ++r ) {
+    XLAL_CHECK_FAIL ( fread ( &nf->records[r], sizeof(nf->records[r]), 1, nf->fp ) == 1, XLAL_EIO, "Failed to read SFT record %u of SFT noise file for '%s'", r, sftFile );
+    XLAL_CHECK_FAIL ( ( nf->offsets[r] = ftell ( nf->fp ) ) >= 0, XLAL_EIO, "Failed to read SFT noise file for '%s': %s", sftFile, strerror ( errno ) );
+    const UINT4 numBins = nf->records[r].numBins;
+    const long recordLength = numBins * sizeof(REAL8) + numBins + ( 8 - numBins % 8 ) % 8;
+    XLAL_CHECK_FAIL ( fseek ( nf->fp, recordLength, SEEK_CUR ) == 0, XLAL_EIO, "Failed to read SFT noise file for '%s': %s", sftFile, strerror ( errno ) );
+  }
+  nf->next = 0;
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  XLALFree ( noiseFile );
+  close_SFTNoiseFile ( nf );
+  return XLAL_FAILURE;
+
+} /* open_SFTNoiseFile() */
+
+
+/* close an SFT noise file opened by open_SFTNoiseFile() */
+static void
+close_SFTNoiseFile ( SFTNoiseFile *nf )
+{
+  if ( nf->fp != NULL ) {
+    fclose ( nf->fp );
+  }
+  XLALFree ( nf->sftFile );
+  XLALFree ( nf->records );
+  XLALFree ( nf->offsets );
+  memset ( nf, 0, sizeof(*nf) );
+} /* close_SFTNoiseFile() */
+
+
 /***********************************************************************
  * internal helper functions
  ***********************************************************************/
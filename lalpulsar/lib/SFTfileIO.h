@@ -49,6 +49,8 @@ extern "C" {
  * - SFT-reading: XLALSFTdataFind(), XLALLoadSFTs(), XLALLoadMultiSFTs()
  * - SFT-writing: XLALWriteSFT2file(), XLALWriteSFTVector2File(), XLALWriteSFTVector2Dir()
  * - SFT-checking: XLALCheckCRCSFTCatalog(): complete check of SFT-validity including CRC64 checksum
+ * - SFT noise files: XLALWriteSFTNoiseFile() precomputes running medians and line flags of the SFTs in a file,
+ * which XLALLoadMultiSFTNoise() reads back to save recomputing them whenever the SFTs are loaded
  * - free SFT-catalog: XLALDestroySFTCatalog()
  * - general manipulation of SFTVectors:
  * - XLALDestroySFTVector(): free up a complete SFT-vector
@@ -306,6 +308,10 @@ SFTVector* XLALLoadSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector* XLALLoadMultiSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector *XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax );
 
+int XLALWriteSFTNoiseFile ( const CHAR *sftFile, UINT4 blockSize, REAL8 lineThreshold );
+/* MultiPSDVector is defined in SFTutils.h, which includes this header */
+struct tagMultiPSDVector *XLALLoadMultiSFTNoise ( const SFTCatalog *catalog, const MultiSFTVector *multiSFTs, UINT4 blockSize, struct tagMultiPSDVector **multiLineFlags );
+
 int XLALCheckCRCSFTCatalog( BOOLEAN *crc_check, SFTCatalog *catalog );
 
 void XLALDestroySFTCatalog ( SFTCatalog *catalog );
@@ -53,6 +53,14 @@ struct E_solver_params {
   double A, B, x0;
 };
 
+/** Sky-independent SSB-timing quantities for a set of detector-state series */
+struct tagMultiSSBtimesBatch {
+  const MultiDetectorStateSeries *multiDetStates;	/**< detector-states at timestamps t_i (referenced, not copied) */
+  SSBprecision precision;				/**< precision of SSB transformation */
+  UINT4 numDetectors;					/**< number of detectors */
+  BarycenterBatch **baryBatch;				/**< sky-independent Barycentering quantities, for each detector */
+};
+
 /*==================== FUNCTION DEFINITIONS ====================*/
 
 /** Compute extra time-delays for a CW source in a (Keplerian) binary orbital system.
@@ -316,6 +324,10 @@ XLALAddBinaryTimes ( SSBtimes **tSSBOut,			//!< [out] reference-time offsets in
   REAL8 epsabs = maxPhaseErr / ( Freq * Porb);  // absolute root-finding accuracy required on E
   REAL8 epsrel = 0;				// no constraint on relative accuracy
 
+  // allocate the GSL root-finder once, it is re-initialised for each timestep
+  gsl_root_fsolver *s = gsl_root_fsolver_alloc ( gsl_root_fsolver_brent );
+  XLAL_CHECK ( s != NULL, XLAL_ENOMEM, "gsl_root_fsolver_alloc() failed\n" );
+
   /* loop over the SFTs i */
   for ( UINT4 i = 0; i < numSteps; i++ )
     {
@@ -327,15 +339,17 @@ XLALAddBinaryTimes ( SSBtimes **tSSBOut,			//!< [out] reference-time offsets in
       REAL8 x0 = fracOrb_i * LAL_TWOPI;
       REAL8 E_i;              // eccentric anomaly at emission of the wavefront arriving in SSB at tSSB
       { // ---------- use GSL for the root-finding
-        const gsl_root_fsolver_type *T = gsl_root_fsolver_brent;
-        gsl_root_fsolver *s = gsl_root_fsolver_alloc(T);
         REAL8 E_lo = 0, E_hi = LAL_TWOPI;	// gauge-choice mod (2pi)
         gsl_function F;
         struct E_solver_params pars = {A, B, x0};
         F.function = &gsl_E_solver;
         F.params = &pars;
 
-        XLAL_CHECK ( gsl_root_fsolver_set(s, &F, E_lo, E_hi) == 0, XLAL_EFAILED );
+        if ( gsl_root_fsolver_set(s, &F, E_lo, E_hi) != 0 )
+          {
+            gsl_root_fsolver_free(s);
+            XLAL_ERROR ( XLAL_EFAILED );
+          }
 
         int max_iter = 100;
         int iter = 0;
@@ -344,7 +358,11 @@ XLALAddBinaryTimes ( SSBtimes **tSSBOut,			//!< [out] reference-time offsets in
           {
             iter++;
             status = gsl_root_fsolver_iterate(s);
-            XLAL_CHECK ( (status == GSL_SUCCESS) || (status == GSL_CONTINUE), XLAL_EFAILED );
+            if ( (status != GSL_SUCCESS) && (status != GSL_CONTINUE) )
+              {
+                gsl_root_fsolver_free(s);
+                XLAL_ERROR ( XLAL_EFAILED );
+              }
             E_i = gsl_root_fsolver_root(s);
             E_lo = gsl_root_fsolver_x_lower (s);
             E_hi = gsl_root_fsolver_x_upper (s);
@@ -352,8 +370,11 @@ XLALAddBinaryTimes ( SSBtimes **tSSBOut,			//!< [out] reference-time offsets in
 
           } while ( (status == GSL_CONTINUE) && (iter < max_iter) );
 
-        XLAL_CHECK ( status == GSL_SUCCESS, XLAL_EMAXITER, "Eccentric anomaly: failed to converge to epsabs=%g within %d iterations\n", epsabs, max_iter );
-        gsl_root_fsolver_free(s);
+        if ( status != GSL_SUCCESS )
+          {
+            gsl_root_fsolver_free(s);
+            XLAL_ERROR ( XLAL_EMAXITER, "Eccentric anomaly: failed to converge to epsabs=%g within %d iterations\n", epsabs, max_iter );
+          }
       } // gsl-root finding block
 
       // use this value of E(tSSB) to compute the additional binary time delay
@@ -368,6 +389,8 @@ XLALAddBinaryTimes ( SSBtimes **tSSBOut,			//!< [out] reference-time offsets in
 
     } /* for i < numSteps */
 
+  gsl_root_fsolver_free(s);
+
   // pass back output SSB timings
   (*tSSBOut) = binaryTimes;
 
@@ -517,40 +540,56 @@ XLALDuplicateMultiSSBtimes ( const MultiSSBtimes *multiSSB )
 
 } /* XLALDuplicateMultiSSBtimes() */
 
-/** For a given DetectorStateSeries, calculate the time-differences
- *  \f$\Delta T_\alpha\equiv T(t_\alpha) - T_0\f$, and their
- *  derivatives \f$\dot{T}_\alpha \equiv d T / d t (t_\alpha)\f$.
- *
- *  \note The return-vector is allocated here
- *
+/** Create a batch of arrival times at a detector for XLALBarycenterBatch() from a DetectorStateSeries
  */
-SSBtimes *
-XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-states at timestamps t_i */
-                  SkyPosition pos,				/**< source sky-location */
-                  LIGOTimeGPS refTime,				/**< SSB reference-time T_0 of pulsar-parameters */
-                  SSBprecision precision			/**< relativistic or Newtonian SSB transformation? */
-                  )
+static BarycenterBatch *
+CreateBarycenterBatch ( const DetectorStateSeries *DetectorStates )
 {
-  XLAL_CHECK_NULL ( DetectorStates != NULL, XLAL_EINVAL, "Invalid NULL input 'DetectorStates'\n" );
-  XLAL_CHECK_NULL ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
-  XLAL_CHECK_NULL ( pos.system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, pos.system );
+  LALDetector site = DetectorStates->detector;
+  site.location[0] /= LAL_C_SI;
+  site.location[1] /= LAL_C_SI;
+  site.location[2] /= LAL_C_SI;
 
-  UINT4 numSteps = DetectorStates->length;		/* number of timestamps */
+  BarycenterBatch *baryBatch = XLALCreateBarycenterBatch ( &site, DetectorStates->length );
+  XLAL_CHECK_NULL ( baryBatch != NULL, XLAL_EFUNC );
 
-  // prepare output SSBtimes struct
-  int len;
-  SSBtimes *ret = XLALCalloc ( 1, len = sizeof(*ret) );
-  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
-  ret->DeltaT = XLALCreateREAL8Vector ( numSteps );
-  XLAL_CHECK_NULL ( ret->DeltaT != NULL, XLAL_EFUNC, "ret->DeltaT = XLALCreateREAL8Vector(%d) failed\n", numSteps );
-  ret->Tdot = XLALCreateREAL8Vector ( numSteps );
-  XLAL_CHECK_NULL ( ret->Tdot != NULL, XLAL_EFUNC, "ret->Tdot = XLALCreateREAL8Vector(%d) failed\n", numSteps );
+  for ( UINT4 i = 0; i < DetectorStates->length; i++ )
+    {
+      const DetectorState *state = &(DetectorStates->data[i]);
+      if ( XLALSetBarycenterBatchTime ( baryBatch, i, &state->tGPS, &state->earthState ) != XLAL_SUCCESS )
+        {
+          XLALDestroyBarycenterBatch ( baryBatch );
+          XLAL_ERROR_NULL ( XLAL_EFUNC );
+        }
+    }
+
+  return baryBatch;
+
+} /* CreateBarycenterBatch() */
+
+/** Fill an allocated SSBtimes struct with the SSB timings for a given DetectorStateSeries and sky-position.
+ * For #SSBPREC_RELATIVISTICOPT, the sky-independent quantities are taken from 'baryBatch'.
+ */
+static int
+FillSSBtimes ( SSBtimes *ret,					/**< [out] SSB timings */
+               const DetectorStateSeries *DetectorStates,	/**< [in] detector-states at timestamps t_i */
+               const BarycenterBatch *baryBatch,		/**< [in] sky-independent Barycentering quantities for 'DetectorStates' */
+               SkyPosition pos,					/**< source sky-location */
+               LIGOTimeGPS refTime,				/**< SSB reference-time T_0 of pulsar-parameters */
+               SSBprecision precision				/**< relativistic or Newtonian SSB transformation? */
+               )
+{
+  XLAL_CHECK ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
+  XLAL_CHECK ( pos.system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, pos.system );
+
+  UINT4 numSteps = DetectorStates->length;		/* number of timestamps */
+  XLAL_CHECK ( ret->DeltaT->length == numSteps, XLAL_EINVAL, "Length ret->DeltaT = %d, while DetectorStates = %d\n", ret->DeltaT->length, numSteps );
+  XLAL_CHECK ( ret->Tdot->length == numSteps, XLAL_EINVAL, "Length ret->Tdot = %d, while DetectorStates = %d\n", ret->Tdot->length, numSteps );
 
   /* convenience variables */
   REAL8 alpha = pos.longitude;
   REAL8 delta = pos.latitude;
   REAL8 refTimeREAL8 = XLALGPSGetREAL8 ( &refTime );
-  BarycenterBuffer *bBuffer = NULL;
 
   BarycenterInput XLAL_INIT_DECL(baryinput);
 
@@ -600,7 +639,7 @@ XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-
 	  baryinput.tgps = state->tGPS;
 
           if ( XLALBarycenter ( &emit, &baryinput, &(state->earthState) ) != XLAL_SUCCESS )
-            XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALBarycenter() failed with xlalErrno = %d\n", xlalErrno );
+            XLAL_ERROR ( XLAL_EFUNC, "XLALBarycenter() failed with xlalErrno = %d\n", xlalErrno );
 
 	  ret->DeltaT->data[i] = XLALGPSGetREAL8 ( &emit.te ) - refTimeREAL8;
 	  ret->Tdot->data[i] = emit.tDot;
@@ -609,33 +648,26 @@ XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-
 
       break;
 
-    case SSBPREC_RELATIVISTICOPT:	/* use optimized version XLALBarycenterOpt() */
+    case SSBPREC_RELATIVISTICOPT:	/* use batch version of XLALBarycenterOpt() */
+      {
+        XLAL_CHECK ( baryBatch != NULL, XLAL_EINVAL );
 
-      baryinput.site = DetectorStates->detector;
-      baryinput.site.location[0] /= LAL_C_SI;
-      baryinput.site.location[1] /= LAL_C_SI;
-      baryinput.site.location[2] /= LAL_C_SI;
-
-      baryinput.alpha = alpha;
-      baryinput.delta = delta;
-      baryinput.dInv = 0;
-
-      for ( UINT4 i = 0; i < numSteps; i++ )
-        {
-          EmissionTime emit;
-          DetectorState *state = &(DetectorStates->data[i]);
-          baryinput.tgps = state->tGPS;
-
-          if ( XLALBarycenterOpt ( &emit, &baryinput, &(state->earthState), &bBuffer ) != XLAL_SUCCESS )
-            XLAL_ERROR_NULL ( XLAL_EFUNC, "XLALBarycenterOpt() failed with xlalErrno = %d\n", xlalErrno );
-
-          ret->DeltaT->data[i] = XLALGPSGetREAL8 ( &emit.te ) - refTimeREAL8;
-          ret->Tdot->data[i] = emit.tDot;
+        // the emission times are returned in 'te', and their derivatives directly in 'Tdot'
+        LIGOTimeGPS *te = XLALCalloc ( numSteps, sizeof(te[0]) );
+        XLAL_CHECK ( te != NULL, XLAL_ENOMEM );
+        if ( XLALBarycenterBatch ( te, ret->Tdot->data, baryBatch, &alpha, &delta, 0, 1 ) != XLAL_SUCCESS )
+          {
+            XLALFree ( te );
+            XLAL_ERROR ( XLAL_EFUNC, "XLALBarycenterBatch() failed with xlalErrno = %d\n", xlalErrno );
+          }
 
-        } /* for i < numSteps */
-      // free buffer memory
-      XLALFree ( bBuffer );
+        for ( UINT4 i = 0; i < numSteps; i++ )
+          {
+            ret->DeltaT->data[i] = XLALGPSGetREAL8 ( &te[i] ) - refTimeREAL8;
+          } /* for i < numSteps */
 
+        XLALFree ( te );
+      }
       break;
 
     case SSBPREC_DMOFF:	/* switch off all demodulation terms */
@@ -649,15 +681,77 @@ XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-
       break;
 
     default:
-      XLAL_ERROR_NULL (XLAL_EFAILED, "\n?? Something went wrong.. this should never be called!\n\n" );
+      XLAL_ERROR (XLAL_EFAILED, "\n?? Something went wrong.. this should never be called!\n\n" );
       break;
     } /* switch precision */
 
   /* finally: store the reference-time used into the output-structure */
   ret->refTime = refTime;
 
+  return XLAL_SUCCESS;
+
+} /* FillSSBtimes() */
+
+/** Allocate an SSBtimes struct with 'numSteps' timestamps
+ */
+static SSBtimes *
+CreateSSBtimes ( UINT4 numSteps )
+{
+  int len;
+  SSBtimes *ret = XLALCalloc ( 1, len = sizeof(*ret) );
+  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
+  ret->DeltaT = XLALCreateREAL8Vector ( numSteps );
+  XLAL_CHECK_FAIL ( ret->DeltaT != NULL, XLAL_EFUNC, "ret->DeltaT = XLALCreateREAL8Vector(%d) failed\n", numSteps );
+  ret->Tdot = XLALCreateREAL8Vector ( numSteps );
+  XLAL_CHECK_FAIL ( ret->Tdot != NULL, XLAL_EFUNC, "ret->Tdot = XLALCreateREAL8Vector(%d) failed\n", numSteps );
   return ret;
 
+XLAL_FAIL:
+  XLALDestroySSBtimes ( ret );
+  return NULL;
+} /* CreateSSBtimes() */
+
+/** For a given DetectorStateSeries, calculate the time-differences
+ *  \f$\Delta T_\alpha\equiv T(t_\alpha) - T_0\f$, and their
+ *  derivatives \f$\dot{T}_\alpha \equiv d T / d t (t_\alpha)\f$.
+ *
+ *  \note The return-vector is allocated here
+ *
+ */
+SSBtimes *
+XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates,	/**< [in] detector-states at timestamps t_i */
+                  SkyPosition pos,				/**< source sky-location */
+                  LIGOTimeGPS refTime,				/**< SSB reference-time T_0 of pulsar-parameters */
+                  SSBprecision precision			/**< relativistic or Newtonian SSB transformation? */
+                  )
+{
+  XLAL_CHECK_NULL ( DetectorStates != NULL, XLAL_EINVAL, "Invalid NULL input 'DetectorStates'\n" );
+  XLAL_CHECK_NULL ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
+  XLAL_CHECK_NULL ( pos.system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, pos.system );
+
+  SSBtimes *ret = NULL;
+  BarycenterBatch *baryBatch = NULL;
+
+  // prepare output SSBtimes struct
+  XLAL_CHECK_FAIL ( (ret = CreateSSBtimes ( DetectorStates->length )) != NULL, XLAL_EFUNC );
+
+  // compute sky-independent Barycentering quantities, if needed
+  if ( precision == SSBPREC_RELATIVISTICOPT )
+    {
+      XLAL_CHECK_FAIL ( (baryBatch = CreateBarycenterBatch ( DetectorStates )) != NULL, XLAL_EFUNC );
+    }
+
+  XLAL_CHECK_FAIL ( FillSSBtimes ( ret, DetectorStates, baryBatch, pos, refTime, precision ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyBarycenterBatch ( baryBatch );
+
+  return ret;
+
+XLAL_FAIL:
+  XLALDestroyBarycenterBatch ( baryBatch );
+  XLALDestroySSBtimes ( ret );
+  return NULL;
+
 } /* XLALGetSSBtimes() */
 
 /** Multi-IFO version of XLALGetSSBtimes().
@@ -677,27 +771,155 @@ XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, /**< [in]
   XLAL_CHECK_NULL ( multiDetStates != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n");
   XLAL_CHECK_NULL ( multiDetStates->length > 0, XLAL_EINVAL, "Invalid zero-length 'multiDetStates'\n");
 
+  // compute sky-independent quantities, then SSB timings for this one sky-position
+  MultiSSBtimesBatch *batch = XLALCreateMultiSSBtimesBatch ( multiDetStates, precision );
+  XLAL_CHECK_NULL ( batch != NULL, XLAL_EFUNC );
+
+  MultiSSBtimes *ret = NULL;
+  XLAL_CHECK_FAIL ( XLALGetMultiSSBtimesBatch ( &ret, batch, &skypos, 1, refTime ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyMultiSSBtimesBatch ( batch );
+
+  return ret;
+
+XLAL_FAIL:
+  XLALDestroyMultiSSBtimesBatch ( batch );
+  XLALDestroyMultiSSBtimes ( ret );
+  return NULL;
+
+} /* XLALGetMultiSSBtimes() */
+
+/** Create a batch of sky-independent SSB-timing quantities for all input detector-series,
+ * for use with XLALGetMultiSSBtimesBatch().
+ *
+ * For #SSBPREC_RELATIVISTICOPT, all quantities of the Barycentering which do not depend on the
+ * sky-position (Earth position and velocity, Einstein delay, Earth rotation and precession, etc.)
+ * are computed here once per timestamp, so that SSB timings for many sky-positions, e.g. over
+ * a sky grid, need only compute the sky-dependent Roemer, Shapiro, etc. delays.
+ *
+ * NOTE: 'multiDetStates' is referenced, not copied, by the returned batch,
+ * and so must not be destroyed before the batch.
+ */
+MultiSSBtimesBatch *
+XLALCreateMultiSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates,	/**< [in] detector-states at timestamps t_i */
+                               SSBprecision precision				/**< use relativistic or Newtonian SSB timing?  */
+                               )
+{
+  /* check input */
+  XLAL_CHECK_NULL ( multiDetStates != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n");
+  XLAL_CHECK_NULL ( multiDetStates->length > 0, XLAL_EINVAL, "Invalid zero-length 'multiDetStates'\n");
+  XLAL_CHECK_NULL ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
+
   UINT4 numDetectors = multiDetStates->length;
 
-  // prepare return struct
-  int len;
-  MultiSSBtimes *ret = XLALCalloc ( 1, len = sizeof( *ret ) );
-  XLAL_CHECK_NULL ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
-  ret->length = numDetectors;
-  ret->data = XLALCalloc ( numDetectors, len=sizeof ( *ret->data ) );
-  XLAL_CHECK_NULL ( ret->data != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(%d,%d)\n", numDetectors, len );
+  MultiSSBtimesBatch *batch = XLALCalloc ( 1, sizeof(*batch) );
+  XLAL_CHECK_NULL ( batch != NULL, XLAL_ENOMEM );
+  batch->multiDetStates = multiDetStates;
+  batch->precision = precision;
+  batch->numDetectors = numDetectors;
+  XLAL_CHECK_FAIL ( (batch->baryBatch = XLALCalloc ( numDetectors, sizeof(batch->baryBatch[0]) )) != NULL, XLAL_ENOMEM );
 
-  // loop over detectors
-  for ( UINT4 X = 0; X < numDetectors; X ++ )
+  if ( precision == SSBPREC_RELATIVISTICOPT )
     {
-      ret->data[X] = XLALGetSSBtimes ( multiDetStates->data[X], skypos, refTime, precision );
-      XLAL_CHECK_NULL ( ret->data[X] != NULL, XLAL_EFUNC, "ret->data[%d] = XLALGetSSBtimes() failed with xlalErrno = %d\n", X, xlalErrno );
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          batch->baryBatch[X] = CreateBarycenterBatch ( multiDetStates->data[X] );
+          XLAL_CHECK_FAIL ( batch->baryBatch[X] != NULL, XLAL_EFUNC, "CreateBarycenterBatch() failed for X=%d\n", X );
+        }
+    }
 
-    } /* for X < numDet */
+  return batch;
 
-  return ret;
+XLAL_FAIL:
+  XLALDestroyMultiSSBtimesBatch ( batch );
+  return NULL;
 
-} /* XLALGetMultiSSBtimes() */
+} /* XLALCreateMultiSSBtimesBatch() */
+
+/** Destroy a batch of sky-independent SSB-timing quantities
+ */
+void
+XLALDestroyMultiSSBtimesBatch ( MultiSSBtimesBatch *batch )
+{
+  if ( ! batch )
+    return;
+
+  if ( batch->baryBatch )
+    {
+      for ( UINT4 X = 0; X < batch->numDetectors; X ++ )
+        {
+          XLALDestroyBarycenterBatch ( batch->baryBatch[X] );
+        }
+      XLALFree ( batch->baryBatch );
+    }
+  XLALFree ( batch );
+
+} /* XLALDestroyMultiSSBtimesBatch() */
+
+/** Get all SSB-timings for all input detector-series, for each of 'numSky' sky-positions,
+ * from a batch created with XLALCreateMultiSSBtimesBatch().
+ *
+ * NOTE: each element of the output array \a multiSSB can be passed either as
+ * - unallocated (<tt>multiSSB[k]==NULL</tt>): it gets allocated here, or
+ * - an allocated MultiSSBtimes of the correct size, which is re-used
+ *   (this is useful in order to minimize unnecessary memory allocs+frees on repeated calls).
+ */
+int
+XLALGetMultiSSBtimesBatch ( MultiSSBtimes **multiSSB,		/**< [out] SSB timings, for each sky-position */
+                            const MultiSSBtimesBatch *batch,	/**< [in] sky-independent SSB-timing quantities */
+                            const SkyPosition *skypos,		/**< [in] source sky-positions [in equatorial coords!] */
+                            UINT4 numSky,			/**< [in] number of sky-positions */
+                            LIGOTimeGPS refTime			/**< [in] SSB reference-time T_0 for SSB-timing */
+                            )
+{
+  /* check input */
+  XLAL_CHECK ( multiSSB != NULL, XLAL_EINVAL, "Invalid NULL input 'multiSSB'\n");
+  XLAL_CHECK ( batch != NULL, XLAL_EINVAL, "Invalid NULL input 'batch'\n");
+  XLAL_CHECK ( skypos != NULL, XLAL_EINVAL, "Invalid NULL input 'skypos'\n");
+
+  const MultiDetectorStateSeries *multiDetStates = batch->multiDetStates;
+  UINT4 numDetectors = batch->numDetectors;
+  XLAL_CHECK ( multiDetStates->length == numDetectors, XLAL_EINVAL );
+
+  // loop over sky-positions
+  for ( UINT4 k = 0; k < numSky; k ++ )
+    {
+
+      // ----- prepare output: either allocate or re-use existing
+      if ( multiSSB[k] == NULL )
+        {
+          int len;
+          // attached to the output at once, so that the caller frees it should allocation fail part-way
+          MultiSSBtimes *ret = multiSSB[k] = XLALCalloc ( 1, len = sizeof( *ret ) );
+          XLAL_CHECK ( ret != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%d)\n", len );
+          ret->length = numDetectors;
+          ret->data = XLALCalloc ( numDetectors, len=sizeof ( *ret->data ) );
+          XLAL_CHECK ( ret->data != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(%d,%d)\n", numDetectors, len );
+          for ( UINT4 X = 0; X < numDetectors; X ++ )
+            {
+              ret->data[X] = CreateSSBtimes ( multiDetStates->data[X]->length );
+              XLAL_CHECK ( ret->data[X] != NULL, XLAL_EFUNC );
+            }
+        }
+      else
+        {
+          XLAL_CHECK ( multiSSB[k]->length == numDetectors, XLAL_EINVAL,
+                       "Inconsistent length multiSSB[%d]->length = %d, while multiDetStates->length = %d\n", k, multiSSB[k]->length, numDetectors );
+          // we'll leave all other sanity-checks to FillSSBtimes()
+        }
+
+      // loop over detectors
+      for ( UINT4 X = 0; X < numDetectors; X ++ )
+        {
+          int ret = FillSSBtimes ( multiSSB[k]->data[X], multiDetStates->data[X], batch->baryBatch[X], skypos[k], refTime, batch->precision );
+          XLAL_CHECK ( ret == XLAL_SUCCESS, XLAL_EFUNC, "FillSSBtimes() failed for k=%d, X=%d\n", k, X );
+        } /* for X < numDet */
+
+    } /* for k < numSky */
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetMultiSSBtimesBatch() */
 
 /** Find the earliest timestamp in a multi-SSB data structure
  *
@@ -69,6 +69,11 @@ typedef struct tagMultiSSBtimes {
   SSBtimes **data;	/**< array of SSBtimes (pointers) */
 } MultiSSBtimes;
 
+/** Sky-independent SSB-timing quantities for all timestamps of a set of detector-state series,
+ * used to compute SSB timings for many sky-positions with XLALGetMultiSSBtimesBatch().
+ */
+typedef struct tagMultiSSBtimesBatch MultiSSBtimesBatch;
+
 /*---------- exported Global variables ----------*/
 
 /*---------- exported prototypes [API] ----------*/
@@ -80,12 +85,16 @@ MultiSSBtimes *XLALDuplicateMultiSSBtimes ( const MultiSSBtimes *multiSSB );
 SSBtimes *XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates, SkyPosition pos, LIGOTimeGPS refTime, SSBprecision precision );
 MultiSSBtimes *XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, SkyPosition skypos, LIGOTimeGPS refTime, SSBprecision precision);
 
+MultiSSBtimesBatch *XLALCreateMultiSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates, SSBprecision precision );
+int XLALGetMultiSSBtimesBatch ( MultiSSBtimes **multiSSB, const MultiSSBtimesBatch *batch, const SkyPosition *skypos, UINT4 numSky, LIGOTimeGPS refTime );
+
 int XLALEarliestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB, const REAL8 Tsft );
 int XLALLatestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB,  const REAL8 Tsft );
 
 /* destructors */
 void XLALDestroySSBtimes ( SSBtimes *multiSSB );
 void XLALDestroyMultiSSBtimes ( MultiSSBtimes *multiSSB );
+void XLALDestroyMultiSSBtimesBatch ( MultiSSBtimesBatch *batch );
 
 /** @} */
 
@@ -31,6 +31,7 @@
 
 /* System includes */
 #include <math.h>
+#include <string.h>
 
 /* LAL-includes */
 #include <lal/XLALError.h>
@@ -38,6 +39,7 @@
 #include <lal/AVFactories.h>
 #include <lal/LogPrintf.h>
 #include <lal/LALString.h>
+#include <lal/VectorMath.h>
 
 #include <lal/ProbabilityDensity.h>
 #include <lal/TransientCW_utils.h>
@@ -57,6 +59,21 @@ static gsl_vector *expLUT = NULL; 	/**< module-global lookup-table for negative
 
 static int XLALCreateExpLUT ( void );	/* only ever used internally, destructor is in exported API */
 
+/* ----- module-local sums of F-stat atoms over transient windows ----- */
+/**
+ * Sums of F-stat atoms {a^2, b^2, ab, Fa, Fb}, as used by XLALComputeTransientFstatMap()
+ * to compute the window-weighted sums over transient windows in O(1) per window
+ */
+typedef struct tagtransientAtomSums_t {
+  REAL8 a2, b2, ab;		/**< sums of antenna-pattern atoms a^2, b^2, ab */
+  REAL8 Fa_re, Fa_im;		/**< sums of real and imaginary parts of Fa atoms */
+  REAL8 Fb_re, Fb_im;		/**< sums of real and imaginary parts of Fb atoms */
+} transientAtomSums_t;
+
+static void PrefixSumTransientAtoms ( transientAtomSums_t *S, const FstatAtomVector *atoms );
+static void FilterTransientAtomsExp ( transientAtomSums_t *S, const FstatAtomVector *atoms, REAL8 q );
+static int SumExpTransientFstatMap ( REAL8 *sum_eF, REAL8 *sum_eF_t0, REAL8 *sum_eF_tau, const transientFstatMap_t *FstatMap );
+
 static const char *transientWindowNames[TRANSIENT_LAST] =
   {
     [TRANSIENT_NONE]	 	= "none",
@@ -398,20 +415,11 @@ XLALComputeTransientBstat ( transientWindowRange_t windowRange,		/**< [in] type
    */
   UINT4 N_t0Range  = FstatMap->F_mn->size1;
   UINT4 N_tauRange = FstatMap->F_mn->size2;
-  UINT4 m, n;
-  REAL8 sum_eB = 0;
-  for ( m=0; m < N_t0Range; m ++ )
-    {
-      for ( n=0; n < N_tauRange; n ++ )
-        {
-          REAL8 DeltaF = FstatMap->maxF - gsl_matrix_get ( FstatMap->F_mn, m, n );	// always >= 0, exactly ==0 at {m,n}_max
-
-          //sum_eB += exp ( - DeltaF );
-          sum_eB += XLALFastNegExp ( DeltaF );
-
-        } /* for n < N_tauRange */
-
-    } /* for m < N_t0Range */
+  REAL8 sum_eB;
+  if ( SumExpTransientFstatMap ( &sum_eB, NULL, NULL, FstatMap ) != XLAL_SUCCESS ) {
+    XLALPrintError ("%s: SumExpTransientFstatMap() failed.\n", __func__ );
+    XLAL_ERROR ( XLAL_EFUNC );
+  }
 
   /* combine this to final log(Bstat) result with proper normalization (assuming rhohMax=1) : */
 
@@ -425,9 +433,6 @@ XLALComputeTransientBstat ( transientWindowRange_t windowRange,		/**< [in] type
 
   // printf ( "\n\nlogBhat = %g, normBh = %g, log(normBh) = %g\nN_t0Range = %d, N_tauRange=%d\n\n", logBhat, normBh, log(normBh), N_t0Range, N_tauRange );
 
-  /* free mem */
-  XLALDestroyExpLUT();
-
   /* ----- return ----- */
   return logBstat;
 
@@ -462,7 +467,6 @@ XLALComputeTransientPosterior_t0 ( transientWindowRange_t windowRange,		/**< [in
    * e^F_mn can overflow (for F>~700). The constant offset e^Fmax is irrelevant for posteriors (normalization constant).
    */
   UINT4 N_t0Range  = FstatMap->F_mn->size1;
-  UINT4 N_tauRange = FstatMap->F_mn->size2;
 
   REAL8 t0 = windowRange.t0;
   REAL8 t1 = t0 + windowRange.t0Band;
@@ -493,25 +497,10 @@ XLALComputeTransientPosterior_t0 ( transientWindowRange_t windowRange,		/**< [in
     XLAL_ERROR_NULL ( XLAL_ENOMEM );
   }
 
-  UINT4 m, n;
-  for ( m=0; m < N_t0Range; m ++ )	/* loop over start-times t0 */
-    {
-      REAL8 sum_eF = 0;
-      for ( n=0; n < N_tauRange; n ++ )	/* loop over timescales tau */
-        {
-          REAL8 DeltaF = FstatMap->maxF - gsl_matrix_get ( FstatMap->F_mn, m, n );	// always >= 0, exactly ==0 at {m,n}_max
-
-          //sum_eB += exp ( - DeltaF );
-          sum_eF += XLALFastNegExp ( DeltaF );
-
-        } /* for n < N_tauRange */
-
-      ret->probDens->data[m] = sum_eF;
-
-    } /* for m < N_t0Range */
-
-  /* free mem */
-  XLALDestroyExpLUT();
+  if ( SumExpTransientFstatMap ( NULL, ret->probDens->data, NULL, FstatMap ) != XLAL_SUCCESS ) {
+    XLALPrintError ("%s: SumExpTransientFstatMap() failed.\n", __func__ );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
 
   /* normalize this PDF */
   if ( XLALNormalizePDF1D ( ret ) != XLAL_SUCCESS ) {
@@ -552,7 +541,6 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
    * It is numerically more robust to marginalize over e^(F_mn - Fmax), which at worst can underflow, while
    * e^F_mn can overflow (for F>~700). The constant offset e^Fmax is irrelevant for posteriors (normalization constant).
    */
-  UINT4 N_t0Range  = FstatMap->F_mn->size1;
   UINT4 N_tauRange = FstatMap->F_mn->size2;
 
   REAL8 tau0 = windowRange.tau;
@@ -584,25 +572,10 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
     XLAL_ERROR_NULL ( XLAL_ENOMEM );
   }
 
-  UINT4 m, n;
-  for ( n=0; n < N_tauRange; n ++ )	/* loop over timescales tau */
-    {
-      REAL8 sum_eF = 0;
-      for ( m=0; m < N_t0Range; m ++ )	/* loop over start-times t0 */
-        {
-          REAL8 DeltaF = FstatMap->maxF - gsl_matrix_get ( FstatMap->F_mn, m, n );	// always >= 0, exactly ==0 at {m,n}_max
-
-          //sum_eB += exp ( - DeltaF );
-          sum_eF += XLALFastNegExp ( DeltaF );
-
-        } /* for m < N_t0Range */
-
-      ret->probDens->data[n] = sum_eF;
-
-    } /* for n < N_tauRange */
-
-  /* free mem */
-  XLALDestroyExpLUT();
+  if ( SumExpTransientFstatMap ( NULL, NULL, ret->probDens->data, FstatMap ) != XLAL_SUCCESS ) {
+    XLALPrintError ("%s: SumExpTransientFstatMap() failed.\n", __func__ );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
 
   /* normalize this PDF */
   if ( XLALNormalizePDF1D ( ret ) != XLAL_SUCCESS ) {
@@ -628,6 +601,10 @@ XLALComputeTransientPosterior_tau ( transientWindowRange_t windowRange,		/**< [i
  * little practical interest, except for demonstrating that marginalizing (1/D)e^F is *less* sensitive
  * than marginalizing e^F (see transient methods-paper [in prepartion])
  *
+ * Note3: the window sums over atoms cost O(1) per map element, independent of the window length:
+ * rectangular windows use prefix sums of the atoms over the data, and exponential windows use a
+ * backwards recursive filter of the atoms, computed once per timescale tau.
+ *
  */
 transientFstatMap_t *
 XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**< [in] multi-IFO F-statistic atoms */
@@ -706,31 +683,50 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
     XLAL_ERROR_NULL ( XLAL_ENOMEM );
   }
 
+  /* ----- prepare the sums of atoms over transient windows ----- */
+  /* The atoms are summed into an array S[0..numAtoms] with a trailing zero element, such that
+   * the sum over any window is available in O(1) operations, independent of the window length:
+   *
+   * - for rectangular windows, S holds the prefix sums S[k] = sum_{i<k} x_i, so the sum over atoms
+   *   [i_t0, i_t1] is S[i_t1+1] - S[i_t0];
+   *
+   * - for exponential windows, S holds for each timescale tau the backwards recursive filter
+   *   S[k] = x_k + q^p S[k+1], with q = e^(-TAtom/tau), and p = 2 for {a^2, b^2, ab} and p = 1 for {Fa, Fb},
+   *   so the window-weighted sum over atoms [i_a, i_b] is e^(-p (t_{i_a} - t0)/tau) ( S[i_a] - q^(p (i_b+1-i_a)) S[i_b+1] )
+   */
+  transientAtomSums_t *S;
+  if ( (S = XLALCalloc ( numAtoms + 1, sizeof(*S) )) == NULL ) {
+    XLALPrintError ("%s: XLALCalloc(%d,%zu) failed.\n", __func__, numAtoms + 1, sizeof(*S) );
+    XLAL_ERROR_NULL ( XLAL_ENOMEM );
+  }
+  if ( windowRange.type == TRANSIENT_RECTANGULAR ) {
+    PrefixSumTransientAtoms ( S, atoms );
+  }
+
   transientWindow_t win_mn;
   win_mn.type = windowRange.type;
   ret->maxF = -1.0;	// keep track of loudest F-stat point. Initializing to a negative value ensures that we always update at least once and hence return sane t0_d_ML, tau_d_ML even if there is only a single bin where F=0 happens.
+  UINT4 m_ML = N_t0Range;
   UINT4 m, n;
-  /* ----- OUTER loop over start-times [t0,t0+t0Band] ---------- */
-  for ( m = 0; m < N_t0Range; m ++ ) /* m enumerates 'binned' t0 start-time indices  */
+  /* ----- OUTER loop over timescale-parameter tau ---------- */
+  for ( n = 0; n < N_tauRange; n ++ )
     {
-      /* compute Fstat-atom index i_t0 in [0, numAtoms) */
-      win_mn.t0 = windowRange.t0 + m * windowRange.dt0;
-      INT4 i_tmp = ( win_mn.t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
-      if ( i_tmp < 0 ) i_tmp = 0;
-      UINT4 i_t0 = (UINT4)i_tmp;
-      if ( i_t0 >= numAtoms ) i_t0 = numAtoms - 1;
-
-      /* ----- INNER loop over timescale-parameter tau ---------- */
-      REAL4 Ad=0, Bd=0, Cd=0;
-      COMPLEX8 Fa=0, Fb=0;
-      UINT4 i_t1_last = i_t0;
-
-      for ( n = 0; n < N_tauRange; n ++ )
+      win_mn.tau = windowRange.tau + n * windowRange.dtau;
+
+      /* exponential windows: filter the atoms for this timescale */
+      if ( windowRange.type == TRANSIENT_EXPONENTIAL ) {
+        FilterTransientAtomsExp ( S, atoms, exp ( - 1.0 * TAtom / win_mn.tau ) );
+      }
+
+      /* ----- INNER loop over start-times [t0,t0+t0Band] ---------- */
+      for ( m = 0; m < N_t0Range; m ++ ) /* m enumerates 'binned' t0 start-time indices  */
         {
-          /* translate n into an atoms end-index for this search interval [t0, t0+Tcoh],
-           * giving the index range of atoms to sum over
-           */
-          win_mn.tau = windowRange.tau + n * windowRange.dtau;
+          /* compute Fstat-atom index i_t0 in [0, numAtoms) */
+          win_mn.t0 = windowRange.t0 + m * windowRange.dt0;
+          INT4 i_tmp = ( win_mn.t0 - t0_data + TAtomHalf ) / TAtom;	// integer round: floor(x+0.5)
+          if ( i_tmp < 0 ) i_tmp = 0;
+          UINT4 i_t0 = (UINT4)i_tmp;
+          if ( i_t0 >= numAtoms ) i_t0 = numAtoms - 1;
 
           /* get end-time t1 of this transient-window search */
           UINT4 t0, t1;
@@ -751,69 +747,55 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
             XLALPrintError ("Window-values m=%d (t0=%d=t0_data + %d), n=%d (tau=%d) ==> t1_data - t0 = %d\n",
                             m, win_mn.t0, i_t0 * TAtom, n, win_mn.tau, t1_data - win_mn.t0 );
             XLALPrintError ("The most likely cause is that your t0-range covered all of your data: t0 must stay away *at least* 2*TAtom from the end of the data!\n");
+            XLALFree ( S );
             XLAL_ERROR_NULL ( XLAL_EDOM );
           }
 
           /* now we have two valid atoms-indices [i_t0, i_t1] spanning our Fstat-window to sum over,
            * using weights according to the window-type
            */
+          REAL4 Ad, Bd, Cd;
+          COMPLEX8 Fa, Fb;
           switch ( windowRange.type )
             {
             case TRANSIENT_RECTANGULAR:
-#if 0
-              /* 'vanilla' unoptimized method, for sanity checks with 'optimized' method */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-#else
-              /* special optimiziation in the rectangular-window case: just add on to previous tau values
-               * ie re-use the sum over [i_t0, i_t1_last] from the pevious tau-loop iteration
-               */
-              for ( UINT4 i = i_t1_last; i <= i_t1; i ++ )
-#endif
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-
-                  /* now add on top of previous values, summed from [i_t0, i_t1_last] */
-                  Ad += thisAtom_i->a2_alpha;
-                  Bd += thisAtom_i->b2_alpha;
-                  Cd += thisAtom_i->ab_alpha;
-
-                  Fa += thisAtom_i->Fa_alpha;
-                  Fb += thisAtom_i->Fb_alpha;
-
-                } /* for i = i_t1_last : i_t1 */
-
-              i_t1_last = i_t1 + 1;		/* keep track of up to where we summed for the next iteration */
-
+              Ad = S[i_t1+1].a2 - S[i_t0].a2;
+              Bd = S[i_t1+1].b2 - S[i_t0].b2;
+              Cd = S[i_t1+1].ab - S[i_t0].ab;
+              Fa = crect ( S[i_t1+1].Fa_re - S[i_t0].Fa_re, S[i_t1+1].Fa_im - S[i_t0].Fa_im );
+              Fb = crect ( S[i_t1+1].Fb_re - S[i_t0].Fb_re, S[i_t1+1].Fb_im - S[i_t0].Fb_im );
               break;
 
             case TRANSIENT_EXPONENTIAL:
-              /* reset all values */
-              Ad=0; Bd=0; Cd=0; Fa=0; Fb=0;
-
-              for ( UINT4 i = i_t0; i <= i_t1; i ++ )
-                {
-                  FstatAtom *thisAtom_i = &atoms->data[i];
-                  UINT4 t_i = thisAtom_i->timestamp;
-
-                  REAL8 win_i;
-                  win_i = XLALGetExponentialTransientWindowValue ( t_i, t0, t1, win_mn.tau );
-
-                  REAL8 win2_i = win_i * win_i;
-
-                  Ad += thisAtom_i->a2_alpha * win2_i;
-                  Bd += thisAtom_i->b2_alpha * win2_i;
-                  Cd += thisAtom_i->ab_alpha * win2_i;
-
-                  Fa += thisAtom_i->Fa_alpha * win_i;
-                  Fb += thisAtom_i->Fb_alpha * win_i;
-
-                } /* for i in [i_t0, i_t1] */
+              {
+                /* restrict [i_t0, i_t1] to atoms [i_a, i_b] with timestamps inside [t0, t1], where the window is non-zero */
+                INT4 i_a = i_t0, i_b = i_t1;
+                while ( i_a <= i_b && t0_data + i_a * TAtom < t0 ) {
+                  i_a ++;
+                }
+                while ( i_b >= i_a && t0_data + i_b * TAtom > t1 ) {
+                  i_b --;
+                }
+                if ( i_a > i_b ) {
+                  Ad = Bd = Cd = 0;
+                  Fa = Fb = 0;
+                  break;
+                }
+                REAL8 w_a = exp ( - 1.0 * ( t0_data + i_a * TAtom - t0 ) / win_mn.tau );	// window value at atom i_a
+                REAL8 q_ab = exp ( - 1.0 * ( i_b + 1 - i_a ) * TAtom / win_mn.tau );	// q^(i_b+1-i_a)
+                REAL8 w2_a = w_a * w_a, q2_ab = q_ab * q_ab;
+                Ad = w2_a * ( S[i_a].a2 - q2_ab * S[i_b+1].a2 );
+                Bd = w2_a * ( S[i_a].b2 - q2_ab * S[i_b+1].b2 );
+                Cd = w2_a * ( S[i_a].ab - q2_ab * S[i_b+1].ab );
+                Fa = crect ( w_a * ( S[i_a].Fa_re - q_ab * S[i_b+1].Fa_re ), w_a * ( S[i_a].Fa_im - q_ab * S[i_b+1].Fa_im ) );
+                Fb = crect ( w_a * ( S[i_a].Fb_re - q_ab * S[i_b+1].Fb_re ), w_a * ( S[i_a].Fb_im - q_ab * S[i_b+1].Fb_im ) );
+              }
               break;
 
             default:
               XLALPrintError ("%s: invalid transient window type %d not in [%d, %d].\n",
                               __func__, windowRange.type, TRANSIENT_NONE, TRANSIENT_LAST -1 );
+              XLALFree ( S );
               XLAL_ERROR_NULL ( XLAL_EINVAL );
               break;
 
@@ -825,12 +807,15 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
           REAL4 DdInv = 1.0f / Dd;
           REAL4 twoF = compute_fstat_from_fa_fb ( Fa, Fb, Ad, Bd, Cd, 0, DdInv );
           REAL4 F = 0.5 * twoF;
-          /* keep track of loudest F-stat value encountered over the m x n matrix */
-          if ( F > ret->maxF )
+          /* keep track of loudest F-stat value encountered over the m x n matrix;
+           * of equal values, keep the first one in {m,n} order, i.e. with the smallest t0, then tau
+           */
+          if ( F > ret->maxF || ( F == ret->maxF && m < m_ML ) )
             {
               ret->maxF = F;
               ret->t0_ML  = win_mn.t0;	/* start-time t0 corresponding to Fmax */
               ret->tau_ML = win_mn.tau;	/* timescale tau corresponding to Fmax */
+              m_ML = m;
             }
 
           /* if requested: use 'regularized' F-stat: log ( 1/D * e^F ) = F + log(1/D) */
@@ -840,11 +825,12 @@ XLALComputeTransientFstatMap ( const MultiFstatAtomVector *multiFstatAtoms, 	/**
           /* and store this in Fstat-matrix as element {m,n} */
           gsl_matrix_set ( ret->F_mn, m, n, F );
 
-        } /* for n in n[tau] : n[tau+tauBand] */
+        } /* for m in m[t0] : m[t0+t0Band] */
 
-    } /* for m in m[t0] : m[t0+t0Band] */
+    } /* for n in n[tau] : n[tau+tauBand] */
 
   /* free internal mem */
+  XLALFree ( S );
   XLALDestroyFstatAtomVector ( atoms );
 
   /* return end product: F-stat map */
@@ -929,7 +915,7 @@ XLALmergeMultiFstatAtomsBinned ( const MultiFstatAtomVector *multiAtoms, UINT4 d
 
           /* add atoms i to target atoms j */
           FstatAtom *destAtom = &atomsOut->data[j];
-          destAtom->timestamp = tMin + i * deltaT;	/* set binned output atoms timestamp */
+          destAtom->timestamp = tMin + j * deltaT;	/* set binned output atoms timestamp */
 
           destAtom->a2_alpha += atom_X_i->a2_alpha;
           destAtom->b2_alpha += atom_X_i->b2_alpha;
@@ -944,6 +930,114 @@ XLALmergeMultiFstatAtomsBinned ( const MultiFstatAtomVector *multiAtoms, UINT4 d
 
 } /* XLALmergeMultiFstatAtomsBinned() */
 
+/**
+ * Compute the prefix sums S[k] = sum_{i<k} x_i, for k = 0 ... numAtoms, of the binned atoms x_i.
+ * S must have length numAtoms + 1.
+ */
+static void
+PrefixSumTransientAtoms ( transientAtomSums_t *S, const FstatAtomVector *atoms )
+{
+  UINT4 numAtoms = atoms->length;
+  XLAL_INIT_MEM ( S[0] );
+  for ( UINT4 i = 0; i < numAtoms; i ++ )
+    {
+      const FstatAtom *atom_i = &atoms->data[i];
+      S[i+1].a2 = S[i].a2 + atom_i->a2_alpha;
+      S[i+1].b2 = S[i].b2 + atom_i->b2_alpha;
+      S[i+1].ab = S[i].ab + atom_i->ab_alpha;
+      S[i+1].Fa_re = S[i].Fa_re + crealf ( atom_i->Fa_alpha );
+      S[i+1].Fa_im = S[i].Fa_im + cimagf ( atom_i->Fa_alpha );
+      S[i+1].Fb_re = S[i].Fb_re + crealf ( atom_i->Fb_alpha );
+      S[i+1].Fb_im = S[i].Fb_im + cimagf ( atom_i->Fb_alpha );
+    } /* for i < numAtoms */
+
+  return;
+
+} /* PrefixSumTransientAtoms() */
+
+/**
+ * Filter the binned atoms x_i backwards in time with the exponential window decay q = e^(-TAtom/tau)
+ * per atom, i.e. compute S[k] = x_k + q^p S[k+1] for k = numAtoms-1 ... 0, with S[numAtoms] = 0,
+ * and p = 2 for the antenna-pattern atoms and p = 1 for the Fa, Fb atoms.
+ * S must have length numAtoms + 1.
+ */
+static void
+FilterTransientAtomsExp ( transientAtomSums_t *S, const FstatAtomVector *atoms, REAL8 q )
+{
+  UINT4 numAtoms = atoms->length;
+  REAL8 q2 = q * q;
+  XLAL_INIT_MEM ( S[numAtoms] );
+  for ( INT4 i = numAtoms - 1; i >= 0; i -- )
+    {
+      const FstatAtom *atom_i = &atoms->data[i];
+      S[i].a2 = atom_i->a2_alpha + q2 * S[i+1].a2;
+      S[i].b2 = atom_i->b2_alpha + q2 * S[i+1].b2;
+      S[i].ab = atom_i->ab_alpha + q2 * S[i+1].ab;
+      S[i].Fa_re = crealf ( atom_i->Fa_alpha ) + q * S[i+1].Fa_re;
+      S[i].Fa_im = cimagf ( atom_i->Fa_alpha ) + q * S[i+1].Fa_im;
+      S[i].Fb_re = crealf ( atom_i->Fb_alpha ) + q * S[i+1].Fb_re;
+      S[i].Fb_im = cimagf ( atom_i->Fb_alpha ) + q * S[i+1].Fb_im;
+    } /* for i = numAtoms-1 : 0 */
+
+  return;
+
+} /* FilterTransientAtomsExp() */
+
+/**
+ * Sum e^(F_mn - maxF) over an F-stat map: over all elements {m,n} (if sum_eF != NULL), over timescales tau
+ * for each start-time t0 (if sum_eF_t0 != NULL, length N_t0Range), and/or over start-times t0 for each
+ * timescale tau (if sum_eF_tau != NULL, length N_tauRange).
+ *
+ * The exponentials are computed one t0-row of the map at a time, using the SIMD vector math of XLALVectorExpREAL4().
+ */
+static int
+SumExpTransientFstatMap ( REAL8 *sum_eF, REAL8 *sum_eF_t0, REAL8 *sum_eF_tau, const transientFstatMap_t *FstatMap )
+{
+  UINT4 N_t0Range  = FstatMap->F_mn->size1;
+  UINT4 N_tauRange = FstatMap->F_mn->size2;
+
+  REAL4VectorAligned *eF_n;
+  XLAL_CHECK ( (eF_n = XLALCreateREAL4VectorAligned ( N_tauRange, 32 )) != NULL, XLAL_EFUNC );
+
+  if ( sum_eF ) {
+    (*sum_eF) = 0;
+  }
+  if ( sum_eF_tau ) {
+    memset ( sum_eF_tau, 0, N_tauRange * sizeof(sum_eF_tau[0]) );
+  }
+  for ( UINT4 m = 0; m < N_t0Range; m ++ )
+    {
+      for ( UINT4 n = 0; n < N_tauRange; n ++ ) {
+        eF_n->data[n] = gsl_matrix_get ( FstatMap->F_mn, m, n ) - FstatMap->maxF;	// always <= 0, exactly ==0 at {m,n}_max
+      }
+      if ( XLALVectorExpREAL4 ( eF_n->data, eF_n->data, N_tauRange ) != XLAL_SUCCESS ) {
+        XLALDestroyREAL4VectorAligned ( eF_n );
+        XLAL_ERROR ( XLAL_EFUNC );
+      }
+
+      REAL8 sum_eF_n = 0;
+      for ( UINT4 n = 0; n < N_tauRange; n ++ ) {
+        sum_eF_n += eF_n->data[n];
+      }
+      if ( sum_eF ) {
+        (*sum_eF) += sum_eF_n;
+      }
+      if ( sum_eF_t0 ) {
+        sum_eF_t0[m] = sum_eF_n;
+      }
+      if ( sum_eF_tau ) {
+        for ( UINT4 n = 0; n < N_tauRange; n ++ ) {
+          sum_eF_tau[n] += eF_n->data[n];
+        }
+      }
+    } /* for m < N_t0Range */
+
+  XLALDestroyREAL4VectorAligned ( eF_n );
+
+  return XLAL_SUCCESS;
+
+} /* SumExpTransientFstatMap() */
+
 /**
  * Write one line for given transient CW candidate into output file.
  *
@@ -84,6 +84,8 @@
  * LALHOUGHupdateSpacePHMDup()
  * LALHOUGHInitializeHT()
  * LALHOUGHConstructHMT()
+ * LALHOUGHConstructHMT_W()
+ * XLALHOUGHConstructHMTVector()
  * LALPrintError()
  * LALMalloc()
  * LALFree()
@@ -103,12 +105,14 @@
 #define TESTDRIVEHOUGHC_EARG  2
 #define TESTDRIVEHOUGHC_EBAD  3
 #define TESTDRIVEHOUGHC_EFILE 4
+#define TESTDRIVEHOUGHC_EMAP  5
 
 #define TESTDRIVEHOUGHC_MSGENORM "Normal exit"
 #define TESTDRIVEHOUGHC_MSGESUB  "Subroutine failed"
 #define TESTDRIVEHOUGHC_MSGEARG  "Error parsing arguments"
 #define TESTDRIVEHOUGHC_MSGEBAD  "Bad argument values"
 #define TESTDRIVEHOUGHC_MSGEFILE "Could not create output file"
+#define TESTDRIVEHOUGHC_MSGEMAP  "Hough maps differ"
 /** @} */
 
 /** \cond DONT_DOXYGEN */
@@ -490,6 +494,70 @@ int main(int argc, char *argv[]){
   fclose( fp );
 
 
+  /******************************************************************/
+  /* construction of several total Hough maps in parallel, compared */
+  /* to maps constructed one at a time, without and with weights    */
+  /******************************************************************/
+  {
+    static HOUGHMapTotalVector htV;
+    static UINT8FrequencyIndexVectorSequence freqIndVS;
+    INT4 useWeights, n;
+
+    htV.length = NFSIZE;
+    htV.ht = (HOUGHMapTotal *)LALCalloc(NFSIZE, sizeof(HOUGHMapTotal));
+    freqIndVS.length = NFSIZE;
+    freqIndVS.vectorLength = MOBSCOH;
+    freqIndVS.freqIndV = (UINT8FrequencyIndexVector *)LALCalloc(NFSIZE, sizeof(UINT8FrequencyIndexVector));
+
+    for (n=0; n< NFSIZE; ++n){
+      htV.ht[n].xSide = xSide;
+      htV.ht[n].ySide = ySide;
+      htV.ht[n].map = (HoughTT *)LALMalloc(xSide*ySide*sizeof(HoughTT));
+      freqIndVS.freqIndV[n].length = MOBSCOH;
+      freqIndVS.freqIndV[n].deltaF = DF;
+      freqIndVS.freqIndV[n].data = (UINT8 *)LALMalloc(MOBSCOH*sizeof(UINT8));
+      for (j=0;j< MOBSCOH;++j){
+        freqIndVS.freqIndV[n].data[j] = phmdVS.fBinMin + (n*j) % NFSIZE;
+      }
+    }
+
+    for (useWeights=0; useWeights<2; ++useWeights){
+      if (useWeights){
+        for(j=0; j<phmdVS.length * phmdVS.nfSize; ++j){
+          phmdVS.phmd[j].weight = 0.5 + 0.1*(j % 7);
+        }
+      }
+
+      if ( XLALHOUGHConstructHMTVector( &htV, &freqIndVS, &phmdVS, useWeights, 3 ) != XLAL_SUCCESS ) {
+        ERROR( TESTDRIVEHOUGHC_ESUB, TESTDRIVEHOUGHC_MSGESUB,
+               "Function call \"XLALHOUGHConstructHMTVector()\" failed:" );
+        return TESTDRIVEHOUGHC_ESUB;
+      }
+
+      for (n=0; n< NFSIZE; ++n){
+        if (useWeights){
+          SUB( LALHOUGHConstructHMT_W( &status, &ht, &(freqIndVS.freqIndV[n]), &phmdVS ), &status );
+        } else {
+          SUB( LALHOUGHConstructHMT( &status, &ht, &(freqIndVS.freqIndV[n]), &phmdVS ), &status );
+        }
+        for(i=0; i<(UINT4)(xSide*ySide); ++i){
+          if ( fabs( htV.ht[n].map[i] - ht.map[i] ) > 1e-10 * ( 1 + fabs( ht.map[i] ) ) ){
+            ERROR( TESTDRIVEHOUGHC_EMAP, TESTDRIVEHOUGHC_MSGEMAP, 0 );
+            return TESTDRIVEHOUGHC_EMAP;
+          }
+        }
+      }
+    }
+
+    for (n=0; n< NFSIZE; ++n){
+      LALFree(htV.ht[n].map);
+      LALFree(freqIndVS.freqIndV[n].data);
+    }
+    LALFree(htV.ht);
+    LALFree(freqIndVS.freqIndV);
+  }
+
+
   /******************************************************************/
   /* Free memory and exit */
   /******************************************************************/
@@ -210,6 +210,140 @@ main( void )
   XLALPrintError ("XLALBarycenter() 	%g s\n", tau / counter );
   XLALPrintError ("XLALBarycenterOpt()	%g s (= %.1f %%)\n", tau_opt / counter,  - 100 * (tau - tau_opt ) / tau );
 
+  /* ===== test XLALBarycenterBatch() against XLALBarycenter() ===== */
+  XLALPrintInfo("\n\nTesting XLALBarycenterBatch() ... ");
+  {
+    const UINT4 numTimes = 100, numSky = 30;
+    BarycenterBatch *batch = XLALCreateBarycenterBatch ( &baryinput.site, numTimes );
+    XLAL_CHECK_MAIN ( batch != NULL, XLAL_EFUNC );
+    LIGOTimeGPS *tgps = XLALCalloc ( numTimes, sizeof(tgps[0]) );
+    EarthState *earths = XLALCalloc ( numTimes, sizeof(earths[0]) );
+    REAL8 *alpha = XLALCalloc ( numSky, sizeof(alpha[0]) );
+    REAL8 *delta = XLALCalloc ( numSky, sizeof(delta[0]) );
+    LIGOTimeGPS *te = XLALCalloc ( numSky * numTimes, sizeof(te[0]) );
+    REAL8 *tDot = XLALCalloc ( numSky * numTimes, sizeof(tDot[0]) );
+    XLAL_CHECK_MAIN ( tgps != NULL && earths != NULL && alpha != NULL && delta != NULL && te != NULL && tDot != NULL, XLAL_ENOMEM );
+    for ( UINT4 i = 0; i < numTimes; i++ )
+      {
+        XLALGPSSetREAL8( &tgps[i], t1998 + ( 1.0 * rand() / RAND_MAX ) * LAL_YRSID_SI );
+        XLAL_CHECK_MAIN ( XLALBarycenterEarth ( &earths[i], &tgps[i], edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK_MAIN ( XLALSetBarycenterBatchTime ( batch, i, &tgps[i], &earths[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+    for ( UINT4 k = 0; k < numSky; k++ )
+      {
+        alpha[k] = ( 1.0 * rand() / RAND_MAX ) * LAL_TWOPI;
+        delta[k] = ( 1.0 * rand() / RAND_MAX ) * LAL_PI - LAL_PI_2;
+      }
+    XLAL_CHECK_MAIN ( XLALBarycenterBatch ( te, tDot, batch, alpha, delta, 0, numSky ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    REAL8 maxDiffTe = 0, maxDiffTDot = 0;
+    for ( UINT4 k = 0; k < numSky; k++ )
+      {
+        baryinput.alpha = alpha[k];
+        baryinput.delta = delta[k];
+        baryinput.dInv = 0;
+        for ( UINT4 i = 0; i < numTimes; i++ )
+          {
+            baryinput.tgps = tgps[i];
+            XLAL_CHECK_MAIN ( XLALBarycenter ( &emit, &baryinput, &earths[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+            maxDiffTe = fmax ( maxDiffTe, fabs ( XLALGPSDiff ( &emit.te, &te[k*numTimes + i] ) ) );
+            maxDiffTDot = fmax ( maxDiffTDot, fabs ( emit.tDot - tDot[k*numTimes + i] ) );
+          }
+      }
+    XLALPrintInfo ( "Max error between XLALBarycenter() and XLALBarycenterBatch(): te = %g s, tDot = %g (tolerance = %g)\n", maxDiffTe, maxDiffTDot, tolerance );
+    XLAL_CHECK_MAIN ( maxDiffTe < tolerance && maxDiffTDot < tolerance, XLAL_EFAILED,
+                      "Max error between XLALBarycenter() and XLALBarycenterBatch(): te = %g s, tDot = %g, exceeding tolerance of %g\n",
+                      maxDiffTe, maxDiffTDot, tolerance );
+
+    XLALDestroyBarycenterBatch ( batch );
+    XLALFree ( tgps );
+    XLALFree ( earths );
+    XLALFree ( alpha );
+    XLALFree ( delta );
+    XLALFree ( te );
+    XLALFree ( tDot );
+  }
+  XLALPrintInfo ("OK.\n");
+
+  /* ===== test binary ephemeris files ===== */
+  XLALPrintInfo("\n\nTesting binary ephemeris files ... ");
+  {
+    /* tables are read back exactly, Chebyshev polynomials within tolerance */
+    const UINT4 numCoeffs[2] = { 0, 16 };
+    const REAL8 posTolerance[2] = { 0, 1e-9 }, velTolerance[2] = { 0, 1e-14 };
+    for ( UINT4 n = 0; n < 2; ++n ) {
+      const char *eEphFileBin = "LALBarycenterTest_earth.bin", *sEphFileBin = "LALBarycenterTest_sun.bin";
+      XLAL_CHECK_MAIN ( XLALWriteEphemerisBinaryFile ( eEphFileBin, edat, 0, numCoeffs[n], 16 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( XLALWriteEphemerisBinaryFile ( sEphFileBin, edat, 1, numCoeffs[n], 16 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      EphemerisData *edat_bin = XLALInitBarycenter ( eEphFileBin, sEphFileBin );
+      XLAL_CHECK_MAIN ( edat_bin != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( edat_bin->nentriesE == edat->nentriesE && edat_bin->nentriesS == edat->nentriesS && edat_bin->etype == edat->etype, XLAL_EFAILED );
+
+      REAL8 maxDiffPos = 0, maxDiffVel = 0;
+      for ( UINT4 i = 0; i < 1000; i++ )
+        {
+          EarthState earth_bin;
+          XLALGPSSetREAL8( &tGPS, t1998 + ( 1.0 * rand() / RAND_MAX ) * LAL_YRSID_SI );
+          XLAL_CHECK_MAIN ( XLALBarycenterEarth ( &earth, &tGPS, edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLAL_CHECK_MAIN ( XLALBarycenterEarth ( &earth_bin, &tGPS, edat_bin ) == XLAL_SUCCESS, XLAL_EFUNC );
+          for ( UINT4 a = 0; a < 3; a++ )
+            {
+              maxDiffPos = fmax ( maxDiffPos, fabs ( earth.posNow[a] - earth_bin.posNow[a] ) );
+              maxDiffVel = fmax ( maxDiffVel, fabs ( earth.velNow[a] - earth_bin.velNow[a] ) );
+            }
+        }
+      XLALPrintInfo ( "Max error with %u Chebyshev coefficients: position = %g s, velocity = %g\n", numCoeffs[n], maxDiffPos, maxDiffVel );
+      XLAL_CHECK_MAIN ( maxDiffPos <= posTolerance[n] && maxDiffVel <= velTolerance[n], XLAL_EFAILED,
+                        "Max error with %u Chebyshev coefficients: position = %g s, velocity = %g, exceeding tolerance of %g s, %g\n",
+                        numCoeffs[n], maxDiffPos, maxDiffVel, posTolerance[n], velTolerance[n] );
+
+      /* binary ephemerides can be restricted like any other */
+      LIGOTimeGPS startGPS = { t1998 + 86400, 0 }, endGPS = { t1998 + 10*86400, 0 };
+      XLAL_CHECK_MAIN ( XLALRestrictEphemerisData ( edat_bin, &startGPS, &endGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( edat_bin->nentriesE < edat->nentriesE && edat_bin->nentriesS < edat->nentriesS, XLAL_EFAILED );
+
+      XLALDestroyEphemerisData ( edat_bin );
+    }
+
+    /* binary files must contain the expected body */
+    XLAL_CHECK_MAIN ( XLALWriteEphemerisBinaryFile ( "LALBarycenterTest_sun.bin", edat, 1, 0, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    EphemerisData *edat_bad = XLALInitBarycenter ( "LALBarycenterTest_sun.bin", sEphFile );
+    XLAL_CHECK_MAIN ( edat_bad == NULL, XLAL_EFAILED, "Expected XLALInitBarycenter() to fail for Sun ephemeris given as Earth ephemeris!" );
+    XLALClearErrno();
+  }
+  XLALPrintInfo ("OK.\n");
+
+  /* ===== test binary time correction files ===== */
+  XLALPrintInfo("\n\nTesting binary time correction files ... ");
+  {
+    /* time corrections are stored as tables, so are read back exactly */
+    const char *tcFiles[2] = { TEST_PKG_DATA_DIR "tdb_2000-2019.dat.gz", TEST_PKG_DATA_DIR "te405_2000-2019.dat.gz" };
+    const char *tcFileBin = "LALBarycenterTest_timecorr.bin";
+    for ( UINT4 n = 0; n < 2; ++n ) {
+      TimeCorrectionData *tdat = XLALInitTimeCorrections ( tcFiles[n] );
+      XLAL_CHECK_MAIN ( tdat != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( XLALWriteTimeCorrectionBinaryFile ( tcFileBin, tdat ) == XLAL_SUCCESS, XLAL_EFUNC );
+      TimeCorrectionData *tdat_bin = XLALInitTimeCorrections ( tcFileBin );
+      XLAL_CHECK_MAIN ( tdat_bin != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( tdat_bin->nentriesT == tdat->nentriesT && tdat_bin->dtTtable == tdat->dtTtable && tdat_bin->timeCorrStart == tdat->timeCorrStart, XLAL_EFAILED,
+                        "Binary copy of '%s' has %u entries from %.9f every %g s, expected %u entries from %.9f every %g s\n", tcFiles[n],
+                        tdat_bin->nentriesT, tdat_bin->timeCorrStart, tdat_bin->dtTtable, tdat->nentriesT, tdat->timeCorrStart, tdat->dtTtable );
+      XLAL_CHECK_MAIN ( memcmp ( tdat_bin->timeCorrs, tdat->timeCorrs, tdat->nentriesT * sizeof(tdat->timeCorrs[0]) ) == 0, XLAL_EFAILED,
+                        "Binary copy of '%s' has different time corrections\n", tcFiles[n] );
+      XLALDestroyTimeCorrectionData ( tdat_bin );
+      XLALDestroyTimeCorrectionData ( tdat );
+    }
+
+    /* binary files must contain the expected data */
+    TimeCorrectionData *tdat_bad = XLALInitTimeCorrections ( "LALBarycenterTest_earth.bin" );
+    XLAL_CHECK_MAIN ( tdat_bad == NULL, XLAL_EFAILED, "Expected XLALInitTimeCorrections() to fail for an Earth ephemeris!" );
+    XLALClearErrno();
+    EphemerisData *edat_bad = XLALInitBarycenter ( tcFileBin, sEphFile );
+    XLAL_CHECK_MAIN ( edat_bad == NULL, XLAL_EFAILED, "Expected XLALInitBarycenter() to fail for time corrections given as Earth ephemeris!" );
+    XLALClearErrno();
+  }
+  XLALPrintInfo ("OK.\n");
+
   /* ===== test XLALRestrictEphemerisData() ===== */
   XLALPrintInfo("\n\nTesting XLALRestrictEphemerisData() ... ");
   {
@@ -171,6 +171,121 @@ static int SerialisationTest(
 
 }
 
+static int BlocksTest(
+  const LatticeTiling *tiling,
+  const size_t itr_ndim,
+  const gsl_matrix *points
+  )
+{
+
+  printf( "  Testing XLALCreateLatticeTilingBlocks() ..." );
+
+  const size_t n = XLALTotalLatticeTilingDimensions( tiling );
+  const UINT8 total = points->size2;
+
+  // Partition lattice tiling into blocks
+  LatticeTilingBlocks *blocks = XLALCreateLatticeTilingBlocks( tiling, itr_ndim, 5 );
+  XLAL_CHECK( blocks != NULL, XLAL_EFUNC );
+  const UINT4 nblocks = XLALLatticeTilingBlockCount( blocks );
+  XLAL_CHECK( 0 < nblocks && nblocks <= 5, XLAL_EFAILED, "nblocks = %u", nblocks );
+
+  // Claim blocks with 3 workers, but have only worker 0 iterate, so that it must steal blocks
+  // from the other workers; every point must be visited once, with the same index as in 'points'
+  XLAL_CHECK( XLALAssignLatticeTilingBlocks( blocks, 3 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  gsl_vector *GAVEC( point, n );
+  UINT8 total_blocks = 0;
+  UINT4 block = 0;
+  BOOLEAN started = 0;
+  int retn;
+  while ( ( retn = XLALNextLatticeTilingBlock( blocks, 0, &block, &started ) ) > 0 ) {
+    XLAL_CHECK( !started, XLAL_EFAILED );
+    LatticeTilingIterator *itr = XLALCreateLatticeTilingBlockIterator( blocks, block );
+    XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+    UINT8 count = 0;
+    while ( ( retn = XLALNextLatticeTilingPoint( itr, point ) ) > 0 ) {
+      const UINT8 k = XLALCurrentLatticeTilingIndex( itr );
+      XLAL_CHECK( k < total, XLAL_EFAILED, "k = %" LAL_UINT8_FORMAT " >= %" LAL_UINT8_FORMAT " = total", k, total );
+      gsl_vector_const_view points_k_view = gsl_matrix_const_column( points, k );
+      gsl_vector_sub( point, &points_k_view.vector );
+      double err = gsl_blas_dasum( point ) / n;
+      XLAL_CHECK( err < 1e-6, XLAL_EFAILED, "err = %e < 1e-6", err );
+      ++count;
+    }
+    XLAL_CHECK( retn == 0, XLAL_EFUNC );
+    XLAL_CHECK( count == XLALLatticeTilingBlockPoints( blocks, block ), XLAL_EFAILED, "block #%u: count = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT, block, count, XLALLatticeTilingBlockPoints( blocks, block ) );
+    XLAL_CHECK( XLALFinishLatticeTilingBlock( blocks, block ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyLatticeTilingIterator( itr );
+    total_blocks += count;
+  }
+  XLAL_CHECK( retn == 0, XLAL_EFUNC );
+  XLAL_CHECK( total_blocks == total, XLAL_EFAILED, "total_blocks = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = total", total_blocks, total );
+  for ( UINT4 w = 0; w < 3; ++w ) {
+    XLAL_CHECK( XLALNextLatticeTilingBlock( blocks, w, &block, &started ) == 0, XLAL_EFUNC );
+  }
+
+#if defined(HAVE_LIBCFITSIO)
+
+  // Claim and partially iterate over the first block, then checkpoint block partition and iterator
+  XLALDestroyLatticeTilingBlocks( blocks );
+  blocks = XLALCreateLatticeTilingBlocks( tiling, itr_ndim, 5 );
+  XLAL_CHECK( blocks != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALNextLatticeTilingBlock( blocks, 0, &block, &started ) > 0, XLAL_EFUNC );
+  XLAL_CHECK( block == 0 && !started, XLAL_EFAILED );
+  {
+    LatticeTilingIterator *itr = XLALCreateLatticeTilingBlockIterator( blocks, block );
+    XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALNextLatticeTilingPoint( itr, NULL ) > 0, XLAL_EFUNC );
+    FITSFile *file = XLALFITSFileOpenWrite( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALSaveLatticeTilingBlocks( blocks, file, "blocks" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSaveLatticeTilingIterator( itr, file, "itr_block_0" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALFITSFileClose( file );
+    XLALDestroyLatticeTilingIterator( itr );
+  }
+
+  // Restore block partition and rebalance over 2 workers; the partially-iterated block must be
+  // claimed again, and its iterator restored to continue after the first point
+  XLALDestroyLatticeTilingBlocks( blocks );
+  blocks = XLALCreateLatticeTilingBlocks( tiling, itr_ndim, 5 );
+  XLAL_CHECK( blocks != NULL, XLAL_EFUNC );
+  {
+    FITSFile *file = XLALFITSFileOpenRead( "LatticeTilingTest.fits" );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALRestoreLatticeTilingBlocks( blocks, file, "blocks" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALAssignLatticeTilingBlocks( blocks, 2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    total_blocks = 0;
+    while ( ( retn = XLALNextLatticeTilingBlock( blocks, 1, &block, &started ) ) > 0 ) {
+      XLAL_CHECK( !started == ( block != 0 ), XLAL_EFAILED, "block #%u: started = %i", block, started );
+      LatticeTilingIterator *itr = XLALCreateLatticeTilingBlockIterator( blocks, block );
+      XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+      if ( started ) {
+        XLAL_CHECK( XLALRestoreLatticeTilingIterator( itr, file, "itr_block_0" ) == XLAL_SUCCESS, XLAL_EFUNC );
+        ++total_blocks;
+      }
+      while ( ( retn = XLALNextLatticeTilingPoint( itr, NULL ) ) > 0 ) {
+        ++total_blocks;
+      }
+      XLAL_CHECK( retn == 0, XLAL_EFUNC );
+      XLAL_CHECK( XLALFinishLatticeTilingBlock( blocks, block ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALDestroyLatticeTilingIterator( itr );
+    }
+    XLAL_CHECK( retn == 0, XLAL_EFUNC );
+    XLAL_CHECK( total_blocks == total, XLAL_EFAILED, "restored total_blocks = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = total", total_blocks, total );
+    XLALFITSFileClose( file );
+  }
+
+#endif // defined(HAVE_LIBCFITSIO)
+
+  printf( " done\n" );
+
+  // Cleanup
+  XLALDestroyLatticeTilingBlocks( blocks );
+  GFVEC( point );
+
+  return XLAL_SUCCESS;
+
+}
+
 static int BasicTest(
   const size_t n,
   const int bound_on_0,
@@ -284,6 +399,9 @@ static int BasicTest(
       }
     }
 
+    // Check iteration over a block partition of the tiling
+    XLAL_CHECK( BlocksTest( tiling, i+1, points ) == XLAL_SUCCESS, XLAL_EFUNC );
+
     // Get nearest points to each template, check for consistency
     printf( "  Testing XLALNearestLatticeTiling{Point|Block}() ..." );
     gsl_vector *GAVEC( nearest, n );
@@ -0,0 +1,248 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \brief Tests for the SFT pair generator and cross-correlation statistic of PulsarCrossCorr_v2:
+ * the generated SFT pairs are compared to those of XLALCreateSFTPairIndexList(), and the
+ * cross-correlation statistic is compared to a direct sum over SFT pairs and frequency bins.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <math.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <lal/PulsarCrossCorr_v2.h>
+
+#define TSFT 1800.0
+#define NUM_BINS 3
+#define SFT_LENGTH 20
+
+static int ComparePairs ( const void *a, const void *b );
+static int TestPairGenerator ( const SFTIndexList *sftIndices, const MultiSFTVector *sfts, REAL8 maxLag, BOOLEAN inclAutoCorr, UINT4 blockLength );
+static REAL8 DirectCrossCorrStatistic ( const REAL8Vector *curlyGAmp, const COMPLEX8Vector *expSignalPhases, const UINT4Vector *lowestBins, const REAL8VectorSequence *sincList, const SFTPairIndexList *sftPairs, const SFTIndexList *sftIndices, const MultiSFTVector *sfts );
+
+int main(void)
+{
+
+  gsl_rng *rng = gsl_rng_alloc ( gsl_rng_mt19937 );
+  XLAL_CHECK_MAIN ( rng != NULL, XLAL_ENOMEM );
+
+  // Two detectors with interleaved SFTs, the second with a gap
+  UINT4 numSFTsPerDet[2] = { 40, 30 };
+  UINT4Vector numSFTsVec = { 2, numSFTsPerDet };
+  MultiSFTVector *sfts = XLALCreateMultiSFTVector ( SFT_LENGTH, &numSFTsVec );
+  XLAL_CHECK_MAIN ( sfts != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < sfts->length; ++X ) {
+    for ( UINT4 i = 0; i < sfts->data[X]->length; ++i ) {
+      SFTtype *sft = &sfts->data[X]->data[i];
+      sft->epoch.gpsSeconds = 800000000 + ( X == 0 ? i * TSFT : ( i + ( i >= 15 ? 5 : 0 ) ) * TSFT + 900 );
+      sft->f0 = 100;
+      sft->deltaF = 1.0 / TSFT;
+      for ( UINT4 k = 0; k < sft->data->length; ++k ) {
+        sft->data->data[k] = crectf ( gsl_ran_gaussian ( rng, 1.0 ), gsl_ran_gaussian ( rng, 1.0 ) );
+      }
+    }
+  }
+  SFTIndexList *sftIndices = NULL;
+  XLAL_CHECK_MAIN ( XLALCreateSFTIndexListFromMultiSFTVect ( &sftIndices, sfts ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const UINT4 numSFTs = sftIndices->length;
+
+  // SFT pair generator should yield the same pairs as XLALCreateSFTPairIndexList()
+  XLAL_CHECK_MAIN ( TestPairGenerator ( sftIndices, sfts, 0, 1, 7 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( TestPairGenerator ( sftIndices, sfts, 3 * TSFT, 0, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( TestPairGenerator ( sftIndices, sfts, 3 * TSFT, 1, 64 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( TestPairGenerator ( sftIndices, sfts, 200 * TSFT, 0, 1000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Random AM coefficients, signal phases, and sinc factors
+  MultiAMCoeffs *multiCoeffs = XLALCalloc ( 1, sizeof ( *multiCoeffs ) );
+  XLAL_CHECK_MAIN ( multiCoeffs != NULL, XLAL_ENOMEM );
+  multiCoeffs->length = sfts->length;
+  XLAL_CHECK_MAIN ( ( multiCoeffs->data = XLALCalloc ( sfts->length, sizeof ( *multiCoeffs->data ) ) ) != NULL, XLAL_ENOMEM );
+  for ( UINT4 X = 0; X < sfts->length; ++X ) {
+    XLAL_CHECK_MAIN ( ( multiCoeffs->data[X] = XLALCreateAMCoeffs ( sfts->data[X]->length ) ) != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < sfts->data[X]->length; ++i ) {
+      multiCoeffs->data[X]->a->data[i] = gsl_ran_flat ( rng, -1, 1 );
+      multiCoeffs->data[X]->b->data[i] = gsl_ran_flat ( rng, -1, 1 );
+    }
+  }
+  COMPLEX8Vector *expSignalPhases = XLALCreateCOMPLEX8Vector ( numSFTs );
+  UINT4Vector *lowestBins = XLALCreateUINT4Vector ( numSFTs );
+  REAL8VectorSequence *sincList = XLALCreateREAL8VectorSequence ( numSFTs, NUM_BINS );
+  XLAL_CHECK_MAIN ( expSignalPhases != NULL && lowestBins != NULL && sincList != NULL, XLAL_EFUNC );
+  for ( UINT4 s = 0; s < numSFTs; ++s ) {
+    const REAL8 phase = gsl_ran_flat ( rng, 0, LAL_TWOPI );
+    expSignalPhases->data[s] = crectf ( cos ( phase ), sin ( phase ) );
+    lowestBins->data[s] = gsl_rng_uniform_int ( rng, SFT_LENGTH - NUM_BINS + 1 );
+    for ( UINT4 j = 0; j < NUM_BINS; ++j ) {
+      sincList->data[s * NUM_BINS + j] = gsl_ran_flat ( rng, -0.5, 1 );
+    }
+  }
+  MultiNoiseWeights multiWeights = { .Sinv_Tsft = 2.5 };
+
+  // Cross-correlation statistic, from a list of SFT pairs and streamed, should match the direct sum
+  {
+    const REAL8 maxLag = 4 * TSFT;
+    SFTPairIndexList *sftPairs = NULL;
+    XLAL_CHECK_MAIN ( XLALCreateSFTPairIndexList ( &sftPairs, sftIndices, sfts, maxLag, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8Vector *GammaAve = NULL, *GammaCirc = NULL;
+    XLAL_CHECK_MAIN ( XLALCalculateCrossCorrGammas ( &GammaAve, &GammaCirc, sftPairs, sftIndices, multiCoeffs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    REAL8 ccStat = 0, evSquared = 0;
+    XLAL_CHECK_MAIN ( XLALCalculatePulsarCrossCorrStatistic ( &ccStat, &evSquared, GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, sfts, &multiWeights, NUM_BINS ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    REAL8 curlyGSqr = 0;
+    for ( UINT4 alpha = 0; alpha < sftPairs->length; ++alpha ) {
+      REAL8 sinc1Sqr = 0, sinc2Sqr = 0;
+      for ( UINT4 j = 0; j < NUM_BINS; ++j ) {
+        sinc1Sqr += pow ( sincList->data[sftPairs->data[alpha].sftNum[0] * NUM_BINS + j], 2 );
+        sinc2Sqr += pow ( sincList->data[sftPairs->data[alpha].sftNum[1] * NUM_BINS + j], 2 );
+      }
+      curlyGSqr += pow ( GammaAve->data[alpha], 2 ) * sinc1Sqr * sinc2Sqr;
+    }
+    const REAL8 evSquaredDirect = 8 * pow ( multiWeights.Sinv_Tsft, 2 ) * curlyGSqr;
+    const REAL8 ccStatDirect = 4 * multiWeights.Sinv_Tsft * DirectCrossCorrStatistic ( GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, sfts ) / sqrt ( evSquaredDirect );
+    XLAL_CHECK_MAIN ( fabs ( evSquared - evSquaredDirect ) <= 1e-10 * evSquaredDirect, XLAL_ETOL, "evSquared = %.15g != %.15g", evSquared, evSquaredDirect );
+    XLAL_CHECK_MAIN ( fabs ( ccStat - ccStatDirect ) <= 1e-5 * fabs ( ccStatDirect ), XLAL_ETOL, "ccStat = %.15g != %.15g", ccStat, ccStatDirect );
+
+    SFTPairGenerator *pairGenerator = XLALCreateSFTPairGenerator ( sftIndices, sfts, maxLag, 1 );
+    XLAL_CHECK_MAIN ( pairGenerator != NULL, XLAL_EFUNC );
+    REAL8 ccStatStreamed = 0, evSquaredStreamed = 0;
+    XLAL_CHECK_MAIN ( XLALCalculatePulsarCrossCorrStatisticStreamed ( &ccStatStreamed, &evSquaredStreamed, pairGenerator, 13, multiCoeffs, expSignalPhases, lowestBins, sincList, sftIndices, sfts, &multiWeights, NUM_BINS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( fabs ( evSquaredStreamed - evSquared ) <= 1e-10 * evSquared, XLAL_ETOL, "evSquared = %.15g != %.15g", evSquaredStreamed, evSquared );
+    XLAL_CHECK_MAIN ( fabs ( ccStatStreamed - ccStat ) <= 1e-10 * fabs ( ccStat ), XLAL_ETOL, "ccStat = %.15g != %.15g", ccStatStreamed, ccStat );
+
+    // Frequency bins off the end of an SFT should be an error
+    int errnum = 0;
+    lowestBins->data[5] = SFT_LENGTH - NUM_BINS + 1;
+    XLAL_TRY_SILENT ( XLALCalculatePulsarCrossCorrStatistic ( &ccStat, &evSquared, GammaAve, expSignalPhases, lowestBins, sincList, sftPairs, sftIndices, sfts, &multiWeights, NUM_BINS ), errnum );
+    XLAL_CHECK_MAIN ( errnum != 0, XLAL_EFAILED, "XLALCalculatePulsarCrossCorrStatistic() should have failed" );
+    XLAL_TRY_SILENT ( XLALCalculatePulsarCrossCorrStatisticStreamed ( &ccStat, &evSquared, pairGenerator, 13, multiCoeffs, expSignalPhases, lowestBins, sincList, sftIndices, sfts, &multiWeights, NUM_BINS ), errnum );
+    XLAL_CHECK_MAIN ( errnum != 0, XLAL_EFAILED, "XLALCalculatePulsarCrossCorrStatisticStreamed() should have failed" );
+
+    XLALDestroySFTPairGenerator ( pairGenerator );
+    XLALDestroyREAL8Vector ( GammaAve );
+    XLALDestroyREAL8Vector ( GammaCirc );
+    XLALDestroySFTPairIndexList ( sftPairs );
+  }
+
+  XLALDestroyCOMPLEX8Vector ( expSignalPhases );
+  XLALDestroyUINT4Vector ( lowestBins );
+  XLALDestroyREAL8VectorSequence ( sincList );
+  XLALDestroyMultiAMCoeffs ( multiCoeffs );
+  XLALDestroySFTIndexList ( sftIndices );
+  XLALDestroyMultiSFTVector ( sfts );
+  gsl_rng_free ( rng );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} // main()
+
+/// Order SFT pairs by their SFT indices
+static int
+ComparePairs ( const void *a, const void *b )
+{
+  const SFTPairIndex *pa = (const SFTPairIndex *) a;
+  const SFTPairIndex *pb = (const SFTPairIndex *) b;
+  for ( UINT4 i = 0; i < 2; ++i ) {
+    if ( pa->sftNum[i] != pb->sftNum[i] ) {
+      return ( pa->sftNum[i] < pb->sftNum[i] ) ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/// Compare the pairs yielded by an SFT pair generator in blocks with those of XLALCreateSFTPairIndexList()
+static int
+TestPairGenerator ( const SFTIndexList *sftIndices, const MultiSFTVector *sfts, REAL8 maxLag, BOOLEAN inclAutoCorr, UINT4 blockLength )
+{
+  SFTPairIndexList *sftPairs = NULL;
+  XLAL_CHECK ( XLALCreateSFTPairIndexList ( &sftPairs, (SFTIndexList *) sftIndices, (MultiSFTVector *) sfts, maxLag, inclAutoCorr ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  SFTPairGenerator *pairGenerator = XLALCreateSFTPairGenerator ( sftIndices, sfts, maxLag, inclAutoCorr );
+  XLAL_CHECK ( pairGenerator != NULL, XLAL_EFUNC );
+  const UINT4 numPairs = XLALSFTPairGeneratorNumPairs ( pairGenerator );
+  XLAL_CHECK ( numPairs == sftPairs->length, XLAL_EFAILED, "Generator has %u pairs, expected %u", numPairs, sftPairs->length );
+
+  SFTPairIndex *pairs = XLALCalloc ( numPairs + blockLength, sizeof ( *pairs ) );
+  XLAL_CHECK ( pairs != NULL, XLAL_ENOMEM );
+  SFTPairGeneratorCursor XLAL_INIT_DECL(cursor);
+  UINT4 n = 0;
+  REAL8 prevTime = -1;
+  while ( 1 ) {
+    SFTPairIndexList block = { 0, pairs + n };
+    XLAL_CHECK ( XLALNextSFTPairBlock ( &block, blockLength, &cursor, pairGenerator ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( block.length <= blockLength && n + block.length <= numPairs, XLAL_EFAILED );
+    if ( block.length == 0 ) {
+      break;
+    }
+    for ( UINT4 alpha = 0; alpha < block.length; ++alpha ) {
+      XLAL_CHECK ( block.data[alpha].sftNum[0] <= block.data[alpha].sftNum[1], XLAL_EFAILED );
+      // Pairs should be in order of the time of their earlier SFT
+      REAL8 time = LAL_REAL8_MAX;
+      for ( UINT4 i = 0; i < 2; ++i ) {
+        const SFTIndex *idx = &sftIndices->data[block.data[alpha].sftNum[i]];
+        time = fmin ( time, XLALGPSGetREAL8 ( &sfts->data[idx->detInd]->data[idx->sftInd].epoch ) );
+      }
+      XLAL_CHECK ( time >= prevTime, XLAL_EFAILED, "Pairs are not in time order" );
+      prevTime = time;
+    }
+    n += block.length;
+  }
+  XLAL_CHECK ( n == numPairs, XLAL_EFAILED, "Generated %u pairs, expected %u", n, numPairs );
+
+  qsort ( pairs, numPairs, sizeof ( pairs[0] ), ComparePairs );
+  qsort ( sftPairs->data, numPairs, sizeof ( sftPairs->data[0] ), ComparePairs );
+  for ( UINT4 alpha = 0; alpha < numPairs; ++alpha ) {
+    XLAL_CHECK ( ComparePairs ( &pairs[alpha], &sftPairs->data[alpha] ) == 0, XLAL_EFAILED, "Pair %u differs", alpha );
+  }
+
+  XLALFree ( pairs );
+  XLALDestroySFTPairGenerator ( pairGenerator );
+  XLALDestroySFTPairIndexList ( sftPairs );
+
+  return XLAL_SUCCESS;
+}
+
+/// Numerator of the cross-correlation statistic, summed directly over SFT pairs and frequency bins
+static REAL8
+DirectCrossCorrStatistic ( const REAL8Vector *curlyGAmp, const COMPLEX8Vector *expSignalPhases, const UINT4Vector *lowestBins, const REAL8VectorSequence *sincList, const SFTPairIndexList *sftPairs, const SFTIndexList *sftIndices, const MultiSFTVector *sfts )
+{
+  REAL8 nume = 0;
+  for ( UINT4 alpha = 0; alpha < sftPairs->length; ++alpha ) {
+    const UINT4 s1 = sftPairs->data[alpha].sftNum[0];
+    const UINT4 s2 = sftPairs->data[alpha].sftNum[1];
+    const COMPLEX8 *data1 = sfts->data[sftIndices->data[s1].detInd]->data[sftIndices->data[s1].sftInd].data->data;
+    const COMPLEX8 *data2 = sfts->data[sftIndices->data[s2].detInd]->data[sftIndices->data[s2].sftInd].data->data;
+    const COMPLEX16 GalphaCC = curlyGAmp->data[alpha] * expSignalPhases->data[s1] * conj ( expSignalPhases->data[s2] );
+    for ( UINT4 j = 0; j < NUM_BINS; ++j ) {
+      for ( UINT4 k = 0; k < NUM_BINS; ++k ) {
+        const UINT4 bin1 = lowestBins->data[s1] + j, bin2 = lowestBins->data[s2] + k;
+        const REAL8 ccSign = ( ( bin1 + bin2 ) % 2 == 0 ) ? 1 : -1;
+        const REAL8 sincFactor = sincList->data[s1 * NUM_BINS + j] * sincList->data[s2 * NUM_BINS + k];
+        nume += ccSign * sincFactor * creal ( GalphaCC * conj ( data1[bin1] ) * data2[bin2] );
+      }
+    }
+  }
+  return nume;
+}
@@ -0,0 +1,200 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \brief Tests for the SFTStream module: SFTs made from time-series data appended in uneven
+ * stretches are compared to SFTs made from the whole time series at once.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <math.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <lal/SFTStream.h>
+#include <lal/CWMakeFakeData.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+
+#define FSAMP 256.0
+#define TSFT 16.0
+
+static REAL8TimeSeries *RandomTimeSeries ( gsl_rng *rng, INT4 gpsSeconds, REAL8 duration );
+static SFTVector *StreamSFTs ( const SFTStreamParams *params, REAL8TimeSeries **segments, UINT4 numSegments, UINT4 chunkLength );
+static SFTVector *ReferenceSFTs ( const SFTStreamParams *params, const REAL8TimeSeries *segment );
+static int CompareSFTs ( const SFTVector *sfts1, UINT4 offset, const SFTVector *sfts2, REAL8 tol );
+
+int main(void)
+{
+
+  gsl_rng *rng = gsl_rng_alloc ( gsl_rng_mt19937 );
+  XLAL_CHECK_MAIN ( rng != NULL, XLAL_ENOMEM );
+
+  // Two segments of data separated by a gap
+  REAL8TimeSeries *segments[2];
+  XLAL_CHECK_MAIN ( ( segments[0] = RandomTimeSeries ( rng, 800000000, 200 ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( ( segments[1] = RandomTimeSeries ( rng, 800000237, 50 ) ) != NULL, XLAL_EFUNC );
+
+  SFTStreamParams XLAL_INIT_DECL(params);
+  params.Tsft = TSFT;
+  params.overlapFraction = 0.5;
+  params.fMin = 10;
+  params.Band = 50;
+  params.windowType = "hann";
+
+  // Without a high-pass filter, streamed SFTs should match SFTs of the whole segments
+  {
+    SFTVector *sfts = StreamSFTs ( &params, segments, 2, 1237 );
+    XLAL_CHECK_MAIN ( sfts != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( sfts->length == 24 + 5, XLAL_EFAILED, "Made %u SFTs, expected %u", sfts->length, 24 + 5 );
+    for ( UINT4 n = 0, offset = 0; n < 2; ++n ) {
+      SFTVector *ref = ReferenceSFTs ( &params, segments[n] );
+      XLAL_CHECK_MAIN ( ref != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( CompareSFTs ( sfts, offset, ref, 1e-5 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      offset += ref->length;
+      XLALDestroySFTVector ( ref );
+    }
+    XLALDestroySFTVector ( sfts );
+  }
+
+  // With a high-pass filter, streamed SFTs should match SFTs of the whole filtered segments,
+  // to within the effect of the finite filter settling time
+  params.highPass.nMax = 10;
+  params.highPass.f2 = 5;
+  params.highPass.a2 = 0.5;
+  params.highPass.f1 = -1;
+  params.highPass.a1 = -1;
+  params.settleTime = 8;
+  {
+    SFTVector *sfts = StreamSFTs ( &params, segments, 2, 999 );
+    XLAL_CHECK_MAIN ( sfts != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( sfts->length == 24 + 5, XLAL_EFAILED, "Made %u SFTs, expected %u", sfts->length, 24 + 5 );
+    for ( UINT4 n = 0, offset = 0; n < 2; ++n ) {
+      REAL8TimeSeries *filtered = XLALCutREAL8TimeSeries ( segments[n], 0, segments[n]->data->length );
+      XLAL_CHECK_MAIN ( filtered != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( XLALButterworthREAL8TimeSeries ( filtered, &params.highPass ) == XLAL_SUCCESS, XLAL_EFUNC );
+      SFTVector *ref = ReferenceSFTs ( &params, filtered );
+      XLAL_CHECK_MAIN ( ref != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( CompareSFTs ( sfts, offset, ref, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      offset += ref->length;
+      XLALDestroySFTVector ( ref );
+      XLALDestroyREAL8TimeSeries ( filtered );
+    }
+    XLALDestroySFTVector ( sfts );
+  }
+
+  XLALDestroyREAL8TimeSeries ( segments[0] );
+  XLALDestroyREAL8TimeSeries ( segments[1] );
+  gsl_rng_free ( rng );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} // main()
+
+/// Generate a time series of Gaussian noise
+static REAL8TimeSeries *
+RandomTimeSeries ( gsl_rng *rng, INT4 gpsSeconds, REAL8 duration )
+{
+  const LIGOTimeGPS epoch = { gpsSeconds, 0 };
+  REAL8TimeSeries *series = XLALCreateREAL8TimeSeries ( "H1:test", &epoch, 0, 1.0 / FSAMP, &lalDimensionlessUnit, (UINT4) round ( duration * FSAMP ) );
+  XLAL_CHECK_NULL ( series != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < series->data->length; ++i ) {
+    series->data->data[i] = gsl_ran_gaussian ( rng, 1.0 );
+  }
+  return series;
+}
+
+/// Make SFTs by appending segments to an SFT stream in chunks of a given length
+static SFTVector *
+StreamSFTs ( const SFTStreamParams *params, REAL8TimeSeries **segments, UINT4 numSegments, UINT4 chunkLength )
+{
+  SFTStream *stream = XLALCreateSFTStream ( params );
+  XLAL_CHECK_NULL ( stream != NULL, XLAL_EFUNC );
+  SFTVector *sfts = XLALCalloc ( 1, sizeof(*sfts) );
+  XLAL_CHECK_NULL ( sfts != NULL, XLAL_ENOMEM );
+  for ( UINT4 n = 0; n < numSegments; ++n ) {
+    for ( UINT4 first = 0; first < segments[n]->data->length; first += chunkLength ) {
+      const UINT4 length = ( first + chunkLength <= segments[n]->data->length ) ? chunkLength : segments[n]->data->length - first;
+      REAL8TimeSeries *chunk = XLALCutREAL8TimeSeries ( segments[n], first, length );
+      XLAL_CHECK_NULL ( chunk != NULL, XLAL_EFUNC );
+      SFTVector *newsfts = XLALSFTStreamAppend ( stream, chunk );
+      XLAL_CHECK_NULL ( newsfts != NULL, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < newsfts->length; ++i ) {
+        XLAL_CHECK_NULL ( XLALAppendSFT2Vector ( sfts, &newsfts->data[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+      XLALDestroySFTVector ( newsfts );
+      XLALDestroyREAL8TimeSeries ( chunk );
+    }
+  }
+  SFTVector *newsfts = XLALSFTStreamEndSegment ( stream );
+  XLAL_CHECK_NULL ( newsfts != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < newsfts->length; ++i ) {
+    XLAL_CHECK_NULL ( XLALAppendSFT2Vector ( sfts, &newsfts->data[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLALDestroySFTVector ( newsfts );
+  XLALDestroySFTStream ( stream );
+  return sfts;
+}
+
+/// Make SFTs from a whole segment with XLALMakeSFTsFromREAL8TimeSeries()
+static SFTVector *
+ReferenceSFTs ( const SFTStreamParams *params, const REAL8TimeSeries *segment )
+{
+  const REAL8 step = ( 1.0 - params->overlapFraction ) * params->Tsft;
+  const UINT4 numSFTs = (UINT4) floor ( ( segment->data->length * segment->deltaT - params->Tsft ) / step ) + 1;
+  LIGOTimeGPSVector *timestamps = XLALCreateTimestampVector ( numSFTs );
+  XLAL_CHECK_NULL ( timestamps != NULL, XLAL_EFUNC );
+  timestamps->deltaT = params->Tsft;
+  for ( UINT4 i = 0; i < numSFTs; ++i ) {
+    timestamps->data[i] = segment->epoch;
+    XLALGPSAdd ( &timestamps->data[i], i * step );
+  }
+  SFTVector *sfts = XLALMakeSFTsFromREAL8TimeSeries ( segment, timestamps, params->windowType, params->windowBeta );
+  XLAL_CHECK_NULL ( sfts != NULL, XLAL_EFUNC );
+  SFTVector *band = XLALExtractBandFromSFTVector ( sfts, params->fMin, params->Band );
+  XLAL_CHECK_NULL ( band != NULL, XLAL_EFUNC );
+  XLALDestroySFTVector ( sfts );
+  XLALDestroyTimestampVector ( timestamps );
+  return band;
+}
+
+/// Compare SFTs, starting at a given offset into the first vector
+static int
+CompareSFTs ( const SFTVector *sfts1, UINT4 offset, const SFTVector *sfts2, REAL8 tol )
+{
+  XLAL_CHECK ( offset + sfts2->length <= sfts1->length, XLAL_EFAILED );
+  for ( UINT4 i = 0; i < sfts2->length; ++i ) {
+    const SFTtype *sft1 = &sfts1->data[offset + i];
+    const SFTtype *sft2 = &sfts2->data[i];
+    XLAL_CHECK ( XLALGPSCmp ( &sft1->epoch, &sft2->epoch ) == 0, XLAL_EFAILED, "SFT %u: epoch %d != %d", offset + i, sft1->epoch.gpsSeconds, sft2->epoch.gpsSeconds );
+    XLAL_CHECK ( fabs ( sft1->f0 - sft2->f0 ) < 1e-9 && sft1->deltaF == sft2->deltaF, XLAL_EFAILED, "SFT %u: frequencies differ", offset + i );
+    XLAL_CHECK ( sft1->data->length == sft2->data->length, XLAL_EFAILED, "SFT %u: %u bins != %u", offset + i, sft1->data->length, sft2->data->length );
+    REAL8 maxabs = 0, maxerr = 0;
+    for ( UINT4 k = 0; k < sft2->data->length; ++k ) {
+      maxabs = fmax ( maxabs, cabs ( sft2->data->data[k] ) );
+      maxerr = fmax ( maxerr, cabs ( sft1->data->data[k] - sft2->data->data[k] ) );
+    }
+    XLAL_CHECK ( maxerr <= tol * maxabs, XLAL_ETOL, "SFT %u: maximum error %g exceeds %g", offset + i, maxerr, tol * maxabs );
+  }
+  return XLAL_SUCCESS;
+}
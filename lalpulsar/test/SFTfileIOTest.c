@@ -24,8 +24,12 @@
 #include <lal/LALStdio.h>
 #include <lal/SFTfileIO.h>
 #include <lal/SFTutils.h>
+#include <lal/NormalizeSFTRngMed.h>
 #include <lal/Units.h>
 
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
 /*---------- DEFINES ----------*/
 /**
  * \file
@@ -100,6 +104,97 @@ static int CompareSFTVectors(SFTVector *sft_vect, SFTVector *sft_vect2)
   return(0);
 }
 
+/* write an SFT noise file, and check that running medians, normalised SFTs and noise weights
+ * loaded from it agree with those computed from the SFTs, away from the edges of the loaded band */
+static int TestSFTNoiseFile(void);
+static int TestSFTNoiseFile(void)
+{
+  const CHAR *sftFile = "outputsftv2_noise.sft";
+  const UINT4 numSFTs = 4, numBins = 1200, blockSize = 51, lineSFT = 2, lineBin = 700;
+  const REAL8 Tsft = 60;
+
+  /* write SFTs of Gaussian noise, with a line in one bin of one SFT */
+  gsl_rng *rng = gsl_rng_alloc ( gsl_rng_mt19937 );
+  XLAL_CHECK ( rng != NULL, XLAL_ENOMEM );
+  SFTVector *sfts = XLALCreateSFTVector ( numSFTs, numBins );
+  XLAL_CHECK ( sfts != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < numSFTs; ++i ) {
+    SFTtype *sft = &sfts->data[i];
+    strcpy ( sft->name, "H1" );
+    sft->epoch.gpsSeconds = 800000000 + i * Tsft;
+    sft->f0 = 100;
+    sft->deltaF = 1.0 / Tsft;
+    for ( UINT4 k = 0; k < numBins; ++k ) {
+      sft->data->data[k] = crectf ( gsl_ran_gaussian ( rng, 1.0 ), gsl_ran_gaussian ( rng, 1.0 ) );
+    }
+  }
+  sfts->data[lineSFT].data->data[lineBin] *= 100;
+  XLAL_CHECK ( XLALWriteSFTVector2NamedFile ( sfts, sftFile, "SFT noise file test" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALDestroySFTVector ( sfts );
+  gsl_rng_free ( rng );
+
+  /* write SFT noise file */
+  XLAL_CHECK ( XLALWriteSFTNoiseFile ( sftFile, blockSize, 20 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* load SFTs in a band containing the line, and normalise them using the SFT noise file, or their own running medians */
+  const REAL8 fMin = 105, fMax = 113;
+  SFTCatalog *catalog = XLALSFTdataFind ( sftFile, NULL );
+  XLAL_CHECK ( catalog != NULL, XLAL_EFUNC );
+  MultiSFTVector *multiSFTs1 = XLALLoadMultiSFTs ( catalog, fMin, fMax );
+  XLAL_CHECK ( multiSFTs1 != NULL, XLAL_EFUNC );
+  MultiPSDVector *multiLineFlags = NULL;
+  MultiPSDVector *multiPSD1 = XLALLoadMultiSFTNoise ( catalog, multiSFTs1, blockSize, &multiLineFlags );
+  XLAL_CHECK ( multiPSD1 != NULL && multiLineFlags != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( XLALNormalizeMultiSFTVectByPSD ( multiSFTs1, multiPSD1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  MultiSFTVector *multiSFTs2 = XLALLoadMultiSFTs ( catalog, fMin, fMax );
+  XLAL_CHECK ( multiSFTs2 != NULL, XLAL_EFUNC );
+  MultiPSDVector *multiPSD2 = XLALNormalizeMultiSFTVect ( multiSFTs2, blockSize, NULL );
+  XLAL_CHECK ( multiPSD2 != NULL, XLAL_EFUNC );
+
+  /* compare away from the edges of the loaded band, where XLALNormalizeMultiSFTVect() extrapolates the running medians */
+  XLAL_CHECK ( multiSFTs1->length == 1 && multiSFTs1->data[0]->length == numSFTs, XLAL_EFAILED );
+  UINT4 numLines = 0;
+  for ( UINT4 i = 0; i < numSFTs; ++i ) {
+    const SFTtype *sft1 = &multiSFTs1->data[0]->data[i], *sft2 = &multiSFTs2->data[0]->data[i];
+    const REAL8FrequencySeries *rngmed1 = &multiPSD1->data[0]->data[i], *rngmed2 = &multiPSD2->data[0]->data[i];
+    const UINT4 length = sft1->data->length;
+    XLAL_CHECK ( rngmed1->data->length == length && XLALGPSCmp ( &rngmed1->epoch, &sft1->epoch ) == 0 && rngmed1->f0 == sft1->f0, XLAL_EFAILED );
+    for ( UINT4 k = blockSize / 2; k + blockSize / 2 < length; ++k ) {
+      XLAL_CHECK ( rngmed1->data->data[k] == rngmed2->data->data[k], XLAL_EFAILED, "SFT %u bin %u: running median %g != %g", i, k, rngmed1->data->data[k], rngmed2->data->data[k] );
+      XLAL_CHECK ( sft1->data->data[k] == sft2->data->data[k], XLAL_EFAILED, "SFT %u bin %u: normalised SFTs differ", i, k );
+    }
+    for ( UINT4 k = 0; k < length; ++k ) {
+      if ( multiLineFlags->data[0]->data[i].data->data[k] != 0 ) {
+        ++numLines;
+        XLAL_CHECK ( i == lineSFT && lround ( sft1->f0 / sft1->deltaF ) + k == lround ( 100 * Tsft ) + lineBin, XLAL_EFAILED, "SFT %u bin %u wrongly flagged as a line", i, k );
+      }
+    }
+  }
+  XLAL_CHECK ( numLines == 1, XLAL_EFAILED, "Line was not flagged" );
+  MultiNoiseWeights *multiWeights1 = XLALComputeMultiNoiseWeights ( multiPSD1, blockSize, 0 );
+  XLAL_CHECK ( multiWeights1 != NULL, XLAL_EFUNC );
+  MultiNoiseWeights *multiWeights2 = XLALComputeMultiNoiseWeights ( multiPSD2, blockSize, 0 );
+  XLAL_CHECK ( multiWeights2 != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( multiWeights1->Sinv_Tsft == multiWeights2->Sinv_Tsft, XLAL_EFAILED, "Noise weight normalisations differ" );
+  for ( UINT4 i = 0; i < numSFTs; ++i ) {
+    XLAL_CHECK ( multiWeights1->data[0]->data[i] == multiWeights2->data[0]->data[i], XLAL_EFAILED, "SFT %u: noise weights differ", i );
+  }
+
+  /* noise file must have been written with the same running median window */
+  XLAL_CHECK ( XLALLoadMultiSFTNoise ( catalog, multiSFTs1, blockSize + 2, NULL ) == NULL, XLAL_EFAILED ); XLALClearErrno();
+
+  XLALDestroyMultiNoiseWeights ( multiWeights1 );
+  XLALDestroyMultiNoiseWeights ( multiWeights2 );
+  XLALDestroyMultiPSDVector ( multiPSD1 );
+  XLALDestroyMultiPSDVector ( multiPSD2 );
+  XLALDestroyMultiPSDVector ( multiLineFlags );
+  XLALDestroyMultiSFTVector ( multiSFTs1 );
+  XLALDestroyMultiSFTVector ( multiSFTs2 );
+  XLALDestroySFTCatalog ( catalog );
+
+  return XLAL_SUCCESS;
+}
+
 int main( void )
 {
   const char *fn = __func__;
@@ -367,6 +462,9 @@ int main( void )
     XLALDestroyTimestampVector ( ts3 );
   }
 
+  /* ---------- test SFT noise files ---------- */
+  XLAL_CHECK_MAIN ( TestSFTNoiseFile() == XLAL_SUCCESS, XLAL_EFUNC );
+
   /* ------------------------------ */
   LALCheckMemoryLeaks();
 
@@ -0,0 +1,206 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \brief Test XLALComputeTransientFstatMap() and XLALmergeMultiFstatAtomsBinned() against
+ * direct sums of F-stat atoms over each transient window, for gapped multi-detector atoms.
+ */
+#include <math.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/TransientCW_utils.h>
+
+#define TATOM 1800
+#define TSTART 800000000
+#define NUM_BINS 40
+#define TOLERANCE 1e-4
+
+/* Atoms of each detector exist in all bins in [first, last] except [gap_first, gap_last] */
+static const struct {
+  UINT4 first, last, gap_first, gap_last;
+} detectors[] = {
+  { 0, 37, 20, 22 },
+  { 3, 39, 20, 23 },
+};
+
+/* Direct F-stat of all atoms within the window [t0, t1] of a given type and timescale tau */
+static REAL8
+direct_transient_F ( const MultiFstatAtomVector *multiAtoms, transientWindowType_t type, UINT4 t0, UINT4 tau )
+{
+  transientWindow_t win = { .type = type, .t0 = t0, .tau = tau };
+  UINT4 win_t0, win_t1;
+  XLAL_CHECK_REAL8 ( XLALGetTransientWindowTimespan ( &win_t0, &win_t1, win ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  REAL8 A = 0, B = 0, C = 0;
+  COMPLEX16 Fa = 0, Fb = 0;
+  for ( UINT4 X = 0; X < multiAtoms->length; ++X ) {
+    for ( UINT4 i = 0; i < multiAtoms->data[X]->length; ++i ) {
+      const FstatAtom *atom = &multiAtoms->data[X]->data[i];
+      /* an atom contributes if all of its timespan lies within the window */
+      if ( atom->timestamp < win_t0 || atom->timestamp + TATOM > win_t1 ) {
+        continue;
+      }
+      const REAL8 w = ( type == TRANSIENT_EXPONENTIAL ) ? exp ( - 1.0 * ( atom->timestamp - win_t0 ) / tau ) : 1.0;
+      A += w * w * atom->a2_alpha;
+      B += w * w * atom->b2_alpha;
+      C += w * w * atom->ab_alpha;
+      Fa += w * atom->Fa_alpha;
+      Fb += w * atom->Fb_alpha;
+    }
+  }
+
+  const REAL4 Dd = XLALComputeAntennaPatternSqrtDeterminant ( A, B, C, 0 );
+  const REAL8 twoF = 2.0 / Dd * ( B * ( creal(Fa) * creal(Fa) + cimag(Fa) * cimag(Fa) )
+                                  + A * ( creal(Fb) * creal(Fb) + cimag(Fb) * cimag(Fb) )
+                                  - 2.0 * C * ( creal(Fa) * creal(Fb) + cimag(Fa) * cimag(Fb) ) );
+  return 0.5 * twoF;
+}
+
+static int
+test_merge_atoms ( const MultiFstatAtomVector *multiAtoms )
+{
+  FstatAtomVector *atoms = XLALmergeMultiFstatAtomsBinned ( multiAtoms, TATOM );
+  XLAL_CHECK ( atoms != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( atoms->length == NUM_BINS && atoms->TAtom == TATOM, XLAL_EFAILED, "Merged atoms have length %u, TAtom %u", atoms->length, atoms->TAtom );
+
+  for ( UINT4 j = 0; j < NUM_BINS; ++j ) {
+    const UINT4 t_j = TSTART + j * TATOM;
+    REAL8 a2 = 0, b2 = 0, ab = 0;
+    COMPLEX16 Fa = 0, Fb = 0;
+    UINT4 count = 0;
+    for ( UINT4 X = 0; X < multiAtoms->length; ++X ) {
+      for ( UINT4 i = 0; i < multiAtoms->data[X]->length; ++i ) {
+        const FstatAtom *atom = &multiAtoms->data[X]->data[i];
+        if ( atom->timestamp == t_j ) {
+          a2 += atom->a2_alpha;
+          b2 += atom->b2_alpha;
+          ab += atom->ab_alpha;
+          Fa += atom->Fa_alpha;
+          Fb += atom->Fb_alpha;
+          ++count;
+        }
+      }
+    }
+    const FstatAtom *atom = &atoms->data[j];
+    XLAL_CHECK ( atom->timestamp == ( count > 0 ? t_j : 0 ), XLAL_EFAILED, "Merged atom %u has timestamp %u, expected %u", j, atom->timestamp, count > 0 ? t_j : 0 );
+    XLAL_CHECK ( fabs ( atom->a2_alpha - a2 ) <= TOLERANCE && fabs ( atom->b2_alpha - b2 ) <= TOLERANCE && fabs ( atom->ab_alpha - ab ) <= TOLERANCE
+                 && cabs ( atom->Fa_alpha - Fa ) <= TOLERANCE && cabs ( atom->Fb_alpha - Fb ) <= TOLERANCE, XLAL_EFAILED, "Merged atom %u differs from sum of atoms", j );
+  }
+
+  XLALDestroyFstatAtomVector ( atoms );
+
+  return XLAL_SUCCESS;
+}
+
+static int
+test_transient_map ( const MultiFstatAtomVector *multiAtoms, transientWindowType_t type )
+{
+  transientWindowRange_t XLAL_INIT_DECL(windowRange);
+  windowRange.type = type;
+  windowRange.t0 = TSTART;
+  windowRange.t0Band = 24 * TATOM;
+  windowRange.dt0 = TATOM;
+  windowRange.tau = 4 * TATOM;
+  windowRange.tauBand = 12 * TATOM;
+  windowRange.dtau = 2 * TATOM;
+
+  transientFstatMap_t *FstatMap = XLALComputeTransientFstatMap ( multiAtoms, windowRange, 0 );
+  XLAL_CHECK ( FstatMap != NULL, XLAL_EFUNC );
+  const UINT4 N_t0Range = windowRange.t0Band / windowRange.dt0 + 1;
+  const UINT4 N_tauRange = windowRange.tauBand / windowRange.dtau + 1;
+  XLAL_CHECK ( FstatMap->F_mn->size1 == N_t0Range && FstatMap->F_mn->size2 == N_tauRange, XLAL_EFAILED );
+
+  REAL8 maxF = -1, F_ML = -1;
+  REAL8 sum_eF = 0;
+  for ( UINT4 m = 0; m < N_t0Range; ++m ) {
+    for ( UINT4 n = 0; n < N_tauRange; ++n ) {
+      const UINT4 t0 = windowRange.t0 + m * windowRange.dt0;
+      const UINT4 tau = windowRange.tau + n * windowRange.dtau;
+      const REAL8 F = direct_transient_F ( multiAtoms, type, t0, tau );
+      XLAL_CHECK ( xlalErrno == 0, XLAL_EFUNC );
+      const REAL8 F_mn = gsl_matrix_get ( FstatMap->F_mn, m, n );
+      XLAL_CHECK ( fabs ( F_mn - F ) <= TOLERANCE * fmax ( 1, fabs ( F ) ), XLAL_EFAILED,
+                   "Window type %d, t0=%u, tau=%u: F_mn = %.6g differs from direct sum %.6g", type, t0, tau, F_mn, F );
+      if ( F > maxF ) {
+        maxF = F;
+      }
+      if ( t0 == FstatMap->t0_ML && tau == FstatMap->tau_ML ) {
+        F_ML = F;
+      }
+    }
+  }
+  XLAL_CHECK ( fabs ( FstatMap->maxF - maxF ) <= TOLERANCE * maxF, XLAL_EFAILED, "Window type %d: maxF = %.6g differs from %.6g", type, FstatMap->maxF, maxF );
+  XLAL_CHECK ( fabs ( F_ML - maxF ) <= TOLERANCE * maxF, XLAL_EFAILED, "Window type %d: F = %.6g at {t0_ML, tau_ML} is not the maximum %.6g", type, F_ML, maxF );
+
+  /* Bayes factor marginalised over the map */
+  for ( UINT4 m = 0; m < N_t0Range; ++m ) {
+    for ( UINT4 n = 0; n < N_tauRange; ++n ) {
+      sum_eF += exp ( direct_transient_F ( multiAtoms, type, windowRange.t0 + m * windowRange.dt0, windowRange.tau + n * windowRange.dtau ) - maxF );
+    }
+  }
+  const REAL8 logB = log ( 70.0 / ( N_t0Range * N_tauRange ) ) + maxF + log ( sum_eF );
+  const REAL8 logBstat = XLALComputeTransientBstat ( windowRange, FstatMap );
+  XLAL_CHECK ( xlalErrno == 0, XLAL_EFUNC );
+  XLAL_CHECK ( fabs ( logBstat - logB ) <= TOLERANCE * fmax ( 1, fabs ( logB ) ), XLAL_EFAILED, "Window type %d: logBstat = %.6g differs from %.6g", type, logBstat, logB );
+
+  XLALDestroyTransientFstatMap ( FstatMap );
+
+  return XLAL_SUCCESS;
+}
+
+int main ( void )
+{
+  gsl_rng *rng = gsl_rng_alloc ( gsl_rng_mt19937 );
+  XLAL_CHECK_MAIN ( rng != NULL, XLAL_ENOMEM );
+
+  /* random atoms of two detectors with different spans and gaps, on a common grid of bins */
+  MultiFstatAtomVector *multiAtoms = XLALCreateMultiFstatAtomVector ( XLAL_NUM_ELEM(detectors) );
+  XLAL_CHECK_MAIN ( multiAtoms != NULL, XLAL_EFUNC );
+  for ( UINT4 X = 0; X < multiAtoms->length; ++X ) {
+    const UINT4 numAtoms = detectors[X].last - detectors[X].first + 1 - ( detectors[X].gap_last - detectors[X].gap_first + 1 );
+    XLAL_CHECK_MAIN ( ( multiAtoms->data[X] = XLALCreateFstatAtomVector ( numAtoms ) ) != NULL, XLAL_EFUNC );
+    multiAtoms->data[X]->TAtom = TATOM;
+    for ( UINT4 j = detectors[X].first, i = 0; j <= detectors[X].last; ++j ) {
+      if ( detectors[X].gap_first <= j && j <= detectors[X].gap_last ) {
+        continue;
+      }
+      FstatAtom *atom = &multiAtoms->data[X]->data[i++];
+      atom->timestamp = TSTART + j * TATOM;
+      atom->a2_alpha = gsl_ran_flat ( rng, 0.5, 1.5 );
+      atom->b2_alpha = gsl_ran_flat ( rng, 0.5, 1.5 );
+      atom->ab_alpha = gsl_ran_flat ( rng, -0.3, 0.3 );
+      atom->Fa_alpha = crectf ( gsl_ran_gaussian ( rng, 1.0 ), gsl_ran_gaussian ( rng, 1.0 ) );
+      atom->Fb_alpha = crectf ( gsl_ran_gaussian ( rng, 1.0 ), gsl_ran_gaussian ( rng, 1.0 ) );
+    }
+  }
+
+  XLAL_CHECK_MAIN ( test_merge_atoms ( multiAtoms ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( test_transient_map ( multiAtoms, TRANSIENT_RECTANGULAR ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( test_transient_map ( multiAtoms, TRANSIENT_EXPONENTIAL ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyMultiFstatAtomVector ( multiAtoms );
+  gsl_rng_free ( rng );
+  XLALDestroyExpLUT();
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,592 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+/**
+ * @defgroup lalsim_bench lalsim-bench
+ * @ingroup lalsimulation_programs
+ *
+ * @brief Measures the performance of inspiral waveform approximants
+ *
+ * ### Synopsis
+ *
+ *     lalsim-bench [options]
+ *
+ * ### Description
+ *
+ * The `lalsim-bench` utility generates waveforms over a grid of masses and
+ * aligned spins for each of a list of approximants, in the time domain, the
+ * frequency domain, or both, and reports how long this took.  Each waveform
+ * is produced in the same four stages as `lalsim-inspiral` would use to
+ * produce data of the other domain:
+ *
+ *   1. *setup*: the data length is estimated from the chirp time and
+ *      rounded up to a power of two, and an FFT plan of that length is made;
+ *   2. *generate*: XLALSimInspiralChooseTDWaveform() or
+ *      XLALSimInspiralChooseFDWaveform() is called;
+ *   3. *condition*: a time-domain waveform is tapered and high-passed with
+ *      XLALSimInspiralTDConditionStage2() and resized to the data length;
+ *      a frequency-domain waveform is resized to the data length;
+ *   4. *fft*: the waveform is transformed to the other domain.
+ *
+ * One line of tab-separated values is written to the output for each
+ * approximant and domain giving the number of waveforms generated and the
+ * number that failed, the throughput in waveforms per second, the total time
+ * in seconds spent in each stage, and the peak memory usage of the process
+ * in MB so far.  The output of two runs with the same options can therefore
+ * be compared line by line, e.g. before and after a code change.
+ *
+ * ### Options
+ * [default values in brackets]
+ *
+ * <DL>
+ * <DT>`-h`, `--help`
+ * <DD>print a help message and exit</DD>
+ * <DT>`-v`, `--verbose`
+ * <DD>verbose output</DD>
+ * <DT>`-a` APPROX[,APPROX...], `--approximants=`APPROX[,APPROX...]
+ * <DD>comma-separated list of approximants [TaylorF2,IMRPhenomD]</DD>
+ * <DT>`-D` DOMAIN, `--domain=`DOMAIN
+ * <DD>domain of generation {"time", "freq", "both"}; approximants are only
+ * run in domains they implement [both]</DD>
+ * <DT>`-M` MIN:MAX:N, `--mass1=`MIN:MAX:N
+ * <DD>grid of primary masses in solar masses [10:50:3]</DD>
+ * <DT>`-q` MIN:MAX:N, `--mass-ratio=`MIN:MAX:N
+ * <DD>grid of mass ratios m2/m1 [0.25:1:2]</DD>
+ * <DT>`-Z` MIN:MAX:N, `--spinz=`MIN:MAX:N
+ * <DD>grid of aligned dimensionless spins of both bodies [0:0:1]</DD>
+ * <DT>`-X` S1X, `--spin1x=`S1X
+ * <DD>in-plane dimensionless spin of primary, for precessing approximants [0]</DD>
+ * <DT>`-f` FMIN, `--f-min=`FMIN
+ * <DD>frequency to start waveform in Hertz [20]</DD>
+ * <DT>`-R` SRATE, `--sample-rate=`SRATE
+ * <DD>sample rate in Hertz [4096]</DD>
+ * <DT>`-n` NREPEAT, `--repeat=`NREPEAT
+ * <DD>number of times each grid point is generated [1]</DD>
+ * <DT>`-o` FILE, `--output=`FILE
+ * <DD>file to write the results to [standard output]</DD>
+ * </DL>
+ *
+ * ### Environment
+ *
+ * The `LAL_DEBUG_LEVEL` can used to control the error and warning reporting of
+ * `lalsim-bench`.  Common values are: `LAL_DEBUG_LEVEL=0` which suppresses
+ * error messages, `LAL_DEBUG_LEVEL=1`  which prints error messages alone,
+ * `LAL_DEBUG_LEVEL=3` which prints both error messages and warning messages,
+ * and `LAL_DEBUG_LEVEL=7` which additionally prints informational messages.
+ * Waveforms that fail to generate are counted but do not stop the benchmark.
+ *
+ * ### Exit Status
+ *
+ * The `lalsim-bench` utility exits 0 on success, and >0 if an error occurs.
+ *
+ * ### Example
+ *
+ * The command:
+ *
+ *     lalsim-bench -a IMRPhenomXPHM,SEOBNRv4P -D both -M 10:60:6 -X 0.5 -o before.dat
+ *
+ * times 6 x 2 x 1 waveforms for each of the two approximants in each of the
+ * domains they support and writes the results to `before.dat`.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALgetopt.h>
+#include <lal/LALString.h>
+#include <lal/LALConstants.h>
+#include <lal/LogPrintf.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/TimeFreqFFT.h>
+#include <lal/LALSimInspiral.h>
+
+/* default values of parameters */
+#define DEFAULT_APPROXIMANTS "TaylorF2,IMRPhenomD"
+#define DEFAULT_MASS1 "10:50:3"
+#define DEFAULT_MASS_RATIO "0.25:1:2"
+#define DEFAULT_SPINZ "0:0:1"
+#define DEFAULT_S1X 0.0
+#define DEFAULT_F_MIN 20.0
+#define DEFAULT_SRATE 4096.0
+#define DEFAULT_DISTANCE 100.0
+#define DEFAULT_NREPEAT 1
+
+/* a linearly spaced grid of values */
+struct grid {
+    double min;
+    double max;
+    int n;
+};
+
+/* parameters given in command line arguments */
+struct params {
+    int verbose;
+    const char *approximants;
+    int do_td;
+    int do_fd;
+    struct grid mass1;
+    struct grid mass_ratio;
+    struct grid spinz;
+    double s1x;
+    double f_min;
+    double srate;
+    int nrepeat;
+    const char *output;
+};
+
+/* accumulated results for one approximant in one domain */
+struct results {
+    int ngood;
+    int nfail;
+    double setup;
+    double generate;
+    double condition;
+    double fft;
+};
+
+int usage(const char *program);
+struct params parseargs(int argc, char **argv);
+int parse_grid(struct grid *g, const char *s);
+double grid_value(const struct grid *g, int i);
+int bench_td_waveform(struct results *r, Approximant approx, double m1, double m2, double s1x, double s1z, double s2z, struct params p);
+int bench_fd_waveform(struct results *r, Approximant approx, double m1, double m2, double s1x, double s1z, double s2z, struct params p);
+int bench_approximant(FILE *fp, Approximant approx, LALSimulationDomain domain, struct params p);
+size_t data_length(double f_min, double m1, double m2, double s1z, double s2z, double srate);
+
+int main(int argc, char *argv[])
+{
+    struct params p;
+    FILE *fp = stdout;
+    char *approximants;
+    char *s;
+    char *token;
+
+    XLALSetErrorHandler(XLALBacktraceErrorHandler);
+
+    p = parseargs(argc, argv);
+
+    if (p.output) {
+        fp = fopen(p.output, "w");
+        if (!fp) {
+            fprintf(stderr, "error: could not open file %s for writing\n", p.output);
+            exit(1);
+        }
+    }
+
+    fprintf(fp, "# approximant\tdomain\tn_waveforms\tn_failed\twaveforms_per_s\tsetup (s)\tgenerate (s)\tcondition (s)\tfft (s)\tpeak_memory (MB)\n");
+
+    approximants = s = XLALStringDuplicate(p.approximants);
+    while ((token = XLALStringToken(&s, ",", 0)) != NULL) {
+        Approximant approx = XLALSimInspiralGetApproximantFromString(token);
+        if ((int)approx == XLAL_FAILURE) {
+            fprintf(stderr, "error: invalid approximant %s\n", token);
+            exit(1);
+        }
+        if (p.do_td && XLALSimInspiralImplementedTDApproximants(approx))
+            bench_approximant(fp, approx, LAL_SIM_DOMAIN_TIME, p);
+        if (p.do_fd && XLALSimInspiralImplementedFDApproximants(approx))
+            bench_approximant(fp, approx, LAL_SIM_DOMAIN_FREQUENCY, p);
+        fflush(fp);
+    }
+    XLALFree(approximants);
+
+    if (fp != stdout)
+        fclose(fp);
+    LALCheckMemoryLeaks();
+    return 0;
+}
+
+/* runs the grid of waveforms for one approximant in one domain and writes
+ * a line of results */
+int bench_approximant(FILE *fp, Approximant approx, LALSimulationDomain domain, struct params p)
+{
+    struct results r = { 0, 0, 0.0, 0.0, 0.0, 0.0 };
+    const char *name = XLALSimInspiralGetStringFromApproximant(approx);
+    double total;
+    int i, j, k, n;
+
+    if (p.verbose)
+        fprintf(stderr, "benchmarking %s in the %s domain...\n", name, domain == LAL_SIM_DOMAIN_TIME ? "time" : "frequency");
+
+    for (i = 0; i < p.mass1.n; ++i)
+        for (j = 0; j < p.mass_ratio.n; ++j)
+            for (k = 0; k < p.spinz.n; ++k) {
+                double m1 = grid_value(&p.mass1, i) * LAL_MSUN_SI;
+                double m2 = grid_value(&p.mass_ratio, j) * m1;
+                double chi = grid_value(&p.spinz, k);
+                for (n = 0; n < p.nrepeat; ++n) {
+                    if (domain == LAL_SIM_DOMAIN_TIME)
+                        bench_td_waveform(&r, approx, m1, m2, p.s1x, chi, chi, p);
+                    else
+                        bench_fd_waveform(&r, approx, m1, m2, p.s1x, chi, chi, p);
+                }
+            }
+
+    total = r.setup + r.generate + r.condition + r.fft;
+    fprintf(fp, "%s\t%s\t%d\t%d\t%.6g\t%.6g\t%.6g\t%.6g\t%.6g\t%.6g\n", name, domain == LAL_SIM_DOMAIN_TIME ? "time" : "freq", r.ngood, r.nfail, total > 0 ? r.ngood / total : 0.0, r.setup, r.generate, r.condition, r.fft, XLALGetPeakHeapUsageMB());
+
+    if (p.verbose)
+        fprintf(stderr, "%d waveforms in %g s (%d failed)\n", r.ngood, total, r.nfail);
+    return 0;
+}
+
+/* times generation of a time-domain waveform, its conditioning, and its
+ * transform to the frequency domain */
+int bench_td_waveform(struct results *r, Approximant approx, double m1, double m2, double s1x, double s1z, double s2z, struct params p)
+{
+    REAL8TimeSeries *h_plus = NULL;
+    REAL8TimeSeries *h_cross = NULL;
+    COMPLEX16FrequencySeries *htilde_plus = NULL;
+    COMPLEX16FrequencySeries *htilde_cross = NULL;
+    REAL8FFTPlan *plan = NULL;
+    double t0, t1, t2, t3, t4;
+    size_t length;
+    int errnum;
+
+    /* setup */
+    t0 = XLALGetTimeOfDay();
+    length = data_length(p.f_min, m1, m2, s1z, s2z, p.srate);
+    plan = XLALCreateForwardREAL8FFTPlan(length, 0);
+    t1 = XLALGetTimeOfDay();
+
+    /* generate */
+    XLAL_TRY(XLALSimInspiralChooseTDWaveform(&h_plus, &h_cross, m1, m2, s1x, 0.0, s1z, 0.0, 0.0, s2z, DEFAULT_DISTANCE * 1e6 * LAL_PC_SI, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0 / p.srate, p.f_min, 0.0, NULL, approx), errnum);
+    t2 = XLALGetTimeOfDay();
+    if (errnum || !h_plus || !h_cross)
+        goto fail;
+
+    /* condition */
+    XLAL_TRY(XLALSimInspiralTDConditionStage2(h_plus, h_cross, p.f_min, 0.5 * p.srate), errnum);
+    if (errnum)
+        goto fail;
+    XLALResizeREAL8TimeSeries(h_plus, (int)h_plus->data->length - (int)length, length);
+    XLALResizeREAL8TimeSeries(h_cross, (int)h_cross->data->length - (int)length, length);
+    t3 = XLALGetTimeOfDay();
+
+    /* fft */
+    htilde_plus = XLALCreateCOMPLEX16FrequencySeries("htilde_plus", &h_plus->epoch, 0.0, p.srate / length, &lalDimensionlessUnit, length / 2 + 1);
+    htilde_cross = XLALCreateCOMPLEX16FrequencySeries("htilde_cross", &h_cross->epoch, 0.0, p.srate / length, &lalDimensionlessUnit, length / 2 + 1);
+    XLALREAL8TimeFreqFFT(htilde_plus, h_plus, plan);
+    XLALREAL8TimeFreqFFT(htilde_cross, h_cross, plan);
+    t4 = XLALGetTimeOfDay();
+
+    r->setup += t1 - t0;
+    r->generate += t2 - t1;
+    r->condition += t3 - t2;
+    r->fft += t4 - t3;
+    ++r->ngood;
+
+    XLALDestroyCOMPLEX16FrequencySeries(htilde_cross);
+    XLALDestroyCOMPLEX16FrequencySeries(htilde_plus);
+    XLALDestroyREAL8TimeSeries(h_cross);
+    XLALDestroyREAL8TimeSeries(h_plus);
+    XLALDestroyREAL8FFTPlan(plan);
+    return 0;
+
+fail:
+    if (p.verbose)
+        fprintf(stderr, "failed to generate waveform for m1=%g Msun m2=%g Msun chi=%g\n", m1 / LAL_MSUN_SI, m2 / LAL_MSUN_SI, s1z);
+    ++r->nfail;
+    XLALDestroyREAL8TimeSeries(h_cross);
+    XLALDestroyREAL8TimeSeries(h_plus);
+    XLALDestroyREAL8FFTPlan(plan);
+    return 1;
+}
+
+/* times generation of a frequency-domain waveform, its resizing, and its
+ * transform to the time domain */
+int bench_fd_waveform(struct results *r, Approximant approx, double m1, double m2, double s1x, double s1z, double s2z, struct params p)
+{
+    COMPLEX16FrequencySeries *htilde_plus = NULL;
+    COMPLEX16FrequencySeries *htilde_cross = NULL;
+    REAL8TimeSeries *h_plus = NULL;
+    REAL8TimeSeries *h_cross = NULL;
+    REAL8FFTPlan *plan = NULL;
+    double t0, t1, t2, t3, t4;
+    double deltaF;
+    size_t length;
+    int errnum;
+
+    /* setup */
+    t0 = XLALGetTimeOfDay();
+    length = data_length(p.f_min, m1, m2, s1z, s2z, p.srate);
+    deltaF = p.srate / length;
+    plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+    t1 = XLALGetTimeOfDay();
+
+    /* generate */
+    XLAL_TRY(XLALSimInspiralChooseFDWaveform(&htilde_plus, &htilde_cross, m1, m2, s1x, 0.0, s1z, 0.0, 0.0, s2z, DEFAULT_DISTANCE * 1e6 * LAL_PC_SI, 0.0, 0.0, 0.0, 0.0, 0.0, deltaF, p.f_min, 0.5 * p.srate, 0.0, NULL, approx), errnum);
+    t2 = XLALGetTimeOfDay();
+    if (errnum || !htilde_plus || !htilde_cross)
+        goto fail;
+
+    /* condition */
+    XLALResizeCOMPLEX16FrequencySeries(htilde_plus, 0, length / 2 + 1);
+    XLALResizeCOMPLEX16FrequencySeries(htilde_cross, 0, length / 2 + 1);
+    t3 = XLALGetTimeOfDay();
+
+    /* fft */
+    h_plus = XLALCreateREAL8TimeSeries("h_plus", &htilde_plus->epoch, 0.0, 1.0 / p.srate, &lalStrainUnit, length);
+    h_cross = XLALCreateREAL8TimeSeries("h_cross", &htilde_cross->epoch, 0.0, 1.0 / p.srate, &lalStrainUnit, length);
+    XLALREAL8FreqTimeFFT(h_plus, htilde_plus, plan);
+    XLALREAL8FreqTimeFFT(h_cross, htilde_cross, plan);
+    t4 = XLALGetTimeOfDay();
+
+    r->setup += t1 - t0;
+    r->generate += t2 - t1;
+    r->condition += t3 - t2;
+    r->fft += t4 - t3;
+    ++r->ngood;
+
+    XLALDestroyREAL8TimeSeries(h_cross);
+    XLALDestroyREAL8TimeSeries(h_plus);
+    XLALDestroyCOMPLEX16FrequencySeries(htilde_cross);
+    XLALDestroyCOMPLEX16FrequencySeries(htilde_plus);
+    XLALDestroyREAL8FFTPlan(plan);
+    return 0;
+
+fail:
+    if (p.verbose)
+        fprintf(stderr, "failed to generate waveform for m1=%g Msun m2=%g Msun chi=%g\n", m1 / LAL_MSUN_SI, m2 / LAL_MSUN_SI, s1z);
+    ++r->nfail;
+    XLALDestroyCOMPLEX16FrequencySeries(htilde_cross);
+    XLALDestroyCOMPLEX16FrequencySeries(htilde_plus);
+    XLALDestroyREAL8FFTPlan(plan);
+    return 1;
+}
+
+/* number of samples, a power of two, that crudely overestimates the
+ * duration of the inspiral, merger, and ringdown */
+size_t data_length(double f_min, double m1, double m2, double s1z, double s2z, double srate)
+{
+    double tchirp, tmerge;
+    double s;
+    double chirplen;
+    int chirplen_exp;
+
+    tchirp = XLALSimInspiralChirpTimeBound(f_min, m1, m2, s1z, s2z);
+    s = XLALSimInspiralFinalBlackHoleSpinBound(s1z, s2z);
+    tmerge = XLALSimInspiralMergeTimeBound(m1, m2) + XLALSimInspiralRingdownTimeBound(m1 + m2, s);
+
+    /* make chirplen next power of two */
+    chirplen = (tchirp + tmerge) * srate;
+    frexp(chirplen, &chirplen_exp);
+    return (size_t) ldexp(1.0, chirplen_exp);
+}
+
+/* parses a grid given as MIN:MAX:N, or a single value */
+int parse_grid(struct grid *g, const char *s)
+{
+    char *end;
+    g->min = g->max = strtod(s, &end);
+    g->n = 1;
+    if (end == s)
+        return -1;
+    if (*end == '\0')
+        return 0;
+    if (*end++ != ':')
+        return -1;
+    s = end;
+    g->max = strtod(s, &end);
+    if (end == s || *end++ != ':')
+        return -1;
+    s = end;
+    g->n = strtol(s, &end, 10);
+    if (end == s || *end != '\0' || g->n < 1)
+        return -1;
+    return 0;
+}
+
+/* returns the ith value of a grid */
+double grid_value(const struct grid *g, int i)
+{
+    if (g->n < 2)
+        return g->min;
+    return g->min + i * (g->max - g->min) / (g->n - 1);
+}
+
+/* prints the usage message */
+int usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [options]\n", program);
+    fprintf(stderr, "options [default values in brackets]:\n");
+    fprintf(stderr, "\t-h, --help               \tprint this message and exit\n");
+    fprintf(stderr, "\t-v, --verbose            \tverbose output\n");
+    fprintf(stderr, "\t-a APPROX[,APPROX...], --approximants=APPROX[,APPROX...]\n\t\tcomma-separated list of approximants [%s]\n", DEFAULT_APPROXIMANTS);
+    fprintf(stderr, "\t-D DOMAIN, --domain=DOMAIN      \n\t\tdomain of generation {\"time\", \"freq\", \"both\"} [both]\n");
+    fprintf(stderr, "\t-M MIN:MAX:N, --mass1=MIN:MAX:N \n\t\tgrid of primary masses in solar masses [%s]\n", DEFAULT_MASS1);
+    fprintf(stderr, "\t-q MIN:MAX:N, --mass-ratio=MIN:MAX:N\n\t\tgrid of mass ratios m2/m1 [%s]\n", DEFAULT_MASS_RATIO);
+    fprintf(stderr, "\t-Z MIN:MAX:N, --spinz=MIN:MAX:N \n\t\tgrid of aligned dimensionless spins of both bodies [%s]\n", DEFAULT_SPINZ);
+    fprintf(stderr, "\t-X S1X, --spin1x=S1X            \n\t\tin-plane dimensionless spin of primary [%g]\n", DEFAULT_S1X);
+    fprintf(stderr, "\t-f FMIN, --f-min=FMIN           \n\t\tfrequency to start waveform in Hertz [%g]\n", DEFAULT_F_MIN);
+    fprintf(stderr, "\t-R SRATE, --sample-rate=SRATE   \n\t\tsample rate in Hertz [%g]\n", DEFAULT_SRATE);
+    fprintf(stderr, "\t-n NREPEAT, --repeat=NREPEAT    \n\t\tnumber of times each grid point is generated [%d]\n", DEFAULT_NREPEAT);
+    fprintf(stderr, "\t-o FILE, --output=FILE          \n\t\tfile to write the results to [standard output]\n");
+    return 0;
+}
+
+/* long name of the option with short name c: option_index is only set
+ * when the option is given by its long name */
+static const char *option_name(const struct LALoption *options, int c)
+{
+    for (; options->name; ++options)
+        if (options->val == c)
+            return options->name;
+    return "unknown option";
+}
+
+/* sets params to default values and parses the command line arguments */
+struct params parseargs(int argc, char **argv)
+{
+    struct params p = {
+        .verbose = 0,
+        .approximants = DEFAULT_APPROXIMANTS,
+        .do_td = 1,
+        .do_fd = 1,
+        .s1x = DEFAULT_S1X,
+        .f_min = DEFAULT_F_MIN,
+        .srate = DEFAULT_SRATE,
+        .nrepeat = DEFAULT_NREPEAT,
+        .output = NULL
+    };
+    struct LALoption long_options[] = {
+        {"help", no_argument, 0, 'h'},
+        {"verbose", no_argument, 0, 'v'},
+        {"approximants", required_argument, 0, 'a'},
+        {"domain", required_argument, 0, 'D'},
+        {"mass1", required_argument, 0, 'M'},
+        {"mass-ratio", required_argument, 0, 'q'},
+        {"spinz", required_argument, 0, 'Z'},
+        {"spin1x", required_argument, 0, 'X'},
+        {"f-min", required_argument, 0, 'f'},
+        {"sample-rate", required_argument, 0, 'R'},
+        {"repeat", required_argument, 0, 'n'},
+        {"output", required_argument, 0, 'o'},
+        {0, 0, 0, 0}
+    };
+    char args[] = "hva:D:M:q:Z:X:f:R:n:o:";
+
+    parse_grid(&p.mass1, DEFAULT_MASS1);
+    parse_grid(&p.mass_ratio, DEFAULT_MASS_RATIO);
+    parse_grid(&p.spinz, DEFAULT_SPINZ);
+
+    while (1) {
+        int option_index = 0;
+        int c;
+
+        c = LALgetopt_long_only(argc, argv, args, long_options, &option_index);
+        if (c == -1)    /* end of options */
+            break;
+
+        switch (c) {
+        case 0:        /* if option set a flag, nothing else to do */
+            if (long_options[option_index].flag)
+                break;
+            else {
+                fprintf(stderr, "error parsing option %s with argument %s\n", long_options[option_index].name, LALoptarg);
+                exit(1);
+            }
+        case 'h':      /* help */
+            usage(argv[0]);
+            exit(0);
+        case 'v':      /* verbose */
+            p.verbose = 1;
+            break;
+        case 'a':      /* approximants */
+            p.approximants = LALoptarg;
+            break;
+        case 'D':      /* domain */
+            switch (*LALoptarg) {
+            case 'T':
+            case 't':
+                p.do_td = 1;
+                p.do_fd = 0;
+                break;
+            case 'F':
+            case 'f':
+                p.do_td = 0;
+                p.do_fd = 1;
+                break;
+            case 'B':
+            case 'b':
+                p.do_td = 1;
+                p.do_fd = 1;
+                break;
+            default:
+                fprintf(stderr, "error: invalid value %s for --%s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'M':      /* mass1 */
+            if (parse_grid(&p.mass1, LALoptarg) < 0) {
+                fprintf(stderr, "error: invalid value %s for --%s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'q':      /* mass-ratio */
+            if (parse_grid(&p.mass_ratio, LALoptarg) < 0) {
+                fprintf(stderr, "error: invalid value %s for --%s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'Z':      /* spinz */
+            if (parse_grid(&p.spinz, LALoptarg) < 0) {
+                fprintf(stderr, "error: invalid value %s for --%s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'X':      /* spin1x */
+            p.s1x = atof(LALoptarg);
+            break;
+        case 'f':      /* f-min */
+            p.f_min = atof(LALoptarg);
+            break;
+        case 'R':      /* sample-rate */
+            p.srate = atof(LALoptarg);
+            break;
+        case 'n':      /* repeat */
+            p.nrepeat = atoi(LALoptarg);
+            break;
+        case 'o':      /* output */
+            p.output = LALoptarg;
+            break;
+        case '?':
+        default:
+            fprintf(stderr, "unknown error while parsing options\n");
+            exit(1);
+        }
+    }
+
+    if (LALoptind < argc) {
+        fprintf(stderr, "extraneous command line arguments:\n");
+        while (LALoptind < argc)
+            fprintf(stderr, "%s\n", argv[LALoptind++]);
+        exit(1);
+    }
+
+    if (p.f_min <= 0.0 || p.srate <= 0.0 || p.nrepeat < 1) {
+        fprintf(stderr, "error: f-min, sample-rate and repeat must be positive\n");
+        exit(1);
+    }
+
+    return p;
+}
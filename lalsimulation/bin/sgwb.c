@@ -60,8 +60,9 @@
  * `LAL_DEBUG_LEVEL=3` which prints both error messages and warning messages,
  * and `LAL_DEBUG_LEVEL=7` which additionally prints informational messages.
  *
- * The `GSL_RNG_SEED` and `GSL_RNG_TYPE` environment variables can be used
- * to set the random number generator seed and type respectively.
+ * The `GSL_RNG_SEED` environment variable can be used to set the seed that
+ * identifies the simulated stream; the same seed always produces the same
+ * data, independent of the number of OpenMP threads.
  *
  * ### Exit Status
  *
@@ -110,11 +111,13 @@ int main(int argc, char *argv[])
 	const double H0 = 0.72 * LAL_H0FAC_SI; // Hubble's constant in seconds
 	const size_t length = 65536; // number of points in a segment
 	const size_t stride = length / 2; // number of points in a stride
+	const size_t nstride = 32; // number of strides generated at a time
 	size_t i, n;
+	UINT8 block;
 	REAL8FrequencySeries *OmegaGW = NULL;
+	LALSimSGWBPlan *plan = NULL;
 	REAL8TimeSeries **seg = NULL;
 	LIGOTimeGPS epoch;
-	gsl_rng *rng;
 
 	XLALSetErrorHandler(XLALAbortErrorHandler);
 
@@ -122,8 +125,8 @@ int main(int argc, char *argv[])
 
 	XLALGPSSetREAL8(&epoch, tstart);
 	gsl_rng_env_setup();
-	rng = gsl_rng_alloc(gsl_rng_default);
 	OmegaGW = XLALSimSGWBOmegaGWFlatSpectrum(Omega0, flow, srate/length, length/2 + 1);
+	plan = XLALSimSGWBPlanCreate(detectors, numDetectors, length, 1.0/srate, OmegaGW, H0);
 
 	n = duration * srate;
 	seg = LALCalloc(numDetectors, sizeof(*seg));
@@ -131,31 +134,29 @@ int main(int argc, char *argv[])
 	for (i = 0; i < numDetectors; ++i) {
 		char name[LALNameLength];
 		snprintf(name, sizeof(name), "%s:STRAIN", detectors[i].frDetector.prefix);
-		seg[i] = XLALCreateREAL8TimeSeries(name, &epoch, 0.0, 1.0/srate, &lalStrainUnit, length);
+		seg[i] = XLALCreateREAL8TimeSeries(name, &epoch, 0.0, 1.0/srate, &lalStrainUnit, nstride * stride);
 		printf("\t%s (strain)", name);
 	}
 	printf("\n");
 
-	XLALSimSGWB(seg, detectors, numDetectors, 0, OmegaGW, H0, rng); // first time to initilize
-
-	while (1) { // infinite loop
+	for (block = 0; n > 0; ++block) {
 		size_t j;
-		for (j = 0; j < stride; ++j, --n) { // output first stride points
+		XLALSimSGWBStrides(seg, plan, stride, block * nstride, gsl_rng_default_seed); // make more data
+		for (j = 0; j < seg[0]->data->length && n > 0; ++j, --n) {
 			LIGOTimeGPS t = seg[0]->epoch;
-			if (n == 0) // check if we're done
-				goto end;
 			printf("%s", XLALGPSToStr(tstr, XLALGPSAdd(&t, j * seg[0]->deltaT)));
 			for (i = 0; i < numDetectors; ++i)
 				printf("\t%.18e", seg[i]->data->data[j]);
 			printf("\n");
 		}
-		XLALSimSGWB(seg, detectors, numDetectors, stride, OmegaGW, H0, rng); // make more data
+		for (i = 0; i < numDetectors; ++i)
+			XLALGPSAdd(&seg[i]->epoch, seg[i]->data->length * seg[i]->deltaT);
 	}
 
-end:
 	for (i = 0; i < numDetectors; ++i)
 		XLALDestroyREAL8TimeSeries(seg[i]);
 	XLALFree(seg);
+	XLALSimSGWBPlanDestroy(plan);
 	XLALDestroyREAL8FrequencySeries(OmegaGW);
 	LALCheckMemoryLeaks();
 
@@ -130,6 +130,8 @@ double XLALSimNeutronStarCentralPressure(double m,
     LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarRadius(double m, LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarLoveNumberK2(double m, LALSimNeutronStarFamily * fam);
+int XLALSimNeutronStarTidalProperties(double *radius, double *love_number_k2,
+    double *lambda, double m, LALSimNeutronStarFamily * fam);
 
 #endif /* _LALSIMNEUTRONSTAR_H */
 
@@ -29,6 +29,10 @@
 #include <gsl/gsl_interp.h>
 #include <lal/LALSimNeutronStar.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /** @cond */
 
 /* Contents of the tabular equation of state data structure. */
@@ -50,6 +54,19 @@ struct tagLALSimNeutronStarEOSDataTabular {
     gsl_interp_accel *log_rho_of_log_h_acc;
 };
 
+/* accelerator to be used by the calling thread: an accelerator remembers
+ * the last interval found, so it is not used inside a parallel region
+ * (e.g. the TOV integrations of XLALCreateSimNeutronStarFamily), where
+ * the interval is instead found by bisection */
+static gsl_interp_accel *eos_acc_tabular(gsl_interp_accel * acc)
+{
+#ifdef _OPENMP
+    if (omp_in_parallel())
+        return NULL;
+#endif
+    return acc;
+}
+
 static double eos_e_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 {
 	double log_p;
@@ -62,7 +79,7 @@ static double eos_e_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_edat[0] + (3.0 / 5.0) * (log_p - eos->data.tabular->log_pdat[0]));
     log_e = gsl_interp_eval(eos->data.tabular->log_e_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_edat, log_p,
-        eos->data.tabular->log_e_of_log_p_acc);
+        eos_acc_tabular(eos->data.tabular->log_e_of_log_p_acc));
     return exp(log_e);
 }
 
@@ -78,7 +95,7 @@ static double eos_e_of_h_tabular(double h, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_edat[0] + 1.5 * (log_h - eos->data.tabular->log_hdat[0]));
     log_e = gsl_interp_eval(eos->data.tabular->log_e_of_log_h_interp,
         eos->data.tabular->log_hdat, eos->data.tabular->log_edat, log_h,
-        eos->data.tabular->log_e_of_log_h_acc);
+        eos_acc_tabular(eos->data.tabular->log_e_of_log_h_acc));
     return exp(log_e);
 }
 
@@ -94,7 +111,7 @@ static double eos_p_of_h_tabular(double h, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_pdat[0] + 2.5 * (log_h - eos->data.tabular->log_hdat[0]));
     log_p = gsl_interp_eval(eos->data.tabular->log_p_of_log_h_interp,
         eos->data.tabular->log_hdat, eos->data.tabular->log_pdat, log_h,
-        eos->data.tabular->log_p_of_log_h_acc);
+        eos_acc_tabular(eos->data.tabular->log_p_of_log_h_acc));
     return exp(log_p);
 }
 
@@ -111,7 +128,7 @@ static double eos_rho_of_h_tabular(double h, LALSimNeutronStarEOS * eos)
     log_rho =
         gsl_interp_eval(eos->data.tabular->log_rho_of_log_h_interp,
         eos->data.tabular->log_hdat, eos->data.tabular->log_rhodat, log_h,
-        eos->data.tabular->log_rho_of_log_h_acc);
+        eos_acc_tabular(eos->data.tabular->log_rho_of_log_h_acc));
     return exp(log_rho);
 }
 
@@ -127,7 +144,7 @@ static double eos_h_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_hdat[0] + 0.4 * (log_p - eos->data.tabular->log_pdat[0]));
     log_h = gsl_interp_eval(eos->data.tabular->log_h_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_hdat, log_p,
-        eos->data.tabular->log_h_of_log_p_acc);
+        eos_acc_tabular(eos->data.tabular->log_h_of_log_p_acc));
     return exp(log_h);
 }
 
@@ -141,11 +158,11 @@ static double eos_dedp_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 		return (3.0 / 5.0) * exp(eos->data.tabular->log_edat[0] - eos->data.tabular->log_pdat[0]);
     log_e = gsl_interp_eval(eos->data.tabular->log_e_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_edat, log_p,
-        eos->data.tabular->log_e_of_log_p_acc);
+        eos_acc_tabular(eos->data.tabular->log_e_of_log_p_acc));
     d_log_e_d_log_p =
         gsl_interp_eval_deriv(eos->data.tabular->log_e_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_edat, log_p,
-        eos->data.tabular->log_e_of_log_p_acc);
+        eos_acc_tabular(eos->data.tabular->log_e_of_log_p_acc));
     return d_log_e_d_log_p * exp(log_e - log_p);
 }
 
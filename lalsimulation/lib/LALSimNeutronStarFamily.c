@@ -31,8 +31,15 @@
 GSL_VAR const gsl_interp_type * lal_gsl_interp_steffen;
 
 #include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
 #include <lal/LALSimNeutronStar.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 /** @cond */
 
 /* Contents of the neutron star family structure. */
@@ -104,7 +111,8 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     double logpmax;
     double dlogp;
     size_t ndat = ndatmax;
-    size_t i;
+    size_t nbatch = 1;
+    size_t i, i0;
 
     /* allocate memory */
     fam = LALMalloc(sizeof(*fam));
@@ -114,18 +122,36 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     fam->mdat = LALMalloc(ndat * sizeof(*fam->mdat));
     fam->rdat = LALMalloc(ndat * sizeof(*fam->rdat));
     fam->kdat = LALMalloc(ndat * sizeof(*fam->kdat));
-    if (!fam->mdat || !fam->rdat || !fam->kdat)
+    if (!fam->pdat || !fam->mdat || !fam->rdat || !fam->kdat)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
 
-    /* compute data tables */
+#ifdef _OPENMP
+    /* if already inside a parallel region (e.g. one family per sampler
+     * thread) the batch would run serially, so don't over-compute */
+    if (!omp_in_parallel())
+        nbatch = omp_get_max_threads();
+#endif
+
+    /* compute data tables: the TOV integrations are independent so they
+     * are done in batches of one per thread; the pressure grid is fixed,
+     * so the family does not depend on the number of threads, and at most
+     * one batch is wasted beyond the turning point of the mass */
     logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
     dlogp = (logpmax - logpmin) / ndat;
-    for (i = 0; i < ndat; ++i) {
-        fam->pdat[i] = exp(logpmin + i * dlogp);
-        XLALSimNeutronStarTOVODEIntegrate(&fam->rdat[i], &fam->mdat[i],
-            &fam->kdat[i], fam->pdat[i], eos);
+    for (i0 = 0, i = 0; i0 < ndat; i0 += nbatch) {
+        size_t i1 = i0 + nbatch < ndat ? i0 + nbatch : ndat;
+        size_t j;
+        #pragma omp parallel for schedule(static, 1)
+        for (j = i0; j < i1; ++j) {
+            fam->pdat[j] = exp(logpmin + j * dlogp);
+            XLALSimNeutronStarTOVODEIntegrate(&fam->rdat[j], &fam->mdat[j],
+                &fam->kdat[j], fam->pdat[j], eos);
+        }
         /* determine if maximum mass has been found */
-        if (i > 0 && fam->mdat[i] <= fam->mdat[i-1])
+        for (i = i0; i < i1; ++i)
+            if (i > 0 && fam->mdat[i] <= fam->mdat[i-1])
+                break;
+        if (i < i1)
             break;
     }
 
@@ -253,4 +279,44 @@ double XLALSimNeutronStarLoveNumberK2(double m, LALSimNeutronStarFamily * fam)
     return k;
 }
 
+/**
+ * @brief Returns the radius, tidal Love number k2, and dimensionless tidal
+ * deformability of a neutron star of mass @a m.
+ * @details
+ * This is equivalent to calling XLALSimNeutronStarRadius() and
+ * XLALSimNeutronStarLoveNumberK2() and forming
+ * \f$\Lambda = (2/3) k_2 (R c^2 / G m)^5\f$, but the radius and Love
+ * number tables share the same mass abscissa so the interval lookup is done
+ * once.  The lookup uses its own accelerator rather than those of the family,
+ * so this function may be called from several threads at once.
+ * As with XLALSimNeutronStarRadius(), a mass outside the family is reported
+ * as a domain error through the GSL error handler.
+ * @param[out] radius The radius of the neutron star (m); may be NULL.
+ * @param[out] love_number_k2 The dimensionless tidal Love number k2; may be
+ * NULL.
+ * @param[out] lambda The dimensionless tidal deformability; may be NULL.
+ * @param[in] m The mass of the neutron star (kg).
+ * @param[in] fam Pointer to the neutron star family structure.
+ * @return 0 on success.
+ */
+int XLALSimNeutronStarTidalProperties(double *radius, double *love_number_k2,
+    double *lambda, double m, LALSimNeutronStarFamily * fam)
+{
+    gsl_interp_accel acc;
+    double r, k, c;
+    XLAL_CHECK(fam, XLAL_EFAULT);
+    gsl_interp_accel_reset(&acc);
+    r = gsl_interp_eval(fam->r_of_m_interp, fam->mdat, fam->rdat, m, &acc);
+    k = gsl_interp_eval(fam->k_of_m_interp, fam->mdat, fam->kdat, m, &acc);
+    if (radius)
+        *radius = r;
+    if (love_number_k2)
+        *love_number_k2 = k;
+    if (lambda) {
+        c = m * LAL_MRSUN_SI / (LAL_MSUN_SI * r);    /* compactness */
+        *lambda = (2.0 / 3.0) * k / pow(c, 5.0);
+    }
+    return 0;
+}
+
 /** @} */
@@ -33,25 +33,32 @@
 #include <lal/Units.h>
 #include <lal/LALSimNoise.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 
 /* 
  * This routine generates a single segment of data.  Note that this segment is
  * generated in the frequency domain and is inverse Fourier transformed into
  * the time domain; consequently the data is periodic in the time domain.
  */
-static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gsl_rng *rng)
+static int XLALSimNoiseSegment(REAL8TimeSeries *s, const REAL8FrequencySeries *psd, gsl_rng *rng, const REAL8FFTPlan *plan)
 {
 	size_t k;
-	REAL8FFTPlan *plan;
+	REAL8FFTPlan *ownplan = NULL;
 	COMPLEX16FrequencySeries *stilde;
 
-	plan = XLALCreateReverseREAL8FFTPlan(s->data->length, 0);
-	if (! plan)
-		XLAL_ERROR(XLAL_EFUNC);
+	/* use the supplied plan if there is one; otherwise make our own */
+	if (! plan) {
+		plan = ownplan = XLALCreateReverseREAL8FFTPlan(s->data->length, 0);
+		if (! plan)
+			XLAL_ERROR(XLAL_EFUNC);
+	}
 
 	stilde = XLALCreateCOMPLEX16FrequencySeries("STILDE", &s->epoch, 0.0, 1.0/(s->data->length * s->deltaT), &lalDimensionlessUnit, s->data->length/2 + 1);
 	if (! stilde) {
-		XLALDestroyREAL8FFTPlan(plan);
+		XLALDestroyREAL8FFTPlan(ownplan);
 		XLAL_ERROR(XLAL_EFUNC);
 	}
 
@@ -69,7 +76,7 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
 	XLALREAL8FreqTimeFFT(s, stilde, plan);
 
 	XLALDestroyCOMPLEX16FrequencySeries(stilde);
-	XLALDestroyREAL8FFTPlan(plan);
+	XLALDestroyREAL8FFTPlan(ownplan);
 	return 0;
 }
 
@@ -166,12 +173,12 @@ int XLALSimNoise(
 		XLAL_ERROR(XLAL_EINVAL);
 
 	if (stride == 0) { /* generate segment with no feathering */
-		XLALSimNoiseSegment(s, psd, rng);
+		XLALSimNoiseSegment(s, psd, rng, NULL);
 		return 0;
 	} else if (stride == s->data->length) {
 		/* will generate two independent noise realizations
 		 * and feather them together with full overlap */
-		XLALSimNoiseSegment(s, psd, rng);
+		XLALSimNoiseSegment(s, psd, rng, NULL);
 		stride = 0;
 	}
 
@@ -181,7 +188,7 @@ int XLALSimNoise(
 	memcpy(overlap->data, s->data->data + stride, overlap->length*sizeof(*overlap->data));
 	
 	/* generate the new data */
-	XLALSimNoiseSegment(s, psd, rng);
+	XLALSimNoiseSegment(s, psd, rng, NULL);
 
 	/* feather old data in overlap region with new data */
 	for (j = 0; j < overlap->length; ++j) {
@@ -197,6 +204,190 @@ int XLALSimNoise(
 	return 0;
 }
 
+/**
+ * @brief Returns a random number generator for one segment of a
+ * reproducible stream of segments.
+ *
+ * Each segment of data produced by XLALSimNoiseStrides() and
+ * XLALSimSGWBStrides() is drawn from its own generator so that segments can
+ * be generated in any order, and on any number of threads, and still give
+ * the same stream.  The generator for segment number segment of the stream
+ * identified by seed is a Mersenne twister whose 32-bit seed is a hash of
+ * both seed and segment.
+ *
+ * @note
+ * The Mersenne twister only takes a 32-bit seed, so there are only 2^32
+ * distinct segment generators.  For a given seed, the hash is a one-to-one
+ * map of the segment numbers onto the 32-bit seeds, so segments of one
+ * stream never share a generator; segment must be less than 2^32, and
+ * XLAL_EDOM is raised otherwise.  The map is scrambled differently for each
+ * seed, so streams with different seeds are not shifted copies of each
+ * other; any two of their segments share a generator with probability
+ * 2^-32.
+ *
+ * The returned generator must be freed with gsl_rng_free().
+ */
+gsl_rng *XLALSimNoiseSegmentRNG(
+	UINT8 seed,	/**< [in] seed identifying the stream */
+	UINT8 segment	/**< [in] segment number within the stream */
+)
+{
+	gsl_rng *rng;
+	UINT8 z;
+	UINT4 x;
+	int i;
+
+	if (segment > UINT64_C(0xffffffff))
+		XLAL_ERROR_NULL(XLAL_EDOM, "Segment number exceeds the 2^32 distinct segment generators");
+
+	/* splitmix64 finalizer: two 32-bit keys from seed */
+	z = seed + UINT64_C(0x9E3779B97F4A7C15);
+	z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+	z ^= z >> 31;
+
+	/* keyed rounds of the murmur3 32-bit finalizer; each step is
+	 * invertible, so distinct segments get distinct seeds */
+	x = (UINT4)segment;
+	for (i = 0; i < 2; ++i) {
+		x ^= (UINT4)(z >> (32 * i));
+		x ^= x >> 16;
+		x *= UINT32_C(0x85EBCA6B);
+		x ^= x >> 13;
+		x *= UINT32_C(0xC2B2AE35);
+		x ^= x >> 16;
+	}
+
+	rng = gsl_rng_alloc(gsl_rng_mt19937);
+	if (! rng)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	gsl_rng_set(rng, x);
+	return rng;
+}
+
+/**
+ * @brief Routine that generates a block of consecutive strides of a
+ * reproducible, continuous stream of noise.
+ *
+ * The stream is made of periodic segments of length samples that are
+ * feathered together with the same overlap-add scheme as XLALSimNoise(): the
+ * output in stride number n (for n > 0) is made from the last length - stride
+ * samples of segment n - 1 feathered into the first samples of segment n,
+ * and stride 0 is the start of segment 0.  Segment n is drawn from the
+ * generator returned by XLALSimNoiseSegmentRNG() for seed and n.
+ *
+ * Each call fills the whole of s with s->data->length / stride strides
+ * starting with stride number firstStride.  The result does not depend on
+ * how the stream is divided into calls, so consecutive calls with
+ * firstStride advanced by the number of strides in s produce one continuous
+ * stream.  Independent blocks can be generated in any order, e.g., by
+ * separate jobs, and the segments within a block are generated in parallel
+ * when OpenMP is enabled.  The epoch of s is not modified; it is up to the
+ * caller to set it to the start of stride firstStride.
+ *
+ * @note
+ * Unlike XLALSimNoise(), every sample of s is valid.  The length of s must
+ * be a multiple of stride, and stride must be shorter than length.
+ */
+int XLALSimNoiseStrides(
+	REAL8TimeSeries *s,			/**< [out] noise time series */
+	size_t length,				/**< [in] segment length (samples) */
+	size_t stride,				/**< [in] stride (samples) */
+	UINT8 firstStride,			/**< [in] number of first stride in s */
+	const REAL8FrequencySeries *psd,	/**< [in] power spectrum frequency series */
+	UINT8 seed				/**< [in] seed identifying the stream */
+)
+{
+	REAL8FFTPlan *plan = NULL;
+	REAL8TimeSeries **raw = NULL;
+	UINT8 firstSegment;
+	size_t numStrides;
+	size_t numSegments;
+	size_t n;
+	int errnum = 0;
+
+	XLAL_CHECK(s && s->data, XLAL_EFAULT);
+	XLAL_CHECK(psd && psd->data, XLAL_EFAULT);
+
+	/* make sure that the resolution of the frequency series is
+	 * commensurate with the requested segments */
+	if (length/2 + 1 != psd->data->length
+			|| (size_t)floor(0.5 + 1.0/(s->deltaT * psd->deltaF)) != length)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	/* the output must hold a whole number of strides, and strides must
+	 * overlap */
+	if (stride == 0 || stride >= length || s->data->length % stride)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	/* segments needed: the one before the first stride, unless this is the
+	 * start of the stream, and one for each stride */
+	numStrides = s->data->length / stride;
+	firstSegment = firstStride ? firstStride - 1 : 0;
+	numSegments = firstStride + numStrides - firstSegment;
+
+	plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	raw = XLALCalloc(numSegments, sizeof(*raw));
+	if (! plan || ! raw) {
+		errnum = XLAL_EFUNC;
+		goto freereturn;
+	}
+	for (n = 0; n < numSegments; ++n) {
+		raw[n] = XLALCreateREAL8TimeSeries(s->name, &s->epoch, s->f0, s->deltaT, &s->sampleUnits, length);
+		if (! raw[n]) {
+			errnum = XLAL_EFUNC;
+			goto freereturn;
+		}
+	}
+
+	/* generate the segments */
+	#pragma omp parallel for schedule(dynamic)
+	for (n = 0; n < numSegments; ++n) {
+		gsl_rng *rng = XLALSimNoiseSegmentRNG(seed, firstSegment + n);
+		if (! rng || XLALSimNoiseSegment(raw[n], psd, rng, plan)) {
+			#pragma omp atomic write
+			errnum = XLAL_EFUNC;
+		}
+		gsl_rng_free(rng);
+	}
+	if (errnum)
+		goto freereturn;
+
+	/* feather the segments together */
+	#pragma omp parallel for
+	for (n = 0; n < numStrides; ++n) {
+		UINT8 stridenum = firstStride + n;
+		const REAL8Sequence *new = raw[stridenum - firstSegment]->data;
+		REAL8 *out = s->data->data + n * stride;
+		size_t j;
+		if (stridenum == 0)
+			memcpy(out, new->data, stride * sizeof(*out));
+		else {
+			const REAL8Sequence *old = raw[stridenum - 1 - firstSegment]->data;
+			for (j = 0; j < stride; ++j)
+				if (j < length - stride) {
+					double x = cos(LAL_PI*j/(2.0 * (length - stride)));
+					double y = sin(LAL_PI*j/(2.0 * (length - stride)));
+					out[j] = x*old->data[j + stride] + y*new->data[j];
+				} else
+					out[j] = new->data[j];
+		}
+	}
+
+	/* correct units */
+	s->sampleUnits = raw[0]->sampleUnits;
+
+freereturn:
+	if (raw)
+		for (n = 0; n < numSegments; ++n)
+			XLALDestroyREAL8TimeSeries(raw[n]);
+	XLALFree(raw);
+	XLALDestroyREAL8FFTPlan(plan);
+	if (errnum)
+		XLAL_ERROR(errnum);
+	return 0;
+}
+
 /** @} */
 
 /*
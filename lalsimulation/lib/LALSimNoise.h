@@ -69,6 +69,8 @@ SWIGLAL(FUNCTION_POINTER(aLIGOQuantumHighFrequency, XLALSimNoisePSDAdvVirgo,
 
 
 int XLALSimNoise(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng);
+gsl_rng *XLALSimNoiseSegmentRNG(UINT8 seed, UINT8 segment);
+int XLALSimNoiseStrides(REAL8TimeSeries *s, size_t length, size_t stride, UINT8 firstStride, const REAL8FrequencySeries *psd, UINT8 seed);
 
 
 /*
@@ -30,9 +30,57 @@
 #include <lal/FrequencySeries.h>
 #include <lal/Sequence.h>
 #include <lal/TimeFreqFFT.h>
+#include <lal/TimeSeries.h>
 #include <lal/Units.h>
+#include <lal/LALSimNoise.h>
 #include <lal/LALSimSGWB.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/* opaque structure holding the quantities that XLALSimSGWBStrides() needs
+ * for every segment */
+struct tagLALSimSGWBPlan {
+	size_t numDetectors;	/* number of detectors in network */
+	size_t length;		/* segment length (samples) */
+	double deltaT;		/* sample interval (s) */
+	REAL8Sequence *sigma;	/* standard deviation in each frequency bin */
+	REAL8Sequence *chol;	/* packed lower Cholesky factors in each bin */
+	REAL8FFTPlan *plan;	/* reverse FFT plan for a segment */
+};
+
+/*
+ * This routine constructs the correlation matrix of the detector network at
+ * frequency f and replaces it with its Cholesky decomposition.
+ */
+static int XLALSimSGWBCorrelationCholesky(gsl_matrix *R, double f, const LALDetector *detectors, size_t numDetectors)
+{
+	size_t i, j;
+
+	/* diagonal elements of correlation matrix are unity */
+	gsl_matrix_set_identity(R);
+	/* now do the off-diagonal elements */
+	for (i = 0; i < numDetectors; ++i)
+		for (j = i + 1; j < numDetectors; ++j) {
+			double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
+			/* if the two sites are the same, the overlap reduciton
+			 * function will be unity, but this will cause problems
+			 * for the cholesky decomposition; a hack is to make it
+			 * unity only to single precision */
+			if (fabs(Rij - 1.0) < LAL_REAL4_EPS)
+				Rij = 1.0 - LAL_REAL4_EPS;
+
+			gsl_matrix_set(R, i, j, Rij);
+			gsl_matrix_set(R, j, i, Rij); /* it is symmetric */
+		}
+
+	/* perform Cholesky decomposition */
+	if (gsl_linalg_cholesky_decomp(R))
+		XLAL_ERROR(XLAL_EFAILED);
+	return 0;
+}
+
 /* 
  * This routine generates a single segment of data.  Note that this segment is
  * generated in the frequency domain and is inverse Fourier transformed into
@@ -88,26 +136,10 @@ static int XLALSimSGWBSegment(REAL8TimeSeries **h, const LALDetector *detectors,
 		double f = k * deltaF;
 		double sigma = 0.5 * sqrt(psdfac * OmegaGW->data->data[k] * pow(f, -3.0) / deltaF);
 
-		/* construct correlation matrix at this frequency */
-		/* diagonal elements of correlation matrix are unity */
-		gsl_matrix_set_identity(R);
-		/* now do the off-diagonal elements */
-		for (i = 0; i < numDetectors; ++i)
-			for (j = i + 1; j < numDetectors; ++j) {
-				double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
-				/* if the two sites are the same, the overlap reduciton
-				 * function will be unity, but this will cause problems
-				 * for the cholesky decomposition; a hack is to make it
-				 * unity only to single precision */
-				if (fabs(Rij - 1.0) < LAL_REAL4_EPS)
-					Rij = 1.0 - LAL_REAL4_EPS;
-
-				gsl_matrix_set(R, i, j, Rij);
-				gsl_matrix_set(R, j, i, Rij); /* it is symmetric */
-			}
-
-		/* perform Cholesky decomposition */
-		gsl_linalg_cholesky_decomp(R);
+		/* construct correlation matrix at this frequency and
+		 * perform Cholesky decomposition */
+		if (XLALSimSGWBCorrelationCholesky(R, f, detectors, numDetectors))
+			CLEANUP_AND_RETURN(XLAL_EFUNC);
 
 		/* generate numDetector random numbers (both re and im parts) and use
  		 * lower-diagonal part of Cholesky decomposition to create correlations */
@@ -553,6 +585,291 @@ int XLALSimSGWBPowerLawSpectrum(
 	return 0;
 }
 
+/**
+ * Creates a plan for generating a stochastic background stream with
+ * XLALSimSGWBStrides().
+ *
+ * The plan holds, for every frequency bin of a segment of length samples,
+ * the Cholesky decomposition of the correlation matrix of the detector
+ * network and the standard deviation of the background given by OmegaGW
+ * and H0, together with the FFT plan for a segment.  These depend only on
+ * the network, the spectrum, and the segment length, so they are computed
+ * once here rather than for every segment as XLALSimSGWB() does.
+ */
+LALSimSGWBPlan *XLALSimSGWBPlanCreate(
+	const LALDetector *detectors,		/**< [in] array of detectors in network */
+	size_t numDetectors,			/**< [in] number of detectors in network */
+	size_t length,				/**< [in] segment length (samples) */
+	double deltaT,				/**< [in] sample interval (s) */
+	const REAL8FrequencySeries *OmegaGW,	/**< [in] sgwb spectrum frequeny series */
+	double H0				/**< [in] Hubble's constant (s) */
+)
+{
+	const size_t numFactors = numDetectors * (numDetectors + 1) / 2;
+	LALSimSGWBPlan *plan;
+	gsl_matrix *R;
+	double psdfac;
+	double deltaF;
+	size_t i, j, k;
+
+	XLAL_CHECK_NULL(detectors, XLAL_EFAULT);
+	XLAL_CHECK_NULL(OmegaGW && OmegaGW->data, XLAL_EFAULT);
+
+	if (numDetectors == 0 || length < 2)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	/* make sure that the resolution of the frequency series is
+	 * commensurate with the requested segments */
+	if (length/2 + 1 != OmegaGW->data->length
+			|| (size_t)floor(0.5 + 1.0/(deltaT * OmegaGW->deltaF)) != length)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	plan = XLALCalloc(1, sizeof(*plan));
+	if (! plan)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	plan->numDetectors = numDetectors;
+	plan->length = length;
+	plan->deltaT = deltaT;
+	plan->sigma = XLALCreateREAL8Sequence(length/2 + 1);
+	plan->chol = XLALCreateREAL8Sequence((length/2 + 1) * numFactors);
+	plan->plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	R = gsl_matrix_alloc(numDetectors, numDetectors);
+	if (! plan->sigma || ! plan->chol || ! plan->plan || ! R) {
+		gsl_matrix_free(R);
+		XLALSimSGWBPlanDestroy(plan);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	memset(plan->sigma->data, 0, plan->sigma->length * sizeof(*plan->sigma->data));
+	memset(plan->chol->data, 0, plan->chol->length * sizeof(*plan->chol->data));
+
+	deltaF = 1.0 / (length * deltaT);
+	psdfac = 0.3 * pow(H0 / LAL_PI, 2.0);
+
+	/* compute frequencies (excluding DC and Nyquist) */
+	for (k = 1; k < length/2; ++k) {
+		double f = k * deltaF;
+		double *L = plan->chol->data + k * numFactors;
+		plan->sigma->data[k] = 0.5 * sqrt(psdfac * OmegaGW->data->data[k] * pow(f, -3.0) / deltaF);
+		if (XLALSimSGWBCorrelationCholesky(R, f, detectors, numDetectors)) {
+			gsl_matrix_free(R);
+			XLALSimSGWBPlanDestroy(plan);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
+		/* pack the lower-triangular part column by column */
+		for (j = 0; j < numDetectors; ++j)
+			for (i = j; i < numDetectors; ++i)
+				*L++ = gsl_matrix_get(R, i, j);
+	}
+
+	gsl_matrix_free(R);
+	return plan;
+}
+
+/** Destroys a plan created by XLALSimSGWBPlanCreate(). */
+void XLALSimSGWBPlanDestroy(LALSimSGWBPlan *plan)
+{
+	if (plan) {
+		XLALDestroyREAL8FFTPlan(plan->plan);
+		XLALDestroyREAL8Sequence(plan->chol);
+		XLALDestroyREAL8Sequence(plan->sigma);
+		XLALFree(plan);
+	}
+	return;
+}
+
+/*
+ * This routine generates a single periodic segment of data from a plan.  The
+ * time series h and the frequency series htilde are workspace of the
+ * correct lengths and are overwritten.
+ */
+static int XLALSimSGWBPlanSegment(REAL8TimeSeries **h, COMPLEX16FrequencySeries **htilde, const LALSimSGWBPlan *plan, gsl_rng *rng)
+{
+	const size_t numDetectors = plan->numDetectors;
+	const size_t numFactors = numDetectors * (numDetectors + 1) / 2;
+	size_t i, j, k;
+
+	for (i = 0; i < numDetectors; ++i)
+		memset(htilde[i]->data->data, 0, htilde[i]->data->length * sizeof(*htilde[i]->data->data));
+
+	/* use lower-diagonal part of Cholesky decomposition to create
+	 * correlations (excluding DC and Nyquist) */
+	for (k = 1; k < plan->length/2; ++k) {
+		const double sigma = plan->sigma->data[k];
+		const double *L = plan->chol->data + k * numFactors;
+		for (j = 0; j < numDetectors; ++j) {
+			double re = gsl_ran_gaussian_ziggurat(rng, sigma);
+			double im = gsl_ran_gaussian_ziggurat(rng, sigma);
+			for (i = j; i < numDetectors; ++i, ++L)
+				htilde[i]->data->data[k] += *L * (re + I * im);
+		}
+	}
+
+	/* now go back to the time domain */
+	for (i = 0; i < numDetectors; ++i)
+		if (XLALREAL8FreqTimeFFT(h[i], htilde[i], plan->plan))
+			XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+/**
+ * Routine that generates a block of consecutive strides of a reproducible,
+ * continuous stream of stochastic background signals for a network of
+ * detectors.
+ *
+ * This is the counterpart of XLALSimNoiseStrides() for a stochastic
+ * background: the stream is made of periodic segments of plan's length that
+ * are feathered together with the same overlap-add scheme as XLALSimSGWB(),
+ * and segment n is drawn from the generator returned by
+ * XLALSimNoiseSegmentRNG() for seed and n.  The per-bin Cholesky factors are
+ * taken from the plan, so they are computed once for the whole stream.
+ *
+ * Each call fills the whole of the time series in h with
+ * h[i]->data->length / stride strides starting with stride number
+ * firstStride.  The result does not depend on how the stream is divided into
+ * calls, so consecutive calls with firstStride advanced by the number of
+ * strides in h produce one continuous stream, and independent blocks can be
+ * generated in any order.  The segments within a block are generated in
+ * parallel when OpenMP is enabled.  The epochs of h are not modified.
+ *
+ * For example, the following writes one hour of data for the HLV network
+ * in 16 s segments, 512 s at a time:
+ *
+ * @code
+ * const size_t length = 16 * 16384, stride = length / 2, nstride = 64;
+ * LALSimSGWBPlan *plan = XLALSimSGWBPlanCreate(detectors, 3, length, 1.0/16384, OmegaGW, H0);
+ * for (n = 0; n * nstride * stride < 3600 * 16384; ++n) {
+ * 	// h[i] have nstride * stride samples; set their epochs here
+ * 	XLALSimSGWBStrides(h, plan, stride, n * nstride, seed);
+ * 	// write h to frames
+ * }
+ * XLALSimSGWBPlanDestroy(plan);
+ * @endcode
+ *
+ * @note
+ * Unlike XLALSimSGWB(), every sample of h is valid.  The lengths of h must be
+ * a multiple of stride, and stride must be shorter than the segment length.
+ */
+int XLALSimSGWBStrides(
+	REAL8TimeSeries **h,			/**< [out] array of sgwb timeseries for detector network */
+	const LALSimSGWBPlan *plan,		/**< [in] plan from XLALSimSGWBPlanCreate() */
+	size_t stride,				/**< [in] stride (samples) */
+	UINT8 firstStride,			/**< [in] number of first stride in h */
+	UINT8 seed				/**< [in] seed identifying the stream */
+)
+{
+	size_t numDetectors;
+	size_t length;
+	REAL8TimeSeries **raw = NULL;
+	UINT8 firstSegment;
+	size_t numStrides;
+	size_t numSegments;
+	size_t i, n;
+	int errnum = 0;
+
+	XLAL_CHECK(h && plan, XLAL_EFAULT);
+	numDetectors = plan->numDetectors;
+	length = plan->length;
+	for (i = 0; i < numDetectors; ++i)
+		XLAL_CHECK(h[i] && h[i]->data, XLAL_EFAULT);
+
+	/* make sure all the lengths and other metadata are the same */
+	for (i = 0; i < numDetectors; ++i)
+		if (h[i]->data->length != h[0]->data->length
+				|| fabs(h[i]->deltaT - plan->deltaT) > LAL_REAL8_EPS)
+			XLAL_ERROR(XLAL_EINVAL);
+
+	/* the output must hold a whole number of strides, and strides must
+	 * overlap */
+	if (stride == 0 || stride >= length || h[0]->data->length % stride)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	/* segments needed: the one before the first stride, unless this is the
+	 * start of the stream, and one for each stride */
+	numStrides = h[0]->data->length / stride;
+	firstSegment = firstStride ? firstStride - 1 : 0;
+	numSegments = firstStride + numStrides - firstSegment;
+
+	raw = XLALCalloc(numSegments * numDetectors, sizeof(*raw));
+	if (! raw)
+		XLAL_ERROR(XLAL_ENOMEM);
+	for (n = 0; n < numSegments; ++n)
+		for (i = 0; i < numDetectors; ++i) {
+			raw[n * numDetectors + i] = XLALCreateREAL8TimeSeries(h[i]->name, &h[i]->epoch, h[i]->f0, h[i]->deltaT, &h[i]->sampleUnits, length);
+			if (! raw[n * numDetectors + i]) {
+				errnum = XLAL_EFUNC;
+				goto freereturn;
+			}
+		}
+
+	/* generate the segments, each thread with its own workspace */
+	#pragma omp parallel
+	{
+		COMPLEX16FrequencySeries **htilde = XLALCalloc(numDetectors, sizeof(*htilde));
+		size_t ii, nn;
+
+		if (htilde)
+			for (ii = 0; ii < numDetectors; ++ii) {
+				htilde[ii] = XLALCreateCOMPLEX16FrequencySeries(h[ii]->name, &h[ii]->epoch, 0.0, 1.0 / (length * plan->deltaT), &lalSecondUnit, length/2 + 1);
+				if (! htilde[ii])
+					break;
+				/* correct units */
+				XLALUnitMultiply(&htilde[ii]->sampleUnits, &htilde[ii]->sampleUnits, &h[ii]->sampleUnits);
+			}
+
+		#pragma omp for schedule(dynamic)
+		for (nn = 0; nn < numSegments; ++nn) {
+			gsl_rng *rng = NULL;
+			if (! htilde || ! htilde[numDetectors - 1]
+					|| ! (rng = XLALSimNoiseSegmentRNG(seed, firstSegment + nn))
+					|| XLALSimSGWBPlanSegment(raw + nn * numDetectors, htilde, plan, rng)) {
+				#pragma omp atomic write
+				errnum = XLAL_EFUNC;
+			}
+			gsl_rng_free(rng);
+		}
+
+		if (htilde)
+			for (ii = 0; ii < numDetectors; ++ii)
+				XLALDestroyCOMPLEX16FrequencySeries(htilde[ii]);
+		XLALFree(htilde);
+	}
+	if (errnum)
+		goto freereturn;
+
+	/* feather the segments together */
+	#pragma omp parallel for private(i)
+	for (n = 0; n < numStrides; ++n) {
+		UINT8 stridenum = firstStride + n;
+		for (i = 0; i < numDetectors; ++i) {
+			const REAL8Sequence *new = raw[(stridenum - firstSegment) * numDetectors + i]->data;
+			REAL8 *out = h[i]->data->data + n * stride;
+			size_t j;
+			if (stridenum == 0)
+				memcpy(out, new->data, stride * sizeof(*out));
+			else {
+				const REAL8Sequence *old = raw[(stridenum - 1 - firstSegment) * numDetectors + i]->data;
+				for (j = 0; j < stride; ++j)
+					if (j < length - stride) {
+						double x = cos(LAL_PI*j/(2.0 * (length - stride)));
+						double y = sin(LAL_PI*j/(2.0 * (length - stride)));
+						out[j] = x*old->data[j + stride] + y*new->data[j];
+					} else
+						out[j] = new->data[j];
+			}
+		}
+	}
+
+freereturn:
+	if (raw)
+		for (n = 0; n < numSegments * numDetectors; ++n)
+			XLALDestroyREAL8TimeSeries(raw[n]);
+	XLALFree(raw);
+	if (errnum)
+		XLAL_ERROR(errnum);
+	return 0;
+}
+
 /** @} */
 
 /*
@@ -43,6 +43,9 @@ extern "C" {
  * @}
  */
 
+/** Opaque structure holding precomputed quantities for XLALSimSGWBStrides(). */
+typedef struct tagLALSimSGWBPlan LALSimSGWBPlan;
+
 /*
  * OVERLAP REDUCTION FUNCTION ROUTINE
  * in module LALSimSGWBORF.c
@@ -68,6 +71,9 @@ REAL8FrequencySeries *XLALSimSGWBOmegaGWPowerLawSpectrum(double Omegaref, double
 int XLALSimSGWB(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, const REAL8FrequencySeries *OmegaGW, double H0, gsl_rng *rng);
 int XLALSimSGWBFlatSpectrum(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, double Omega0, double flow, double H0, gsl_rng *rng);
 int XLALSimSGWBPowerLawSpectrum(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, double Omegaref, double alpha, double fref, double flow, double H0, gsl_rng *rng);
+LALSimSGWBPlan *XLALSimSGWBPlanCreate(const LALDetector *detectors, size_t numDetectors, size_t length, double deltaT, const REAL8FrequencySeries *OmegaGW, double H0);
+void XLALSimSGWBPlanDestroy(LALSimSGWBPlan *plan);
+int XLALSimSGWBStrides(REAL8TimeSeries **h, const LALSimSGWBPlan *plan, size_t stride, UINT8 firstStride, UINT8 seed);
 
 #if 0
 { /* so that editors will match succeeding brace */
@@ -1676,6 +1676,464 @@ freereturn:
 }
 
 
+/*
+ * The following routine projects one waveform onto a network of
+ * detectors at once.  It uses the same segmentation as
+ * XLALSimInjectDetectorStrainREAL8TimeSeries() but shares the windowing
+ * and forward FFTs of the polarizations between all detectors.
+ */
+
+
+/* Helper routine that computes, for one detector, a segment of strain data
+ * from the frequency-domain polarizations of a segment of data that has
+ * been aligned to the geocentre.  Only the fractional part of the time
+ * delay is applied in the frequency domain; the integer part is returned
+ * in *shift, and sample j of the strain in the detector is sample
+ * j - *shift of the segment. */
+static int XLALSimComputeNetworkStrainSegmentREAL8TimeSeries(
+	REAL8TimeSeries *segment,
+	int *shift,
+	const COMPLEX16FrequencySeries *hplustilde,
+	const COMPLEX16FrequencySeries *hcrosstilde,
+	COMPLEX16FrequencySeries *work,
+	REAL8FFTPlan *revplan,
+	double gmst,
+	double offrac,
+	double ra,
+	double dec,
+	double psi,
+	const LALDetector *detector,
+	const COMPLEX16FrequencySeries *response
+)
+{
+	const double gha = gmst - ra;
+	double ehat_src[3];
+	double xcos;
+	double ycos;
+	double fxplus;
+	double fyplus;
+	double fxcross;
+	double fycross;
+	double armlen;
+	double deltaT;
+	double offint;
+	size_t k;
+
+	/* geometric delay from the earth's center; this is equivalent to
+	 * XLALTimeDelayFromEarthCenter() but uses the sidereal time that
+	 * the calling routine has already computed for this segment */
+
+	ehat_src[0] = cos(dec) * cos(gha);
+	ehat_src[1] = cos(dec) * -sin(gha);
+	ehat_src[2] = sin(dec);
+	deltaT = -(ehat_src[0] * detector->location[0] + ehat_src[1] * detector->location[1] + ehat_src[2] * detector->location[2]) / LAL_C_SI;
+
+	XLALComputeDetAMResponseParts(&armlen, &xcos, &ycos, &fxplus, &fyplus,
+		&fxcross, &fycross, detector, ra, dec, psi, gmst);
+
+	/* split the total shift, in samples, into an integer part and a
+	 * fractional part no greater than 1/2 a sample in magnitude */
+
+	offrac += deltaT / segment->deltaT;
+	offint = round(offrac);
+	offrac -= offint;
+	*shift = offint;
+	deltaT = offrac * segment->deltaT;
+
+	/* combine polarizations and apply sub-sample time shift in
+	 * frequency domain */
+
+	work->epoch = hplustilde->epoch;
+	work->f0 = hplustilde->f0;
+	work->deltaF = hplustilde->deltaF;
+	for (k = 0; k < work->data->length; ++k) {
+		double f = work->f0 + k * work->deltaF;
+		double beta = f * armlen / LAL_C_SI;
+		COMPLEX16 Tx, Ty; /* x- and y-arm transfer functions */
+		COMPLEX16 gplus, gcross;
+		COMPLEX16 fac;
+
+		/* phase for sub-sample time correction */
+		fac = cexp(-I * LAL_TWOPI * f * deltaT);
+		if (response)
+			fac /= response->data->data[k];
+
+		Tx = XLALComputeDetArmTransferFunction(beta, xcos);
+		Ty = XLALComputeDetArmTransferFunction(beta, ycos);
+		gplus = Tx * fxplus + Ty * fyplus;
+		gcross = Tx * fxcross + Ty * fycross;
+
+		work->data->data[k] = fac * (gplus * hplustilde->data->data[k] + gcross * hcrosstilde->data->data[k]);
+	}
+
+	/* adjust DC and Nyquist components as in
+	 * XLALSimComputeStrainSegmentREAL8TimeSeries() */
+
+	work->data->data[0] = cabs(work->data->data[0]);
+	work->data->data[work->data->length - 1] =
+		creal(work->data->data[work->data->length - 1]);
+
+	/* return data to time domain */
+
+	if (XLALREAL8FreqTimeFFT(segment, work, revplan) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+/**
+ * @brief Computes strain for a network of detectors and injects into the
+ * target time series.
+ * @details This routine is equivalent to calling
+ * XLALSimInjectDetectorStrainREAL8TimeSeries() once for each detector, but
+ * it is cheaper when the same waveform is to be injected into several
+ * detectors.  The data are broken into the same overlapping 2 s segments;
+ * the windowing and forward Fourier transforms of the plus- and
+ * cross-polarizations are done once per segment at the geocentre and are
+ * shared by all detectors, so that each additional detector only costs the
+ * frequency-domain projection and one reverse transform per segment.  The
+ * sidereal time is computed once per segment for the whole network.  The
+ * antenna response and geometric delay of each detector are evaluated at
+ * the centre of each segment, and the overlapping segments are feathered
+ * together so that these are linearly interpolated between segments.
+ *
+ * The integer-sample part of each detector's geometric delay is applied
+ * in the time domain so that the frequency-domain time shift never exceeds
+ * 1/2 a sample, as in the single-detector routine.  It is applied when the
+ * samples of each segment are read, so that adjacent segments are always
+ * feathered over the same samples even when the Earth's rotation changes
+ * the integer delay from one segment to the next; the result therefore
+ * agrees with XLALSimInjectDetectorStrainREAL8TimeSeries() to rounding
+ * error.
+ *
+ * All target time series must have the same sample interval and
+ * heterodyne frequency as the polarizations; they need not share an epoch
+ * or length.
+ * @param[in,out] targets Array of ndetectors time series to inject strain
+ * into, one per detector.
+ * @param[in] detectors Array of ndetectors detectors to use when computing
+ * strain.
+ * @param[in] ndetectors Number of detectors in the network.
+ * @param[in] hplus Time series with plus-polarization gravitational waveform.
+ * @param[in] hcross Time series with cross-polarization gravitational waveform.
+ * @param[in] ra Right ascension of the source (radians).
+ * @param[in] dec Declination of the source (radians).
+ * @param[in] psi Polarization angle of the source (radians).
+ * @param[in] responses Array of ndetectors response functions to use, or
+ * NULL if none; individual elements may also be NULL.
+ * @retval 0 Success.
+ * @retval <0 Failure.
+ */
+int XLALSimInjectNetworkStrainREAL8TimeSeries(
+	REAL8TimeSeries **targets,
+	const LALDetector *detectors,
+	UINT4 ndetectors,
+	const REAL8TimeSeries *hplus,
+	const REAL8TimeSeries *hcross,
+	double ra,
+	double dec,
+	double psi,
+	const COMPLEX16FrequencySeries **responses
+)
+{
+	const double nominal_segdur = 2.0; /* nominal segment duration = 2s */
+	const double max_time_delay = 0.1; /* generous allowed time delay */
+	const size_t strides_per_segment = 2; /* 2 strides in one segment */
+	LIGOTimeGPS t0;
+	LIGOTimeGPS t1;
+	LIGOTimeGPS t;
+	size_t length;		/* length in samples of interval t0 - t1 */
+	size_t seglen;		/* length of segment in samples */
+	size_t padlen;		/* padding at beginning and end of segment */
+	size_t ovrlap;		/* overlapping data length */
+	size_t stride;		/* stride of each step */
+	size_t nsteps;		/* number of steps to take */
+	REAL8TimeSeries **h = NULL; /* strain timeseries to inject into targets */
+	REAL8TimeSeries *segment = NULL;
+	REAL8TimeSeries *detsegment = NULL;
+	COMPLEX16FrequencySeries *hplustilde = NULL;
+	COMPLEX16FrequencySeries *hcrosstilde = NULL;
+	COMPLEX16FrequencySeries *work = NULL;
+	REAL8FFTPlan *fwdplan = NULL;
+	REAL8FFTPlan *revplan = NULL;
+	REAL8Window *window = NULL;
+	size_t step;
+	size_t j;
+	UINT4 d;
+	int errnum = 0;
+
+	/* check validity and compatibility of time series */
+
+	if (!targets || !detectors)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (ndetectors == 0)
+		return 0;
+	LAL_CHECK_VALID_SERIES(hplus, XLAL_FAILURE);
+	LAL_CHECK_VALID_SERIES(hcross, XLAL_FAILURE);
+	LAL_CHECK_CONSISTENT_TIME_SERIES(hplus, hcross, XLAL_FAILURE);
+	for (d = 0; d < ndetectors; ++d) {
+		LAL_CHECK_VALID_SERIES(targets[d], XLAL_FAILURE);
+		if (responses == NULL || responses[d] == NULL) {
+			LAL_CHECK_COMPATIBLE_TIME_SERIES(targets[d], hplus, XLAL_FAILURE);
+		} else {
+			/* units do no need to agree, but sample interval and
+			 * start frequency do */
+			if (fabs(targets[d]->deltaT - hplus->deltaT ) > LAL_REAL8_EPS)
+				XLAL_ERROR(XLAL_ETIME);
+			if (fabs(targets[d]->f0 - hplus->f0) > LAL_REAL8_EPS)
+				XLAL_ERROR(XLAL_EFREQ);
+		}
+	}
+
+	/* constants describing the data segmentation: the length of the
+	 * segment must be a power of two and the segment duration is at least
+	 * nominal_segdur */
+
+	seglen = round_up_to_power_of_two(nominal_segdur / hplus->deltaT);
+	stride = seglen / strides_per_segment;
+	padlen = max_time_delay / hplus->deltaT;
+	ovrlap = seglen;
+	ovrlap -= 2 * padlen;
+	ovrlap -= stride;
+
+	/* determine start and end time: the start time is the later of the
+	 * start of the hplus/hcross time series and the earliest start of the
+	 * target time series; the end time is the earlier of the end of the
+	 * hplus/hcross time series and the latest end of the target time
+	 * series */
+
+	t0 = targets[0]->epoch;
+	t1 = targets[0]->epoch;
+	XLALGPSAdd(&t1, targets[0]->data->length * targets[0]->deltaT);
+	for (d = 1; d < ndetectors; ++d) {
+		t = targets[d]->epoch;
+		t0 = XLALGPSCmp(&t, &t0) < 0 ? t : t0;
+		XLALGPSAdd(&t, targets[d]->data->length * targets[d]->deltaT);
+		t1 = XLALGPSCmp(&t, &t1) > 0 ? t : t1;
+	}
+	t = hplus->epoch;
+	t0 = XLALGPSCmp(&t, &t0) > 0 ? t : t0;
+	XLALGPSAdd(&t, hplus->data->length * hplus->deltaT);
+	t1 = XLALGPSCmp(&t, &t1) < 0 ? t : t1;
+
+	/* add padding of 1 stride before and after these start and end times */
+
+	XLALGPSAdd(&t0, -1.0 * stride * hplus->deltaT);
+	XLALGPSAdd(&t1, stride * hplus->deltaT);
+
+	/* determine if this is a disjoint set: if so, there is nothing to do */
+
+	if (XLALGPSCmp(&t1, &t0) <= 0)
+		return 0;
+
+	/* create segments that are seglen samples long: one for the
+	 * polarizations at the geocentre and one for the strain in a
+	 * detector */
+
+	segment = XLALCreateREAL8TimeSeries(NULL, &t0, hplus->f0,
+		hplus->deltaT, &hplus->sampleUnits, seglen);
+	detsegment = XLALCreateREAL8TimeSeries(NULL, &t0, hplus->f0,
+		hplus->deltaT, &hplus->sampleUnits, seglen);
+	if (!segment || !detsegment) {
+		errnum = XLAL_EFUNC;
+		goto freereturn;
+	}
+
+	/* create time series to hold the strain to inject into the targets */
+
+	length = XLALGPSDiff(&t1, &t0) / hplus->deltaT;
+	h = XLALCalloc(ndetectors, sizeof(*h));
+	if (!h) {
+		errnum = XLAL_ENOMEM;
+		goto freereturn;
+	}
+	for (d = 0; d < ndetectors; ++d) {
+		h[d] = XLALCreateREAL8TimeSeries(NULL, &t0, targets[d]->f0,
+			targets[d]->deltaT, &targets[d]->sampleUnits, length);
+		if (!h[d]) {
+			errnum = XLAL_EFUNC;
+			goto freereturn;
+		}
+		memset(h[d]->data->data, 0, h[d]->data->length * sizeof(*h[d]->data->data));
+	}
+
+	/* determine number of steps it takes to go from t0 to t1 */
+
+	nsteps = ((length%stride) ? (1 + length/stride) : (length/stride));
+
+	/* create frequency-domain workspace; note that the FFT function
+	 * populates the frequency series' metadata with the appropriate
+	 * values */
+
+	hplustilde = XLALCreateCOMPLEX16FrequencySeries(NULL, &t0, 0, 0,
+		&lalDimensionlessUnit, seglen / 2 + 1);
+	hcrosstilde = XLALCreateCOMPLEX16FrequencySeries(NULL, &t0, 0, 0,
+		&lalDimensionlessUnit, seglen / 2 + 1);
+	work = XLALCreateCOMPLEX16FrequencySeries(NULL, &t0, 0, 0,
+		&lalDimensionlessUnit, seglen / 2 + 1);
+	if (!hplustilde || !hcrosstilde || !work) {
+		errnum = XLAL_EFUNC;
+		goto freereturn;
+	}
+
+	/* create forward and reverse FFT plans */
+
+	fwdplan = XLALCreateForwardREAL8FFTPlan(seglen, 0);
+	revplan = XLALCreateReverseREAL8FFTPlan(seglen, 0);
+	if (!fwdplan || !revplan) {
+		errnum = XLAL_EFUNC;
+		goto freereturn;
+	}
+
+	/* create a Tukey window with tapers entirely within the padding */
+
+	window = XLALCreateTukeyREAL8Window(seglen, (double)padlen / seglen);
+	if (!window) {
+		errnum = XLAL_EFUNC;
+		goto freereturn;
+	}
+
+	/* loop over steps, adding data from the current step to the strain */
+
+	for (step = 0; step < nsteps; ++step) {
+
+		long offset;
+		double gmst;
+		double offint;
+		double offrac;
+		int hoff;
+		int k;
+
+		/* sidereal time at the middle of the segment, shared by all
+		 * detectors */
+
+		t = segment->epoch;
+		XLALGPSAdd(&t, 0.5 * segment->data->length * segment->deltaT);
+		gmst = XLALGreenwichMeanSiderealTime(&t);
+		if (XLAL_IS_REAL8_FAIL_NAN(gmst)) {
+			errnum = XLAL_EFUNC;
+			goto freereturn;
+		}
+
+		/* integer and fractional parts of the sample index in the
+		 * segment on which the hplus and hcross time series begin at
+		 * the geocentre */
+
+		offrac = modf(XLALGPSDiff(&hplus->epoch, &segment->epoch) / segment->deltaT, &offint);
+		hoff = offint;
+
+		/* window the data and put it in frequency domain */
+
+		for (k = 0; k < (int)segment->data->length; ++k)
+			if (k >= hoff && k < (int)hplus->data->length + hoff) {
+				segment->data->data[k] = window->data->data[k]
+					* hplus->data->data[k - hoff];
+			} else
+				segment->data->data[k] = 0.0;
+
+		if (XLALREAL8TimeFreqFFT(hplustilde, segment, fwdplan) < 0) {
+			errnum = XLAL_EFUNC;
+			goto freereturn;
+		}
+
+		for (k = 0; k < (int)segment->data->length; ++k)
+			if (k >= hoff && k < (int)hcross->data->length + hoff) {
+				segment->data->data[k] = window->data->data[k]
+					* hcross->data->data[k - hoff];
+			} else
+				segment->data->data[k] = 0.0;
+
+		if (XLALREAL8TimeFreqFFT(hcrosstilde, segment, fwdplan) < 0) {
+			errnum = XLAL_EFUNC;
+			goto freereturn;
+		}
+
+		/* compute the offset of this segment relative to the strain series */
+
+		offset = lround(XLALGPSDiff(&segment->epoch, &h[0]->epoch) / h[0]->deltaT);
+
+		/* project onto each detector and add to its strain */
+
+		for (d = 0; d < ndetectors; ++d) {
+			int shift;
+
+			if (XLALSimComputeNetworkStrainSegmentREAL8TimeSeries(detsegment,
+				&shift, hplustilde, hcrosstilde, work, revplan,
+				gmst, offrac, ra, dec, psi, &detectors[d],
+				responses ? responses[d] : NULL) < 0) {
+				errnum = XLAL_EFUNC;
+				goto freereturn;
+			}
+
+			/* the integer shift differs between detectors and
+			 * from one segment to the next, so it is applied when
+			 * reading the segment rather than when placing it:
+			 * every segment then covers, and is feathered over, the
+			 * same samples of the strain as the previous one
+			 * overlaps, whatever the shifts of the two */
+
+			if (shift <= -(long) padlen || shift >= (long) padlen) {
+				errnum = XLAL_EDOM;
+				goto freereturn;
+			}
+			for (j = padlen; j < seglen - padlen; ++j) {
+				long i = offset + (long) j;
+				double hj = detsegment->data->data[(long) j - shift];
+				if (i < 0 || i >= (long) h[d]->data->length)
+					continue;
+				if (step && j - padlen < ovrlap) {
+					/* feather overlapping data */
+					double x = (double)(j - padlen) / ovrlap;
+					h[d]->data->data[i] = x * hj
+						+ (1.0 - x) * h[d]->data->data[i];
+				} else /* no feathering of remaining data */
+					h[d]->data->data[i] = hj;
+			}
+		}
+
+		/* advance segment start time the next step */
+
+		XLALGPSAdd(&segment->epoch, stride * segment->deltaT);
+	}
+
+	/* apply window to beginning and end of time series to reduce ringing
+	 * and add computed strain to target time series */
+
+	for (d = 0; d < ndetectors; ++d) {
+		for (j = 0; j < stride - padlen; ++j)
+			h[d]->data->data[j] = h[d]->data->data[h[d]->data->length - 1 - j] = 0.0;
+		for ( ; j < stride; ++j) {
+			double fac = window->data->data[j - (stride - padlen)];
+			h[d]->data->data[j] *= fac;
+			h[d]->data->data[h[d]->data->length - 1 - j] *= fac;
+		}
+
+		XLALAddREAL8TimeSeries(targets[d], h[d]);
+	}
+
+freereturn:
+
+	/* free all memory and return */
+
+	XLALDestroyREAL8Window(window);
+	XLALDestroyREAL8FFTPlan(revplan);
+	XLALDestroyREAL8FFTPlan(fwdplan);
+	XLALDestroyCOMPLEX16FrequencySeries(work);
+	XLALDestroyCOMPLEX16FrequencySeries(hcrosstilde);
+	XLALDestroyCOMPLEX16FrequencySeries(hplustilde);
+	if (h)
+		for (d = 0; d < ndetectors; ++d)
+			XLALDestroyREAL8TimeSeries(h[d]);
+	XLALFree(h);
+	XLALDestroyREAL8TimeSeries(detsegment);
+	XLALDestroyREAL8TimeSeries(segment);
+
+	if (errnum)
+		XLAL_ERROR(errnum);
+	return 0;
+}
+
+
 /*
  * The following routines are more computationally efficient but they
  * assume the long-wavelength limit is valid.
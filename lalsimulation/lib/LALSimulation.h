@@ -188,6 +188,20 @@ int XLALSimInjectDetectorStrainREAL4TimeSeries(
 	const COMPLEX8FrequencySeries *response
 );
 
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALSimInjectNetworkStrainREAL8TimeSeries(
+	REAL8TimeSeries **targets,
+	const LALDetector *detectors,
+	UINT4 ndetectors,
+	const REAL8TimeSeries *hplus,
+	const REAL8TimeSeries *hcross,
+	double ra,
+	double dec,
+	double psi,
+	const COMPLEX16FrequencySeries **responses
+);
+#endif /* SWIG */
+
 int XLALSimInjectLWLDetectorStrainREAL8TimeSeries(
 	REAL8TimeSeries *target,
 	const REAL8TimeSeries *hplus,
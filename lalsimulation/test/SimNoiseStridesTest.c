@@ -0,0 +1,208 @@
+/*
+ * Check that the block-wise noise generators XLALSimNoiseStrides() and
+ * XLALSimSGWBStrides() produce the same stream no matter how it is divided
+ * into blocks, and no matter how many OpenMP threads generate it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/Date.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALDetectors.h>
+#include <lal/LALSimNoise.h>
+#include <lal/LALSimSGWB.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define DELTA_T		(1.0 / 1024)	/* seconds */
+#define SEGLENGTH	1024		/* samples */
+#define STRIDE		(SEGLENGTH / 2)	/* samples */
+#define NUMSTRIDES	24
+#define FLOW		10.0		/* Hz */
+#define SEED		20181114
+
+static const size_t blockSizes[] = {1, 2, 5, 24};
+static const int numThreads[] = {1, 2, 3};
+
+static void set_num_threads(int n)
+{
+#ifdef _OPENMP
+	omp_set_num_threads(n);
+#else
+	(void) n;
+#endif
+}
+
+/* generate the stream into s in blocks of blockSize strides */
+static int noise_blocks(REAL8TimeSeries *s, const REAL8FrequencySeries *psd, size_t blockSize)
+{
+	size_t n;
+	for (n = 0; n * STRIDE < s->data->length; n += blockSize) {
+		size_t len = (NUMSTRIDES - n < blockSize ? NUMSTRIDES - n : blockSize) * STRIDE;
+		REAL8TimeSeries *block = XLALCutREAL8TimeSeries(s, n * STRIDE, len);
+		if (! block || XLALSimNoiseStrides(block, SEGLENGTH, STRIDE, n, psd, SEED))
+			return 1;
+		memcpy(s->data->data + n * STRIDE, block->data->data, len * sizeof(*s->data->data));
+		XLALDestroyREAL8TimeSeries(block);
+	}
+	return 0;
+}
+
+/* generate the background of all detectors into h in blocks of blockSize strides */
+static int sgwb_blocks(REAL8TimeSeries **h, const LALSimSGWBPlan *plan, size_t numDetectors, size_t blockSize)
+{
+	REAL8TimeSeries *block[2];
+	size_t n, i;
+	for (n = 0; n * STRIDE < h[0]->data->length; n += blockSize) {
+		size_t len = (NUMSTRIDES - n < blockSize ? NUMSTRIDES - n : blockSize) * STRIDE;
+		for (i = 0; i < numDetectors; ++i)
+			if (! (block[i] = XLALCutREAL8TimeSeries(h[i], n * STRIDE, len)))
+				return 1;
+		if (XLALSimSGWBStrides(block, plan, STRIDE, n, SEED))
+			return 1;
+		for (i = 0; i < numDetectors; ++i) {
+			memcpy(h[i]->data->data + n * STRIDE, block[i]->data->data, len * sizeof(*h[i]->data->data));
+			XLALDestroyREAL8TimeSeries(block[i]);
+		}
+	}
+	return 0;
+}
+
+static int TestXLALSimNoiseStrides(void)
+{
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8FrequencySeries *psd = XLALCreateREAL8FrequencySeries("PSD", &epoch, 0.0, 1.0 / (SEGLENGTH * DELTA_T), &lalSecondUnit, SEGLENGTH / 2 + 1);
+	REAL8TimeSeries *ref = XLALCreateREAL8TimeSeries("noise", &epoch, 0.0, DELTA_T, &lalStrainUnit, NUMSTRIDES * STRIDE);
+	REAL8TimeSeries *s = XLALCreateREAL8TimeSeries("noise", &epoch, 0.0, DELTA_T, &lalStrainUnit, NUMSTRIDES * STRIDE);
+	size_t b, t;
+	int result = 0;
+
+	if (! psd || ! ref || ! s || XLALSimNoisePSD(psd, FLOW, XLALSimNoisePSDaLIGOZeroDetHighPower))
+		return 1;
+
+	/* reference: the whole stream in one block on one thread */
+	set_num_threads(1);
+	if (XLALSimNoiseStrides(ref, SEGLENGTH, STRIDE, 0, psd, SEED))
+		return 1;
+
+	for (t = 0; t < XLAL_NUM_ELEM(numThreads); ++t)
+		for (b = 0; b < XLAL_NUM_ELEM(blockSizes); ++b) {
+			set_num_threads(numThreads[t]);
+			memset(s->data->data, 0, s->data->length * sizeof(*s->data->data));
+			if (noise_blocks(s, psd, blockSizes[b]))
+				return 1;
+			if (memcmp(s->data->data, ref->data->data, s->data->length * sizeof(*s->data->data)) != 0) {
+				fprintf(stderr, "%s(): noise differs for blocks of %zu strides on %d threads\n", __func__, blockSizes[b], numThreads[t]);
+				result = 1;
+			}
+		}
+
+	XLALDestroyREAL8TimeSeries(s);
+	XLALDestroyREAL8TimeSeries(ref);
+	XLALDestroyREAL8FrequencySeries(psd);
+	return result;
+}
+
+static int TestXLALSimSGWBStrides(void)
+{
+	const LALDetector detectors[2] = {lalCachedDetectors[LAL_LHO_4K_DETECTOR], lalCachedDetectors[LAL_LLO_4K_DETECTOR]};
+	const size_t numDetectors = XLAL_NUM_ELEM(detectors);
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8FrequencySeries *OmegaGW = XLALSimSGWBOmegaGWFlatSpectrum(1e-6, FLOW, 1.0 / (SEGLENGTH * DELTA_T), SEGLENGTH / 2 + 1);
+	LALSimSGWBPlan *plan = OmegaGW ? XLALSimSGWBPlanCreate(detectors, numDetectors, SEGLENGTH, DELTA_T, OmegaGW, 70.0) : NULL;
+	REAL8TimeSeries *ref[2], *h[2];
+	size_t b, t, i;
+	int result = 0;
+
+	if (! plan)
+		return 1;
+	for (i = 0; i < numDetectors; ++i) {
+		ref[i] = XLALCreateREAL8TimeSeries(detectors[i].frDetector.prefix, &epoch, 0.0, DELTA_T, &lalStrainUnit, NUMSTRIDES * STRIDE);
+		h[i] = XLALCreateREAL8TimeSeries(detectors[i].frDetector.prefix, &epoch, 0.0, DELTA_T, &lalStrainUnit, NUMSTRIDES * STRIDE);
+		if (! ref[i] || ! h[i])
+			return 1;
+	}
+
+	/* reference: the whole stream in one block on one thread */
+	set_num_threads(1);
+	if (XLALSimSGWBStrides(ref, plan, STRIDE, 0, SEED))
+		return 1;
+
+	for (t = 0; t < XLAL_NUM_ELEM(numThreads); ++t)
+		for (b = 0; b < XLAL_NUM_ELEM(blockSizes); ++b) {
+			set_num_threads(numThreads[t]);
+			for (i = 0; i < numDetectors; ++i)
+				memset(h[i]->data->data, 0, h[i]->data->length * sizeof(*h[i]->data->data));
+			if (sgwb_blocks(h, plan, numDetectors, blockSizes[b]))
+				return 1;
+			for (i = 0; i < numDetectors; ++i)
+				if (memcmp(h[i]->data->data, ref[i]->data->data, h[i]->data->length * sizeof(*h[i]->data->data)) != 0) {
+					fprintf(stderr, "%s(): %s background differs for blocks of %zu strides on %d threads\n", __func__, h[i]->name, blockSizes[b], numThreads[t]);
+					result = 1;
+				}
+		}
+
+	for (i = 0; i < numDetectors; ++i) {
+		XLALDestroyREAL8TimeSeries(h[i]);
+		XLALDestroyREAL8TimeSeries(ref[i]);
+	}
+	XLALSimSGWBPlanDestroy(plan);
+	XLALDestroyREAL8FrequencySeries(OmegaGW);
+	return result;
+}
+
+static int TestXLALSimNoiseSegmentRNG(void)
+{
+	gsl_rng *rng;
+	int errnum;
+
+	/* the last segment with its own generator, and the first one past it */
+	rng = XLALSimNoiseSegmentRNG(SEED, UINT64_C(0xffffffff));
+	if (! rng)
+		return 1;
+	gsl_rng_free(rng);
+	XLAL_TRY_SILENT(rng = XLALSimNoiseSegmentRNG(SEED, UINT64_C(0x100000000)), errnum);
+	if (rng || errnum != XLAL_EDOM) {
+		fprintf(stderr, "%s(): segment 2^32 did not fail with XLAL_EDOM\n", __func__);
+		gsl_rng_free(rng);
+		return 1;
+	}
+	return 0;
+}
+
+static int TestNullArguments(void)
+{
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8TimeSeries *s = XLALCreateREAL8TimeSeries("noise", &epoch, 0.0, DELTA_T, &lalStrainUnit, NUMSTRIDES * STRIDE);
+	int result = 0;
+	int errnum;
+	int retval;
+
+	if (! s)
+		return 1;
+	XLAL_TRY_SILENT(retval = XLALSimNoiseStrides(s, SEGLENGTH, STRIDE, 0, NULL, SEED), errnum);
+	if (retval == 0 || errnum != XLAL_EFAULT) {
+		fprintf(stderr, "%s(): XLALSimNoiseStrides() with NULL psd did not fail with XLAL_EFAULT\n", __func__);
+		result = 1;
+	}
+	XLAL_TRY_SILENT(retval = XLALSimSGWBStrides(&s, NULL, STRIDE, 0, SEED), errnum);
+	if (retval == 0 || errnum != XLAL_EFAULT) {
+		fprintf(stderr, "%s(): XLALSimSGWBStrides() with NULL plan did not fail with XLAL_EFAULT\n", __func__);
+		result = 1;
+	}
+	XLALDestroyREAL8TimeSeries(s);
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+	(void) argc;	/* silence unused parameter warning */
+	(void) argv;	/* silence unused parameter warning */
+	return TestXLALSimNoiseStrides() || TestXLALSimSGWBStrides() || TestXLALSimNoiseSegmentRNG() || TestNullArguments();
+}
@@ -4,10 +4,13 @@
 #include <string.h>
 
 #include <lal/Date.h>
+#include <lal/LALDetectors.h>
 #include <lal/LALSimulation.h>
 #include <lal/LALSimBurst.h>
+#include <lal/TimeDelay.h>
 #include <lal/TimeSeries.h>
 #include <lal/Units.h>
+#include <lal/Window.h>
 
 #define DELTA_T		(1.0 / 16384)	/* seconds */
 #define SIMLENGTH	(16384 * 16)	/* samples */
@@ -15,6 +18,10 @@
 #define OFFSET		86.332874431	/* seconds */
 #define REAL4THRESH	.5e-6
 #define REAL8THRESH	1e-12
+#define NETWORKTHRESH	1e-12
+#define MOVINGOFFSET	10.332874431	/* seconds */
+#define MOVINGLENGTH	(16384 * 100)	/* samples */
+#define MOVINGFREQ	100.0		/* Hz */
 
 
 static int TestXLALSimAddInjectionREAL4TimeSeries(void)
@@ -98,9 +105,115 @@ static int TestXLALSimAddInjectionREAL8TimeSeries(void)
 }
 
 
+/* inject hplus and hcross into H1, L1 and V1 with the network routine and
+ * one detector at a time, and compare */
+static int CompareNetworkInjection(const char *name, REAL8TimeSeries *hplus, REAL8TimeSeries *hcross, double ra, double dec, double psi)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	const char *prefixes[] = {"H1", "L1", "V1"};
+	LALDetector detectors[3];
+	REAL8TimeSeries *network[3];
+	REAL8TimeSeries *single[3];
+	int failed = 0;
+	unsigned d, i;
+
+	for(d = 0; d < 3; d++) {
+		detectors[d] = *XLALDetectorPrefixToLALDetector(prefixes[d]);
+		network[d] = XLALCreateREAL8TimeSeries(prefixes[d], &epoch, 0.0, DELTA_T, &lalStrainUnit, DSTLENGTH);
+		single[d] = XLALCreateREAL8TimeSeries(prefixes[d], &epoch, 0.0, DELTA_T, &lalStrainUnit, DSTLENGTH);
+		memset(network[d]->data->data, 0, network[d]->data->length * sizeof(*network[d]->data->data));
+		memset(single[d]->data->data, 0, single[d]->data->length * sizeof(*single[d]->data->data));
+		failed |= XLALSimInjectDetectorStrainREAL8TimeSeries(single[d], hplus, hcross, ra, dec, psi, &detectors[d], NULL) < 0;
+	}
+
+	failed |= XLALSimInjectNetworkStrainREAL8TimeSeries(network, detectors, 3, hplus, hcross, ra, dec, psi, NULL) < 0;
+
+	/* the network injection must agree with the single-detector
+	 * injections to rounding error */
+	for(d = 0; d < 3; d++) {
+		double norm = 0.0, diff = 0.0;
+		for(i = 0; i < single[d]->data->length; i++) {
+			norm += single[d]->data->data[i] * single[d]->data->data[i];
+			diff += (network[d]->data->data[i] - single[d]->data->data[i]) * (network[d]->data->data[i] - single[d]->data->data[i]);
+		}
+		fprintf(stderr, "%s(): %s: %s: square integral = %.17g, fractional square integral of difference = %g\n", __func__, name, prefixes[d], norm * DELTA_T, diff / norm);
+		failed |= !(norm > 0.0) || diff / norm > NETWORKTHRESH;
+		XLALDestroyREAL8TimeSeries(network[d]);
+		XLALDestroyREAL8TimeSeries(single[d]);
+	}
+
+	return failed;
+}
+
+
+static int TestXLALSimInjectNetworkStrainREAL8TimeSeries(void)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	REAL8TimeSeries *hplus = NULL;
+	REAL8TimeSeries *hcross = NULL;
+	double ra = 1.3, dec = -0.4, psi = 0.7;
+	int failed;
+
+	XLALSimBurstSineGaussian(&hplus, &hcross, 9.0, 250.0, 1e-21, 0.5, 0.3, DELTA_T);
+	XLALGPSAdd(&hplus->epoch, XLALGPSGetREAL8(&epoch) + OFFSET);
+	XLALGPSAdd(&hcross->epoch, XLALGPSGetREAL8(&epoch) + OFFSET);
+
+	failed = CompareNetworkInjection("sine-Gaussian", hplus, hcross, ra, dec, psi);
+
+	XLALDestroyREAL8TimeSeries(hplus);
+	XLALDestroyREAL8TimeSeries(hcross);
+	return failed;
+}
+
+
+/* a long source, over which the rotation of the earth changes the integer
+ * number of samples of each detector's delay from one segment to the next */
+static int TestXLALSimInjectNetworkStrainREAL8TimeSeriesMoving(void)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	LIGOTimeGPS end;
+	const LALDetector *H1 = XLALDetectorPrefixToLALDetector("H1");
+	REAL8TimeSeries *hplus;
+	REAL8TimeSeries *hcross;
+	REAL8Window *window;
+	double ra, dec = 0.0, psi = 0.7;
+	double ddelay;
+	int failed;
+	unsigned i;
+
+	XLALGPSAdd(&epoch, MOVINGOFFSET);
+	/* put the source 6 hours of right ascension from Hanford's meridian,
+	 * where its delay changes fastest */
+	ra = XLALGreenwichMeanSiderealTime(&epoch) + H1->frDetector.vertexLongitudeRadians - M_PI / 2;
+	hplus = XLALCreateREAL8TimeSeries("hplus", &epoch, 0.0, DELTA_T, &lalStrainUnit, MOVINGLENGTH);
+	hcross = XLALCreateREAL8TimeSeries("hcross", &epoch, 0.0, DELTA_T, &lalStrainUnit, MOVINGLENGTH);
+	window = XLALCreateTukeyREAL8Window(MOVINGLENGTH, 0.1);
+	for(i = 0; i < MOVINGLENGTH; i++) {
+		double phi = 2.0 * M_PI * MOVINGFREQ * i * DELTA_T;
+		hplus->data->data[i] = 1e-21 * window->data->data[i] * cos(phi);
+		hcross->data->data[i] = 1e-21 * window->data->data[i] * sin(phi);
+	}
+	XLALDestroyREAL8Window(window);
+
+	/* make sure the delay to Hanford changes by more than a sample over
+	 * the signal, or this test tests nothing */
+	end = epoch;
+	XLALGPSAdd(&end, MOVINGLENGTH * DELTA_T);
+	ddelay = XLALTimeDelayFromEarthCenter(H1->location, ra, dec, &end) - XLALTimeDelayFromEarthCenter(H1->location, ra, dec, &epoch);
+	fprintf(stderr, "%s(): H1 delay changes by %g samples\n", __func__, ddelay / DELTA_T);
+	failed = fabs(ddelay) < DELTA_T;
+
+	failed |= CompareNetworkInjection("moving source", hplus, hcross, ra, dec, psi);
+
+	XLALDestroyREAL8TimeSeries(hplus);
+	XLALDestroyREAL8TimeSeries(hcross);
+	return failed;
+}
+
+
 int main(int argc, char *argv[])
 {
 	(void) argc;	/* silence unused parameter warning */
 	(void) argv;	/* silence unused parameter warning */
-	return TestXLALSimAddInjectionREAL4TimeSeries() || TestXLALSimAddInjectionREAL8TimeSeries();
+	return TestXLALSimAddInjectionREAL4TimeSeries() || TestXLALSimAddInjectionREAL8TimeSeries() || TestXLALSimInjectNetworkStrainREAL8TimeSeries() || TestXLALSimInjectNetworkStrainREAL8TimeSeriesMoving();
 }